@@ -19,6 +19,15 @@
 
 #include <type_traits>
 #include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <gsl/span>
+
+#if defined(__BMI__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace o2
 {
@@ -151,6 +160,83 @@ class BitstreamReader
     return result;
   }
 
+  /// Extract a sequence of fixed width fields and move the read position
+  ///
+  /// The fields are read in stream direction MSB -> LSB and aligned to the LSB
+  /// of the target elements, like in the single value get. The stream is consumed
+  /// in word sized chunks through a 64 bit window instead of shifting bit by bit
+  /// per value, for byte sized targets a BMI2 fast path unpacks multiple fields
+  /// per instruction.
+  /// @param target     span for the extracted fields
+  /// @param bitlength  number of bits per field
+  /// @return number of completely extracted fields, smaller than the span size
+  ///         if the end of the resource is reached
+  template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+  size_t extract(gsl::span<T> target, size_t bitlength)
+  {
+    return extract(target.data(), target.size(), bitlength);
+  }
+
+  /// Extract a sequence of fixed width fields, pointer and count version
+  template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+  size_t extract(T* target, size_t count, size_t bitlength)
+  {
+    if (bitlength == 0 || bitlength > sizeof(T) * 8) {
+      throw std::length_error(std::string("requested bit length ") + std::to_string(bitlength) + " does not fit size of result data type " + std::to_string(sizeof(T) * 8));
+    }
+    if (!good()) {
+      return 0;
+    }
+    size_t extracted = 0;
+    uint64_t window = 0;
+    size_t windowBits = 0;
+    auto current = mCurrent;
+    auto bitsAvailable = mBitPosition;
+    while (extracted < count) {
+      // fill the window from the stream, the last word can be consumed partially
+      while (windowBits < 64 && current != mEnd) {
+        size_t take = 64 - windowBits < bitsAvailable ? 64 - windowBits : bitsAvailable;
+        value_type chunk = (*current >> (bitsAvailable - take)) & (value_type(~value_type(0)) >> (value_size - take));
+        // the two-step shift keeps the operation defined when taking 64 bits at once
+        window = (window << (take - 1) << 1) | chunk;
+        windowBits += take;
+        bitsAvailable -= take;
+        if (bitsAvailable == 0) {
+          ++current;
+          bitsAvailable = value_size;
+        }
+      }
+      if (windowBits < bitlength) {
+        break;
+      }
+#if defined(__BMI2__)
+      if constexpr (sizeof(T) == 1) {
+        if (bitlength <= 8) {
+          // deposit 8 fields into the byte lanes of one word, the lowest lane
+          // receives the last field, so swap into stream order before the store
+          const uint64_t lanes = UINT64_C(0x0101010101010101) * ((uint64_t(1) << bitlength) - 1);
+          while (extracted + 8 <= count && windowBits >= 8 * bitlength) {
+            windowBits -= 8 * bitlength;
+            uint64_t deposited = __builtin_bswap64(_pdep_u64(window >> windowBits, lanes));
+            std::memcpy(target + extracted, &deposited, 8);
+            extracted += 8;
+          }
+        }
+      }
+#endif
+      while (extracted < count && windowBits >= bitlength) {
+        windowBits -= bitlength;
+        target[extracted++] = static_cast<T>(extractField(window, windowBits, bitlength));
+      }
+    }
+    // bits left in the window have been taken out of the stream but not been
+    // consumed, move the read position to the end of the last complete field
+    size_t position = (current - mStart + 1) * value_size - bitsAvailable - windowBits;
+    mCurrent = mStart + position / value_size;
+    mBitPosition = value_size - position % value_size;
+    return extracted;
+  }
+
   /// @class Bits
   /// @brief Helper class to get value of specified type which holds the number used bits
   ///
@@ -239,6 +325,16 @@ class BitstreamReader
   }
 
  private:
+  /// extract a field of given length starting at bit position from the window
+  static uint64_t extractField(uint64_t window, size_t start, size_t length)
+  {
+#if defined(__BMI__)
+    return _bextr_u64(window, start, length);
+#else
+    return (window >> start) & (~uint64_t(0) >> (64 - length));
+#endif
+  }
+
   /// The internal peek method
   template <typename T, bool RuntimeCheck>
   size_t peek(T& result, size_t bitlength)
@@ -254,8 +350,10 @@ class BitstreamReader
     auto current = mCurrent;
     auto bitsAvailable = mBitPosition;
     while (bitsToWrite > 0 && current != mEnd) {
-      // extract available bits
-      value_type mask = ~value_type(0) >> (value_size - bitsAvailable);
+      // extract available bits, the cast keeps the complement in the value type
+      // before the shift, otherwise integer promotion turns it into an all-ones
+      // mask for types smaller than int and consumed bits leak into the result
+      value_type mask = value_type(~value_type(0)) >> (value_size - bitsAvailable);
       if (bitsToWrite >= bitsAvailable) {
         T value = (*current & mask) << (bitsToWrite - bitsAvailable);
         result |= value;
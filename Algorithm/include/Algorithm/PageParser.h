@@ -20,6 +20,7 @@
 #include <functional>
 #include <vector>
 #include <cassert>
+#include <cstring>
 #include <type_traits>
 #include <stdexcept>
 
@@ -154,6 +155,15 @@ void set<void>(void*, size_t)
  *   for (auto element : parser) {
  *     // do something with element
  *   }
+ *
+ * For parallel processing, the buffer can be partitioned into multiple
+ * independently parseable ranges, the boundaries are chosen such that no
+ * element and no block of grouped elements is split
+ *   for (auto const& range : parser.splitRanges(nThreads)) {
+ *     // hand each range to a worker, e.g. a thread pool
+ *   }
+ * Parser and iterators fulfill the standard range requirements, the
+ * std::ranges algorithms can be used directly on the parser.
  */
 template <typename PageHeaderT,
           size_t PageSize,
@@ -191,6 +201,24 @@ class PageParser
     // that iterator write works only for non-const buffers
     mBuffer = const_cast<BufferType*>(buffer);
   }
+  // copies share the underlying buffer but get their own group iteration
+  // state, i.e. a copy starts parsing from the beginning
+  PageParser(const PageParser& other)
+    : mBuffer(other.mBuffer), mBufferIsConst(other.mBufferIsConst), mSize(other.mSize), mGetNElementsFct(other.mGetNElementsFct), mNPages(other.mNPages), mGroupHeader(pageparser::alloc<GroupType>())
+  {
+  }
+  PageParser& operator=(const PageParser& other)
+  {
+    if (this != &other) {
+      mBuffer = other.mBuffer;
+      mBufferIsConst = other.mBufferIsConst;
+      mSize = other.mSize;
+      mGetNElementsFct = other.mGetNElementsFct;
+      mNPages = other.mNPages;
+      mNGroupElements = 0;
+    }
+    return *this;
+  }
   ~PageParser()
   {
     pageparser::free(mGroupHeader);
@@ -209,7 +237,9 @@ class PageParser
     using difference_type = std::ptrdiff_t;
     using ElementType = typename std::remove_const<value_type>::type;
 
-    Iterator() = delete;
+    // the default constructed iterator is not attached to a parser and only
+    // there to satisfy the std::forward_iterator requirements
+    Iterator() = default;
 
     Iterator(ParentType const* parent, size_t position = 0)
       : mParent(parent)
@@ -250,7 +280,7 @@ class PageParser
       return copy;
     }
     // return reference
-    reference operator*()
+    reference operator*() const
     {
       return mElement;
     }
@@ -275,6 +305,9 @@ class PageParser
     template <typename U = void>
     typename std::enable_if<!std::is_const<value_type>::value, U>::type sync()
     {
+      if (mParent == nullptr) {
+        return;
+      }
       if (std::memcmp(&mElement, &mBackup, sizeof(value_type)) != 0) {
         // mElement is changed, sync to buffer
         mParent->setElement(mPosition, mElement);
@@ -300,10 +333,11 @@ class PageParser
     {
     }
 
-    int mPosition;
-    int mNextPosition;
-    ParentType const* mParent;
-    ElementType mElement;
+    int mPosition = 0;
+    int mNextPosition = 0;
+    ParentType const* mParent = nullptr;
+    // mutable to allow dereferencing through a const iterator
+    mutable ElementType mElement;
     ElementType mBackup;
   };
 
@@ -482,7 +516,101 @@ class PageParser
     return iterator(this, mSize);
   }
 
+  /// get the buffer positions where a page starts with a new element, or for
+  /// grouped elements with a new block, i.e. the positions where the buffer
+  /// can be split into independently parseable ranges
+  std::vector<size_t> getSplitPoints() const
+  {
+    std::vector<size_t> points;
+    if (std::is_void<GroupType>::value) {
+      // without grouping the elements are packed continuously with only the
+      // page headers interspersed, the element phase of every page follows
+      // from the payload capacity alone
+      constexpr size_t capacity = page_size - sizeof(PageHeaderType);
+      for (size_t page = 1; page < mNPages; page++) {
+        if (((page * capacity) % sizeof(value_type)) == 0) {
+          points.emplace_back(page * page_size);
+        }
+      }
+      return points;
+    }
+    // for grouped elements the block lengths have to be extracted from the
+    // group headers, a split is possible at every page starting a new block
+    auto groupHeader = pageparser::alloc<GroupType>();
+    size_t position = 0;
+    while (position < mSize) {
+      if ((position % page_size) == 0) {
+        if (position > 0 && position + sizeof(PageHeaderType) + pageparser::sizeofGroupHeader<GroupType>() <= mSize) {
+          points.emplace_back(position);
+        }
+        position += sizeof(PageHeaderType);
+      } else if ((position % page_size) != sizeof(PageHeaderType)) {
+        // nothing more in this page, a new block can only start in the next one
+        position += page_size - (position % page_size);
+        continue;
+      }
+      if (position + pageparser::sizeofGroupHeader<GroupType>() > mSize) {
+        break;
+      }
+      auto nGroupElements = readGroupHeader(position, groupHeader);
+      position += pageparser::sizeofGroupHeader<GroupType>();
+      if (nGroupElements == 0) {
+        continue;
+      }
+      // forward over the block, it can wrap over page boundaries
+      size_t nPages = 0;
+      size_t required = pageparser::sizeofGroupHeader<GroupType>() + nGroupElements * sizeof(value_type);
+      do {
+        required += sizeof(PageHeaderType);
+        ++nPages;
+      } while (required > nPages * page_size);
+      required -= sizeof(PageHeaderType) + pageparser::sizeofGroupHeader<GroupType>();
+      position += required;
+    }
+    pageparser::free(groupHeader);
+    return points;
+  }
+
+  /// split the buffer into at most nRanges independently parseable parsers,
+  /// the boundaries are chosen from the split points closest to an equal
+  /// division of the buffer; each returned range can be processed without
+  /// touching the others, e.g. by the workers of a thread pool
+  std::vector<PageParser> splitRanges(size_t nRanges) const
+  {
+    std::vector<PageParser> ranges;
+    if (nRanges < 2 || mNPages < 2) {
+      ranges.push_back(PageParser(mBuffer, mSize, mBufferIsConst, mGetNElementsFct));
+      return ranges;
+    }
+    auto points = getSplitPoints();
+    std::vector<size_t> starts{0};
+    size_t current = 0;
+    for (size_t range = 1; range < nRanges; range++) {
+      auto desired = (mSize * range) / nRanges;
+      while (current < points.size() && points[current] < desired) {
+        ++current;
+      }
+      if (current >= points.size()) {
+        break;
+      }
+      if (points[current] > starts.back()) {
+        starts.emplace_back(points[current]);
+      }
+    }
+    for (size_t range = 0; range < starts.size(); range++) {
+      auto end = (range + 1 < starts.size()) ? starts[range + 1] : mSize;
+      ranges.push_back(PageParser(mBuffer + starts[range], end - starts[range], mBufferIsConst, mGetNElementsFct));
+    }
+    return ranges;
+  }
+
  private:
+  // internal constructor for the sub-ranges created by splitRanges
+  PageParser(BufferType* buffer, size_t size, bool bufferIsConst, GetNElements getNElementsFct)
+    : mBuffer(buffer), mBufferIsConst(bufferIsConst), mSize(size), mGetNElementsFct(getNElementsFct), mNPages(size > 0 ? ((size - 1) / page_size) + 1 : 0), mGroupHeader(pageparser::alloc<GroupType>())
+  {
+  }
+
   BufferType* mBuffer = nullptr;
   bool mBufferIsConst = false;
   size_t mSize = 0;
@@ -18,8 +18,10 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <ranges>
 #include <vector>
 #include "Headers/DataHeader.h" // hexdump
 #include "../include/Algorithm/PageParser.h"
@@ -244,3 +246,74 @@ BOOST_AUTO_TEST_CASE(test_pageparser_group_perpage)
   runParserTest<DataSetT, PageHeader, int, 100, true>(dataset);
   runParserTest<DataSetT, PageHeader, int, 89, true>(dataset);
 }
+
+BOOST_AUTO_TEST_CASE(test_pageparser_splitranges)
+{
+  constexpr unsigned pagesize = 128;
+  std::vector<ClusterData> dataset;
+  FillData(dataset, 20);
+  auto buffer = MakeBuffer(pagesize, PageHeader(0), dataset);
+
+  using RawParser = o2::algorithm::PageParser<PageHeader, pagesize, ClusterData>;
+  const RawParser parser(buffer.first.get(), buffer.second);
+
+  // the concatenation of the sub-ranges must reproduce the full sequence,
+  // independent of the number of ranges requested
+  for (size_t nRanges = 1; nRanges <= 8; nRanges++) {
+    auto ranges = parser.splitRanges(nRanges);
+    BOOST_REQUIRE(ranges.size() >= 1);
+    BOOST_REQUIRE(ranges.size() <= nRanges);
+    unsigned dataidx = 0;
+    for (const auto& range : ranges) {
+      for (auto i : range) {
+        BOOST_REQUIRE(i == dataset[dataidx++]);
+      }
+    }
+    BOOST_REQUIRE(dataidx == dataset.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_pageparser_splitranges_group)
+{
+  using DataSetT = std::vector<ClusterData>;
+  DataSetT dataset;
+  FillData(dataset, 20);
+  constexpr unsigned pagesize = 128;
+  using RawParser = o2::algorithm::PageParser<PageHeader, pagesize, ClusterData, int>;
+
+  // a single group header means one block wrapping over all pages, no split
+  // is possible
+  auto single = MakeBuffer<DataSetT, PageHeader, int, false>(pagesize, PageHeader(0), dataset);
+  const RawParser singleparser(single.first.get(), single.second);
+  BOOST_REQUIRE(singleparser.getSplitPoints().empty());
+  BOOST_REQUIRE(singleparser.splitRanges(4).size() == 1);
+
+  // with one group header per page, every page holds a complete block and
+  // is a valid split point
+  auto buffer = MakeBuffer<DataSetT, PageHeader, int, true>(pagesize, PageHeader(0), dataset);
+  const RawParser parser(buffer.first.get(), buffer.second);
+  BOOST_REQUIRE(parser.getSplitPoints().size() == buffer.second / pagesize - 1);
+
+  unsigned dataidx = 0;
+  for (const auto& range : parser.splitRanges(3)) {
+    for (auto i : range) {
+      BOOST_REQUIRE(i == dataset[dataidx++]);
+    }
+  }
+  BOOST_REQUIRE(dataidx == dataset.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_pageparser_stdranges)
+{
+  constexpr unsigned pagesize = 128;
+  using RawParser = o2::algorithm::PageParser<PageHeader, pagesize, ClusterData>;
+  static_assert(std::forward_iterator<RawParser::const_iterator>);
+  static_assert(std::ranges::forward_range<const RawParser>);
+
+  std::vector<ClusterData> dataset;
+  FillData(dataset, 20);
+  auto buffer = MakeBuffer(pagesize, PageHeader(0), dataset);
+  const RawParser parser(buffer.first.get(), buffer.second);
+  BOOST_REQUIRE(std::ranges::distance(parser) == static_cast<std::ptrdiff_t>(dataset.size()));
+  BOOST_REQUIRE(std::ranges::equal(parser, dataset));
+}
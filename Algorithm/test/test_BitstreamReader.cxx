@@ -23,6 +23,7 @@
 #include <array>
 #include <vector>
 #include <bitset>
+#include <gsl/span>
 #include "../include/Algorithm/BitstreamReader.h"
 
 namespace o2
@@ -117,5 +118,59 @@ BOOST_AUTO_TEST_CASE(test_BitstreamReader_bitset)
   BOOST_CHECK_MESSAGE(aBitset.to_ulong() == 0x6465, std::string("mismatch: value 0x") << std::hex << aBitset.to_ulong() << ",  expected 0x6465");
 }
 
+BOOST_AUTO_TEST_CASE(test_BitstreamReader_extract)
+{
+  std::array<uint8_t, 8> data = {'d', 'e', 'a', 'd', 'b', 'e', 'e', 'f'};
+  std::array<uint8_t, 10> expected7bit = {0x32, 0x19, 0x2c, 0x16, 0x23, 0x09, 0x4a, 0x65, 0x33, 0x0};
+
+  BitstreamReader<uint8_t> reader(data.data(), data.data() + data.size());
+  std::array<uint8_t, 10> values;
+  values.fill(0xff);
+  // only 9 complete 7 bit fields fit into the 64 bits of data
+  BOOST_REQUIRE(reader.extract(gsl::span<uint8_t>(values), 7) == 9);
+  for (size_t i = 0; i < 9; i++) {
+    BOOST_CHECK_MESSAGE(values[i] == expected7bit[i], std::string("mismatch at ") << i << ": value " << (int)values[i] << ",  expected " << (int)expected7bit[i]);
+  }
+  // the read position is right after the last complete field, one bit left
+  BOOST_CHECK(reader.eof() == false);
+  BOOST_CHECK(reader.get<uint8_t>(1) == 0);
+  BOOST_CHECK(reader.eof());
+}
+
+BOOST_AUTO_TEST_CASE(test_BitstreamReader_extract_widths)
+{
+  std::array<uint8_t, 16> data = {'d', 'e', 'a', 'd', 'b', 'e', 'e', 'f', 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+  constexpr size_t totalBits = data.size() * sizeof(decltype(data)::value_type) * 8;
+
+  // the bulk extraction must reproduce the sequential single value reads for
+  // any field width, including fields wrapping the refill of the internal window
+  for (size_t width : {3, 5, 7, 8, 11, 13, 16}) {
+    BitstreamReader<uint8_t> reader(data.data(), data.data() + data.size());
+    std::vector<uint16_t> bulk(totalBits / width + 1);
+    BOOST_REQUIRE(reader.extract(gsl::span<uint16_t>(bulk), width) == totalBits / width);
+    BitstreamReader<uint8_t> refReader(data.data(), data.data() + data.size());
+    for (size_t i = 0; i < totalBits / width; i++) {
+      auto expected = refReader.get<uint16_t>(width);
+      BOOST_CHECK_MESSAGE(bulk[i] == expected, std::string("width ") << width << " mismatch at " << i << ": value " << bulk[i] << ",  expected " << expected);
+    }
+    if (totalBits % width) {
+      // both readers sit in front of the incomplete trailing field
+      BOOST_CHECK(reader.get<uint16_t>(totalBits % width) == refReader.get<uint16_t>(totalBits % width));
+    }
+  }
+
+  // byte sized targets take the fast path unpacking 8 fields at a time
+  for (size_t width : {3, 5, 7, 8}) {
+    BitstreamReader<uint8_t> reader(data.data(), data.data() + data.size());
+    std::vector<uint8_t> bulk(totalBits / width);
+    BOOST_REQUIRE(reader.extract(gsl::span<uint8_t>(bulk), width) == bulk.size());
+    BitstreamReader<uint8_t> refReader(data.data(), data.data() + data.size());
+    for (size_t i = 0; i < bulk.size(); i++) {
+      auto expected = refReader.get<uint8_t>(width);
+      BOOST_CHECK_MESSAGE(bulk[i] == expected, std::string("width ") << width << " mismatch at " << i << ": value " << (int)bulk[i] << ",  expected " << (int)expected);
+    }
+  }
+}
+
 } // namespace algorithm
 } // namespace o2
@@ -16,6 +16,7 @@
 #define O2_BASICCDBMANAGER_H
 
 #include "CCDB/CcdbApi.h"
+#include "CCDB/CCDBDiskCache.h"
 #include "CCDB/CCDBTimeStampUtils.h"
 #include "CommonUtils/NameConf.h"
 #include "Framework/DataTakingContext.h"
@@ -25,6 +26,7 @@
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 #include <cstdlib>
 
 class TGeoManager; // we need to forward-declare those classes which should not be cleaned up
@@ -80,6 +82,14 @@ class CCDBManagerInstance
   {
     mCCDBAccessor.init(path);
     mDeplMode = o2::framework::DefaultsHelpers::deploymentMode();
+    const char* diskCacheDir = getenv("ALICEO2_CCDB_DISKCACHE");
+    if (diskCacheDir && diskCacheDir[0]) {
+      setDiskCachePath(diskCacheDir);
+    }
+    const char* negTTL = getenv("ALICEO2_CCDB_NEGATIVE_TTL");
+    if (negTTL && atol(negTTL) > 0) {
+      setNegativeCacheTTL(atol(negTTL));
+    }
   }
   /// set a URL to query from
   void setURL(const std::string& url);
@@ -132,14 +142,50 @@ class CCDBManagerInstance
   bool isHostReachable() const { return mCCDBAccessor.isHostReachable(); }
 
   /// clear all entries in the cache
-  void clearCache() { mCache.clear(); }
+  void clearCache()
+  {
+    mCache.clear();
+    mNegativeCache.clear();
+  }
 
   /// clear particular entry in the cache
-  void clearCache(std::string const& path) { mCache.erase(path); }
+  void clearCache(std::string const& path)
+  {
+    mCache.erase(path);
+    mNegativeCache.erase(path);
+  }
+
+  /// Set for how long (in ms of wall-clock time) a failed fetch suppresses retries of the
+  /// same path: within the TTL getForTimeStamp returns nullptr without contacting the
+  /// server. Protects the backend from retry storms on missing objects (every TF would
+  /// otherwise pay and inflict a full round trip). 0 disables negative caching.
+  void setNegativeCacheTTL(long ttlMS) { mNegativeCacheTTLms = ttlMS; }
+
+  /// get the negative-result cache TTL in ms
+  long getNegativeCacheTTL() const { return mNegativeCacheTTLms; }
+
+  /// number of fetch attempts suppressed by the negative-result cache
+  int getNegativeCacheHits() const { return mNegativeCacheHits; }
 
   /// check if caching is enabled
   bool isCachingEnabled() const { return mCachingEnabled; }
 
+  /// Enable the node-local content-addressed disk cache under the given directory
+  /// (also enabled via the ALICEO2_CCDB_DISKCACHE environment variable): blobs are
+  /// shared by ETag between all processes of the node and consulted before any body
+  /// download, only a cheap headers query goes to the network on a hit. Empty path
+  /// disables the cache.
+  void setDiskCachePath(const std::string& cacheDir)
+  {
+    mDiskCache = cacheDir.empty() ? nullptr : std::make_unique<CCDBDiskCache>(cacheDir);
+  }
+
+  /// check if the disk cache is enabled
+  bool isDiskCacheEnabled() const { return mDiskCache != nullptr; }
+
+  /// access the disk cache (e.g. for hit/miss statistics), may be nullptr
+  const CCDBDiskCache* getDiskCache() const { return mDiskCache.get(); }
+
   /// disable or enable caching
   void setCaching(bool v)
   {
@@ -195,6 +241,20 @@ class CCDBManagerInstance
   std::pair<int64_t, int64_t> getRunDuration(int runnumber, bool fatal = true);
   static std::pair<int64_t, int64_t> getRunDuration(o2::ccdb::CcdbApi const& api, int runnumber, bool fatal = true);
   static std::pair<int64_t, int64_t> getRunDuration(const MD& headers);
+
+  /// Prefetch into the node-local disk cache all versions of the given paths valid in the
+  /// [startTime, endTime) range, with the downloads overlapped. Async passes which know the
+  /// run time range up front can thus replace the incremental mid-run fetches by a single
+  /// startup transfer: subsequent getForTimeStamp queries are served with a headers-only
+  /// round trip plus a local read. The validity timeline of each path is walked with cheap
+  /// headers queries, blobs already present in the cache are not downloaded again.
+  /// Requires the disk cache to be enabled and is not available in TimeMachine mode.
+  /// @return the number of objects downloaded, or -1 if prefetching is not possible
+  int prefetchForRange(const std::vector<std::string>& paths, long startTime, long endTime);
+
+  /// Prefetch the given paths for the duration of a run (convenience wrapper combining
+  /// getRunDuration and prefetchForRange).
+  int prefetchForRun(const std::vector<std::string>& paths, int runnumber);
   std::string getSummaryString() const;
 
   size_t getFetchedSize() const { return mFetchedSize; }
@@ -206,9 +266,18 @@ class CCDBManagerInstance
  private:
   // method to print (fatal) error
   void reportFatal(std::string_view s);
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+  // serve an object blob through the disk cache, filling mHeaders like a regular
+  // query. Returns true if the blob was filled (from the cache or from a download
+  // which was then published to the cache), false if the in-memory object with
+  // etagCached is still valid or the object could not be retrieved.
+  bool fetchBlobViaDiskCache(std::string const& path, long timestamp, std::string const& etagCached, o2::pmr::vector<char>& blob);
+#endif
   // we access the CCDB via the CURL based C++ API
   o2::ccdb::CcdbApi mCCDBAccessor;
+  std::unique_ptr<CCDBDiskCache> mDiskCache;            //! node-local content-addressed disk cache, nullptr if disabled
   std::unordered_map<std::string, CachedObject> mCache; //! map for {path, CachedObject} associations
+  std::unordered_map<std::string, long> mNegativeCache; //! paths of failed fetches -> wall-clock expiry of the retry suppression
   MD mMetaData;                                         // some dummy object needed to talk to CCDB API
   MD mHeaders;                                          // headers to retrieve tags
   long mTimestamp{o2::ccdb::getCurrentTimestamp()};     // timestamp to be used for query (by default "now")
@@ -218,6 +287,8 @@ class CCDBManagerInstance
   bool mFatalWhenNull = true;                           // if nullptr blob replies should be treated as fatal (can be set by user)
   long mCreatedNotAfter = 0;                            // upper limit for object creation timestamp (TimeMachine mode) - If-Not-After HTTP header
   long mCreatedNotBefore = 0;                           // lower limit for object creation timestamp (TimeMachine mode) - If-Not-Before HTTP header
+  long mNegativeCacheTTLms = 0;                         // for how long a failed fetch suppresses retries of the same path, 0 disables
+  int mNegativeCacheHits = 0;                           // fetch attempts suppressed by the negative cache
   long mTimerMS = 0;                                    // timer for queries
   size_t mFetchedSize = 0;                              // total fetched size
   int mQueries = 0;                                     // total number of object queries
@@ -232,16 +303,38 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
 {
   T* ptr = nullptr;
   mQueries++;
+  if (mNegativeCacheTTLms > 0) { // suppress the retry of a recently failed fetch
+    auto neg = mNegativeCache.find(path);
+    if (neg != mNegativeCache.end()) {
+      if (o2::ccdb::getCurrentTimestamp() < neg->second) {
+        mNegativeCacheHits++;
+        return nullptr;
+      }
+      mNegativeCache.erase(neg); // TTL expired, retry
+    }
+  }
   auto start = std::chrono::system_clock::now();
   if (!isCachingEnabled()) {
-    ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, nullptr, "",
-                                                mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
-                                                mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+    if (mDiskCache) {
+      o2::pmr::vector<char> blob;
+      ptr = fetchBlobViaDiskCache(path, timestamp, "", blob) ? o2::ccdb::CcdbApi::extractFromMemoryBlob<T>(blob) : nullptr;
+    } else {
+#endif
+      ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, nullptr, "",
+                                                  mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
+                                                  mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+    }
+#endif
     if (!ptr) {
       if (mFatalWhenNull) {
         reportFatal(std::string("Got nullptr from CCDB for path ") + path + std::string(" and timestamp ") + std::to_string(timestamp));
       }
       mFailures++;
+      if (mNegativeCacheTTLms > 0) {
+        mNegativeCache[path] = o2::ccdb::getCurrentTimestamp() + mNegativeCacheTTLms;
+      }
     } else {
       mFetches++;
       auto sh = mHeaders.find("fileSize");
@@ -256,9 +349,18 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
     if ((!isOnline() && cached.isCacheValid(timestamp)) || (mCheckObjValidityEnabled && cached.isValid(timestamp))) {
       return reinterpret_cast<T*>(cached.noCleanupPtr ? cached.noCleanupPtr : cached.objPtr.get());
     }
-    ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
-                                                mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
-                                                mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+    if (mDiskCache) {
+      o2::pmr::vector<char> blob;
+      ptr = fetchBlobViaDiskCache(path, timestamp, cached.uuid, blob) ? o2::ccdb::CcdbApi::extractFromMemoryBlob<T>(blob) : nullptr;
+    } else {
+#endif
+      ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
+                                                  mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
+                                                  mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+    }
+#endif
     if (ptr) { // new object was shipped, old one (if any) is not valid anymore
       cached.fetches++;
       mFetches++;
@@ -312,6 +414,9 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
         reportFatal(std::string("Got nullptr from CCDB for path ") + path + std::string(" and timestamp ") + std::to_string(timestamp));
       }
       mFailures++;
+      if (mNegativeCacheTTLms > 0) {
+        mNegativeCache[path] = o2::ccdb::getCurrentTimestamp() + mNegativeCacheTTLms;
+      }
     }
   }
   auto end = std::chrono::system_clock::now();
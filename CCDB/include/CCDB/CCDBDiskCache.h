@@ -0,0 +1,84 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBDiskCache.h
+/// \brief  Node-local content-addressed disk cache for CCDB object blobs
+///
+
+#ifndef O2_CCDB_CCDBDISKCACHE_H
+#define O2_CCDB_CCDBDISKCACHE_H
+
+#include <cstddef>
+#include <string>
+
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+#include "MemoryResources/MemoryResources.h"
+#endif
+
+namespace o2
+{
+namespace ccdb
+{
+
+/**
+ * Node-local content-addressed cache for CCDB object blobs, shared by all
+ * processes on the node. Blobs are stored in flat files named after the ETag
+ * of the object, so any process knowing the current ETag (a cheap headers-only
+ * query) can serve the body locally, and different versions of the same path
+ * never collide - unlike the path-keyed snapshot cache. Writers publish a blob
+ * with an atomic rename and readers map the file read-only, so concurrent
+ * access needs no locking and repeated loads on one node share the page cache.
+ * The cache is append-only, pruning is left to the deployment (e.g. a cron
+ * removing files by atime).
+ */
+class CCDBDiskCache
+{
+ public:
+  CCDBDiskCache() = default;
+
+  /// attach to (and create if needed) the cache directory
+  CCDBDiskCache(std::string cacheDir);
+
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+  /// Serve the blob with the given ETag from the cache if present. The file is
+  /// mapped read-only and copied into dest, the kernel page cache backing the
+  /// mapping is shared by all processes reading the same object.
+  /// @return true if the blob was found and dest was filled
+  bool load(const std::string& etag, o2::pmr::vector<char>& dest) const;
+
+  /// Publish the blob under its ETag: written to a process-unique temporary
+  /// file and moved in place with an atomic rename, so concurrent writers of
+  /// the same object are safe and readers never see a partial file.
+  void store(const std::string& etag, const o2::pmr::vector<char>& blob) const;
+#endif
+
+  /// check whether a blob with the given ETag is present, without loading it
+  bool contains(const std::string& etag) const;
+
+  bool isActive() const { return !mCacheDir.empty(); }
+  const std::string& getCacheDir() const { return mCacheDir; }
+  size_t getHits() const { return mHits; }
+  size_t getMisses() const { return mMisses; }
+
+  /// reduce an ETag to a file name: strip quotes and path-hostile characters
+  static std::string keyToFileName(const std::string& etag);
+
+ private:
+  std::string mCacheDir{};  ///< root directory of the cache, empty if inactive
+  mutable size_t mHits = 0; ///< blobs served from the cache
+  mutable size_t mMisses = 0; ///< lookups which went to the network
+};
+
+} // namespace ccdb
+} // namespace o2
+
+#endif // O2_CCDB_CCDBDISKCACHE_H
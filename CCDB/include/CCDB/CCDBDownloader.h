@@ -143,6 +143,12 @@ class CCDBDownloader
    */
   int mMaxHandlesInUse = 3;
 
+  /**
+   * Cap on the download speed of a single transfer in bytes per second, 0 means no limit.
+   * Together with the connection limit it allows to budget the node bandwidth across the many devices sharing it.
+   */
+  long mMaxRecvSpeed = 0;
+
   /**
    * Variable denoting whether an external or internal uv_loop is being used.
    */
@@ -177,6 +183,12 @@ class CCDBDownloader
    */
   void setMaxParallelConnections(int limit);
 
+  /**
+   * Limits the download speed of a single transfer (bytes per second, 0 removes the limit).
+   * Applies to transfers started after the call.
+   */
+  void setMaxRecvSpeed(long bytesPerSecond);
+
   /**
    * Limits the time a socket and its connection will be opened after transfer finishes.
    */
@@ -124,6 +124,35 @@ class CcdbApi //: public DatabaseInterface
    */
   static std::unique_ptr<std::vector<char>> createObjectImage(const void* obj, std::type_info const& tinfo, CcdbObjectInfo* info = nullptr);
 
+  /**
+   * Create a binary image of the arbitrary type object directly in the user-provided buffer,
+   * e.g. a vector backed by the output message, avoiding the intermediate image vector and
+   * its copy into the message. If CcdbObjectInfo pointer is provided, register there
+   * the assigned object class name and the filename.
+   *
+   * @param obj: Raw pointer to the object to store.
+   * @param dest: destination buffer, resized to the image size
+   * @param info: optinal info where assigned object name and filename will be filled
+   * @return the image size
+   */
+  template <typename T>
+  inline static size_t createObjectImage(const T* obj, o2::pmr::vector<char>& dest, CcdbObjectInfo* info = nullptr)
+  {
+    return createObjectImage(reinterpret_cast<const void*>(obj), typeid(T), dest, info);
+  }
+
+  /**
+   * Create a binary image of the object directly in the user-provided buffer, if CcdbObjectInfo
+   * pointer is provided, register there the assigned object class name and the filename.
+   *
+   * @param obj: Raw pointer to the object to store.
+   * @param tinfo: object type info
+   * @param dest: destination buffer, resized to the image size
+   * @param info: optinal info where assigned object name and filename will be filled
+   * @return the image size
+   */
+  static size_t createObjectImage(const void* obj, std::type_info const& tinfo, o2::pmr::vector<char>& dest, CcdbObjectInfo* info = nullptr);
+
   /**
    * Store into the CCDB a TFile containing the ROOT object.
    *
@@ -292,6 +321,45 @@ class CcdbApi //: public DatabaseInterface
    */
   std::map<std::string, std::string> retrieveHeaders(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp = -1) const;
 
+  /**
+   * Element of an up-to-date check: the request fields are filled by the caller,
+   * the outcome fields by checkObjectUpToDate/checkBatchUpToDate.
+   */
+  struct UpdateCheck {
+    std::string path;
+    std::map<std::string, std::string> metadata{};
+    long timestamp = -1;
+    std::string etag{};       // ETag of the version known to the caller, empty if none
+    std::string createdNotAfter{};
+    std::string createdNotBefore{};
+    // outcome, filled on return:
+    bool exists = false;                          // an object is valid at timestamp
+    bool upToDate = false;                        // the version behind etag is still the current one
+    std::map<std::string, std::string> headers{}; // reply headers (new ETag, Valid-Until, ...)
+
+    UpdateCheck() = default;
+    UpdateCheck(std::string p, std::map<std::string, std::string> m, long ts, std::string et)
+      : path(std::move(p)), metadata(std::move(m)), timestamp(ts), etag(std::move(et)) {}
+  };
+
+  /**
+   * Lightweight existence/validity check: a HEAD request carrying If-None-Match,
+   * so no object body is ever transferred and the reply headers are parsed by
+   * the compiled header callback (no JSON browsing involved). Meant for polling
+   * loops which only need to know whether a newer version exists.
+   * @param check Request/outcome structure, see UpdateCheck.
+   * @return true when the caller's version is still the current one.
+   */
+  bool checkObjectUpToDate(UpdateCheck& check) const;
+
+  /**
+   * Batched variant of checkObjectUpToDate: all HEAD requests are overlapped
+   * on a curl multi handle, so the cost of polling many paths is a single
+   * round trip instead of one per path.
+   * @param checks Requests to perform, outcome fields filled on return.
+   */
+  void checkBatchUpToDate(std::vector<UpdateCheck>& checks) const;
+
   /**
    * A helper function to extract an object from an existing in-memory TFile
    * @param file a TFile instance
@@ -369,6 +437,11 @@ class CcdbApi //: public DatabaseInterface
   // Stores file associated with requestContext as a snapshot.
   void saveSnapshot(RequestContext& requestContext) const;
 
+  // Try to store the object as a block delta against the base version of its snapshot
+  // (delta mode only). Returns false when a full image should be written instead
+  // (no base yet, or the object diverged so much that the delta is not smaller).
+  bool trySaveSnapshotDelta(RequestContext& requestContext, std::string const& snapshotpath) const;
+
   // Schedules download via CCDBDownloader, but doesn't perform it until mUVLoop is ran.
   void scheduleDownload(RequestContext& requestContext, size_t* requestCounter) const;
 
@@ -424,6 +497,45 @@ class CcdbApi //: public DatabaseInterface
    * @param requestContext Structure giving details about the transfer.
    */
   void vectoredLoadFileToMemory(std::vector<RequestContext>& requestContext) const;
+
+  /**
+   * Element of a batch retrieval: the request fields are filled by the caller,
+   * blob and headers are filled by retrieveBatch. The typed object is
+   * deserialized on demand via extract.
+   */
+  struct BatchElement {
+    std::string path;
+    std::map<std::string, std::string> metadata{};
+    long timestamp = -1;
+    std::string etag{};
+    std::string createdNotAfter{};
+    std::string createdNotBefore{};
+    std::map<std::string, std::string> headers{}; // headers of the reply, filled on return
+    o2::pmr::vector<char> blob{};                 // downloaded content, filled on return
+
+    BatchElement() = default;
+    BatchElement(std::string p, std::map<std::string, std::string> m = {}, long ts = -1)
+      : path(std::move(p)), metadata(std::move(m)), timestamp(ts) {}
+
+    /// deserialize the downloaded blob, nullptr if the transfer failed or the type does not match
+    template <typename T>
+    T* extract()
+    {
+      return (blob.empty() || isMemoryFileInvalid(blob)) ? nullptr : extractFromMemoryBlob<T>(blob);
+    }
+  };
+
+  /**
+   * Retrieve several objects with all transfers overlapped through the multi-handle
+   * machinery of CCDBDownloader: elements available as local snapshots are served
+   * immediately, the remaining ones are downloaded in parallel. Returns when all
+   * elements are final; the objects are extracted lazily via BatchElement::extract,
+   * so the (single threaded) ROOT deserialization is not done before it is needed.
+   *
+   * @param elements Requests to serve, filled with the results on return.
+   * @param considerSnapshot Use/update the local snapshot cache if configured.
+   */
+  void retrieveBatch(std::vector<BatchElement>& elements, bool considerSnapshot = true) const;
 #endif
 
  private:
@@ -636,6 +748,7 @@ class CcdbApi //: public DatabaseInterface
   std::string mSnapshotTopPath{};    // root of the snaphot in the snapshot backend mode, i.e. with init("file://<dir>) call
   std::string mSnapshotCachePath{};  // root of the local snapshot (to fill or impose, even if not in the snapshot backend mode)
   bool mPreferSnapshotCache = false; // if snapshot is available, don't try to query its validity even in non-snapshot backend mode
+  bool mSnapshotDeltaEnabled = false; // store repeated snapshots of a path as block deltas against the first version (ALICEO2_CCDB_SNAPSHOT_DELTA)
   bool mInSnapshotMode = false;
   mutable TGrid* mAlienInstance = nullptr;                       // a cached connection to TGrid (needed for Alien locations)
   bool mNeedAlienToken = true;                                   // On EPN and FLP we use a local cache and don't need the alien token
@@ -0,0 +1,127 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CcdbFlatBlob.h
+/// \brief  Zero-deserialization CCDB storage for flat-copyable objects
+///
+
+#ifndef O2_CCDB_CCDBFLATBLOB_H
+#define O2_CCDB_CCDBFLATBLOB_H
+
+#include "CCDB/CcdbApi.h"
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace ccdb
+{
+
+/// Store and retrieve flat-copyable objects (classes implementing the FlatObject
+/// interface of GPU/Utils/FlatObject.h) as raw binary images instead of ROOT
+/// serialized TFiles. The image is a small header followed by the bytes of the
+/// class instance and of its flat buffer; restoring it is two memcpy's plus the
+/// pointer relocation the class provides for moving between processes, no
+/// TFile/TObject machinery is involved. The flat-object interface is duck-typed
+/// (getFlatBufferSize / getFlatBufferPtr / clearInternalBufferPtr /
+/// setActualBufferAddress / adoptInternalBuffer), so this header does not pull a
+/// dependency on the GPU utilities into CCDB.
+class CcdbFlatBlob
+{
+ public:
+  struct ImageHeader {
+    char magic[8] = {'O', '2', 'F', 'L', 'A', 'T', 'O', 'B'};
+    uint32_t version = 1;
+    uint32_t classSize = 0;  ///< sizeof of the stored class, consistency check on reading
+    uint64_t bufferSize = 0; ///< size of the flat buffer following the class instance
+  };
+  static_assert(sizeof(ImageHeader) == 24, "ImageHeader is part of the stored image layout");
+
+  /// check whether a memory region starts with a flat-blob image
+  static bool isFlatBlob(const char* data, size_t size)
+  {
+    ImageHeader ref{};
+    return data && size >= sizeof(ImageHeader) && std::memcmp(data, ref.magic, sizeof(ref.magic)) == 0;
+  }
+
+  /// serialize obj (instance + flat buffer) into a self-contained binary image
+  template <typename T>
+  static std::vector<char> createImage(const T& obj)
+  {
+    ImageHeader head;
+    head.classSize = sizeof(T);
+    head.bufferSize = obj.getFlatBufferSize();
+    std::vector<char> image(sizeof(ImageHeader) + sizeof(T) + head.bufferSize);
+    std::memcpy(image.data(), &head, sizeof(ImageHeader));
+    std::memcpy(image.data() + sizeof(ImageHeader), (const void*)&obj, sizeof(T));
+    std::memcpy(image.data() + sizeof(ImageHeader) + sizeof(T), obj.getFlatBufferPtr(), head.bufferSize);
+    return image;
+  }
+
+  /// restore an object from an image created by createImage, nullptr if the
+  /// image is not a flat blob or was written for a different class layout
+  template <typename T>
+  static T* extractImage(const char* data, size_t size)
+  {
+    if (!isFlatBlob(data, size)) {
+      return nullptr;
+    }
+    ImageHeader head;
+    std::memcpy(&head, data, sizeof(ImageHeader));
+    if (head.classSize != sizeof(T) || size < sizeof(ImageHeader) + sizeof(T) + head.bufferSize) {
+      return nullptr;
+    }
+    auto* obj = new T;
+    std::memcpy((void*)obj, data + sizeof(ImageHeader), sizeof(T));
+    obj->clearInternalBufferPtr(); // the container pointer of the writing process is meaningless here
+    char* buffer = new char[head.bufferSize];
+    std::memcpy(buffer, data + sizeof(ImageHeader) + sizeof(T), head.bufferSize);
+    obj->setActualBufferAddress(buffer); // relocate pointers from the writer's buffer base
+    obj->adoptInternalBuffer(buffer);    // pass the buffer ownership to the object
+    return obj;
+  }
+
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+  /// upload obj as a flat-blob image
+  template <typename T>
+  static int store(const CcdbApi& api, const T& obj, const std::string& path,
+                   const std::map<std::string, std::string>& metadata,
+                   long startValidityTimestamp, long endValidityTimestamp)
+  {
+    auto image = createImage(obj);
+    return api.storeAsBinaryFile(image.data(), image.size(), "flat_object.blob", "FlatObject",
+                                 path, metadata, startValidityTimestamp, endValidityTimestamp);
+  }
+
+  /// download and restore a flat-blob image, nullptr on failure
+  template <typename T>
+  static T* retrieve(const CcdbApi& api, const std::string& path,
+                     const std::map<std::string, std::string>& metadata, long timestamp,
+                     std::map<std::string, std::string>* headers = nullptr)
+  {
+    o2::pmr::vector<char> dest;
+    api.loadFileToMemory(dest, path, metadata, timestamp, headers, "", "", "");
+    if (dest.empty() || CcdbApi::isMemoryFileInvalid(dest)) {
+      return nullptr;
+    }
+    return extractImage<T>(dest.data(), dest.size());
+  }
+#endif
+};
+
+} // namespace ccdb
+} // namespace o2
+
+#endif // O2_CCDB_CCDBFLATBLOB_H
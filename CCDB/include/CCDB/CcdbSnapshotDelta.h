@@ -0,0 +1,85 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CcdbSnapshotDelta.h
+/// \brief  Block-delta encoding of CCDB snapshot files against a base version
+///
+
+#ifndef O2_CCDB_CCDBSNAPSHOTDELTA_H
+#define O2_CCDB_CCDBSNAPSHOTDELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+#include "MemoryResources/MemoryResources.h"
+#endif
+
+namespace o2
+{
+namespace ccdb
+{
+
+/**
+ * Delta codec for snapshots of slowly-evolving objects: successive versions of
+ * e.g. TPC scalers are nearly identical, so instead of a full image only the
+ * blocks differing from an immutable base version are stored, together with the
+ * reply headers of the original download. The delta references the base by size
+ * and hash, so a delta can never be applied to the wrong base. The format is
+ * self-contained and needs no external diff library: a fixed block grid over
+ * the object, a bitmap marking the blocks which differ from the base at the
+ * same offset, and the literal bytes of those blocks.
+ */
+class CcdbSnapshotDelta
+{
+ public:
+  static constexpr uint32_t BlockSize = 4096;
+
+  struct DeltaHeader {
+    char magic[8] = {'O', '2', 'C', 'D', 'B', 'D', 'L', 'T'};
+    uint32_t version = 1;
+    uint32_t blockSize = BlockSize;
+    uint64_t baseSize = 0;    ///< size of the base file the delta applies to
+    uint64_t baseHash = 0;    ///< FNV-1a hash of the base file, guards against a mismatched base
+    uint64_t objectSize = 0;  ///< size of the encoded object
+    uint64_t headersSize = 0; ///< size of the flattened reply headers stored after this header
+  };
+  static_assert(sizeof(DeltaHeader) == 48, "DeltaHeader is part of the stored file layout");
+
+  /// check whether a memory region starts with the delta magic (8 bytes suffice)
+  static bool isDelta(const char* data, size_t size);
+
+  /// FNV-1a hash used to fingerprint the base file
+  static uint64_t hash(const char* data, size_t size);
+
+  /// encode object against base; headers of the original download are embedded
+  /// so that the delta file is self-contained on the metadata side
+  static std::vector<char> encode(const char* base, size_t baseSize,
+                                  const char* object, size_t objectSize,
+                                  const std::map<std::string, std::string>& headers);
+
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
+  /// reconstruct the object from a delta and its base, optionally extracting
+  /// the embedded reply headers
+  /// @return false (with object cleared) if the delta is malformed or base does not match
+  static bool decode(const char* delta, size_t deltaSize, const char* base, size_t baseSize,
+                     o2::pmr::vector<char>& object, std::map<std::string, std::string>* headers = nullptr);
+#endif
+};
+
+} // namespace ccdb
+} // namespace o2
+
+#endif // O2_CCDB_CCDBSNAPSHOTDELTA_H
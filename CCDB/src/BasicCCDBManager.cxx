@@ -32,6 +32,113 @@ void CCDBManagerInstance::reportFatal(std::string_view err)
   LOG(fatal) << err;
 }
 
+bool CCDBManagerInstance::fetchBlobViaDiskCache(std::string const& path, long timestamp, std::string const& etagCached, o2::pmr::vector<char>& blob)
+{
+  if (timestamp < 0) {
+    timestamp = o2::ccdb::getCurrentTimestamp();
+  }
+  std::string etag;
+  if (!mCreatedNotAfter && !mCreatedNotBefore) {
+    // ask the server only for the headers: on a cache hit the body never crosses the network
+    mHeaders = mCCDBAccessor.retrieveHeaders(path, mMetaData, timestamp);
+    auto et = mHeaders.find("ETag");
+    if (et == mHeaders.end() || et->second.empty()) {
+      return false; // no such object
+    }
+    if (!etagCached.empty() && et->second == etagCached) {
+      return false; // the in-memory object is still valid
+    }
+    etag = et->second;
+    if (mDiskCache->load(etag, blob)) {
+      return true;
+    }
+  } // in TimeMachine mode the headers query cannot apply the creation constraints, download directly
+  std::map<std::string, std::string> headers;
+  mCCDBAccessor.loadFileToMemory(blob, path, mMetaData, timestamp, &headers, etagCached,
+                                 mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
+                                 mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "", false);
+  mHeaders = headers;
+  if (blob.empty() || CcdbApi::isMemoryFileInvalid(blob)) {
+    blob.clear();
+    return false; // not modified or error, reply headers tell the caller which
+  }
+  if (etag.empty()) {
+    auto et = headers.find("ETag");
+    etag = et != headers.end() ? et->second : std::string{};
+  }
+  if (!etag.empty()) {
+    mDiskCache->store(etag, blob);
+  }
+  return true;
+}
+
+int CCDBManagerInstance::prefetchForRange(const std::vector<std::string>& paths, long startTime, long endTime)
+{
+  if (!mDiskCache) {
+    LOG(alarm) << "CCDB prefetch requires the disk cache to be enabled, ignoring the request";
+    return -1;
+  }
+  if (mCreatedNotAfter || mCreatedNotBefore) {
+    LOG(alarm) << "CCDB prefetch is not available in TimeMachine mode, ignoring the request";
+    return -1;
+  }
+  // walk the validity timeline of every path with headers-only queries and collect
+  // the objects missing from the disk cache
+  std::vector<CcdbApi::BatchElement> toFetch;
+  std::vector<std::string> etags;
+  int nCached = 0;
+  for (const auto& path : paths) {
+    long t = startTime;
+    constexpr int MaxVersionsPerPath = 100000; // guard against a non-advancing timeline
+    for (int i = 0; t < endTime && i < MaxVersionsPerPath; i++) {
+      auto headers = mCCDBAccessor.retrieveHeaders(path, mMetaData, t);
+      auto et = headers.find("ETag");
+      if (et == headers.end() || et->second.empty()) {
+        break; // no object valid at t
+      }
+      if (mDiskCache->contains(et->second)) {
+        nCached++;
+      } else {
+        toFetch.emplace_back(path, mMetaData, t);
+        etags.push_back(et->second);
+      }
+      auto vu = headers.find("Valid-Until");
+      long until = vu != headers.end() ? boost::lexical_cast<int64_t>(vu->second) : -1L;
+      if (until <= t) {
+        break;
+      }
+      t = until;
+    }
+  }
+  int nFetched = 0;
+  if (!toFetch.empty()) {
+    mCCDBAccessor.retrieveBatch(toFetch); // all transfers overlapped
+    for (size_t i = 0; i < toFetch.size(); i++) {
+      auto& blob = toFetch[i].blob;
+      if (!blob.empty() && !CcdbApi::isMemoryFileInvalid(blob)) {
+        mDiskCache->store(etags[i], blob);
+        mFetchedSize += blob.size();
+        nFetched++;
+      } else {
+        LOGP(alarm, "CCDB prefetch of {} for timestamp {} failed", toFetch[i].path, toFetch[i].timestamp);
+      }
+    }
+  }
+  LOGP(info, "CCDB prefetch: {} objects downloaded, {} already cached for {} paths over [{},{})",
+       nFetched, nCached, paths.size(), startTime, endTime);
+  return nFetched;
+}
+
+int CCDBManagerInstance::prefetchForRun(const std::vector<std::string>& paths, int runnumber)
+{
+  auto rd = getRunDuration(runnumber, false);
+  if (rd.first < 0 || rd.second < rd.first) {
+    LOGP(alarm, "Cannot determine duration of run {}, prefetch not possible", runnumber);
+    return -1;
+  }
+  return prefetchForRange(paths, rd.first, rd.second + 1);
+}
+
 std::pair<int64_t, int64_t> CCDBManagerInstance::getRunDuration(const std::map<std::string, std::string>& headers)
 {
   if (headers.size() != 0) {
@@ -104,6 +211,9 @@ std::string CCDBManagerInstance::getSummaryString() const
     res += fmt::format(" for {} objects", mCache.size());
   }
   res += fmt::format(", {} good fetches (and {} failed ones", mFetches, mFailures);
+  if (mNegativeCacheHits) {
+    res += fmt::format(", {} retries suppressed by negative cache", mNegativeCacheHits);
+  }
   if (mCachingEnabled && mFailures) {
     int nfailObj = 0;
     for (const auto& obj : mCache) {
@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "CCDB/CCDBDiskCache.h"
+#include "CommonUtils/FileSystemUtils.h"
+#include <fairlogger/Logger.h>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace o2::ccdb;
+
+CCDBDiskCache::CCDBDiskCache(std::string cacheDir) : mCacheDir{std::move(cacheDir)}
+{
+  if (!mCacheDir.empty()) {
+    o2::utils::createDirectoriesIfAbsent(mCacheDir);
+  }
+}
+
+std::string CCDBDiskCache::keyToFileName(const std::string& etag)
+{
+  std::string name;
+  name.reserve(etag.size());
+  for (char c : etag) {
+    if (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.') {
+      name += c;
+    }
+  }
+  return name;
+}
+
+bool CCDBDiskCache::contains(const std::string& etag) const
+{
+  auto key = keyToFileName(etag);
+  if (mCacheDir.empty() || key.empty()) {
+    return false;
+  }
+  struct stat statbuf;
+  return stat((mCacheDir + '/' + key).c_str(), &statbuf) == 0 && statbuf.st_size > 0;
+}
+
+bool CCDBDiskCache::load(const std::string& etag, o2::pmr::vector<char>& dest) const
+{
+  auto key = keyToFileName(etag);
+  if (mCacheDir.empty() || key.empty()) {
+    return false;
+  }
+  auto path = mCacheDir + '/' + key;
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    mMisses++;
+    return false;
+  }
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) != 0 || statbuf.st_size == 0) {
+    close(fd);
+    mMisses++;
+    return false;
+  }
+  size_t size = statbuf.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    LOGP(warn, "Failed to mmap cached CCDB blob {}: {}", path, strerror(errno));
+    mMisses++;
+    return false;
+  }
+  dest.resize(size);
+  std::memcpy(dest.data(), addr, size);
+  munmap(addr, size);
+  mHits++;
+  return true;
+}
+
+void CCDBDiskCache::store(const std::string& etag, const o2::pmr::vector<char>& blob) const
+{
+  auto key = keyToFileName(etag);
+  if (mCacheDir.empty() || key.empty() || blob.empty()) {
+    return;
+  }
+  auto path = mCacheDir + '/' + key;
+  auto tmpPath = path + '.' + std::to_string(getpid()) + ".part";
+  auto fh = std::fopen(tmpPath.c_str(), "w");
+  if (!fh) {
+    LOGP(warn, "Failed to create CCDB cache file {}: {}", tmpPath, strerror(errno));
+    return;
+  }
+  auto ws = std::fwrite(blob.data(), 1, blob.size(), fh);
+  std::fclose(fh);
+  if (ws != blob.size() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    LOGP(warn, "Failed to publish CCDB cache file {}", path);
+    std::remove(tmpPath.c_str());
+  }
+}
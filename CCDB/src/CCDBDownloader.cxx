@@ -81,6 +81,17 @@ std::string uniqueAgentID()
 CCDBDownloader::CCDBDownloader(uv_loop_t* uv_loop)
   : mUserAgentId(uniqueAgentID())
 {
+  // node-level bandwidth budgeting: operators can cap the number of parallel connections
+  // and the per-connection download rate of all O2 processes sharing the uplink
+  char const* maxConnections = getenv("ALICEO2_CCDB_MAXCONNECTIONS");
+  if (maxConnections && atoi(maxConnections) > 0) {
+    mMaxHandlesInUse = atoi(maxConnections);
+  }
+  char const* maxRecvSpeed = getenv("ALICEO2_CCDB_MAXRECVSPEED");
+  if (maxRecvSpeed && atol(maxRecvSpeed) > 0) {
+    mMaxRecvSpeed = atol(maxRecvSpeed);
+  }
+
   if (uv_loop) {
     mExternalLoop = true;
     mUVLoop = uv_loop;
@@ -296,6 +307,11 @@ void CCDBDownloader::setMaxParallelConnections(int limit)
   mMaxHandlesInUse = limit;
 }
 
+void CCDBDownloader::setMaxRecvSpeed(long bytesPerSecond)
+{
+  mMaxRecvSpeed = bytesPerSecond;
+}
+
 void CCDBDownloader::setKeepaliveTimeoutTime(int timeoutMS)
 {
   mKeepaliveTimeoutMS = timeoutMS;
@@ -624,6 +640,7 @@ void CCDBDownloader::setHandleOptions(CURL* handle, PerformData* data)
   curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT_MS, mConnectionTimeoutMS));
   curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, mHappyEyeballsHeadstartMS));
   curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_USERAGENT, mUserAgentId.c_str()));
+  curlEasyErrorCheck(curl_easy_setopt(handle, CURLOPT_MAX_RECV_SPEED_LARGE, (curl_off_t)mMaxRecvSpeed));
 }
 
 void CCDBDownloader::checkHandleQueue()
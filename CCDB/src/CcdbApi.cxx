@@ -15,6 +15,7 @@
 ///
 
 #include "CCDB/CcdbApi.h"
+#include "CCDB/CcdbSnapshotDelta.h"
 #include "CCDB/CCDBQuery.h"
 
 #include "CommonUtils/StringUtils.h"
@@ -210,6 +211,11 @@ void CcdbApi::init(std::string const& host)
     }
     snapshotReport += ", prefer if available";
   }
+  if (cachedir && getenv("ALICEO2_CCDB_SNAPSHOT_DELTA")) {
+    // repeated snapshots of slowly-evolving objects are stored as block deltas against the first version
+    mSnapshotDeltaEnabled = true;
+    snapshotReport += ", delta encoded";
+  }
   if (!snapshotReport.empty()) {
     snapshotReport += ')';
   }
@@ -318,6 +324,21 @@ std::unique_ptr<std::vector<char>> CcdbApi::createObjectImage(const void* obj, s
   return o2::utils::MemFileHelper::createFileImage(obj, tinfo, tmpFileName, CCDBOBJECT_ENTRY);
 }
 
+size_t CcdbApi::createObjectImage(const void* obj, std::type_info const& tinfo, o2::pmr::vector<char>& dest, CcdbObjectInfo* info)
+{
+  // Create a binary image of the object directly in the destination buffer (e.g. a vector
+  // backed by the output message), if CcdbObjectInfo pointer is provided, register there
+  // the assigned object class name and the filename
+  std::lock_guard<std::mutex> guard(gIOMutex);
+  std::string className = o2::utils::MemFileHelper::getClassName(tinfo);
+  std::string tmpFileName = generateFileName(className);
+  if (info) {
+    info->setFileName(tmpFileName);
+    info->setObjectType(className);
+  }
+  return o2::utils::MemFileHelper::createFileImage(dest, obj, tinfo, tmpFileName, CCDBOBJECT_ENTRY);
+}
+
 std::unique_ptr<std::vector<char>> CcdbApi::createObjectImage(const TObject* rootObject, CcdbObjectInfo* info)
 {
   // Create a binary image of the object, if CcdbObjectInfo pointer is provided, register there
@@ -920,6 +941,20 @@ void* CcdbApi::extractFromLocalFile(std::string const& filename, std::type_info
     LOG(error) << "Local snapshot " << filename << " not found \n";
     return nullptr;
   }
+  {
+    char magicbuf[8] = {};
+    std::ifstream peek(filename, std::ios::binary);
+    peek.read(magicbuf, sizeof(magicbuf));
+    if (CcdbSnapshotDelta::isDelta(magicbuf, sizeof(magicbuf))) {
+      // delta-encoded snapshot: reconstruct in memory and extract from there
+      o2::pmr::vector<char> blob;
+      loadFileToMemory(blob, filename, headers);
+      if (blob.empty() || isMemoryFileInvalid(blob)) {
+        return nullptr;
+      }
+      return interpretAsTMemFileAndExtract(blob.data(), blob.size(), tinfo);
+    }
+  }
   std::lock_guard<std::mutex> guard(gIOMutex);
   auto tcl = tinfo2TClass(tinfo);
   TFile f(filename.c_str(), "READ");
@@ -1493,6 +1528,69 @@ std::map<std::string, std::string> CcdbApi::retrieveHeaders(std::string const& p
   return do_remote_header_call();
 }
 
+bool CcdbApi::checkObjectUpToDate(UpdateCheck& check) const
+{
+  std::vector<UpdateCheck> checks;
+  checks.emplace_back(std::move(check));
+  checkBatchUpToDate(checks);
+  check = std::move(checks.front());
+  return check.upToDate;
+}
+
+void CcdbApi::checkBatchUpToDate(std::vector<UpdateCheck>& checks) const
+{
+  CURLM* multiHandle = curl_multi_init();
+  std::vector<CURL*> handles;
+  std::vector<curl_slist*> optionLists;
+  for (auto& check : checks) {
+    check.exists = check.upToDate = false;
+    check.headers.clear();
+    CURL* curl = curl_easy_init();
+    if (curl == nullptr) {
+      continue;
+    }
+    std::string fullUrl = getFullUrlForRetrieval(curl, check.path, check.metadata, check.timestamp);
+    curl_slist* optionList = nullptr;
+    initCurlHTTPHeaderOptionsForRetrieve(curl, optionList, check.timestamp, nullptr, check.etag, check.createdNotAfter, check.createdNotBefore);
+    curl_easy_setopt(curl, CURLOPT_URL, fullUrl.c_str());
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_map_callback<>);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &check.headers);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, &check);
+    curlSetSSLOptions(curl);
+    curl_multi_add_handle(multiHandle, curl);
+    handles.push_back(curl);
+    optionLists.push_back(optionList);
+  }
+  int handlesRunning = 0;
+  do {
+    curl_multi_perform(multiHandle, &handlesRunning);
+    if (handlesRunning) {
+      curl_multi_wait(multiHandle, nullptr, 0, 1000, nullptr);
+    }
+  } while (handlesRunning);
+  for (size_t i = 0; i < handles.size(); i++) {
+    UpdateCheck* check = nullptr;
+    curl_easy_getinfo(handles[i], CURLINFO_PRIVATE, &check);
+    long httpCode = 404;
+    curl_easy_getinfo(handles[i], CURLINFO_RESPONSE_CODE, &httpCode);
+    if (httpCode == 304) {
+      // the version known to the caller is still the current one
+      check->exists = check->upToDate = true;
+    } else if (httpCode != 404 && check->headers.count("ETag") && !check->headers["ETag"].empty()) {
+      check->exists = true;
+      check->upToDate = !check->etag.empty() && check->headers["ETag"] == check->etag;
+    }
+    curl_multi_remove_handle(multiHandle, handles[i]);
+    curl_easy_cleanup(handles[i]);
+    if (optionLists[i]) {
+      curl_slist_free_all(optionLists[i]);
+    }
+  }
+  curl_multi_cleanup(multiHandle);
+}
+
 bool CcdbApi::getCCDBEntryHeaders(std::string const& url, std::string const& etag, std::vector<std::string>& headers, const std::string& agentID)
 {
   auto curl = curl_easy_init();
@@ -1857,6 +1955,9 @@ void CcdbApi::saveSnapshot(RequestContext& requestContext) const
     if (logStream.is_open()) {
       logStream << "CCDB-access[" << getpid() << "] ... " << mUniqueAgentID << " downloading to snapshot " << snapshotpath << " from memory\n";
     }
+    if (mSnapshotDeltaEnabled && trySaveSnapshotDelta(requestContext, snapshotpath)) {
+      return;
+    }
     { // dump image to a file
       LOGP(debug, "creating snapshot {} -> {}", requestContext.path, snapshotpath);
       CCDBQuery querysummary(requestContext.path, requestContext.metadata, requestContext.timestamp);
@@ -1870,6 +1971,54 @@ void CcdbApi::saveSnapshot(RequestContext& requestContext) const
   }
 }
 
+bool CcdbApi::trySaveSnapshotDelta(RequestContext& requestContext, std::string const& snapshotpath) const
+{
+  // the first stored version of a path is kept as immutable base, later versions are
+  // encoded as block deltas against it (caller holds the snapshot semaphore)
+  std::string basepath = snapshotpath + ".base";
+  std::error_code ec;
+  if (!std::filesystem::exists(basepath) && std::filesystem::exists(snapshotpath)) {
+    char magicbuf[8] = {};
+    std::ifstream prev(snapshotpath, std::ios::binary);
+    prev.read(magicbuf, sizeof(magicbuf));
+    if (CcdbSnapshotDelta::isDelta(magicbuf, sizeof(magicbuf))) {
+      return false; // delta without its base, overwrite with a full image
+    }
+    std::filesystem::rename(snapshotpath, basepath, ec); // promote the previous full snapshot to base
+    if (ec) {
+      return false;
+    }
+  }
+  if (!std::filesystem::exists(basepath)) {
+    return false; // first version of this path, store the full image
+  }
+  std::vector<char> base;
+  {
+    std::ifstream baseFile(basepath, std::ios::binary | std::ios::ate);
+    auto size = baseFile.tellg();
+    if (!baseFile.good() || size <= 0) {
+      return false;
+    }
+    base.resize(size);
+    baseFile.seekg(0);
+    baseFile.read(base.data(), base.size());
+    if (!baseFile.good()) {
+      return false;
+    }
+  }
+  auto delta = CcdbSnapshotDelta::encode(base.data(), base.size(),
+                                         requestContext.dest.data(), requestContext.dest.size(),
+                                         requestContext.headers);
+  if (delta.size() >= requestContext.dest.size()) {
+    return false; // object diverged from the base, a full image is cheaper
+  }
+  LOGP(debug, "creating delta snapshot {} -> {} ({} instead of {} bytes)",
+       requestContext.path, snapshotpath, delta.size(), requestContext.dest.size());
+  std::ofstream objFile(snapshotpath, std::ios::out | std::ofstream::binary | std::ios::trunc);
+  std::copy(delta.begin(), delta.end(), std::ostreambuf_iterator<char>(objFile));
+  return objFile.good();
+}
+
 void CcdbApi::loadFileToMemory(o2::pmr::vector<char>& dest, std::string const& path,
                                std::map<std::string, std::string> const& metadata, long timestamp,
                                std::map<std::string, std::string>* headers, std::string const& etag,
@@ -1953,6 +2102,22 @@ void CcdbApi::vectoredLoadFileToMemory(std::vector<RequestContext>& requestConte
   }
 }
 
+void CcdbApi::retrieveBatch(std::vector<BatchElement>& elements, bool considerSnapshot) const
+{
+  std::vector<RequestContext> contexts;
+  contexts.reserve(elements.size());
+  for (auto& element : elements) {
+    auto& context = contexts.emplace_back(element.blob, element.metadata, element.headers);
+    context.path = element.path;
+    context.timestamp = element.timestamp;
+    context.etag = element.etag;
+    context.createdNotAfter = element.createdNotAfter;
+    context.createdNotBefore = element.createdNotBefore;
+    context.considerSnapshot = considerSnapshot;
+  }
+  vectoredLoadFileToMemory(contexts);
+}
+
 bool CcdbApi::loadLocalContentToMemory(o2::pmr::vector<char>& dest, std::string& url) const
 {
   if (url.find("alien:/", 0) != std::string::npos) {
@@ -2017,6 +2182,30 @@ void CcdbApi::loadFileToMemory(o2::pmr::vector<char>& dest, const std::string& p
     totalread += nread;
   } while (nread == (long)MaxCopySize);
 
+  if (CcdbSnapshotDelta::isDelta(dest.data(), dest.size())) {
+    // delta-encoded snapshot: reconstruct the object from the base version; the
+    // reply headers of the original download are embedded in the delta
+    std::vector<char> base;
+    std::ifstream baseFile(path + ".base", std::ios::binary | std::ios::ate);
+    auto baseSize = baseFile.tellg();
+    if (baseFile.good() && baseSize > 0) {
+      base.resize(baseSize);
+      baseFile.seekg(0);
+      baseFile.read(base.data(), base.size());
+    }
+    o2::pmr::vector<char> object;
+    std::map<std::string, std::string> embeddedHeaders;
+    if (!baseFile.good() || !CcdbSnapshotDelta::decode(dest.data(), dest.size(), base.data(), base.size(), object, &embeddedHeaders)) {
+      LOG(error) << "Failed to reconstruct delta-encoded snapshot " << path;
+      signalError();
+      return;
+    }
+    dest.swap(object);
+    if (localHeaders) {
+      *localHeaders = embeddedHeaders;
+    }
+  }
+
   if (localHeaders) {
     TMemFile memFile("name", const_cast<char*>(dest.data()), dest.size(), "READ");
     auto storedmeta = (std::map<std::string, std::string>*)extractFromTFile(memFile, TClass::GetClass("std::map<std::string, std::string>"), CCDBMETA_ENTRY);
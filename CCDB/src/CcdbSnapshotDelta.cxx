@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "CCDB/CcdbSnapshotDelta.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace o2::ccdb;
+
+bool CcdbSnapshotDelta::isDelta(const char* data, size_t size)
+{
+  DeltaHeader ref{};
+  return data && size >= sizeof(ref.magic) && std::memcmp(data, ref.magic, sizeof(ref.magic)) == 0;
+}
+
+uint64_t CcdbSnapshotDelta::hash(const char* data, size_t size)
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; i++) {
+    h = (h ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+std::vector<char> CcdbSnapshotDelta::encode(const char* base, size_t baseSize,
+                                            const char* object, size_t objectSize,
+                                            const std::map<std::string, std::string>& headers)
+{
+  DeltaHeader head;
+  head.baseSize = baseSize;
+  head.baseHash = hash(base, baseSize);
+  head.objectSize = objectSize;
+  std::string flatHeaders;
+  for (const auto& h : headers) {
+    flatHeaders += h.first;
+    flatHeaders += '\0';
+    flatHeaders += h.second;
+    flatHeaders += '\0';
+  }
+  head.headersSize = flatHeaders.size();
+
+  size_t nBlocks = (objectSize + BlockSize - 1) / BlockSize;
+  std::vector<char> out(sizeof(DeltaHeader));
+  std::memcpy(out.data(), &head, sizeof(DeltaHeader));
+  out.insert(out.end(), flatHeaders.begin(), flatHeaders.end());
+  size_t bitmapPos = out.size();
+  out.resize(out.size() + (nBlocks + 7) / 8, 0);
+  for (size_t i = 0; i < nBlocks; i++) {
+    size_t offset = i * BlockSize;
+    size_t len = std::min<size_t>(BlockSize, objectSize - offset);
+    if (offset + len > baseSize || std::memcmp(object + offset, base + offset, len) != 0) {
+      out[bitmapPos + i / 8] |= static_cast<char>(1u << (i % 8)); // literal block
+      out.insert(out.end(), object + offset, object + offset + len);
+    }
+  }
+  return out;
+}
+
+bool CcdbSnapshotDelta::decode(const char* delta, size_t deltaSize, const char* base, size_t baseSize,
+                               o2::pmr::vector<char>& object, std::map<std::string, std::string>* headers)
+{
+  object.clear();
+  if (!isDelta(delta, deltaSize) || deltaSize < sizeof(DeltaHeader)) {
+    return false;
+  }
+  DeltaHeader head;
+  std::memcpy(&head, delta, sizeof(DeltaHeader));
+  if (head.version != 1 || head.blockSize == 0 ||
+      head.baseSize != baseSize || head.baseHash != hash(base, baseSize)) {
+    return false;
+  }
+  size_t nBlocks = (head.objectSize + head.blockSize - 1) / head.blockSize;
+  size_t bitmapPos = sizeof(DeltaHeader) + head.headersSize;
+  size_t literalPos = bitmapPos + (nBlocks + 7) / 8;
+  if (literalPos > deltaSize) {
+    return false;
+  }
+  object.resize(head.objectSize);
+  for (size_t i = 0; i < nBlocks; i++) {
+    size_t offset = i * head.blockSize;
+    size_t len = std::min<size_t>(head.blockSize, head.objectSize - offset);
+    if (delta[bitmapPos + i / 8] & static_cast<char>(1u << (i % 8))) {
+      if (literalPos + len > deltaSize) {
+        object.clear();
+        return false;
+      }
+      std::memcpy(object.data() + offset, delta + literalPos, len);
+      literalPos += len;
+    } else {
+      if (offset + len > baseSize) {
+        object.clear();
+        return false;
+      }
+      std::memcpy(object.data() + offset, base + offset, len);
+    }
+  }
+  if (headers) {
+    headers->clear();
+    const char* ptr = delta + sizeof(DeltaHeader);
+    const char* end = ptr + head.headersSize;
+    while (ptr < end) {
+      std::string key(ptr);
+      ptr += key.size() + 1;
+      if (ptr >= end) {
+        break;
+      }
+      std::string value(ptr);
+      ptr += value.size() + 1;
+      (*headers)[key] = value;
+    }
+  }
+  return true;
+}
@@ -21,8 +21,11 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/BasicCCDBManager.h"
+#include "CCDB/CCDBDiskCache.h"
 #include "Framework/Logger.h"
 #include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <filesystem>
 
 using namespace o2::ccdb;
 
@@ -102,6 +105,18 @@ BOOST_AUTO_TEST_CASE(TestBasicCCDBManager)
   objA = cdb.getForTimeStamp<std::string>(pathA, start - (stop - start) / 2); // wrong time
   LOG(info) << "Read for wrong time, expect null: " << objA;
   BOOST_CHECK(objA == nullptr);
+
+  // negative-result caching: within the TTL a repeated query of the failed path is answered locally
+  cdb.setNegativeCacheTTL(60000);
+  objA = cdb.getForTimeStamp<std::string>(pathA, start - (stop - start) / 2);
+  BOOST_CHECK(objA == nullptr);
+  BOOST_CHECK_EQUAL(cdb.getNegativeCacheHits(), 0); // this failure went to the server
+  objA = cdb.getForTimeStamp<std::string>(pathA, start - (stop - start) / 2);
+  BOOST_CHECK(objA == nullptr);
+  BOOST_CHECK_EQUAL(cdb.getNegativeCacheHits(), 1); // the retry was suppressed
+  cdb.setNegativeCacheTTL(0);
+  cdb.clearCache(pathA); // drop the negative entry before the positive queries below
+
   cdb.setFatalWhenNull(true);
   objA = cdb.get<std::string>(pathA); // cache again
   LOG(info) << "Reading of A from scratch after error: " << *objA;
@@ -156,4 +171,40 @@ BOOST_AUTO_TEST_CASE(TestBasicCCDBManager)
   objA = cdb.get<std::string>(pathA); // will be loaded from scratch
   LOG(info) << "Reading A again, it should not be cached: " << *objA;
   BOOST_CHECK(objA && (*objA) != hack); // make sure correct object is loaded
+
+  // run-scoped prefetch: all versions in the range go to the disk cache in one transfer
+  std::string cacheDir = std::string("/tmp/o2diskcache_mgr_") + std::to_string(getpid());
+  cdb.setDiskCachePath(cacheDir);
+  auto nFetched = cdb.prefetchForRange({pathA, pathB}, start, stop + (stop - start));
+  LOG(info) << "Prefetched " << nFetched << " objects";
+  BOOST_CHECK_EQUAL(nFetched, 3);                                              // 2 versions of A, 1 of B
+  BOOST_CHECK_EQUAL(cdb.prefetchForRange({pathA, pathB}, start, stop + (stop - start)), 0); // everything cached now
+  cdb.setDiskCachePath("");
+  std::filesystem::remove_all(cacheDir);
+}
+
+BOOST_AUTO_TEST_CASE(TestCCDBDiskCache)
+{
+  // offline test of the content-addressed blob cache, no server involved
+  std::string cacheDir = std::string("/tmp/o2diskcache_") + std::to_string(getpid());
+  CCDBDiskCache cache(cacheDir);
+  BOOST_CHECK(cache.isActive());
+
+  // the ETag is reduced to a safe file name
+  BOOST_CHECK_EQUAL(CCDBDiskCache::keyToFileName("\"6dca2a8a-1e07-11ec-8efb-200114580202\""), "6dca2a8a-1e07-11ec-8efb-200114580202");
+  BOOST_CHECK(CCDBDiskCache::keyToFileName("../../../etc/passwd").find('/') == std::string::npos);
+
+  std::string etag = "\"deadbeef-0000-1111-2222-333344445555\"";
+  o2::pmr::vector<char> blob, back;
+  for (int i = 0; i < 1000; i++) {
+    blob.push_back(char(i % 251));
+  }
+  BOOST_CHECK(!cache.load(etag, back)); // not stored yet
+  cache.store(etag, blob);
+  BOOST_REQUIRE(cache.load(etag, back));
+  BOOST_CHECK(back.size() == blob.size() && std::memcmp(back.data(), blob.data(), blob.size()) == 0);
+  BOOST_CHECK_EQUAL(cache.getHits(), 1);
+  BOOST_CHECK_EQUAL(cache.getMisses(), 1);
+
+  std::filesystem::remove_all(cacheDir);
 }
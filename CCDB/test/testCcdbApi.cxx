@@ -20,6 +20,8 @@
 #define BOOST_TEST_DYN_LINK
 
 #include "CCDB/CcdbApi.h"
+#include "CCDB/CcdbFlatBlob.h"
+#include "CCDB/CcdbSnapshotDelta.h"
 #include "CCDB/IdPath.h"    // just as test object
 #include "CommonUtils/RootChain.h" // just as test object
 #include "CCDB/CCDBTimeStampUtils.h"
@@ -491,6 +493,39 @@ BOOST_AUTO_TEST_CASE(TestRetrieveHeaders, *utf::precondition(if_reachable()))
   BOOST_CHECK_EQUAL(headers.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(checkUpToDate_test, *utf::precondition(if_reachable()))
+{
+  test_fixture f;
+
+  TH1F h1("uptodate", "uptodate", 100, 0, 99);
+  map<string, string> metadata;
+  f.api.storeAsTFile(&h1, basePath + "UpToDate", metadata);
+
+  auto headers = f.api.retrieveHeaders(basePath + "UpToDate", metadata);
+  BOOST_REQUIRE(!headers["ETag"].empty());
+
+  // the cached version is confirmed without transferring any body
+  CcdbApi::UpdateCheck check(basePath + "UpToDate", metadata, -1, headers["ETag"]);
+  BOOST_CHECK(f.api.checkObjectUpToDate(check));
+  BOOST_CHECK(check.exists);
+
+  // a stale ETag reports the existence of a newer version
+  CcdbApi::UpdateCheck stale(basePath + "UpToDate", metadata, -1, "\"00000000-0000-0000-0000-000000000000\"");
+  BOOST_CHECK(!f.api.checkObjectUpToDate(stale));
+  BOOST_CHECK(stale.exists);
+  BOOST_CHECK_EQUAL(stale.headers["ETag"], headers["ETag"]);
+
+  // batched poll: one current, one stale, one inexistent path
+  std::vector<CcdbApi::UpdateCheck> checks;
+  checks.emplace_back(basePath + "UpToDate", metadata, -1, headers["ETag"]);
+  checks.emplace_back(basePath + "UpToDate", metadata, -1, "\"00000000-0000-0000-0000-000000000000\"");
+  checks.emplace_back(basePath + "DoesNotExist", metadata, -1, "");
+  f.api.checkBatchUpToDate(checks);
+  BOOST_CHECK(checks[0].upToDate);
+  BOOST_CHECK(checks[1].exists && !checks[1].upToDate);
+  BOOST_CHECK(!checks[2].exists);
+}
+
 BOOST_AUTO_TEST_CASE(TestUpdateMetadata, *utf::precondition(if_reachable()))
 {
   test_fixture f;
@@ -589,4 +624,108 @@ BOOST_AUTO_TEST_CASE(vectored)
   for (auto context : contexts) {
     BOOST_CHECK(context.dest.size() != 0);
   }
+}
+
+BOOST_AUTO_TEST_CASE(retrieveBatch_test, *utf::precondition(if_reachable()))
+{
+  test_fixture f;
+
+  TH1F h1("batchth1", "batchth1", 100, 0, 99);
+  h1.FillRandom("gaus", 10000);
+  f.api.storeAsTFile(&h1, basePath + "batchth1", f.metadata);
+  TGraph graph(10);
+  graph.SetPoint(0, 2, 3);
+  f.api.storeAsTFile(&graph, basePath + "batchgraph", f.metadata);
+
+  std::vector<CcdbApi::BatchElement> elements;
+  elements.emplace_back(basePath + "batchth1", f.metadata);
+  elements.emplace_back(basePath + "batchgraph", f.metadata);
+  f.api.retrieveBatch(elements);
+
+  for (auto& element : elements) {
+    BOOST_CHECK(element.blob.size() != 0);
+  }
+  auto* h1back = elements[0].extract<TH1F>();
+  BOOST_REQUIRE(h1back != nullptr);
+  BOOST_CHECK_EQUAL(h1back->GetNbinsX(), h1.GetNbinsX());
+  auto* graphback = elements[1].extract<TGraph>();
+  BOOST_REQUIRE(graphback != nullptr);
+  BOOST_CHECK_EQUAL(graphback->GetN(), graph.GetN());
+}
+
+// minimal class implementing the flat-object interface, to exercise the
+// flat-blob image round trip without pulling the GPU utilities into the test
+struct FlatMock {
+  ~FlatMock() { delete[] mOwnedBuffer; }
+  size_t getFlatBufferSize() const { return mBufferSize; }
+  const char* getFlatBufferPtr() const { return mBufferPtr; }
+  void clearInternalBufferPtr() { mOwnedBuffer = nullptr; }
+  void setActualBufferAddress(char* buffer) { mBufferPtr = buffer; }
+  void adoptInternalBuffer(char* buffer)
+  {
+    mBufferPtr = buffer;
+    mOwnedBuffer = buffer;
+  }
+  int mPayload = 0;
+  size_t mBufferSize = 0;
+  char* mBufferPtr = nullptr;
+  char* mOwnedBuffer = nullptr;
+};
+
+BOOST_AUTO_TEST_CASE(ccdbFlatBlob_image_test)
+{
+  // offline round trip of the flat-blob image, no server involved
+  std::vector<char> buffer(256);
+  for (size_t i = 0; i < buffer.size(); i++) {
+    buffer[i] = char(i);
+  }
+  FlatMock mock;
+  mock.mPayload = 0x600df1a7;
+  mock.mBufferSize = buffer.size();
+  mock.mBufferPtr = buffer.data();
+
+  auto image = CcdbFlatBlob::createImage(mock);
+  BOOST_CHECK_EQUAL(image.size(), sizeof(CcdbFlatBlob::ImageHeader) + sizeof(FlatMock) + buffer.size());
+  BOOST_CHECK(CcdbFlatBlob::isFlatBlob(image.data(), image.size()));
+
+  auto* back = CcdbFlatBlob::extractImage<FlatMock>(image.data(), image.size());
+  BOOST_REQUIRE(back != nullptr);
+  BOOST_CHECK_EQUAL(back->mPayload, mock.mPayload);
+  BOOST_CHECK_EQUAL(back->mBufferSize, buffer.size());
+  BOOST_CHECK(back->mBufferPtr != buffer.data());    // own copy of the buffer
+  BOOST_CHECK(back->mBufferPtr == back->mOwnedBuffer); // buffer ownership taken over
+  BOOST_CHECK(std::memcmp(back->mBufferPtr, buffer.data(), buffer.size()) == 0);
+  delete back;
+
+  // truncated or foreign images must be rejected
+  BOOST_CHECK(CcdbFlatBlob::extractImage<FlatMock>(image.data(), image.size() - 1) == nullptr);
+  BOOST_CHECK(!CcdbFlatBlob::isFlatBlob(buffer.data(), buffer.size()));
+}
+
+BOOST_AUTO_TEST_CASE(snapshotDelta_codec_test)
+{
+  // offline round trip of the snapshot delta codec, no server involved
+  std::vector<char> base(3 * CcdbSnapshotDelta::BlockSize + 100);
+  for (size_t i = 0; i < base.size(); i++) {
+    base[i] = char(i % 251);
+  }
+  auto current = base;
+  current[CcdbSnapshotDelta::BlockSize + 10] ^= 0x5a; // touch one block
+  current.resize(current.size() + 50, 7);             // and grow the tail
+  std::map<std::string, std::string> headers{{"ETag", "\"abc\""}, {"Valid-Until", "123456"}};
+
+  auto delta = CcdbSnapshotDelta::encode(base.data(), base.size(), current.data(), current.size(), headers);
+  BOOST_CHECK(CcdbSnapshotDelta::isDelta(delta.data(), delta.size()));
+  BOOST_CHECK(delta.size() < current.size()); // only the touched blocks are stored
+
+  o2::pmr::vector<char> restored;
+  std::map<std::string, std::string> headersBack;
+  BOOST_REQUIRE(CcdbSnapshotDelta::decode(delta.data(), delta.size(), base.data(), base.size(), restored, &headersBack));
+  BOOST_CHECK(restored.size() == current.size() && std::memcmp(restored.data(), current.data(), current.size()) == 0);
+  BOOST_CHECK(headersBack == headers);
+
+  // a delta never applies to a base it was not made from
+  auto wrongBase = base;
+  wrongBase[0] ^= 1;
+  BOOST_CHECK(!CcdbSnapshotDelta::decode(delta.data(), delta.size(), wrongBase.data(), wrongBase.size(), restored));
 }
\ No newline at end of file
@@ -375,5 +375,20 @@ BOOST_AUTO_TEST_CASE(trim_host_url_test)
   BOOST_CHECK_EQUAL(downloader.trimHostUrl("http://localhost:8080/Task/Detector/1?HTTPOnly=true"), "http://localhost:8080");
 }
 
+BOOST_AUTO_TEST_CASE(bandwidth_limits_env_test)
+{
+  // the node-level bandwidth budget is picked up from the environment at construction
+  setenv("ALICEO2_CCDB_MAXCONNECTIONS", "2", 1);
+  setenv("ALICEO2_CCDB_MAXRECVSPEED", "1048576", 1);
+  {
+    CCDBDownloader downloader;
+    BOOST_CHECK_EQUAL(downloader.mMaxHandlesInUse, 2);
+  }
+  unsetenv("ALICEO2_CCDB_MAXCONNECTIONS");
+  unsetenv("ALICEO2_CCDB_MAXRECVSPEED");
+  CCDBDownloader downloader;
+  BOOST_CHECK_EQUAL(downloader.mMaxHandlesInUse, 3);
+}
+
 } // namespace ccdb
 } // namespace o2
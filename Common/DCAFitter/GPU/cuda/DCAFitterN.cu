@@ -258,6 +258,83 @@ void processBulk(const int nBlocks,
   }
 }
 
+template <typename Fitter, class... Tr>
+void processBatch(std::vector<Fitter>& fitters,
+                  std::vector<int>& results,
+                  std::vector<Tr>&... args)
+{
+  // production variant of processBulk: chunking and stream management are internal and no
+  // benchmarking is done, the results of each chunk land in the host arrays as soon as its
+  // stream completes
+  constexpr unsigned int ChunkSize = 16384; // candidates per chunk, each chunk is pipelined on its own stream
+  constexpr int nBlocks = 40, nThreads = 256;
+  auto* gpuInterface = GPUInterface::Instance();
+  kernel::warmUpGpuKernel<<<1, 1, 0, gpuInterface->getNextStream()>>>();
+  const unsigned int totalSize = fitters.size();
+  results.resize(totalSize);
+  if (totalSize == 0) {
+    return;
+  }
+
+  // Tracks
+  std::array<o2::track::TrackParCov*, Fitter::getNProngs()> tracks_device;
+  int iArg{0};
+  ([&] {
+    gpuInterface->registerBuffer(reinterpret_cast<void*>(args.data()), sizeof(Tr) * args.size());
+    gpuInterface->allocDevice(reinterpret_cast<void**>(&(tracks_device[iArg])), sizeof(Tr) * args.size());
+    ++iArg;
+  }(),
+   ...);
+
+  // Fitters
+  gpuInterface->registerBuffer(reinterpret_cast<void*>(fitters.data()), sizeof(Fitter) * totalSize);
+  Fitter* fitters_device;
+  gpuInterface->allocDevice(reinterpret_cast<void**>(&fitters_device), sizeof(Fitter) * totalSize);
+
+  // Results
+  gpuInterface->registerBuffer(reinterpret_cast<void*>(results.data()), sizeof(int) * totalSize);
+  int* results_device;
+  gpuInterface->allocDevice(reinterpret_cast<void**>(&results_device), sizeof(int) * totalSize);
+
+  for (unsigned int offset{0}; offset < totalSize; offset += ChunkSize) {
+    const unsigned int nFits = std::min(ChunkSize, totalSize - offset);
+    auto& stream = gpuInterface->getNextStream();
+
+    gpuCheckError(cudaMemcpyAsync(fitters_device + offset, fitters.data() + offset, sizeof(Fitter), cudaMemcpyHostToDevice, stream)); // copying just the first fitter of the chunk
+    iArg = 0;
+    ([&] {
+      gpuCheckError(cudaMemcpyAsync(tracks_device[iArg] + offset, args.data() + offset, sizeof(Tr) * nFits, cudaMemcpyHostToDevice, stream));
+      ++iArg;
+    }(),
+     ...);
+
+    kernel::initFitters<<<nBlocks, nThreads, 0, stream>>>(fitters_device, offset, nFits);
+    std::apply([&](auto&&... args) { kernel::processBatchKernel<<<nBlocks, nThreads, 0, stream>>>(fitters_device, results_device, offset, nFits, args...); }, tracks_device);
+    gpuCheckError(cudaPeekAtLastError());
+
+    iArg = 0;
+    ([&] {
+      gpuCheckError(cudaMemcpyAsync(args.data() + offset, tracks_device[iArg] + offset, sizeof(Tr) * nFits, cudaMemcpyDeviceToHost, stream));
+      ++iArg;
+    }(),
+     ...);
+    gpuCheckError(cudaMemcpyAsync(fitters.data() + offset, fitters_device + offset, sizeof(Fitter) * nFits, cudaMemcpyDeviceToHost, stream));
+    gpuCheckError(cudaMemcpyAsync(results.data() + offset, results_device + offset, sizeof(int) * nFits, cudaMemcpyDeviceToHost, stream));
+  }
+  gpuCheckError(cudaDeviceSynchronize());
+
+  ([&] { gpuInterface->unregisterBuffer(args.data()); }(), ...);
+
+  for (auto* tracksD : tracks_device) {
+    gpuInterface->freeDevice(tracksD);
+  }
+
+  gpuInterface->freeDevice(fitters_device);
+  gpuInterface->freeDevice(results_device);
+  gpuInterface->unregisterBuffer(fitters.data());
+  gpuInterface->unregisterBuffer(results.data());
+}
+
 template void processBulk(const int,
                           const int,
                           const int,
@@ -273,6 +350,15 @@ template void processBulk(const int,
                           std::vector<o2::track::TrackParCov>&,
                           std::vector<o2::track::TrackParCov>&,
                           std::vector<o2::track::TrackParCov>&);
+template void processBatch(std::vector<o2::vertexing::DCAFitterN<2>>&,
+                           std::vector<int>&,
+                           std::vector<o2::track::TrackParCov>&,
+                           std::vector<o2::track::TrackParCov>&);
+template void processBatch(std::vector<o2::vertexing::DCAFitterN<3>>&,
+                           std::vector<int>&,
+                           std::vector<o2::track::TrackParCov>&,
+                           std::vector<o2::track::TrackParCov>&,
+                           std::vector<o2::track::TrackParCov>&);
 template int process(const int, const int, o2::vertexing::DCAFitterN<2>&, o2::track::TrackParCov&, o2::track::TrackParCov&);
 template int process(const int, const int, o2::vertexing::DCAFitterN<3>&, o2::track::TrackParCov&, o2::track::TrackParCov&, o2::track::TrackParCov&);
 template void print(const int, const int, o2::vertexing::DCAFitterN<2>&);
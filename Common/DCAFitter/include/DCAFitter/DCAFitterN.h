@@ -1143,6 +1143,14 @@ int process(const int nBlocks, const int nThreads, Fitter&, Tr&... args);
 
 template <class Fitter, class... Tr>
 void processBulk(const int nBlocks, const int nThreads, const int nBatches, std::vector<Fitter>& fitters, std::vector<int>& results, std::vector<Tr>&... args);
+
+/// Production batch entry point: the candidates are staged in per-prong SoA arrays, split in fixed-size
+/// chunks pipelined on the interface streams, and the results land in the host arrays chunk by chunk as
+/// the corresponding stream completes. The first fitter carries the configuration and is broadcast to the
+/// batch on the device; on return each fitter holds the fit results of its candidate and results[i] is
+/// the number of vertices found for candidate i.
+template <class Fitter, class... Tr>
+void processBatch(std::vector<Fitter>& fitters, std::vector<int>& results, std::vector<Tr>&... args);
 } // namespace device
 
 } // namespace vertexing
@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldBatchService.h
+/// \brief Batched magnetic field evaluation for simulation stepping
+
+#ifndef ALICEO2_FIELD_MAGFIELDBATCHSERVICE_H_
+#define ALICEO2_FIELD_MAGFIELDBATCHSERVICE_H_
+
+#include "Field/MagneticField.h"
+#include <unordered_map>
+#include <array>
+#include <vector>
+
+namespace o2
+{
+namespace field
+{
+
+/// Service evaluating the magnetic field for batches of points without the
+/// per-point virtual dispatch of the FairField interface. Points inside the
+/// validity of the fast solenoid parametrization (MagFieldFast) are processed
+/// in vectorizable runs, the remaining ones fall back to the exact field.
+/// In addition, homogeneity hints can be registered per geometry volume
+/// (keyed by the TGeoVolume number): for volumes known to see a flat field
+/// the evaluation collapses to a lookup. Meant to be used from
+/// o2::base::Detector subclasses and fast transport paths during stepping.
+class MagFieldBatchService
+{
+ public:
+  static MagFieldBatchService& Instance()
+  {
+    static MagFieldBatchService inst;
+    return inst;
+  }
+
+  /// set the field backing this service; the fast parametrization is used when present
+  void setField(MagneticField* fld)
+  {
+    mField = fld;
+    mFast = fld ? fld->getFastField() : nullptr;
+  }
+  MagneticField* getField() const { return mField; }
+
+  /// evaluate the field for npoints consecutive (x,y,z) triplets into (Bx,By,Bz) triplets
+  void field(const float* xyz, float* bxyz, int npoints);
+
+  /// register the hint that a volume sees a homogeneous field of the given value
+  void setVolumeHomogeneityHint(int volumeID, float bx, float by, float bz)
+  {
+    mVolumeHints[volumeID] = {bx, by, bz};
+  }
+
+  /// field for a point inside a given volume: a registered homogeneity hint
+  /// short-circuits the evaluation; returns true if the hint was used
+  bool fieldForVolume(int volumeID, const float xyz[3], float bxyz[3])
+  {
+    auto hint = mVolumeHints.find(volumeID);
+    if (hint != mVolumeHints.end()) {
+      bxyz[0] = hint->second[0];
+      bxyz[1] = hint->second[1];
+      bxyz[2] = hint->second[2];
+      return true;
+    }
+    field(xyz, bxyz, 1);
+    return false;
+  }
+
+  void clearVolumeHints() { mVolumeHints.clear(); }
+
+ private:
+  MagFieldBatchService() = default;
+
+  MagneticField* mField = nullptr;                             //! backing field
+  const MagFieldFast* mFast = nullptr;                         //! optional fast parametrization of mField
+  std::unordered_map<int, std::array<float, 3>> mVolumeHints;  //! per-volume homogeneous field values
+  std::vector<unsigned char> mStatus;                          //! scratch buffer for per-point validity
+};
+
+} // namespace field
+} // namespace o2
+
+#endif
@@ -53,6 +53,15 @@ class MagFieldFast
 
   bool Field(const double xyz[3], double bxyz[3]) const;
   bool Field(const float xyz[3], float bxyz[3]) const;
+
+  /// batched evaluation for npoints stored as consecutive (x,y,z) triplets;
+  /// the output is filled with the corresponding (Bx,By,Bz) triplets and points
+  /// outside of the parametrization validity get B = 0. Consecutive points in the
+  /// same parametrization segment (the typical stepping pattern) are evaluated in
+  /// one inner loop over the shared polynomial coefficients, which the compiler can
+  /// vectorize. If status is given, it is filled with the per-point validity.
+  /// Returns the number of points inside the parametrization validity.
+  int Field(const float* xyz, float* bxyz, int npoints, unsigned char* status = nullptr) const;
   bool Field(const math_utils::Point3D<float> xyz, float bxyz[3]) const;
   bool Field(const math_utils::Point3D<double> xyz, double bxyz[3]) const;
   bool GetBcomp(EDim comp, const double xyz[3], double& b) const;
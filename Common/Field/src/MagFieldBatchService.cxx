@@ -0,0 +1,45 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldBatchService.cxx
+/// \brief Implementation of the batched magnetic field evaluation service
+
+#include "Field/MagFieldBatchService.h"
+#include <GPUCommonLogger.h>
+
+using namespace o2::field;
+
+void MagFieldBatchService::field(const float* xyz, float* bxyz, int npoints)
+{
+  if (!mField) {
+    LOG(error) << "MagFieldBatchService used without a field set";
+    for (int i = 3 * npoints; i--;) {
+      bxyz[i] = 0.f;
+    }
+    return;
+  }
+  if (mFast) {
+    mStatus.resize(npoints);
+    if (mFast->Field(xyz, bxyz, npoints, mStatus.data()) == npoints) {
+      return;
+    }
+    // points outside of the fast parametrization validity go through the exact field
+    for (int i = 0; i < npoints; i++) {
+      if (!mStatus[i]) {
+        mField->field(&xyz[3 * i], &bxyz[3 * i]);
+      }
+    }
+    return;
+  }
+  for (int i = 0; i < npoints; i++) {
+    mField->field(&xyz[3 * i], &bxyz[3 * i]);
+  }
+}
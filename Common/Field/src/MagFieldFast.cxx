@@ -202,6 +202,51 @@ bool MagFieldFast::Field(const float xyz[3], float bxyz[3]) const
   return true;
 }
 
+//_______________________________________________________________________
+int MagFieldFast::Field(const float* xyz, float* bxyz, int npoints, unsigned char* status) const
+{
+  // batched field evaluation: process runs of consecutive points falling into the
+  // same parametrization segment with a shared coefficient set, so that the
+  // polynomial evaluation over each run is a plain vectorizable loop
+  int nvalid = 0, ip = 0;
+  while (ip < npoints) {
+    int zSeg, rSeg, quadrant;
+    const float* pnt = &xyz[3 * ip];
+    if (!GetSegment(pnt[kX], pnt[kY], pnt[kZ], zSeg, rSeg, quadrant)) {
+      bxyz[3 * ip + kX] = bxyz[3 * ip + kY] = bxyz[3 * ip + kZ] = 0.f;
+      if (status) {
+        status[ip] = 0;
+      }
+      ip++;
+      continue;
+    }
+    // extend the run while the points stay in the same segment
+    int ipEnd = ip + 1;
+    while (ipEnd < npoints) {
+      int zSegN, rSegN, quadrantN;
+      const float* pntN = &xyz[3 * ipEnd];
+      if (!GetSegment(pntN[kX], pntN[kY], pntN[kZ], zSegN, rSegN, quadrantN) ||
+          zSegN != zSeg || rSegN != rSeg || quadrantN != quadrant) {
+        break;
+      }
+      ipEnd++;
+    }
+    const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
+    for (int i = ip; i < ipEnd; i++) {
+      const float x = xyz[3 * i + kX], y = xyz[3 * i + kY], z = xyz[3 * i + kZ];
+      bxyz[3 * i + kX] = CalcPol(par->parBxyz[kX], x, y, z) * mFactorSol;
+      bxyz[3 * i + kY] = CalcPol(par->parBxyz[kY], x, y, z) * mFactorSol;
+      bxyz[3 * i + kZ] = CalcPol(par->parBxyz[kZ], x, y, z) * mFactorSol;
+      if (status) {
+        status[i] = 1;
+      }
+    }
+    nvalid += ipEnd - ip;
+    ip = ipEnd;
+  }
+  return nvalid;
+}
+
 //_______________________________________________________________________
 bool MagFieldFast::Field(const math_utils::Point3D<float> xyz, float bxyz[3]) const
 {
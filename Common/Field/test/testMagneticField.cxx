@@ -16,7 +16,9 @@
 #include <iostream>
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
+#include "Field/MagFieldBatchService.h"
 #include <memory>
+#include <vector>
 #include <fairlogger/Logger.h> // for FairLogger
 #include <TStopwatch.h>
 #include <TRandom.h>
@@ -98,3 +100,42 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagFieldBatch_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  fld->AllowFastField(true);
+  auto& svc = MagFieldBatchService::Instance();
+  svc.setField(fld.get());
+
+  const int ntst = 1000;
+  float rnd[3];
+  std::vector<float> xyz(3 * ntst), bBatch(3 * ntst);
+  for (int it = ntst; it--;) {
+    gRandom->RndmArray(3, rnd);
+    xyz[3 * it + 0] = rnd[0] * 400.f * TMath::Cos(rnd[1] * TMath::Pi() * 2);
+    xyz[3 * it + 1] = rnd[1] * 400.f * TMath::Sin(rnd[1] * TMath::Pi() * 2);
+    xyz[3 * it + 2] = (rnd[0] - 0.5f) * 250.f;
+  }
+  // put some points outside of the fast parametrization validity to exercise the fallback
+  xyz[2] = 600.f;
+  xyz[5] = -600.f;
+
+  // batched evaluation must agree with the per-point one
+  svc.field(xyz.data(), bBatch.data(), ntst);
+  for (int it = ntst; it--;) {
+    float bSingle[3];
+    fld->field(&xyz[3 * it], bSingle);
+    for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_SMALL(bBatch[3 * it + i] - bSingle[i], 1.e-4f);
+    }
+  }
+
+  // homogeneity hints short-circuit the evaluation
+  svc.setVolumeHomogeneityHint(42, 0.f, 0.f, -5.f);
+  float b[3];
+  BOOST_CHECK(svc.fieldForVolume(42, xyz.data(), b));
+  BOOST_CHECK_EQUAL(b[2], -5.f);
+  BOOST_CHECK(!svc.fieldForVolume(7, xyz.data(), b));
+  svc.clearVolumeHints();
+}
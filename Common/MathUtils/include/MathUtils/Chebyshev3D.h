@@ -19,6 +19,7 @@
 #include <TNamed.h>                    // for TNamed
 #include <TObjArray.h>                 // for TObjArray
 #include <cstdio>                      // for FILE, stdout
+#include <vector>                      // for batched evaluation buffers
 #include "MathUtils/Chebyshev3DCalc.h" // for Chebyshev3DCalc, etc
 #include "Rtypes.h"                    // for Float_t, Int_t, Double_t, Bool_t, etc
 #include "TString.h"                   // for TString
@@ -136,6 +137,12 @@ class Chebyshev3D : public TNamed
 
   Double_t Eval(const Double_t* par, int idim);
 
+  /// Evaluates the parameterization for np points at once. par holds the points as x,y,z triplets
+  /// (3*np elements), res receives the output packed per component (res[idim*np + p], DimOut*np
+  /// elements). The points are processed in blocks, with the Clenshaw recurrences vectorizing
+  /// over the points of a block
+  void evalBatch(int np, const Float_t* par, Float_t* res);
+
   void evaluateDerivative(int dimd, const Float_t* par, Float_t* res);
 
   void evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, Float_t* res);
@@ -260,6 +267,7 @@ class Chebyshev3D : public TNamed
   Int_t mTemporaryChebyshevGridOffs[3]; //! start of grid for each dimension
   TString mUserFunctionName;            //! name of user macro containing the function of  "void (*fcn)(float*,float*)" format
   TMethodCall* mUserMacro;              //! Pointer to MethodCall for function from user macro
+  std::vector<Float_t> mTemporaryBatchCoords; //! mapped coordinates packed per dimension for batched evaluation
 
   static const Float_t sMinimumPrecision; ///< minimum precision allowed
 
@@ -300,6 +308,27 @@ inline void Chebyshev3D::Eval(const Float_t* par, Float_t* res)
   }
 }
 
+/// Evaluates Chebyshev parameterization for np points at once, see the declaration for the layouts.
+/// The coordinates are mapped to [-1:1] once and repacked per dimension, so that every output
+/// component streams the coefficients structure a single time for the whole batch
+inline void Chebyshev3D::evalBatch(int np, const Float_t* par, Float_t* res)
+{
+  if (mTemporaryBatchCoords.size() < size_t(np) * 3) {
+    mTemporaryBatchCoords.resize(size_t(np) * 3);
+  }
+  Float_t* px = mTemporaryBatchCoords.data();
+  Float_t* py = px + np;
+  Float_t* pz = py + np;
+  for (int p = 0; p < np; p++) {
+    px[p] = mapToInternal(par[3 * p + 0], 0);
+    py[p] = mapToInternal(par[3 * p + 1], 1);
+    pz[p] = mapToInternal(par[3 * p + 2], 2);
+  }
+  for (int i = mOutputArrayDimension; i--;) {
+    getChebyshevCalc(i)->evalBatch(np, px, py, pz, res + size_t(i) * np);
+  }
+}
+
 /// Evaluates Chebyshev parameterization for 3d->DimOut function
 inline void Chebyshev3D::Eval(const Double_t* par, Double_t* res)
 {
@@ -18,6 +18,7 @@
 
 #include <TNamed.h> // for TNamed
 #include <cstdio>   // for FILE, stdout
+#include <vector>   // for temporary batch buffers
 #include "Rtypes.h" // for Float_t, UShort_t, Int_t, Double_t, etc
 
 class TString;
@@ -169,6 +170,22 @@ class Chebyshev3DCalc : public TNamed
 
   Double_t Eval(const Double_t* par) const;
 
+  /// Evaluates the parameterization for np points at once; the arguments must be ALREADY MAPPED
+  /// to the [-1:1] interval and packed per coordinate (parx[np], pary[np], parz[np])
+  void evalBatch(int np, const Float_t* parx, const Float_t* pary, const Float_t* parz, Float_t* res) const;
+
+  /// number of points evaluated together by the batched kernels (SIMD lanes direction)
+  static constexpr int BatchBlock = 8;
+
+  /// Evaluates the 1D parameterization for a block of B arguments with common coefficients
+  template <int B>
+  static void chebyshevEvaluation1DBlock(const Float_t* x, const Float_t* array, int ncf, Float_t* out);
+
+  /// Evaluates the 1D parameterization for a block of B arguments with per-lane coefficients
+  /// packed lane-major (array[i * B + lane])
+  template <int B>
+  static void chebyshevEvaluation1DBlockV(const Float_t* x, const Float_t* array, int ncf, Float_t* out);
+
  private:
   Int_t mNumberOfCoefficients;    ///< total number of coeeficients
   Int_t mNumberOfRows;            ///< number of significant rows in the 3D coeffs matrix
@@ -190,6 +207,8 @@ class Chebyshev3DCalc : public TNamed
   Float_t* mTemporaryCoefficients2D; //[mNumberOfColumns] temp. coeffs for 2d summation
   Float_t* mTemporaryCoefficients1D; //[mNumberOfRows] temp. coeffs for 1d summation
 
+  mutable std::vector<Float_t> mTemporaryBatch; //! lane-major temp. coeffs for batched evaluation
+
   ClassDefOverride(o2::math_utils::Chebyshev3DCalc,
                    2) // Class for interpolation of 3D->1 function by Chebyshev parametrization
 };
@@ -244,6 +263,91 @@ inline Double_t Chebyshev3DCalc::Eval(const Double_t* par) const
   }
   return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
 }
+
+/// Evaluates 1D Chebyshev parameterization for B arguments at once. The Clenshaw recurrence runs
+/// with B independent lanes over a common coefficients array, so the loop body vectorizes
+template <int B>
+inline void Chebyshev3DCalc::chebyshevEvaluation1DBlock(const Float_t* x, const Float_t* array, int ncf, Float_t* out)
+{
+  if (ncf <= 0) {
+    for (int l = 0; l < B; l++) {
+      out[l] = 0;
+    }
+    return;
+  }
+  Float_t b0[B], b1[B], b2[B];
+  for (int l = 0; l < B; l++) {
+    b0[l] = array[ncf - 1];
+    b1[l] = b2[l] = 0;
+  }
+  for (int i = ncf - 1; i--;) {
+    for (int l = 0; l < B; l++) {
+      b2[l] = b1[l];
+      b1[l] = b0[l];
+      b0[l] = array[i] + (x[l] + x[l]) * b1[l] - b2[l];
+    }
+  }
+  for (int l = 0; l < B; l++) {
+    out[l] = b0[l] - x[l] * b1[l];
+  }
+}
+
+/// Same as chebyshevEvaluation1DBlock but with per-lane coefficients packed lane-major
+template <int B>
+inline void Chebyshev3DCalc::chebyshevEvaluation1DBlockV(const Float_t* x, const Float_t* array, int ncf, Float_t* out)
+{
+  if (ncf <= 0) {
+    for (int l = 0; l < B; l++) {
+      out[l] = 0;
+    }
+    return;
+  }
+  Float_t b0[B], b1[B], b2[B];
+  for (int l = 0; l < B; l++) {
+    b0[l] = array[(ncf - 1) * B + l];
+    b1[l] = b2[l] = 0;
+  }
+  for (int i = ncf - 1; i--;) {
+    for (int l = 0; l < B; l++) {
+      b2[l] = b1[l];
+      b1[l] = b0[l];
+      b0[l] = array[i * B + l] + (x[l] + x[l]) * b1[l] - b2[l];
+    }
+  }
+  for (int l = 0; l < B; l++) {
+    out[l] = b0[l] - x[l] * b1[l];
+  }
+}
+
+/// Evaluates Chebyshev parameterization for np mapped points packed per coordinate. Full blocks of
+/// BatchBlock points share the traversal of the coefficients structure, with the points in the SIMD
+/// lanes direction; the intermediate sums are packed lane-major in the batch buffer
+inline void Chebyshev3DCalc::evalBatch(int np, const Float_t* parx, const Float_t* pary, const Float_t* parz, Float_t* res) const
+{
+  constexpr int B = BatchBlock;
+  if (mTemporaryBatch.size() < size_t(mNumberOfColumns + mNumberOfRows) * B) {
+    mTemporaryBatch.resize(size_t(mNumberOfColumns + mNumberOfRows) * B);
+  }
+  Float_t* tmp2D = mTemporaryBatch.data();
+  Float_t* tmp1D = tmp2D + mNumberOfColumns * B;
+  int p = 0;
+  for (; p + B <= np; p += B) {
+    for (int id0 = mNumberOfRows; id0--;) {
+      int nCLoc = mNumberOfColumnsAtRow[id0];
+      int col0 = mColumnAtRowBeginning[id0];
+      for (int id1 = nCLoc; id1--;) {
+        int id = id1 + col0;
+        chebyshevEvaluation1DBlock<B>(parz + p, mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id], tmp2D + id1 * B);
+      }
+      chebyshevEvaluation1DBlockV<B>(pary + p, tmp2D, nCLoc, tmp1D + id0 * B);
+    }
+    chebyshevEvaluation1DBlockV<B>(parx + p, tmp1D, mNumberOfRows, res + p);
+  }
+  for (; p < np; p++) { // tail points one by one
+    Float_t par[3] = {parx[p], pary[p], parz[p]};
+    res[p] = Eval(par);
+  }
+}
 } // namespace math_utils
 } // namespace o2
 
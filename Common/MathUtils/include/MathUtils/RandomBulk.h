@@ -0,0 +1,157 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// @file   RandomBulk.h
+///
+
+/// @brief  Bulk pseudo-random number generation from interleaved PCG streams
+///
+/// This class generates pseudo-random numbers in bulk, span by span, instead
+/// of value by value. It keeps NStreams independently seeded pcg32 (XSH-RR
+/// 64/32, see Utilities/PCG) generators in structure-of-arrays layout, so the
+/// state advance runs as a simple loop over fixed-size arrays which the
+/// compiler can vectorize. Each stream produces every NStreams-th value of
+/// the output, matching the plain pcg32 sequences of the respective streams.
+///
+/// It is meant for consumers which need many values at once, like the noise
+/// injection of the digitizers and RandomRing refills.
+
+#ifndef ALICEO2_MATHUTILS_RANDOMBULK_H_
+#define ALICEO2_MATHUTILS_RANDOMBULK_H_
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include <gsl/span>
+
+namespace o2
+{
+namespace math_utils
+{
+
+template <size_t NStreams = 8>
+class RandomBulk
+{
+  static_assert(NStreams > 0, "at least one stream is required");
+
+ public:
+  /// constructor
+  /// @param [in] seed common seed, each stream additionally selects its own sequence
+  RandomBulk(uint64_t seed = 0x853c49e6748fea9bULL) { initialize(seed); }
+
+  /// (re-)seed all streams; stream i behaves like pcg32(seed, i)
+  void initialize(uint64_t seed)
+  {
+    for (size_t i = 0; i < NStreams; i++) {
+      // pcg32 seeding: the increment selects the sequence and must be odd
+      mInc[i] = (uint64_t(i) << 1u) | 1u;
+      mState[i] = 0;
+    }
+    advance();
+    for (size_t i = 0; i < NStreams; i++) {
+      mState[i] += seed;
+    }
+    advance();
+  }
+
+  /// fill the span with uniform 32-bit integers
+  void fillUniformU32(gsl::span<uint32_t> values)
+  {
+    size_t i = 0;
+    for (; i + NStreams <= values.size(); i += NStreams) {
+      for (size_t s = 0; s < NStreams; s++) {
+        values[i + s] = output(mState[s]);
+      }
+      advance();
+    }
+    for (size_t s = 0; i < values.size(); i++, s++) {
+      values[i] = output(mState[s]);
+    }
+    if (i % NStreams != 0) {
+      advance(); // the partially consumed batch is discarded to keep the streams aligned
+    }
+  }
+
+  /// fill the span with uniform floats in [0, 1)
+  void fillUniform(gsl::span<float> values)
+  {
+    size_t i = 0;
+    for (; i + NStreams <= values.size(); i += NStreams) {
+      for (size_t s = 0; s < NStreams; s++) {
+        values[i + s] = toUnit(output(mState[s]));
+      }
+      advance();
+    }
+    for (size_t s = 0; i < values.size(); i++, s++) {
+      values[i] = toUnit(output(mState[s]));
+    }
+    if (i % NStreams != 0) {
+      advance();
+    }
+  }
+
+  /// fill the span with Gaussian-distributed floats (Box-Muller on uniform pairs)
+  void fillGaus(gsl::span<float> values, float mean = 0.f, float sigma = 1.f)
+  {
+    constexpr float twoPi = 2.f * float(M_PI);
+    std::array<float, 2 * NStreams> uniforms;
+    size_t i = 0;
+    while (i < values.size()) {
+      fillUniform(gsl::span<float>(uniforms.data(), uniforms.size()));
+      for (size_t p = 0; p < NStreams && i < values.size(); p++) {
+        // 1 - u avoids log(0)
+        const float r = std::sqrt(-2.f * std::log(1.f - uniforms[2 * p]));
+        const float phi = twoPi * uniforms[2 * p + 1];
+        values[i++] = mean + sigma * r * std::cos(phi);
+        if (i < values.size()) {
+          values[i++] = mean + sigma * r * std::sin(phi);
+        }
+      }
+    }
+  }
+
+  /// number of interleaved streams
+  static constexpr size_t size() { return NStreams; }
+
+ private:
+  /// advance all LCG states by one step (the loop is trivially vectorizable)
+  void advance()
+  {
+    for (size_t s = 0; s < NStreams; s++) {
+      mState[s] = mState[s] * 6364136223846793005ULL + mInc[s];
+    }
+  }
+
+  /// pcg32 XSH-RR output function
+  static uint32_t output(uint64_t state)
+  {
+    const uint32_t xorshifted = uint32_t(((state >> 18u) ^ state) >> 27u);
+    const uint32_t rot = uint32_t(state >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+  }
+
+  /// map a 32-bit integer to [0, 1)
+  static float toUnit(uint32_t value)
+  {
+    // take the upper 24 bits, so the result is exactly representable and stays below 1
+    return float(value >> 8u) * 0x1.0p-24f;
+  }
+
+  std::array<uint64_t, NStreams> mState; ///< LCG states, one per stream
+  std::array<uint64_t, NStreams> mInc;   ///< LCG increments selecting the sequences (odd)
+
+}; // end class RandomBulk
+
+} // namespace math_utils
+} // namespace o2
+#endif
@@ -35,6 +35,8 @@
 #include "TRandom.h"
 #include <functional>
 
+#include "MathUtils/RandomBulk.h"
+
 
 namespace o2
 {
@@ -72,6 +74,13 @@ class RandomRing
   /// @param [in] randomType type of the random generator
   void initialize(std::function<float()> function);
 
+  /// initialisation of the random ring from a bulk generator
+  /// The full ring is filled in one call instead of drawing the numbers one
+  /// by one from gRandom. Only meaningful for Gaus and Flat rings.
+  /// @param [in] bulk bulk random number generator
+  template <size_t NStreams>
+  void initialize(RandomBulk<NStreams>& bulk);
+
   /// next random value from the ring buffer
   /// This function return a value from the ring buffer
   /// and increases the buffer position
@@ -110,6 +119,98 @@ class RandomRing
   /// @return position in the ring buffer
   unsigned int getRingPosition() const { return mRingPosition; }
 
+  /// size of the chunks regenerated in one refill step, power of two
+  static constexpr size_t RefillChunkSize = 4096;
+
+  /// view of one partition of the ring for use by a single thread
+  ///
+  /// Every view iterates over its own disjoint range of the backing store, so
+  /// any number of views can draw numbers concurrently without synchronization
+  /// and without duplicating the ring. With refill enabled, each time the view
+  /// crosses a chunk boundary it regenerates the chunk it just consumed with
+  /// its own bulk generator streams, so the partition does not replay the same
+  /// sequence on the next turn around; chunks of different views never
+  /// overlap, which keeps the refill free of any locking.
+  class ThreadView
+  {
+   public:
+    /// next random value from the partition of this view
+    float getNextValue()
+    {
+      const float value = mData[mPos];
+      if (++mPos >= mEnd) {
+        mPos = mBegin;
+      }
+      if (mRefill && (mPos & (RefillChunkSize - 1)) == 0) {
+        refillChunk(mPos == mBegin ? mEnd - RefillChunkSize : mPos - RefillChunkSize);
+      }
+      return value;
+    }
+
+    /// next vector with random values, see RandomRing::getNextValueVc()
+    template <typename VcType>
+    VcType getNextValueVc()
+    {
+      const VcType value = VcType(&mData[mPos]);
+      mPos += VcType::size();
+      if (mPos >= mEnd) {
+        mPos = mBegin;
+      }
+      if (mRefill && (mPos & (RefillChunkSize - 1)) == 0) {
+        refillChunk(mPos == mBegin ? mEnd - RefillChunkSize : mPos - RefillChunkSize);
+      }
+      return value;
+    }
+
+    /// position in the partition of this view
+    size_t getRingPosition() const { return mPos - mBegin; }
+
+   private:
+    friend class RandomRing;
+    ThreadView(RandomRing& parent, size_t begin, size_t size, uint64_t seed, bool refill)
+      : mData(parent.mRandomNumbers.data()), mBegin(begin), mEnd(begin + size), mPos(begin), mRandomType(parent.mRandomType), mRefill(refill), mBulk(seed)
+    {
+    }
+
+    /// regenerate one consumed chunk in place with the vectorizable bulk streams
+    void refillChunk(size_t chunkBegin)
+    {
+      auto chunk = gsl::span<float>(mData + chunkBegin, RefillChunkSize);
+      if (mRandomType == RandomType::Gaus) {
+        mBulk.fillGaus(chunk);
+      } else if (mRandomType == RandomType::Flat) {
+        mBulk.fillUniform(chunk);
+      }
+    }
+
+    float* mData = nullptr;   ///< backing store of the parent ring
+    size_t mBegin = 0;        ///< first element of the partition
+    size_t mEnd = 0;          ///< end of the partition
+    size_t mPos = 0;          ///< presently accessed position
+    RandomType mRandomType;   ///< distribution of the parent ring, defines the refill
+    bool mRefill = false;     ///< regenerate consumed chunks instead of replaying them
+    RandomBulk<> mBulk;       ///< per-view generator streams, seeded per thread
+  };
+
+  /// partition the ring into nThreads disjoint per-thread views
+  /// The partitions are aligned to the refill chunk size; refill is only
+  /// possible for Gaus and Flat rings and when the ring is large enough for
+  /// at least one aligned chunk per thread. The views reference the backing
+  /// store of this ring and must not outlive it.
+  /// @param [in] threadId index of the partition to view, < nThreads
+  /// @param [in] nThreads number of partitions
+  /// @param [in] refillOnWrap regenerate consumed chunks in place
+  ThreadView getView(size_t threadId, size_t nThreads, bool refillOnWrap = false)
+  {
+    size_t partSize = (N / nThreads) & ~(RefillChunkSize - 1);
+    if (partSize == 0) { // ring too small for aligned chunks, plain split without refill
+      partSize = N / nThreads;
+      refillOnWrap = false;
+    }
+    const bool canRefill = refillOnWrap && (mRandomType == RandomType::Gaus || mRandomType == RandomType::Flat);
+    return ThreadView(*this, threadId * partSize, partSize, 0x9e3779b97f4a7c15ULL * (threadId + 1), canRefill);
+  }
+
  private:
   // =========================================================================
   // ===| members |===========================================================
@@ -174,6 +275,27 @@ inline void RandomRing<N>::initialize(TF1& function)
   }
 }
 
+//______________________________________________________________________________
+template <size_t N>
+template <size_t NStreams>
+inline void RandomRing<N>::initialize(RandomBulk<NStreams>& bulk)
+{
+  switch (mRandomType) {
+    case RandomType::Gaus: {
+      bulk.fillGaus(gsl::span<float>(mRandomNumbers.data(), mRandomNumbers.size()));
+      break;
+    }
+    case RandomType::Flat: {
+      bulk.fillUniform(gsl::span<float>(mRandomNumbers.data(), mRandomNumbers.size()));
+      break;
+    }
+    default: {
+      mRandomNumbers.fill(0);
+      break;
+    }
+  }
+}
+
 //______________________________________________________________________________
 template <size_t N>
 inline void RandomRing<N>::initialize(std::function<float()> function)
@@ -725,6 +725,33 @@ GPUdi() Expr<MatrixMulOpGPU<SMatrixGPU<T, D1, D, R1>, SMatrixGPU<T, D, D2, R2>,
               typename MultPolicyGPU<T, R1, R2>::RepType>(MatMulOp(lhs, rhs));
 }
 
+template <class A, class T, unsigned int D1, unsigned int D, unsigned int D2, class R1, class R2>
+GPUdi() Expr<MatrixMulOpGPU<SMatrixGPU<T, D1, D, R1>, Expr<A, T, D, D2, R2>, T, D>, T, D1, D2, typename MultPolicyGPU<T, R1, R2>::RepType>
+  operator*(const SMatrixGPU<T, D1, D, R1>& lhs, const Expr<A, T, D, D2, R2>& rhs)
+{
+  typedef MatrixMulOpGPU<SMatrixGPU<T, D1, D, R1>, Expr<A, T, D, D2, R2>, T, D> MatMulOp;
+  return Expr<MatMulOp, T, D1, D2,
+              typename MultPolicyGPU<T, R1, R2>::RepType>(MatMulOp(lhs, rhs));
+}
+
+template <class A, class T, unsigned int D1, unsigned int D, unsigned int D2, class R1, class R2>
+GPUdi() Expr<MatrixMulOpGPU<Expr<A, T, D1, D, R1>, SMatrixGPU<T, D, D2, R2>, T, D>, T, D1, D2, typename MultPolicyGPU<T, R1, R2>::RepType>
+  operator*(const Expr<A, T, D1, D, R1>& lhs, const SMatrixGPU<T, D, D2, R2>& rhs)
+{
+  typedef MatrixMulOpGPU<Expr<A, T, D1, D, R1>, SMatrixGPU<T, D, D2, R2>, T, D> MatMulOp;
+  return Expr<MatMulOp, T, D1, D2,
+              typename MultPolicyGPU<T, R1, R2>::RepType>(MatMulOp(lhs, rhs));
+}
+
+template <class A1, class A2, class T, unsigned int D1, unsigned int D, unsigned int D2, class R1, class R2>
+GPUdi() Expr<MatrixMulOpGPU<Expr<A1, T, D1, D, R1>, Expr<A2, T, D, D2, R2>, T, D>, T, D1, D2, typename MultPolicyGPU<T, R1, R2>::RepType>
+  operator*(const Expr<A1, T, D1, D, R1>& lhs, const Expr<A2, T, D, D2, R2>& rhs)
+{
+  typedef MatrixMulOpGPU<Expr<A1, T, D1, D, R1>, Expr<A2, T, D, D2, R2>, T, D> MatMulOp;
+  return Expr<MatMulOp, T, D1, D2,
+              typename MultPolicyGPU<T, R1, R2>::RepType>(MatMulOp(lhs, rhs));
+}
+
 /// Inversion
 template <unsigned int D, unsigned int N = D>
 class Inverter
@@ -1457,5 +1484,89 @@ GPUdi() SMatrixGPU<T, D1, D1, MatRepSymGPU<T, D1>> Similarity(const SMatrixGPU<T
   AssignSym::Evaluate(mret, tmp * Transpose(lhs));
   return mret;
 }
+
+template <class T, unsigned int D1, unsigned int D2, class R>
+GPUdi() SMatrixGPU<T, D2, D2, MatRepSymGPU<T, D2>> SimilarityT(const SMatrixGPU<T, D1, D2, R>& lhs, const SMatrixGPU<T, D1, D1, MatRepSymGPU<T, D1>>& rhs)
+{
+  SMatrixGPU<T, D1, D2, MatRepStdGPU<T, D1, D2>> tmp = rhs * lhs;
+  typedef SMatrixGPU<T, D2, D2, MatRepSymGPU<T, D2>> SMatrixSym;
+  SMatrixSym mret;
+  AssignSym::Evaluate(mret, Transpose(lhs) * tmp);
+  return mret;
+}
+
+// vector similarity: scalar lhs^T * rhs * lhs
+template <class T, unsigned int D>
+GPUdi() T Similarity(const SVectorGPU<T, D>& lhs, const SMatrixGPU<T, D, D, MatRepSymGPU<T, D>>& rhs)
+{
+  return Dot(lhs, rhs * lhs);
+}
+
+template <class Vector1, class Vector2, class T, unsigned int D1, unsigned int D2>
+class TensorMulOpGPU
+{
+ public:
+  GPUd() TensorMulOpGPU(const Vector1& lhs, const Vector2& rhs) : lhs_(lhs), rhs_(rhs) {}
+  GPUdDefault() ~TensorMulOpGPU() = default;
+  GPUdi() T apply(unsigned int i) const
+  {
+    return lhs_.apply(i / D2) * rhs_.apply(i % D2);
+  }
+
+  GPUdi() T operator()(unsigned int i, unsigned int j) const
+  {
+    return lhs_.apply(i) * rhs_.apply(j);
+  }
+
+  GPUdi() bool IsInUse(const T*) const
+  {
+    return false;
+  }
+
+ protected:
+  const Vector1& lhs_;
+  const Vector2& rhs_;
+};
+
+// outer (tensor) product of two vectors
+template <class T, unsigned int D1, unsigned int D2>
+GPUdi() Expr<TensorMulOpGPU<SVectorGPU<T, D1>, SVectorGPU<T, D2>, T, D1, D2>, T, D1, D2> TensorProd(const SVectorGPU<T, D1>& lhs, const SVectorGPU<T, D2>& rhs)
+{
+  typedef TensorMulOpGPU<SVectorGPU<T, D1>, SVectorGPU<T, D2>, T, D1, D2> TensMulOp;
+  return Expr<TensMulOp, T, D1, D2>(TensMulOp(lhs, rhs));
+}
+
+// rank-1 update of a symmetric matrix: rhs += alpha * v * v^T, evaluated directly on the packed
+// lower triangle: the flat restrict-qualified loops vectorize on the host compilers
+template <class T, unsigned int D>
+GPUdi() void Rank1Update(SMatrixGPU<T, D, D, MatRepSymGPU<T, D>>& rhs, const SVectorGPU<T, D>& v, T alpha = 1)
+{
+  T* GPUrestrict() a = rhs.Array();
+  const T* GPUrestrict() x = v.Array();
+  unsigned int l = 0;
+  for (unsigned int i = 0; i < D; ++i) {
+    const T axi = alpha * x[i];
+    for (unsigned int j = 0; j <= i; ++j) {
+      a[l++] += axi * x[j];
+    }
+  }
+}
+
+// rank-k update of a symmetric matrix: rhs += alpha * u * u^T
+template <class T, unsigned int D, unsigned int K, class R>
+GPUdi() void RankUpdate(SMatrixGPU<T, D, D, MatRepSymGPU<T, D>>& rhs, const SMatrixGPU<T, D, K, R>& u, T alpha = 1)
+{
+  T* GPUrestrict() a = rhs.Array();
+  unsigned int l = 0;
+  for (unsigned int i = 0; i < D; ++i) {
+    for (unsigned int j = 0; j <= i; ++j) {
+      T sum = 0;
+      for (unsigned int k = 0; k < K; ++k) {
+        sum += u(i, k) * u(j, k);
+      }
+      a[l++] += alpha * sum;
+    }
+  }
+}
 } // namespace o2::math_utils::detail
 #endif
@@ -27,8 +27,64 @@ using namespace o2::math_utils;
 
 void SymMatrixSolver::solve()
 {
-  // Upper Triangulization
-  for (int i = 0; i < mN; i++) {
+  // Upper Triangulization.
+  // The pivot rows are processed in blocks of PivotBlock: every trailing row then
+  // receives one fused rank-PivotBlock update instead of PivotBlock separate sweeps,
+  // which multiplies the arithmetic done per loaded row and keeps the contiguous
+  // inner loop auto-vectorizable. The multipliers only depend on the pivot rows,
+  // so the fused update is algebraically identical to the row-by-row elimination.
+  constexpr int PivotBlock = 4;
+  int i0 = 0;
+  for (; i0 + PivotBlock <= mN; i0 += PivotBlock) {
+    double cInv[PivotBlock];
+    // factorize the pivot rows among themselves
+    for (int p = 0; p < PivotBlock; p++) {
+      int i = i0 + p;
+      double* rowI = &mA[i * mShift];
+      double c = (std::fabs(rowI[i]) > 1.e-10) ? 1. / rowI[i] : 0.;
+      double* rowJ = rowI + mShift;
+      for (int j = i + 1; j < i0 + PivotBlock; j++, rowJ += mShift) {
+        if (rowI[j] != 0.) {
+          double aij = c * rowI[j];
+          for (int k = j; k < mShift; k++) {
+            rowJ[k] -= aij * rowI[k];
+          }
+          rowI[j] = aij;
+        }
+      }
+      cInv[p] = c;
+    }
+    // fused update of the trailing rows with all pivot rows of the block
+    const double* rowP0 = &mA[(i0 + 0) * mShift];
+    const double* rowP1 = &mA[(i0 + 1) * mShift];
+    const double* rowP2 = &mA[(i0 + 2) * mShift];
+    const double* rowP3 = &mA[(i0 + 3) * mShift];
+    double* rowJ = &mA[(i0 + PivotBlock) * mShift];
+    for (int j = i0 + PivotBlock; j < mN; j++, rowJ += mShift) {
+      double m[PivotBlock];
+      for (int p = 0; p < PivotBlock; p++) {
+        m[p] = cInv[p] * mA[(i0 + p) * mShift + j];
+      }
+      if (m[0] != 0. || m[1] != 0. || m[2] != 0. || m[3] != 0.) {
+        for (int k = j; k < mShift; k++) {
+          rowJ[k] -= m[0] * rowP0[k] + m[1] * rowP1[k] + m[2] * rowP2[k] + m[3] * rowP3[k];
+        }
+      }
+      // store the multipliers only now: the k == j terms above need the original values
+      for (int p = 0; p < PivotBlock; p++) {
+        mA[(i0 + p) * mShift + j] = m[p];
+      }
+    }
+    // scale B of the pivot rows only now: the updates above need the unscaled values
+    for (int p = 0; p < PivotBlock; p++) {
+      double* rowIb = &mA[(i0 + p) * mShift + mN];
+      for (int k = 0; k < mM; k++) {
+        rowIb[k] *= cInv[p];
+      }
+    }
+  }
+  // remaining pivot rows, row-by-row
+  for (int i = i0; i < mN; i++) {
     double* rowI = &mA[i * mShift];
     double* rowIb = &mA[i * mShift + mN];
     double c = (std::fabs(rowI[i]) > 1.e-10) ? 1. / rowI[i] : 0.;
@@ -46,8 +102,11 @@ void SymMatrixSolver::solve()
       rowIb[k] *= c;
     }
   }
-  // Diagonalization
-  for (int i = mN - 1; i >= 0; i--) {
+
+  // Diagonalization, blocked the same way: once the B rows of a block are final,
+  // their contributions to all rows above are applied in one fused sweep
+  int rem = mN % PivotBlock;
+  for (int i = mN - 1; i >= mN - rem; i--) {
     double* rowIb = &mA[i * mShift + mN];
     double* rowJb = rowIb - mShift;
     for (int j = i - 1; j >= 0; j--, rowJb -= mShift) { // row j
@@ -59,6 +118,73 @@ void SymMatrixSolver::solve()
       }
     }
   }
+  for (int ib = mN - rem - PivotBlock; ib >= 0; ib -= PivotBlock) {
+    // finalize the B rows of the block among themselves
+    for (int i = ib + PivotBlock - 1; i > ib; i--) {
+      const double* rowIb = &mA[i * mShift + mN];
+      for (int j = i - 1; j >= ib; j--) {
+        double aji = mA[j * mShift + i];
+        if (aji != 0.) {
+          double* rowJb = &mA[j * mShift + mN];
+          for (int k = 0; k < mM; k++) {
+            rowJb[k] -= aji * rowIb[k];
+          }
+        }
+      }
+    }
+    // fused update of all rows above the block
+    const double* b0 = &mA[(ib + 0) * mShift + mN];
+    const double* b1 = &mA[(ib + 1) * mShift + mN];
+    const double* b2 = &mA[(ib + 2) * mShift + mN];
+    const double* b3 = &mA[(ib + 3) * mShift + mN];
+    for (int j = ib - 1; j >= 0; j--) {
+      const double* rowJ = &mA[j * mShift];
+      double m0 = rowJ[ib + 0], m1 = rowJ[ib + 1], m2 = rowJ[ib + 2], m3 = rowJ[ib + 3];
+      if (m0 == 0. && m1 == 0. && m2 == 0. && m3 == 0.) {
+        continue;
+      }
+      double* rowJb = &mA[j * mShift + mN];
+      for (int k = 0; k < mM; k++) {
+        rowJb[k] -= m0 * b0[k] + m1 * b1[k] + m2 * b2[k] + m3 * b3[k];
+      }
+    }
+  }
+}
+
+void SymMatrixSolver::solveFor(double* b, int nCols)
+{
+  // Forward elimination with the multipliers stored by solve().
+  // The diagonal of A is not touched by the factorization, so 1/pivot is recomputed.
+  for (int i = 0; i < mN; i++) {
+    const double* rowI = &mA[i * mShift];
+    double* bi = b + i * nCols;
+    for (int j = i + 1; j < mN; j++) {
+      double aij = rowI[j];
+      if (aij != 0.) {
+        double* bj = b + j * nCols;
+        for (int k = 0; k < nCols; k++) {
+          bj[k] -= aij * bi[k];
+        }
+      }
+    }
+    double c = (std::fabs(rowI[i]) > 1.e-10) ? 1. / rowI[i] : 0.;
+    for (int k = 0; k < nCols; k++) {
+      bi[k] *= c;
+    }
+  }
+  // Back substitution
+  for (int i = mN - 1; i >= 0; i--) {
+    const double* bi = b + i * nCols;
+    for (int j = i - 1; j >= 0; j--) {
+      double aji = mA[j * mShift + i];
+      if (aji != 0.) {
+        double* bj = b + j * nCols;
+        for (int k = 0; k < nCols; k++) {
+          bj[k] -= aji * bi[k];
+        }
+      }
+    }
+  }
 }
 
 void SymMatrixSolver::print()
@@ -155,6 +281,15 @@ int SymMatrixSolver::test(bool prn)
     auto stop = std::chrono::high_resolution_clock::now();
     duration += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
 
+    // solve the same system once more through the factorization-reuse interface
+    double b2[n][d];
+    for (int i = 0; i < n; i++) {
+      for (int k = 0; k < d; k++) {
+        b2[i][k] = b[i][k];
+      }
+    }
+    sym.solveFor(&b2[0][0], d);
+
     double diff = 0.;
     for (int i = 0; i < n; i++) {
       for (int k = 0; k < d; k++) {
@@ -162,6 +297,10 @@ int SymMatrixSolver::test(bool prn)
         if (diff < t) {
           diff = t;
         }
+        t = std::fabs(x[i][k] - b2[i][k]);
+        if (diff < t) {
+          diff = t;
+        }
       }
     }
     if (maxDiff < diff) {
@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test RandomBulk class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "MathUtils/RandomBulk.h"
+#include "MathUtils/RandomRing.h"
+
+#include <cmath>
+#include <vector>
+
+namespace o2
+{
+namespace math_utils
+{
+
+BOOST_AUTO_TEST_CASE(RandomBulk_uniform)
+{
+  RandomBulk<> bulk(12345);
+  std::vector<float> values(100001); // odd on purpose, to exercise the tail handling
+  bulk.fillUniform(values);
+
+  double sum = 0.;
+  for (auto v : values) {
+    BOOST_CHECK(v >= 0.f && v < 1.f);
+    sum += v;
+  }
+  BOOST_CHECK_SMALL(sum / values.size() - 0.5, 0.01);
+
+  // the same seed reproduces the same sequence
+  RandomBulk<> bulk2(12345);
+  std::vector<float> values2(values.size());
+  bulk2.fillUniform(values2);
+  BOOST_CHECK(values == values2);
+
+  // a different seed does not
+  RandomBulk<> bulk3(54321);
+  bulk3.fillUniform(values2);
+  BOOST_CHECK(values != values2);
+}
+
+BOOST_AUTO_TEST_CASE(RandomBulk_gaus)
+{
+  RandomBulk<> bulk(987);
+  std::vector<float> values(200000);
+  bulk.fillGaus(values, 1.f, 2.f);
+
+  double mean = 0.;
+  for (auto v : values) {
+    mean += v;
+  }
+  mean /= values.size();
+  double var = 0.;
+  for (auto v : values) {
+    var += (v - mean) * (v - mean);
+  }
+  const double sigma = std::sqrt(var / values.size());
+
+  BOOST_CHECK_SMALL(mean - 1., 0.05);
+  BOOST_CHECK_SMALL(sigma - 2., 0.05);
+}
+
+BOOST_AUTO_TEST_CASE(RandomBulk_ring)
+{
+  RandomBulk<> bulk(42);
+  RandomRing<2048> ring(RandomRing<2048>::RandomType::Flat);
+  ring.initialize(bulk);
+
+  for (size_t i = 0; i < 2048; i++) {
+    const auto v = ring.getNextValue();
+    BOOST_CHECK(v >= 0.f && v < 1.f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RandomRing_threadViews)
+{
+  constexpr size_t ringSize = 4 * 100000;
+  RandomRing<ringSize> ring(RandomRing<ringSize>::RandomType::Flat);
+  constexpr size_t nThreads = 4;
+  const size_t partSize = (ringSize / nThreads) & ~(RandomRing<ringSize>::RefillChunkSize - 1);
+
+  // views of different threads iterate disjoint partitions of the same store
+  auto v0 = ring.getView(0, nThreads);
+  auto v1 = ring.getView(1, nThreads);
+  std::vector<float> s0, s1;
+  for (size_t i = 0; i < partSize; i++) {
+    s0.push_back(v0.getNextValue());
+    s1.push_back(v1.getNextValue());
+  }
+  BOOST_CHECK(s0 != s1);
+  // without refill a view replays its partition after a full turn
+  BOOST_CHECK_EQUAL(v0.getNextValue(), s0[0]);
+
+  // with refill the consumed chunks are regenerated, so there is no replay
+  auto v2 = ring.getView(2, nThreads, true);
+  std::vector<float> s2;
+  for (size_t i = 0; i < partSize; i++) {
+    s2.push_back(v2.getNextValue());
+  }
+  bool replayed = true;
+  for (size_t i = 0; i < 100; i++) {
+    const auto v = v2.getNextValue();
+    BOOST_CHECK(v >= 0.f && v < 1.f);
+    replayed = replayed && (v == s2[i]);
+  }
+  BOOST_CHECK(!replayed);
+}
+
+} // namespace math_utils
+} // namespace o2
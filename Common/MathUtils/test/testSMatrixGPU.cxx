@@ -0,0 +1,98 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test SMatrixGPU
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <Math/SMatrix.h>
+#include "MathUtils/SMatrixGPU.h"
+
+using namespace o2::math_utils::detail;
+
+BOOST_AUTO_TEST_CASE(SMatrixGPU_CovarianceOps)
+{
+  // cross-check the covariance algebra ops against the ROOT SMatrix reference
+  constexpr unsigned int D = 5, K = 3;
+  ROOT::Math::SMatrix<double, D, D, ROOT::Math::MatRepSym<double, D>> rSym;
+  ROOT::Math::SMatrix<double, D, D> rGen;
+  ROOT::Math::SVector<double, D> rVec;
+  SMatrixGPU<double, D, D, MatRepSymGPU<double, D>> gSym;
+  SMatrixGPU<double, D, D, MatRepStdGPU<double, D, D>> gGen;
+  SVectorGPU<double, D> gVec;
+  for (unsigned int i = 0; i < D; i++) {
+    rVec[i] = gVec[i] = 0.3 * i - 0.7;
+    for (unsigned int j = 0; j < D; j++) {
+      rGen(i, j) = gGen(i, j) = 0.1 * i + 0.01 * j * j - 0.2;
+      if (j <= i) {
+        rSym(i, j) = gSym(i, j) = (i == j ? 2.0 : 0.0) + 0.05 * i * j;
+      }
+    }
+  }
+
+  auto rSim = ROOT::Math::Similarity(rGen, rSym);
+  auto gSim = Similarity(gGen, gSym);
+  auto rSimT = ROOT::Math::SimilarityT(rGen, rSym);
+  auto gSimT = SimilarityT(gGen, gSym);
+  for (unsigned int i = 0; i < D; i++) {
+    for (unsigned int j = 0; j < D; j++) {
+      BOOST_CHECK_CLOSE(gSim(i, j), rSim(i, j), 1e-9);
+      BOOST_CHECK_CLOSE(gSimT(i, j), rSimT(i, j), 1e-9);
+    }
+  }
+  BOOST_CHECK_CLOSE(Similarity(gVec, gSym), ROOT::Math::Similarity(rVec, rSym), 1e-9);
+
+  // outer product and rank updates
+  SMatrixGPU<double, D, D, MatRepStdGPU<double, D, D>> gTens = TensorProd(gVec, gVec);
+  auto rTens = ROOT::Math::TensorProd(rVec, rVec);
+  auto gUpd1 = gSym;
+  Rank1Update(gUpd1, gVec, 2.5);
+  SMatrixGPU<double, D, K, MatRepStdGPU<double, D, K>> gU;
+  for (unsigned int i = 0; i < D; i++) {
+    for (unsigned int k = 0; k < K; k++) {
+      gU(i, k) = 0.2 * i - 0.1 * k;
+    }
+  }
+  auto gUpdK = gSym;
+  RankUpdate(gUpdK, gU, -0.5);
+  for (unsigned int i = 0; i < D; i++) {
+    for (unsigned int j = 0; j < D; j++) {
+      BOOST_CHECK_CLOSE(gTens(i, j), rTens(i, j), 1e-9);
+      double ref1 = rSym(i, j) + 2.5 * rVec[i] * rVec[j];
+      BOOST_CHECK_CLOSE(gUpd1(i, j), ref1, 1e-9);
+      double refK = rSym(i, j);
+      for (unsigned int k = 0; k < K; k++) {
+        refK += -0.5 * gU(i, k) * gU(j, k);
+      }
+      BOOST_CHECK_CLOSE(gUpdK(i, j), refK, 1e-9);
+    }
+  }
+
+  // expression operands on both sides of the product
+  SMatrixGPU<double, D, D, MatRepStdGPU<double, D, D>> gTT = Transpose(gGen) * Transpose(gGen);
+  auto rTT = ROOT::Math::Transpose(rGen) * ROOT::Math::Transpose(rGen);
+  for (unsigned int i = 0; i < D; i++) {
+    for (unsigned int j = 0; j < D; j++) {
+      BOOST_CHECK_CLOSE(gTT(i, j), rTT(i, j), 1e-9);
+    }
+  }
+
+  // symmetric inversion must match as well: cov * cov^-1 = 1
+  auto gInv = gSym;
+  BOOST_CHECK(gInv.Invert());
+  auto rInv = rSym;
+  BOOST_CHECK(rInv.Invert());
+  for (unsigned int i = 0; i < D; i++) {
+    for (unsigned int j = 0; j < D; j++) {
+      BOOST_CHECK_CLOSE(gInv(i, j), rInv(i, j), 1e-7);
+    }
+  }
+}
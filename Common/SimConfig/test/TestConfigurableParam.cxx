@@ -63,5 +63,13 @@ int main(int argc, char* argv[])
   assert(d3 == BazParam::Instance().getGasDensity());
   assert(x == BazParam::Instance().getGasDensity());
 
+  // resolve a handle against the frozen key table and check that reads
+  // through it track updates of the underlying member
+  auto handle = o2::conf::ConfigurableParam::getHandle<double>("Baz.mGasDensity");
+  assert(handle.get() == BazParam::Instance().getGasDensity());
+  double y = 205;
+  o2::conf::ConfigurableParam::setValue<double>("Baz", "mGasDensity", y);
+  assert(handle.get() == y);
+
   o2::conf::ConfigurableParam::writeINI("newconf.ini");
 }
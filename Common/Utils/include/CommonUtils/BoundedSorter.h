@@ -0,0 +1,175 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \brief Sorter with reusable arena-backed auxiliary buffer
+
+#ifndef ALICEO2_BOUNDEDSORTER_H_
+#define ALICEO2_BOUNDEDSORTER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace o2
+{
+namespace utils
+{
+
+/// Sorter for the large transient sorts done once per TF (indices, IR frames, digits).
+/// std::sort is in place but slow on integer keys, while std::stable_sort and radix sorts
+/// allocate and free an auxiliary buffer of the input size at every call, which spikes the
+/// RSS at high interaction rate. This class keeps the auxiliary buffer in an arena which is
+/// reused across calls (i.e. TFs) and never exceeds the size of the larger merged run,
+/// typically half of the input:
+/// - data is processed in chunks of at most the chunk size (settable, default 1M elements),
+///   sorted either with std::sort or, for unsigned integer keys, with a byte-wise radix sort
+///   ping-ponging between the data and the arena;
+/// - the sorted chunks are then merged bottom-up, copying only the left run to the arena.
+/// The sorts are stable. Call clear() to return the arena memory to the system, e.g. after
+/// an exceptionally large TF.
+template <typename T>
+class BoundedSorter
+{
+ public:
+  BoundedSorter() = default;
+
+  /// set max number of elements sorted per chunk (also the min arena allocation)
+  void setChunkSize(size_t n) { mChunkSize = n > MinChunkSize ? n : MinChunkSize; }
+  size_t getChunkSize() const { return mChunkSize; }
+
+  /// current arena capacity in bytes
+  size_t getArenaCapacityBytes() const { return mArena.capacity() * sizeof(T); }
+
+  /// release the arena memory
+  void clear()
+  {
+    mArena.clear();
+    mArena.shrink_to_fit();
+  }
+
+  /// stable comparator-based sort
+  template <typename IT, typename Cmp = std::less<>>
+  void sort(IT begin, IT end, Cmp cmp = {})
+  {
+    static_assert(std::is_same_v<typename std::iterator_traits<IT>::value_type, T>, "iterator value type must match sorter type");
+    const size_t n = std::distance(begin, end);
+    if (n < 2) {
+      return;
+    }
+    for (size_t i = 0; i < n; i += mChunkSize) {
+      std::stable_sort(begin + i, begin + std::min(i + mChunkSize, n), cmp);
+    }
+    mergeChunks(begin, n, cmp);
+  }
+
+  /// stable sort by unsigned integer key, radix-sorting each chunk byte by byte
+  template <typename IT, typename KeyF>
+  void sortByKey(IT begin, IT end, KeyF key)
+  {
+    static_assert(std::is_same_v<typename std::iterator_traits<IT>::value_type, T>, "iterator value type must match sorter type");
+    using key_t = std::decay_t<decltype(key(*begin))>;
+    static_assert(std::is_unsigned_v<key_t>, "radix sort requires an unsigned integer key");
+    const size_t n = std::distance(begin, end);
+    if (n < 2) {
+      return;
+    }
+    const size_t chunk = std::min(n, mChunkSize);
+    mArena.resize(chunk);
+    for (size_t i = 0; i < n; i += mChunkSize) {
+      radixSortChunk(&*(begin + i), std::min(mChunkSize, n - i), key);
+    }
+    mergeChunks(begin, n, [&key](const T& a, const T& b) { return key(a) < key(b); });
+  }
+
+ private:
+  static constexpr size_t MinChunkSize = 256;
+
+  /// bottom-up merge of sorted chunks, the arena holds only the left run of each merge
+  template <typename IT, typename Cmp>
+  void mergeChunks(IT begin, size_t n, Cmp cmp)
+  {
+    for (size_t width = mChunkSize; width < n; width *= 2) {
+      for (size_t i = 0; i + width < n; i += 2 * width) {
+        mergeRuns(begin + i, begin + (i + width), begin + std::min(i + 2 * width, n), cmp);
+      }
+    }
+  }
+
+  /// merge [b, m) and [m, e) in place, buffering the left run in the arena
+  template <typename IT, typename Cmp>
+  void mergeRuns(IT b, IT m, IT e, Cmp cmp)
+  {
+    if (!cmp(*m, *(m - 1))) { // already ordered
+      return;
+    }
+    mArena.assign(b, m);
+    auto left = mArena.begin(), leftEnd = mArena.end();
+    auto right = m, out = b;
+    while (left != leftEnd && right != e) {
+      if (cmp(*right, *left)) { // strict: keep equal elements from the left run first
+        *out++ = std::move(*right++);
+      } else {
+        *out++ = std::move(*left++);
+      }
+    }
+    std::move(left, leftEnd, out); // remaining right elements are already in place
+  }
+
+  /// LSD radix sort of a chunk, ping-ponging between the data and the arena
+  template <typename KeyF>
+  void radixSortChunk(T* data, size_t n, KeyF key)
+  {
+    using key_t = std::decay_t<decltype(key(*data))>;
+    mArena.resize(std::max(mArena.size(), n));
+    T* src = data;
+    T* dst = mArena.data();
+    for (size_t pass = 0; pass < sizeof(key_t); pass++) {
+      const size_t shift = 8 * pass;
+      std::array<size_t, 256> count{};
+      bool ordered = true;
+      for (size_t i = 0; i < n; i++) {
+        count[(key(src[i]) >> shift) & 0xff]++;
+        if (i && key(src[i]) < key(src[i - 1])) {
+          ordered = false;
+        }
+      }
+      if (ordered) { // also covers passes where all remaining bytes are equal
+        break;
+      }
+      size_t offs = 0;
+      for (auto& c : count) {
+        auto nc = c;
+        c = offs;
+        offs += nc;
+      }
+      for (size_t i = 0; i < n; i++) {
+        dst[count[(key(src[i]) >> shift) & 0xff]++] = std::move(src[i]);
+      }
+      std::swap(src, dst);
+    }
+    if (src != data) { // odd number of passes, result is in the arena
+      std::move(src, src + n, data);
+    }
+  }
+
+  size_t mChunkSize = 1024 * 1024; // max number of elements sorted per chunk
+  std::vector<T> mArena;           // reusable auxiliary buffer
+};
+
+} // namespace utils
+} // namespace o2
+
+#endif
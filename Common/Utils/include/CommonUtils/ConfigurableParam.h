@@ -16,9 +16,11 @@
 
 #include <vector>
 #include <cassert>
+#include <cstdint>
 #include <map>
 #include <unordered_map>
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <string_view>
 #include <typeinfo>
 #include <iostream>
 #include <array>
@@ -187,6 +189,41 @@ class ConfigurableParam
   // writes a human readable INI file of all parameters
   static void writeINI(std::string const& filename, std::string const& keyOnly = "");
 
+  // compile-time FNV-1a hash of a full parameter key ("MainKey.memberName");
+  // used as the lookup key of the frozen post-init key table
+  static constexpr uint64_t hashKey(std::string_view key)
+  {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const char c : key) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  // Handle to the storage of a single parameter member, resolved once against
+  // the frozen key table: reading through the handle is a plain load of the
+  // singleton member, which stays in sync with updates through setValue.
+  // To be used in hot code instead of repeated getValueAs calls.
+  template <typename T>
+  class ParamHandle
+  {
+   public:
+    T get() const { return *mPtr; }
+
+   private:
+    friend class ConfigurableParam;
+    ParamHandle(const T* ptr) : mPtr(ptr) {}
+    const T* mPtr = nullptr;
+  };
+
+  // resolve a handle for the given key (e.g. "TPCGas.mGasDensity");
+  // fatal if the key is unknown or T does not match the member type
+  template <typename T>
+  static ParamHandle<T> getHandle(std::string_view key)
+  {
+    return ParamHandle<T>(static_cast<const T*>(resolveKey(hashKey(key), key, typeid(T))));
+  }
+
   // can be used instead of using API on concrete child classes
   template <typename T>
   static T getValueAs(std::string key)
@@ -282,6 +319,10 @@ class ConfigurableParam
   static EParamUpdateStatus updateThroughStorageMap(std::string, std::string, std::type_info const&, void*);
   static EParamUpdateStatus updateThroughStorageMapWithConversion(std::string const&, std::string const&);
 
+  // look up the storage location of the given key in the frozen flat key table
+  // (freezing it first if necessary)
+  static const void* resolveKey(uint64_t hash, std::string_view key, std::type_info const& tinfo);
+
   virtual ~ConfigurableParam() = default;
 
   // fill property tree with the key-values from the sub-classes
@@ -68,6 +68,8 @@ struct ParameterDebugStreamer : public o2::conf::ConfigurableParamHelper<Paramet
   SamplingTypes samplingType[StreamFlags::streamFlagsCount]{};                                    ///< sampling type for each streamer (default = SamplingTypes::sampleAll)
   float samplingFrequency[StreamFlags::streamFlagsCount]{0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1}; ///< frequency which is used for the sampling (0.1 -> 10% is written if sampling is used)
   int sampleIDGlobal[StreamFlags::streamFlagsCount]{};                                            ///< storage of reference streamer used for sampleIDFromOtherStreamer
+  float samplingTsallisSqrts{13600.f};                                                            ///< centre-of-mass energy used for the Tsallis sampling
+  int flightRecorderNRows{};                                                                      ///< if >0 keep only the last n rows per streamer in memory and write them only on dumpFlightRecorder()
   O2ParamDef(ParameterDebugStreamer, "DebugStreamerParam");
 };
 
@@ -106,6 +108,12 @@ class DebugStreamer
   /// flush all TTrees to disc
   void flush();
 
+  /// write the flight-recorder rings of all streamers to their files (to be called on error)
+  void dumpFlightRecorder();
+
+  /// install signal handlers (SIGSEGV, SIGBUS, SIGABRT) which dump the flight recorder post-mortem
+  static void enableDumpOnSignal();
+
   /// \return returns streamer object for given id
   /// \param id unique id of streamer
   o2::utils::TreeStreamRedirector& getStreamer(const size_t id = getCPUID()) { return *(mTreeStreamer[id]); }
@@ -152,7 +160,7 @@ class DebugStreamer
 
   /// check if streamer for specific flag is enabled
   /// \param samplingID optional index of the data which is streamed in to perform sampling on this index
-  /// \param weight weight which can be used to perform some weightes sampling
+  /// \param weight weight which can be used to perform some weightes sampling (the transverse momentum for sampleTsallis)
   static bool checkStream(const StreamFlags streamFlag, const size_t samplingID = -1, const float weight = 1);
 
   /// merge trees with the same content structure, but different naming
@@ -212,6 +220,8 @@ class DebugStreamer
 
   GPUd() void flush() const {};
 
+  GPUd() void dumpFlightRecorder() const {};
+
 #endif
 };
 
@@ -62,6 +62,13 @@ class FileFetcher
   float getFailThreshold() const { return mFailThreshold; }
   void setMaxFilesInQueue(size_t s) { mMaxInQueue = s > 0 ? s : 1; }
   void setMaxLoops(size_t v) { mMaxLoops = v; }
+  // number of parallel copy streams for remote files (files are still queued in input order)
+  void setNStreams(size_t n) { mNStreams = n > 0 ? n : 1; }
+  size_t getNStreams() const { return mNStreams; }
+  // optional validation command in format "<operation> ?src ?dst" (e.g. checksum comparison),
+  // executed right after a successful copy; non-zero exit code counts as fetch failure
+  void setCheckCmd(const std::string& cmd) { mCheckCmd = cmd; }
+  const std::string& getCheckCmd() const { return mCheckCmd; }
   bool isRunning() const { return mRunning; }
   bool isFailed() const { return mFailure; }
   void start();
@@ -94,12 +101,14 @@ class FileFetcher
   std::string mCopyDirName{"/tmp"};
   std::string mCopyCmdLogFile{};
   std::string mCopyCmd{};
+  std::string mCheckCmd{};
   std::unique_ptr<std::regex> mSelRegex;
   std::unique_ptr<std::regex> mRemRegex;
   std::unordered_map<std::string, size_t> mCopied{};
   std::vector<FileRef> mInputFiles{};
   size_t mNRemote{0};
   size_t mMaxInQueue{5};
+  size_t mNStreams{1};
   bool mRunning = false;
   bool mNoRemoteCopy = false;
   bool mFailure = false;
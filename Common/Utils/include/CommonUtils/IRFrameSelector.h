@@ -24,8 +24,11 @@ namespace o2::utils
 class IRFrameSelector
 {
  public:
+  static constexpr size_t AutoIndexThreshold = 500000; ///< build the fast index automatically above this number of frames
+
   long check(o2::dataformats::IRFrame fr, size_t bwd = 0, size_t fwd = 0);
   long check(const o2::InteractionRecord& ir, size_t bwd = 0, size_t fwd = 0) { return check(o2::dataformats::IRFrame{ir, ir}, bwd, fwd); }
+  size_t checkBatch(gsl::span<const o2::dataformats::IRFrame> queries, std::vector<long>& results, size_t bwd = 0, size_t fwd = 0);
   gsl::span<const o2::dataformats::IRFrame> getMatchingFrames(const o2::dataformats::IRFrame& fr);
 
   template <typename SPAN>
@@ -33,26 +36,41 @@ class IRFrameSelector
   {
     mFrames = gsl::span<const o2::dataformats::IRFrame>(sp.data(), sp.size());
     mIsSet = true;
+    mOrbitBitmap.clear(); // previous index, if any, is invalid
+    mBucketFirstFrame.clear();
     applyMargins(bwd, fwd, shift, removeOverlaps);
     mLastIRFrameChecked.getMin().clear(); // invalidate
     mLastBoundID = -1;
+    if (mFrames.size() >= AutoIndexThreshold) {
+      buildIndex(mOrbitsPerBucket);
+    }
   }
 
   void clear();
   size_t loadIRFrames(const std::string& fname);
   void applyMargins(size_t bwd, size_t fwd, long shift, bool removeOverlaps = true);
+  void buildIndex(uint32_t orbitsPerBucket = 64);
+  bool isIndexBuilt() const { return !mBucketFirstFrame.empty(); }
+  void restore();
   void print(bool lst = false) const;
 
   auto getIRFrames() const { return mFrames; }
   bool isSet() const { return mIsSet; }
 
  private:
+  long checkIndexed(const o2::dataformats::IRFrame& fr) const;
+
   gsl::span<const o2::dataformats::IRFrame> mFrames{}; // externally provided span of IRFrames, must be sorted in IRFrame.getMin()
   o2::dataformats::IRFrame mLastIRFrameChecked{};      // last frame which was checked
   long mLastBoundID = -1;                              // id of the last checked entry >= mLastIRFrameChecked
   bool mIsSet = false;                                 // flag that something was set (even if empty)
   std::vector<o2::dataformats::IRFrame> mOwnList;      // list loaded from the file
-  ClassDefNV(IRFrameSelector, 1);
+  uint32_t mOrbitsPerBucket = 64;                      //!< granularity of the bucket index in orbits
+  uint32_t mIndexFirstOrbit = 0;                       //!< 1st orbit covered by the index
+  uint32_t mIndexNOrbits = 0;                          //!< number of orbits covered by the index
+  std::vector<uint64_t> mOrbitBitmap;                  //!< bit per orbit: set if some frame intersects it
+  std::vector<uint32_t> mBucketFirstFrame;             //!< 1st frame to inspect for queries starting in given bucket
+  ClassDefNV(IRFrameSelector, 2);
 };
 
 } // namespace o2::utils
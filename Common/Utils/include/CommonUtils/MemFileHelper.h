@@ -160,6 +160,35 @@ struct MemFileHelper {
     return img;
   }
 
+  //________________________________________________________________
+  /// create binary image of the TMemFile directly in the caller-provided char buffer, e.g. a
+  /// vector living in the output message, avoiding the intermediate image and its later copy.
+  /// Returns the image size.
+  template <typename C>
+  static size_t createFileImage(C& dest, const void* obj, const std::type_info& tinfo, const std::string& fileName, const std::string& optName = "")
+  {
+    static_assert(sizeof(typename C::value_type) == 1, "destination must be a byte container");
+    auto memfUPtr = createTMemFile(obj, tinfo, fileName, optName);
+    dest.resize(memfUPtr->GetSize());
+    auto sz = memfUPtr->CopyTo(dest.data(), memfUPtr->GetSize());
+    dest.resize(sz);
+    return sz;
+  }
+
+  //________________________________________________________________
+  /// create binary image of the TMemFile containing the TObject directly in the caller-provided
+  /// char buffer. Returns the image size.
+  template <typename C>
+  static size_t createFileImage(C& dest, const TObject& obj, const std::string& fileName, const std::string& objName)
+  {
+    static_assert(sizeof(typename C::value_type) == 1, "destination must be a byte container");
+    auto memfUPtr = createTMemFile(obj, fileName, objName);
+    dest.resize(memfUPtr->GetSize());
+    auto sz = memfUPtr->CopyTo(dest.data(), memfUPtr->GetSize());
+    dest.resize(sz);
+    return sz;
+  }
+
   ClassDefNV(MemFileHelper, 1);
 };
 
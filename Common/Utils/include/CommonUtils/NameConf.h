@@ -94,6 +94,9 @@ class NameConf : public o2::conf::ConfigurableParamHelper<NameConf>
   // CTF tree name
   static constexpr std::string_view CTFTREENAME = "ctf"; // hardcoded
 
+  // name of the manifest object with the detectors contained in a CTF file
+  static constexpr std::string_view CTFDETSNAME = "ctfdets"; // hardcoded
+
   // CTF Filename
   static std::string getCTFFileName(uint32_t run, uint32_t orb, uint32_t id, const std::string& host, const std::string_view prefix = "o2_ctf");
 
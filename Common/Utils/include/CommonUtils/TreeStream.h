@@ -18,6 +18,8 @@
 
 #include <TString.h>
 #include <TTree.h>
+#include <deque>
+#include <functional>
 #include <vector>
 #include "GPUCommonDef.h"
 
@@ -143,6 +145,16 @@ class TreeStream
 
   TreeStream& operator<<(const Char_t* name);
 
+  /// Switch the stream to deferred filling: at the end of each row the values are
+  /// serialized and handed to the sink instead of being filled into the tree on the
+  /// calling thread. Used by the TreeStreamRedirector async mode, which fills the
+  /// staged rows from its writing thread via fillDeferredRow.
+  void setDeferredFill(std::function<void(std::vector<char>&&)> sink) { mRowSink = std::move(sink); }
+
+  /// Deserialize a staged row and fill it into the tree.
+  /// Must only be called by the owner of the row sink (i.e. on the writing thread).
+  void fillDeferredRow(const std::vector<char>& row);
+
   template <class T>
   TreeStream& operator<<(const T* obj)
   {
@@ -161,6 +173,27 @@ class TreeStream
   Int_t CheckIn(const T* obj);
 
  private:
+  /// writer-side description of a staged element, built from the self-describing rows
+  struct DeferredElement {
+    std::string name;          ///< branch name
+    char type = 0;             ///< elementary type, 0 for objects
+    TClass* cls = nullptr;     ///< object class
+    TBranch* branch = nullptr; ///< branch, created when the element delivers data for the first time
+    void* obj = nullptr;       ///< address of the deserialized object of the row being filled
+  };
+
+  /// tags of the elements within a serialized row
+  enum DeferredTag : char {
+    TagEmpty = 0,        ///< element without data in this row
+    TagPod = 1,          ///< elementary value
+    TagPodDescribed = 2, ///< elementary value preceded by branch name and type
+    TagObject = 3,       ///< streamed object
+    TagObjectDescribed = 4 ///< streamed object preceded by branch name and class name
+  };
+
+  void serializeRow(std::vector<char>& row);
+  static size_t elementSize(char type);
+
   //
   std::vector<TreeDataElement> mElements;
   std::vector<TBranch*> mBranches; ///< pointers to branches
@@ -171,6 +204,11 @@ class TreeStream
   int mStatus = 0;                 ///< status of the layout
   TString mNextName;               ///< name for next entry
 
+  std::function<void(std::vector<char>&&)> mRowSink; //!< if set, completed rows are serialized and staged instead of filled
+  std::vector<bool> mElementDescribed;               //!< elements already described in an earlier staged row
+  bool mRowsStaged = false;                          //!< at least one row was handed to the sink
+  std::deque<DeferredElement> mDeferredElements;     //!< layout mirror owned by the writing thread (stable addresses)
+
   ClassDefNV(TreeStream, 0);
 };
 
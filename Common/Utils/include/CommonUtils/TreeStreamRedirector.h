@@ -18,6 +18,7 @@
 
 #include <Rtypes.h>
 #include <TDirectory.h>
+#include <unordered_map>
 #include "CommonUtils/TreeStream.h"
 
 namespace o2
@@ -36,6 +37,17 @@ namespace utils
 /// The flushing of trees to the file happens on TreeStreamRedirector::Close() call
 /// or at its desctruction.
 ///
+/// By default the trees are filled (and their baskets compressed and written)
+/// synchronously on the calling thread. Calling EnableAsyncWriting() before the
+/// first stream is used moves this work to a background thread: the calling
+/// thread only serializes the row values into a bounded lock-free staging
+/// buffer and blocks only when the writing thread cannot keep up.
+///
+/// Alternatively, EnableFlightRecorder() keeps only the last rows of each
+/// stream in a memory ring without any I/O; the recorded rows are filled and
+/// written only when DumpFlightRecorder() is called, e.g. from an error
+/// handler, while rows never dumped are discarded on Close().
+///
 /// See testTreeStream.cxx for functional example
 ///
 class TreeStreamRedirector
@@ -50,15 +62,23 @@ class TreeStreamRedirector
   virtual TreeStream& operator<<(const char* name);
   void SetDirectory(TDirectory* sfile);
   void SetFile(TFile* sfile);
+  void EnableAsyncWriting(size_t maxStagedBytes = 256 * 1024 * 1024);
+  void EnableFlightRecorder(size_t maxRows = 10000);
+  void DumpFlightRecorder();
   static void FixLeafNameBug(TTree* tree);
 
  private:
   TreeStreamRedirector(const TreeStreamRedirector& tsr);
   TreeStreamRedirector& operator=(const TreeStreamRedirector& tsr);
 
+  class AsyncWriter; // staging buffer and writing thread of the async mode
+
   std::unique_ptr<TDirectory> mOwnDirectory;             // own directory of the redirector
   TDirectory* mDirectory = nullptr;                      // output directory
   std::vector<std::unique_ptr<TreeStream>> mDataLayouts; // array of data layouts
+  std::unique_ptr<AsyncWriter> mAsyncWriter;             //! background writer (see EnableAsyncWriting)
+  size_t mFlightRecorderRows = 0;                        //! ring depth per stream (see EnableFlightRecorder)
+  std::unordered_map<TreeStream*, std::deque<std::vector<char>>> mFlightRows; //! recorded rows per stream
 
   ClassDefNV(TreeStreamRedirector, 0);
 };
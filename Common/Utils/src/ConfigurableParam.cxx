@@ -349,6 +349,51 @@ void ConfigurableParam::initialize()
 
 // ------------------------------------------------------------------
 
+namespace
+{
+// flat key table frozen after initialization: sorted by hash for binary
+// search, the full key disambiguates (unlikely) hash collisions
+struct FlatKeyEntry {
+  uint64_t hash = 0;
+  std::string key{};
+  std::type_info const* type = nullptr;
+  void* ptr = nullptr;
+};
+std::vector<FlatKeyEntry> sFlatKeyTable;
+size_t sFlatKeyTableSourceSize = 0;
+} // namespace
+
+const void* ConfigurableParam::resolveKey(uint64_t hash, std::string_view key, std::type_info const& tinfo)
+{
+  if (!sIsFullyInitialized) {
+    initialize();
+  }
+  if (sFlatKeyTableSourceSize != sKeyToStorageMap->size()) {
+    // (re-)freeze the table; this can happen again only when a dynamically
+    // loaded library registers additional parameter classes
+    sFlatKeyTable.clear();
+    sFlatKeyTable.reserve(sKeyToStorageMap->size());
+    for (auto& entry : *sKeyToStorageMap) {
+      sFlatKeyTable.push_back(FlatKeyEntry{hashKey(entry.first), entry.first, &entry.second.first, entry.second.second});
+    }
+    std::sort(sFlatKeyTable.begin(), sFlatKeyTable.end(), [](FlatKeyEntry const& a, FlatKeyEntry const& b) { return a.hash < b.hash; });
+    sFlatKeyTableSourceSize = sKeyToStorageMap->size();
+  }
+  auto iter = std::lower_bound(sFlatKeyTable.begin(), sFlatKeyTable.end(), hash, [](FlatKeyEntry const& a, uint64_t h) { return a.hash < h; });
+  for (; iter != sFlatKeyTable.end() && iter->hash == hash; ++iter) {
+    if (iter->key == key) {
+      if (*(iter->type) != tinfo) {
+        LOG(fatal) << "Type mismatch for parameter key " << key << " (member is of type " << iter->type->name() << ")";
+      }
+      return iter->ptr;
+    }
+  }
+  LOG(fatal) << "Unknown parameter key " << key;
+  return nullptr;
+}
+
+// ------------------------------------------------------------------
+
 void ConfigurableParam::printAllRegisteredParamNames()
 {
   for (auto p : *sRegisteredParamClasses) {
@@ -15,8 +15,10 @@
 #include <fmt/format.h>
 #include "TROOT.h"
 #include "TKey.h"
+#include <csignal>
 #include <random>
 #include "Framework/Logger.h"
+#include "MathUtils/Tsallis.h"
 #endif
 
 O2ParamImpl(o2::utils::ParameterDebugStreamer);
@@ -32,6 +34,12 @@ void o2::utils::DebugStreamer::setStreamer(const char* outFile, const char* opti
 {
   if (!isStreamerSet(id)) {
     mTreeStreamer[id] = std::make_unique<o2::utils::TreeStreamRedirector>(fmt::format("{}_{}.root", outFile, id).data(), option);
+    const int nRowsFlightRecorder = ParameterDebugStreamer::Instance().flightRecorderNRows;
+    if (nRowsFlightRecorder > 0) {
+      // keep the instrumentation always-on without steady-state I/O: only the
+      // last rows are kept in memory and written on dumpFlightRecorder()
+      mTreeStreamer[id]->EnableFlightRecorder(nRowsFlightRecorder);
+    }
   }
 }
 
@@ -55,6 +63,30 @@ void o2::utils::DebugStreamer::flush()
   }
 }
 
+void o2::utils::DebugStreamer::dumpFlightRecorder()
+{
+  for (const auto& pair : mTreeStreamer) {
+    if (pair.second) {
+      pair.second->DumpFlightRecorder();
+    }
+  }
+}
+
+void o2::utils::DebugStreamer::enableDumpOnSignal()
+{
+  // Best effort post-mortem dump of the flight recorder: writing ROOT files is
+  // not async-signal-safe, but in a fatal-signal context losing the dump is no
+  // worse than not attempting it. The default handler is restored and the
+  // signal re-raised afterwards, so the process still terminates as usual.
+  for (const int sig : {SIGSEGV, SIGBUS, SIGABRT}) {
+    std::signal(sig, [](int signal) {
+      instance()->dumpFlightRecorder();
+      std::signal(signal, SIG_DFL);
+      std::raise(signal);
+    });
+  }
+}
+
 bool o2::utils::DebugStreamer::checkStream(const StreamFlags streamFlag, const size_t samplingID, const float weight)
 {
   const bool isStreamerSet = ((getStreamFlags() & streamFlag) == streamFlag);
@@ -102,6 +134,10 @@ bool o2::utils::DebugStreamer::checkStream(const StreamFlags streamFlag, const s
     } else if (sampling.first == SamplingTypes::sampleWeights) {
       // sample with weight
       return (weight * getRandom() < sampling.second);
+    } else if (sampling.first == SamplingTypes::sampleTsallis) {
+      // downsampling flat in q/pt using the Tsallis/Hagedorn spectra fit; the weight argument is the pt
+      float tsallisWeight = 0;
+      return o2::math_utils::Tsallis::downsampleTsallisCharged(weight, sampling.second, ParameterDebugStreamer::Instance().samplingTsallisSqrts, tsallisWeight, getRandom());
     }
   }
   return true;
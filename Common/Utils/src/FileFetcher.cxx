@@ -16,8 +16,10 @@
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/FileSystemUtils.h"
 #include "Framework/Logger.h"
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <thread>
 #include <chrono>
@@ -267,14 +269,53 @@ void FileFetcher::fetcher()
     }
   }
 
+  // copies dispatched to the parallel streams, in dispatch order: harvesting
+  // only the front entry preserves the input order in the readiness queue,
+  // while the copies of the following files proceed in the background
+  std::deque<std::pair<size_t, std::future<bool>>> inFlight;
+
+  auto accountFailure = [this]() {
+    if (mFailThreshold < 0.f) { // cut on abs number of failures
+      if (mNFilesProc - mNFilesProcOK > -mNFilesProcOK) {
+        mFailure = true;
+      }
+    } else if (mFailThreshold > 0.f) {
+      float fracFail = mNLoops ? (mNFilesProc - mNFilesProcOK) / float(mNFilesProc) : (mNFilesProc - mNFilesProcOK) / float(getNFiles());
+      mFailure = fracFail > mFailThreshold;
+    }
+    if (mFailure) {
+      mRunning = false;
+    }
+  };
+
   while (mRunning) {
+    // harvest finished copies from the front of the dispatch order
+    while (!inFlight.empty() && inFlight.front().second.wait_for(0s) == std::future_status::ready) {
+      const auto entry = inFlight.front().first;
+      const bool copiedOK = inFlight.front().second.get();
+      inFlight.pop_front();
+      if (copiedOK) {
+        mInputFiles[entry].copied = true;
+        mQueue.push(entry);
+        mNFilesProcOK++;
+      } else {
+        accountFailure();
+      }
+    }
+    if (!mRunning) {
+      break;
+    }
     mNLoops = mNFilesProc / getNFiles();
     if (mNLoops > mMaxLoops) {
+      if (!inFlight.empty()) { // let the dispatched copies drain
+        std::this_thread::sleep_for(5ms);
+        continue;
+      }
       LOGP(info, "Finished file fetching: {} of {} files fetched successfully in {} iterations", mNFilesProcOK, mNFilesProc, mMaxLoops);
       mRunning = false;
       break;
     }
-    if (getQueueSize() >= mMaxInQueue) {
+    if (getQueueSize() + inFlight.size() >= mMaxInQueue || inFlight.size() >= mNStreams) {
       std::this_thread::sleep_for(5ms);
       continue;
     }
@@ -285,27 +326,16 @@ void FileFetcher::fetcher()
     mNFilesProc++;
     auto& fileRef = mInputFiles[fileEntry];
     if (fileRef.copied || !fileRef.remote || mNoRemoteCopy) {
-      mQueue.push(fileEntry);
-      mNFilesProcOK++;
-    } else { // need to copy
-      if (copyFile(fileEntry)) {
-        fileRef.copied = true;
+      if (inFlight.empty()) { // can go to the queue right away
         mQueue.push(fileEntry);
         mNFilesProcOK++;
-      } else {
-        if (mFailThreshold < 0.f) { // cut on abs number of failures
-          if (mNFilesProc - mNFilesProcOK > -mNFilesProcOK) {
-            mFailure = true;
-          }
-        } else if (mFailThreshold > 0.f) {
-          float fracFail = mNLoops ? (mNFilesProc - mNFilesProcOK) / float(mNFilesProc) : (mNFilesProc - mNFilesProcOK) / float(getNFiles());
-          mFailure = fracFail > mFailThreshold;
-        }
-        if (mFailure) {
-          mRunning = false;
-          break;
-        }
+      } else { // the preceding copies must be queued first
+        std::promise<bool> ready;
+        ready.set_value(true);
+        inFlight.emplace_back(fileEntry, ready.get_future());
       }
+    } else { // need to copy: dispatch to a parallel stream
+      inFlight.emplace_back(fileEntry, std::async(std::launch::async, &FileFetcher::copyFile, this, fileEntry));
     }
   }
 }
@@ -365,6 +395,19 @@ bool FileFetcher::copyFile(size_t id)
     LOGP(alarm, "FileFetcher: failed for copy command {}", realCmd);
     return false;
   }
-  mCopied[mInputFiles[id].getLocalName()] = id + 1;
+  if (!mCheckCmd.empty()) {
+    // validate the freshly staged file (still in the page cache), e.g. by checksum comparison
+    auto checkCmd = std::regex_replace(std::regex_replace(mCheckCmd, std::regex(R"(\?src)"), mInputFiles[id].getOrigName()), std::regex(R"(\?dst)"), mInputFiles[id].getLocalName());
+    auto fullCheckCmd = fmt::format(R"(sh -c "{}" >> {}  2>&1)", checkCmd, mCopyCmdLogFile);
+    if (gSystem->Exec(fullCheckCmd.c_str()) != 0) {
+      LOGP(alarm, "FileFetcher: staged file failed validation by {}", checkCmd);
+      fs::remove(mInputFiles[id].getLocalName());
+      return false;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMtx); // copyFile may run on parallel streams
+    mCopied[mInputFiles[id].getLocalName()] = id + 1;
+  }
   return true;
 }
@@ -42,6 +42,11 @@ long IRFrameSelector::check(o2::dataformats::IRFrame fr, size_t bwd, size_t fwd)
   if (fwd) {
     fr.setMax(o2::InteractionRecord::MaxGlobalBCs - fr.getMax().toLong() > fwd ? fr.getMax() + fwd : o2::InteractionRecord::getIRMaxBC());
   }
+  if (isIndexBuilt()) {
+    ans = checkIndexed(fr);
+    mLastIRFrameChecked = fr;
+    return ans;
+  }
   // find entry which overlaps or above fr
   auto fullcheck = [&fr, this]() -> long {
     auto lower = std::lower_bound(this->mFrames.begin(), this->mFrames.end(), fr);
@@ -100,6 +105,123 @@ long IRFrameSelector::check(o2::dataformats::IRFrame fr, size_t bwd, size_t fwd)
   return ans;
 }
 
+long IRFrameSelector::checkIndexed(const o2::dataformats::IRFrame& fr) const
+{
+  // query via the orbit bitmap and the bucket index: O(1 + k) instead of binary search over millions of frames
+  if (!mFrames.size() || fr.getMax() < mFrames.front().getMin()) {
+    return -1;
+  }
+  uint32_t omin = fr.getMin().orbit > mIndexFirstOrbit ? fr.getMin().orbit - mIndexFirstOrbit : 0;
+  if (omin >= mIndexNOrbits) {
+    return -1;
+  }
+  uint32_t omax = fr.getMax().orbit > mIndexFirstOrbit ? fr.getMax().orbit - mIndexFirstOrbit : 0;
+  if (omax >= mIndexNOrbits) {
+    omax = mIndexNOrbits - 1;
+  }
+  // reject queries not touching any selected orbit without looking at the frames
+  bool any = false;
+  uint32_t wmin = omin >> 6, wmax = omax >> 6;
+  uint64_t mskMin = ~uint64_t(0) << (omin & 63), mskMax = ~uint64_t(0) >> (63 - (omax & 63));
+  if (wmin == wmax) {
+    any = (mOrbitBitmap[wmin] & mskMin & mskMax) != 0;
+  } else {
+    any = (mOrbitBitmap[wmin] & mskMin) != 0 || (mOrbitBitmap[wmax] & mskMax) != 0;
+    for (uint32_t w = wmin + 1; w < wmax && !any; w++) {
+      any = mOrbitBitmap[w] != 0;
+    }
+  }
+  if (!any) {
+    return -1;
+  }
+  for (size_t i = mBucketFirstFrame[omin / mOrbitsPerBucket]; i < mFrames.size(); i++) {
+    auto res = fr.isOutside(mFrames[i]);
+    if (res == o2::dataformats::IRFrame::Inside) {
+      return long(i);
+    } else if (res == o2::dataformats::IRFrame::Above) {
+      break;
+    }
+  }
+  return -1;
+}
+
+size_t IRFrameSelector::checkBatch(gsl::span<const o2::dataformats::IRFrame> queries, std::vector<long>& results, size_t bwd, size_t fwd)
+{
+  // check a span of queries sorted in getMin(), filling for each the id of the matching frame or -1
+  results.clear();
+  results.reserve(queries.size());
+  size_t nMatched = 0;
+  for (const auto& q : queries) {
+    auto id = check(q, bwd, fwd);
+    if (id >= 0) {
+      nMatched++;
+    }
+    results.push_back(id);
+  }
+  return nMatched;
+}
+
+void IRFrameSelector::buildIndex(uint32_t orbitsPerBucket)
+{
+  // build orbit bitmap (fast rejection) and bucket index (entry point into the sorted frames) over the
+  // currently set frames; pays off for selections with >~ 10^5 frames, e.g. skimmed reprocessing
+  mOrbitBitmap.clear();
+  mBucketFirstFrame.clear();
+  if (!mIsSet || !mFrames.size()) {
+    return;
+  }
+  mOrbitsPerBucket = orbitsPerBucket > 0 ? orbitsPerBucket : 1;
+  mIndexFirstOrbit = mFrames.front().getMin().orbit;
+  uint32_t lastOrbit = mIndexFirstOrbit;
+  for (const auto& f : mFrames) { // frames are sorted in getMin() but getMax() may be non-monotonic if overlaps were kept
+    if (f.getMax().orbit > lastOrbit) {
+      lastOrbit = f.getMax().orbit;
+    }
+  }
+  mIndexNOrbits = lastOrbit - mIndexFirstOrbit + 1;
+  mOrbitBitmap.resize((size_t(mIndexNOrbits) + 63) / 64, 0);
+  for (const auto& f : mFrames) {
+    uint32_t a = f.getMin().orbit > mIndexFirstOrbit ? f.getMin().orbit - mIndexFirstOrbit : 0, b = f.getMax().orbit - mIndexFirstOrbit;
+    uint32_t wa = a >> 6, wb = b >> 6;
+    uint64_t mska = ~uint64_t(0) << (a & 63), mskb = ~uint64_t(0) >> (63 - (b & 63));
+    if (wa == wb) {
+      mOrbitBitmap[wa] |= mska & mskb;
+    } else {
+      mOrbitBitmap[wa] |= mska;
+      for (uint32_t w = wa + 1; w < wb; w++) {
+        mOrbitBitmap[w] = ~uint64_t(0);
+      }
+      mOrbitBitmap[wb] |= mskb;
+    }
+  }
+  size_t nBuckets = (size_t(mIndexNOrbits) + mOrbitsPerBucket - 1) / mOrbitsPerBucket;
+  mBucketFirstFrame.resize(nBuckets);
+  size_t ptr = 0; // once a frame ends before a bucket start, it ends before all later ones, so a single sweep suffices
+  for (size_t b = 0; b < nBuckets; b++) {
+    o2::InteractionRecord bucketStart{0, uint32_t(mIndexFirstOrbit + b * mOrbitsPerBucket)};
+    while (ptr < mFrames.size() && mFrames[ptr].getMax() < bucketStart) {
+      ptr++;
+    }
+    mBucketFirstFrame[b] = uint32_t(ptr);
+  }
+  LOGP(info, "Built index over {} IRFrames spanning {} orbits: {} KB bitmap + {} KB buckets of {} orbits",
+       mFrames.size(), mIndexNOrbits, mOrbitBitmap.size() * sizeof(uint64_t) / 1024, mBucketFirstFrame.size() * sizeof(uint32_t) / 1024, mOrbitsPerBucket);
+}
+
+void IRFrameSelector::restore()
+{
+  // re-attach the frames span to the owned list and rebuild the transient index, e.g. after the
+  // selection was deserialized from a CCDB object or a file
+  mFrames = gsl::span<const o2::dataformats::IRFrame>(mOwnList.data(), mOwnList.size());
+  mLastIRFrameChecked.getMin().clear(); // invalidate
+  mLastBoundID = -1;
+  mOrbitBitmap.clear();
+  mBucketFirstFrame.clear();
+  if (mFrames.size() >= AutoIndexThreshold) {
+    buildIndex(mOrbitsPerBucket);
+  }
+}
+
 size_t IRFrameSelector::loadIRFrames(const std::string& fname)
 {
   // read IRFrames to filter from the file
@@ -184,6 +306,8 @@ void IRFrameSelector::clear()
   mIsSet = false;
   mOwnList.clear();
   mFrames = {};
+  mOrbitBitmap.clear();
+  mBucketFirstFrame.clear();
 }
 
 void IRFrameSelector::applyMargins(size_t bwd, size_t fwd, long shift, bool removeOverlaps)
@@ -219,4 +343,7 @@ void IRFrameSelector::applyMargins(size_t bwd, size_t fwd, long shift, bool remo
   }
   mOwnList.swap(lst);
   mFrames = gsl::span<const o2::dataformats::IRFrame>(mOwnList.data(), mOwnList.size());
+  if (isIndexBuilt()) {
+    buildIndex(mOrbitsPerBucket);
+  }
 }
@@ -29,6 +29,12 @@
 #include <cstdlib>
 #include <cassert>
 
+#ifdef __linux__
+#include <filesystem>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 using namespace boost::interprocess;
 
 namespace o2
@@ -40,6 +46,80 @@ namespace utils
 const char* SHMIDNAME = "ALICEO2_SIMSHM_SHMID";
 // a common virtual address under which this should be mapped
 const char* SHMADDRNAME = "ALICEO2_SIMSHM_COMMONADDR";
+// if set, no NUMA memory policy is applied to the segments
+const char* SHMNONUMANAME = "ALICEO2_SIMSHM_NONUMA";
+
+namespace
+{
+#if defined(__linux__) && defined(SYS_mbind)
+// memory policy modes from <numaif.h>, spelled out here to avoid a libnuma dependency
+constexpr int MPolPreferred = 1;
+constexpr int MPolInterleave = 3;
+
+// apply a NUMA memory policy to the full pages of the given range;
+// only affects pages not yet faulted in, which is what we want:
+// the data pages are placed according to the policy on first touch
+bool applyMemPolicy(void* addr, size_t length, int mode, const unsigned long* nodemask, unsigned long maxnode)
+{
+  const size_t pagesize = sysconf(_SC_PAGESIZE);
+  const auto begin = (((size_t)addr + pagesize - 1) / pagesize) * pagesize;
+  const auto end = (((size_t)addr + length) / pagesize) * pagesize;
+  if (end <= begin) {
+    return true;
+  }
+  return syscall(SYS_mbind, begin, end - begin, mode, nodemask, maxnode, 0u) == 0;
+}
+
+// number of online NUMA nodes (1 on non-NUMA machines)
+int countNumaNodes()
+{
+  int nodes = 0;
+  while (std::filesystem::exists("/sys/devices/system/node/node" + std::to_string(nodes))) {
+    nodes++;
+  }
+  return nodes > 0 ? nodes : 1;
+}
+#endif
+
+// interleave the pages of a shared read-mostly region across all NUMA nodes
+void interleaveSegment(void* addr, size_t length)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  if (getenv(SHMNONUMANAME)) {
+    return;
+  }
+  const int nodes = countNumaNodes();
+  if (nodes < 2 || nodes > (int)(8 * sizeof(unsigned long))) {
+    return;
+  }
+  const unsigned long nodemask = (1ul << nodes) - 1;
+  if (applyMemPolicy(addr, length, MPolInterleave, &nodemask, nodes + 1)) {
+    LOG(info) << "INTERLEAVING SEGMENT PAGES ACROSS " << nodes << " NUMA NODES";
+  } else {
+    LOG(debug) << "Could not apply the interleave memory policy to the shared segment";
+  }
+#endif
+}
+
+// prefer placing the pages of a worker-private region on the NUMA node the worker runs on
+void bindSegmentToLocalNode(void* addr, size_t length)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  if (getenv(SHMNONUMANAME)) {
+    return;
+  }
+  if (countNumaNodes() < 2) {
+    return;
+  }
+  // MPOL_PREFERRED with an empty node mask means "the node of the faulting thread"
+  if (applyMemPolicy(addr, length, MPolPreferred, nullptr, 0)) {
+    LOG(info) << "BINDING SEGMENT PAGES TO THE LOCAL NUMA NODE";
+  } else {
+    LOG(debug) << "Could not apply the preferred-local memory policy to the segment";
+  }
+#endif
+}
+} // namespace
 
 ShmManager::ShmManager() = default;
 
@@ -132,6 +212,10 @@ bool ShmManager::createGlobalSegment(int nsegments)
     mSegPtr = addr;
     LOG(debug) << "COMMON ADDRESS " << addr << " AS NUMBER " << (unsigned long long)addr;
 
+    // spread the pages the master touches (meta information and anything read back)
+    // evenly across the NUMA nodes; the workers bind their own subsegments locally
+    interleaveSegment(addr, totalsize);
+
     // initialize the meta information (counter)
     o2::utils::ShmMetaInfo info;
     std::memcpy(addr, &info, sizeof(info));
@@ -201,6 +285,10 @@ void ShmManager::occupySegment()
 
     assert((unsigned long long)((char*)mBufferPtr - (char*)addr) + SHMPOOLSIZE <= info->allocedbytes);
 
+    // place the pages of this worker's subsegment on the NUMA node the worker runs on;
+    // has to happen before the first touch by the managed buffer below
+    bindSegmentToLocalNode(mBufferPtr, SHMPOOLSIZE);
+
     boostmanagedbuffer = new boost::interprocess::wmanaged_external_buffer(create_only, mBufferPtr, SHMPOOLSIZE);
     boostallocator = new boost::interprocess::allocator<char, wmanaged_external_buffer::segment_manager>(
       boostmanagedbuffer->get_segment_manager());
@@ -13,6 +13,9 @@
 
 #include "CommonUtils/TreeStream.h"
 #include <TBranch.h>
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <cstring>
 
 using namespace o2::utils;
 
@@ -135,6 +138,20 @@ TreeStream& TreeStream::Endl()
 {
   // Perform pseudo endl operation
 
+  if (mRowSink) {
+    // deferred mode: serialize the row and stage it for the writing thread,
+    // which deserializes and fills it via fillDeferredRow
+    if (!mStatus && !mElements.empty()) {
+      std::vector<char> row;
+      serializeRow(row);
+      mRowsStaged = true;
+      mRowSink(std::move(row));
+    }
+    mStatus = 0;
+    mCurrentIndex = 0;
+    return *this;
+  }
+
   if (mTree.GetNbranches() == 0) {
     BuildTree();
   }
@@ -154,7 +171,8 @@ TreeStream& TreeStream::operator<<(const Char_t* name)
   }
   //
   // if tree was already defined ignore
-  if (mTree.GetEntries() > 0) {
+  // (in deferred mode the writing thread owns the tree, so it must not be queried here)
+  if (mRowsStaged || mTree.GetEntries() > 0) {
     return *this;
   }
   // check branch name if tree was not
@@ -173,3 +191,154 @@ TreeStream& TreeStream::operator<<(const Char_t* name)
   }
   return *this;
 }
+
+//_________________________________________________
+size_t TreeStream::elementSize(char type)
+{
+  // size in bytes of an elementary data element of given type
+
+  switch (type) {
+    case 'B':
+    case 'b':
+      return 1;
+    case 'S':
+    case 's':
+      return 2;
+    case 'I':
+    case 'i':
+    case 'F':
+      return 4;
+    case 'L':
+    case 'l':
+    case 'D':
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+//_________________________________________________
+void TreeStream::serializeRow(std::vector<char>& row)
+{
+  // Serialize the current row into a self-describing byte buffer: each element is
+  // tagged and, the first time it delivers data, preceded by its branch name and
+  // type/class name. This way the writing thread can rebuild the layout from the
+  // staged rows alone, without sharing any state with this (the filling) thread.
+
+  auto append = [&row](const void* src, size_t n) {
+    const char* c = reinterpret_cast<const char*>(src);
+    row.insert(row.end(), c, c + n);
+  };
+
+  if (mElementDescribed.size() < mElements.size()) {
+    mElementDescribed.resize(mElements.size(), false);
+  }
+
+  for (size_t i = 0; i < mElements.size(); i++) {
+    auto& element = mElements[i];
+    if (element.cls && element.ptr) {
+      TBufferFile msg(TBuffer::kWrite);
+      msg.WriteObjectAny(element.ptr, const_cast<TClass*>(element.cls));
+      const uint32_t length = msg.Length();
+      if (!mElementDescribed[i]) {
+        row.push_back(TagObjectDescribed);
+        append(element.name.c_str(), element.name.size() + 1);
+        const char* clname = element.cls->GetName();
+        append(clname, std::strlen(clname) + 1);
+        mElementDescribed[i] = true;
+      } else {
+        row.push_back(TagObject);
+      }
+      append(&length, sizeof(length));
+      append(msg.Buffer(), length);
+    } else if (element.type > 0) {
+      if (!mElementDescribed[i]) {
+        row.push_back(TagPodDescribed);
+        append(element.name.c_str(), element.name.size() + 1);
+        row.push_back(element.type);
+        mElementDescribed[i] = true;
+      } else {
+        row.push_back(TagPod);
+      }
+      append(element.ptr, elementSize(element.type));
+    } else {
+      // object element without data in this row (or element without type and class)
+      row.push_back(TagEmpty);
+    }
+  }
+}
+
+//_________________________________________________
+void TreeStream::fillDeferredRow(const std::vector<char>& row)
+{
+  // Counterpart of serializeRow: rebuild the layout from the tags, point the
+  // branches into the row buffer (respectively deserialize the objects) and fill.
+  // Branches showing up after the first row are backfilled like in BuildTree.
+
+  const int entriesFilled = mTree.GetEntries();
+  size_t off = 0;
+  size_t idx = 0;
+  while (off < row.size()) {
+    if (idx >= mDeferredElements.size()) {
+      mDeferredElements.emplace_back();
+    }
+    auto& element = mDeferredElements[idx++];
+    const char tag = row[off++];
+    if (tag == TagEmpty) {
+      element.obj = nullptr;
+      continue;
+    }
+    if (tag == TagPodDescribed || tag == TagObjectDescribed) {
+      element.name = row.data() + off;
+      off += element.name.size() + 1;
+      if (tag == TagPodDescribed) {
+        element.type = row[off++];
+      } else {
+        element.cls = TClass::GetClass(row.data() + off);
+        off += std::strlen(row.data() + off) + 1;
+      }
+    }
+    if (element.type > 0) {
+      void* addr = const_cast<char*>(row.data() + off);
+      off += elementSize(element.type);
+      if (!element.branch) {
+        TString nameC = TString::Format("%s/%c", element.name.c_str(), element.type);
+        element.branch = mTree.Branch(element.name.c_str(), addr, nameC.Data());
+        if (entriesFilled) {
+          element.branch->SetAddress(nullptr);
+          for (int ientry = 0; ientry < entriesFilled; ientry++) {
+            element.branch->Fill();
+          }
+          element.branch->SetAddress(addr);
+        }
+      } else {
+        element.branch->SetAddress(addr);
+      }
+    } else {
+      uint32_t length = 0;
+      std::memcpy(&length, row.data() + off, sizeof(length));
+      off += sizeof(length);
+      TBufferFile msg(TBuffer::kRead, length, const_cast<char*>(row.data() + off), kFALSE);
+      off += length;
+      element.obj = msg.ReadObjectAny(element.cls);
+      if (!element.branch && element.cls) {
+        element.branch = mTree.Branch(element.name.c_str(), element.cls->GetName(), &element.obj);
+        if (entriesFilled) {
+          element.branch->SetAddress(nullptr);
+          for (int ientry = 0; ientry < entriesFilled; ientry++) {
+            element.branch->Fill();
+          }
+          element.branch->SetAddress(&element.obj);
+        }
+      }
+    }
+  }
+  mTree.Fill();
+  // the deserialized objects were created above and are owned here
+  for (auto& element : mDeferredElements) {
+    if (element.obj && element.cls) {
+      element.cls->Destructor(element.obj);
+      element.obj = nullptr;
+    }
+  }
+}
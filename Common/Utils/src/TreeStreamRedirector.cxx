@@ -14,10 +14,106 @@
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <TFile.h>
 #include <TLeaf.h>
+#include <TROOT.h>
+#include <fairlogger/Logger.h>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <mutex>
+#include <thread>
 
 using namespace o2::utils;
 
+/// The AsyncWriter stages serialized rows in a bounded single-producer
+/// single-consumer lock-free ring buffer and fills them into the trees (which
+/// includes the basket compression and the file I/O) from its own thread.
+/// The producer blocks only when the ring or the byte budget is exhausted,
+/// which bounds the memory held by staged rows.
+class TreeStreamRedirector::AsyncWriter
+{
+ public:
+  AsyncWriter(size_t maxStagedBytes) : mMaxStagedBytes(maxStagedBytes), mSlots(QueueCapacity)
+  {
+    ROOT::EnableThreadSafety();
+    mThread = std::thread(&AsyncWriter::run, this);
+  }
+
+  ~AsyncWriter()
+  {
+    stop();
+  }
+
+  /// stage a row for the given stream; blocks if the buffer is full (backpressure)
+  void enqueue(TreeStream* stream, std::vector<char>&& row)
+  {
+    const size_t bytes = row.size();
+    while (mStagedBytes.load(std::memory_order_acquire) + bytes > mMaxStagedBytes &&
+           mStagedBytes.load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+    while (tail - mHead.load(std::memory_order_acquire) >= mSlots.size()) {
+      std::this_thread::yield();
+    }
+    auto& slot = mSlots[tail % mSlots.size()];
+    slot.stream = stream;
+    slot.row = std::move(row);
+    mStagedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    mTail.store(tail + 1, std::memory_order_release);
+  }
+
+  /// drain the staged rows and terminate the writing thread
+  void stop()
+  {
+    if (mThread.joinable()) {
+      mStop.store(true, std::memory_order_release);
+      mThread.join();
+    }
+  }
+
+  /// serializes the creation of new trees against the writing of staged rows
+  std::mutex& getDirectoryMutex() { return mDirectoryMutex; }
+
+ private:
+  struct Slot {
+    TreeStream* stream = nullptr;
+    std::vector<char> row;
+  };
+
+  void run()
+  {
+    while (true) {
+      const size_t head = mHead.load(std::memory_order_relaxed);
+      if (head == mTail.load(std::memory_order_acquire)) {
+        if (mStop.load(std::memory_order_acquire)) {
+          break;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        continue;
+      }
+      auto& slot = mSlots[head % mSlots.size()];
+      {
+        std::lock_guard<std::mutex> lock(mDirectoryMutex);
+        slot.stream->fillDeferredRow(slot.row);
+      }
+      mStagedBytes.fetch_sub(slot.row.size(), std::memory_order_release);
+      std::vector<char>().swap(slot.row); // release the buffer memory
+      mHead.store(head + 1, std::memory_order_release);
+    }
+  }
+
+  static constexpr size_t QueueCapacity = 4096; ///< number of slots of the ring buffer
+
+  const size_t mMaxStagedBytes;         ///< byte budget of the staged rows
+  std::vector<Slot> mSlots;             ///< ring buffer slots
+  std::atomic<size_t> mHead{0};         ///< next slot to be consumed
+  std::atomic<size_t> mTail{0};         ///< next slot to be filled
+  std::atomic<size_t> mStagedBytes{0};  ///< bytes currently staged
+  std::atomic<bool> mStop{false};       ///< request to drain and terminate
+  std::mutex mDirectoryMutex;           ///< held while touching the output directory
+  std::thread mThread;                  ///< the writing thread
+};
+
 //_________________________________________________
 TreeStreamRedirector::TreeStreamRedirector(const char* fname, const char* option)
 {
@@ -46,6 +142,74 @@ void TreeStreamRedirector::SetFile(TFile* sfile)
   SetDirectory(sfile);
 }
 
+//_________________________________________________
+void TreeStreamRedirector::EnableAsyncWriting(size_t maxStagedBytes)
+{
+  // Fill, compress and write the trees on a background thread: the calling
+  // thread only serializes the completed rows into a bounded staging buffer.
+  // Must be called before the first stream is used; the redirector (and its
+  // streams) must then be fed from a single thread.
+
+  if (!mDataLayouts.empty()) {
+    LOG(warn) << "async writing must be enabled before the first stream is used";
+    return;
+  }
+  if (mFlightRecorderRows) {
+    LOG(warn) << "async writing cannot be combined with the flight recorder";
+    return;
+  }
+  if (!mAsyncWriter) {
+    mAsyncWriter = std::make_unique<AsyncWriter>(maxStagedBytes);
+  }
+}
+
+//_________________________________________________
+void TreeStreamRedirector::EnableFlightRecorder(size_t maxRows)
+{
+  // Keep only the last maxRows rows of each stream in a memory ring instead of
+  // filling them: the recorded rows are filled and written only when
+  // DumpFlightRecorder() is called (e.g. from an error handler), so always-on
+  // instrumentation costs only the serialization of the row values.
+  // Rows which were never dumped are discarded on Close().
+
+  if (!mDataLayouts.empty()) {
+    LOG(warn) << "the flight recorder must be enabled before the first stream is used";
+    return;
+  }
+  if (mAsyncWriter) {
+    LOG(warn) << "the flight recorder cannot be combined with async writing";
+    return;
+  }
+  mFlightRecorderRows = maxRows;
+}
+
+//_________________________________________________
+void TreeStreamRedirector::DumpFlightRecorder()
+{
+  // Fill the recorded rows into the trees and write them out. Best effort:
+  // this is meant to be callable also from an error/signal context.
+
+  if (!mDirectory) {
+    return;
+  }
+  TDirectory* backup = gDirectory;
+  mDirectory->cd();
+  for (auto& layout : mDataLayouts) {
+    auto rows = mFlightRows.find(layout.get());
+    if (rows == mFlightRows.end() || rows->second.empty()) {
+      continue;
+    }
+    for (auto& row : rows->second) {
+      layout->fillDeferredRow(row);
+    }
+    rows->second.clear();
+    layout->getTree().Write(layout->getName(), TObject::kOverwrite);
+  }
+  if (backup) {
+    backup->cd();
+  }
+}
+
 //_________________________________________________
 void TreeStreamRedirector::SetDirectory(TDirectory* sfile)
 {
@@ -73,10 +237,29 @@ TreeStream& TreeStreamRedirector::operator<<(Int_t id)
   }
 
   TDirectory* backup = gDirectory;
-  mDirectory->cd();
-  mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(Form("Tree%d", id))));
+  {
+    // the creation of the tree touches the output directory, which the
+    // writing thread of the async mode may be using at the same time
+    std::unique_lock<std::mutex> lock;
+    if (mAsyncWriter) {
+      lock = std::unique_lock<std::mutex>(mAsyncWriter->getDirectoryMutex());
+    }
+    mDirectory->cd();
+    mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(Form("Tree%d", id))));
+  }
   auto layout = mDataLayouts.back().get();
   layout->setID(id);
+  if (mAsyncWriter) {
+    layout->setDeferredFill([this, layout](std::vector<char>&& row) { mAsyncWriter->enqueue(layout, std::move(row)); });
+  } else if (mFlightRecorderRows) {
+    layout->setDeferredFill([this, layout](std::vector<char>&& row) {
+      auto& ring = mFlightRows[layout];
+      if (ring.size() >= mFlightRecorderRows) {
+        ring.pop_front();
+      }
+      ring.push_back(std::move(row));
+    });
+  }
   if (backup) {
     backup->cd();
   }
@@ -97,10 +280,28 @@ TreeStream& TreeStreamRedirector::operator<<(const char* name)
 
   // create new
   TDirectory* backup = gDirectory;
-  mDirectory->cd();
-  mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(name)));
+  {
+    // see operator<<(Int_t) for the locking rationale
+    std::unique_lock<std::mutex> lock;
+    if (mAsyncWriter) {
+      lock = std::unique_lock<std::mutex>(mAsyncWriter->getDirectoryMutex());
+    }
+    mDirectory->cd();
+    mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(name)));
+  }
   auto layout = mDataLayouts.back().get();
   layout->setID(-1);
+  if (mAsyncWriter) {
+    layout->setDeferredFill([this, layout](std::vector<char>&& row) { mAsyncWriter->enqueue(layout, std::move(row)); });
+  } else if (mFlightRecorderRows) {
+    layout->setDeferredFill([this, layout](std::vector<char>&& row) {
+      auto& ring = mFlightRows[layout];
+      if (ring.size() >= mFlightRecorderRows) {
+        ring.pop_front();
+      }
+      ring.push_back(std::move(row));
+    });
+  }
   if (backup) {
     backup->cd();
   }
@@ -114,11 +315,16 @@ void TreeStreamRedirector::Close()
   if (!mDirectory) {
     return;
   }
+  if (mAsyncWriter) {
+    mAsyncWriter->stop(); // drains the staged rows before the trees are written
+    mAsyncWriter.reset();
+  }
   TDirectory* backup = gDirectory;
   mDirectory->cd();
   for (auto& layout : mDataLayouts) {
     layout->getTree().Write(layout->getName(), TObject::kOverwrite);
   }
+  mFlightRows.clear(); // not dumped rows are discarded
   mDataLayouts.clear();
   if (backup) {
     backup->cd();
@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test BoundedSorter
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "CommonUtils/BoundedSorter.h"
+#include <TRandom.h>
+#include <algorithm>
+#include <vector>
+
+using namespace o2;
+
+BOOST_AUTO_TEST_CASE(BoundedSorter_comparator)
+{
+  utils::BoundedSorter<int> sorter;
+  sorter.setChunkSize(1000); // force multiple chunks and merge passes
+  std::vector<int> data(50000), ref;
+  for (auto& d : data) {
+    d = int(gRandom->Integer(1 << 20)) - (1 << 19);
+  }
+  ref = data;
+  std::sort(ref.begin(), ref.end());
+  sorter.sort(data.begin(), data.end());
+  BOOST_CHECK(data == ref);
+  // the arena must not exceed the size of the largest merged run
+  BOOST_CHECK(sorter.getArenaCapacityBytes() < data.size() * sizeof(int));
+  sorter.clear();
+  BOOST_CHECK_EQUAL(sorter.getArenaCapacityBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BoundedSorter_radix)
+{
+  struct Entry {
+    uint32_t key = 0;
+    uint32_t payload = 0;
+  };
+  utils::BoundedSorter<Entry> sorter;
+  sorter.setChunkSize(4096);
+  std::vector<Entry> data(100000);
+  for (uint32_t i = 0; i < data.size(); i++) {
+    data[i].key = gRandom->Integer(0xffffffff);
+    data[i].payload = i;
+  }
+  auto ref = data;
+  std::stable_sort(ref.begin(), ref.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+  sorter.sortByKey(data.begin(), data.end(), [](const Entry& e) { return e.key; });
+  for (size_t i = 0; i < data.size(); i++) {
+    BOOST_CHECK_EQUAL(data[i].key, ref[i].key);
+    BOOST_CHECK_EQUAL(data[i].payload, ref[i].payload); // stability
+  }
+  // reuse across "TFs": the second sort must not grow the arena
+  auto capacity = sorter.getArenaCapacityBytes();
+  for (auto& d : data) {
+    d.key = gRandom->Integer(0xffff);
+  }
+  sorter.sortByKey(data.begin(), data.end(), [](const Entry& e) { return e.key; });
+  BOOST_CHECK(std::is_sorted(data.begin(), data.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; }));
+  BOOST_CHECK_EQUAL(sorter.getArenaCapacityBytes(), capacity);
+}
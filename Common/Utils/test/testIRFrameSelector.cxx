@@ -0,0 +1,70 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test IRFrameSelector
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "CommonUtils/IRFrameSelector.h"
+#include <TRandom.h>
+#include <algorithm>
+#include <vector>
+
+using namespace o2;
+
+BOOST_AUTO_TEST_CASE(IRFrameSelector_index)
+{
+  // random sparse selection of disjoint frames, sorted in getMin()
+  std::vector<o2::dataformats::IRFrame> frames;
+  int64_t bc = 1000;
+  for (int i = 0; i < 20000; i++) {
+    bc += 100 + gRandom->Integer(10000);
+    int64_t len = 1 + gRandom->Integer(500);
+    frames.emplace_back(InteractionRecord::long2IR(bc), InteractionRecord::long2IR(bc + len));
+    bc += len;
+  }
+  utils::IRFrameSelector plain, indexed;
+  plain.setSelectedIRFrames(frames, 5, 5); // margins force copy to the own list, as for selections shipped via CCDB
+  indexed.setSelectedIRFrames(frames, 5, 5);
+  indexed.buildIndex();
+  BOOST_CHECK(!plain.isIndexBuilt());
+  BOOST_CHECK(indexed.isIndexBuilt());
+
+  // indexed queries must give the same answer as the scan-based ones, in any query order
+  std::vector<o2::dataformats::IRFrame> queries;
+  for (int i = 0; i < 50000; i++) {
+    int64_t qmin = gRandom->Integer(uint32_t(bc + 10000));
+    queries.emplace_back(InteractionRecord::long2IR(qmin), InteractionRecord::long2IR(qmin + gRandom->Integer(1000)));
+  }
+  size_t nMatched = 0;
+  for (const auto& q : queries) {
+    auto refAns = plain.check(q);
+    BOOST_CHECK_EQUAL(indexed.check(q), refAns);
+    if (refAns >= 0) {
+      nMatched++;
+    }
+  }
+  BOOST_CHECK(nMatched > 0); // selection covers a sizeable fraction, some queries must match
+
+  // batch query over sorted inputs
+  std::sort(queries.begin(), queries.end(), [](const auto& a, const auto& b) { return a.getMin() < b.getMin(); });
+  std::vector<long> resIdx, resPlain;
+  BOOST_CHECK_EQUAL(indexed.checkBatch(queries, resIdx), nMatched);
+  plain.checkBatch(queries, resPlain);
+  BOOST_CHECK(resIdx == resPlain);
+
+  // restoring (as after CCDB deserialization) must rebuild a consistent state
+  utils::IRFrameSelector restored = indexed;
+  restored.restore();
+  for (size_t i = 0; i < 100; i++) {
+    BOOST_CHECK_EQUAL(restored.check(queries[i * 500]), resIdx[i * 500]);
+  }
+}
@@ -107,6 +107,93 @@ BOOST_AUTO_TEST_CASE(TreeStream_test)
   //
 }
 
+BOOST_AUTO_TEST_CASE(TreeStreamAsync_test)
+{
+  // The same data written via the async mode must give the same trees as the
+  // synchronous mode: the rows are staged in a buffer and filled/compressed/written
+  // by a background thread
+
+  LOG(info) << "Testing TreeStream async writing";
+  std::string outFName("testTreeStreamAsync.root");
+  int nit = 500;
+  {
+    TreeStreamRedirector tstStream(outFName.data(), "recreate");
+    tstStream.EnableAsyncWriting();
+    std::array<float, o2::track::kNParams> par{};
+    for (int i = 0; i < nit; i++) {
+      par[o2::track::kQ2Pt] = 0.5 + float(i) / nit;
+      float x = 10. + float(i) / nit * 200.;
+      o2::track::TrackPar trc(0., 0., par);
+      trc.propagateParamTo(x, 0.5);
+      // skip the track for some entries to test sparse object branches
+      o2::track::TrackPar* trcP = (i % 7 == 0) ? nullptr : &trc;
+      tstStream << "TrackTree"
+                << "id=" << i << "x=" << x << "track=" << trcP << "\n";
+    }
+    tstStream.Close(); // drains the staged rows and writes the trees
+  }
+  // read back and check
+  {
+    TFile inpf(outFName.data());
+    BOOST_CHECK(!inpf.IsZombie());
+    auto tree = (TTree*)inpf.GetObjectChecked("TrackTree", "TTree");
+    BOOST_CHECK(tree);
+    int nent = tree->GetEntries();
+    BOOST_CHECK(nent == nit);
+    int id;
+    float x;
+    o2::track::TrackPar* trc = nullptr;
+    BOOST_CHECK(!tree->SetBranchAddress("id", &id));
+    BOOST_CHECK(!tree->SetBranchAddress("x", &x));
+    BOOST_CHECK(!tree->SetBranchAddress("track", &trc));
+    for (int i = 0; i < nent; i++) {
+      tree->GetEntry(i);
+      BOOST_CHECK(id == i);
+      if (i % 7 != 0) {
+        BOOST_CHECK(trc && std::abs(x - trc->getX()) < 1e-4);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TreeStreamFlightRecorder_test)
+{
+  // In flight-recorder mode only the last maxRows rows are kept in memory and
+  // written on DumpFlightRecorder()
+
+  LOG(info) << "Testing TreeStream flight recorder";
+  std::string outFName("testTreeStreamFlightRec.root");
+  const int nit = 500;
+  const size_t maxRows = 100;
+  {
+    TreeStreamRedirector tstStream(outFName.data(), "recreate");
+    tstStream.EnableFlightRecorder(maxRows);
+    for (int i = 0; i < nit; i++) {
+      float x = 2.f * i;
+      tstStream << "FlightTree"
+                << "id=" << i << "x=" << x << "\n";
+    }
+    tstStream.DumpFlightRecorder(); // as it would be called on error
+    tstStream.Close();
+  }
+  {
+    TFile inpf(outFName.data());
+    BOOST_CHECK(!inpf.IsZombie());
+    auto tree = (TTree*)inpf.GetObjectChecked("FlightTree", "TTree");
+    BOOST_CHECK(tree);
+    BOOST_CHECK(tree->GetEntries() == (int)maxRows);
+    int id;
+    float x;
+    BOOST_CHECK(!tree->SetBranchAddress("id", &id));
+    BOOST_CHECK(!tree->SetBranchAddress("x", &x));
+    for (int i = 0; i < (int)maxRows; i++) {
+      tree->GetEntry(i);
+      BOOST_CHECK(id == nit - (int)maxRows + i); // only the last rows survive
+      BOOST_CHECK(std::abs(x - 2.f * id) < 1e-6);
+    }
+  }
+}
+
 //_________________________________________________
 bool UnitTestSparse(Double_t scale, Int_t testEntries)
 {
@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file LumiIntegrals.h
+/// \brief Running luminosity integrals per scaler counter with O(1) range queries
+
+#ifndef _ALICEO2_CTP_LUMIINTEGRALS_H_
+#define _ALICEO2_CTP_LUMIINTEGRALS_H_
+#include "DataFormatsCTP/Scalers.h"
+#include <Rtypes.h>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace ctp
+{
+/// Streaming aggregation of the CTP scaler counts for luminosity normalization.
+///
+/// The scaler records are consumed once, in time order, and resampled onto a
+/// uniform time grid: for each tracked counter the object keeps the cumulative
+/// count since the first record at every grid point. An integral over an
+/// arbitrary time range then costs two array lookups with linear interpolation
+/// inside the grid cells (no search over the records), so downstream
+/// normalization queries are O(1) however often they are repeated. Only the
+/// few counters relevant for luminosity are tracked, which keeps the object
+/// small enough to be published to the CCDB next to the full scalers.
+class LumiIntegrals
+{
+ public:
+  LumiIntegrals() = default;
+
+  /// configure the grid and the tracked counters; each counter is identified
+  /// by its scaler index and the type convention of CTPRunScalers::getRate
+  /// (1-6: class lmBefore..l1After, 7: input)
+  void init(uint32_t runNumber, double timeStep, const std::vector<std::pair<int, int>>& counters);
+
+  /// streaming update: consume one O2 scaler record; records must be added in
+  /// increasing time order
+  void addRecord(const CTPScalerRecordO2& record);
+
+  /// aggregate a full scaler object (must be converted to O2 scalers already)
+  void fillFrom(CTPRunScalers& scalers);
+
+  /// counts accumulated by the given counter in [tStart, tStop] (epoch seconds);
+  /// the range is clamped to the aggregated time span
+  double integral(int counter, double tStart, double tStop) const;
+
+  /// mean rate in Hz of the given counter over [tStart, tStop]
+  double meanRate(int counter, double tStart, double tStop) const;
+
+  /// position of the (scaler index, type) counter in the tracked list, -1 if not tracked
+  int getCounterId(int scalerIndex, int type) const;
+
+  uint32_t getRunNumber() const { return mRunNumber; }
+  double getTimeStep() const { return mTimeStep; }
+  double getTimeFirst() const { return mTimeFirst; }
+  /// time of the last complete grid point
+  double getTimeLast() const { return mCumulative.empty() ? mTimeFirst : mTimeFirst + (mCumulative[0].size() - 1) * mTimeStep; }
+  size_t getNCounters() const { return mCounters.size(); }
+  const std::vector<std::pair<int, int>>& getCounters() const { return mCounters; }
+
+  void printStream(std::ostream& stream) const;
+
+ private:
+  /// monotone raw value of a tracked counter in one record
+  double counterValue(const CTPScalerRecordO2& record, int counter) const;
+  /// cumulative count at an arbitrary time, interpolated on the grid
+  double cumulativeAt(int counter, double timestamp) const;
+
+  uint32_t mRunNumber = 0;
+  double mTimeStep = 10.;                          ///< grid pitch in seconds
+  double mTimeFirst = 0.;                          ///< epoch time of grid point 0
+  std::vector<std::pair<int, int>> mCounters;      ///< tracked (scaler index, type) pairs
+  std::vector<std::vector<double>> mCumulative;    ///< per counter: counts since first record at each grid point
+  double mLastTime = 0.;                           ///< time of the last consumed record
+  std::vector<double> mLastCounts;                 ///< raw counter values of the last consumed record
+  std::vector<double> mFirstCounts;                ///< raw counter values of the first consumed record
+  ClassDefNV(LumiIntegrals, 1);
+};
+} // namespace ctp
+} // namespace o2
+
+#endif // _ALICEO2_CTP_LUMIINTEGRALS_H_
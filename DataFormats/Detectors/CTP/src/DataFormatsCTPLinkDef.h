@@ -46,6 +46,7 @@
 #pragma link C++ class o2::ctp::CTPRunScalers + ;
 #pragma link C++ class o2::ctp::LumiInfo + ;
 #pragma link C++ class vector < o2::ctp::LumiInfo> + ;
+#pragma link C++ class o2::ctp::LumiIntegrals + ;
 #pragma link C++ class o2::ctp::CTPRateFetcher + ;
 
 #pragma link C++ struct o2::ctp::CTFHeader + ;
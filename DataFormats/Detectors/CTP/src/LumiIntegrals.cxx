@@ -0,0 +1,179 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file LumiIntegrals.cxx
+/// \brief Implementation of the streaming luminosity integral aggregator
+
+#include "DataFormatsCTP/LumiIntegrals.h"
+#include <fairlogger/Logger.h>
+#include <cmath>
+
+using namespace o2::ctp;
+
+void LumiIntegrals::init(uint32_t runNumber, double timeStep, const std::vector<std::pair<int, int>>& counters)
+{
+  mRunNumber = runNumber;
+  mTimeStep = timeStep > 0. ? timeStep : 10.;
+  mCounters = counters;
+  mCumulative.assign(mCounters.size(), {});
+  mLastCounts.assign(mCounters.size(), 0.);
+  mFirstCounts.assign(mCounters.size(), 0.);
+  mTimeFirst = 0.;
+  mLastTime = 0.;
+}
+
+double LumiIntegrals::counterValue(const CTPScalerRecordO2& record, int counter) const
+{
+  auto [index, type] = mCounters[counter];
+  if (type == 7) {
+    if (index < 0 || index >= (int)record.scalersInps.size()) {
+      LOG(error) << "Input index " << index << " out of range";
+      return 0.;
+    }
+    return record.scalersInps[index];
+  }
+  if (index < 0 || index >= (int)record.scalers.size()) {
+    LOG(error) << "Class scaler index " << index << " out of range";
+    return 0.;
+  }
+  const auto& scaler = record.scalers[index];
+  switch (type) {
+    case 1:
+      return scaler.lmBefore;
+    case 2:
+      return scaler.lmAfter;
+    case 3:
+      return scaler.l0Before;
+    case 4:
+      return scaler.l0After;
+    case 5:
+      return scaler.l1Before;
+    case 6:
+      return scaler.l1After;
+    default:
+      LOG(error) << "Wrong type:" << type;
+      return 0.;
+  }
+}
+
+void LumiIntegrals::addRecord(const CTPScalerRecordO2& record)
+{
+  if (mCumulative.empty()) {
+    LOG(error) << "LumiIntegrals not initialized";
+    return;
+  }
+  if (mCumulative[0].empty()) {
+    // first record defines grid point 0 and the counter baselines
+    mTimeFirst = record.epochTime;
+    mLastTime = record.epochTime;
+    for (size_t ic = 0; ic < mCounters.size(); ic++) {
+      mFirstCounts[ic] = counterValue(record, ic);
+      mLastCounts[ic] = mFirstCounts[ic];
+      mCumulative[ic].push_back(0.);
+    }
+    return;
+  }
+  if (record.epochTime <= mLastTime) {
+    LOG(warn) << "Scaler record not in increasing time order, skipped";
+    return;
+  }
+  // append the grid points covered by the new record, interpolating the
+  // monotone counters linearly between the last and the current record
+  for (size_t ic = 0; ic < mCounters.size(); ic++) {
+    double value = counterValue(record, ic);
+    auto& grid = mCumulative[ic];
+    double slope = (value - mLastCounts[ic]) / (record.epochTime - mLastTime);
+    double tGrid = mTimeFirst + grid.size() * mTimeStep;
+    while (tGrid <= record.epochTime) {
+      grid.push_back(mLastCounts[ic] + slope * (tGrid - mLastTime) - mFirstCounts[ic]);
+      tGrid += mTimeStep;
+    }
+    mLastCounts[ic] = value;
+  }
+  mLastTime = record.epochTime;
+}
+
+void LumiIntegrals::fillFrom(CTPRunScalers& scalers)
+{
+  const auto& records = scalers.getScalerRecordO2();
+  if (records.empty()) {
+    LOG(error) << "No O2 scaler records: convertRawToO2 not called?";
+    return;
+  }
+  for (const auto& record : records) {
+    addRecord(record);
+  }
+}
+
+double LumiIntegrals::cumulativeAt(int counter, double timestamp) const
+{
+  const auto& grid = mCumulative[counter];
+  if (grid.size() < 2) {
+    return 0.;
+  }
+  // clamp to the aggregated span and interpolate within the grid cell
+  double position = (timestamp - mTimeFirst) / mTimeStep;
+  if (position <= 0.) {
+    return grid.front();
+  }
+  if (position >= grid.size() - 1) {
+    return grid.back();
+  }
+  size_t cell = (size_t)position;
+  double frac = position - cell;
+  return grid[cell] + frac * (grid[cell + 1] - grid[cell]);
+}
+
+double LumiIntegrals::integral(int counter, double tStart, double tStop) const
+{
+  if (counter < 0 || counter >= (int)mCumulative.size()) {
+    LOG(error) << "Counter " << counter << " not tracked";
+    return -1.;
+  }
+  if (tStop < tStart) {
+    std::swap(tStart, tStop);
+  }
+  return cumulativeAt(counter, tStop) - cumulativeAt(counter, tStart);
+}
+
+double LumiIntegrals::meanRate(int counter, double tStart, double tStop) const
+{
+  // clamp the range the same way as the integral, otherwise padding with
+  // out-of-span time would dilute the rate
+  double tmin = std::max(tStart, mTimeFirst);
+  double tmax = std::min(tStop, getTimeLast());
+  if (tmax <= tmin) {
+    return -1.;
+  }
+  auto counts = integral(counter, tmin, tmax);
+  return counts >= 0. ? counts / (tmax - tmin) : -1.;
+}
+
+int LumiIntegrals::getCounterId(int scalerIndex, int type) const
+{
+  for (size_t ic = 0; ic < mCounters.size(); ic++) {
+    if (mCounters[ic].first == scalerIndex && mCounters[ic].second == type) {
+      return ic;
+    }
+  }
+  return -1;
+}
+
+void LumiIntegrals::printStream(std::ostream& stream) const
+{
+  stream << "LumiIntegrals run:" << mRunNumber << " time step:" << mTimeStep << " s";
+  stream << " span:[" << (long)mTimeFirst << "," << (long)getTimeLast() << "]" << std::endl;
+  for (size_t ic = 0; ic < mCounters.size(); ic++) {
+    stream << " counter " << ic << " (index:" << mCounters[ic].first << " type:" << mCounters[ic].second << ")";
+    stream << " grid points:" << mCumulative[ic].size();
+    stream << " total counts:" << (mCumulative[ic].empty() ? 0. : mCumulative[ic].back()) << std::endl;
+  }
+}
@@ -0,0 +1,46 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @brief  per-column CTF size statistics
+
+#ifndef ALICEO2_CTF_COLUMN_STATS_H
+#define ALICEO2_CTF_COLUMN_STATS_H
+
+#include "GPUCommonRtypes.h"
+#include <vector>
+#include <string>
+
+namespace o2::ctf
+{
+
+/// Per-column accounting of the CTF of one detector, extracted from the metadata of the
+/// encoded image. Complements the integral o2::ctf::CTFIOSize report: when the compression
+/// of a detector degrades, it tells which column is responsible. The object is ROOT
+/// serializable, so it can be published to QC as is.
+struct CTFColumnStats {
+  int det = -1;                  // DetID of the source detector
+  std::vector<size_t> sizeIn;    // uncompressed column size in bytes
+  std::vector<size_t> sizeOut;   // stored column size in bytes (dictionary + data + literals)
+  std::vector<size_t> nLiterals; // number of samples stored as incompressible literals
+  std::vector<uint8_t> optStore; // applied storage operation (Metadata::OptStore)
+
+  int getNColumns() const { return sizeIn.size(); }
+  void reset(int nColumns);
+  float getRatio(int column) const { return sizeOut[column] ? float(sizeIn[column]) / sizeOut[column] : 0.f; }
+  std::string asString(int column) const;
+  std::string asString() const;
+
+  ClassDefNV(CTFColumnStats, 1);
+};
+
+} // namespace o2::ctf
+
+#endif
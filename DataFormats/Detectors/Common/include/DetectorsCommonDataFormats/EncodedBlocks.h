@@ -20,6 +20,7 @@
 // #include <cassert>
 #include <type_traits>
 #include <cstddef>
+#include <memory>
 #include <Rtypes.h>
 #include <any>
 
@@ -28,6 +29,7 @@
 #include "Framework/Logger.h"
 #include "DetectorsCommonDataFormats/CTFDictHeader.h"
 #include "DetectorsCommonDataFormats/CTFIOSize.h"
+#include "DetectorsCommonDataFormats/CTFColumnStats.h"
 #include "DetectorsCommonDataFormats/ANSHeader.h"
 #include "DetectorsCommonDataFormats/internal/Packer.h"
 #include "DetectorsCommonDataFormats/Metadata.h"
@@ -66,17 +68,35 @@ inline constexpr bool is_iterator_v = is_iterator<T>::value;
 
 inline constexpr bool mayEEncode(Metadata::OptStore opt) noexcept
 {
-  return (opt == Metadata::OptStore::EENCODE) || (opt == Metadata::OptStore::EENCODE_OR_PACK);
+  return (opt == Metadata::OptStore::EENCODE) || (opt == Metadata::OptStore::EENCODE_OR_PACK) || (opt == Metadata::OptStore::EENCODE_PACK_OR_NONE);
 }
 
 inline constexpr bool mayPack(Metadata::OptStore opt) noexcept
 {
-  return (opt == Metadata::OptStore::PACK) || (opt == Metadata::OptStore::EENCODE_OR_PACK);
+  return (opt == Metadata::OptStore::PACK) || (opt == Metadata::OptStore::EENCODE_OR_PACK) || (opt == Metadata::OptStore::EENCODE_PACK_OR_NONE);
 }
 
+inline constexpr bool mayStoreAsIs(Metadata::OptStore opt) noexcept
+{
+  return opt == Metadata::OptStore::EENCODE_PACK_OR_NONE;
+}
+
+// decoder built from a dictionary embedded in a CTF, cached across timeframes together with
+// the checksum of the dictionary it was built from
+template <typename decoder_T>
+struct CachedDictDecoder {
+  uint64_t checksum = 0;
+  decoder_T decoder;
+};
+
 } // namespace detail
 constexpr size_t PackingThreshold = 512;
 
+// bias applied to the estimated compressed/packed size when deciding to store a block as is:
+// spending CPU on entropy coding or packing on the synchronous path is only worth it
+// if it shrinks the block by more than ~1% wrt the raw source size
+constexpr double StoreAsIsBias = 1.01;
+
 constexpr size_t Alignment = 16;
 
 constexpr int WrappersSplitLevel = 99;
@@ -482,6 +502,18 @@ class EncodedBlocks
   /// copy itself to flat buffer created on the fly at the provided pointer. The destination block should be at least of size estimateSize()
   void copyToFlat(void* base) { fillFlatCopy(create(base, estimateSize())); }
 
+  /// collect per-column size statistics from the metadata of the encoded image
+  void fillColumnStats(CTFColumnStats& stats) const
+  {
+    stats.reset(N);
+    for (int i = 0; i < N; i++) {
+      stats.sizeIn[i] = mMetadata[i].getUncompressedSize();
+      stats.sizeOut[i] = (mBlocks[i].getNDict() + mBlocks[i].getNData() + mBlocks[i].getNLiterals()) * sizeof(W);
+      stats.nLiterals[i] = mMetadata[i].nLiterals;
+      stats.optStore[i] = static_cast<uint8_t>(mMetadata[i].opt);
+    }
+  }
+
   /// attach to tree
   size_t appendToTree(TTree& tree, const std::string& name) const;
 
@@ -511,9 +543,38 @@ class EncodedBlocks
   template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool> = true>
   o2::ctf::CTFIOSize decode(D_IT dest, int slot, const std::any& decoderExt = {}) const;
 
+  /// decode block at provided slot, caching the decoder built from the in-CTF dictionary in
+  /// decoderCache: consecutive CTFs carrying the same dictionary (verified via its checksum) reuse
+  /// the decoder tables instead of rebuilding them for every TF. A cache already holding an
+  /// externally provided decoder (from a standalone dictionary) is used as is.
+  template <class container_T, class container_IT = typename container_T::iterator>
+  o2::ctf::CTFIOSize decode(container_T& dest, int slot, std::any& decoderCache) const;
+
+  template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool> = true>
+  o2::ctf::CTFIOSize decode(D_IT dest, int slot, std::any& decoderCache) const;
+
+  /// checksum of the dictionary stored for the slot and of the metadata entering the decoder
+  /// construction, used to detect dictionary changes between consecutively decoded CTFs
+  uint64_t getDictChecksum(int slot) const;
+
 #ifndef __CLING__
   /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
   static std::vector<char> createDictionaryBlocks(const std::vector<rans::DenseHistogram<int32_t>>& vfreq, const std::vector<Metadata>& prbits);
+
+  /// precompute frequency table and metrics of the inplace entropy coder for the given source range.
+  /// The returned object can be passed to encode() in place of an external encoder to skip the
+  /// histogramming pass there, so the sampling of independent columns can proceed concurrently
+  /// while the blocks are still encoded serially into the shared buffer.
+  template <typename input_IT>
+  static std::any prepareInplaceEntropyCoder(const input_IT srcBegin, const input_IT srcEnd)
+  {
+    using input_t = typename std::iterator_traits<input_IT>::value_type;
+    try {
+      return std::make_shared<internal::InplaceEntropyCoder<input_t>>(srcBegin, srcEnd);
+    } catch (const rans::HistogramError& error) {
+      return {}; // histogramming failed, the encoding pass will handle this with its fallback option
+    }
+  }
 #endif
 
   /// print itself
@@ -597,10 +658,11 @@ class EncodedBlocks
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize encodeRANSV1External(const input_IT srcBegin, const input_IT srcEnd, int slot, const std::any& encoderExt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1);
 
+#ifndef __CLING__
   template <typename input_IT, typename buffer_T>
-  o2::ctf::CTFIOSize encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1);
+  o2::ctf::CTFIOSize encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1,
+                                         internal::InplaceEntropyCoder<typename std::iterator_traits<input_IT>::value_type>* preparedCoder = nullptr);
 
-#ifndef __CLING__
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize pack(const input_IT srcBegin, const input_IT srcEnd, int slot, rans::Metrics<typename std::iterator_traits<input_IT>::value_type> metrics, buffer_T* buffer = nullptr);
 
@@ -955,7 +1017,83 @@ CTFIOSize EncodedBlocks<H, N, W>::decode(D_IT dest,                        // it
   }
 };
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <class container_T, class container_IT>
+inline o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::decode(container_T& dest,          // destination container
+                                                         int slot,                   // slot of the block to decode
+                                                         std::any& decoderCache) const // decoder cached across timeframes
+{
+  dest.resize(mMetadata[slot].messageLength); // allocate output buffer
+  return decode(std::begin(dest), slot, decoderCache);
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+uint64_t EncodedBlocks<H, N, W>::getDictChecksum(int slot) const
+{
+  const auto& block = mBlocks[slot];
+  const auto& md = mMetadata[slot];
+  // FNV-1a over the stored dictionary and the metadata fields entering the decoder construction
+  constexpr uint64_t Prime = 0x100000001b3;
+  uint64_t checksum = 0xcbf29ce484222325;
+  auto add = [&checksum](uint64_t value) {
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      checksum = (checksum ^ ((value >> (8 * i)) & 0xff)) * Prime;
+    }
+  };
+  for (int i = 0; i < block.getNDict(); ++i) {
+    add(block.getDict()[i]);
+  }
+  add(static_cast<uint64_t>(static_cast<uint32_t>(md.min)));
+  add(static_cast<uint64_t>(static_cast<uint32_t>(md.max)));
+  add(md.probabilityBits);
+  add(md.streamSize);
+  add(md.coderType);
+  return checksum;
+}
+
 #ifndef __CLING__
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool>>
+CTFIOSize EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to destination
+                                         int slot,                     // slot of the block to decode
+                                         std::any& decoderCache) const // decoder cached across timeframes
+{
+  const auto ansVersion = getANSHeader();
+  const auto& md = mMetadata[slot];
+  using dst_type = typename std::iterator_traits<D_IT>::value_type;
+  // a decoder is cached only for entropy encoded blocks carrying their own dictionary, a cache
+  // holding an externally provided decoder is left untouched
+  if (md.opt == Metadata::OptStore::EENCODE && md.nDictWords > 0 && mBlocks[slot].getNStored()) {
+    if (ansVersion == ANSVersionCompat) {
+      using decoder_type = typename rans::compat::decoder_type<dst_type>;
+      using cache_type = detail::CachedDictDecoder<decoder_type>;
+      auto* cached = std::any_cast<cache_type>(&decoderCache);
+      if (cached || !decoderCache.has_value()) {
+        const uint64_t checksum = getDictChecksum(slot);
+        if (!cached || cached->checksum != checksum) {
+          decoderCache = cache_type{checksum, decoder_type{std::get<rans::RenormedDenseHistogram<dst_type>>(getDictionary<dst_type>(slot))}};
+        }
+      }
+    } else if (ansVersion == ANSVersion1) {
+      using decoder_type = typename rans::defaultDecoder_type<dst_type>;
+      using cache_type = detail::CachedDictDecoder<decoder_type>;
+      auto* cached = std::any_cast<cache_type>(&decoderCache);
+      if (cached || !decoderCache.has_value()) {
+        const uint64_t checksum = getDictChecksum(slot);
+        if (!cached || cached->checksum != checksum) {
+          std::optional<decoder_type> decoder{};
+          std::visit([&](auto&& arg) { decoder = decoder_type{arg}; }, getDictionary<dst_type>(slot));
+          decoderCache = cache_type{checksum, std::move(decoder.value())};
+        }
+      }
+    }
+  }
+  return decode(dest, slot, static_cast<const std::any&>(decoderCache));
+};
+
 template <typename H, int N, typename W>
 template <typename dst_IT>
 CTFIOSize EncodedBlocks<H, N, W>::decodeCompatImpl(dst_IT dstBegin, int slot, const std::any& decoderExt) const
@@ -969,7 +1107,7 @@ CTFIOSize EncodedBlocks<H, N, W>::decodeCompatImpl(dst_IT dstBegin, int slot, co
   using decoder_type = typename rans::compat::decoder_type<dst_type>;
 
   std::optional<decoder_type> inplaceDecoder{};
-  if (md.nDictWords > 0) {
+  if (md.nDictWords > 0 && !decoderExt.has_value()) {
     inplaceDecoder = decoder_type{std::get<rans::RenormedDenseHistogram<dst_type>>(this->getDictionary<dst_type>(slot))};
   } else if (!decoderExt.has_value()) {
     throw std::runtime_error("neither dictionary nor external decoder provided");
@@ -978,6 +1116,8 @@ CTFIOSize EncodedBlocks<H, N, W>::decodeCompatImpl(dst_IT dstBegin, int slot, co
   auto getDecoder = [&]() -> const decoder_type& {
     if (inplaceDecoder.has_value()) {
       return inplaceDecoder.value();
+    } else if (auto* cached = std::any_cast<detail::CachedDictDecoder<decoder_type>>(&decoderExt)) {
+      return cached->decoder;
     } else {
       return std::any_cast<const decoder_type&>(decoderExt);
     }
@@ -1007,7 +1147,7 @@ CTFIOSize EncodedBlocks<H, N, W>::decodeRansV1Impl(dst_IT dstBegin, int slot, co
   using decoder_type = typename rans::defaultDecoder_type<dst_type>;
 
   std::optional<decoder_type> inplaceDecoder{};
-  if (md.nDictWords > 0) {
+  if (md.nDictWords > 0 && !decoderExt.has_value()) {
     std::visit([&](auto&& arg) { inplaceDecoder = decoder_type{arg}; }, this->getDictionary<dst_type>(slot));
   } else if (!decoderExt.has_value()) {
     throw std::runtime_error("no dictionary nor external decoder provided");
@@ -1016,6 +1156,8 @@ CTFIOSize EncodedBlocks<H, N, W>::decodeRansV1Impl(dst_IT dstBegin, int slot, co
   auto getDecoder = [&]() -> const decoder_type& {
     if (inplaceDecoder.has_value()) {
       return inplaceDecoder.value();
+    } else if (auto* cached = std::any_cast<detail::CachedDictDecoder<decoder_type>>(&decoderExt)) {
+      return cached->decoder;
     } else {
       return std::any_cast<const decoder_type&>(decoderExt);
     }
@@ -1277,13 +1419,20 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::entropyCodeRANSV1(const input_IT srcB
 {
   CTFIOSize encoderStatistics{};
 
+  using input_t = typename std::iterator_traits<input_IT>::value_type;
+  using preparedCoder_t = std::shared_ptr<internal::InplaceEntropyCoder<input_t>>;
+
   const size_t nSamples = std::distance(srcBegin, srcEnd);
   if (detail::mayPack(opt) && nSamples < PackingThreshold) {
     encoderStatistics = pack(srcBegin, srcEnd, slot, buffer);
   } else {
 
     if (encoderExt.has_value()) {
-      encoderStatistics = encodeRANSV1External(srcBegin, srcEnd, slot, encoderExt, buffer, memfc);
+      if (auto* prepared = std::any_cast<preparedCoder_t>(&encoderExt)) { // coder prepared upfront via prepareInplaceEntropyCoder
+        encoderStatistics = encodeRANSV1Inplace(srcBegin, srcEnd, slot, opt, buffer, memfc, prepared->get());
+      } else {
+        encoderStatistics = encodeRANSV1External(srcBegin, srcEnd, slot, encoderExt, buffer, memfc);
+      }
     } else {
       encoderStatistics = encodeRANSV1Inplace(srcBegin, srcEnd, slot, opt, buffer, memfc);
     }
@@ -1354,7 +1503,8 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1External(const input_IT srcBegin,
 
 template <typename H, int N, typename W>
 template <typename input_IT, typename buffer_T>
-CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer, double_t sizeEstimateSafetyFactor)
+CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer, double_t sizeEstimateSafetyFactor,
+                                                      internal::InplaceEntropyCoder<typename std::iterator_traits<input_IT>::value_type>* preparedCoder)
 {
   using storageBuffer_t = W;
   using input_t = typename std::iterator_traits<input_IT>::value_type;
@@ -1376,7 +1526,9 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, c
                                     }};
 
   try {
-    if (proxy.isCached()) {
+    if (preparedCoder != nullptr) { // histogramming and metrics were already done concurrently
+      encoder = std::move(*preparedCoder);
+    } else if (proxy.isCached()) {
       encoder = internal::InplaceEntropyCoder<input_t>{proxy.beginCache(), proxy.endCache()};
     } else {
       encoder = internal::InplaceEntropyCoder<input_t>{proxy.beginIter(), proxy.endIter()};
@@ -1397,7 +1549,16 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, c
     LOGP(info, "Metrics:{{slot: {}, numSamples: {}, min: {}, max: {}, alphabetRangeBits: {}, nUsedAlphabetSymbols: {}, preferPacking: {}}}", slot, dp.numSamples, dp.min, dp.max, dp.alphabetRangeBits, dp.nUsedAlphabetSymbols, metrics.getSizeEstimate().preferPacking());
   }
   */
-  if (detail::mayPack(opt) && metrics.getSizeEstimate().preferPacking()) {
+  const rans::SizeEstimate sizeEstimate = metrics.getSizeEstimate();
+  if (detail::mayStoreAsIs(opt) && sizeEstimate.preferPassthrough(StoreAsIsBias)) {
+    // the column is nearly incompressible, pass it through instead of burning CPU on coding it
+    if (proxy.isCached()) {
+      return store(proxy.beginCache(), proxy.endCache(), slot, Metadata::OptStore::NONE, buffer);
+    } else {
+      return store(proxy.beginIter(), proxy.endIter(), slot, Metadata::OptStore::NONE, buffer);
+    }
+  }
+  if (detail::mayPack(opt) && sizeEstimate.preferPacking()) {
     if (proxy.isCached()) {
       return pack(proxy.beginCache(), proxy.endCache(), slot, metrics, buffer);
     } else {
@@ -1407,7 +1568,6 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, c
 
   encoder.makeEncoder();
 
-  const rans::SizeEstimate sizeEstimate = metrics.getSizeEstimate();
   const size_t bufferSizeWords = rans::utils::nBytesTo<storageBuffer_t>((sizeEstimate.getCompressedDictionarySize() +
                                                                          sizeEstimate.getCompressedDatasetSize() +
                                                                          sizeEstimate.getIncompressibleSize()) *
@@ -0,0 +1,68 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @brief  per-column CTF size statistics
+
+#include "DetectorsCommonDataFormats/CTFColumnStats.h"
+#include "DetectorsCommonDataFormats/Metadata.h"
+#include "Framework/Logger.h"
+#include <numeric>
+
+using namespace o2::ctf;
+
+namespace
+{
+const char* optStoreName(uint8_t opt)
+{
+  switch (static_cast<Metadata::OptStore>(opt)) {
+    case Metadata::OptStore::EENCODE:
+      return "EENCODE";
+    case Metadata::OptStore::ROOTCompression:
+      return "ROOTCompression";
+    case Metadata::OptStore::NONE:
+      return "NONE";
+    case Metadata::OptStore::NODATA:
+      return "NODATA";
+    case Metadata::OptStore::PACK:
+      return "PACK";
+    case Metadata::OptStore::EENCODE_OR_PACK:
+      return "EENCODE_OR_PACK";
+    case Metadata::OptStore::EENCODE_PACK_OR_NONE:
+      return "EENCODE_PACK_OR_NONE";
+  }
+  return "UNKNOWN";
+}
+} // namespace
+
+void CTFColumnStats::reset(int nColumns)
+{
+  sizeIn.clear();
+  sizeOut.clear();
+  nLiterals.clear();
+  optStore.clear();
+  sizeIn.resize(nColumns);
+  sizeOut.resize(nColumns);
+  nLiterals.resize(nColumns);
+  optStore.resize(nColumns);
+}
+
+std::string CTFColumnStats::asString(int column) const
+{
+  return fmt::format("column {:2}: in:{} out:{} bytes (ratio {:.2f}) literals:{} opt:{}",
+                     column, sizeIn[column], sizeOut[column], getRatio(column), nLiterals[column], optStoreName(optStore[column]));
+}
+
+std::string CTFColumnStats::asString() const
+{
+  size_t in = std::accumulate(sizeIn.begin(), sizeIn.end(), size_t(0));
+  size_t out = std::accumulate(sizeOut.begin(), sizeOut.end(), size_t(0));
+  return fmt::format("{} columns, in:{} out:{} bytes (ratio {:.2f})", getNColumns(), in, out, out ? float(in) / out : 0.f);
+}
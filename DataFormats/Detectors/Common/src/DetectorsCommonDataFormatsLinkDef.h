@@ -37,5 +37,6 @@
 #pragma link C++ class o2::ctf::Metadata + ;
 #pragma link C++ class o2::ctf::ANSHeader + ;
 #pragma link C++ class o2::ctf::CTFIOSize + ;
+#pragma link C++ class o2::ctf::CTFColumnStats + ;
 
 #endif
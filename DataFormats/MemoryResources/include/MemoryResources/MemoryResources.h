@@ -267,6 +267,190 @@ class OwningMessageSpectatorAllocator
   }
 };
 
+//__________________________________________________________________________________________________
+/// Memory resource carving fixed size slabs from an upstream resource and recycling them between
+/// allocations. Meant for periodic buffers of similar size (e.g. per-detector TF buffers in the
+/// raw proxy chain): the upstream resource (e.g. the shmem segment of the transport) sees a small
+/// number of long lived slab allocations instead of a per-TF alloc/free churn which fragments it.
+/// Requests fitting into a slab are served from the free list, larger requests are passed through
+/// to the upstream resource and accounted as overflows. The counters returned by getStats can be
+/// polled to monitor occupancy and the budget wasted by rounding requests up to the slab size.
+class SlabMemoryResource : public boost::container::pmr::memory_resource
+{
+ public:
+  struct Stats {
+    size_t slabSize = 0;       ///< size of a single slab
+    size_t slabsTotal = 0;     ///< slabs carved from the upstream resource
+    size_t slabsFree = 0;      ///< recycled slabs waiting in the free list
+    size_t bytesRequested = 0; ///< payload bytes of live in-slab allocations
+    size_t bytesOverflown = 0; ///< live bytes served directly by the upstream resource
+    size_t nOverflows = 0;     ///< number of allocations which did not fit into a slab
+    /// fraction of the memory of busy slabs not covered by the payload of live allocations
+    float fragmentation() const
+    {
+      size_t busy = (slabsTotal - slabsFree) * slabSize;
+      return busy ? 1.f - float(bytesRequested) / float(busy) : 0.f;
+    }
+    /// fraction of carved slabs currently holding a live allocation
+    float occupancy() const
+    {
+      return slabsTotal ? float(slabsTotal - slabsFree) / float(slabsTotal) : 0.f;
+    }
+  };
+
+  SlabMemoryResource() noexcept = delete;
+  SlabMemoryResource(const SlabMemoryResource&) = delete;
+  SlabMemoryResource& operator=(const SlabMemoryResource&) = delete;
+
+  /// @param upstream      resource the slabs are carved from, must outlive this resource
+  /// @param slabSize      size of a single slab, i.e. the budget for one allocation
+  /// @param maxFreeSlabs  free list watermark: slabs freed beyond it are returned to the
+  ///                      upstream resource instead of being recycled, 0 means no limit
+  SlabMemoryResource(boost::container::pmr::memory_resource* upstream, size_t slabSize, size_t maxFreeSlabs = 0)
+    : mUpstream{upstream}, mSlabSize{slabSize}, mMaxFreeSlabs{maxFreeSlabs}
+  {
+  }
+
+  ~SlabMemoryResource() noexcept override
+  {
+    for (auto* slab : mFreeSlabs) {
+      mUpstream->deallocate(slab, mSlabSize, SlabAlignment);
+    }
+  }
+
+  const Stats& getStats() const
+  {
+    mStats.slabsFree = mFreeSlabs.size();
+    return mStats;
+  }
+
+ protected:
+  static constexpr size_t SlabAlignment = 64;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    if (bytes <= mSlabSize && alignment <= SlabAlignment) {
+      void* slab = nullptr;
+      if (!mFreeSlabs.empty()) {
+        slab = mFreeSlabs.back();
+        mFreeSlabs.pop_back();
+      } else {
+        slab = mUpstream->allocate(mSlabSize, SlabAlignment);
+        mStats.slabSize = mSlabSize;
+        mStats.slabsTotal++;
+      }
+      mStats.bytesRequested += bytes;
+      return slab;
+    }
+    mStats.nOverflows++;
+    mStats.bytesOverflown += bytes;
+    return mUpstream->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+  {
+    if (bytes <= mSlabSize && alignment <= SlabAlignment) {
+      mStats.bytesRequested -= bytes;
+      if (mMaxFreeSlabs == 0 || mFreeSlabs.size() < mMaxFreeSlabs) {
+        mFreeSlabs.push_back(p);
+      } else {
+        mUpstream->deallocate(p, mSlabSize, SlabAlignment);
+        mStats.slabsTotal--;
+      }
+      return;
+    }
+    mStats.bytesOverflown -= bytes;
+    mUpstream->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+ private:
+  boost::container::pmr::memory_resource* mUpstream = nullptr;
+  size_t mSlabSize = 0;
+  size_t mMaxFreeSlabs = 0;
+  std::vector<void*> mFreeSlabs;
+  mutable Stats mStats;
+};
+
+//__________________________________________________________________________________________________
+/// Memory resource forwarding all requests to an upstream resource while recording per-resource
+/// allocation statistics. Wrapped around the resource backing an output message it makes
+/// reallocation storms visible: every growth step of a vector living in the message shows up as
+/// an allocation followed by the release of the previous buffer, so nReallocs counts releases
+/// happening while other allocations of this resource are still live. Like for the
+/// SlabMemoryResource the counters are meant to be polled (e.g. published as metrics once per TF)
+/// rather than pushed.
+class TrackingMemoryResource : public boost::container::pmr::memory_resource
+{
+ public:
+  struct Stats {
+    size_t nAllocations = 0;   ///< allocations served since the last reset
+    size_t nDeallocations = 0; ///< deallocations served since the last reset
+    size_t nReallocs = 0;      ///< buffers released while other allocations were live, i.e. container growth
+    size_t bytesAllocated = 0; ///< cumulative bytes requested since the last reset
+    size_t bytesLive = 0;      ///< bytes of currently live allocations
+    size_t bytesPeak = 0;      ///< high watermark of bytesLive since the last reset
+  };
+
+  TrackingMemoryResource() noexcept = delete;
+  TrackingMemoryResource(const TrackingMemoryResource&) = delete;
+  TrackingMemoryResource& operator=(const TrackingMemoryResource&) = delete;
+
+  /// @param upstream  resource actually serving the requests, must outlive this resource
+  TrackingMemoryResource(boost::container::pmr::memory_resource* upstream) : mUpstream{upstream}
+  {
+  }
+
+  const Stats& getStats() const { return mStats; }
+
+  /// reset the counters, e.g. after publishing them, keeping the live-bytes accounting
+  void resetStats()
+  {
+    auto live = mStats.bytesLive;
+    mStats = Stats{};
+    mStats.bytesLive = live;
+    mStats.bytesPeak = live;
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    void* p = mUpstream->allocate(bytes, alignment);
+    mStats.nAllocations++;
+    mStats.bytesAllocated += bytes;
+    mStats.bytesLive += bytes;
+    if (mStats.bytesLive > mStats.bytesPeak) {
+      mStats.bytesPeak = mStats.bytesLive;
+    }
+    mNLiveBlocks++;
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+  {
+    mUpstream->deallocate(p, bytes, alignment);
+    mStats.nDeallocations++;
+    mStats.bytesLive -= bytes;
+    if (--mNLiveBlocks > 0) {
+      mStats.nReallocs++;
+    }
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+ private:
+  boost::container::pmr::memory_resource* mUpstream = nullptr;
+  size_t mNLiveBlocks = 0;
+  Stats mStats;
+};
+
 // The NoConstructAllocator behaves like the normal pmr vector but does not call constructors / destructors
 template <typename T>
 class NoConstructAllocator : public boost::container::pmr::polymorphic_allocator<T>
@@ -216,4 +216,75 @@ BOOST_AUTO_TEST_CASE(test_SpectatorMemoryResource)
   BOOST_CHECK(vecmove.size() == size);
 }
 
+BOOST_AUTO_TEST_CASE(test_SlabMemoryResource)
+{
+  constexpr size_t slabSize = 1024;
+  SlabMemoryResource resource(boost::container::pmr::new_delete_resource(), slabSize, 2);
+
+  // allocations within the slab budget are recycled instead of going back upstream
+  auto* a = resource.allocate(100, 8);
+  auto* b = resource.allocate(slabSize, 64);
+  BOOST_CHECK(resource.getStats().slabsTotal == 2);
+  BOOST_CHECK(resource.getStats().bytesRequested == 100 + slabSize);
+  resource.deallocate(a, 100, 8);
+  BOOST_CHECK(resource.getStats().slabsFree == 1);
+  auto* c = resource.allocate(200, 8);
+  BOOST_CHECK(c == a); // recycled
+  BOOST_CHECK(resource.getStats().slabsTotal == 2);
+  BOOST_CHECK(resource.getStats().fragmentation() > 0.f);
+  BOOST_CHECK(resource.getStats().occupancy() == 1.f);
+
+  // oversized allocations are passed through to the upstream resource
+  auto* d = resource.allocate(2 * slabSize, 8);
+  BOOST_CHECK(resource.getStats().nOverflows == 1);
+  BOOST_CHECK(resource.getStats().bytesOverflown == 2 * slabSize);
+  resource.deallocate(d, 2 * slabSize, 8);
+  BOOST_CHECK(resource.getStats().bytesOverflown == 0);
+
+  resource.deallocate(b, slabSize, 64);
+  resource.deallocate(c, 200, 8);
+  BOOST_CHECK(resource.getStats().slabsFree == 2);
+  BOOST_CHECK(resource.getStats().bytesRequested == 0);
+
+  // the free list watermark limits the number of retained slabs
+  auto* e = resource.allocate(100, 8);
+  auto* f = resource.allocate(100, 8);
+  auto* g = resource.allocate(100, 8);
+  BOOST_CHECK(resource.getStats().slabsTotal == 3);
+  resource.deallocate(e, 100, 8);
+  resource.deallocate(f, 100, 8);
+  resource.deallocate(g, 100, 8);
+  BOOST_CHECK(resource.getStats().slabsFree == 2);
+  BOOST_CHECK(resource.getStats().slabsTotal == 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_TrackingMemoryResource)
+{
+  TrackingMemoryResource resource(boost::container::pmr::new_delete_resource());
+  boost::container::pmr::polymorphic_allocator<int> alloc(&resource);
+
+  // a growing vector shows up as reallocations and drives the peak above the live bytes
+  std::vector<int, boost::container::pmr::polymorphic_allocator<int>> vec(alloc);
+  vec.reserve(1);
+  for (int i = 0; i < 1000; i++) {
+    vec.push_back(i);
+  }
+  const auto& stats = resource.getStats();
+  BOOST_CHECK(stats.nReallocs == stats.nDeallocations);
+  BOOST_CHECK(stats.nReallocs > 0);
+  BOOST_CHECK(stats.nAllocations == stats.nDeallocations + 1);
+  BOOST_CHECK(stats.bytesLive == vec.capacity() * sizeof(int));
+  BOOST_CHECK(stats.bytesPeak >= stats.bytesLive);
+
+  // a pre-reserved vector is filled with a single upstream allocation
+  resource.resetStats();
+  std::vector<int, boost::container::pmr::polymorphic_allocator<int>> vecReserved(alloc);
+  vecReserved.reserve(1000);
+  for (int i = 0; i < 1000; i++) {
+    vecReserved.push_back(i);
+  }
+  BOOST_CHECK(stats.nAllocations == 1);
+  BOOST_CHECK(stats.nReallocs == 0);
+}
+
 }; // namespace o2::pmr
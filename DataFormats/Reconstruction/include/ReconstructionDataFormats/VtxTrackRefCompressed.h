@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file  VtxTrackRefCompressed.h
+/// \brief Compressed contiguous table of the vertex -> track references for cache-linear iteration
+/// \author ruben.shahoyan@cern.ch
+
+#ifndef O2_VERTEX_TRACK_REF_COMPRESSED
+#define O2_VERTEX_TRACK_REF_COMPRESSED
+
+#include "CommonDataFormat/RangeReference.h"
+#include "ReconstructionDataFormats/VtxTrackRef.h"
+#include <gsl/span>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace dataformats
+{
+
+/* Transient companion of the std::vector<VtxTrackRef> association output: each VtxTrackRef
+   carries the absolute first entry of every track source, so a vector of them spends more
+   than a hundred scattered bytes per vertex, most of it redundant since the entries are
+   consecutive. This table repacks the same information contiguously: one cumulative start
+   per reference plus delta-encoded 16-bit per-source counts, so consumers walking the
+   associated tracks of many vertices (the association is traversed many times per TF
+   across the chain) stream through a few compact arrays instead. The rare counts not
+   fitting in 16 bit (typically the trailing reference holding the unassigned tracks)
+   are escaped to a side list. */
+
+class VtxTrackRefCompressed
+{
+ public:
+  static constexpr int NSources = VtxTrackIndex::Source::NSources;
+  using Range = RangeReference<int, int>;
+
+  VtxTrackRefCompressed() = default;
+  VtxTrackRefCompressed(const gsl::span<const VtxTrackRef> refs) { build(refs); }
+
+  void build(const gsl::span<const VtxTrackRef> refs);
+  void clear();
+
+  int getNRefs() const { return mStart.empty() ? 0 : int(mStart.size()) - 1; }
+
+  ///< full associated-tracks range of the reference (the trailing one holds the unassigned tracks)
+  Range getRange(int iv) const { return {mStart[iv], mStart[iv + 1] - mStart[iv]}; }
+
+  ///< iteration adapter: contiguous index range of the tracks of given source, obtained by a
+  ///< prefix walk over the 16-bit counts which touches at most a single cache line
+  Range getRangeOfSource(int iv, int s) const
+  {
+    int first = mStart[iv];
+    for (int is = 0; is < s; is++) {
+      first += getEntriesOfSource(iv, is);
+    }
+    return {first, getEntriesOfSource(iv, s)};
+  }
+
+  int getFirstEntryOfSource(int iv, int s) const { return getRangeOfSource(iv, s).getFirstEntry(); }
+  int getEntriesOfSource(int iv, int s) const
+  {
+    auto c = mCounts[size_t(iv) * NSources + s];
+    return c != Overflow ? c : bigCount(size_t(iv) * NSources + s);
+  }
+
+ private:
+  static constexpr uint16_t Overflow = 0xffff; ///< escape marker for counts stored in mBigCounts
+
+  int bigCount(size_t slot) const;
+
+  std::vector<int> mStart;                      ///< cumulative first entries, one per reference + total size
+  std::vector<uint16_t> mCounts;                ///< delta-encoded per-source entry counts, NSources per reference
+  std::vector<std::pair<size_t, int>> mBigCounts; ///< rare counts not fitting in 16 bit, keyed by slot
+};
+
+} // namespace dataformats
+} // namespace o2
+
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "ReconstructionDataFormats/VtxTrackRefCompressed.h"
+
+using namespace o2::dataformats;
+
+void VtxTrackRefCompressed::build(const gsl::span<const VtxTrackRef> refs)
+{
+  clear();
+  int nr = refs.size();
+  mStart.resize(nr + 1);
+  mCounts.resize(size_t(nr) * NSources);
+  for (int iv = 0; iv < nr; iv++) {
+    const auto& ref = refs[iv];
+    mStart[iv] = ref.getFirstEntry();
+    for (int is = 0; is < NSources; is++) {
+      int c = ref.getEntriesOfSource(is);
+      auto slot = size_t(iv) * NSources + is;
+      if (c < Overflow) {
+        mCounts[slot] = uint16_t(c);
+      } else {
+        mCounts[slot] = Overflow;
+        mBigCounts.emplace_back(slot, c);
+      }
+    }
+  }
+  mStart[nr] = nr ? refs[nr - 1].getFirstEntry() + refs[nr - 1].getEntries() : 0;
+}
+
+void VtxTrackRefCompressed::clear()
+{
+  mStart.clear();
+  mCounts.clear();
+  mBigCounts.clear();
+}
+
+int VtxTrackRefCompressed::bigCount(size_t slot) const
+{
+  for (const auto& bc : mBigCounts) {
+    if (bc.first == slot) {
+      return bc.second;
+    }
+  }
+  return 0;
+}
@@ -122,6 +122,18 @@ class DigitizationContext
                     int entryID,
                     std::vector<T>* hits) const;
 
+  /// returns the sorted list of chain entries of the given source which are actually
+  /// sampled by this context; restricted to one timeframe when timeframeID >= 0
+  /// (requires finalizeTimeframeStructure to have been called)
+  std::vector<int> getSampledEntriesForSource(int sourceID, int timeframeID = -1) const;
+
+  /// Restrict the ROOT read-ahead of the hit chains (setup with initSimChains) to the
+  /// entries actually sampled by this context: per source a TTreeCache covering only
+  /// the sampled entry range is attached and trained on the requested branch, so an
+  /// embedding production decompresses only the baskets containing sampled events
+  /// instead of streaming the full hit branch of the background file.
+  void optimizeHitChainReading(std::vector<TChain*> const& chains, const char* brname, int timeframeID = -1, int cacheSizeBytes = 10 * 1024 * 1024) const;
+
   /// returns the GRP object associated to this context
   o2::parameters::GRPObject const& getGRP() const;
 
@@ -138,6 +150,20 @@ class DigitizationContext
   // helper functions to save and load a context
   void saveToFile(std::string_view filename) const;
 
+  /// Save the context in a seekable, per-timeframe layout: the collision
+  /// records, event parts and vertices are written as one tree entry per
+  /// timeframe (plus a payload-free header object), so that a reader can
+  /// fetch an arbitrary timeframe range without materializing the full
+  /// context. Requires finalizeTimeframeStructure to have been called.
+  void saveToTimeframeFile(std::string_view filename) const;
+
+  /// Load a timeframe range [tfFirst, tfLast] (inclusive; negative means
+  /// "from the start" / "to the end") from a file written with
+  /// saveToTimeframeFile. The returned context contains only the collisions
+  /// of the requested slice, with a correspondingly rebuilt timeframe
+  /// structure.
+  static DigitizationContext* loadTimeframeSlice(std::string_view filename, int tfFirst = -1, int tfLast = -1);
+
   // Return the vector of interaction vertices associated with collisions
   // The vector is empty if no vertices were provided or sampled. In this case, one
   // may call "sampleInteractionVertices".
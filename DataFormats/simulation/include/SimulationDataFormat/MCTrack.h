@@ -232,6 +232,12 @@ class MCTrackT
   /// get generator status code
   o2::mcgenstatus::MCGenStatusEncoding getStatusCode() const { return ((o2::mcgenstatus::MCGenStatusEncoding)mStatusCode); }
 
+  /// set generator status code (encoded)
+  void setStatusCode(Int_t enc) { mStatusCode = enc; }
+
+  /// set particle weight
+  void setWeight(_T w) { mWeight = w; }
+
   void setToBeDone(bool f)
   {
     auto prop = ((PropEncoding)mProp);
@@ -0,0 +1,220 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PackedMCTrack.h
+/// \brief Compressed in-memory representation of MCTrack for buffering in the simulation
+
+#ifndef ALICEO2_DATA_PACKEDMCTRACK_H_
+#define ALICEO2_DATA_PACKEDMCTRACK_H_
+
+#include "SimulationDataFormat/MCTrack.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace o2
+{
+
+namespace mctrackpacking
+{
+/// conversion of a float to IEEE-754 half precision (round towards zero;
+/// subnormals flushed to zero); relative precision is 2^-11 ~ 5e-4
+inline uint16_t floatToHalf(float f)
+{
+  uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  uint32_t sign = (u >> 16) & 0x8000u;
+  int32_t exp = (int32_t)((u >> 23) & 0xffu) - 127 + 15;
+  uint32_t mant = u & 0x7fffffu;
+  if (exp <= 0) {
+    return sign; // underflow to (signed) zero
+  }
+  if (exp >= 31) {
+    return sign | 0x7c00u; // overflow to inf (also maps inf/nan)
+  }
+  return sign | ((uint32_t)exp << 10) | (mant >> 13);
+}
+
+inline float halfToFloat(uint16_t h)
+{
+  uint32_t sign = ((uint32_t)h & 0x8000u) << 16;
+  uint32_t exp = (h >> 10) & 0x1fu;
+  uint32_t mant = (uint32_t)h & 0x3ffu;
+  uint32_t u = sign;
+  if (exp == 31) {
+    u |= 0x7f800000u | (mant << 13);
+  } else if (exp != 0) {
+    u |= ((exp - 15 + 127) << 23) | (mant << 13);
+  }
+  float f;
+  std::memcpy(&f, &u, sizeof(f));
+  return f;
+}
+} // namespace mctrackpacking
+
+/// Packed counterpart of MCTrack meant for the in-memory buffering of kept
+/// tracks during simulation (the stack holds all of them until the event is
+/// flushed, which caps the number of workers per node in Pb-Pb productions).
+///
+/// Momenta, start-vertex coordinates and the weight are stored as half
+/// precision (relative precision 2^-11); the integer properties that must stay
+/// exact (pdg code, direct mother, hit/property mask) are kept verbatim. The
+/// rarely-populated links (second mother, daughter range) and the generator
+/// status code live in a side pool shared by all tracks of a container, so the
+/// common case costs a single index. Use PackedMCTrackContainer, which manages
+/// the pool and offers transparent MCTrack-level access.
+class PackedMCTrack
+{
+ public:
+  PackedMCTrack() = default;
+
+ private:
+  friend class PackedMCTrackContainer;
+
+  uint16_t mPx = 0, mPy = 0, mPz = 0;       // momentum components [GeV], half precision
+  uint16_t mVx = 0, mVy = 0, mVz = 0;       // start vertex [cm], half precision
+  uint16_t mT = 0;                          // start time [ns], half precision
+  uint16_t mWeight = 0;                     // particle weight, half precision
+  int32_t mPdgCode = 0;                     // PDG code (exact)
+  int32_t mMotherTrackId = -1;              // direct mother (exact)
+  int32_t mProp = 0;                        // hit/storage/process mask (exact)
+  int32_t mExtIndex = -1;                   // index into the link pool, -1 if nothing beyond the defaults
+};
+
+/// Container of PackedMCTrack with transparent packing/unpacking from/to
+/// MCTrack plus the mutators the stack needs while an event is being
+/// processed (hit flags and mother/daughter link updates).
+class PackedMCTrackContainer
+{
+ public:
+  size_t size() const { return mTracks.size(); }
+  bool empty() const { return mTracks.empty(); }
+  void reserve(size_t n) { mTracks.reserve(n); }
+  void clear()
+  {
+    mTracks.clear();
+    mLinkPool.clear();
+  }
+
+  /// pack a track and append it
+  void push_back(const MCTrack& t)
+  {
+    using namespace mctrackpacking;
+    PackedMCTrack p;
+    p.mPx = floatToHalf(t.Px());
+    p.mPy = floatToHalf(t.Py());
+    p.mPz = floatToHalf(t.Pz());
+    p.mVx = floatToHalf(t.Vx());
+    p.mVy = floatToHalf(t.Vy());
+    p.mVz = floatToHalf(t.Vz());
+    p.mT = floatToHalf(t.T());
+    p.mWeight = floatToHalf(t.getWeight());
+    p.mPdgCode = t.GetPdgCode();
+    p.mMotherTrackId = t.getMotherTrackId();
+    p.mProp = (int32_t)(((uint32_t)t.getHitMask() & HitMaskMax) |
+                        ((uint32_t)t.getProcess() << ProcessShift) |
+                        ((t.getStore() ? 1u : 0u) << StoreShift) |
+                        ((t.getInhibited() ? 1u : 0u) << InhibitedShift) |
+                        ((t.getToBeDone() ? 1u : 0u) << ToBeDoneShift));
+    auto status = t.getStatusCode().fullEncoding;
+    if (t.getSecondMotherTrackId() != -1 || t.getFirstDaughterTrackId() != -1 ||
+        t.getLastDaughterTrackId() != -1 || status != 0) {
+      p.mExtIndex = (int32_t)(mLinkPool.size());
+      mLinkPool.push_back(t.getSecondMotherTrackId());
+      mLinkPool.push_back(t.getFirstDaughterTrackId());
+      mLinkPool.push_back(t.getLastDaughterTrackId());
+      mLinkPool.push_back(status);
+    }
+    mTracks.push_back(p);
+  }
+
+  /// reconstruct the full MCTrack for entry i
+  MCTrack getTrack(size_t i) const
+  {
+    using namespace mctrackpacking;
+    auto& p = mTracks[i];
+    int32_t secondMother = -1, firstDaughter = -1, lastDaughter = -1, status = 0;
+    if (p.mExtIndex >= 0) {
+      secondMother = mLinkPool[p.mExtIndex];
+      firstDaughter = mLinkPool[p.mExtIndex + 1];
+      lastDaughter = mLinkPool[p.mExtIndex + 2];
+      status = mLinkPool[p.mExtIndex + 3];
+    }
+    MCTrack t(p.mPdgCode, p.mMotherTrackId, secondMother, firstDaughter, lastDaughter,
+              halfToFloat(p.mPx), halfToFloat(p.mPy), halfToFloat(p.mPz),
+              halfToFloat(p.mVx), halfToFloat(p.mVy), halfToFloat(p.mVz), halfToFloat(p.mT), 0);
+    uint32_t prop = (uint32_t)p.mProp;
+    t.setHitMask((int32_t)(prop & HitMaskMax));
+    t.setProcess((int32_t)((prop >> ProcessShift) & 0x3fu));
+    t.setStore((prop >> StoreShift) & 1u);
+    t.setInhibited((prop >> InhibitedShift) & 1u);
+    t.setToBeDone((prop >> ToBeDoneShift) & 1u);
+    t.setStatusCode(status);
+    t.setWeight(halfToFloat(p.mWeight));
+    return t;
+  }
+  MCTrack operator[](size_t i) const { return getTrack(i); }
+
+  /// mutators needed during event processing (no full unpack/repack)
+  void setHit(size_t i, int iDetBit)
+  {
+    mTracks[i].mProp |= (int32_t)(1u << iDetBit);
+  }
+  void setMotherTrackId(size_t i, int id) { mTracks[i].mMotherTrackId = id; }
+  void setFirstDaughterTrackId(size_t i, int id) { linksOf(i)[1] = id; }
+  void setLastDaughterTrackId(size_t i, int id) { linksOf(i)[2] = id; }
+
+  /// unpack everything (e.g. for flushing to the output)
+  void unpackTo(std::vector<MCTrack>& out) const
+  {
+    out.clear();
+    out.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+      out.push_back(getTrack(i));
+    }
+  }
+
+  /// current payload size in bytes (tracks + link pool)
+  size_t dataSizeInBytes() const
+  {
+    return mTracks.size() * sizeof(PackedMCTrack) + mLinkPool.size() * sizeof(int32_t);
+  }
+
+ private:
+  // layout of the packed property word: the hit mask in the low bits,
+  // followed by the production process and the status flags
+  static constexpr uint32_t HitMaskMax = (1u << MCTrack::NHITBITS) - 1;
+  static constexpr int ProcessShift = MCTrack::NHITBITS;
+  static constexpr int StoreShift = ProcessShift + 6;
+  static constexpr int InhibitedShift = StoreShift + 1;
+  static constexpr int ToBeDoneShift = InhibitedShift + 1;
+
+  /// get (creating on demand) the link-pool entry of track i
+  int32_t* linksOf(size_t i)
+  {
+    auto& p = mTracks[i];
+    if (p.mExtIndex < 0) {
+      p.mExtIndex = (int32_t)(mLinkPool.size());
+      mLinkPool.push_back(-1);
+      mLinkPool.push_back(-1);
+      mLinkPool.push_back(-1);
+      mLinkPool.push_back(0);
+    }
+    return &mLinkPool[p.mExtIndex];
+  }
+
+  std::vector<PackedMCTrack> mTracks; // packed tracks
+  std::vector<int32_t> mLinkPool;     // pooled (secondMother, firstDaughter, lastDaughter, status) tuples
+};
+
+} // namespace o2
+
+#endif
@@ -15,6 +15,8 @@
 #include "DetectorsCommonDataFormats/DetectorNameConf.h"
 #include <TChain.h>
 #include <TFile.h>
+#include <TTree.h>
+#include <algorithm>
 #include <iostream>
 #include <numeric> // for iota
 #include <MathUtils/Cartesian.h>
@@ -202,6 +204,125 @@ void DigitizationContext::saveToFile(std::string_view filename) const
   file.Close();
 }
 
+void DigitizationContext::saveToTimeframeFile(std::string_view filename) const
+{
+  TFile file(filename.data(), "RECREATE");
+
+  // a payload-free header object keeping the global settings
+  DigitizationContext header;
+  header.mMaxPartNumber = mMaxPartNumber;
+  header.mFirstOrbitForSampling = mFirstOrbitForSampling;
+  header.mMuBC = mMuBC;
+  header.mBCFilling = mBCFilling;
+  header.mSimPrefixes = mSimPrefixes;
+  header.mQEDSimPrefix = mQEDSimPrefix;
+  header.mDigitizerInteractionRate = mDigitizerInteractionRate;
+  auto cl = TClass::GetClass(typeid(header));
+  file.WriteObjectAny(&header, cl, "DigitizationContextHeader");
+
+  // collision data goes to a tree with one entry per timeframe, so that
+  // readers can seek to their timeframe range
+  TTree tree("TimeFrames", "Per-timeframe slices of the DigitizationContext");
+  std::vector<o2::InteractionTimeRecord> records, recordsQED;
+  std::vector<std::vector<o2::steer::EventPart>> parts, partsQED;
+  std::vector<math_utils::Point3D<float>> vertices;
+  auto recordsPtr = &records;
+  auto partsPtr = &parts;
+  auto recordsQEDPtr = &recordsQED;
+  auto partsQEDPtr = &partsQED;
+  auto verticesPtr = &vertices;
+  tree.Branch("EventRecords", &recordsPtr);
+  tree.Branch("EventParts", &partsPtr);
+  tree.Branch("EventRecordsWithQED", &recordsQEDPtr);
+  tree.Branch("EventPartsWithQED", &partsQEDPtr);
+  tree.Branch("InteractionVertices", &verticesPtr);
+
+  // a context without finalized timeframe structure is saved as a single timeframe
+  auto tfindices = mTimeFrameStartIndex;
+  if (tfindices.empty() && mNofEntries > 0) {
+    tfindices.emplace_back(0, mNofEntries - 1);
+  }
+  for (size_t tf = 0; tf < tfindices.size(); ++tf) {
+    records.clear();
+    parts.clear();
+    recordsQED.clear();
+    partsQED.clear();
+    vertices.clear();
+    size_t first = tfindices[tf].first;
+    size_t last = std::min<size_t>(tfindices[tf].second + 1, mEventRecords.size());
+    for (size_t i = first; i < last; ++i) {
+      records.push_back(mEventRecords[i]);
+      parts.push_back(mEventParts[i]);
+      if (i < mInteractionVertices.size()) {
+        vertices.push_back(mInteractionVertices[i]);
+      }
+    }
+    if (tf < mTimeFrameStartIndexQED.size()) {
+      size_t firstQED = mTimeFrameStartIndexQED[tf].first;
+      size_t lastQED = std::min<size_t>(mTimeFrameStartIndexQED[tf].second + 1, mEventRecordsWithQED.size());
+      for (size_t i = firstQED; i < lastQED; ++i) {
+        recordsQED.push_back(mEventRecordsWithQED[i]);
+        partsQED.push_back(mEventPartsWithQED[i]);
+      }
+    }
+    tree.Fill();
+  }
+  tree.Write();
+  file.Close();
+}
+
+DigitizationContext* DigitizationContext::loadTimeframeSlice(std::string_view filename, int tfFirst, int tfLast)
+{
+  TFile file(filename.data(), "OPEN");
+  DigitizationContext* context = nullptr;
+  file.GetObject("DigitizationContextHeader", context);
+  auto tree = (TTree*)file.Get("TimeFrames");
+  if (!context || !tree) {
+    LOG(error) << "File " << filename << " does not contain a per-timeframe context";
+    return nullptr;
+  }
+  std::vector<o2::InteractionTimeRecord> records, recordsQED;
+  std::vector<std::vector<o2::steer::EventPart>> parts, partsQED;
+  std::vector<math_utils::Point3D<float>> vertices;
+  auto recordsPtr = &records;
+  auto partsPtr = &parts;
+  auto recordsQEDPtr = &recordsQED;
+  auto partsQEDPtr = &partsQED;
+  auto verticesPtr = &vertices;
+  tree->SetBranchAddress("EventRecords", &recordsPtr);
+  tree->SetBranchAddress("EventParts", &partsPtr);
+  tree->SetBranchAddress("EventRecordsWithQED", &recordsQEDPtr);
+  tree->SetBranchAddress("EventPartsWithQED", &partsQEDPtr);
+  tree->SetBranchAddress("InteractionVertices", &verticesPtr);
+
+  const int ntf = tree->GetEntries();
+  if (tfFirst < 0) {
+    tfFirst = 0;
+  }
+  if (tfLast < 0 || tfLast >= ntf) {
+    tfLast = ntf - 1;
+  }
+  for (int tf = tfFirst; tf <= tfLast; ++tf) {
+    tree->GetEntry(tf);
+    int start = (int)(context->mEventRecords.size());
+    std::copy(records.begin(), records.end(), std::back_inserter(context->mEventRecords));
+    std::copy(parts.begin(), parts.end(), std::back_inserter(context->mEventParts));
+    std::copy(vertices.begin(), vertices.end(), std::back_inserter(context->mInteractionVertices));
+    context->mTimeFrameStartIndex.emplace_back(start, (int)(context->mEventRecords.size()) - 1);
+    if (!recordsQED.empty()) {
+      int startQED = (int)(context->mEventRecordsWithQED.size());
+      std::copy(recordsQED.begin(), recordsQED.end(), std::back_inserter(context->mEventRecordsWithQED));
+      std::copy(partsQED.begin(), partsQED.end(), std::back_inserter(context->mEventPartsWithQED));
+      context->mTimeFrameStartIndexQED.emplace_back(startQED, (int)(context->mEventRecordsWithQED.size()) - 1);
+    }
+  }
+  context->mNofEntries = context->mEventRecords.size();
+  for (auto& p : context->mEventParts) {
+    context->mMaxPartNumber = std::max<int>(context->mMaxPartNumber, p.size());
+  }
+  return context;
+}
+
 DigitizationContext* DigitizationContext::loadFromFile(std::string_view filename)
 {
   std::string tmpFile;
@@ -416,6 +537,54 @@ std::unordered_map<int, int> DigitizationContext::getCollisionIndicesForSource(i
   return result;
 }
 
+std::vector<int> DigitizationContext::getSampledEntriesForSource(int sourceID, int timeframeID) const
+{
+  std::vector<int> entries;
+  const bool qed = (sourceID == QEDSOURCEID);
+  auto const& parts = getEventParts(qed);
+  auto const& tfindices = qed ? mTimeFrameStartIndexQED : mTimeFrameStartIndex;
+  size_t first = 0;
+  size_t last = parts.size();
+  if (timeframeID >= 0) {
+    if (timeframeID >= (int)tfindices.size()) {
+      LOG(error) << "Timeframe " << timeframeID << " unknown; was finalizeTimeframeStructure called?";
+      return entries;
+    }
+    first = tfindices[timeframeID].first;
+    last = std::min<size_t>(tfindices[timeframeID].second + 1, parts.size());
+  }
+  for (auto index = first; index < last; ++index) {
+    for (auto& part : parts[index]) {
+      if (part.sourceID == sourceID) {
+        entries.push_back(part.entryID);
+      }
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  return entries;
+}
+
+void DigitizationContext::optimizeHitChainReading(std::vector<TChain*> const& chains, const char* brname, int timeframeID, int cacheSizeBytes) const
+{
+  for (int source = 0; source < (int)chains.size(); ++source) {
+    auto chain = chains[source];
+    if (!chain) {
+      continue;
+    }
+    auto entries = getSampledEntriesForSource(source, timeframeID);
+    if (entries.empty()) {
+      continue;
+    }
+    // a cache trained on the hit branch and clipped to the sampled entry range:
+    // baskets outside of it are neither fetched nor decompressed
+    chain->SetCacheSize(cacheSizeBytes);
+    chain->AddBranchToCache(brname, true);
+    chain->SetCacheEntryRange(entries.front(), entries.back() + 1);
+    chain->StopCacheLearningPhase();
+  }
+}
+
 int DigitizationContext::findSimPrefix(std::string const& prefix) const
 {
   auto iter = std::find(mSimPrefixes.begin(), mSimPrefixes.end(), prefix);
@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DigitizationContext class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "SimulationDataFormat/DigitizationContext.h"
+#include <cstdio>
+
+using namespace o2::steer;
+
+BOOST_AUTO_TEST_CASE(SampledEntries_test)
+{
+  DigitizationContext context;
+  // 4 collisions in 2 timeframes (2 orbits per timeframe), mixing entries of 2 sources
+  auto& records = context.getEventRecords();
+  auto& parts = context.getEventParts();
+  records.emplace_back(o2::InteractionRecord(0, 0), 0.);
+  parts.push_back({EventPart(0, 5), EventPart(1, 0)});
+  records.emplace_back(o2::InteractionRecord(0, 1), 0.);
+  parts.push_back({EventPart(0, 2)});
+  records.emplace_back(o2::InteractionRecord(0, 2), 0.);
+  parts.push_back({EventPart(0, 2), EventPart(1, 1)});
+  records.emplace_back(o2::InteractionRecord(0, 3), 0.);
+  parts.push_back({EventPart(0, 7)});
+  context.setNCollisions(records.size());
+  context.finalizeTimeframeStructure(0, 2);
+
+  // all timeframes: sorted, duplicates removed
+  auto entries = context.getSampledEntriesForSource(0);
+  BOOST_REQUIRE_EQUAL(entries.size(), 3);
+  BOOST_CHECK(entries[0] == 2 && entries[1] == 5 && entries[2] == 7);
+  entries = context.getSampledEntriesForSource(1);
+  BOOST_REQUIRE_EQUAL(entries.size(), 2);
+
+  // restricted to single timeframes
+  entries = context.getSampledEntriesForSource(0, 0);
+  BOOST_REQUIRE_EQUAL(entries.size(), 2);
+  BOOST_CHECK(entries[0] == 2 && entries[1] == 5);
+  entries = context.getSampledEntriesForSource(0, 1);
+  BOOST_REQUIRE_EQUAL(entries.size(), 2);
+  BOOST_CHECK(entries[0] == 2 && entries[1] == 7);
+  entries = context.getSampledEntriesForSource(1, 1);
+  BOOST_REQUIRE_EQUAL(entries.size(), 1);
+  BOOST_CHECK_EQUAL(entries[0], 1);
+
+  // unknown timeframe yields nothing
+  BOOST_CHECK(context.getSampledEntriesForSource(0, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(TimeframeSlice_test)
+{
+  DigitizationContext context;
+  // same setup as above: 4 collisions in 2 timeframes, mixing entries of 2 sources
+  auto& records = context.getEventRecords();
+  auto& parts = context.getEventParts();
+  records.emplace_back(o2::InteractionRecord(0, 0), 0.);
+  parts.push_back({EventPart(0, 5), EventPart(1, 0)});
+  records.emplace_back(o2::InteractionRecord(0, 1), 0.);
+  parts.push_back({EventPart(0, 2)});
+  records.emplace_back(o2::InteractionRecord(0, 2), 0.);
+  parts.push_back({EventPart(0, 2), EventPart(1, 1)});
+  records.emplace_back(o2::InteractionRecord(0, 3), 0.);
+  parts.push_back({EventPart(0, 7)});
+  context.setNCollisions(records.size());
+  context.setMuPerBC(0.01);
+  context.finalizeTimeframeStructure(0, 2);
+
+  std::string filename("collisioncontext_tf_test.root");
+  context.saveToTimeframeFile(filename);
+
+  // loading everything reproduces the full context
+  auto full = DigitizationContext::loadTimeframeSlice(filename);
+  BOOST_REQUIRE(full != nullptr);
+  BOOST_REQUIRE_EQUAL(full->getNCollisions(), 4);
+  BOOST_CHECK_EQUAL(full->getEventParts()[0].size(), 2);
+  BOOST_CHECK_EQUAL(full->getEventParts()[3][0].entryID, 7);
+  BOOST_CHECK_CLOSE(full->getMuPerBC(), 0.01, 1E-4);
+  BOOST_CHECK_EQUAL(full->getMaxNumberParts(), 2);
+  delete full;
+
+  // a slice restricted to the second timeframe contains only its collisions,
+  // with a locally rebuilt timeframe structure
+  auto slice = DigitizationContext::loadTimeframeSlice(filename, 1, 1);
+  BOOST_REQUIRE(slice != nullptr);
+  BOOST_REQUIRE_EQUAL(slice->getNCollisions(), 2);
+  BOOST_CHECK_EQUAL(slice->getEventParts()[0].size(), 2);
+  BOOST_CHECK_EQUAL(slice->getEventParts()[0][1].sourceID, 1);
+  BOOST_CHECK_EQUAL(slice->getEventParts()[1][0].entryID, 7);
+  auto entries = slice->getSampledEntriesForSource(0, 0);
+  BOOST_REQUIRE_EQUAL(entries.size(), 2);
+  BOOST_CHECK(entries[0] == 2 && entries[1] == 7);
+  delete slice;
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PackedMCTrack class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "SimulationDataFormat/PackedMCTrack.h"
+
+using namespace o2;
+
+BOOST_AUTO_TEST_CASE(PackedMCTrack_roundtrip)
+{
+  BOOST_CHECK(sizeof(PackedMCTrack) < sizeof(MCTrack));
+
+  MCTrack t(211, 5, -1, -1, -1, 1.25, -0.5, 3.75, 0.1, -0.2, 10.5, 2.5, 0);
+  t.setProcess(4);
+  t.setStore(true);
+  t.setToBeDone(true);
+  t.setHit(3);
+  t.setWeight(1.5);
+
+  PackedMCTrackContainer cont;
+  cont.push_back(t);
+  BOOST_REQUIRE_EQUAL(cont.size(), 1);
+  // a track without daughters/second mother/status costs no pool entry
+  BOOST_CHECK_EQUAL(cont.dataSizeInBytes(), sizeof(PackedMCTrack));
+
+  auto r = cont.getTrack(0);
+  BOOST_CHECK_EQUAL(r.GetPdgCode(), 211);
+  BOOST_CHECK_EQUAL(r.getMotherTrackId(), 5);
+  BOOST_CHECK_EQUAL(r.getSecondMotherTrackId(), -1);
+  BOOST_CHECK_EQUAL(r.getFirstDaughterTrackId(), -1);
+  BOOST_CHECK_EQUAL(r.getProcess(), 4);
+  BOOST_CHECK(r.getStore());
+  BOOST_CHECK(r.getToBeDone());
+  BOOST_CHECK(!r.getInhibited());
+  BOOST_CHECK_EQUAL(r.getHitMask(), t.getHitMask());
+  BOOST_CHECK_CLOSE(r.Px(), 1.25, 0.1);
+  BOOST_CHECK_CLOSE(r.Py(), -0.5, 0.1);
+  BOOST_CHECK_CLOSE(r.Pz(), 3.75, 0.1);
+  BOOST_CHECK_CLOSE(r.Vz(), 10.5, 0.1);
+  BOOST_CHECK_CLOSE(r.getWeight(), 1.5, 0.1);
+
+  // a track with links gets a pool entry
+  MCTrack t2(-211, 0, 1, 7, 9, 0.1, 0.2, 0.3, 0., 0., 0., 0., 0);
+  cont.push_back(t2);
+  auto r2 = cont.getTrack(1);
+  BOOST_CHECK_EQUAL(r2.getSecondMotherTrackId(), 1);
+  BOOST_CHECK_EQUAL(r2.getFirstDaughterTrackId(), 7);
+  BOOST_CHECK_EQUAL(r2.getLastDaughterTrackId(), 9);
+
+  // in-place mutators
+  cont.setHit(0, 5);
+  BOOST_CHECK(cont.getTrack(0).leftTraceGivenBitField(5));
+  BOOST_CHECK(cont.getTrack(0).leftTraceGivenBitField(3));
+  cont.setFirstDaughterTrackId(0, 1);
+  cont.setLastDaughterTrackId(0, 1);
+  BOOST_CHECK_EQUAL(cont.getTrack(0).getFirstDaughterTrackId(), 1);
+  BOOST_CHECK_EQUAL(cont.getTrack(0).getLastDaughterTrackId(), 1);
+
+  std::vector<MCTrack> unpacked;
+  cont.unpackTo(unpacked);
+  BOOST_REQUIRE_EQUAL(unpacked.size(), 2);
+  BOOST_CHECK_EQUAL(unpacked[1].GetPdgCode(), -211);
+
+  cont.clear();
+  BOOST_CHECK(cont.empty());
+  BOOST_CHECK_EQUAL(cont.dataSizeInBytes(), 0);
+}
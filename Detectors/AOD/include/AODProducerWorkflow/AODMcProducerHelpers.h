@@ -20,6 +20,7 @@
 #include <Framework/AnalysisDataModel.h>
 #include <Framework/FunctionalHelpers.h>
 #include <Framework/TableBuilder.h>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -224,9 +225,46 @@ bool updateHepMCHeavyIon(const HeavyIonCursor& cursor,
                          HepMCUpdate when = HepMCUpdate::anyKey);
 //--------------------------------------------------------------------
 /**
- * Type of mapping from track number to row index
+ * Mapping from track number to row index.
+ *
+ * Track numbers are dense within an event, so the mapping is a flat
+ * array indexed by the track number rather than a hash map: marking a
+ * track and remapping a label become direct loads and stores instead
+ * of per-entry hashed lookups.  Tracks never set map to NotSet.
  */
-using TrackToIndex = std::unordered_map<int, int>;
+class TrackToIndex
+{
+ public:
+  static constexpr int NotSet = -1;
+
+  /// row index the track maps to, NotSet if the track was never set
+  int get(int track) const
+  {
+    return (track >= 0 && track < int(mStore.size())) ? mStore[track] : NotSet;
+  }
+
+  bool contains(int track) const { return get(track) != NotSet; }
+
+  /// write access, growing the store to cover the track number
+  int& operator[](int track)
+  {
+    if (track >= int(mStore.size())) {
+      mStore.resize(std::max(size_t(track) + 1, 2 * mStore.size()), NotSet);
+    }
+    return mStore[track];
+  }
+
+  /// number of tracks set
+  size_t size() const
+  {
+    return std::count_if(mStore.begin(), mStore.end(), [](int v) { return v != NotSet; });
+  }
+
+  void clear() { mStore.clear(); }
+
+ private:
+  std::vector<int> mStore;
+};
 //--------------------------------------------------------------------
 /**
  * Update aod::McParticles table with information from an MC track.
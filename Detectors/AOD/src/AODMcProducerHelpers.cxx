@@ -217,11 +217,7 @@ void updateParticle(const ParticleCursor& cursor,
   using namespace o2::mcgenstatus;
 
   auto mapping = [&toStore](int trackNo) {
-    auto iter = toStore.find(trackNo);
-    if (iter == toStore.end()) {
-      return -1;
-    }
-    return iter->second;
+    return toStore.get(trackNo);
   };
 
   auto statusCode = track.getStatusCode().fullEncoding;
@@ -321,11 +317,7 @@ uint32_t updateParticles(const ParticleCursor& cursor,
   // Mapping lambda.  This maps the track number to the index into
   // the table exported.
   auto mapping = [&toStore](int trackNo) {
-    auto iter = toStore.find(trackNo);
-    if (iter == toStore.end()) {
-      return -1;
-    }
-    return iter->second;
+    return toStore.get(trackNo);
   };
 
   LOG(verbosity) << "Got a total of " << tracks.size();
@@ -333,7 +325,7 @@ uint32_t updateParticles(const ParticleCursor& cursor,
     auto& track = tracks[trackNo];
     auto hepmc = getHepMCStatusCode(track.getStatusCode());
     if (filter) {
-      if (toStore.find(trackNo) == toStore.end() and
+      if (not toStore.contains(trackNo) and
           /* The above test is in-correct.  The track may be stored in
              the list, but with a negative value.  In that case, the
              above test will still check mothers and daughters, and
@@ -95,6 +95,8 @@
 #include "TLorentzVector.h"
 #include "TVector3.h"
 #include "MathUtils/Tsallis.h"
+#include <array>
+#include <functional>
 #include <random>
 #ifdef WITH_OPENMP
 #include <omp.h>
@@ -875,7 +877,7 @@ void AODProducerWorkflowDPL::updateMCHeader(MCCollisionCursor& collisionCursor,
                        : HepMCUpdate::never);
 }
 
-void dimensionMCKeepStore(std::vector<std::vector<std::unordered_map<int, int>>>& store, int Nsources, int NEvents)
+void dimensionMCKeepStore(std::vector<std::vector<o2::aodmchelpers::TrackToIndex>>& store, int Nsources, int NEvents)
 {
   store.resize(Nsources);
   for (int s = 0; s < Nsources; ++s) {
@@ -883,7 +885,7 @@ void dimensionMCKeepStore(std::vector<std::vector<std::unordered_map<int, int>>>
   }
 }
 
-void clearMCKeepStore(std::vector<std::vector<std::unordered_map<int, int>>>& store)
+void clearMCKeepStore(std::vector<std::vector<o2::aodmchelpers::TrackToIndex>>& store)
 {
   for (auto s = 0U; s < store.size(); ++s) {
     for (auto e = 0U; e < store[s].size(); ++e) {
@@ -893,7 +895,7 @@ void clearMCKeepStore(std::vector<std::vector<std::unordered_map<int, int>>>& st
 }
 
 // helper function to add a particle/track to the MC keep store
-void keepMCParticle(std::vector<std::vector<std::unordered_map<int, int>>>& store, int source, int event, int track, int value = 1)
+void keepMCParticle(std::vector<std::vector<o2::aodmchelpers::TrackToIndex>>& store, int source, int event, int track, int value = 1)
 {
   if (track < 0) {
     LOG(warn) << "trackID is smaller than 0. Neglecting";
@@ -1053,7 +1055,7 @@ void AODProducerWorkflowDPL::fillMCTrackLabelsTable(MCTrackLabelCursorType& mcTr
             continue;
           }
           if (mcTruth.isValid()) { // if not set, -1 will be stored
-            labelHolder.labelID = (mToStore[mcTruth.getSourceID()][mcTruth.getEventID()])[mcTruth.getTrackID()];
+            labelHolder.labelID = mToStore[mcTruth.getSourceID()][mcTruth.getEventID()].get(mcTruth.getTrackID());
           }
           if (mcTruth.isFake()) {
             labelHolder.fwdLabelMask |= (0x1 << 7);
@@ -1073,7 +1075,7 @@ void AODProducerWorkflowDPL::fillMCTrackLabelsTable(MCTrackLabelCursorType& mcTr
             continue;
           }
           if (mcTruth.isValid()) { // if not set, -1 will be stored
-            labelHolder.labelID = (mToStore[mcTruth.getSourceID()][mcTruth.getEventID()])[mcTruth.getTrackID()];
+            labelHolder.labelID = mToStore[mcTruth.getSourceID()][mcTruth.getEventID()].get(mcTruth.getTrackID());
           }
           // treating possible mismatches and fakes for global tracks
           auto contributorsGID = data.getSingleDetectorRefs(trackIndex);
@@ -1084,13 +1086,13 @@ void AODProducerWorkflowDPL::fillMCTrackLabelsTable(MCTrackLabelCursorType& mcTr
           if (isSetTPC && (isSetITS || isSetTOF)) {
             auto mcTruthTPC = data.getTrackMCLabel(contributorsGID[GIndex::Source::TPC]);
             if (mcTruthTPC.isValid()) {
-              labelHolder.labelTPC = (mToStore[mcTruthTPC.getSourceID()][mcTruthTPC.getEventID()])[mcTruthTPC.getTrackID()];
+              labelHolder.labelTPC = mToStore[mcTruthTPC.getSourceID()][mcTruthTPC.getEventID()].get(mcTruthTPC.getTrackID());
               labelHolder.labelID = labelHolder.labelTPC;
             }
             if (isSetITS) {
               auto mcTruthITS = data.getTrackMCLabel(contributorsGID[GIndex::Source::ITS]);
               if (mcTruthITS.isValid()) {
-                labelHolder.labelITS = (mToStore[mcTruthITS.getSourceID()][mcTruthITS.getEventID()])[mcTruthITS.getTrackID()];
+                labelHolder.labelITS = mToStore[mcTruthITS.getSourceID()][mcTruthITS.getEventID()].get(mcTruthITS.getTrackID());
               }
               if (labelHolder.labelITS != labelHolder.labelTPC) {
                 LOG(debug) << "ITS-TPC MCTruth: labelIDs do not match at " << trackIndex.getIndex() << ", src = " << src;
@@ -1132,7 +1134,7 @@ void AODProducerWorkflowDPL::fillMCTrackLabelsTable(MCTrackLabelCursorType& mcTr
       auto& collStrTrk = mCollisionStrTrk[iS];
       auto& label = sTrackLabels[collStrTrk.second];
       MCLabels labelHolder;
-      labelHolder.labelID = label.isValid() ? (mToStore[label.getSourceID()][label.getEventID()])[label.getTrackID()] : -1;
+      labelHolder.labelID = label.isValid() ? mToStore[label.getSourceID()][label.getEventID()].get(label.getTrackID()) : -1;
       labelHolder.labelMask = (label.isFake() << 15) | (label.isNoise() << 14);
       mcTrackLabelCursor(labelHolder.labelID, labelHolder.labelMask);
     }
@@ -1523,18 +1525,17 @@ void AODProducerWorkflowDPL::addToCaloTable(TCaloHandler& caloHandler, TCaloCurs
           if (mEMCselectLeading) {
             if (mclabel.getAmplitudeFraction() > tmpMaxAmplitude) {
               // Check if this MCparticle added to be kept?
-              if (mToStore.at(mclabel.getSourceID()).at(mclabel.getEventID()).find(mclabel.getTrackID()) !=
-                  mToStore.at(mclabel.getSourceID()).at(mclabel.getEventID()).end()) {
+              if (mToStore.at(mclabel.getSourceID()).at(mclabel.getEventID()).contains(mclabel.getTrackID())) {
                 tmpMaxAmplitude = mclabel.getAmplitudeFraction();
-                tmpindex = (mToStore.at(mclabel.getSourceID()).at(mclabel.getEventID())).at(mclabel.getTrackID());
+                tmpindex = mToStore.at(mclabel.getSourceID()).at(mclabel.getEventID()).get(mclabel.getTrackID());
               }
             }
           } else {
-            auto trackStore = mToStore.at(mclabel.getSourceID()).at(mclabel.getEventID());
-            auto iter = trackStore.find(mclabel.getTrackID());
-            if (iter != trackStore.end()) {
+            const auto& trackStore = mToStore.at(mclabel.getSourceID()).at(mclabel.getEventID());
+            auto index = trackStore.get(mclabel.getTrackID());
+            if (index != aodmchelpers::TrackToIndex::NotSet) {
               amplitudeFraction.emplace_back(mclabel.getAmplitudeFraction());
-              particleIds.emplace_back(iter->second);
+              particleIds.emplace_back(index);
             } else {
               particleIds.emplace_back(-1); // should the mc particle not be in mToStore make sure something (e.g. -1) is saved in particleIds so the length of particleIds is the same es amplitudeFraction!
               amplitudeFraction.emplace_back(0.f);
@@ -1873,71 +1874,78 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     tfNumber = mTFNumber;
   }
 
-  std::vector<float> aAmplitudes;
-  std::vector<uint8_t> aChannels;
-  fv0aCursor.reserve(fv0RecPoints.size());
-  for (auto& fv0RecPoint : fv0RecPoints) {
-    aAmplitudes.clear();
-    aChannels.clear();
-    const auto channelData = fv0RecPoint.getBunchChannelData(fv0ChData);
-    for (auto& channel : channelData) {
-      if (channel.charge > 0) {
-        aAmplitudes.push_back(truncateFloatFraction(channel.charge, mV0Amplitude));
-        aChannels.push_back(channel.channel);
+  // The BC-keyed forward-detector tables are independent of each other and of the remaining
+  // tables: each stage reads only its own reco spans and the shared read-only bcsMap and writes
+  // through its own table builder, so the stages can be built concurrently
+  auto fillFV0A = [&]() {
+    std::vector<float> aAmplitudes;
+    std::vector<uint8_t> aChannels;
+    fv0aCursor.reserve(fv0RecPoints.size());
+    for (auto& fv0RecPoint : fv0RecPoints) {
+      aAmplitudes.clear();
+      aChannels.clear();
+      const auto channelData = fv0RecPoint.getBunchChannelData(fv0ChData);
+      for (auto& channel : channelData) {
+        if (channel.charge > 0) {
+          aAmplitudes.push_back(truncateFloatFraction(channel.charge, mV0Amplitude));
+          aChannels.push_back(channel.channel);
+        }
       }
+      uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
+      auto item = bcsMap.find(bc);
+      int bcID = -1;
+      if (item != bcsMap.end()) {
+        bcID = item->second;
+      } else {
+        LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
+      }
+      fv0aCursor(bcID,
+                 aAmplitudes,
+                 aChannels,
+                 truncateFloatFraction(fv0RecPoint.getCollisionGlobalMeanTime() * 1E-3, mV0Time), // ps to ns
+                 fv0RecPoint.getTrigger().getTriggersignals());
     }
-    uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
-    }
-    fv0aCursor(bcID,
-               aAmplitudes,
-               aChannels,
-               truncateFloatFraction(fv0RecPoint.getCollisionGlobalMeanTime() * 1E-3, mV0Time), // ps to ns
-               fv0RecPoint.getTrigger().getTriggersignals());
-  }
+  };
 
-  std::vector<float> zdcEnergy, zdcAmplitudes, zdcTime;
-  std::vector<uint8_t> zdcChannelsE, zdcChannelsT;
-  zdcCursor.reserve(zdcBCRecData.size());
-  for (auto zdcRecData : zdcBCRecData) {
-    uint64_t bc = zdcRecData.ir.toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
-    }
-    int fe, ne, ft, nt, fi, ni;
-    zdcRecData.getRef(fe, ne, ft, nt, fi, ni);
-    zdcEnergy.clear();
-    zdcChannelsE.clear();
-    zdcAmplitudes.clear();
-    zdcTime.clear();
-    zdcChannelsT.clear();
-    for (int ie = 0; ie < ne; ie++) {
-      auto& zdcEnergyData = zdcEnergies[fe + ie];
-      zdcEnergy.emplace_back(zdcEnergyData.energy());
-      zdcChannelsE.emplace_back(zdcEnergyData.ch());
-    }
-    for (int it = 0; it < nt; it++) {
-      auto& tdc = zdcTDCData[ft + it];
-      zdcAmplitudes.emplace_back(tdc.amplitude());
-      zdcTime.emplace_back(tdc.value());
-      zdcChannelsT.emplace_back(o2::zdc::TDCSignal[tdc.ch()]);
-    }
-    zdcCursor(bcID,
-              zdcEnergy,
-              zdcChannelsE,
-              zdcAmplitudes,
-              zdcTime,
-              zdcChannelsT);
-  }
+  auto fillZDC = [&]() {
+    std::vector<float> zdcEnergy, zdcAmplitudes, zdcTime;
+    std::vector<uint8_t> zdcChannelsE, zdcChannelsT;
+    zdcCursor.reserve(zdcBCRecData.size());
+    for (auto zdcRecData : zdcBCRecData) {
+      uint64_t bc = zdcRecData.ir.toLong();
+      auto item = bcsMap.find(bc);
+      int bcID = -1;
+      if (item != bcsMap.end()) {
+        bcID = item->second;
+      } else {
+        LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
+      }
+      int fe, ne, ft, nt, fi, ni;
+      zdcRecData.getRef(fe, ne, ft, nt, fi, ni);
+      zdcEnergy.clear();
+      zdcChannelsE.clear();
+      zdcAmplitudes.clear();
+      zdcTime.clear();
+      zdcChannelsT.clear();
+      for (int ie = 0; ie < ne; ie++) {
+        auto& zdcEnergyData = zdcEnergies[fe + ie];
+        zdcEnergy.emplace_back(zdcEnergyData.energy());
+        zdcChannelsE.emplace_back(zdcEnergyData.ch());
+      }
+      for (int it = 0; it < nt; it++) {
+        auto& tdc = zdcTDCData[ft + it];
+        zdcAmplitudes.emplace_back(tdc.amplitude());
+        zdcTime.emplace_back(tdc.value());
+        zdcChannelsT.emplace_back(o2::zdc::TDCSignal[tdc.ch()]);
+      }
+      zdcCursor(bcID,
+                zdcEnergy,
+                zdcChannelsE,
+                zdcAmplitudes,
+                zdcTime,
+                zdcChannelsT);
+    }
+  };
 
   // keep track event/source id for each mc-collision
   // using map and not unordered_map to ensure
@@ -2001,83 +2009,95 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
   std::sort(mcColToEvSrc.begin(), mcColToEvSrc.end(),
             [](const std::vector<int>& left, const std::vector<int>& right) { return (left[0] < right[0]); });
 
-  // vector of FDD amplitudes
-  int16_t aFDDAmplitudesA[8] = {0u};
-  int16_t aFDDAmplitudesC[8] = {0u};
   // filling FDD table
-  fddCursor.reserve(fddRecPoints.size());
-  for (const auto& fddRecPoint : fddRecPoints) {
-    for (int i = 0; i < 8; i++) {
-      aFDDAmplitudesA[i] = 0;
-      aFDDAmplitudesC[i] = 0;
-    }
+  auto fillFDD = [&]() {
+    // vector of FDD amplitudes
+    int16_t aFDDAmplitudesA[8] = {0u};
+    int16_t aFDDAmplitudesC[8] = {0u};
+    fddCursor.reserve(fddRecPoints.size());
+    for (const auto& fddRecPoint : fddRecPoints) {
+      for (int i = 0; i < 8; i++) {
+        aFDDAmplitudesA[i] = 0;
+        aFDDAmplitudesC[i] = 0;
+      }
 
-    const auto channelData = fddRecPoint.getBunchChannelData(fddChData);
-    for (const auto& channel : channelData) {
-      if (channel.mPMNumber < 8) {
-        aFDDAmplitudesC[channel.mPMNumber] = channel.mChargeADC; // amplitude
-      } else {
-        aFDDAmplitudesA[channel.mPMNumber - 8] = channel.mChargeADC; // amplitude
+      const auto channelData = fddRecPoint.getBunchChannelData(fddChData);
+      for (const auto& channel : channelData) {
+        if (channel.mPMNumber < 8) {
+          aFDDAmplitudesC[channel.mPMNumber] = channel.mChargeADC; // amplitude
+        } else {
+          aFDDAmplitudesA[channel.mPMNumber - 8] = channel.mChargeADC; // amplitude
+        }
       }
-    }
 
-    uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
-    uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
+      uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
+      uint64_t bc = globalBC;
+      auto item = bcsMap.find(bc);
+      int bcID = -1;
+      if (item != bcsMap.end()) {
+        bcID = item->second;
+      } else {
+        LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
+      }
+      fddCursor(bcID,
+                aFDDAmplitudesA,
+                aFDDAmplitudesC,
+                truncateFloatFraction(fddRecPoint.getCollisionTimeA() * 1E-3, mFDDTime), // ps to ns
+                truncateFloatFraction(fddRecPoint.getCollisionTimeC() * 1E-3, mFDDTime), // ps to ns
+                fddRecPoint.getTrigger().getTriggersignals());
     }
-    fddCursor(bcID,
-              aFDDAmplitudesA,
-              aFDDAmplitudesC,
-              truncateFloatFraction(fddRecPoint.getCollisionTimeA() * 1E-3, mFDDTime), // ps to ns
-              truncateFloatFraction(fddRecPoint.getCollisionTimeC() * 1E-3, mFDDTime), // ps to ns
-              fddRecPoint.getTrigger().getTriggersignals());
-  }
+  };
 
   // filling FT0 table
-  std::vector<float> aAmplitudesA, aAmplitudesC;
-  std::vector<uint8_t> aChannelsA, aChannelsC;
-  ft0Cursor.reserve(ft0RecPoints.size());
-  for (auto& ft0RecPoint : ft0RecPoints) {
-    aAmplitudesA.clear();
-    aAmplitudesC.clear();
-    aChannelsA.clear();
-    aChannelsC.clear();
-    const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
-    for (auto& channel : channelData) {
-      // TODO: switch to calibrated amplitude
-      if (channel.QTCAmpl > 0) {
-        constexpr int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
-        if (channel.ChId < nFT0ChannelsAside) {
-          aChannelsA.push_back(channel.ChId);
-          aAmplitudesA.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
-        } else {
-          aChannelsC.push_back(channel.ChId - nFT0ChannelsAside);
-          aAmplitudesC.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+  auto fillFT0 = [&]() {
+    std::vector<float> aAmplitudesA, aAmplitudesC;
+    std::vector<uint8_t> aChannelsA, aChannelsC;
+    ft0Cursor.reserve(ft0RecPoints.size());
+    for (auto& ft0RecPoint : ft0RecPoints) {
+      aAmplitudesA.clear();
+      aAmplitudesC.clear();
+      aChannelsA.clear();
+      aChannelsC.clear();
+      const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
+      for (auto& channel : channelData) {
+        // TODO: switch to calibrated amplitude
+        if (channel.QTCAmpl > 0) {
+          constexpr int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
+          if (channel.ChId < nFT0ChannelsAside) {
+            aChannelsA.push_back(channel.ChId);
+            aAmplitudesA.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+          } else {
+            aChannelsC.push_back(channel.ChId - nFT0ChannelsAside);
+            aAmplitudesC.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+          }
         }
       }
+      uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
+      uint64_t bc = globalBC;
+      auto item = bcsMap.find(bc);
+      int bcID = -1;
+      if (item != bcsMap.end()) {
+        bcID = item->second;
+      } else {
+        LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
+      }
+      ft0Cursor(bcID,
+                aAmplitudesA,
+                aChannelsA,
+                aAmplitudesC,
+                aChannelsC,
+                truncateFloatFraction(ft0RecPoint.getCollisionTimeA() * 1E-3, mT0Time), // ps to ns
+                truncateFloatFraction(ft0RecPoint.getCollisionTimeC() * 1E-3, mT0Time), // ps to ns
+                ft0RecPoint.getTrigger().getTriggersignals());
     }
-    uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
-    uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
-    }
-    ft0Cursor(bcID,
-              aAmplitudesA,
-              aChannelsA,
-              aAmplitudesC,
-              aChannelsC,
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeA() * 1E-3, mT0Time), // ps to ns
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeC() * 1E-3, mT0Time), // ps to ns
-              ft0RecPoint.getTrigger().getTriggersignals());
+  };
+
+  std::array<std::function<void()>, 4> bcTableFillers{fillFV0A, fillZDC, fillFDD, fillFT0};
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(std::min(mNThreads, int(bcTableFillers.size())))
+#endif
+  for (int itab = 0; itab < int(bcTableFillers.size()); itab++) {
+    bcTableFillers[itab]();
   }
 
   if (mUseMC) {
@@ -89,6 +89,9 @@ struct AlignConfig : public o2::conf::ConfigurableParamHelper<AlignConfig> {
   bool KalmanResid = true;    // Kalman residuals
   bool MilleOutBin = true;    // text vs binary output for mille data
   bool GZipMilleOut = false;  // compress binary records
+  bool ZstdMilleOut = false;  // stream binary records as batched zstd frames with a label index
+  int ZstdMilleLevel = 5;     // zstd compression level for mille record streaming
+  int MilleBatchSizeMB = 4;   // uncompressed batch size (MB) of one compressed mille frame
 
   std::string mpDatFileName{"mpData"};            //  file name for records mille data output
   std::string mpParFileName{"mpParams.txt"};      //  file name for MP params
@@ -365,6 +365,7 @@ class Controller final : public TObject
   static const Char_t* sDetectorName[kNDetectors]; // names of detectors //RSREM
   static const Char_t* sMPDataExt;                 // extension for MP2 binary data
   static const Char_t* sMPDataTxtExt;              // extension for MP2 txt data
+  static const Char_t* sMPDataZExt;                // extension for zstd-streamed MP2 binary data
   //
   ClassDefOverride(Controller, 1)
 };
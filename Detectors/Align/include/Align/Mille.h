@@ -31,6 +31,7 @@
 #define MILLE_H
 
 #include <fstream>
+#include <set>
 #include <TArrayI.h>
 #include <TArrayF.h>
 
@@ -43,6 +44,7 @@ class Mille
 {
  public:
   Mille(const std::string& outFileName, bool asBinary = true, bool writeZero = false);
+  ~Mille();
   void mille(int NLC, const float* derLc, int NGL, const float* derGl, const int* label, float rMeas, float sigma);
   void special(int nSpecial, const float* floatings, const int* integers);
   void clear();
@@ -50,15 +52,34 @@ class Mille
   void kill() { clear(); };        // alias to old Mille method
   int end() { return finalise(); } //  alias to old Mille method
 
+  /// switch binary output to batched zstd-compressed frames with a sidecar label
+  /// index (<file>.idx), to be called before the first record is finalised
+  void enableCompression(int level, int batchSizeMB = 4);
+
+  /// extract from a compressed file the records depending on the given global
+  /// labels (all records if the list is empty) into a plain Mille binary readable
+  /// by pede; returns the number of extracted records or -1 on failure
+  static long extract(const std::string& zmilleName, const std::vector<int>& labels, const std::string& outFileName);
+
  private:
+  void flushFrame();
+
   /// largest label allowed: 2^31 - 1
   static constexpr int MaxLabel = 0x7fffffff;
   std::ofstream mOutFile = {};     ///< C-binary for output
+  std::string mFileName = {};      ///< name of the output file
   bool mAsBinary = true;           ///< if false output as text
   bool mWriteZero = false;         ///< if true also write out derivatives/labels ==0
   bool mHasSpecial = false;        ///< if true, special(..) already called for this record
   std::vector<int> mBufferInt;     ///< to collect labels etc.
   std::vector<float> mBufferFloat; ///< to collect derivatives etc.
+  int mCompressionLevel = 0;       ///< >0: batch records into zstd-compressed frames
+  size_t mBatchSize = 0;           ///< uncompressed batch size which triggers a frame flush
+  std::vector<char> mBatch;        ///< accumulated uncompressed records
+  std::vector<char> mZipBuffer;    ///< compression workspace
+  std::vector<int> mRecordLabels;  ///< global labels of the record being built
+  std::set<int> mFrameLabels;      ///< global labels present in the current frame
+  std::ofstream mIndexFile = {};   ///< per-frame label index
 };
 
 } // namespace align
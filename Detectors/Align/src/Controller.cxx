@@ -80,6 +80,7 @@ void Controller::ProcStat::print() const
 
 const Char_t* Controller::sMPDataExt = ".mille";
 const Char_t* Controller::sMPDataTxtExt = ".mille_txt";
+const Char_t* Controller::sMPDataZExt = ".zmille";
 
 const Char_t* Controller::sDetectorName[Controller::kNDetectors] = {"ITS", "TPC", "TRD", "TOF", "HMPID"}; //RSREM
 
@@ -785,8 +786,12 @@ bool Controller::fillMilleData()
   // store MP2 data in Mille format
   if (!mMille) {
     const auto& conf = AlignConfig::Instance();
-    mMilleFileName = fmt::format("{}_{:08d}_{:010d}{}", AlignConfig::Instance().mpDatFileName, mTimingInfo.runNumber, mTimingInfo.tfCounter, conf.MilleOutBin ? sMPDataExt : sMPDataTxtExt);
+    bool zstd = conf.ZstdMilleOut && conf.MilleOutBin;
+    mMilleFileName = fmt::format("{}_{:08d}_{:010d}{}", AlignConfig::Instance().mpDatFileName, mTimingInfo.runNumber, mTimingInfo.tfCounter, conf.MilleOutBin ? (zstd ? sMPDataZExt : sMPDataExt) : sMPDataTxtExt);
     mMille = std::make_unique<Mille>(mMilleFileName.c_str(), conf.MilleOutBin);
+    if (zstd) { // stream compressed frames instead of gzipping the full file at the end
+      mMille->enableCompression(conf.ZstdMilleLevel, conf.MilleBatchSizeMB);
+    }
   }
   if (!mAlgTrack->getDerivDone()) {
     LOG(error) << "Track derivatives are not yet evaluated";
@@ -1082,7 +1087,8 @@ void Controller::closeMilleOutput()
   bool compress = false;
   if (mMille) {
     LOG(info) << "Closing " << mMilleFileName;
-    compress = AlignConfig::Instance().GZipMilleOut;
+    // zstd-streamed output is already compressed, no post-hoc gzip pass needed
+    compress = AlignConfig::Instance().GZipMilleOut && !AlignConfig::Instance().ZstdMilleOut;
   } else {
     return;
   }
@@ -20,6 +20,9 @@
 
 #include "Align/Mille.h"
 #include "Framework/Logger.h"
+#include <Compression.h>
+#include <RZip.h>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -30,6 +33,7 @@ namespace align
 //___________________________________________________________________________
 Mille::Mille(const std::string& outFileName, bool asBinary, bool writeZero)
   : mOutFile(outFileName, (asBinary ? (std::ios::binary | std::ios::out | std::ios::trunc) : (std::ios::out | std::ios::trunc))),
+    mFileName(outFileName),
     mAsBinary(asBinary),
     mWriteZero(writeZero)
 {
@@ -41,6 +45,31 @@ Mille::Mille(const std::string& outFileName, bool asBinary, bool writeZero)
   clear();
 }
 
+//___________________________________________________________________________
+Mille::~Mille()
+{
+  if (mCompressionLevel > 0) {
+    flushFrame();
+  }
+}
+
+//___________________________________________________________________________
+/// Switch to batched zstd-compressed frames with a sidecar label index.
+void Mille::enableCompression(int level, int batchSizeMB)
+{
+  if (!mAsBinary) {
+    LOG(warning) << "Mille: compression is supported only for binary output, ignoring";
+    return;
+  }
+  mCompressionLevel = level > 0 ? level : 1;
+  mBatchSize = size_t(batchSizeMB > 0 ? batchSizeMB : 1) * 1024 * 1024;
+  mBatch.reserve(mBatchSize + 4096);
+  mIndexFile.open(mFileName + ".idx", std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!mIndexFile.is_open()) {
+    LOG(fatal) << "Failed to open Mille index file " << mFileName << ".idx";
+  }
+}
+
 //___________________________________________________________________________
 /// Add measurement to buffer.
 /**
@@ -81,6 +110,7 @@ void Mille::mille(int NLC, const float* derLc,
       if ((label[i] > 0 || mWriteZero) && label[i] <= MaxLabel) { // and for valid labels
         mBufferFloat.push_back(derGl[i]);                         // global derivatives
         mBufferInt.push_back(label[i]);                           // index of global parameter
+        mRecordLabels.push_back(label[i]);                        // remember the label for the frame index
       } else {
         LOGP(error, "Mille: invalid label {} <=0 or > {}", label[i], MaxLabel);
       }
@@ -133,7 +163,28 @@ int Mille::finalise()
   if (nw) { // only if anything stored...
     const int numWordsToWrite = nw * 2;
 
-    if (mAsBinary) {
+    if (mCompressionLevel > 0 && mAsBinary) {
+      // append the record to the current batch; the label stream is
+      // delta-encoded, which compresses much better than the raw labels
+      auto oldSize = mBatch.size();
+      mBatch.resize(oldSize + sizeof(int) * (1 + nw) + sizeof(float) * nw);
+      char* wptr = mBatch.data() + oldSize;
+      std::memcpy(wptr, &numWordsToWrite, sizeof(int));
+      wptr += sizeof(int);
+      std::memcpy(wptr, mBufferFloat.data(), nw * sizeof(float));
+      wptr += nw * sizeof(float);
+      int prev = 0;
+      for (int i = 0; i < nw; i++) {
+        int delta = mBufferInt[i] - prev;
+        prev = mBufferInt[i];
+        std::memcpy(wptr, &delta, sizeof(int));
+        wptr += sizeof(int);
+      }
+      mFrameLabels.insert(mRecordLabels.begin(), mRecordLabels.end());
+      if (mBatch.size() >= mBatchSize) {
+        flushFrame();
+      }
+    } else if (mAsBinary) {
       mOutFile.write(reinterpret_cast<const char*>(&numWordsToWrite), sizeof(int));
       mOutFile.write(reinterpret_cast<const char*>(mBufferFloat.data()), nw * sizeof(mBufferFloat[0]));
       mOutFile.write(reinterpret_cast<const char*>(mBufferInt.data()), nw * sizeof(mBufferInt[0]));
@@ -161,9 +212,133 @@ void Mille::clear()
   mHasSpecial = false;
   mBufferInt.clear();
   mBufferFloat.clear();
+  mRecordLabels.clear();
   mBufferFloat.push_back(0.f);
   mBufferInt.push_back(0); // position 0 used as error counter
 }
 
+//___________________________________________________________________________
+/// Compress the accumulated batch of records into one frame and index it.
+void Mille::flushFrame()
+{
+  if (mBatch.empty()) {
+    return;
+  }
+  int srcSize = int(mBatch.size());
+  int tgtSize = srcSize;
+  mZipBuffer.resize(srcSize);
+  int zipped = 0;
+  R__zipMultipleAlgorithm(mCompressionLevel, &srcSize, mBatch.data(), &tgtSize, mZipBuffer.data(), &zipped, ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+  const char* frame = mZipBuffer.data();
+  if (zipped <= 0 || zipped >= srcSize) { // incompressible frame, store it as is
+    frame = mBatch.data();
+    zipped = srcSize;
+  }
+  int64_t offset = mOutFile.tellp();
+  mOutFile.write(frame, zipped);
+  // index entry: frame position, sizes and the global labels it contains
+  int32_t zipSize = zipped, rawSize = srcSize, nLabels = int32_t(mFrameLabels.size());
+  mIndexFile.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+  mIndexFile.write(reinterpret_cast<const char*>(&zipSize), sizeof(zipSize));
+  mIndexFile.write(reinterpret_cast<const char*>(&rawSize), sizeof(rawSize));
+  mIndexFile.write(reinterpret_cast<const char*>(&nLabels), sizeof(nLabels));
+  for (int lbl : mFrameLabels) {
+    int32_t l = lbl;
+    mIndexFile.write(reinterpret_cast<const char*>(&l), sizeof(l));
+  }
+  mBatch.clear();
+  mFrameLabels.clear();
+}
+
+//___________________________________________________________________________
+/// Extract records depending on the given global labels into a plain Mille binary.
+long Mille::extract(const std::string& zmilleName, const std::vector<int>& labels, const std::string& outFileName)
+{
+  std::ifstream zin(zmilleName, std::ios::binary);
+  std::ifstream idx(zmilleName + ".idx", std::ios::binary);
+  if (!zin.is_open() || !idx.is_open()) {
+    LOG(error) << "Mille::extract: cannot open " << zmilleName << " or its .idx companion";
+    return -1;
+  }
+  std::ofstream out(outFileName, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    LOG(error) << "Mille::extract: cannot open output file " << outFileName;
+    return -1;
+  }
+  std::set<int> selection(labels.begin(), labels.end());
+  std::vector<char> zbuf, raw;
+  std::vector<int> ints;
+  long nRecords = 0;
+  while (true) {
+    int64_t offset = 0;
+    int32_t zipSize = 0, rawSize = 0, nLabels = 0;
+    if (!idx.read(reinterpret_cast<char*>(&offset), sizeof(offset))) {
+      break; // no more frames
+    }
+    idx.read(reinterpret_cast<char*>(&zipSize), sizeof(zipSize));
+    idx.read(reinterpret_cast<char*>(&rawSize), sizeof(rawSize));
+    idx.read(reinterpret_cast<char*>(&nLabels), sizeof(nLabels));
+    bool wanted = selection.empty();
+    for (int32_t i = 0; i < nLabels; i++) {
+      int32_t l = 0;
+      idx.read(reinterpret_cast<char*>(&l), sizeof(l));
+      wanted = wanted || selection.count(l);
+    }
+    if (!wanted) {
+      continue; // no selected label in this frame, skip it without reading
+    }
+    zbuf.resize(zipSize);
+    raw.resize(rawSize);
+    zin.seekg(offset);
+    zin.read(zbuf.data(), zipSize);
+    if (zipSize < rawSize) {
+      int src = zipSize, tgt = rawSize, irep = 0;
+      R__unzip(&src, reinterpret_cast<unsigned char*>(zbuf.data()), &tgt, reinterpret_cast<unsigned char*>(raw.data()), &irep);
+      if (irep != rawSize) {
+        LOG(error) << "Mille::extract: failed to decompress frame at offset " << offset;
+        return -1;
+      }
+    } else {
+      std::memcpy(raw.data(), zbuf.data(), rawSize);
+    }
+    const char* rptr = raw.data();
+    const char* rend = raw.data() + rawSize;
+    while (rptr < rend) {
+      int numWords = 0;
+      std::memcpy(&numWords, rptr, sizeof(int));
+      rptr += sizeof(int);
+      const int nw = numWords / 2;
+      const char* floats = rptr;
+      rptr += nw * sizeof(float);
+      ints.resize(nw);
+      int prev = 0;
+      for (int i = 0; i < nw; i++) {
+        int delta = 0;
+        std::memcpy(&delta, rptr, sizeof(int));
+        rptr += sizeof(int);
+        prev += delta;
+        ints[i] = prev;
+      }
+      // the global labels follow the third zero marker (header, measurement, sigma)
+      bool keep = selection.empty();
+      int nZero = 0;
+      for (int i = 0; i < nw && !keep; i++) {
+        if (ints[i] == 0) {
+          nZero++;
+        } else if (nZero >= 3 && selection.count(ints[i])) {
+          keep = true;
+        }
+      }
+      if (keep) {
+        out.write(reinterpret_cast<const char*>(&numWords), sizeof(int));
+        out.write(floats, nw * sizeof(float));
+        out.write(reinterpret_cast<const char*>(ints.data()), nw * sizeof(int));
+        nRecords++;
+      }
+    }
+  }
+  return nRecords;
+}
+
 } // namespace align
 } // namespace o2
@@ -25,6 +25,7 @@
 #include "DetectorsCommonDataFormats/CTFDictHeader.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "DetectorsCommonDataFormats/CTFIOSize.h"
+#include "DetectorsCommonDataFormats/CTFColumnStats.h"
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DetectorsCommonDataFormats/ANSHeader.h"
 #include "rANS/factory.h"
@@ -35,6 +36,7 @@
 #include "Framework/ConcreteDataMatcher.h"
 #include "Framework/ConfigParamRegistry.h"
 #include <any>
+#include <functional>
 
 namespace o2
 {
@@ -121,6 +123,13 @@ class CTFCoderBase
   void setVerbosity(int v) { mVerbosity = v; }
   int getVerbosity() const { return mVerbosity; }
 
+  void setCoderThreads(int n) { mCoderThreads = n > 1 ? n : 1; }
+  int getCoderThreads() const { return mCoderThreads; }
+
+  void setReportColumnSizes(bool v) { mReportColumnSizes = v; }
+  bool getReportColumnSizes() const { return mReportColumnSizes; }
+  const CTFColumnStats& getColumnStats() const { return mColumnStats; }
+
   const CTFDictHeader& getExtDictHeader() const { return mExtHeader; }
 
   template <typename T>
@@ -185,6 +194,11 @@ class CTFCoderBase
     return estimateBufferSize(slot, samples.begin(), samples.end());
   }
 
+  // Run independent per-block coding jobs and sum up their I/O sizes. When more than 1 coder
+  // thread was requested the jobs are dispatched to a pool of threads, hence they must not
+  // touch shared state (e.g. decoding of distinct blocks to distinct destination containers).
+  o2::ctf::CTFIOSize dispatchBlockJobs(std::vector<std::function<o2::ctf::CTFIOSize()>>& jobs) const;
+
   template <typename CTF>
   std::vector<char> loadDictionaryFromTree(TTree* tree);
   std::vector<std::any> mCoders; // encoders/decoders
@@ -203,7 +217,10 @@ class CTFCoderBase
   size_t mIRFrameSelMarginBwd = 0; // margin in BC to add to the IRFrame lower boundary when selection is requested
   size_t mIRFrameSelMarginFwd = 0; // margin in BC to add to the IRFrame upper boundary when selection is requested
   long mIRFrameSelShift = 0;       // Global shift of the IRFrames, to account for e.g. detector latency
+  int mCoderThreads = 1;           // number of threads to process independent blocks
   int mVerbosity = 0;
+  bool mReportColumnSizes = false; // collect and report per-column sizes of the encoded CTF
+  CTFColumnStats mColumnStats;     // per-column statistics of the last encoded CTF
 };
 
 ///________________________________
@@ -325,6 +342,12 @@ void CTFCoderBase::init(o2::framework::InitContext& ic)
       }
     }
   }
+  if (ic.options().hasOption("ans-threads")) {
+    setCoderThreads(ic.options().get<int>("ans-threads"));
+  }
+  if (ic.options().hasOption("ctf-columns-report")) {
+    setReportColumnSizes(ic.options().get<bool>("ctf-columns-report"));
+  }
   auto dict = ic.options().get<std::string>("ctf-dict");
   if (dict.empty() || dict == "ccdb") { // load from CCDB
     mLoadDictFromCCDB = true;
@@ -347,6 +370,14 @@ size_t CTFCoderBase::finaliseCTFOutput(BUF& buffer)
   eeb->compactify();                  // eliminate unnecessary padding
   buffer.resize(eeb->size());         // shrink buffer to strictly necessary size
   // eeb->print();
+  if (mReportColumnSizes) {
+    eeb->fillColumnStats(mColumnStats);
+    mColumnStats.det = mDet;
+    LOGP(important, "{}{}", getPrefix(), mColumnStats.asString());
+    for (int i = 0; i < mColumnStats.getNColumns(); i++) {
+      LOGP(important, "{}{}", getPrefix(), mColumnStats.asString(i));
+    }
+  }
   return eeb->size();
 }
 
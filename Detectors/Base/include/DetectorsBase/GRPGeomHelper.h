@@ -35,6 +35,10 @@ namespace o2::detectors
 {
 class AlignParam;
 }
+namespace o2::ccdb
+{
+class CcdbApi;
+}
 namespace o2::parameters
 {
 class GRPECSObject;
@@ -136,6 +140,17 @@ class GRPGeomHelper
   const o2::parameters::AggregatedRunInfo& getAggregatedRunInfo() const { return mAggregatedRunInfo; }
   static int getNHBFPerTF();
 
+  // fetch the material LUT directly from CCDB (for standalone use outside of the DPL condition
+  // inputs machinery): objects stored as flat-blob images (CCDB/CcdbFlatBlob.h) are restored
+  // with plain memcpy's, ROOT-serialized ones go through the usual TMemFile deserialization
+  static const o2::base::MatLayerCylSet* loadMatLUT(const o2::ccdb::CcdbApi& api, long timestamp, const std::string& path = "GLO/Param/MatLUT");
+
+  // Load the aligned geometry into gGeoManager through a node-local cache: only the first
+  // process on the node fetches the object from CCDB and exports it to a file keyed by
+  // the object ETag, all later ones import the cached file (sharing the kernel page
+  // cache and skipping download and alignment). Empty cacheDir fetches directly.
+  static bool loadAlignedGeometryCached(const o2::ccdb::CcdbApi& api, long timestamp, const std::string& cacheDir, const std::string& path = "GLO/Config/GeometryAligned");
+
  private:
   GRPGeomHelper() = default;
 
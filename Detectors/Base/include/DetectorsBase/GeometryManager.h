@@ -29,6 +29,7 @@
 #include <mutex>
 class TGeoHMatrix; // lines 11-11
 class TGeoManager; // lines 9-9
+class TGeoNavigator;
 
 namespace o2
 {
@@ -97,6 +98,10 @@ class GeometryManager : public TObject
   };
 
   static o2::base::MatBudget meanMaterialBudget(float x0, float y0, float z0, float x1, float y1, float z1);
+  /// variant navigating with the caller-owned navigator: does not take the global TGeo lock,
+  /// so concurrent callers with their own navigators (gGeoManager->AddNavigator() per thread
+  /// after gGeoManager->SetMaxThreads) can query the budget in parallel
+  static o2::base::MatBudget meanMaterialBudget(float x0, float y0, float z0, float x1, float y1, float z1, TGeoNavigator* nav);
   static o2::base::MatBudget meanMaterialBudget(const math_utils::Point3D<float>& start, const math_utils::Point3D<float>& end)
   {
     return meanMaterialBudget(start.X(), start.Y(), start.Z(), end.X(), end.Y(), end.Z());
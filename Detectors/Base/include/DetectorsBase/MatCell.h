@@ -48,6 +48,21 @@ struct MatCell {
   ClassDefNV(MatCell, 1);
 };
 
+struct MatCellQ {
+  // quantized representation of the MatCell: values are stored as 16-bit integers
+  // and decoded with per-layer scaling factors kept next to the cells array
+
+  static constexpr int NParams = 2;     // number of material parameters described
+  static constexpr float QMax = 0xffff; // max quantized value
+  uint16_t meanRhoQ;                    ///< quantized mean density
+  uint16_t meanX2X0Q;                   ///< quantized fraction of radiation length
+
+  GPUd() MatCellQ() : meanRhoQ(0), meanX2X0Q(0) {}
+  GPUdDefault() MatCellQ(const MatCellQ& src) CON_DEFAULT;
+
+  ClassDefNV(MatCellQ, 1);
+};
+
 struct MatBudget : MatCell {
 
   // small struct to hold <X/X0>, <rho> and length traversed by track in the voxel
@@ -25,6 +25,8 @@
 #include "GPUCommonMath.h"
 #include "DetectorsBase/MatCell.h"
 
+class TGeoNavigator;
+
 namespace o2
 {
 namespace base
@@ -65,8 +67,8 @@ class MatLayerCyl : public o2::gpu::FlatObject
 
   void initSegmentation(float rMin, float rMax, float zHalfSpan, int nz, int nphi);
   void initSegmentation(float rMin, float rMax, float zHalfSpan, float dzMin, float drphiMin);
-  void populateFromTGeo(int ntrPerCell = 10);
-  void populateFromTGeo(int ip, int iz, int ntrPerCell);
+  void populateFromTGeo(int ntrPerCell = 10, int nThreads = 1);
+  void populateFromTGeo(int ip, int iz, int ntrPerCell, TGeoNavigator* nav = nullptr);
   void print(bool data = false) const;
 #endif // !GPUCA_ALIGPUCODE
 
@@ -88,10 +90,27 @@ class MatLayerCyl : public o2::gpu::FlatObject
   GPUd() float getDZ() const { return mDZ; }
   GPUd() float getDPhi() const { return mDPhi; }
 
-  // obtain material cell, cell ID must be valid
+  // obtain material cell, cell ID must be valid; use only on non-quantized layers
   GPUd() const MatCell& getCellPhiBin(int iphi, int iz) const { return mCells[getCellIDPhiBin(iphi, iz)]; }
   GPUd() const MatCell& getCell(int iphiSlice, int iz) const { return mCells[getCellID(iphiSlice, iz)]; }
 
+  GPUd() bool isQuantized() const { return mQuantized == Quantized16Bit; }
+
+  // obtain decoded copy of the material cell, valid for both quantized and float layers
+  GPUd() MatCell getCellCopy(int iphiSlice, int iz) const
+  {
+    if (mQuantized != Quantized16Bit) {
+      return mCells[getCellID(iphiSlice, iz)];
+    }
+    const float* q2v = reinterpret_cast<const float*>(mCells); // decoding scales precede the cells
+    const auto& cellQ = reinterpret_cast<const MatCellQ*>(q2v + MatCellQ::NParams)[getCellID(iphiSlice, iz)];
+    MatCell cell;
+    cell.meanRho = cellQ.meanRhoQ * q2v[0];
+    cell.meanX2X0 = cellQ.meanX2X0Q * q2v[1];
+    return cell;
+  }
+  GPUd() MatCell getCellPhiBinCopy(int iphi, int iz) const { return getCellCopy(phiBin2Slice(iphi), iz); }
+
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
   GPUd() MatCell& getCellPhiBin(int iphi, int iz)
   {
@@ -133,21 +152,23 @@ class MatLayerCyl : public o2::gpu::FlatObject
   bool cellsDiffer(const MatCell& cellA, const MatCell& cellB, float maxRelDiff) const;
   bool canMergePhiSlices(int i, int j, float maxRelDiff = 0.05, int maxDifferent = 1) const;
   void optimizePhiSlices(float maxRelDiff = 0.05);
+  void quantize();
   void flatten(char* newPtr);
 #endif // !GPUCA_ALIGPUCODE
 
 #ifndef GPUCA_GPUCODE
   std::size_t estimateFlatBufferSize() const
   {
-    return estimateFlatBufferSize(getNPhiBins(), getNPhiSlices(), getNZBins());
+    return estimateFlatBufferSize(getNPhiBins(), getNPhiSlices(), getNZBins(), isQuantized());
   }
-  static std::size_t estimateFlatBufferSize(int nPhiBins, int nPhiSlices, int nZBins)
+  static std::size_t estimateFlatBufferSize(int nPhiBins, int nPhiSlices, int nZBins, bool quantized = false)
   {
     size_t sz = 0;
-    sz += alignSize(sz + nPhiBins * sizeof(short), getBufferAlignmentBytes());              // mPhiBin2Slice
-    sz += alignSize(sz + nPhiSlices * sizeof(float), getBufferAlignmentBytes());            // mSliceCos
-    sz += alignSize(sz + nPhiSlices * sizeof(float), getBufferAlignmentBytes());            // mSliceSin
-    sz += alignSize(sz + nPhiSlices * nZBins * sizeof(MatCell), getBufferAlignmentBytes()); // mSliceSin
+    std::size_t szCells = quantized ? MatCellQ::NParams * sizeof(float) + nPhiSlices * nZBins * sizeof(MatCellQ) : nPhiSlices * nZBins * sizeof(MatCell);
+    sz += alignSize(sz + nPhiBins * sizeof(short), getBufferAlignmentBytes());   // mPhiBin2Slice
+    sz += alignSize(sz + nPhiSlices * sizeof(float), getBufferAlignmentBytes()); // mSliceCos
+    sz += alignSize(sz + nPhiSlices * sizeof(float), getBufferAlignmentBytes()); // mSliceSin
+    sz += alignSize(sz + szCells, getBufferAlignmentBytes());                    // mCells, with decoding scales ahead if quantized
     return sz;
   }
   void fixPointers(char* oldPtr, char* newPtr);
@@ -196,9 +217,12 @@ class MatLayerCyl : public o2::gpu::FlatObject
 
   //------------------------------------------------------
 
+  static constexpr short Quantized16Bit = 0x5136; ///< magic value marking layers with 16-bit quantized cells
+
   short mNZBins;     ///< number of Z bins
   short mNPhiBins;   ///< number of phi bins (logical)
   short mNPhiSlices; ///< actual number of phi slices
+  short mQuantized;  ///< Quantized16Bit if the cells were quantized, occupies former padding to keep old layout
   //
   float mZHalf;   ///< Z half span
   float mRMin2;   ///< squared min r
@@ -215,7 +239,7 @@ class MatLayerCyl : public o2::gpu::FlatObject
 
   MatCell* mCells; //! mat.budget per cell
 
-  ClassDefNV(MatLayerCyl, 1);
+  ClassDefNV(MatLayerCyl, 2);
 };
 
 } // namespace base
@@ -22,6 +22,9 @@
 
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
 #include "MathUtils/Cartesian.h"
+#include <string>
+#include <vector>
+class TFile;
 #endif // !GPUCA_ALIGPUCODE
 
 /**********************************************************************
@@ -73,8 +76,29 @@ class MatLayerCylSet : public o2::gpu::FlatObject
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
   void print(bool data = false) const;
   void addLayer(float rmin, float rmax, float zmax, float dz, float drphi);
-  void populateFromTGeo(int ntrPerCel = 10);
+  /// populate the layers with ntrPerCel test tracks per cell, rasterizing with nThreads workers.
+  /// When cacheFile is provided, the rasterized cells of every layer are stored there together
+  /// with the budgets of a small set of probe rays: on the next build, layers whose probe
+  /// budgets are unchanged (i.e. whose geometry/alignment did not move) are restored from the
+  /// cache instead of being re-rasterized.
+  void populateFromTGeo(int ntrPerCel = 10, int nThreads = 1, const std::string& cacheFile = "");
+  /// segmentation parameters and probe-ray material fingerprint of the layer, used as the cache key
+  std::vector<float> layerCacheMeta(const MatLayerCyl& lr, int ntrPerCell) const;
+  /// restore the cells of the layer from the cache if its stored meta matches; true on success
+  bool importLayerCells(MatLayerCyl& lr, TFile& cache, int il, const std::vector<float>& meta);
+  /// store the cells of the layer and its meta in the cache
+  void exportLayerCells(const MatLayerCyl& lr, TFile& cache, int il, const std::vector<float>& meta);
   void optimizePhiSlices(float maxRelDiff = 0.05);
+  void quantize();
+  bool isQuantized() const
+  {
+    for (int i = getNLayers(); i--;) {
+      if (getLayer(i).isQuantized()) {
+        return true;
+      }
+    }
+    return false;
+  }
 
   void dumpToTree(const std::string& outName = "matbudTree.root") const;
   void writeToFile(const std::string& outFName = "matbud.root");
@@ -98,9 +122,15 @@ class MatLayerCylSet : public o2::gpu::FlatObject
     // get material budget traversed on the line between point0 and point1
     return getMatBudget(point0.X(), point0.Y(), point0.Z(), point1.X(), point1.Y(), point1.Z());
   }
+  /// batched version: get the budgets of nRays rays at once, processing the layers layer-major
+  /// so that the tables of every layer are visited once per batch instead of once per ray
+  void getMatBudget(int nRays, Ray* rays, MatBudget* budgets) const;
 #endif // !GPUCA_ALIGPUCODE
   GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const;
 
+  /// account in the budget the material seen by the ray on all its crossings with given layer
+  GPUd() void accountLayerCrossings(Ray& ray, short lrID, MatBudget& rval) const;
+
   GPUd() int searchSegment(float val, int low = -1, int high = -1) const;
 
   /// searches a layer based on r2 input, using a lookup table
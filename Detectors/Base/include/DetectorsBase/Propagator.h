@@ -80,6 +80,17 @@ class PropagatorImpl
                                  value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
                                  track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const;
 
+#ifndef GPUCA_GPUCODE
+  ///< batched version: the tracks with non-zero status are advanced in lockstep to their xToGo, so that
+  ///< the field of all tracks sharing a step is evaluated in a single structure-of-arrays pass and their
+  ///< material budgets are obtained with a single layer-major query of the material LUT; diverged tracks
+  ///< are compacted out of the batch. On exit the status is 1 for tracks which reached their xToGo and 0 otherwise,
+  ///< the return value is the number of tracks which reached it. tofInfo, if provided, must have nTracks entries.
+  int PropagateToXBxByBz(int nTracks, TrackParCov_t* tracks, const value_type* xToGo, uint8_t* status,
+                         value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                         track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const;
+#endif
+
   GPUd() bool propagateToX(TrackParCov_t& track, value_type x, value_type bZ,
                            value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
                            track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const;
@@ -157,10 +168,37 @@ class PropagatorImpl
 
   GPUd() void getFieldXYZ(const math_utils::Point3D<double> xyz, double* bxyz) const;
 
+#ifndef GPUCA_GPUCODE
+  ///< batched version: evaluate the field in nPts points at once, bxyz must have 3*nPts entries;
+  ///< the dispatch to the field implementation is resolved once per batch instead of once per point
+  void getFieldXYZ(int nPts, const math_utils::Point3D<value_type>* xyz, value_type* bxyz) const;
+#endif
+
  private:
 #ifndef GPUCA_GPUCODE
   PropagatorImpl(bool uninitialized = false);
   ~PropagatorImpl() = default;
+
+  ///< field access variants of the specialized propagation loop
+  enum class FieldKind : int { UniformBz, // single Bz value passed by the caller
+                               FastField, // fast parameterized field
+                               AnyField   // generic per-point dispatch, fall-back for the remaining cases
+  };
+
+  ///< scalar propagation loop with the material treatment and field access resolved at compile time;
+  ///< the public entry points map their runtime flags to the matching instantiation once per call,
+  ///< so the per-step loop carries no dispatch
+  template <typename track_T, MatCorrType matCorrT, FieldKind fieldT>
+  bool propagateToXImpl(track_T& track, value_type xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
+                        track::TrackLTIntegral* tofInfo, int signCorr) const;
+
+  template <typename track_T, MatCorrType matCorrT>
+  bool propagateToXFieldDispatch(track_T& track, value_type xToGo, value_type bZ, bool bzOnly, value_type maxSnp, value_type maxStep,
+                                 track::TrackLTIntegral* tofInfo, int signCorr) const;
+
+  template <typename track_T>
+  bool propagateToXDispatch(track_T& track, value_type xToGo, value_type bZ, bool bzOnly, value_type maxSnp, value_type maxStep,
+                            MatCorrType matCorr, track::TrackLTIntegral* tofInfo, int signCorr) const;
 #endif
   static constexpr value_type Epsilon = 0.00001; // precision of propagation to X
   template <typename T>
@@ -190,6 +190,10 @@ class Stack : public FairGenericStack
 
   void initFromPrimaries(std::vector<TParticle>& primaries)
   {
+    if (mPrimariesOnlyMode) {
+      initFromPrimariesPooled(primaries);
+      return;
+    }
     Reset();
     for (auto p : primaries) {
       Int_t doTrack = 0;
@@ -204,6 +208,15 @@ class Stack : public FairGenericStack
 
   void setExternalMode(bool m) { mIsExternalMode = m; }
 
+  /// Enable a pooled, primaries-only operation mode meant for generator-level
+  /// productions (no transport). The per-event buffers keep their allocations
+  /// across initFromPrimaries calls and primaries are injected in one batch
+  /// without the per-particle transport-stack and index-map bookkeeping;
+  /// PopNextTrack serves the primaries directly from the primary buffer.
+  /// Must not be enabled when particles are actually transported.
+  void setPrimariesOnlyMode(bool m) { mPrimariesOnlyMode = m; }
+  bool isPrimariesOnlyMode() const { return mPrimariesOnlyMode; }
+
   /// Allow to query the **direct** mother track ID of an arbitrary trackID managed by stack
   int getMotherTrackId(int /*trackid*/) const;
 
@@ -296,6 +309,9 @@ class Stack : public FairGenericStack
   bool mIsExternalMode = false; // is stack an external factory or directly used inside simulation?
   bool mDoTrackSeeding = false; // whether to do track based seeding
 
+  bool mPrimariesOnlyMode = false; //! pooled generator-level mode (no transport bookkeeping)
+  Int_t mPrimaryPopCursor = 0;     //! next primary to serve from PopNextTrack in primaries-only mode
+
   TransportFcn mTransportPrimary = [](const TParticle& p, const std::vector<TParticle>& particles) { return false; }; //! a function to inhibit the tracking of a particle
 
   // storage for track references
@@ -309,6 +325,10 @@ class Stack : public FairGenericStack
   /// returns false if some tracks are discarded
   bool selectTracks();
 
+  /// batch (re-)initialization from external primaries in primaries-only mode;
+  /// keeps the capacity of the per-event buffers
+  void initFromPrimariesPooled(std::vector<TParticle>& primaries);
+
   bool isPrimary(const MCTrack& part);
   bool isFromPrimaryDecayChain(const MCTrack& part);
   bool isFromPrimaryPairProduction(const MCTrack& part);
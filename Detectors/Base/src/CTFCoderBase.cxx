@@ -18,10 +18,52 @@
 #include "Framework/ProcessingContext.h"
 #include "Framework/InputRecord.h"
 #include "Framework/TimingInfo.h"
+#include <atomic>
+#include <thread>
 
 using namespace o2::ctf;
 using namespace o2::framework;
 
+CTFIOSize CTFCoderBase::dispatchBlockJobs(std::vector<std::function<CTFIOSize()>>& jobs) const
+{
+  CTFIOSize total{};
+  int nThreads = std::min(mCoderThreads, int(jobs.size()));
+  if (nThreads < 2) {
+    for (auto& job : jobs) {
+      total += job();
+    }
+    return total;
+  }
+  std::atomic<size_t> nextJob{0};
+  std::vector<CTFIOSize> partials(nThreads);
+  std::vector<std::exception_ptr> errors(nThreads);
+  std::vector<std::thread> pool;
+  pool.reserve(nThreads);
+  for (int it = 0; it < nThreads; it++) {
+    pool.emplace_back([&, it]() {
+      try {
+        for (size_t ij = nextJob++; ij < jobs.size(); ij = nextJob++) {
+          partials[it] += jobs[ij]();
+        }
+      } catch (...) {
+        errors[it] = std::current_exception(); // rethrown on the calling thread after the join
+      }
+    });
+  }
+  for (auto& t : pool) {
+    t.join();
+  }
+  for (auto& err : errors) {
+    if (err) {
+      std::rethrow_exception(err);
+    }
+  }
+  for (const auto& partial : partials) {
+    total += partial;
+  }
+  return total;
+}
+
 void CTFCoderBase::checkDictVersion(const CTFDictHeader& h) const
 {
   if (h.isValidDictTimeStamp()) { // external dictionary was used
@@ -31,6 +31,7 @@
 
 #pragma link C++ class o2::base::Ray + ;
 #pragma link C++ class o2::base::MatCell + ;
+#pragma link C++ class o2::base::MatCellQ + ;
 #pragma link C++ class o2::base::MatBudget + ;
 #pragma link C++ class o2::base::MatLayerCyl + ;
 #pragma link C++ class o2::base::MatLayerCylSet + ;
@@ -24,7 +24,14 @@
 #include "Framework/InputRecord.h"
 #include "Framework/TimingInfo.h"
 #include "Framework/CCDBParamSpec.h"
+#include "CCDB/CcdbApi.h"
+#include "CCDB/CcdbFlatBlob.h"
+#include "CommonUtils/FileSystemUtils.h"
 #include "DetectorsBase/MatLayerCylSet.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <unistd.h>
 #include "DetectorsBase/Propagator.h"
 #include "DetectorsCommonDataFormats/AlignParam.h"
 #include "DataFormatsParameters/GRPLHCIFData.h"
@@ -256,3 +263,57 @@ int GRPGeomHelper::getNHBFPerTF()
 {
   return instance().mGRPECS ? instance().mGRPECS->getNHBFPerTF() : 128;
 }
+
+bool GRPGeomHelper::loadAlignedGeometryCached(const o2::ccdb::CcdbApi& api, long timestamp, const std::string& cacheDir, const std::string& path)
+{
+  std::map<std::string, std::string> metadata;
+  if (!cacheDir.empty()) {
+    auto headers = api.retrieveHeaders(path, metadata, timestamp);
+    auto et = headers.find("ETag");
+    if (et == headers.end() || et->second.empty()) {
+      LOGP(alarm, "Cannot query {} for timestamp {}", path, timestamp);
+      return false;
+    }
+    std::string key = et->second;
+    key.erase(std::remove_if(key.begin(), key.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '-'; }), key.end());
+    o2::utils::createDirectoriesIfAbsent(cacheDir);
+    auto cacheFile = fmt::format("{}/geomAligned_{}.root", cacheDir, key);
+    if (std::filesystem::exists(cacheFile)) {
+      LOGP(info, "Importing aligned geometry from node-local cache {}", cacheFile);
+      return TGeoManager::Import(cacheFile.c_str()) != nullptr;
+    }
+    auto* geom = api.retrieveFromTFileAny<TGeoManager>(path, metadata, timestamp);
+    if (!geom) {
+      return false;
+    }
+    // publish via a process-unique temporary and an atomic rename, so concurrently
+    // starting processes never see a partial file
+    auto tmpFile = fmt::format("{}.{}.part", cacheFile, getpid());
+    geom->Export(tmpFile.c_str());
+    std::error_code ec;
+    std::filesystem::rename(tmpFile, cacheFile, ec);
+    if (ec) {
+      std::filesystem::remove(tmpFile, ec);
+    }
+    return true;
+  }
+  return api.retrieveFromTFileAny<TGeoManager>(path, metadata, timestamp) != nullptr;
+}
+
+const o2::base::MatLayerCylSet* GRPGeomHelper::loadMatLUT(const o2::ccdb::CcdbApi& api, long timestamp, const std::string& path)
+{
+  std::map<std::string, std::string> metadata;
+  o2::pmr::vector<char> blob;
+  api.loadFileToMemory(blob, path, metadata, timestamp, nullptr, "", "", "");
+  if (blob.empty() || o2::ccdb::CcdbApi::isMemoryFileInvalid(blob)) {
+    LOGP(alarm, "Failed to load material LUT from {} for timestamp {}", path, timestamp);
+    return nullptr;
+  }
+  MatLayerCylSet* lut = nullptr;
+  if (o2::ccdb::CcdbFlatBlob::isFlatBlob(blob.data(), blob.size())) {
+    lut = o2::ccdb::CcdbFlatBlob::extractImage<MatLayerCylSet>(blob.data(), blob.size());
+  } else {
+    lut = o2::ccdb::CcdbApi::extractFromMemoryBlob<MatLayerCylSet>(blob);
+  }
+  return lut ? MatLayerCylSet::rectifyPtrFromFile(lut) : nullptr;
+}
@@ -18,6 +18,11 @@
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
 #include "DetectorsBase/GeometryManager.h"
 #include "GPUCommonLogger.h"
+#include <TGeoManager.h>
+#include <TGeoNavigator.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 #endif
 
 using namespace o2::base;
@@ -25,7 +30,7 @@ using flatObject = o2::gpu::FlatObject;
 
 #ifndef GPUCA_GPUCODE
 //________________________________________________________________________________
-MatLayerCyl::MatLayerCyl() : mNZBins(0), mNPhiBins(0), mNPhiSlices(0), mZHalf(0.f), mRMin2(0.f), mRMax2(0.f), mDZ(0.f), mDZInv(0.f), mDPhi(0.f), mDPhiInv(0.f), mPhiBin2Slice(nullptr), mSliceCos(nullptr), mSliceSin(nullptr), mCells(nullptr)
+MatLayerCyl::MatLayerCyl() : mNZBins(0), mNPhiBins(0), mNPhiSlices(0), mQuantized(0), mZHalf(0.f), mRMin2(0.f), mRMax2(0.f), mDZ(0.f), mDZInv(0.f), mDPhi(0.f), mDPhiInv(0.f), mPhiBin2Slice(nullptr), mSliceCos(nullptr), mSliceSin(nullptr), mCells(nullptr)
 {
 }
 #endif
@@ -85,6 +90,7 @@ void MatLayerCyl::initSegmentation(float rMin, float rMax, float zHalfSpan, int
 
   o2::gpu::resizeArray(mPhiBin2Slice, 0, nphi, reinterpret_cast<short*>(mFlatBufferPtr + offs));
   mNPhiSlices = mNPhiBins = nphi;
+  mQuantized = 0;
 
   for (int i = nphi; i--;) {
     mPhiBin2Slice[i] = i; // fill with trivial mapping
@@ -109,21 +115,47 @@ void MatLayerCyl::initSegmentation(float rMin, float rMax, float zHalfSpan, int
 }
 
 //________________________________________________________________________________
-void MatLayerCyl::populateFromTGeo(int ntrPerCell)
+void MatLayerCyl::populateFromTGeo(int ntrPerCell, int nThreads)
 {
-  /// populate layer with info extracted from TGeometry, using ntrPerCell test tracks per cell
+  /// populate layer with info extracted from TGeometry, using ntrPerCell test tracks per cell,
+  /// rasterizing the cells with nThreads workers
   assert(mConstructionMask != Constructed);
   mConstructionMask = InProgress;
   ntrPerCell = ntrPerCell > 1 ? ntrPerCell : 1;
-  for (int iz = getNZBins(); iz--;) {
-    for (int ip = getNPhiBins(); ip--;) {
-      populateFromTGeo(ip, iz, ntrPerCell);
+  if (nThreads < 2) {
+    for (int iz = getNZBins(); iz--;) {
+      for (int ip = getNPhiBins(); ip--;) {
+        populateFromTGeo(ip, iz, ntrPerCell);
+      }
     }
+    return;
+  }
+  // with an own navigator per worker the rays are rasterized without serializing
+  // on the global TGeo navigation lock; the cells written by different workers are disjoint
+  gGeoManager->SetMaxThreads(nThreads);
+  std::atomic<int> zRow{0};
+  auto worker = [this, ntrPerCell, &zRow]() {
+    TGeoNavigator* nav = gGeoManager->AddNavigator();
+    int iz;
+    while ((iz = zRow.fetch_add(1)) < getNZBins()) {
+      for (int ip = getNPhiBins(); ip--;) {
+        populateFromTGeo(ip, iz, ntrPerCell, nav);
+      }
+    }
+    gGeoManager->RemoveNavigator(nav);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(nThreads);
+  for (int it = 0; it < nThreads; it++) {
+    pool.emplace_back(worker);
+  }
+  for (auto& t : pool) {
+    t.join();
   }
 }
 
 //________________________________________________________________________________
-void MatLayerCyl::populateFromTGeo(int ip, int iz, int ntrPerCell)
+void MatLayerCyl::populateFromTGeo(int ip, int iz, int ntrPerCell, TGeoNavigator* nav)
 {
   /// populate cell with info extracted from TGeometry, using ntrPerCell test tracks per cell
 
@@ -136,7 +168,7 @@ void MatLayerCyl::populateFromTGeo(int ip, int iz, int ntrPerCell)
     float dzt = zs > 0.f ? 0.25 * dz : -0.25 * dz; // to avoid 90 degree polar angle
     for (int isp = ntrPerCell; isp--;) {
       o2::math_utils::sincos(phmn + (isp + 0.5) * getDPhi() / ntrPerCell, sn, cs);
-      auto bud = o2::base::GeometryManager::meanMaterialBudget(rMin * cs, rMin * sn, zs - dzt, rMax * cs, rMax * sn, zs + dzt);
+      auto bud = o2::base::GeometryManager::meanMaterialBudget(rMin * cs, rMin * sn, zs - dzt, rMax * cs, rMax * sn, zs + dzt, nav);
       if (bud.length > 0.) {
         meanRho += bud.length * bud.meanRho;
         meanX2X0 += bud.meanX2X0; // we store actually not X2X0 but 1./X0
@@ -160,8 +192,8 @@ bool MatLayerCyl::canMergePhiSlices(int i, int j, float maxRelDiff, int maxDiffe
   }
   int ndiff = 0; // number of different cells
   for (int iz = getNZBins(); iz--;) {
-    const auto& cellI = getCellPhiBin(i, iz);
-    const auto& cellJ = getCellPhiBin(j, iz);
+    const auto cellI = getCellPhiBinCopy(i, iz);
+    const auto cellJ = getCellPhiBinCopy(j, iz);
     if (cellsDiffer(cellI, cellJ, maxRelDiff)) {
       if (++ndiff > maxDifferent) {
         return false;
@@ -253,6 +285,45 @@ void MatLayerCyl::optimizePhiSlices(float maxRelDiff)
   LOG(info) << "Updated Nslices = " << getNPhiSlices();
 }
 
+//________________________________________________________________________________
+void MatLayerCyl::quantize()
+{
+  // convert the cells to 16-bit values with per-layer decoding scales stored ahead of them,
+  // shrinking the flat buffer in place. To be called as the last construction step, after
+  // the merging of the phi slices: the layer data become read-only.
+  if (isQuantized()) {
+    return;
+  }
+  int nc = getNCells();
+  size_t szNew = MatCellQ::NParams * sizeof(float) + nc * sizeof(MatCellQ);
+  if (szNew > nc * sizeof(MatCell)) { // pathologically small layer, quantization would not shrink it
+    LOG(warn) << "Layer with " << nc << " cells is too small to quantize, keeping float cells";
+    return;
+  }
+  float rhoMax = 0.f, x2x0Max = 0.f;
+  for (int i = nc; i--;) {
+    if (mCells[i].meanRho > rhoMax) {
+      rhoMax = mCells[i].meanRho;
+    }
+    if (mCells[i].meanX2X0 > x2x0Max) {
+      x2x0Max = mCells[i].meanX2X0;
+    }
+  }
+  float rhoV2Q = rhoMax > 0.f ? MatCellQ::QMax / rhoMax : 0.f, x2x0V2Q = x2x0Max > 0.f ? MatCellQ::QMax / x2x0Max : 0.f;
+  std::vector<MatCellQ> tmp(nc);
+  for (int i = nc; i--;) {
+    tmp[i].meanRhoQ = uint16_t(mCells[i].meanRho * rhoV2Q + 0.5f);
+    tmp[i].meanX2X0Q = uint16_t(mCells[i].meanX2X0 * x2x0V2Q + 0.5f);
+  }
+  // the cells array is the last one in the buffer, overwrite it in place: scales first, then the cells
+  float* q2v = reinterpret_cast<float*>(mCells);
+  q2v[0] = rhoMax / MatCellQ::QMax;
+  q2v[1] = x2x0Max / MatCellQ::QMax;
+  std::memcpy(q2v + MatCellQ::NParams, tmp.data(), nc * sizeof(MatCellQ));
+  mQuantized = Quantized16Bit;
+  mFlatBufferSize = estimateFlatBufferSize();
+}
+
 //________________________________________________________________________________
 void MatLayerCyl::getMeanRMS(MatCell& mean, MatCell& rms) const
 {
@@ -261,7 +332,7 @@ void MatLayerCyl::getMeanRMS(MatCell& mean, MatCell& rms) const
   mean.meanX2X0 = rms.meanX2X0 = 0.f;
   for (int ip = getNPhiBins(); ip--;) {
     for (int iz = getNZBins(); iz--;) {
-      const auto& cell = getCellPhiBin(ip, iz);
+      const auto cell = getCellPhiBinCopy(ip, iz);
       mean.meanRho += cell.meanRho;
       mean.meanX2X0 += cell.meanX2X0;
       rms.meanRho += cell.meanRho * cell.meanRho;
@@ -284,8 +355,8 @@ void MatLayerCyl::print(bool data) const
 {
   ///< print layer data
   float szkb = float(getFlatBufferSize()) / 1024;
-  printf("Cyl.Layer %.3f<r<%.3f %+.3f<Z<%+.3f | Nphi: %5d (%d slices) Nz: %5d Size: %.3f KB\n",
-         getRMin(), getRMax(), getZMin(), getZMax(), getNPhiBins(), getNPhiSlices(), getNZBins(), szkb);
+  printf("Cyl.Layer %.3f<r<%.3f %+.3f<Z<%+.3f | Nphi: %5d (%d slices) Nz: %5d Size: %.3f KB%s\n",
+         getRMin(), getRMax(), getZMin(), getZMax(), getNPhiBins(), getNPhiSlices(), getNZBins(), szkb, isQuantized() ? " (quantized)" : "");
   if (!data) {
     return;
   }
@@ -295,7 +366,7 @@ void MatLayerCyl::print(bool data) const
     printf("phi slice: %d (%d bins %d-%d %.4f:%.4f) sn:%+.4f/cs:%+.4f ... [iz/<rho>/<x/x0>] \n",
            ip, nb, ib0, ib1, getDPhi() * ib0, getDPhi() * (ib1 + 1), getSliceSin(ip), getSliceCos(ip));
     for (int iz = 0; iz < getNZBins(); iz++) {
-      auto cell = getCellPhiBin(ib0, iz);
+      auto cell = getCellPhiBinCopy(ib0, iz);
       printf("%3d/%.2e/%.2e ", iz, cell.meanRho, cell.meanX2X0);
       if (((iz + 1) % 5) == 0) {
         printf("\n");
@@ -16,7 +16,9 @@
 
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
 #include "GPUCommonLogger.h"
+#include "DetectorsBase/GeometryManager.h"
 #include <TFile.h>
+#include <memory>
 #include "CommonUtils/TreeStreamRedirector.h"
 //#define _DBG_LOC_ // for local debugging only
 
@@ -69,7 +71,7 @@ void MatLayerCylSet::addLayer(float rmin, float rmax, float zmax, float dz, floa
 }
 
 //________________________________________________________________________________
-void MatLayerCylSet::populateFromTGeo(int ntrPerCell)
+void MatLayerCylSet::populateFromTGeo(int ntrPerCell, int nThreads, const std::string& cacheFile)
 {
   ///< populate layers, using ntrPerCell test tracks per cell
   assert(mConstructionMask == InProgress);
@@ -83,14 +85,114 @@ void MatLayerCylSet::populateFromTGeo(int ntrPerCell)
     LOG(error) << "The LUT is already populated";
     return;
   }
+  std::unique_ptr<TFile> cache;
+  if (!cacheFile.empty()) {
+    cache.reset(TFile::Open(cacheFile.data(), "UPDATE"));
+    if (!cache || cache->IsZombie()) {
+      LOG(warn) << "Failed to open build cache " << cacheFile << ", rasterizing all layers";
+      cache.reset();
+    }
+  }
   for (int i = 0; i < nlr; i++) {
     printf("Populating with %d trials Lr  %3d ", ntrPerCell, i);
     get()->mLayers[i].print();
-    get()->mLayers[i].populateFromTGeo(ntrPerCell);
+    std::vector<float> meta;
+    if (cache) {
+      meta = layerCacheMeta(get()->mLayers[i], ntrPerCell);
+      if (importLayerCells(get()->mLayers[i], *cache, i, meta)) {
+        LOG(info) << "Layer " << i << " unchanged, cells restored from " << cacheFile;
+        continue;
+      }
+    }
+    get()->mLayers[i].populateFromTGeo(ntrPerCell, nThreads);
+    if (cache) {
+      exportLayerCells(get()->mLayers[i], *cache, i, meta);
+    }
+  }
+  if (cache) {
+    cache->Close();
   }
   finalizeStructures();
 }
 
+//________________________________________________________________________________
+std::vector<float> MatLayerCylSet::layerCacheMeta(const MatLayerCyl& lr, int ntrPerCell) const
+{
+  // Cache key of the layer: segmentation parameters plus a material fingerprint, the budgets
+  // of a small deterministic grid of probe rays through the layer. A geometry or alignment
+  // change inside the layer alters the probe budgets, a change leaving every probe ray
+  // identical is assumed to leave the layer unchanged.
+  constexpr int NProbePhi = 16, NProbeZ = 16;
+  std::vector<float> meta;
+  meta.reserve(6 + 2 * NProbePhi * NProbeZ);
+  meta.push_back(lr.getRMin());
+  meta.push_back(lr.getRMax());
+  meta.push_back(lr.getZMax());
+  meta.push_back(lr.getNZBins());
+  meta.push_back(lr.getNPhiBins());
+  meta.push_back(ntrPerCell);
+  float rMin = lr.getRMin(), rMax = lr.getRMax(), dzp = (lr.getZMax() - lr.getZMin()) / NProbeZ;
+  for (int izp = 0; izp < NProbeZ; izp++) {
+    float zs = lr.getZMin() + (izp + 0.5f) * dzp;
+    float dzt = zs > 0.f ? 0.25f * dzp : -0.25f * dzp; // to avoid 90 degree polar angle
+    for (int ipp = 0; ipp < NProbePhi; ipp++) {
+      float sn, cs;
+      o2::math_utils::sincos((ipp + 0.5f) * o2::constants::math::TwoPI / NProbePhi, sn, cs);
+      auto bud = o2::base::GeometryManager::meanMaterialBudget(rMin * cs, rMin * sn, zs - dzt, rMax * cs, rMax * sn, zs + dzt);
+      meta.push_back(bud.meanRho);
+      meta.push_back(bud.meanX2X0);
+    }
+  }
+  return meta;
+}
+
+//________________________________________________________________________________
+bool MatLayerCylSet::importLayerCells(MatLayerCyl& lr, TFile& cache, int il, const std::vector<float>& meta)
+{
+  // restore the cells of the layer from the cache if the stored meta matches the current one
+  std::string nmMeta = "layer" + std::to_string(il) + "_meta", nmCells = "layer" + std::to_string(il) + "_cells";
+  std::unique_ptr<std::vector<float>> oldMeta{reinterpret_cast<std::vector<float>*>(cache.GetObjectChecked(nmMeta.data(), "std::vector<float>"))};
+  if (!oldMeta || oldMeta->size() != meta.size()) {
+    return false;
+  }
+  for (size_t j = 0; j < meta.size(); j++) {
+    if (std::abs((*oldMeta)[j] - meta[j]) > 1e-9 + 1e-6 * std::abs(meta[j])) {
+      return false;
+    }
+  }
+  std::unique_ptr<std::vector<float>> cells{reinterpret_cast<std::vector<float>*>(cache.GetObjectChecked(nmCells.data(), "std::vector<float>"))};
+  if (!cells || cells->size() != 2 * size_t(lr.getNPhiBins()) * lr.getNZBins()) {
+    return false;
+  }
+  const float* src = cells->data();
+  for (int ip = 0; ip < lr.getNPhiBins(); ip++) {
+    for (int iz = 0; iz < lr.getNZBins(); iz++) {
+      auto& cell = lr.getCellPhiBin(ip, iz);
+      cell.meanRho = *src++;
+      cell.meanX2X0 = *src++;
+    }
+  }
+  return true;
+}
+
+//________________________________________________________________________________
+void MatLayerCylSet::exportLayerCells(const MatLayerCyl& lr, TFile& cache, int il, const std::vector<float>& meta)
+{
+  // store the cells of the layer and its meta in the cache
+  std::string nmMeta = "layer" + std::to_string(il) + "_meta", nmCells = "layer" + std::to_string(il) + "_cells";
+  std::vector<float> cells;
+  cells.reserve(2 * size_t(lr.getNPhiBins()) * lr.getNZBins());
+  for (int ip = 0; ip < lr.getNPhiBins(); ip++) {
+    for (int iz = 0; iz < lr.getNZBins(); iz++) {
+      const auto cell = lr.getCellPhiBinCopy(ip, iz);
+      cells.push_back(cell.meanRho);
+      cells.push_back(cell.meanX2X0);
+    }
+  }
+  cache.WriteObjectAny(&meta, "std::vector<float>", nmMeta.data(), "kOverwrite");
+  cache.WriteObjectAny(&cells, "std::vector<float>", nmCells.data(), "kOverwrite");
+}
+
 //________________________________________________________________________________
 void MatLayerCylSet::finalizeStructures()
 {
@@ -147,7 +249,7 @@ void MatLayerCylSet::dumpToTree(const std::string& outName) const
       float x = r * cs, y = r * sn;
       for (int iz = 0; iz < lr.getNZBins(); iz++) {
         float z = 0.5 * (lr.getZBinMin(iz) + lr.getZBinMax(iz));
-        auto cell = lr.getCellPhiBin(ip, iz);
+        auto cell = lr.getCellPhiBinCopy(ip, iz);
         dump << "cell"
              << "ilr=" << i << "r=" << r << "phi=" << phi << "x=" << x << "y=" << y << "z=" << z << "ip=" << ip << "ips=" << ips << "iz=" << iz
              << "mrgnxt=" << merge << "val=" << cell << "\n";
@@ -237,6 +339,17 @@ void MatLayerCylSet::optimizePhiSlices(float maxRelDiff)
   // flatten();  // RS: TODO
 }
 
+//________________________________________________________________________________
+void MatLayerCylSet::quantize()
+{
+  // switch the layers to the compact 16-bit cell representation with per-layer decoding scales,
+  // to be called as the last construction step, after the optimization of the phi slices
+  assert(mConstructionMask == InProgress);
+  for (int i = getNLayers(); i--;) {
+    get()->mLayers[i].quantize();
+  }
+}
+
 //________________________________________________________________________________
 void MatLayerCylSet::print(bool data) const
 {
@@ -286,120 +399,170 @@ GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, floa
     rval.length = ray.getDist();
     return rval;
   }
-  short lrID = lmax;
-  while (lrID >= lmin) { // go from outside to inside
-    const auto& lr = getLayer(lrID);
-    int nphiSlices = lr.getNPhiSlices();
-    int nc = ray.crossLayer(lr); // determines how many crossings this ray has with this tubular layer
-    for (int ic = nc; ic--;) {
-      float cross1, cross2;
-      ray.getCrossParams(ic, cross1, cross2); // tmax,tmin of crossing the layer
-
-      auto phi0 = ray.getPhi(cross1), phi1 = ray.getPhi(cross2), dPhi = phi0 - phi1;
-      auto phiID = lr.getPhiSliceID(phi0), phiIDLast = lr.getPhiSliceID(phi1);
-      // account for eventual wrapping around 0
-      if (dPhi > 0.f) {
-        if (dPhi > o2::constants::math::PI) { // wraps around phi=0
-          phiIDLast += nphiSlices;
-        }
-      } else {
-        if (dPhi < -o2::constants::math::PI) { // wraps around phi=0
-          phiID += nphiSlices;
-        }
-      }
+  for (short lrID = lmax; lrID >= lmin; lrID--) { // go from outside to inside
+    accountLayerCrossings(ray, lrID, rval);
+  }
 
-      int stepPhiID = phiID > phiIDLast ? -1 : 1;
-      bool checkMorePhi = true;
-      auto tStartPhi = cross1, tEndPhi = 0.f;
-      do {
-        // get the path in the current phi slice
-        if (phiID == phiIDLast) {
-          tEndPhi = cross2;
-          checkMorePhi = false;
-        } else { // last phi slice still not reached
-          tEndPhi = ray.crossRadial(lr, (stepPhiID > 0 ? phiID + 1 : phiID) % nphiSlices);
-          if (tEndPhi == Ray::InvalidT) {
-            break; // ray parallel to radial line, abandon check for phi bin change
-          }
-        }
-        auto zID = lr.getZBinID(ray.getZ(tStartPhi));
-        auto zIDLast = lr.getZBinID(ray.getZ(tEndPhi));
-        // check if Zbins are crossed
+  if (rval.length != 0.f) {
+    rval.meanRho /= rval.length;    // average
+    rval.meanX2X0 *= ray.getDist(); // normalize
+  }
+  rval.length = ray.getDist();
 
 #ifdef _DBG_LOC_
-        printf("-- Zdiff (%3d : %3d) mode: t: %+e %+e\n", zID, zIDLast, tStartPhi, tEndPhi);
+  printf("<rho> = %e, x2X0 = %e  | step = %e\n", rval.meanRho, rval.meanX2X0, rval.length);
 #endif
+  return rval;
+}
 
-        if (zID != zIDLast) {
-          auto stepZID = zID < zIDLast ? 1 : -1;
-          bool checkMoreZ = true;
-          auto tStartZ = tStartPhi, tEndZ = 0.f;
-          do {
-            if (zID == zIDLast) {
-              tEndZ = tEndPhi;
-              checkMoreZ = false;
-            } else {
-              tEndZ = ray.crossZ(lr.getZBinMin(stepZID > 0 ? zID + 1 : zID));
-              if (tEndZ == Ray::InvalidT) { // track normal to Z axis, abandon Zbin change test
-                break;
-              }
-            }
-            // account materials of this step
-            float step = tEndZ > tStartZ ? tEndZ - tStartZ : tStartZ - tEndZ; // the real step is ray.getDist(tEnd-tStart), will rescale all later
-            const auto& cell = lr.getCell(phiID % nphiSlices, zID);
-            rval.meanRho += cell.meanRho * step;
-            rval.meanX2X0 += cell.meanX2X0 * step;
-            rval.length += step;
+#ifndef GPUCA_ALIGPUCODE
+//_________________________________________________________________________________________________
+void MatLayerCylSet::getMatBudget(int nRays, Ray* rays, MatBudget* budgets) const
+{
+  // Batched version of getMatBudget: the rays of the batch are processed layer-major, i.e. every
+  // layer is accounted for all rays crossing it before moving to the next one, so that its tables
+  // stay cached across the batch instead of being revisited once per ray.
+  constexpr int ChunkSize = 64;
+  short lmin[ChunkSize], lmax[ChunkSize];
+  for (int first = 0; first < nRays; first += ChunkSize) {
+    int n = nRays - first < ChunkSize ? nRays - first : ChunkSize;
+    short lminTot = getNLayers(), lmaxTot = -1;
+    for (int i = 0; i < n; i++) {
+      budgets[first + i] = MatBudget();
+      if (rays[first + i].isTooShort() || !getLayersRange(rays[first + i], lmin[i], lmax[i])) {
+        lmin[i] = 0;
+        lmax[i] = -1; // empty layers range
+        continue;
+      }
+      if (lmin[i] < lminTot) {
+        lminTot = lmin[i];
+      }
+      if (lmax[i] > lmaxTot) {
+        lmaxTot = lmax[i];
+      }
+    }
+    for (short lrID = lmaxTot; lrID >= lminTot; lrID--) { // go from outside to inside
+      for (int i = 0; i < n; i++) {
+        if (lrID <= lmax[i] && lrID >= lmin[i]) {
+          accountLayerCrossings(rays[first + i], lrID, budgets[first + i]);
+        }
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      auto& rval = budgets[first + i];
+      if (rval.length != 0.f) {
+        rval.meanRho /= rval.length;              // average
+        rval.meanX2X0 *= rays[first + i].getDist(); // normalize
+      }
+      rval.length = rays[first + i].getDist();
+    }
+  }
+}
+#endif // !GPUCA_ALIGPUCODE
+
+//_________________________________________________________________________________________________
+GPUd() void MatLayerCylSet::accountLayerCrossings(Ray& ray, short lrID, MatBudget& rval) const
+{
+  // account in the budget the material seen by the ray on all its crossings with given layer
+  const auto& lr = getLayer(lrID);
+  int nphiSlices = lr.getNPhiSlices();
+  int nc = ray.crossLayer(lr); // determines how many crossings this ray has with this tubular layer
+  for (int ic = nc; ic--;) {
+    float cross1, cross2;
+    ray.getCrossParams(ic, cross1, cross2); // tmax,tmin of crossing the layer
+
+    auto phi0 = ray.getPhi(cross1), phi1 = ray.getPhi(cross2), dPhi = phi0 - phi1;
+    auto phiID = lr.getPhiSliceID(phi0), phiIDLast = lr.getPhiSliceID(phi1);
+    // account for eventual wrapping around 0
+    if (dPhi > 0.f) {
+      if (dPhi > o2::constants::math::PI) { // wraps around phi=0
+        phiIDLast += nphiSlices;
+      }
+    } else {
+      if (dPhi < -o2::constants::math::PI) { // wraps around phi=0
+        phiID += nphiSlices;
+      }
+    }
+
+    int stepPhiID = phiID > phiIDLast ? -1 : 1;
+    bool checkMorePhi = true;
+    auto tStartPhi = cross1, tEndPhi = 0.f;
+    do {
+      // get the path in the current phi slice
+      if (phiID == phiIDLast) {
+        tEndPhi = cross2;
+        checkMorePhi = false;
+      } else { // last phi slice still not reached
+        tEndPhi = ray.crossRadial(lr, (stepPhiID > 0 ? phiID + 1 : phiID) % nphiSlices);
+        if (tEndPhi == Ray::InvalidT) {
+          break; // ray parallel to radial line, abandon check for phi bin change
+        }
+      }
+      auto zID = lr.getZBinID(ray.getZ(tStartPhi));
+      auto zIDLast = lr.getZBinID(ray.getZ(tEndPhi));
+      // check if Zbins are crossed
 
 #ifdef _DBG_LOC_
-            float pos0[3] = {ray.getPos(tStartZ, 0), ray.getPos(tStartZ, 1), ray.getPos(tStartZ, 2)};
-            float pos1[3] = {ray.getPos(tEndZ, 0), ray.getPos(tEndZ, 1), ray.getPos(tEndZ, 2)};
-            printf(
-              "Lr#%3d / cross#%d : account %f<t<%f at phiSlice %d | Zbin: %3d (%3d) |[%+e %+e +%e]:[%+e %+e %+e] "
-              "Step: %.3e StrpCor: %.3e\n",
-              lrID, ic, tEndZ, tStartZ, phiID % nphiSlices, zID, zIDLast,
-              pos0[0], pos0[1], pos0[2], pos1[0], pos1[1], pos1[2], step, ray.getDist(step));
+      printf("-- Zdiff (%3d : %3d) mode: t: %+e %+e\n", zID, zIDLast, tStartPhi, tEndPhi);
 #endif
 
-            tStartZ = tEndZ;
-            zID += stepZID;
-          } while (checkMoreZ);
-        } else {
-          float step = tEndPhi > tStartPhi ? tEndPhi - tStartPhi : tStartPhi - tEndPhi; // the real step is |ray.getDist(tEnd-tStart)|, will rescale all later
-          const auto& cell = lr.getCell(phiID % nphiSlices, zID);
+      if (zID != zIDLast) {
+        auto stepZID = zID < zIDLast ? 1 : -1;
+        bool checkMoreZ = true;
+        auto tStartZ = tStartPhi, tEndZ = 0.f;
+        do {
+          if (zID == zIDLast) {
+            tEndZ = tEndPhi;
+            checkMoreZ = false;
+          } else {
+            tEndZ = ray.crossZ(lr.getZBinMin(stepZID > 0 ? zID + 1 : zID));
+            if (tEndZ == Ray::InvalidT) { // track normal to Z axis, abandon Zbin change test
+              break;
+            }
+          }
+          // account materials of this step
+          float step = tEndZ > tStartZ ? tEndZ - tStartZ : tStartZ - tEndZ; // the real step is ray.getDist(tEnd-tStart), will rescale all later
+          const auto cell = lr.getCellCopy(phiID % nphiSlices, zID);
           rval.meanRho += cell.meanRho * step;
           rval.meanX2X0 += cell.meanX2X0 * step;
           rval.length += step;
 
 #ifdef _DBG_LOC_
-          float pos0[3] = {ray.getPos(tStartPhi, 0), ray.getPos(tStartPhi, 1), ray.getPos(tStartPhi, 2)};
-          float pos1[3] = {ray.getPos(tEndPhi, 0), ray.getPos(tEndPhi, 1), ray.getPos(tEndPhi, 2)};
+          float pos0[3] = {ray.getPos(tStartZ, 0), ray.getPos(tStartZ, 1), ray.getPos(tStartZ, 2)};
+          float pos1[3] = {ray.getPos(tEndZ, 0), ray.getPos(tEndZ, 1), ray.getPos(tEndZ, 2)};
           printf(
-            "Lr#%3d / cross#%d : account %f<t<%f at phiSlice %d | Zbin: %3d ----- |[%+e %+e +%e]:[%+e %+e %+e]"
+            "Lr#%3d / cross#%d : account %f<t<%f at phiSlice %d | Zbin: %3d (%3d) |[%+e %+e +%e]:[%+e %+e %+e] "
             "Step: %.3e StrpCor: %.3e\n",
-            lrID, ic, tEndPhi, tStartPhi, phiID % nphiSlices, zID,
+            lrID, ic, tEndZ, tStartZ, phiID % nphiSlices, zID, zIDLast,
             pos0[0], pos0[1], pos0[2], pos1[0], pos1[1], pos1[2], step, ray.getDist(step));
 #endif
-        }
-        //
-        tStartPhi = tEndPhi;
-        phiID += stepPhiID;
-
-      } while (checkMorePhi);
-    }
-    lrID--;
-  } // loop over layers
 
-  if (rval.length != 0.f) {
-    rval.meanRho /= rval.length;                                       // average
-    rval.meanX2X0 *= ray.getDist();                                    // normalize
-  }
-  rval.length = ray.getDist();
+          tStartZ = tEndZ;
+          zID += stepZID;
+        } while (checkMoreZ);
+      } else {
+        float step = tEndPhi > tStartPhi ? tEndPhi - tStartPhi : tStartPhi - tEndPhi; // the real step is |ray.getDist(tEnd-tStart)|, will rescale all later
+        const auto cell = lr.getCellCopy(phiID % nphiSlices, zID);
+        rval.meanRho += cell.meanRho * step;
+        rval.meanX2X0 += cell.meanX2X0 * step;
+        rval.length += step;
 
 #ifdef _DBG_LOC_
-  printf("<rho> = %e, x2X0 = %e  | step = %e\n", rval.meanRho, rval.meanX2X0, rval.length);
+        float pos0[3] = {ray.getPos(tStartPhi, 0), ray.getPos(tStartPhi, 1), ray.getPos(tStartPhi, 2)};
+        float pos1[3] = {ray.getPos(tEndPhi, 0), ray.getPos(tEndPhi, 1), ray.getPos(tEndPhi, 2)};
+        printf(
+          "Lr#%3d / cross#%d : account %f<t<%f at phiSlice %d | Zbin: %3d ----- |[%+e %+e +%e]:[%+e %+e %+e]"
+          "Step: %.3e StrpCor: %.3e\n",
+          lrID, ic, tEndPhi, tStartPhi, phiID % nphiSlices, zID,
+          pos0[0], pos0[1], pos0[2], pos1[0], pos1[1], pos1[2], step, ray.getDist(step));
 #endif
-  return rval;
+      }
+      //
+      tStartPhi = tEndPhi;
+      phiID += stepPhiID;
+
+    } while (checkMorePhi);
+  }
 }
 
 //_________________________________________________________________________________________________
@@ -599,7 +762,7 @@ MatLayerCylSet* MatLayerCylSet::extractCopy(float rmin, float rmax, float tolera
     auto& lrNew = copy->getLayer(lrCount);
     for (int iz = 0; iz < lrNew.getNZBins(); iz++) {
       for (int ip = 0; ip < lrNew.getNPhiBins(); ip++) {
-        lrNew.getCellPhiBin(ip, iz).set(lr.getCellPhiBin(ip, iz));
+        lrNew.getCellPhiBin(ip, iz).set(lr.getCellPhiBinCopy(ip, iz));
       }
     }
     lrCount++;
@@ -607,6 +770,9 @@ MatLayerCylSet* MatLayerCylSet::extractCopy(float rmin, float rmax, float tolera
 
   copy->finalizeStructures();
   copy->optimizePhiSlices(tolerance);
+  if (isQuantized()) {
+    copy->quantize();
+  }
   copy->flatten();
   return copy;
 }
@@ -22,6 +22,8 @@ using namespace o2::gpu;
 
 #if !defined(GPUCA_GPUCODE)
 #include "Field/MagFieldFast.h" // Don't use this on the GPU
+#include <type_traits>
+#include <vector>
 #endif
 
 #if !defined(GPUCA_STANDALONE) && !defined(GPUCA_GPUCODE)
@@ -148,11 +150,157 @@ PropagatorImpl<value_T>::PropagatorImpl(bool uninitialized)
 } // empty dummy constructor for standalone benchmark
 #endif
 
+#ifndef GPUCA_GPUCODE
+//_______________________________________________________________________
+template <typename value_T>
+template <typename track_T, typename PropagatorImpl<value_T>::MatCorrType matCorrT, typename PropagatorImpl<value_T>::FieldKind fieldT>
+bool PropagatorImpl<value_T>::propagateToXImpl(track_T& track, value_type xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
+                                               track::TrackLTIntegral* tofInfo, int signCorr) const
+{
+  //----------------------------------------------------------------
+  //
+  // Single body behind the scalar propagateToX / PropagateToXBxByBz host versions below:
+  // the material treatment and the field access are compile-time parameters, so the
+  // stepping loop is free of the per-step dispatch the generic versions pay. With
+  // billions of steps per pass these branches are a measurable fraction of the loop.
+  //
+  //----------------------------------------------------------------
+  constexpr bool withCov = std::is_same_v<track_T, TrackParCov_t>;
+  auto dx = xToGo - track.getX();
+  int dir = dx > 0.f ? 1 : -1;
+  if (!signCorr) {
+    signCorr = -dir; // sign of eloss correction is not imposed
+  }
+
+  gpu::gpustd::array<value_type, 3> b{0.f, 0.f, bZ};
+  while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
+    auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
+    if (dir < 0) {
+      step = -step;
+    }
+    auto x = track.getX() + step;
+    auto xyz0 = track.getXYZGlo();
+    if constexpr (fieldT == FieldKind::FastField) {
+      mFieldFast->Field(xyz0, &b[0]);
+    } else if constexpr (fieldT == FieldKind::AnyField) {
+      getFieldXYZ(xyz0, &b[0]);
+    }
+
+    auto correct = [&track, &xyz0, tofInfo, signCorr, this]() {
+      bool res = true;
+      if constexpr (matCorrT != MatCorrType::USEMatCorrNONE) {
+        auto xyz1 = track.getXYZGlo();
+        MatBudget mb;
+        if constexpr (matCorrT == MatCorrType::USEMatCorrLUT) {
+          mb = mMatLUT->getMatBudget(xyz0.X(), xyz0.Y(), xyz0.Z(), xyz1.X(), xyz1.Y(), xyz1.Z());
+        } else {
+#if !defined(GPUCA_STANDALONE)
+          mb = GeometryManager::meanMaterialBudget(xyz0, xyz1);
+#endif
+        }
+        if constexpr (withCov) {
+          res = track.correctForMaterial(mb.meanX2X0, mb.getXRho(signCorr));
+        } else {
+          res = track.correctForELoss(mb.getXRho(signCorr));
+        }
+        if (tofInfo) {
+          tofInfo->addStep(mb.length, track.getP2Inv()); // fill L,ToF info using already calculated step length
+          tofInfo->addX2X0(mb.meanX2X0);
+          tofInfo->addXRho(mb.getXRho(signCorr));
+        }
+      } else if (tofInfo) { // if tofInfo filling was requested w/o material correction, we need to calculate the step lenght
+        auto xyz1 = track.getXYZGlo();
+        math_utils::Vector3D<value_type> stepV(xyz1.X() - xyz0.X(), xyz1.Y() - xyz0.Y(), xyz1.Z() - xyz0.Z());
+        tofInfo->addStep(stepV.R(), track.getP2Inv());
+      }
+      return res;
+    };
+
+    bool stepOK;
+    if constexpr (withCov) {
+      if constexpr (fieldT == FieldKind::UniformBz) {
+        stepOK = track.propagateTo(x, bZ);
+      } else {
+        stepOK = track.propagateTo(x, b);
+      }
+    } else {
+      if constexpr (fieldT == FieldKind::UniformBz) {
+        stepOK = track.propagateParamTo(x, bZ);
+      } else {
+        stepOK = track.propagateParamTo(x, b);
+      }
+    }
+    if (!stepOK) {
+      return false;
+    }
+    if (maxSnp > 0 && math_utils::detail::abs<value_type>(track.getSnp()) >= maxSnp) {
+      correct();
+      return false;
+    }
+    if (!correct()) {
+      return false;
+    }
+    dx = xToGo - track.getX();
+  }
+  track.setX(xToGo);
+  return true;
+}
+
+//_______________________________________________________________________
+template <typename value_T>
+template <typename track_T, typename PropagatorImpl<value_T>::MatCorrType matCorrT>
+bool PropagatorImpl<value_T>::propagateToXFieldDispatch(track_T& track, value_type xToGo, value_type bZ, bool bzOnly, value_type maxSnp, value_type maxStep,
+                                                        track::TrackLTIntegral* tofInfo, int signCorr) const
+{
+  // select the field access variant of the specialized loop
+  if (bzOnly) {
+    return propagateToXImpl<track_T, matCorrT, FieldKind::UniformBz>(track, xToGo, bZ, maxSnp, maxStep, tofInfo, signCorr);
+  }
+  if (!mGPUField && mFieldFast) {
+    return propagateToXImpl<track_T, matCorrT, FieldKind::FastField>(track, xToGo, bZ, maxSnp, maxStep, tofInfo, signCorr);
+  }
+  return propagateToXImpl<track_T, matCorrT, FieldKind::AnyField>(track, xToGo, bZ, maxSnp, maxStep, tofInfo, signCorr);
+}
+
+//_______________________________________________________________________
+template <typename value_T>
+template <typename track_T>
+bool PropagatorImpl<value_T>::propagateToXDispatch(track_T& track, value_type xToGo, value_type bZ, bool bzOnly, value_type maxSnp, value_type maxStep,
+                                                   MatCorrType matCorr, track::TrackLTIntegral* tofInfo, int signCorr) const
+{
+  // map the runtime material option to its compile-time instantiation; the LUT availability
+  // check and the eventual fall-back to TGeo are resolved here instead of once per step
+#if !defined(GPUCA_STANDALONE)
+  if (matCorr == MatCorrType::USEMatCorrLUT && !mMatLUT) {
+    if (!mTGeoFallBackAllowed) {
+      throw std::runtime_error("requested MatLUT is absent and fall-back to TGeo is disabled");
+    }
+    matCorr = MatCorrType::USEMatCorrTGeo;
+  }
+#else
+  if (matCorr == MatCorrType::USEMatCorrTGeo) {
+    matCorr = MatCorrType::USEMatCorrLUT; // no TGeo in the standalone benchmark
+  }
+#endif
+  switch (matCorr) {
+    case MatCorrType::USEMatCorrNONE:
+      return propagateToXFieldDispatch<track_T, MatCorrType::USEMatCorrNONE>(track, xToGo, bZ, bzOnly, maxSnp, maxStep, tofInfo, signCorr);
+    case MatCorrType::USEMatCorrTGeo:
+      return propagateToXFieldDispatch<track_T, MatCorrType::USEMatCorrTGeo>(track, xToGo, bZ, bzOnly, maxSnp, maxStep, tofInfo, signCorr);
+    default:
+      return propagateToXFieldDispatch<track_T, MatCorrType::USEMatCorrLUT>(track, xToGo, bZ, bzOnly, maxSnp, maxStep, tofInfo, signCorr);
+  }
+}
+#endif // !GPUCA_GPUCODE
+
 //_______________________________________________________________________
 template <typename value_T>
 GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackParCov_t& track, value_type xToGo, value_type maxSnp, value_type maxStep,
                                                         PropagatorImpl<value_T>::MatCorrType matCorr, track::TrackLTIntegral* tofInfo, int signCorr) const
 {
+#ifndef GPUCA_GPUCODE
+  return propagateToXDispatch(track, xToGo, getNominalBz(), false, maxSnp, maxStep, matCorr, tofInfo, signCorr);
+#else
   //----------------------------------------------------------------
   //
   // Propagates the track to the plane X=xk (cm)
@@ -215,13 +363,152 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackParCov_t& track, va
   }
   track.setX(xToGo);
   return true;
+#endif // GPUCA_GPUCODE
 }
 
+#ifndef GPUCA_GPUCODE
+//_______________________________________________________________________
+template <typename value_T>
+int PropagatorImpl<value_T>::PropagateToXBxByBz(int nTracks, TrackParCov_t* tracks, const value_type* xToGo, uint8_t* status,
+                                                value_type maxSnp, value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr,
+                                                track::TrackLTIntegral* tofInfo, int signCorr) const
+{
+  //----------------------------------------------------------------
+  //
+  // Batched version of the scalar PropagateToXBxByBz above: the tracks with non-zero status are
+  // advanced in lockstep, so that the field of all tracks sharing a step is evaluated in a single
+  // structure-of-arrays pass and their material budgets are obtained with a single layer-major query
+  // of the material LUT instead of track by track scalar queries. Tracks which diverge (fail or
+  // reach their target) are compacted out of the active batch.
+  //
+  // status   - in: non-zero for the tracks to process, out: 1 for tracks which reached their xToGo, 0 otherwise
+  // tofInfo  - optional array of nTracks containers for track length and PID-dependent TOF integration
+  //----------------------------------------------------------------
+  std::vector<int8_t> snpFail, stepOK;
+  std::vector<int8_t> signC(nTracks);
+  std::vector<int> active; // indices of the tracks still being stepped, compacted on divergence
+  std::vector<int> rayOf;  // entry of the track's step in the rays batch, -1 if none
+  std::vector<math_utils::Point3D<value_type>> xyz0;
+  std::vector<value_type> bvals;
+  std::vector<Ray> rays;
+  std::vector<MatBudget> budgets;
+#ifndef GPUCA_ALIGPUCODE
+  const bool batchLUT = matCorr == MatCorrType::USEMatCorrLUT && mMatLUT;
+#else
+  constexpr bool batchLUT = false; // the batched LUT query is not compiled in the standalone build
+#endif
+  int nReached = 0;
+  active.reserve(nTracks);
+  for (int i = 0; i < nTracks; i++) {
+    if (!status[i]) {
+      continue;
+    }
+    signC[i] = signCorr ? signCorr : (xToGo[i] > tracks[i].getX() ? -1 : 1); // sign of eloss correction is not imposed
+    active.push_back(i);
+  }
+  while (true) {
+    // retire the tracks which reached their target, compacting the active list
+    int nAct = 0;
+    for (int i : active) {
+      auto dx = xToGo[i] - tracks[i].getX();
+      if (math_utils::detail::abs<value_type>(dx) <= Epsilon) {
+        tracks[i].setX(xToGo[i]);
+        status[i] = 1;
+        nReached++;
+      } else {
+        active[nAct++] = i;
+      }
+    }
+    active.resize(nAct);
+    if (!nAct) {
+      break;
+    }
+    // gather the start points and evaluate the field of all active tracks in a single pass
+    xyz0.resize(nAct);
+    bvals.resize(3 * nAct);
+    for (int j = 0; j < nAct; j++) {
+      xyz0[j] = tracks[active[j]].getXYZGlo();
+    }
+    getFieldXYZ(nAct, xyz0.data(), bvals.data());
+    // advance all active tracks by one step, collecting the material queries
+    rays.clear();
+    rayOf.resize(nAct);
+    snpFail.resize(nAct);
+    stepOK.resize(nAct);
+    for (int j = 0; j < nAct; j++) {
+      int i = active[j];
+      auto& track = tracks[i];
+      auto dx = xToGo[i] - track.getX();
+      auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
+      if (dx < 0.f) {
+        step = -step;
+      }
+      gpu::gpustd::array<value_type, 3> b{bvals[3 * j], bvals[3 * j + 1], bvals[3 * j + 2]};
+      rayOf[j] = -1;
+      snpFail[j] = false;
+      stepOK[j] = track.propagateTo(track.getX() + step, b);
+      if (!stepOK[j]) {
+        status[i] = 0;
+        continue;
+      }
+      snpFail[j] = maxSnp > 0 && math_utils::detail::abs<value_type>(track.getSnp()) >= maxSnp;
+      if (batchLUT && matCorr != MatCorrType::USEMatCorrNONE) {
+        auto xyz1 = track.getXYZGlo();
+        rayOf[j] = rays.size();
+        rays.emplace_back(xyz0[j].X(), xyz0[j].Y(), xyz0[j].Z(), xyz1.X(), xyz1.Y(), xyz1.Z());
+      }
+    }
+#ifndef GPUCA_ALIGPUCODE
+    if (!rays.empty()) {
+      budgets.resize(rays.size());
+      mMatLUT->getMatBudget((int)rays.size(), rays.data(), budgets.data());
+    }
+#endif
+    // apply the material corrections and conclude the step, keeping only the survivors active
+    int nKeep = 0;
+    for (int j = 0; j < nAct; j++) {
+      int i = active[j];
+      if (!stepOK[j]) {
+        continue;
+      }
+      auto& track = tracks[i];
+      bool res = true;
+      if (matCorr != MatCorrType::USEMatCorrNONE) {
+        auto xyz1 = track.getXYZGlo();
+        auto mb = rayOf[j] >= 0 ? budgets[rayOf[j]] : this->getMatBudget(matCorr, xyz0[j], xyz1);
+        if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(signC[i]))) {
+          res = false;
+        }
+        if (tofInfo) {
+          tofInfo[i].addStep(mb.length, track.getP2Inv()); // fill L,ToF info using already calculated step length
+          tofInfo[i].addX2X0(mb.meanX2X0);
+          tofInfo[i].addXRho(mb.getXRho(signC[i]));
+        }
+      } else if (tofInfo) { // if tofInfo filling was requested w/o material correction, we need to calculate the step lenght
+        auto xyz1 = track.getXYZGlo();
+        math_utils::Vector3D<value_type> stepV(xyz1.X() - xyz0[j].X(), xyz1.Y() - xyz0[j].Y(), xyz1.Z() - xyz0[j].Z());
+        tofInfo[i].addStep(stepV.R(), track.getP2Inv());
+      }
+      if (snpFail[j] || !res) { // as in the scalar version, the correction of the last step is applied before giving up
+        status[i] = 0;
+      } else {
+        active[nKeep++] = i;
+      }
+    }
+    active.resize(nKeep);
+  }
+  return nReached;
+}
+#endif // !GPUCA_GPUCODE
+
 //_______________________________________________________________________
 template <typename value_T>
 GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackPar_t& track, value_type xToGo, value_type maxSnp, value_type maxStep,
                                                         PropagatorImpl<value_T>::MatCorrType matCorr, track::TrackLTIntegral* tofInfo, int signCorr) const
 {
+#ifndef GPUCA_GPUCODE
+  return propagateToXDispatch(track, xToGo, getNominalBz(), false, maxSnp, maxStep, matCorr, tofInfo, signCorr);
+#else
   //----------------------------------------------------------------
   //
   // Propagates the track params to the plane X=xk (cm), NO error evaluation
@@ -284,6 +571,7 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackPar_t& track, value
   }
   track.setX(xToGo);
   return true;
+#endif // GPUCA_GPUCODE
 }
 
 //_______________________________________________________________________
@@ -291,6 +579,9 @@ template <typename value_T>
 GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackParCov_t& track, value_type xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
                                                   PropagatorImpl<value_T>::MatCorrType matCorr, track::TrackLTIntegral* tofInfo, int signCorr) const
 {
+#ifndef GPUCA_GPUCODE
+  return propagateToXDispatch(track, xToGo, bZ, true, maxSnp, maxStep, matCorr, tofInfo, signCorr);
+#else
   //----------------------------------------------------------------
   //
   // Propagates the track to the plane X=xk (cm)
@@ -349,6 +640,7 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackParCov_t& track, value_ty
   }
   track.setX(xToGo);
   return true;
+#endif // GPUCA_GPUCODE
 }
 
 //_______________________________________________________________________
@@ -356,6 +648,9 @@ template <typename value_T>
 GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
                                                   PropagatorImpl<value_T>::MatCorrType matCorr, track::TrackLTIntegral* tofInfo, int signCorr) const
 {
+#ifndef GPUCA_GPUCODE
+  return propagateToXDispatch(track, xToGo, bZ, true, maxSnp, maxStep, matCorr, tofInfo, signCorr);
+#else
   //----------------------------------------------------------------
   //
   // Propagates the track parameters only to the plane X=xk (cm)
@@ -416,6 +711,7 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type
   }
   track.setX(xToGo);
   return true;
+#endif // GPUCA_GPUCODE
 }
 
 //_______________________________________________________________________
@@ -784,6 +1080,24 @@ GPUd() void PropagatorImpl<value_T>::getFieldXYZ(const math_utils::Point3D<doubl
   getFieldXYZImpl<double>(xyz, bxyz);
 }
 
+#ifndef GPUCA_GPUCODE
+template <typename value_T>
+void PropagatorImpl<value_T>::getFieldXYZ(int nPts, const math_utils::Point3D<value_type>* xyz, value_type* bxyz) const
+{
+  // batched version: resolve the dispatch to the field implementation once per batch, so that
+  // the fast field polynomials are evaluated in a tight loop over the points
+  if (!mGPUField && mFieldFast) {
+    for (int i = 0; i < nPts; i++) {
+      mFieldFast->Field(xyz[i], bxyz + 3 * i);
+    }
+  } else {
+    for (int i = 0; i < nPts; i++) {
+      getFieldXYZ(xyz[i], bxyz + 3 * i);
+    }
+  }
+}
+#endif
+
 namespace o2::base
 {
 #if !defined(GPUCA_GPUCODE) || defined(GPUCA_GPUCODE_DEVICE) // FIXME: DR: WORKAROUND to avoid CUDA bug creating host symbols for device code.
@@ -239,7 +239,10 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
     // while the particle will still be treated as a primary given its bit settings
     p.SetUniqueID(proc2);
 
-    mIndexMap[trackId] = trackId;
+    if (!mPrimariesOnlyMode) {
+      // the mapping is the identity for primaries; in primaries-only mode it stays implicit
+      mIndexMap[trackId] = trackId;
+    }
     p.SetBit(ParticleStatus::kKeep, 1);
     if (p.TestBit(ParticleStatus::kToBeDone)) {
       mNumberOfPrimariesforTracking++;
@@ -251,7 +254,9 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
     mParticles.emplace_back(p);
     mCurrentParticle0 = p;
   }
-  mStack.push(p);
+  if (!mPrimariesOnlyMode) {
+    mStack.push(p);
+  }
 }
 
 void Stack::handleTransportPrimary(TParticle& p)
@@ -277,19 +282,53 @@ void Stack::PushTrack(int toBeDone, TParticle& p)
   //
   // - during parallel simulation to push primary particles (called by the stack itself)
   if (p.TestBit(ParticleStatus::kPrimary)) {
-    // one to one mapping for primaries
-    mIndexMap[mNumberOfPrimaryParticles] = mNumberOfPrimaryParticles;
+    if (!mPrimariesOnlyMode) {
+      // one to one mapping for primaries
+      mIndexMap[mNumberOfPrimaryParticles] = mNumberOfPrimaryParticles;
+    }
     mNumberOfPrimaryParticles++;
     mPrimaryParticles.push_back(p);
     // Push particle on the stack
     if (p.TestBit(ParticleStatus::kToBeDone)) {
       mNumberOfPrimariesforTracking++;
     }
-    mStack.push(p);
+    if (!mPrimariesOnlyMode) {
+      mStack.push(p);
+    }
     mTracks->emplace_back(p);
   }
 }
 
+void Stack::initFromPrimariesPooled(std::vector<TParticle>& primaries)
+{
+  // capacity-preserving reset: the vector buffers stay allocated across events
+  // and neither the transport stack nor the index map are touched in this mode
+  mIndexOfCurrentTrack = -1;
+  mNumberOfPrimariesforTracking = 0;
+  mNumberOfPrimariesPopped = 0;
+  mPrimariesDone = 0;
+  mPrimaryPopCursor = 0;
+  mHitCounter = 0;
+  mPrimaryParticles.clear();
+  mParticles.clear();
+  mTracks->clear();
+  mTrackRefs->clear();
+  mTrackIDtoParticlesEntry.clear();
+
+  // batch injection of the primaries
+  mPrimaryParticles.reserve(primaries.size());
+  mTracks->reserve(primaries.size());
+  for (auto& p : primaries) {
+    if (p.TestBit(ParticleStatus::kToBeDone)) {
+      mNumberOfPrimariesforTracking++;
+    }
+    mTracks->emplace_back(p);
+  }
+  mPrimaryParticles.insert(mPrimaryParticles.end(), primaries.begin(), primaries.end());
+  mNumberOfPrimaryParticles = (int)(primaries.size());
+  mNumberOfEntriesInParticles = mNumberOfPrimaryParticles;
+}
+
 /// Set the current track number
 /// Declared in TVirtualMCStack
 /// \param iTrack track number
@@ -329,6 +368,24 @@ ULong_t getHash(TParticle const& p)
 
 TParticle* Stack::PopNextTrack(Int_t& iTrack)
 {
+  if (mPrimariesOnlyMode) {
+    // serve the to-be-done primaries directly from the primary buffer
+    // (nothing was put on the transport stack in this mode)
+    while (mPrimaryPopCursor < (Int_t)(mPrimaryParticles.size())) {
+      auto& p = mPrimaryParticles[mPrimaryPopCursor];
+      mIndexOfCurrentPrimary = mPrimaryPopCursor;
+      mIndexOfCurrentTrack = mPrimaryPopCursor;
+      ++mPrimaryPopCursor;
+      if (p.TestBit(ParticleStatus::kToBeDone)) {
+        mNumberOfPrimariesPopped++;
+        mCurrentParticle = p;
+        iTrack = mIndexOfCurrentTrack;
+        return &mCurrentParticle;
+      }
+    }
+    iTrack = -1;
+    return nullptr;
+  }
 
   // This functions is mainly used by Geant3?
   Int_t nprod = (int)(mParticles.size());
@@ -595,13 +652,14 @@ void Stack::Reset()
   }
   mParticles.clear();
   mTracks->clear();
-  if (!mIsExternalMode && (mPrimariesDone != mNumberOfPrimariesforTracking)) {
+  if (!mIsExternalMode && !mPrimariesOnlyMode && (mPrimariesDone != mNumberOfPrimariesforTracking)) {
     LOG(fatal) << "Inconsistency in primary particles treated " << mPrimariesDone << " vs expected "
                << mNumberOfPrimariesforTracking << "\n(This points to a flaw in the stack logic)";
   }
   mPrimariesDone = 0;
   mNumberOfPrimariesforTracking = 0;
   mNumberOfPrimariesPopped = 0;
+  mPrimaryPopCursor = 0;
   mPrimaryParticles.clear();
   mTrackRefs->clear();
   mTrackIDtoParticlesEntry.clear();
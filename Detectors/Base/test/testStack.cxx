@@ -44,3 +44,37 @@ BOOST_AUTO_TEST_CASE(Stack_test)
     BOOST_CHECK(inst->getPrimaries().size() == 2);
   }
 }
+
+// check the pooled primaries-only mode used for generator-level productions
+BOOST_AUTO_TEST_CASE(Stack_primariesonly_test)
+{
+  o2::data::Stack st;
+  st.setExternalMode(true);
+  st.setPrimariesOnlyMode(true);
+  int a;
+  TMCProcess proc{kPPrimary};
+  st.PushTrack(1, -1, 0, 0, 0., 0., 10., 5., 5., 5., 0.1, 0., 0., 0., proc, a, 1., 1);
+  st.PushTrack(1, -1, 0, 0, 0., 0., 10., 5., 5., 5., 0.1, 0., 0., 0., proc, a, 1., 1);
+  BOOST_CHECK_EQUAL(st.getPrimaries().size(), 2);
+
+  // primaries are served directly from the primary buffer
+  Int_t itrack = -1;
+  int npopped = 0;
+  while (st.PopNextTrack(itrack)) {
+    BOOST_CHECK_EQUAL(itrack, npopped);
+    npopped++;
+  }
+  BOOST_CHECK_EQUAL(npopped, 2);
+
+  // batch re-initialization for a next event
+  auto primaries = st.getPrimaries();
+  primaries.pop_back();
+  st.initFromPrimaries(primaries);
+  BOOST_CHECK_EQUAL(st.getPrimaries().size(), 1);
+  BOOST_CHECK_EQUAL(st.GetNprimary(), 1);
+  npopped = 0;
+  while (st.PopNextTrack(itrack)) {
+    npopped++;
+  }
+  BOOST_CHECK_EQUAL(npopped, 1);
+}
@@ -0,0 +1,128 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   RawCTFWriter.h
+/// @brief  Streaming writer for CTFs in a fixed-layout raw container with an index footer
+
+#ifndef O2_CTF_RAWCTFWRITER_H
+#define O2_CTF_RAWCTFWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace ctf
+{
+
+/// Appends the flat CTF images of consecutive TFs to a single file opened with direct IO
+/// (when the filesystem supports it), bypassing the page cache of the nodes which also host
+/// the shmem segments. The file space is preallocated in large extents to avoid per-append
+/// metadata updates. Layout (little-endian, every record zero-padded to Alignment):
+///
+/// FileHeader | TF record | TF record | ... | IndexEntry per TF ... Footer
+///
+/// A TF record is a TFRecordHeader followed by a fixed-size per-detector directory and the
+/// concatenated flat EncodedBlocks buffers exactly as received from the entropy encoders.
+/// The Footer sits at the very end of the last (aligned) block, so a reader locates the
+/// index for random TF access from the last Alignment bytes of the file.
+class RawCTFWriter
+{
+ public:
+  static constexpr size_t Alignment = 4096;     // covers any direct IO logical block size in production
+  static constexpr uint32_t MaxDetectors = 32;  // size of the per-TF detector directory, bound by the DetID mask width
+  static constexpr uint64_t MagicFileHeader = 0x574152465443324Full; // "O2CTFRAW"
+  static constexpr uint64_t MagicFooter = 0x584449465443324Full;     // "O2CTFIDX"
+
+  struct FileHeader {
+    uint64_t magic = MagicFileHeader;
+    uint32_t version = 1;
+    uint32_t alignment = Alignment;
+    uint32_t runNumber = 0;
+    uint32_t reserved[3] = {};
+  };
+
+  struct TFRecordHeader {
+    uint64_t creationTime = 0; // creation time from the DataProcessingHeader
+    uint32_t tfCounter = 0;    // original TF counter of the TF
+    uint32_t firstTForbit = 0; // first orbit of the TF
+    uint32_t detectors = 0;    // mask of detectors stored in this record
+    uint32_t nDets = 0;        // number of filled entries of the detector directory
+  };
+
+  struct DetEntry {
+    uint32_t detID = 0;
+    uint32_t reserved = 0;
+    uint64_t offset = 0; // payload offset from the start of the TF record
+    uint64_t size = 0;   // payload size in bytes
+  };
+
+  struct IndexEntry {
+    uint32_t tfCounter = 0;
+    uint32_t firstTForbit = 0;
+    uint64_t offset = 0; // file offset of the TF record
+    uint64_t size = 0;   // unpadded size of the TF record
+  };
+
+  struct Footer {
+    uint64_t magic = MagicFooter;
+    uint64_t indexOffset = 0; // file offset of the 1st IndexEntry
+    uint32_t nTFs = 0;
+    uint32_t version = 1;
+  };
+
+  RawCTFWriter() = default;
+  ~RawCTFWriter();
+  RawCTFWriter(const RawCTFWriter&) = delete;
+  RawCTFWriter& operator=(const RawCTFWriter&) = delete;
+
+  /// open the output file, preallocating preallocSize bytes (if >0) for the run
+  void open(const std::string& filename, uint32_t runNumber, size_t preallocSize);
+  /// start staging a new TF record
+  void startTF(uint32_t tfCounter, uint32_t firstTForbit, uint64_t creationTime);
+  /// stage the flat CTF buffer of a detector for the current TF
+  void addDetector(uint32_t detID, const void* data, size_t size);
+  /// append the staged TF record to the file, returns its unpadded size
+  size_t finishTF(uint32_t detectorsMask);
+  /// write the index footer and close the file
+  void close();
+
+  bool isOpen() const { return mFD != -1; }
+  size_t getFileSize() const { return mFileEnd; }
+  size_t getNTFs() const { return mIndex.size(); }
+  const std::string& getFileName() const { return mFileName; }
+
+ private:
+  static constexpr size_t TFHeaderBytes = sizeof(TFRecordHeader) + MaxDetectors * sizeof(DetEntry);
+  static constexpr size_t alignSize(size_t sz) { return (sz + Alignment - 1) & ~(Alignment - 1); }
+
+  void ensureStaging(size_t size);
+  void writeAt(const char* data, size_t size, size_t offset);
+
+  int mFD = -1;
+  size_t mFileEnd = 0;     // file offset where the next record will be appended
+  size_t mTFSize = 0;      // filled part of the staging buffer of the current TF
+  size_t mStagingSize = 0; // capacity of the staging buffer
+  uint32_t mNDets = 0;     // detectors staged for the current TF
+  TFRecordHeader mCurrHeader{};
+  std::string mFileName{};
+  std::vector<IndexEntry> mIndex{};
+  std::unique_ptr<char, decltype(&std::free)> mStaging{nullptr, &std::free}; // Alignment-aligned, as required by direct IO
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif /* O2_CTF_RAWCTFWRITER_H */
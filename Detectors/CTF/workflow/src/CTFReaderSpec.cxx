@@ -72,6 +72,8 @@ bool readFromTree(TTree& tree, const std::string brname, T& dest, int ev = 0)
 
 using DetID = o2::detectors::DetID;
 
+constexpr long TreeCacheSize = 50 * 1024 * 1024; // size of the TTree cache holding the baskets of the selected branches
+
 class CTFReaderSpec : public o2::framework::Task
 {
  public:
@@ -178,6 +180,27 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
     if (mCTFTree->GetEntries() < 1) {
       throw std::runtime_error(fmt::format("CTF tree in {} has 0 entries, skipping", flname));
     }
+    // the manifest (stored since the introduction of per-file detector bookkeeping) tells which
+    // detectors the file contains, so the TTree cache can be restricted to the branches of the
+    // requested detectors instead of prefetching the full entry
+    DetID::mask_t fileDets = DetID::FullMask;
+    std::unique_ptr<std::string> detsManifest{(std::string*)mCTFFile->GetObjectChecked(std::string(o2::base::NameConf::CTFDETSNAME).c_str(), "std::string")};
+    if (detsManifest) {
+      fileDets = DetID::getMask(*detsManifest);
+      LOGP(info, "CTF file {} contains detectors {}", flname, *detsManifest);
+      if ((fileDets & mInput.detMask).none()) {
+        LOGP(warning, "CTF file {} contains none of the requested detectors", flname);
+      }
+    }
+    mCTFTree->SetCacheSize(0); // reset the default cache before defining the branch selection
+    mCTFTree->SetCacheSize(TreeCacheSize);
+    mCTFTree->AddBranchToCache("CTFHeader", true);
+    for (auto id = DetID::First; id <= DetID::Last; id++) {
+      if (mInput.detMask[id] && fileDets[id]) {
+        mCTFTree->AddBranchToCache(fmt::format("{}_*", DetID::getName(id)).c_str(), true);
+      }
+    }
+    mCTFTree->StopCacheLearningPhase();
   } catch (const std::exception& e) {
     LOG(error) << "Cannot process " << flname << ", reason: " << e.what();
     mCTFTree.reset();
@@ -23,6 +23,7 @@
 
 #include "DataFormatsParameters/GRPECSObject.h"
 #include "CTFWorkflow/CTFWriterSpec.h"
+#include "CTFWorkflow/RawCTFWriter.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "CommonUtils/NameConf.h"
 #include "CommonUtils/FileSystemUtils.h"
@@ -128,6 +129,7 @@ class CTFWriterSpec : public o2::framework::Task
   bool mCreateRunEnvDir = true;
   bool mStoreMetaFile = false;
   bool mRejectCurrentTF = false;
+  bool mRawOutput = false; // write CTFs to raw streaming file with direct IO instead of ROOT tree
   bool mFallBackDirUsed = false;
   bool mFallBackDirProvided = false;
   int mReportInterval = -1;
@@ -138,11 +140,13 @@ class CTFWriterSpec : public o2::framework::Task
   size_t mMinSize = 0;             // if > 0, accumulate CTFs in the same tree until the total size exceeds this minimum
   size_t mMaxSize = 0;             // if > MinSize, and accumulated size will exceed this value, stop accumulation (even if mMinSize is not reached)
   size_t mChkSize = 0;             // if > 0 and fallback storage provided, reserve this size per CTF file in production on primary storage
+  size_t mRawPreallocSize = 0;     // in raw output mode preallocate so many bytes per CTF file
   size_t mAccCTFSize = 0;          // so far accumulated size (if any)
   size_t mCurrCTFSize = 0;         // size of currently processed CTF
   size_t mNCTF = 0;                // total number of CTFs written
   size_t mNCTFPrevDict = 0;        // total number of CTFs used for previous dictionary version
   size_t mNAccCTF = 0;             // total number of CTFs accumulated in the current file
+  DetID::mask_t mDetsPerFile{};    // union of detectors written to the current file
   int mWaitDiskFull = 0;           // if mCheckDiskFull triggers, pause for this amount of ms before new attempt
   int mWaitDiskFullMax = -1;       // produce fatal mCheckDiskFull block the workflow for more than this time (in ms)
   float mCheckDiskFull = 0.;       // wait for if available abs. disk space is < mCheckDiskFull (if >0) or if its fraction is < -mCheckDiskFull (if <0)
@@ -170,6 +174,7 @@ class CTFWriterSpec : public o2::framework::Task
   int mLockFD = -1;
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  std::unique_ptr<RawCTFWriter> mRawWriterOut; // used instead of mCTFFileOut/mCTFTreeOut in raw output mode
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -212,6 +217,10 @@ void CTFWriterSpec::init(InitContext& ic)
   } else if (outmode == "both") {
     mWriteCTF = true;
     mCreateDict = true;
+  } else if (outmode == "raw") {
+    mWriteCTF = true;
+    mCreateDict = false;
+    mRawOutput = true;
   } else if (outmode == "none") {
     mWriteCTF = false;
     mCreateDict = false;
@@ -266,6 +275,10 @@ void CTFWriterSpec::init(InitContext& ic)
   mWaitDiskFullMax = 1000 * ic.options().get<float>("max-wait-for-free-disk");
 
   mChkSize = std::max(size_t(mMinSize * 1.1), mMaxSize);
+  if (mRawOutput) {
+    auto prealloc = ic.options().get<int64_t>("raw-prealloc-size");
+    mRawPreallocSize = prealloc > 0 ? prealloc : mChkSize; // by default reserve what the space checks account per file
+  }
   o2::utils::createDirectoriesIfAbsent(LOCKFileDir);
 
   if (mCreateDict) { // make sure that there is no local dictonary
@@ -314,7 +327,12 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
     const auto ctfImage = C::getImage(bdata);
     ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "), mVerbosity);
     if (mWriteCTF && !mRejectCurrentTF) {
-      sz = ctfImage.appendToTree(*tree, det.getName());
+      if (mRawOutput) {
+        mRawWriterOut->addDetector(det, bdata, ctfBuffer.size());
+        sz = ctfBuffer.size();
+      } else {
+        sz = ctfImage.appendToTree(*tree, det.getName());
+      }
       header.detectors.set(det);
     } else {
       sz = ctfBuffer.size();
@@ -445,7 +463,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
       constexpr size_t MB = 1024 * 1024;
       constexpr int showFirstN = 10, prsecaleWarnings = 50;
       try {
-        const auto si = std::filesystem::space(mCTFFileOut->GetName());
+        const auto si = std::filesystem::space(mRawOutput ? mRawWriterOut->getFileName() : mCTFFileOut->GetName());
         std::string wmsg{};
         if (mCheckDiskFull > 0.f && si.available < mCheckDiskFull) {
           nwaitCycles++;
@@ -473,6 +491,9 @@ void CTFWriterSpec::run(ProcessingContext& pc)
       }
       break;
     }
+    if (mRawOutput) {
+      mRawWriterOut->startTF(mTimingInfo.tfCounter, mTimingInfo.firstTForbit, mTimingInfo.creation);
+    }
   }
   // create header
   CTFHeader header{mTimingInfo.runNumber, mTimingInfo.creation, mTimingInfo.firstTForbit, mTimingInfo.tfCounter};
@@ -503,10 +524,17 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Stop();
 
   if (mWriteCTF && !mRejectCurrentTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
     size_t prevSizeMB = mAccCTFSize / (1 << 20);
-    mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
+    if (mRawOutput) {
+      szCTF = mRawWriterOut->finishTF(header.detectors.to_ulong());
+      mAccCTFSize = mRawWriterOut->getFileSize();
+      mNAccCTF++;
+    } else {
+      szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+      mAccCTFSize += szCTF;
+      mCTFTreeOut->SetEntries(++mNAccCTF);
+    }
+    mDetsPerFile |= header.detectors;
     mTFOrbits.push_back(mTimingInfo.firstTForbit);
     LOG(info) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCurrentCTFFileNameFull << " in " << mTimer.CpuTime() - cput << " s";
     if (mNAccCTF > 1) {
@@ -522,8 +550,8 @@ void CTFWriterSpec::run(ProcessingContext& pc)
 
     if (mAccCTFSize >= mMinSize || (mMaxCTFPerFile > 0 && mNAccCTF >= mMaxCTFPerFile)) {
       closeTFTreeAndFile();
-    } else if ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave))) {
-      mCTFTreeOut->AutoSave("override");
+    } else if (!mRawOutput && ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave)))) {
+      mCTFTreeOut->AutoSave("override"); // in raw output mode the TF is already on disk, nothing to autosave
     }
   } else {
     LOG(info) << "TF#" << mNCTF << " {" << header << "} CTF writing is disabled, size was " << szCTF << " bytes";
@@ -564,7 +592,7 @@ void CTFWriterSpec::prepareTFTreeAndFile()
     return;
   }
   bool needToOpen = false;
-  if (!mCTFTreeOut) {
+  if (!mCTFTreeOut && !mRawWriterOut) {
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file.
@@ -596,13 +624,20 @@ void CTFWriterSpec::prepareTFTreeAndFile()
       }
     }
     mCurrentCTFFileName = o2::base::NameConf::getCTFFileName(mTimingInfo.runNumber, mTimingInfo.firstTForbit, mTimingInfo.tfCounter, mHostName);
+    if (mRawOutput) {
+      mCurrentCTFFileName.replace(mCurrentCTFFileName.rfind(".root"), 5, ".rctf");
+    }
     mCurrentCTFFileNameFull = fmt::format("{}{}", ctfDir, mCurrentCTFFileName);
-    mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
-    if (mCTFFileCompression >= 0) {
-      mCTFFileOut->SetCompressionLevel(mCTFFileCompression);
+    if (mRawOutput) { // to prevent premature external usage, use temporary name
+      mRawWriterOut = std::make_unique<RawCTFWriter>();
+      mRawWriterOut->open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding), mTimingInfo.runNumber, mRawPreallocSize);
+    } else {
+      mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
+      if (mCTFFileCompression >= 0) {
+        mCTFFileOut->SetCompressionLevel(mCTFFileCompression);
+      }
+      mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
     }
-    mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
-
     mNCTFFiles++;
   }
 }
@@ -610,13 +645,22 @@ void CTFWriterSpec::prepareTFTreeAndFile()
 //___________________________________________________________________
 void CTFWriterSpec::closeTFTreeAndFile()
 {
-  if (mCTFTreeOut) {
+  if (mCTFTreeOut || mRawWriterOut) {
     try {
-      mCTFFileOut->cd();
-      mCTFTreeOut->Write();
-      mCTFTreeOut.reset();
-      mCTFFileOut->Close();
-      mCTFFileOut.reset();
+      if (mRawWriterOut) {
+        mRawWriterOut->close(); // appends the index footer
+        mRawWriterOut.reset();
+      } else {
+        mCTFFileOut->cd();
+        mCTFTreeOut->Write();
+        // store the manifest with the union of detectors contained in the file, the reader uses
+        // it to restrict branch-level reads to the detectors it was asked for
+        auto detNames = DetID::getNames(mDetsPerFile);
+        mCTFFileOut->WriteObject(&detNames, std::string(o2::base::NameConf::CTFDETSNAME).c_str());
+        mCTFTreeOut.reset();
+        mCTFFileOut->Close();
+        mCTFFileOut.reset();
+      }
       // write CTF file metaFile data
       auto actualFileName = TMPFileEnding.empty() ? mCurrentCTFFileNameFull : o2::utils::Str::concat_string(mCurrentCTFFileNameFull, TMPFileEnding);
       if (mStoreMetaFile) {
@@ -650,6 +694,7 @@ void CTFWriterSpec::closeTFTreeAndFile()
     mTFOrbits.clear();
     mNAccCTF = 0;
     mAccCTFSize = 0;
+    mDetsPerFile.reset();
     removeLockFile();
   }
 }
@@ -804,7 +849,7 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, const std::string& outTyp
     Outputs{{OutputLabel{"ctfdone"}, "CTF", "DONE", 0, Lifetime::Timeframe},
             {"CTF", "SIZES", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<CTFWriterSpec>(dets, outType, verbosity, reportInterval)}, // RS FIXME once global/local options clash is solved, --output-type will become device option
-    Options{                                                                               //{"output-type", VariantType::String, "ctf", {"output types: ctf (per TF) or dict (create dictionaries) or both or none"}},
+    Options{                                                                               //{"output-type", VariantType::String, "ctf", {"output types: ctf (per TF), raw (streaming file with direct IO), dict (create dictionaries), both (ctf+dict) or none"}},
             {"save-ctf-after", VariantType::Int64, 0ll, {"autosave CTF tree with multiple CTFs after every N CTFs if >0 or every -N MBytes if < 0"}},
             {"save-dict-after", VariantType::Int, 0, {"if > 0, in dictionary generation mode save it dictionary after certain number of TFs processed"}},
             {"ctf-dict-dir", VariantType::String, "none", {"CTF dictionary directory, must exist"}},
@@ -817,6 +862,7 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, const std::string& outTyp
             {"max-ctf-per-file", VariantType::Int, 0, {"if > 0, avoid storing more than requested CTFs per file"}},
             {"ctf-rejection", VariantType::Int, 0, {">0: percentage to reject randomly, <0: reject if timeslice%|value|!=0"}},
             {"ctf-file-compression", VariantType::Int, 0, {"if >= 0: impose CTF file compression level"}},
+            {"raw-prealloc-size", VariantType::Int64, 0l, {"raw output mode: preallocate so many bytes per CTF file (0: use max-file-size based reservation)"}},
             {"require-free-disk", VariantType::Float, 0.f, {"pause writing op. if available disk space is below this margin, in bytes if >0, as a fraction of total if <0"}},
             {"wait-for-free-disk", VariantType::Float, 10.f, {"if paused due to the low disk space, recheck after this time (in s)"}},
             {"max-wait-for-free-disk", VariantType::Float, 60.f, {"produce fatal if paused due to the low disk space for more than this amount in s."}},
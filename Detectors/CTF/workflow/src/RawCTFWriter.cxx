@@ -0,0 +1,180 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   RawCTFWriter.cxx
+
+#include "CTFWorkflow/RawCTFWriter.h"
+#include "Framework/Logger.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2
+{
+namespace ctf
+{
+
+//___________________________________________________________________
+RawCTFWriter::~RawCTFWriter()
+{
+  try {
+    close();
+  } catch (std::exception const& e) {
+    LOG(error) << "Failed to close raw CTF file " << mFileName << ", reason: " << e.what();
+  }
+}
+
+//___________________________________________________________________
+void RawCTFWriter::open(const std::string& filename, uint32_t runNumber, size_t preallocSize)
+{
+  if (isOpen()) {
+    close();
+  }
+  mFileName = filename;
+  int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+#ifdef O_DIRECT
+  flags |= O_DIRECT;
+#endif
+  mFD = ::open(filename.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+#ifdef O_DIRECT
+  if (mFD == -1 && errno == EINVAL) { // the filesystem does not support direct IO (e.g. tmpfs)
+    LOGP(warning, "Direct IO is not supported for {}, falling back to buffered writes", filename);
+    mFD = ::open(filename.c_str(), flags & ~O_DIRECT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  }
+#endif
+  if (mFD == -1) {
+    throw std::runtime_error(fmt::format("Error opening raw CTF file {}: {}", filename, strerror(errno)));
+  }
+#ifdef __linux__
+  // reserve the extents for the whole file upfront, the nominal size keeps tracking the appends
+  if (preallocSize > 0 && fallocate(mFD, FALLOC_FL_KEEP_SIZE, 0, preallocSize) != 0) {
+    LOGP(warning, "Failed to preallocate {} bytes for {}: {}", preallocSize, filename, strerror(errno));
+  }
+#endif
+  mIndex.clear();
+  mTFSize = 0;
+  mNDets = 0;
+  ensureStaging(Alignment);
+  std::memset(mStaging.get(), 0, Alignment);
+  FileHeader fh{};
+  fh.runNumber = runNumber;
+  std::memcpy(mStaging.get(), &fh, sizeof(fh));
+  writeAt(mStaging.get(), Alignment, 0);
+  mFileEnd = Alignment;
+}
+
+//___________________________________________________________________
+void RawCTFWriter::startTF(uint32_t tfCounter, uint32_t firstTForbit, uint64_t creationTime)
+{
+  mCurrHeader = TFRecordHeader{creationTime, tfCounter, firstTForbit, 0, 0};
+  mNDets = 0;
+  ensureStaging(TFHeaderBytes);
+  std::memset(mStaging.get(), 0, TFHeaderBytes);
+  mTFSize = TFHeaderBytes;
+}
+
+//___________________________________________________________________
+void RawCTFWriter::addDetector(uint32_t detID, const void* data, size_t size)
+{
+  if (mNDets >= MaxDetectors) {
+    throw std::runtime_error(fmt::format("Too many detectors in TF record of {}", mFileName));
+  }
+  ensureStaging(mTFSize + size);
+  DetEntry entry{detID, 0, mTFSize, size};
+  std::memcpy(mStaging.get() + sizeof(TFRecordHeader) + mNDets * sizeof(DetEntry), &entry, sizeof(entry));
+  std::memcpy(mStaging.get() + mTFSize, data, size);
+  mNDets++;
+  mTFSize += size;
+}
+
+//___________________________________________________________________
+size_t RawCTFWriter::finishTF(uint32_t detectorsMask)
+{
+  mCurrHeader.detectors = detectorsMask;
+  mCurrHeader.nDets = mNDets;
+  std::memcpy(mStaging.get(), &mCurrHeader, sizeof(mCurrHeader));
+  size_t padded = alignSize(mTFSize);
+  ensureStaging(padded);
+  std::memset(mStaging.get() + mTFSize, 0, padded - mTFSize);
+  mIndex.push_back({mCurrHeader.tfCounter, mCurrHeader.firstTForbit, mFileEnd, mTFSize});
+  writeAt(mStaging.get(), padded, mFileEnd);
+  mFileEnd += padded;
+  size_t sz = mTFSize;
+  mTFSize = 0;
+  return sz;
+}
+
+//___________________________________________________________________
+void RawCTFWriter::close()
+{
+  if (!isOpen()) {
+    return;
+  }
+  size_t footerBytes = mIndex.size() * sizeof(IndexEntry) + sizeof(Footer);
+  size_t padded = alignSize(footerBytes);
+  mTFSize = 0;
+  ensureStaging(padded);
+  std::memset(mStaging.get(), 0, padded);
+  std::memcpy(mStaging.get(), mIndex.data(), mIndex.size() * sizeof(IndexEntry));
+  Footer footer{};
+  footer.indexOffset = mFileEnd;
+  footer.nTFs = static_cast<uint32_t>(mIndex.size());
+  std::memcpy(mStaging.get() + padded - sizeof(Footer), &footer, sizeof(footer));
+  writeAt(mStaging.get(), padded, mFileEnd);
+  mFileEnd += padded;
+  if (fsync(mFD) != 0) { // commit the preallocated extents before the caller renames the file
+    LOGP(warning, "Failed to sync {}: {}", mFileName, strerror(errno));
+  }
+  ::close(mFD);
+  mFD = -1;
+}
+
+//___________________________________________________________________
+void RawCTFWriter::ensureStaging(size_t size)
+{
+  if (size <= mStagingSize) {
+    return;
+  }
+  size_t newSize = alignSize(std::max(size, 2 * mStagingSize));
+  void* buff = nullptr;
+  if (posix_memalign(&buff, Alignment, newSize) != 0) {
+    throw std::runtime_error(fmt::format("Failed to allocate {} bytes staging buffer for {}", newSize, mFileName));
+  }
+  if (mTFSize) {
+    std::memcpy(buff, mStaging.get(), mTFSize);
+  }
+  mStaging.reset(static_cast<char*>(buff));
+  mStagingSize = newSize;
+}
+
+//___________________________________________________________________
+void RawCTFWriter::writeAt(const char* data, size_t size, size_t offset)
+{
+  while (size) {
+    auto nwr = ::pwrite(mFD, data, size, offset);
+    if (nwr < 1) {
+      if (nwr < 0 && errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(fmt::format("Failed to write {} bytes to {} at offset {}: {}", size, mFileName, offset, strerror(errno)));
+    }
+    data += nwr;
+    size -= nwr;
+    offset += nwr;
+  }
+}
+
+} // namespace ctf
+} // namespace o2
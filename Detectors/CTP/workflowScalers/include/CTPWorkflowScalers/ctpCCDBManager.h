@@ -15,6 +15,7 @@
 #ifndef _CTP_CTPCCDB_H_
 #define _CTP_CTPCCDB_H_
 #include "DataFormatsCTP/Configuration.h"
+#include "DataFormatsCTP/LumiIntegrals.h"
 
 namespace o2
 {
@@ -25,6 +26,7 @@ class ctpCCDBManager
  public:
   ctpCCDBManager() = default;
   int saveRunScalersToCCDB(CTPRunScalers& scalers, long timeStart, long timeStop);
+  int saveLumiIntegralsToCCDB(LumiIntegrals& integrals, long timeStart, long timeStop);
   int saveRunScalersToQCDB(CTPRunScalers& scalers, long timeStart, long timeStop);
   int saveRunConfigToCCDB(CTPConfiguration* cfg, long timeStart);
   static CTPConfiguration getConfigFromCCDB(long timestamp, std::string run, bool& ok);
@@ -43,6 +45,7 @@ class ctpCCDBManager
   static std::string mCCDBHost;
   static std::string mQCDBHost;
   std::string mCCDBPathCTPScalers = "CTP/Calib/Scalers";
+  std::string mCCDBPathCTPLumiIntegrals = "CTP/Calib/LumiIntegrals";
   std::string mCCDBPathCTPConfig = "CTP/Config/Config";
   std::string mQCDBPathCTPScalers = "qc/CTP/Scalers";
   ClassDefNV(ctpCCDBManager, 1);
@@ -52,6 +52,33 @@ int ctpCCDBManager::saveRunScalersToCCDB(CTPRunScalers& scalers, long timeStart,
   }
   return ret;
 }
+int ctpCCDBManager::saveLumiIntegralsToCCDB(LumiIntegrals& integrals, long timeStart, long timeStop)
+{
+  // data base
+  if (mCCDBHost == "none") {
+    LOG(info) << "Lumi integrals not written to CCDB none";
+    return 0;
+  }
+  using namespace std::chrono_literals;
+  std::chrono::seconds days3 = 259200s;
+  std::chrono::seconds min10 = 600s;
+  long time3days = std::chrono::duration_cast<std::chrono::milliseconds>(days3).count();
+  long time10min = std::chrono::duration_cast<std::chrono::milliseconds>(min10).count();
+  long tmin = timeStart - time10min;
+  long tmax = timeStop + time3days;
+  o2::ccdb::CcdbApi api;
+  map<string, string> metadata; // can be empty
+  metadata["runNumber"] = std::to_string(integrals.getRunNumber());
+  api.init(mCCDBHost.c_str()); // or http://localhost:8080 for a local installation
+  // store abitrary user object in strongly typed manner
+  int ret = api.storeAsTFileAny(&(integrals), mCCDBPathCTPLumiIntegrals, metadata, tmin, tmax);
+  if (ret == 0) {
+    LOG(info) << "CTP lumi integrals saved in ccdb:" << mCCDBHost << " run:" << integrals.getRunNumber() << " tmin:" << tmin << " tmax:" << tmax;
+  } else {
+    LOG(fatal) << "Problem writing lumi integrals to database ret:" << ret;
+  }
+  return ret;
+}
 int ctpCCDBManager::saveRunScalersToQCDB(CTPRunScalers& scalers, long timeStart, long timeStop)
 {
   // data base
@@ -95,26 +95,30 @@ void MeanVertexCalibDevice::sendOutput(DataAllocator& output)
   for (uint32_t i = 0; i < payloadVec.size(); i++) {
     auto w = infoVec[i];
     auto& mv = payloadVec[i];
-    auto image = o2::ccdb::CcdbApi::createObjectImage(&mv, &w);
-    LOG(info) << (MeanVertexParams::Instance().skipObjectSending ? "Skip " : "") << "sending object "
-              << w.getPath() << "/" << w.getFileName() << " of size " << image->size()
+    if (MeanVertexParams::Instance().skipObjectSending) {
+      LOG(info) << "Skip sending object " << w.getPath()
+                << ", valid for " << w.getStartValidityTimestamp() << " : " << w.getEndValidityTimestamp();
+      continue;
+    }
+    // create the image directly in the output message, avoiding the intermediate image vector and its copy
+    auto& image = output.make<std::vector<char>>(Output{clbUtils::gDataOriginCDBPayload, "MEANVERTEX", i});
+    o2::ccdb::CcdbApi::createObjectImage(&mv, image, &w);
+    LOG(info) << "sending object "
+              << w.getPath() << "/" << w.getFileName() << " of size " << image.size()
               << " bytes, valid for " << w.getStartValidityTimestamp() << " : " << w.getEndValidityTimestamp();
-    if (!MeanVertexParams::Instance().skipObjectSending) {
-      if (mDCSSubSpec) { // create message for DCS CCDB
-        auto ts = (w.getStartValidityTimestamp() + w.getEndValidityTimestamp()) / 2;
-        o2::ccdb::CcdbObjectInfo dcsw("GLO/Calib/MeanVertexCSV", "csv", fmt::format("meanvertex_{}.csv", ts), {}, w.getStartValidityTimestamp(), w.getEndValidityTimestamp());
-
-        std::string csvMeanVertex = fmt::format("timestamp={},fillNumber={},runNumber={},x={:+.4e},y={:+.4e},z={:+.4e},sigmax={:+.4e},sigmay={:+.4e},sigmaz={:+.4e}",
-                                                ts, mFillNumber, mRunNumber, mv.getX(), mv.getY(), mv.getZ(), mv.getSigmaX(), mv.getSigmaY(), mv.getSigmaZ());
-        dcsMVObj.clear();
-        std::copy(csvMeanVertex.begin(), csvMeanVertex.end(), std::back_inserter(dcsMVObj));
-        output.snapshot(Output{clbUtils::gDataOriginCDBPayload, "MEANVERTEX_DCS", mDCSSubSpec + i}, dcsMVObj);
-        output.snapshot(Output{clbUtils::gDataOriginCDBWrapper, "MEANVERTEX_DCS", mDCSSubSpec + i}, dcsw);
-      }
-      w.setEndValidityTimestamp(w.getEndValidityTimestamp() + o2::ccdb::CcdbObjectInfo::MONTH);
-      output.snapshot(Output{clbUtils::gDataOriginCDBPayload, "MEANVERTEX", i}, *image.get()); // vector<char>
-      output.snapshot(Output{clbUtils::gDataOriginCDBWrapper, "MEANVERTEX", i}, w);            // root-serialized
+    if (mDCSSubSpec) { // create message for DCS CCDB
+      auto ts = (w.getStartValidityTimestamp() + w.getEndValidityTimestamp()) / 2;
+      o2::ccdb::CcdbObjectInfo dcsw("GLO/Calib/MeanVertexCSV", "csv", fmt::format("meanvertex_{}.csv", ts), {}, w.getStartValidityTimestamp(), w.getEndValidityTimestamp());
+
+      std::string csvMeanVertex = fmt::format("timestamp={},fillNumber={},runNumber={},x={:+.4e},y={:+.4e},z={:+.4e},sigmax={:+.4e},sigmay={:+.4e},sigmaz={:+.4e}",
+                                              ts, mFillNumber, mRunNumber, mv.getX(), mv.getY(), mv.getZ(), mv.getSigmaX(), mv.getSigmaY(), mv.getSigmaZ());
+      dcsMVObj.clear();
+      std::copy(csvMeanVertex.begin(), csvMeanVertex.end(), std::back_inserter(dcsMVObj));
+      output.snapshot(Output{clbUtils::gDataOriginCDBPayload, "MEANVERTEX_DCS", mDCSSubSpec + i}, dcsMVObj);
+      output.snapshot(Output{clbUtils::gDataOriginCDBWrapper, "MEANVERTEX_DCS", mDCSSubSpec + i}, dcsw);
     }
+    w.setEndValidityTimestamp(w.getEndValidityTimestamp() + o2::ccdb::CcdbObjectInfo::MONTH);
+    output.snapshot(Output{clbUtils::gDataOriginCDBWrapper, "MEANVERTEX", i}, w); // root-serialized
   }
   if (payloadVec.size()) {
     mCalibrator->initOutput(); // reset the outputs once they are already sent
@@ -282,6 +282,27 @@ class MinorAltroDecodingError
   uint32_t mPayloadWord;   ///< Payload word raising the error
 };
 
+/// \struct AltroDecoderStats
+/// \brief Throughput counters of the ALTRO payload decoding
+/// \ingroup EMCALreconstruction
+///
+/// The counters accumulate over subsequent calls of AltroDecoder::decode
+/// until they are reset, so they can be normalized to the walltime of an
+/// arbitrary processing interval (page, event or timeframe).
+struct AltroDecoderStats {
+  std::size_t mPayloadWordsDecoded = 0; ///< Number of 32-bit ALTRO payload words unpacked
+  std::size_t mChannelsDecoded = 0;     ///< Number of good channels decoded
+  std::size_t mBunchesDecoded = 0;      ///< Number of bunches decoded
+
+  /// \brief Reset all counters to 0
+  void reset()
+  {
+    mPayloadWordsDecoded = 0;
+    mChannelsDecoded = 0;
+    mBunchesDecoded = 0;
+  }
+};
+
 /// \class AltroDecoder
 /// \brief Decoder of the ALTRO data in the raw page
 /// \ingroup EMCALreconstruction
@@ -345,6 +366,13 @@ class AltroDecoder
   /// \return List of minor decoding errors
   const std::vector<MinorAltroDecodingError>& getMinorDecodingErrors() const { return mMinorDecodingErrors; }
 
+  /// \brief Get the throughput counters of the decoder
+  /// \return Counters accumulated since the last call of resetDecoderStats
+  const AltroDecoderStats& getDecoderStats() const { return mDecoderStats; }
+
+  /// \brief Reset the throughput counters of the decoder
+  void resetDecoderStats() { mDecoderStats.reset(); }
+
  private:
   /// \brief run checks on the RCU trailer
   /// \throw Error if the RCU trailer has inconsistencies
@@ -362,6 +390,8 @@ class AltroDecoder
   RCUTrailer mRCUTrailer;                                    ///< RCU trailer
   std::vector<Channel> mChannels;                            ///< vector of channels in the raw stream
   std::vector<MinorAltroDecodingError> mMinorDecodingErrors; ///< Container for minor (non-crashing) errors
+  std::vector<uint16_t> mBunchwordsBuffer;                   ///< reusable scratch buffer for the bulk-unpacked 10-bit words of a channel
+  AltroDecoderStats mDecoderStats;                           ///< throughput counters of the payload decoding
   bool mChannelsInitialized = false;                         ///< check whether the channels are initialized
   unsigned int mMaxBunchLength = UINT_MAX;                   ///< Max bunch length
 
@@ -15,6 +15,7 @@
 #include <array>
 #include <optional>
 #include <string_view>
+#include <vector>
 #include <Rtypes.h>
 #include <gsl/span>
 #include "EMCALReconstruction/CaloFitResults.h"
@@ -146,6 +147,19 @@ class CaloRawFitter
 
   virtual CaloFitResults evaluate(const gsl::span<const Bunch> bunchvector) = 0;
 
+  /// \brief Evaluate a batch of channels in one call
+  /// \param channels Bunch collections of the channels to be fitted
+  /// \param[out] results Fit results, parallel to channels (default-constructed for failed fits)
+  /// \param[out] statuses Error codes, parallel to channels (no value for successful fits)
+  ///
+  /// Batch entry point for callers holding the channels of a whole
+  /// readout unit: the virtual dispatch and the error handling are
+  /// paid once per batch instead of once per channel, and concrete
+  /// fitters can reuse per-channel setup across the batch.
+  void evaluateBatch(const std::vector<gsl::span<const Bunch>>& channels,
+                     std::vector<CaloFitResults>& results,
+                     std::vector<std::optional<RawFitterError_t>>& statuses);
+
   /// \brief Method to do the selection of what should possibly be fitted.
   /// \param bunchvector ALTRO bunches for the current channel
   /// \param adcThreshold ADC threshold applied in peak finding
@@ -12,6 +12,7 @@
 #ifndef __CALORAWFITTERGAMMA2_H__
 #define __CALORAWFITTERGAMMA2_H__
 
+#include <cmath>
 #include <iosfwd>
 #include <array>
 #include <optional>
@@ -82,6 +83,49 @@ class CaloRawFitterGamma2 final : public CaloRawFitter
   /// Fit performed as parabola fit to the signal
   std::tuple<float, float> doParabolaFit(int maxTimeBin) const;
 
+  /// \brief Accumulate the normal-equation sums of one gamma-2 Newton step
+  /// \param nSamples Number of time samples entering the fit
+  /// \param ampl Current amplitude estimate
+  /// \param time Current time estimate
+  /// \param[out] sums The accumulated sums (c11, c12, c21, c22, d1, d2, chi2)
+  ///
+  /// Kept inline so that the templated wrapper below compiles into a
+  /// kernel with a compile-time trip count which the compiler can
+  /// unroll and vectorize.
+  inline void accumulateGamma2Sums(int nSamples, float ampl, float time, std::array<double, 7>& sums) const
+  {
+    for (int itbin = 0; itbin < nSamples; itbin++) {
+      double ti = (itbin - time) / constants::TAU;
+      if ((ti + 1) < 0) {
+        continue;
+      }
+      double g_1i = (ti + 1) * std::exp(-2 * ti);
+      double g_i = (ti + 1) * g_1i;
+      double gp_i = 2 * (g_i - g_1i);
+      double q1_i = (2 * ti + 1) * std::exp(-2 * ti);
+      double q2_i = g_1i * g_1i * (4 * ti + 1);
+      sums[0] += (getReversed(itbin) - ampl * 2 * g_i) * gp_i;
+      sums[1] += g_i * g_i;
+      sums[2] += getReversed(itbin) * q1_i - ampl * q2_i;
+      sums[3] += g_i * g_1i;
+      double delta = ampl * g_i - getReversed(itbin);
+      sums[4] += delta * g_i;
+      sums[5] += delta * g_1i;
+      sums[6] += delta * delta;
+    }
+  }
+
+  /// \brief Compile-time-specialized version of accumulateGamma2Sums
+  ///
+  /// The fixed sample count propagates as constant into the inlined
+  /// accumulation loop, specializing the kernel for the regular bunch
+  /// lengths (doFit_1peak dispatches here for the common cases).
+  template <int NSAMPLES>
+  void accumulateGamma2Sums(float ampl, float time, std::array<double, 7>& sums) const
+  {
+    accumulateGamma2Sums(NSAMPLES, ampl, time, sums);
+  }
+
   ClassDefNV(CaloRawFitterGamma2, 1);
 }; // End of CaloRawFitterGamma2
 
@@ -92,10 +92,10 @@ void AltroDecoder::readChannels()
     }
     lastFEC = currentfec;
 
-    /// decode all words for channel
+    /// validate all words for channel
     bool foundChannelError = false;
     int numberofwords = (payloadsize + 2) / 3;
-    std::vector<uint16_t> bunchwords;
+    int wordstart = currentpos;
     for (int iword = 0; iword < numberofwords; iword++) {
       if (currentpos >= maxpayloadsize) {
         mMinorDecodingErrors.emplace_back(MinorAltroDecodingError::ErrorType_t::CHANNEL_PAYLOAD_EXCEED, channelheader, currentword);
@@ -110,14 +110,26 @@ void AltroDecoder::readChannels()
         currentpos--;
         continue;
       }
-      bunchwords.push_back((currentword >> 20) & 0x3FF);
-      bunchwords.push_back((currentword >> 10) & 0x3FF);
-      bunchwords.push_back(currentword & 0x3FF);
     }
     if (foundChannelError) {
       // do not decode bunch if channel payload is corrupted
       continue;
     }
+
+    // bulk-unpack the validated payload words (3 10-bit samples per 32-bit word)
+    // into the reusable scratch buffer: the loop is free of branches and vector
+    // capacity checks, so the compiler can vectorize the bit extraction
+    auto& bunchwords = mBunchwordsBuffer;
+    bunchwords.resize(3 * numberofwords);
+    const uint32_t* payloadwords = buffer.data() + wordstart;
+    for (int iword = 0; iword < numberofwords; iword++) {
+      uint32_t word = payloadwords[iword];
+      bunchwords[3 * iword] = (word >> 20) & 0x3FF;
+      bunchwords[3 * iword + 1] = (word >> 10) & 0x3FF;
+      bunchwords[3 * iword + 2] = word & 0x3FF;
+    }
+    mDecoderStats.mPayloadWordsDecoded += numberofwords;
+    mDecoderStats.mChannelsDecoded++;
     // Payload decoding for channel good - starting a new channel object
     mChannels.emplace_back(hwaddress, payloadsize);
     auto& currentchannel = mChannels.back();
@@ -161,6 +173,7 @@ void AltroDecoder::readChannels()
       }
       auto& currentbunch = currentchannel.createBunch(bunchlength, starttime);
       currentbunch.initFromRange(gsl::span<uint16_t>(&bunchwords[currentsample + 2], std::min((unsigned long)bunchlength, bunchwords.size() - currentsample - 2)));
+      mDecoderStats.mBunchesDecoded++;
       currentsample += bunchlength + 2;
     }
   }
@@ -394,6 +394,25 @@ std::tuple<int, int, float, short, short, float, int, int> CaloRawFitter::preFit
   return std::make_tuple(nsamples, bunchindex, peakADC, adcMAX, indexMaxADCRReveresed, pedestal, first, last);
 }
 
+void CaloRawFitter::evaluateBatch(const std::vector<gsl::span<const Bunch>>& channels,
+                                  std::vector<CaloFitResults>& results,
+                                  std::vector<std::optional<RawFitterError_t>>& statuses)
+{
+  results.clear();
+  statuses.clear();
+  results.reserve(channels.size());
+  statuses.reserve(channels.size());
+  for (const auto& bunchvector : channels) {
+    try {
+      results.emplace_back(evaluate(bunchvector));
+      statuses.emplace_back(std::nullopt);
+    } catch (RawFitterError_t& error) {
+      results.emplace_back();
+      statuses.emplace_back(error);
+    }
+  }
+}
+
 std::ostream& o2::emcal::operator<<(std::ostream& stream, const CaloRawFitter::RawFitterError_t error)
 {
   stream << CaloRawFitter::getErrorTypeName(error);
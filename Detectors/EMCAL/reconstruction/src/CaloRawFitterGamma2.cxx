@@ -107,36 +107,60 @@ float CaloRawFitterGamma2::doFit_1peak(int firstTimeBin, int nSamples, float& am
   }
 
   double D, dA, dt;
-  double c11 = 0;
-  double c12 = 0;
-  double c21 = 0;
-  double c22 = 0;
-  double d1 = 0;
-  double d2 = 0;
 
   mNiter++;
 
-  for (int itbin = 0; itbin < nSamples; itbin++) {
-
-    double ti = (itbin - time) / constants::TAU;
-    if ((ti + 1) < 0) {
-      continue;
-    }
-
-    double g_1i = (ti + 1) * TMath::Exp(-2 * ti);
-    double g_i = (ti + 1) * g_1i;
-    double gp_i = 2 * (g_i - g_1i);
-    double q1_i = (2 * ti + 1) * TMath::Exp(-2 * ti);
-    double q2_i = g_1i * g_1i * (4 * ti + 1);
-    c11 += (getReversed(itbin) - ampl * 2 * g_i) * gp_i;
-    c12 += g_i * g_i;
-    c21 += getReversed(itbin) * q1_i - ampl * q2_i;
-    c22 += g_i * g_1i;
-    double delta = ampl * g_i - getReversed(itbin);
-    d1 += delta * g_i;
-    d2 += delta * g_1i;
-    chi2 += (delta * delta);
+  // dispatch the accumulation of the normal-equation sums to the kernel
+  // specialized for the given sample count: the regular bunch lengths get a
+  // compile-time trip count (and thus an unrolled, vectorizable loop), only
+  // irregular bunches take the generic runtime-length path
+  std::array<double, 7> sums{};
+  switch (nSamples) {
+    case 3:
+      accumulateGamma2Sums<3>(ampl, time, sums);
+      break;
+    case 4:
+      accumulateGamma2Sums<4>(ampl, time, sums);
+      break;
+    case 5:
+      accumulateGamma2Sums<5>(ampl, time, sums);
+      break;
+    case 6:
+      accumulateGamma2Sums<6>(ampl, time, sums);
+      break;
+    case 7:
+      accumulateGamma2Sums<7>(ampl, time, sums);
+      break;
+    case 8:
+      accumulateGamma2Sums<8>(ampl, time, sums);
+      break;
+    case 9:
+      accumulateGamma2Sums<9>(ampl, time, sums);
+      break;
+    case 10:
+      accumulateGamma2Sums<10>(ampl, time, sums);
+      break;
+    case 11:
+      accumulateGamma2Sums<11>(ampl, time, sums);
+      break;
+    case 12:
+      accumulateGamma2Sums<12>(ampl, time, sums);
+      break;
+    case 13:
+      accumulateGamma2Sums<13>(ampl, time, sums);
+      break;
+    case 14:
+      accumulateGamma2Sums<14>(ampl, time, sums);
+      break;
+    case 15:
+      accumulateGamma2Sums<15>(ampl, time, sums);
+      break;
+    default:
+      accumulateGamma2Sums(nSamples, ampl, time, sums);
+      break;
   }
+  auto [c11, c12, c21, c22, d1, d2, chi2sum] = sums;
+  chi2 = chi2sum;
 
   D = c11 * c22 - c12 * c21;
 
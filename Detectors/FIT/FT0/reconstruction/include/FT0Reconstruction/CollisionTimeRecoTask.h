@@ -21,6 +21,7 @@
 #include "DataFormatsFT0/FT0ChannelTimeCalibrationObject.h"
 #include "DataFormatsFT0/SpectraInfoObject.h"
 #include "DataFormatsFT0/SlewingCoef.h"
+#include "FITReconstruction/TimeCalibEngine.h"
 #include <gsl/span>
 #include <array>
 #include <vector>
@@ -51,7 +52,17 @@ class CollisionTimeRecoTask
                                   const gsl::span<const o2::ft0::ChannelData> inChData,
                                   std::vector<o2::ft0::ChannelDataFloat>& outChData);
   void FinishTask();
-  void SetTimeCalibObject(o2::ft0::TimeSpectraInfoObject const* timeCalibObject) { mTimeCalibObject = timeCalibObject; };
+  void SetTimeCalibObject(o2::ft0::TimeSpectraInfoObject const* timeCalibObject)
+  {
+    mTimeCalibObject = timeCalibObject;
+    // the offset of a channel depends only on the calibration object: derive
+    // the flat table once here instead of re-deriving it for every hit
+    if (mTimeCalibObject != nullptr) {
+      mTimeCalib.update([this](int channel) { return deriveTimeOffset(channel); });
+    } else {
+      mTimeCalib.reset();
+    }
+  };
   void SetSlewingCalibObject(o2::ft0::SlewingCoef const* calibSlew)
   {
     LOG(info) << "Init for slewing calib object";
@@ -60,7 +71,9 @@ class CollisionTimeRecoTask
   float getTimeInPS(const o2::ft0::ChannelData& channelData);
 
  private:
+  float deriveTimeOffset(int channel) const;
   o2::ft0::TimeSpectraInfoObject const* mTimeCalibObject = nullptr;
+  o2::fit::TimeCalibEngine<NCHANNELS> mTimeCalib{};
   typename o2::ft0::SlewingCoef::SlewingPlots_t mCalibSlew{};
 };
 } // namespace ft0
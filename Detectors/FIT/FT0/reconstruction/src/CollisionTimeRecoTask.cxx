@@ -99,30 +99,33 @@ void CollisionTimeRecoTask::FinishTask()
   // if (!mContinuous)   return;
 }
 
-float CollisionTimeRecoTask::getTimeInPS(const o2::ft0::ChannelData& channelData)
+float CollisionTimeRecoTask::deriveTimeOffset(int channel) const
 {
-  // Getting time offset
-  float offsetChannel{0};
-  if (mTimeCalibObject) {
-    // Temporary, will be changed to status bit checking
-    // Check statistics
-    const auto& stat = mTimeCalibObject->mTime[channelData.ChId].mStat;
-    const bool isEnoughStat = stat > CalibParam::Instance().mMaxEntriesThreshold;
-    const bool isNotGoogStat = stat > CalibParam::Instance().mMinEntriesThreshold && !isEnoughStat;
-    // Check fit quality
-    const auto& meanGaus = mTimeCalibObject->mTime[channelData.ChId].mGausMean;
-    const auto& meanHist = mTimeCalibObject->mTime[channelData.ChId].mStatMean;
-    const auto& sigmaGaus = mTimeCalibObject->mTime[channelData.ChId].mGausRMS;
-    const auto& rmsHist = mTimeCalibObject->mTime[channelData.ChId].mStatRMS;
-    const bool isGoodFitResult = (mTimeCalibObject->mTime[channelData.ChId].mStatusBits & 1) > 0;
-    const bool isBadFit = std::abs(meanGaus - meanHist) > CalibParam::Instance().mMaxDiffMean || rmsHist < CalibParam::Instance().mMinRMS || sigmaGaus > CalibParam::Instance().mMaxSigma;
+  // Temporary, will be changed to status bit checking
+  // Check statistics
+  const auto& stat = mTimeCalibObject->mTime[channel].mStat;
+  const bool isEnoughStat = stat > CalibParam::Instance().mMaxEntriesThreshold;
+  const bool isNotGoogStat = stat > CalibParam::Instance().mMinEntriesThreshold && !isEnoughStat;
+  // Check fit quality
+  const auto& meanGaus = mTimeCalibObject->mTime[channel].mGausMean;
+  const auto& meanHist = mTimeCalibObject->mTime[channel].mStatMean;
+  const auto& sigmaGaus = mTimeCalibObject->mTime[channel].mGausRMS;
+  const auto& rmsHist = mTimeCalibObject->mTime[channel].mStatRMS;
+  const bool isGoodFitResult = (mTimeCalibObject->mTime[channel].mStatusBits & 1) > 0;
+  const bool isBadFit = std::abs(meanGaus - meanHist) > CalibParam::Instance().mMaxDiffMean || rmsHist < CalibParam::Instance().mMinRMS || sigmaGaus > CalibParam::Instance().mMaxSigma;
 
-    if (isEnoughStat && isGoodFitResult && !isBadFit) {
-      offsetChannel = meanGaus;
-    } else if ((isNotGoogStat || isEnoughStat) && isBadFit) {
-      offsetChannel = meanHist;
-    }
+  if (isEnoughStat && isGoodFitResult && !isBadFit) {
+    return meanGaus;
+  } else if ((isNotGoogStat || isEnoughStat) && isBadFit) {
+    return meanHist;
   }
+  return 0;
+}
+
+float CollisionTimeRecoTask::getTimeInPS(const o2::ft0::ChannelData& channelData)
+{
+  // Getting time offset from the table derived at calibration update
+  const float offsetChannel = mTimeCalib.getOffset(channelData.ChId);
   // Getting slewing offset
   float slewoffset{0};
   const auto& gr = mCalibSlew[static_cast<int>(channelData.getFlag(o2::ft0::ChannelData::EEventDataBit::kNumberADC))][channelData.ChId];
@@ -18,7 +18,9 @@
 #include "DataFormatsFV0/ChannelData.h"
 #include "DataFormatsFV0/RecPoints.h"
 #include "DataFormatsFV0/FV0ChannelTimeCalibrationObject.h"
+#include "FITReconstruction/TimeCalibEngine.h"
 #include <gsl/span>
+#include <vector>
 
 namespace o2
 {
@@ -35,11 +37,22 @@ class BaseRecoTask
                              gsl::span<const o2::fv0::ChannelData> inChData,
                              gsl::span<o2::fv0::ChannelDataFloat> outChData);
   void FinishTask();
-  void SetChannelOffset(o2::fv0::FV0ChannelTimeCalibrationObject const* caliboffsets) { mCalibOffset = caliboffsets; };
+  void SetChannelOffset(o2::fv0::FV0ChannelTimeCalibrationObject const* caliboffsets)
+  {
+    mCalibOffset = caliboffsets;
+    // derive the flat offset table once per calibration update
+    if (mCalibOffset != nullptr) {
+      mTimeCalib.update([this](int channel) { return float(mCalibOffset->mTimeOffsets[channel]); });
+    } else {
+      mTimeCalib.reset();
+    }
+  };
   int getOffset(int channel);
 
  private:
   o2::fv0::FV0ChannelTimeCalibrationObject const* mCalibOffset = nullptr;
+  o2::fit::TimeCalibEngine<Constants::nFv0Channels> mTimeCalib{}; //! flat per-channel offsets with batch application
+  std::vector<float> mCalibTimes{};                               //! calibrated times of the digit being processed
 
   ClassDefNV(BaseRecoTask, 3);
 };
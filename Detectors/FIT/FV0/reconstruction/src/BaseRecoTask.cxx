@@ -42,11 +42,12 @@ RP BaseRecoTask::process(o2::fv0::Digit const& bcd,
   LOG(debug) << " event time " << timeStamp << " orbit " << bcd.getIntRecord().orbit << " bc " << bcd.getIntRecord().bc;
 
   int nch = inChData.size();
+  // calibrate all the channel times of this digit in one pass over the block
+  mTimeCalib.calibrate(inChData, DigitizationConstant::TIME_PER_TDCCHANNEL, mCalibTimes);
   for (int ich = 0; ich < nch; ich++) {
     LOG(debug) << "  channel " << ich << " / " << nch;
-    int offsetChannel = getOffset(int(inChData[ich].ChId));
     outChData[ich] = o2::fv0::ChannelDataFloat{inChData[ich].ChId,
-                                               (inChData[ich].CFDTime - offsetChannel) * DigitizationConstant::TIME_PER_TDCCHANNEL,
+                                               mCalibTimes[ich],
                                                (float)inChData[ich].QTCAmpl,
                                                inChData[ich].ChainQTC};
 
@@ -82,9 +83,5 @@ void BaseRecoTask::FinishTask()
 //______________________________________________________
 int BaseRecoTask::getOffset(int channel)
 {
-  if (!mCalibOffset) {
-    return 0;
-  }
-  int offsetChannel = mCalibOffset->mTimeOffsets[channel];
-  return offsetChannel;
+  return mTimeCalib.getOffset(channel);
 }
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TimeCalibEngine.h
+/// \brief Per-channel time calibration engine shared by the FIT subdetectors
+
+#ifndef ALICEO2_FIT_TIMECALIBENGINE_H
+#define ALICEO2_FIT_TIMECALIBENGINE_H
+
+#include <array>
+#include <vector>
+#include <gsl/span>
+
+namespace o2
+{
+namespace fit
+{
+/// \class TimeCalibEngine
+/// \brief Flat per-channel time offsets with batch application
+///
+/// The static time offset of a channel depends only on the calibration object,
+/// not on the hit, so it is derived once per calibration update into a flat
+/// table instead of being re-derived for every hit of every event. The
+/// subdetectors instantiate the engine with their channel count and provide
+/// the detector-specific derivation rule when the CCDB object changes; hits
+/// are then calibrated with plain table lookups, and whole blocks of channel
+/// data can be converted in a single pass over the packed arrays.
+template <int NChannels>
+class TimeCalibEngine
+{
+ public:
+  static constexpr int sNChannels = NChannels;
+
+  /// re-derive the per-channel offsets from a new calibration object;
+  /// deriveOffset(channel) implements the detector-specific rules
+  template <typename OffsetDeriver>
+  void update(OffsetDeriver deriveOffset)
+  {
+    for (int ich = 0; ich < NChannels; ich++) {
+      mOffsets[ich] = deriveOffset(ich);
+    }
+    mHasCalib = true;
+  }
+
+  void reset()
+  {
+    mOffsets.fill(0.f);
+    mHasCalib = false;
+  }
+
+  bool hasCalib() const { return mHasCalib; }
+  float getOffset(int channel) const { return mOffsets[channel]; }
+
+  /// calibrated time of a single hit in output units: (raw - offset) * scale
+  float calibrate(int channel, float rawTime, float scale) const
+  {
+    return (rawTime - mOffsets[channel]) * scale;
+  }
+
+  /// one pass over a block of channel data; ChannelT needs the common FIT
+  /// ChId/CFDTime fields. The output vector is resized to the block length.
+  template <typename ChannelT>
+  void calibrate(gsl::span<const ChannelT> channels, float scale, std::vector<float>& times) const
+  {
+    times.resize(channels.size());
+    for (size_t ic = 0; ic < channels.size(); ic++) {
+      times[ic] = (static_cast<float>(channels[ic].CFDTime) - mOffsets[channels[ic].ChId]) * scale;
+    }
+  }
+
+ private:
+  std::array<float, NChannels> mOffsets{}; ///< static time offset per channel
+  bool mHasCalib = false;                  ///< offsets were derived from a calibration object
+};
+} // namespace fit
+} // namespace o2
+
+#endif // ALICEO2_FIT_TIMECALIBENGINE_H
@@ -146,6 +146,7 @@ void FilteringSpec::finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
 
 void FilteringSpec::init(InitContext& ic)
 {
+  mSelections.compile(ic.options().get<std::string>("track-selections"));
 }
 
 void FilteringSpec::clear()
@@ -299,16 +300,20 @@ bool FilteringSpec::selectTrack(GIndex id, const o2::globaltracking::RecoContain
   } else {                                                                                 // for the rest, get the track directly
     t = recoData.getTrack<o2::track::TrackParCov>(id);
   }
-  // select on track kinematics, for example, on pT
-  if (t.getPt() < 2.) {
-    return false;
-  }
-  return true;
+  // select on track kinematics via the compiled selections
+  SelectionEngine::Summary summary;
+  summary[SelectionEngine::VarPt] = t.getPt();
+  summary[SelectionEngine::VarEta] = t.getEta();
+  summary[SelectionEngine::VarAbsEta] = std::abs(t.getEta());
+  summary[SelectionEngine::VarPhi] = t.getPhi();
+  summary[SelectionEngine::VarTgl] = t.getTgl();
+  return mSelections.evaluate(summary);
 }
 
 void FilteringSpec::endOfStream(EndOfStreamContext& ec)
 {
   LOGF(info, "data filtering total timing: Cpu: %.3e Real: %.3e s in %d slots", mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
+  mSelections.printCounters();
 }
 
 void FilteringSpec::updateTimeDependentParams(ProcessingContext& pc)
@@ -347,7 +352,9 @@ DataProcessorSpec getDataFilteringSpec(GID::mask_t src, bool enableSV, bool useM
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<FilteringSpec>(src, dataRequest, enableSV, useMC)},
-    Options{/*ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}}*/}};
+    Options{
+      ConfigParamSpec{"track-selections", VariantType::String, "highPt:pt>2", {"Track selections as name:expression pairs separated by ;, comparisons joined with &&, e.g. highPt:pt>2;central:abseta<0.8&&pt>0.5"}},
+      /*ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}}*/}};
 }
 
 } // namespace o2::filtering
@@ -15,6 +15,7 @@
 #define O2_DATA_FILTERING_SPEC
 
 #include "DataFormatsGlobalTracking/FilteredRecoTF.h"
+#include "SelectionEngine.h"
 
 #include "CCDB/BasicCCDBManager.h"
 #include "DataFormatsFT0/RecPoints.h"
@@ -85,6 +86,8 @@ class FilteringSpec : public Task
   GID::mask_t mInputSources;
   TStopwatch mTimer;
 
+  SelectionEngine mSelections; // compiled track selections
+
   bool mNeedToSave = false;                // flag that there was something selected to save
   std::map<int, int> mITSTrackIDCache{};   // cache for selected ITS track IDS
   std::map<int, int> mITSClusterIDCache{}; // cache for selected ITS clusters
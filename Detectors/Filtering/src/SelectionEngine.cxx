@@ -0,0 +1,129 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   SelectionEngine.cxx
+
+#include "SelectionEngine.h"
+#include "Framework/Logger.h"
+#include <regex>
+
+namespace o2::filtering
+{
+
+SelectionEngine::Variable SelectionEngine::parseVariable(const std::string& name)
+{
+  if (name == "pt") {
+    return VarPt;
+  }
+  if (name == "eta") {
+    return VarEta;
+  }
+  if (name == "abseta") {
+    return VarAbsEta;
+  }
+  if (name == "phi") {
+    return VarPhi;
+  }
+  if (name == "tgl") {
+    return VarTgl;
+  }
+  LOG(fatal) << "Unknown selection variable \"" << name << "\", available: pt, eta, abseta, phi, tgl";
+  return NVariables;
+}
+
+void SelectionEngine::compile(const std::string& config)
+{
+  mPredicates.clear();
+  mSelections.clear();
+  if (config.empty()) {
+    return;
+  }
+  static const std::regex comparisonRE(R"(^\s*([a-z]+)\s*(<=|>=|<|>)\s*([-+]?[0-9]*\.?[0-9]+(?:[eE][-+]?[0-9]+)?)\s*$)");
+  std::regex selectionsRE(";");
+  std::regex predicatesRE("&&");
+  std::sregex_token_iterator selIter(config.begin(), config.end(), selectionsRE, -1), endIter;
+  for (; selIter != endIter; ++selIter) {
+    auto selStr = selIter->str();
+    auto colon = selStr.find(':');
+    if (colon == std::string::npos) {
+      LOG(fatal) << "Malformed selection \"" << selStr << "\", expecting \"name:expression\"";
+    }
+    auto& sel = mSelections.emplace_back();
+    sel.name = selStr.substr(0, colon);
+    sel.firstPredicate = mPredicates.size();
+    auto exprStr = selStr.substr(colon + 1);
+    std::sregex_token_iterator predIter(exprStr.begin(), exprStr.end(), predicatesRE, -1);
+    for (; predIter != endIter; ++predIter) {
+      std::smatch match;
+      auto predStr = predIter->str();
+      if (!std::regex_match(predStr, match, comparisonRE)) {
+        LOG(fatal) << "Malformed comparison \"" << predStr << "\" in selection \"" << sel.name << "\"";
+      }
+      auto& pred = mPredicates.emplace_back();
+      pred.var = parseVariable(match[1].str());
+      const auto& opStr = match[2].str();
+      pred.op = opStr == "<" ? OpLT : opStr == "<=" ? OpLE
+                                    : opStr == ">"  ? OpGT
+                                                    : OpGE;
+      pred.value = std::stof(match[3].str());
+    }
+    sel.nPredicates = mPredicates.size() - sel.firstPredicate;
+    if (sel.nPredicates == 0) {
+      LOG(fatal) << "Selection \"" << sel.name << "\" has no comparisons";
+    }
+    LOGF(info, "Compiled selection %s with %d comparison(s)", sel.name, sel.nPredicates);
+  }
+}
+
+bool SelectionEngine::evaluate(const Summary& summary)
+{
+  bool selected = false;
+  for (auto& sel : mSelections) {
+    bool pass = true;
+    const auto* pred = mPredicates.data() + sel.firstPredicate;
+    for (uint32_t i = 0; i < sel.nPredicates; i++, pred++) {
+      const float v = summary[pred->var];
+      switch (pred->op) {
+        case OpLT:
+          pass = v < pred->value;
+          break;
+        case OpLE:
+          pass = v <= pred->value;
+          break;
+        case OpGT:
+          pass = v > pred->value;
+          break;
+        default:
+          pass = v >= pred->value;
+          break;
+      }
+      if (!pass) {
+        break;
+      }
+    }
+    if (pass) {
+      sel.nPassed++;
+      selected = true;
+    } else {
+      sel.nFailed++;
+    }
+  }
+  return selected;
+}
+
+void SelectionEngine::printCounters() const
+{
+  for (const auto& sel : mSelections) {
+    LOGF(info, "Selection %s: passed %zu, failed %zu candidates", sel.name, sel.nPassed, sel.nFailed);
+  }
+}
+
+} // namespace o2::filtering
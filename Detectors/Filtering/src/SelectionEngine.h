@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   SelectionEngine.h
+/// @brief  Compiled track/event selections for the data filtering workflow
+
+#ifndef O2_DATA_FILTERING_SELECTION_ENGINE
+#define O2_DATA_FILTERING_SELECTION_ENGINE
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace o2::filtering
+{
+
+/// Evaluates named selections against a flat summary of track properties.
+///
+/// Selections are provided as a configuration string and compiled once, at
+/// init time, into a flat vector of predicates (variable index, comparison,
+/// threshold). Per candidate only this vector is scanned, there is no string
+/// or expression handling on the hot path. Each selection keeps pass/fail
+/// counters which can be printed at the end of the stream.
+///
+/// Configuration syntax: semicolon-separated list of "name:expression", where
+/// an expression is a conjunction of comparisons "variable op value" joined
+/// with "&&", e.g. "highPt:pt>2;central:abseta<0.8&&pt>0.5".
+/// A candidate is selected if at least one selection passes.
+class SelectionEngine
+{
+ public:
+  /// variables a selection can cut on, indices into the per-candidate summary
+  enum Variable : uint8_t { VarPt,
+                            VarEta,
+                            VarAbsEta,
+                            VarPhi,
+                            VarTgl,
+                            NVariables };
+
+  using Summary = std::array<float, NVariables>;
+
+  /// compile the configuration string, LOG(fatal) on malformed input
+  void compile(const std::string& config);
+
+  /// evaluate all selections on the summary, updating the counters;
+  /// returns true if at least one selection passed
+  bool evaluate(const Summary& summary);
+
+  /// log the pass/fail counters of every selection
+  void printCounters() const;
+
+  bool empty() const { return mSelections.empty(); }
+
+ private:
+  enum CompOp : uint8_t { OpLT,
+                          OpLE,
+                          OpGT,
+                          OpGE };
+
+  struct Predicate {
+    uint8_t var = 0;
+    uint8_t op = 0;
+    float value = 0.f;
+  };
+
+  struct Selection {
+    std::string name;
+    uint32_t firstPredicate = 0;
+    uint32_t nPredicates = 0;
+    size_t nPassed = 0;
+    size_t nFailed = 0;
+  };
+
+  static Variable parseVariable(const std::string& name);
+
+  std::vector<Predicate> mPredicates; // flat predicate code of all selections
+  std::vector<Selection> mSelections;
+};
+
+} // namespace o2::filtering
+
+#endif /* O2_DATA_FILTERING_SELECTION_ENGINE */
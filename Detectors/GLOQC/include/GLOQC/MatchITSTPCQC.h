@@ -19,6 +19,7 @@
 #include <TH1D.h>
 #include <TH1F.h>
 #include <TH2F.h>
+#include <THnSparse.h>
 #include <TEfficiency.h>
 #include <TObjArray.h>
 #include "DataFormatsGlobalTracking/RecoContainer.h"
@@ -78,24 +79,24 @@ class MatchITSTPCQC
   TH1F* getHistoPhiDen(matchType m) const { return mPhiDen[m]; }
   TEfficiency* getFractionITSTPCmatchPhi(matchType m) const { return mFractionITSTPCmatchPhi[m]; }
 
-  TH2F* getHistoPhiVsPtNum(matchType m) const { return mPhiVsPtNum[m]; }
-  TH2F* getHistoPhiVsPtDen(matchType m) const { return mPhiVsPtDen[m]; }
+  THnSparseF* getHistoPhiVsPtNum(matchType m) const { return mPhiVsPtNum[m]; }
+  THnSparseF* getHistoPhiVsPtDen(matchType m) const { return mPhiVsPtDen[m]; }
   TEfficiency* getFractionITSTPCmatchPhiVsPt(matchType m) const { return mFractionITSTPCmatchPhiVsPt[m]; }
 
   TH1F* getHistoEtaNum(matchType m) const { return mEtaNum[m]; }
   TH1F* getHistoEtaDen(matchType m) const { return mEtaDen[m]; }
   TEfficiency* getFractionITSTPCmatchEta(matchType m) const { return mFractionITSTPCmatchEta[m]; }
 
-  TH2F* getHistoEtaVsPtNum(matchType m) const { return mEtaVsPtNum[m]; }
-  TH2F* getHistoEtaVsPtDen(matchType m) const { return mEtaVsPtDen[m]; }
+  THnSparseF* getHistoEtaVsPtNum(matchType m) const { return mEtaVsPtNum[m]; }
+  THnSparseF* getHistoEtaVsPtDen(matchType m) const { return mEtaVsPtDen[m]; }
   TEfficiency* getFractionITSTPCmatchEtaVsPt(matchType m) const { return mFractionITSTPCmatchEtaVsPt[m]; }
 
-  TH2F* getHistoClsVsPtNum(matchType m) const { return mClsVsPtNum[m]; }
-  TH2F* getHistoClsVsPtDen(matchType m) const { return mClsVsPtDen[m]; }
+  THnSparseF* getHistoClsVsPtNum(matchType m) const { return mClsVsPtNum[m]; }
+  THnSparseF* getHistoClsVsPtDen(matchType m) const { return mClsVsPtDen[m]; }
   TEfficiency* getFractionITSTPCmatchClsVsPt(matchType m) const { return mFractionITSTPCmatchClsVsPt[m]; }
 
-  TH2F* getHistoChi2VsPtNum(matchType m) const { return mChi2VsPtNum[m]; }
-  TH2F* getHistoChi2VsPtDen(matchType m) const { return mChi2VsPtDen[m]; }
+  THnSparseF* getHistoChi2VsPtNum(matchType m) const { return mChi2VsPtNum[m]; }
+  THnSparseF* getHistoChi2VsPtDen(matchType m) const { return mChi2VsPtDen[m]; }
   TEfficiency* getFractionITSTPCmatchChi2VsPt(matchType m) const { return mFractionITSTPCmatchChi2VsPt[m]; }
 
   TH1F* getHistoPtPhysPrimNum(matchType m) const { return mPtPhysPrimNum[m]; }
@@ -118,8 +119,8 @@ class MatchITSTPCQC
   TH1F* getHistoChi2Refit() const { return mChi2Refit; }
   TH2F* getHistoTimeResVsPt() const { return mTimeResVsPt; }
   TH1F* getHistoDCAr() const { return mDCAr; }
-  TH2F* getHistoDCArVsPtNum() const { return mDCArVsPtNum; }
-  TH2F* getHistoDCArVsPtDen() const { return mDCArVsPtDen; }
+  THnSparseF* getHistoDCArVsPtNum() const { return mDCArVsPtNum; }
+  THnSparseF* getHistoDCArVsPtDen() const { return mDCArVsPtDen; }
   TEfficiency* getFractionITSTPCmatchDCArVsPt() const { return mFractionITSTPCmatchDCArVsPt; }
 
   TH1D* getHisto1OverPtNum(matchType m) const { return m1OverPtNum[m]; }
@@ -332,8 +333,8 @@ class MatchITSTPCQC
   TH1F* mPhiPhysPrimNum[matchType::SIZE] = {};
   TH1F* mPhiPhysPrimDen[matchType::SIZE] = {};
   TEfficiency* mFractionITSTPCmatchPhiPhysPrim[matchType::SIZE] = {};
-  TH2F* mPhiVsPtNum[matchType::SIZE] = {};
-  TH2F* mPhiVsPtDen[matchType::SIZE] = {};
+  THnSparseF* mPhiVsPtNum[matchType::SIZE] = {};
+  THnSparseF* mPhiVsPtDen[matchType::SIZE] = {};
   TEfficiency* mFractionITSTPCmatchPhiVsPt[matchType::SIZE] = {};
   // Phi split per PID hypothesis in tracking
   TH1D* mPhiNumVsTrkPID[matchType::SIZE][track::PID::NIDs] = {};
@@ -346,16 +347,16 @@ class MatchITSTPCQC
   TH1F* mEtaPhysPrimNum[matchType::SIZE] = {};
   TH1F* mEtaPhysPrimDen[matchType::SIZE] = {};
   TEfficiency* mFractionITSTPCmatchEtaPhysPrim[matchType::SIZE] = {};
-  TH2F* mEtaVsPtNum[matchType::SIZE] = {};
-  TH2F* mEtaVsPtDen[matchType::SIZE] = {};
+  THnSparseF* mEtaVsPtNum[matchType::SIZE] = {};
+  THnSparseF* mEtaVsPtDen[matchType::SIZE] = {};
   TEfficiency* mFractionITSTPCmatchEtaVsPt[matchType::SIZE] = {};
   // Clusters
-  TH2F* mClsVsPtNum[matchType::SIZE] = {};
-  TH2F* mClsVsPtDen[matchType::SIZE] = {};
+  THnSparseF* mClsVsPtNum[matchType::SIZE] = {};
+  THnSparseF* mClsVsPtDen[matchType::SIZE] = {};
   TEfficiency* mFractionITSTPCmatchClsVsPt[matchType::SIZE] = {};
   // Chi2
-  TH2F* mChi2VsPtNum[matchType::SIZE] = {};
-  TH2F* mChi2VsPtDen[matchType::SIZE] = {};
+  THnSparseF* mChi2VsPtNum[matchType::SIZE] = {};
+  THnSparseF* mChi2VsPtDen[matchType::SIZE] = {};
   TEfficiency* mFractionITSTPCmatchChi2VsPt[matchType::SIZE] = {};
   // Eta split per PID hypothesis in tracking
   TH1D* mEtaNumVsTrkPID[matchType::SIZE][track::PID::NIDs] = {};
@@ -370,8 +371,8 @@ class MatchITSTPCQC
   TH1F* mChi2Refit = nullptr;
   TH2F* mTimeResVsPt = nullptr;
   TH1F* mDCAr = nullptr;
-  TH2F* mDCArVsPtNum = nullptr;
-  TH2F* mDCArVsPtDen = nullptr;
+  THnSparseF* mDCArVsPtNum = nullptr;
+  THnSparseF* mDCArVsPtDen = nullptr;
   TEfficiency* mFractionITSTPCmatchDCArVsPt = nullptr;
   // 1/Pt
   TH1D* m1OverPtNum[matchType::SIZE] = {};
@@ -382,6 +383,21 @@ class MatchITSTPCQC
   TEfficiency* mFractionITSTPCmatchPhysPrim1OverPt[matchType::SIZE] = {};
 
   void setEfficiency(TEfficiency* eff, TH1* hnum, TH1* hden, bool is2D = false);
+  // refresh the ratio snapshot only if num/den gained entries since the last cycle
+  void updateEfficiency(TEfficiency* eff, TH1* hnum, TH1* hden, bool is2D = false);
+  void updateEfficiency(TEfficiency* eff, THnSparseF* hnum, THnSparseF* hden);
+  bool isEfficiencyUpToDate(const TEfficiency* eff, double numEntries, double denEntries);
+
+  /// fill a 2-dimensional sparse numerator/denominator histogram
+  static void fillSparse(THnSparseF* h, double x, double y)
+  {
+    double v[2] = {x, y};
+    h->Fill(v);
+  }
+
+  // entries of num/den at the last TEfficiency update, to skip ratio
+  // snapshots whose inputs did not change since the previous cycle
+  std::unordered_map<const TEfficiency*, std::pair<double, double>> mEffSnapshot;
 
   int mNTPCSelectedTracks = 0;
   int mNITSSelectedTracks = 0;
@@ -415,7 +431,7 @@ class MatchITSTPCQC
   float mMaxEtaK0 = 0.8;    // cut on the K0 eta
   long int mTimestamp = -1; // timestamp used to load the SVertexParam object: if differnt from -1, we don't load (it means we already did it)
 
-  ClassDefNV(MatchITSTPCQC, 3);
+  ClassDefNV(MatchITSTPCQC, 4);
 };
 } // namespace gloqc
 } // namespace o2
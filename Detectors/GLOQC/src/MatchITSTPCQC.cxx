@@ -17,6 +17,7 @@
 #include "DetectorsBase/Propagator.h"
 #include "SimulationDataFormat/MCUtils.h"
 #include <algorithm>
+#include <memory>
 #include "TGraphAsymmErrors.h"
 #include "GlobalTracking/TrackCuts.h"
 #include <DetectorsBase/GRPGeomHelper.h>
@@ -207,6 +208,9 @@ void MatchITSTPCQC::reset()
   if (mDoK0QC) {
     mK0MassVsPt->Reset();
   }
+
+  // force the next cycle to refresh all efficiencies
+  mEffSnapshot.clear();
 }
 
 //__________________________________________________________
@@ -229,6 +233,18 @@ bool MatchITSTPCQC::init()
     xbinsPt[i] = TMath::Exp(TMath::Log(10) * xlogPt);
   }
 
+  // the 2D numerator/denominator pairs are kept in sparse storage: only the
+  // populated bins travel to the merger, and the dense projection is done
+  // only when the efficiency is refreshed
+  auto makeSparse2D = [](const char* name, const char* title, int nbx, double xlo, double xhi, int nby, double ylo, double yhi) {
+    const int nbins[2] = {nbx, nby};
+    const double xmin[2] = {xlo, ylo};
+    const double xmax[2] = {xhi, yhi};
+    auto h = new THnSparseF(name, title, 2, nbins, xmin, xmax);
+    h->Sumw2();
+    return h;
+  };
+
   LOGP(debug, "Creating Histograms");
   // Data and MC
   for (int i = 0; i < matchType::SIZE; ++i) {
@@ -258,10 +274,8 @@ bool MatchITSTPCQC::init()
     mPhiDen[i] = new TH1F(Form("mPhiDen_%s", title[i].c_str()), Form("Phi distribution of %s tracks %s; Phi [rad]; dNdPhi", title[i].c_str(), etaSel[i].c_str()), 100, 0.f, 2 * TMath::Pi());
     mPhiDen[i]->Sumw2();
     mFractionITSTPCmatchPhi[i] = new TEfficiency(Form("mFractionITSTPCmatchPhi_%s", title[i].c_str()), Form("Fraction of ITSTPC matched tracks vs Phi wrt %s tracks %s; Phi [rad]; Eff", title[i].c_str(), etaSel[i].c_str()), 100, 0.f, 2 * TMath::Pi());
-    mPhiVsPtNum[i] = new TH2F(Form("mPhiVsPtNum_%s", title[i].c_str()), Form("Phi vs Pt distribution of ITSTPC matched tracks wrt %s %s; #it{p}_{T} [GeV#it{c}]; Phi [rad]; dNdPhi", title[i].c_str(), etaSel[i].c_str()), 100, 0.f, 20.f, 100, 0.f, 2 * TMath::Pi());
-    mPhiVsPtNum[i]->Sumw2();
-    mPhiVsPtDen[i] = new TH2F(Form("mPhiVsPtDen_%s", title[i].c_str()), Form("Phi vs Pt distribution of %s tracks %s; #it{p}_{T} [GeV#it{c}]; Phi [rad]; dNdPhi", title[i].c_str(), etaSel[i].c_str()), 100, 0.f, 20.f, 100, 0.f, 2 * TMath::Pi());
-    mPhiVsPtDen[i]->Sumw2();
+    mPhiVsPtNum[i] = makeSparse2D(Form("mPhiVsPtNum_%s", title[i].c_str()), Form("Phi vs Pt distribution of ITSTPC matched tracks wrt %s %s; #it{p}_{T} [GeV#it{c}]; Phi [rad]; dNdPhi", title[i].c_str(), etaSel[i].c_str()), 100, 0.f, 20.f, 100, 0.f, 2 * TMath::Pi());
+    mPhiVsPtDen[i] = makeSparse2D(Form("mPhiVsPtDen_%s", title[i].c_str()), Form("Phi vs Pt distribution of %s tracks %s; #it{p}_{T} [GeV#it{c}]; Phi [rad]; dNdPhi", title[i].c_str(), etaSel[i].c_str()), 100, 0.f, 20.f, 100, 0.f, 2 * TMath::Pi());
     mFractionITSTPCmatchPhiVsPt[i] = new TEfficiency(Form("mFractionITSTPCmatchPhiVsPt_%s", title[i].c_str()), Form("Fraction of ITSTPC matched tracks wrt %s tracks %s, Phi vs Pt; #it{p}_{T} [GeV#it{c}]; Phi [rad]; Eff", title[i].c_str(), etaSel[i].c_str()), 100, 0.f, 20.f, 100, 0.f, 2 * TMath::Pi());
 
     // Eta
@@ -272,24 +286,18 @@ bool MatchITSTPCQC::init()
     mEtaDen[i]->Sumw2();
     mEtaDen[i]->GetYaxis()->SetTitleOffset(1.4);
     mFractionITSTPCmatchEta[i] = new TEfficiency(Form("mFractionITSTPCmatchEta_%s", title[i].c_str()), Form("Fraction of ITSTPC matched tracks , wrt %s tracks, vs Eta; Eta; Eff", title[i].c_str()), 100, -2.f, 2.f);
-    mEtaVsPtNum[i] = new TH2F(Form("mEtaVsPtNum_%s", title[i].c_str()), Form("Eta vs Pt distribution of ITSTPC matched tracks, wrt %s tracks; #it{p}_{T} [GeV#it{c}]; Eta", title[i].c_str()), 100, 0.f, 20.f, 100, -2.f, 2.f);
-    mEtaVsPtNum[i]->Sumw2();
-    mEtaVsPtDen[i] = new TH2F(Form("mEtaVsPtDen_%s", title[i].c_str()), Form("Eta vs Pt distribution of %s tracks; #it{p}_{T} [GeV#it{c}]; Eta", title[i].c_str()), 100, 0.f, 20.f, 100, -2.f, 2.f);
-    mEtaVsPtDen[i]->Sumw2();
+    mEtaVsPtNum[i] = makeSparse2D(Form("mEtaVsPtNum_%s", title[i].c_str()), Form("Eta vs Pt distribution of ITSTPC matched tracks, wrt %s tracks; #it{p}_{T} [GeV#it{c}]; Eta", title[i].c_str()), 100, 0.f, 20.f, 100, -2.f, 2.f);
+    mEtaVsPtDen[i] = makeSparse2D(Form("mEtaVsPtDen_%s", title[i].c_str()), Form("Eta vs Pt distribution of %s tracks; #it{p}_{T} [GeV#it{c}]; Eta", title[i].c_str()), 100, 0.f, 20.f, 100, -2.f, 2.f);
     mFractionITSTPCmatchEtaVsPt[i] = new TEfficiency(Form("mFractionITSTPCmatchEtaVsPt_%s", title[i].c_str()), Form("Fraction of ITSTPC matched tracks, wrt %s tracks, Eta vs Pt; #it{p}_{T} [GeV#it{c}]; Eta; Eff", title[i].c_str()), 100, 0.f, 20.f, 100, -2.f, 2.f);
 
     // Clusters
-    mClsVsPtNum[i] = new TH2F(Form("mClsVsPtNum_%s", title[i].c_str()), Form("#Clusters vs Pt distribution of ITSTPC matched tracks, wrt %s tracks; #it{p}_{T} [GeV#it{c}]; #Clusters", title[i].c_str()), 100, 0.f, 20.f, maxNCls[i], 0, maxNCls[i]);
-    mClsVsPtNum[i]->Sumw2();
-    mClsVsPtDen[i] = new TH2F(Form("mClsVsPtDen_%s", title[i].c_str()), Form("#Clusters vs Pt distribution of %s tracks; #it{p}_{T} [GeV#it{c}]; #Clusters", title[i].c_str()), 100, 0.f, 20.f, maxNCls[i], 0, maxNCls[i]);
-    mClsVsPtDen[i]->Sumw2();
+    mClsVsPtNum[i] = makeSparse2D(Form("mClsVsPtNum_%s", title[i].c_str()), Form("#Clusters vs Pt distribution of ITSTPC matched tracks, wrt %s tracks; #it{p}_{T} [GeV#it{c}]; #Clusters", title[i].c_str()), 100, 0.f, 20.f, maxNCls[i], 0, maxNCls[i]);
+    mClsVsPtDen[i] = makeSparse2D(Form("mClsVsPtDen_%s", title[i].c_str()), Form("#Clusters vs Pt distribution of %s tracks; #it{p}_{T} [GeV#it{c}]; #Clusters", title[i].c_str()), 100, 0.f, 20.f, maxNCls[i], 0, maxNCls[i]);
     mFractionITSTPCmatchClsVsPt[i] = new TEfficiency(Form("mFractionITSTPCmatchClsVsPt_%s", title[i].c_str()), Form("Fraction of ITSTPC matched tracks, wrt %s tracks, #Clusters vs Pt; #it{p}_{T} [GeV#it{c}]; #Clusters; Eff", title[i].c_str()), 100, 0.f, 20.f, maxNCls[i], 0, maxNCls[i]);
 
     // Chi2
-    mChi2VsPtNum[i] = new TH2F(Form("mChi2VsPtNum_%s", title[i].c_str()), Form("Chi2 vs Pt distribution of ITSTPC matched tracks, wrt %s tracks; #it{p}_{T} [GeV#it{c}]; Chi2", title[i].c_str()), 100, 0.f, 20.f, 200, 0, 300);
-    mChi2VsPtNum[i]->Sumw2();
-    mChi2VsPtDen[i] = new TH2F(Form("mChi2VsPtDen_%s", title[i].c_str()), Form("Chi2 vs Pt distribution of %s tracks; #it{p}_{T} [GeV#it{c}]; Chi2", title[i].c_str()), 100, 0.f, 20.f, 200, 0, 300);
-    mChi2VsPtDen[i]->Sumw2();
+    mChi2VsPtNum[i] = makeSparse2D(Form("mChi2VsPtNum_%s", title[i].c_str()), Form("Chi2 vs Pt distribution of ITSTPC matched tracks, wrt %s tracks; #it{p}_{T} [GeV#it{c}]; Chi2", title[i].c_str()), 100, 0.f, 20.f, 200, 0, 300);
+    mChi2VsPtDen[i] = makeSparse2D(Form("mChi2VsPtDen_%s", title[i].c_str()), Form("Chi2 vs Pt distribution of %s tracks; #it{p}_{T} [GeV#it{c}]; Chi2", title[i].c_str()), 100, 0.f, 20.f, 200, 0, 300);
     mFractionITSTPCmatchChi2VsPt[i] = new TEfficiency(Form("mFractionITSTPCmatchChi2VsPt_%s", title[i].c_str()), Form("Fraction of ITSTPC matched tracks, wrt %s tracks, Chi2 vs Pt; #it{p}_{T} [GeV#it{c}]; Chi2; Eff", title[i].c_str()), 100, 0.f, 20.f, 200, 0, 300);
 
     // 1/pt
@@ -335,10 +343,8 @@ bool MatchITSTPCQC::init()
   mChi2Refit->SetOption("logy");
   mChi2Refit->GetYaxis()->SetTitleOffset(1.4);
   mDCAr = new TH1F("mDCAr", "DCA of TPC tracks; DCAr", 200, -100, 100);
-  mDCArVsPtNum = new TH2F("mDCArVsPtNum", "DCA of TPC tracks Vs Pt Num; #it{p}_{T} [GeV/c]; DCAr", 100, 0, 20., 200, -30, 30);
-  mDCArVsPtNum->Sumw2();
-  mDCArVsPtDen = new TH2F("mDCArVsPtDen", "DCA of TPC tracks Vs Pt Den; #it{p}_{T} [GeV/c]; DCAr", 100, 0, 20., 200, -30, 30);
-  mDCArVsPtDen->Sumw2();
+  mDCArVsPtNum = makeSparse2D("mDCArVsPtNum", "DCA of TPC tracks Vs Pt Num; #it{p}_{T} [GeV/c]; DCAr", 100, 0, 20., 200, -30, 30);
+  mDCArVsPtDen = makeSparse2D("mDCArVsPtDen", "DCA of TPC tracks Vs Pt Den; #it{p}_{T} [GeV/c]; DCAr", 100, 0, 20., 200, -30, 30);
   mFractionITSTPCmatchDCArVsPt = new TEfficiency("mFractionITSTPCmatchDCArVsPt", "Fraction of ITSTPC matched tracks wrt TPC vs DCAr; #it{p}_{T} [GeV#it{c}]; DCAr; Eff", 100, 0, 20., 200, -30, 30);
 
   mTimeResVsPt = new TH2F("mTimeResVsPt", "Time resolution vs Pt; Pt [GeV/c]; time res [us]", nbinsPt, xbinsPt, 100, 0.f, 2.f);
@@ -555,7 +561,7 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
             mPtNum_noEta0[i]->Fill(trkDen.getPt());
           }
           mPhiNum[i]->Fill(trkDen.getPhi());
-          mPhiVsPtNum[i]->Fill(trkDen.getPt(), trkDen.getPhi());
+          fillSparse(mPhiVsPtNum[i], trkDen.getPt(), trkDen.getPhi());
           m1OverPtNum[i]->Fill(trkDen.getSign() * trkDen.getPtInv());
           // we fill also the denominator
           mPtDen[i]->Fill(trkDen.getPt());
@@ -563,7 +569,7 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
             mPtDen_noEta0[i]->Fill(trkDen.getPt());
           }
           mPhiDen[i]->Fill(trkDen.getPhi());
-          mPhiVsPtDen[i]->Fill(trkDen.getPt(), trkDen.getPhi());
+          fillSparse(mPhiVsPtDen[i], trkDen.getPt(), trkDen.getPhi());
           m1OverPtDen[i]->Fill(trkDen.getSign() * trkDen.getPtInv());
           if (mUseTrkPID) { // Vs Tracking PID hypothesis
             mPtNumVsTrkPID[i][trkDen.getPID()]->Fill(trkDen.getPt());
@@ -574,28 +580,28 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
           }
         }
         mEtaNum[i]->Fill(trkDen.getEta());
-        mEtaVsPtNum[i]->Fill(trkDen.getPt(), trkDen.getEta());
+        fillSparse(mEtaVsPtNum[i], trkDen.getPt(), trkDen.getEta());
         // we fill also the denominator
         mEtaDen[i]->Fill(trkDen.getEta());
-        mEtaVsPtDen[i]->Fill(trkDen.getPt(), trkDen.getEta());
+        fillSparse(mEtaVsPtDen[i], trkDen.getPt(), trkDen.getEta());
         if (i == matchType::TPC) {
           auto tpcTrk = mTPCTracks[trk.getRefTPC()];
-          mClsVsPtNum[i]->Fill(tpcTrk.getPt(), tpcTrk.getNClusters());
-          mChi2VsPtNum[i]->Fill(tpcTrk.getPt(), tpcTrk.getChi2());
-          mClsVsPtDen[i]->Fill(tpcTrk.getPt(), tpcTrk.getNClusters());
-          mChi2VsPtDen[i]->Fill(tpcTrk.getPt(), tpcTrk.getChi2());
+          fillSparse(mClsVsPtNum[i], tpcTrk.getPt(), tpcTrk.getNClusters());
+          fillSparse(mChi2VsPtNum[i], tpcTrk.getPt(), tpcTrk.getChi2());
+          fillSparse(mClsVsPtDen[i], tpcTrk.getPt(), tpcTrk.getNClusters());
+          fillSparse(mChi2VsPtDen[i], tpcTrk.getPt(), tpcTrk.getChi2());
           math_utils::Point3D<float> v{};
           std::array<float, 2> dca{};
           if (tpcTrk.propagateParamToDCA(v, mBz, &dca)) {
-            mDCArVsPtNum->Fill(tpcTrk.getPt(), dca[0]);
-            mDCArVsPtDen->Fill(tpcTrk.getPt(), dca[0]);
+            fillSparse(mDCArVsPtNum, tpcTrk.getPt(), dca[0]);
+            fillSparse(mDCArVsPtDen, tpcTrk.getPt(), dca[0]);
           }
         } else {
           const auto& itsTrk = mITSTracks[trk.getRefITS()];
-          mClsVsPtNum[i]->Fill(itsTrk.getPt(), itsTrk.getNClusters());
-          mChi2VsPtNum[i]->Fill(itsTrk.getPt(), itsTrk.getChi2());
-          mClsVsPtDen[i]->Fill(itsTrk.getPt(), itsTrk.getNClusters());
-          mChi2VsPtDen[i]->Fill(itsTrk.getPt(), itsTrk.getChi2());
+          fillSparse(mClsVsPtNum[i], itsTrk.getPt(), itsTrk.getNClusters());
+          fillSparse(mChi2VsPtNum[i], itsTrk.getPt(), itsTrk.getChi2());
+          fillSparse(mClsVsPtDen[i], itsTrk.getPt(), itsTrk.getNClusters());
+          fillSparse(mChi2VsPtDen[i], itsTrk.getPt(), itsTrk.getChi2());
         }
         if (mUseTrkPID) { // Vs Tracking PID hypothesis
           mEtaNumVsTrkPID[i][trkDen.getPID()]->Fill(trkDen.getEta());
@@ -676,22 +682,22 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
               mPtNumVsTrkPID[i][trkRef.getPID()]->Fill(trkRef.getPt());
               mPhiNumVsTrkPID[i][trkRef.getPID()]->Fill(trkRef.getPhi());
             }
-            mPhiVsPtNum[i]->Fill(trkRef.getPt(), trkRef.getPhi());
+            fillSparse(mPhiVsPtNum[i], trkRef.getPt(), trkRef.getPhi());
             m1OverPtNum[i]->Fill(trkRef.getSign() * trkRef.getPtInv());
           }
           mEtaNum[i]->Fill(trkRef.getEta());
           if (mUseTrkPID) { // Vs Tracking PID hypothesis
             mEtaNumVsTrkPID[i][trkRef.getPID()]->Fill(trkRef.getEta());
           }
-          mEtaVsPtNum[i]->Fill(trkRef.getPt(), trkRef.getEta());
+          fillSparse(mEtaVsPtNum[i], trkRef.getPt(), trkRef.getEta());
           if (i == matchType::TPC) {
             const auto& tpcTrk = mTPCTracks[trk.getRefTPC()];
-            mClsVsPtNum[i]->Fill(tpcTrk.getPt(), tpcTrk.getNClusters());
-            mChi2VsPtNum[i]->Fill(tpcTrk.getPt(), tpcTrk.getChi2());
+            fillSparse(mClsVsPtNum[i], tpcTrk.getPt(), tpcTrk.getNClusters());
+            fillSparse(mChi2VsPtNum[i], tpcTrk.getPt(), tpcTrk.getChi2());
           } else {
             const auto& itsTrk = mITSTracks[trk.getRefITS()];
-            mClsVsPtNum[i]->Fill(itsTrk.getPt(), itsTrk.getNClusters());
-            mChi2VsPtNum[i]->Fill(itsTrk.getPt(), itsTrk.getChi2());
+            fillSparse(mClsVsPtNum[i], itsTrk.getPt(), itsTrk.getNClusters());
+            fillSparse(mChi2VsPtNum[i], itsTrk.getPt(), itsTrk.getChi2());
           }
         }
         if (i == matchType::TPC) {
@@ -706,7 +712,7 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
           if (trkRef.propagateParamToDCA(v, mBz, &dca)) {
             mDCAr->Fill(dca[0]);
             if (!mUseMC) {
-              mDCArVsPtNum->Fill(trkRef.getPt(), dca[0]);
+              fillSparse(mDCArVsPtNum, trkRef.getPt(), dca[0]);
             }
           }
           LOG(debug) << "*** chi2Matching = " << trk.getChi2Match() << ", chi2refit = " << trk.getChi2Refit() << ", timeResolution = " << trk.getTimeMUS().getTimeStampError();
@@ -797,16 +803,16 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
         mPtDen_noEta0[matchType::TPC]->Fill(trk.getPt());
       }
       mPhiDen[matchType::TPC]->Fill(trk.getPhi());
-      mPhiVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getPhi());
+      fillSparse(mPhiVsPtDen[matchType::TPC], trk.getPt(), trk.getPhi());
       mEtaDen[matchType::TPC]->Fill(trk.getEta());
-      mEtaVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getEta());
+      fillSparse(mEtaVsPtDen[matchType::TPC], trk.getPt(), trk.getEta());
       m1OverPtDen[matchType::TPC]->Fill(trk.getSign() * trk.getPtInv());
-      mClsVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getNClusters());
-      mChi2VsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getChi2());
+      fillSparse(mClsVsPtDen[matchType::TPC], trk.getPt(), trk.getNClusters());
+      fillSparse(mChi2VsPtDen[matchType::TPC], trk.getPt(), trk.getChi2());
       math_utils::Point3D<float> v{};
       std::array<float, 2> dca{};
       if (auto trc = trk; trc.propagateParamToDCA(v, mBz, &dca)) {
-        mDCArVsPtDen->Fill(trc.getPt(), dca[0]);
+        fillSparse(mDCArVsPtDen, trc.getPt(), dca[0]);
       }
       if (el.second.mIsPhysicalPrimary) {
         mPtPhysPrimDen[matchType::TPC]->Fill(trk.getPt());
@@ -824,13 +830,13 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
           mPtDen_noEta0[matchType::ITS]->Fill(trk.getPt());
         }
         mPhiDen[matchType::ITS]->Fill(trk.getPhi());
-        mPhiVsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getPhi());
+        fillSparse(mPhiVsPtDen[matchType::ITS], trk.getPt(), trk.getPhi());
         m1OverPtDen[matchType::ITS]->Fill(trk.getSign() * trk.getPtInv());
       }
       mEtaDen[matchType::ITS]->Fill(trk.getEta());
-      mEtaVsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getEta());
-      mClsVsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getNClusters());
-      mChi2VsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getChi2());
+      fillSparse(mEtaVsPtDen[matchType::ITS], trk.getPt(), trk.getEta());
+      fillSparse(mClsVsPtDen[matchType::ITS], trk.getPt(), trk.getNClusters());
+      fillSparse(mChi2VsPtDen[matchType::ITS], trk.getPt(), trk.getChi2());
       if (el.second.mIsPhysicalPrimary) {
         if (std::abs(trk.getEta()) < 0.9) {
           mPtPhysPrimDen[matchType::ITS]->Fill(trk.getPt());
@@ -854,16 +860,16 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
           LOG(debug) << "Track (ITS) " << itrk << " with pt = " << trk.getPt() << " and eta = " << trk.getEta() << " not used for den pt, phi, phi vs pt, 1.pt histos";
         }
         mPhiDen[matchType::TPC]->Fill(trk.getPhi());
-        mPhiVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getPhi());
+        fillSparse(mPhiVsPtDen[matchType::TPC], trk.getPt(), trk.getPhi());
         mEtaDen[matchType::TPC]->Fill(trk.getEta());
-        mEtaVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getEta());
+        fillSparse(mEtaVsPtDen[matchType::TPC], trk.getPt(), trk.getEta());
         m1OverPtDen[matchType::TPC]->Fill(trk.getSign() * trk.getPtInv());
-        mClsVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getNClusters());
-        mChi2VsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getChi2());
+        fillSparse(mClsVsPtDen[matchType::TPC], trk.getPt(), trk.getNClusters());
+        fillSparse(mChi2VsPtDen[matchType::TPC], trk.getPt(), trk.getChi2());
         math_utils::Point3D<float> v{};
         std::array<float, 2> dca{};
         if (auto trc = trk; trc.propagateParamToDCA(v, mBz, &dca)) {
-          mDCArVsPtDen->Fill(trc.getPt(), dca[0]);
+          fillSparse(mDCArVsPtDen, trc.getPt(), dca[0]);
         }
         ++mNTPCSelectedTracks;
       }
@@ -879,15 +885,15 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
             mPtDen_noEta0[matchType::ITS]->Fill(trk.getPt());
           }
           mPhiDen[matchType::ITS]->Fill(trk.getPhi());
-          mPhiVsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getPhi());
+          fillSparse(mPhiVsPtDen[matchType::ITS], trk.getPt(), trk.getPhi());
           m1OverPtDen[matchType::ITS]->Fill(trk.getSign() * trk.getPtInv());
         } else {
           LOG(debug) << "Track (ITS) " << itrk << " with pt = " << trk.getPt() << " and eta = " << trk.getEta() << " not used for num pt, phi, phi vs pt, 1.pt histos";
         }
         mEtaDen[matchType::ITS]->Fill(trk.getEta());
-        mEtaVsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getEta());
-        mClsVsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getNClusters());
-        mChi2VsPtDen[matchType::ITS]->Fill(trk.getPt(), trk.getChi2());
+        fillSparse(mEtaVsPtDen[matchType::ITS], trk.getPt(), trk.getEta());
+        fillSparse(mClsVsPtDen[matchType::ITS], trk.getPt(), trk.getNClusters());
+        fillSparse(mChi2VsPtDen[matchType::ITS], trk.getPt(), trk.getChi2());
         ++mNITSSelectedTracks;
       } else {
         LOG(debug) << "Not filling for this track (ITS) " << itrk << " with pt = " << trk.getPt();
@@ -1036,30 +1042,30 @@ void MatchITSTPCQC::finalize()
     }
 
     // filling the efficiency
-    setEfficiency(mFractionITSTPCmatch[ti], mPtNum[ti], mPtDen[ti]);
-    setEfficiency(mFractionITSTPCmatch_noEta0[ti], mPtNum_noEta0[ti], mPtDen_noEta0[ti]);
-    setEfficiency(mFractionITSTPCmatchPhi[ti], mPhiNum[ti], mPhiDen[ti]);
-    setEfficiency(mFractionITSTPCmatchEta[ti], mEtaNum[ti], mEtaDen[ti]);
-    setEfficiency(mFractionITSTPCmatchPhiVsPt[ti], mPhiVsPtNum[ti], mPhiVsPtDen[ti], true);
-    setEfficiency(mFractionITSTPCmatchEtaVsPt[ti], mEtaVsPtNum[ti], mEtaVsPtDen[ti], true);
-    setEfficiency(mFractionITSTPCmatch1OverPt[ti], m1OverPtNum[ti], m1OverPtDen[ti]);
-    setEfficiency(mFractionITSTPCmatchClsVsPt[ti], mClsVsPtNum[ti], mClsVsPtDen[ti], true);
-    setEfficiency(mFractionITSTPCmatchChi2VsPt[ti], mChi2VsPtNum[ti], mChi2VsPtDen[ti], true);
+    updateEfficiency(mFractionITSTPCmatch[ti], mPtNum[ti], mPtDen[ti]);
+    updateEfficiency(mFractionITSTPCmatch_noEta0[ti], mPtNum_noEta0[ti], mPtDen_noEta0[ti]);
+    updateEfficiency(mFractionITSTPCmatchPhi[ti], mPhiNum[ti], mPhiDen[ti]);
+    updateEfficiency(mFractionITSTPCmatchEta[ti], mEtaNum[ti], mEtaDen[ti]);
+    updateEfficiency(mFractionITSTPCmatchPhiVsPt[ti], mPhiVsPtNum[ti], mPhiVsPtDen[ti]);
+    updateEfficiency(mFractionITSTPCmatchEtaVsPt[ti], mEtaVsPtNum[ti], mEtaVsPtDen[ti]);
+    updateEfficiency(mFractionITSTPCmatch1OverPt[ti], m1OverPtNum[ti], m1OverPtDen[ti]);
+    updateEfficiency(mFractionITSTPCmatchClsVsPt[ti], mClsVsPtNum[ti], mClsVsPtDen[ti]);
+    updateEfficiency(mFractionITSTPCmatchChi2VsPt[ti], mChi2VsPtNum[ti], mChi2VsPtDen[ti]);
     if (mUseTrkPID) { // Vs Tracking PID hypothesis
       for (int j = 0; j < o2::track::PID::NIDs; ++j) {
-        setEfficiency(mFractionITSTPCmatchPtVsTrkPID[ti][j], mPtNumVsTrkPID[ti][j], mPtDenVsTrkPID[ti][j]);
-        setEfficiency(mFractionITSTPCmatchPhiVsTrkPID[ti][j], mPhiNumVsTrkPID[ti][j], mPhiDenVsTrkPID[ti][j]);
-        setEfficiency(mFractionITSTPCmatchEtaVsTrkPID[ti][j], mEtaNumVsTrkPID[ti][j], mEtaDenVsTrkPID[ti][j]);
+        updateEfficiency(mFractionITSTPCmatchPtVsTrkPID[ti][j], mPtNumVsTrkPID[ti][j], mPtDenVsTrkPID[ti][j]);
+        updateEfficiency(mFractionITSTPCmatchPhiVsTrkPID[ti][j], mPhiNumVsTrkPID[ti][j], mPhiDenVsTrkPID[ti][j]);
+        updateEfficiency(mFractionITSTPCmatchEtaVsTrkPID[ti][j], mEtaNumVsTrkPID[ti][j], mEtaDenVsTrkPID[ti][j]);
       }
     }
     if (mUseMC) {
-      setEfficiency(mFractionITSTPCmatchPhysPrim[ti], mPtPhysPrimNum[ti], mPtPhysPrimDen[ti]);
-      setEfficiency(mFractionITSTPCmatchPhiPhysPrim[ti], mPhiPhysPrimNum[ti], mPhiPhysPrimDen[ti]);
-      setEfficiency(mFractionITSTPCmatchEtaPhysPrim[ti], mEtaPhysPrimNum[ti], mEtaPhysPrimDen[ti]);
-      setEfficiency(mFractionITSTPCmatchPhysPrim1OverPt[ti], m1OverPtPhysPrimNum[ti], m1OverPtPhysPrimDen[ti]);
+      updateEfficiency(mFractionITSTPCmatchPhysPrim[ti], mPtPhysPrimNum[ti], mPtPhysPrimDen[ti]);
+      updateEfficiency(mFractionITSTPCmatchPhiPhysPrim[ti], mPhiPhysPrimNum[ti], mPhiPhysPrimDen[ti]);
+      updateEfficiency(mFractionITSTPCmatchEtaPhysPrim[ti], mEtaPhysPrimNum[ti], mEtaPhysPrimDen[ti]);
+      updateEfficiency(mFractionITSTPCmatchPhysPrim1OverPt[ti], m1OverPtPhysPrimNum[ti], m1OverPtPhysPrimDen[ti]);
     }
   }
-  setEfficiency(mFractionITSTPCmatchDCArVsPt, mDCArVsPtNum, mDCArVsPtDen, true);
+  updateEfficiency(mFractionITSTPCmatchDCArVsPt, mDCArVsPtNum, mDCArVsPtDen);
   /*
   mPtTPC->Scale(scaleFactTPC);
   mPt->Scale(scaleFactITSTPC);
@@ -1080,6 +1086,47 @@ void MatchITSTPCQC::finalize()
 
 //__________________________________________________________
 
+bool MatchITSTPCQC::isEfficiencyUpToDate(const TEfficiency* eff, double numEntries, double denEntries)
+{
+  auto& snapshot = mEffSnapshot[eff];
+  if (snapshot.first == numEntries && snapshot.second == denEntries) {
+    return true;
+  }
+  snapshot = {numEntries, denEntries};
+  return false;
+}
+
+//__________________________________________________________
+
+void MatchITSTPCQC::updateEfficiency(TEfficiency* eff, TH1* hnum, TH1* hden, bool is2D)
+{
+  // refresh the ratio snapshot only when the inputs accumulated new entries
+  if (isEfficiencyUpToDate(eff, hnum->GetEntries(), hden->GetEntries())) {
+    return;
+  }
+  setEfficiency(eff, hnum, hden, is2D);
+}
+
+//__________________________________________________________
+
+void MatchITSTPCQC::updateEfficiency(TEfficiency* eff, THnSparseF* hnum, THnSparseF* hden)
+{
+  if (hnum == nullptr || hden == nullptr) {
+    LOG(fatal) << "Cannot get sparse num/den histograms for TEfficiency object " << (eff != nullptr ? eff->GetName() : "");
+  }
+  if (isEfficiencyUpToDate(eff, hnum->GetEntries(), hden->GetEntries())) {
+    return;
+  }
+  // project the sparse storage to dense histograms only when a new ratio snapshot is due
+  std::unique_ptr<TH2D> num(hnum->Projection(1, 0));
+  std::unique_ptr<TH2D> den(hden->Projection(1, 0));
+  num->SetDirectory(nullptr);
+  den->SetDirectory(nullptr);
+  setEfficiency(eff, num.get(), den.get(), true);
+}
+
+//__________________________________________________________
+
 void MatchITSTPCQC::setEfficiency(TEfficiency* eff, TH1* hnum, TH1* hden, bool is2D)
 {
   if (eff == nullptr) {
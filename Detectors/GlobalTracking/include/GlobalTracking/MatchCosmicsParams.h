@@ -33,6 +33,7 @@ struct MatchCosmicsParams : public o2::conf::ConfigurableParamHelper<MatchCosmic
   float minSeedPt = 0.10;  // use only tracks above this pT (scaled with field)
   float nSigmaTError = 4.; // number of sigmas on track time error for matching (except for TPC which provides an interval)
   bool allowTPCOnly = true;
+  bool useTglBuckets = true; // pair only time-clustered legs with tgl compatible within the crude cut (pure speedup, same accepted pairs)
   o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT;
 
   O2ParamDef(MatchCosmicsParams, "cosmicsMatch");
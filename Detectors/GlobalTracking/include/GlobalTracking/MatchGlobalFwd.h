@@ -163,6 +163,9 @@ class MatchGlobalFwd
 
   o2::MCCompLabel computeLabel(const int MCHId, const int MFTid);
 
+  ///< Cheap proxy of the matching chi2 used to rank candidates in the two-stage mode
+  static double matchingProxyChi2(const GlobalFwdTrack& mchTrack, const TrackParCovFwd& mftTrack);
+
   ///< Matches MFT tracks in one MFT ROFrame with all MCH tracks in the overlapping MCH ROFrames
   template <int saveMode>
   void ROFMatch(int MFTROFId, int firstMCHROFId, int lastMCHROFId);
@@ -341,6 +344,8 @@ class MatchGlobalFwd
   bool mUseMIDMCHMatch = false; ///< Flag for using MCHMID matches (TrackMCHMID)
   int mSaveMode = 0;            ///< Output mode [0 = SaveBestMatch; 1 = SaveAllMatches; 2 = SaveTrainingData; 3 = SaveNCandidates]
   int mNCandidates = 5;         ///< Numbers of matching candidates to save in savemode=3
+  bool mTwoStageMatching = false; ///< rank candidates with the chi2 proxy, full matching function only for the best ones
+  int mNProxyCandidates = 5;      ///< number of proxy-ranked candidates evaluated with the full matching function
   MatchingType mMatchingType = MATCHINGUNDEFINED;
   TGeoManager* mGeoManager;
 };
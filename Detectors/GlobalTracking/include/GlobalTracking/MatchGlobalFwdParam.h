@@ -43,6 +43,8 @@ struct GlobalFwdMatchingParam : public o2::conf::ConfigurableParamHelper<GlobalF
   float MFTRadLength = 0.042;                             ///< MFT thickness in radiation length
   float alignResidual = 1.;                               ///< Alignment residual for cluster position uncertainty
   int nCandidates = 5;                                    ///< Number of best matching candidates to save in savemode=3
+  bool useTwoStageMatching = false;                       ///< rank pair candidates with a cheap diagonal chi2 proxy, full matching function only for the best proxy candidates
+  int nProxyCandidates = 5;                               ///< number of proxy-ranked candidates per MCH track evaluated with the full matching function
 
   bool
     isMatchUpstream() const
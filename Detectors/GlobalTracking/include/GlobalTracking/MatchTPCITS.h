@@ -383,6 +383,11 @@ class MatchTPCITS
   void end();
   void reportTiming();
 
+  ///< access to the per-stage stopwatches, e.g. for metrics publishing by the workflow
+  int getNTimers() const { return NStopWatches; }
+  TStopwatch& getTimer(int i) { return mTimer[i]; }
+  std::string_view getTimerName(int i) const { return TimerName[i]; }
+
   ///< clear results of previous event reco
   void clear();
 
@@ -486,6 +491,7 @@ class MatchTPCITS
                              std::array<int, MatchTPCITS::MaxLadderCand>& lad2Check) const;
   bool prepareTPCData();
   bool prepareITSData();
+  void buildITSCellIndex();
   bool prepareFITData();
   int prepareInteractionTimes();
   int prepareTPCTracksAfterBurner();
@@ -552,6 +558,13 @@ class MatchTPCITS
     return --start;
   }
 
+  ///< tgl cell of the (ITS ROF, tgl) candidate index, out of range tracks are clamped to the edge cells
+  int tgl2ITSCell(float tgl) const
+  {
+    int cell = (tgl + MaxTglIndex) * TglIndexCellInv;
+    return cell < 0 ? 0 : (cell >= NTglIndexCells ? NTglIndexCells - 1 : cell);
+  }
+
   ///< convert TPC time bin to microseconds
   float tpcTimeBin2Z(float tbn) const { return tbn * mTPCBin2Z; }
 
@@ -720,6 +733,8 @@ class MatchTPCITS
   std::array<std::vector<int>, o2::constants::math::NSectors> mTPCTimeStart;
   ///< indices of 1st entries of ITS tracks starting at given ROframe
   std::array<std::vector<int>, o2::constants::math::NSectors> mITSTimeStart;
+  ///< per sector (ITS ROF x tgl cell) candidate index: 1st entry of every cell in the sorted mITSSectIndexCache, with closing sentinel
+  std::array<std::vector<int>, o2::constants::math::NSectors> mITSCellStart;
 
   /// mapping for tracks' continuos ROF cycle to actual continuous readout ROFs with eventual gaps
   std::vector<int> mITSTrackROFContMapping;
@@ -738,6 +753,9 @@ class MatchTPCITS
   static constexpr float MaxSnp = 0.9;                 // max snp of ITS or TPC track at xRef to be matched
   static constexpr float MaxTgp = 2.064;               // max tg corresponting to MaxSnp = MaxSnp/std::sqrt(1.-MaxSnp^2)
   static constexpr float MinTBToCleanCache = 600.;     // keep in AB ITS cluster refs cache at most this number of TPC bins
+  static constexpr float MaxTglIndex = 2.5f;           // tgl range covered by the (ITS ROF, tgl) candidate index
+  static constexpr int NTglIndexCells = 50;            // number of tgl cells of the candidate index, cell width 0.1
+  static constexpr float TglIndexCellInv = NTglIndexCells / (2.f * MaxTglIndex); // inverse tgl cell width
 
   enum TimerIDs { SWTot,
                   SWPrepITS,
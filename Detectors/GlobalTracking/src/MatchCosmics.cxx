@@ -67,10 +67,64 @@ void MatchCosmics::process(const o2::globaltracking::RecoContainer& data)
   std::iota(sortID.begin(), sortID.end(), 0);
   std::sort(sortID.begin(), sortID.end(), [this](int a, int b) { return mSeeds[a].tBracket.getMin() < mSeeds[b].tBracket.getMin(); });
 
-  for (int i = 0; i < ntr; i++) {
-    for (int j = i + 1; j < ntr; j++) {
-      if (checkPair(sortID[i], sortID[j]) == RejTime) {
-        break;
+  if (mMatchParams->useTglBuckets) {
+    // Split the time-ordered tracks into clusters of chained overlapping time brackets: a track
+    // whose bracket starts after the latest bracket end seen so far cannot match any earlier one.
+    // Within a cluster the legs are ordered in tgl and only the pairs which can pass the crude
+    // back-to-back tgl cut of checkPair are tried, the accepted pairs are the same as in the
+    // exhaustive loop.
+    std::vector<float> tglMargin(ntr);
+    const float nSigTgl = std::sqrt(mMatchParams->crudeNSigma2Cut[o2::track::kTgl]);
+    for (int i = 0; i < ntr; i++) {
+      tglMargin[i] = nSigTgl * std::sqrt(mMatchParams->systSigma2[o2::track::kTgl] + mSeeds[i].getSigmaTgl2());
+    }
+    std::vector<std::pair<float, int>> tglOrd;
+    auto processCluster = [this, &sortID, &tglMargin, &tglOrd](int from, int to) { // pair the seeds of the cluster [from,to)
+      if (to - from < 2) {
+        return;
+      }
+      tglOrd.clear();
+      float maxMargin = 0.f;
+      for (int i = from; i < to; i++) {
+        int id = sortID[i];
+        tglOrd.emplace_back(mSeeds[id].getTgl(), id);
+        maxMargin = std::max(maxMargin, tglMargin[id]);
+      }
+      std::sort(tglOrd.begin(), tglOrd.end());
+      float window = 2.f * maxMargin; // the crude cut is bounded by the sum of the 2 margins
+      int ncl = tglOrd.size();
+      for (int ia = 0; ia < ncl; ia++) {
+        float tgt = -tglOrd[ia].first; // a back-to-back partner has the opposite tgl
+        int ib = std::lower_bound(tglOrd.begin(), tglOrd.end(), std::make_pair(tgt - window, -1)) - tglOrd.begin();
+        for (; ib < ncl && tglOrd[ib].first <= tgt + window; ib++) {
+          if (ib <= ia) { // every pair is seen from both sides, process it once
+            continue;
+          }
+          int a = tglOrd[ia].second, b = tglOrd[ib].second;
+          if (mSeeds[a].tBracket.getMin() > mSeeds[b].tBracket.getMin()) { // checkPair expects the earlier bracket first
+            std::swap(a, b);
+          }
+          checkPair(a, b);
+        }
+      }
+    };
+    int clFrom = 0;
+    float tMax = ntr ? mSeeds[sortID[0]].tBracket.getMax() : 0.f;
+    for (int i = 1; i <= ntr; i++) {
+      if (i == ntr || mSeeds[sortID[i]].tBracket.getMin() > tMax) {
+        processCluster(clFrom, i);
+        clFrom = i;
+      }
+      if (i < ntr) {
+        tMax = std::max(tMax, mSeeds[sortID[i]].tBracket.getMax());
+      }
+    }
+  } else {
+    for (int i = 0; i < ntr; i++) {
+      for (int j = i + 1; j < ntr; j++) {
+        if (checkPair(sortID[i], sortID[j]) == RejTime) {
+          break;
+        }
       }
     }
   }
@@ -69,6 +69,12 @@ void MatchGlobalFwd::init()
   LOG(info) << "Save mode MFTMCH candidates = " << mSaveMode;
 
   mNCandidates = matchingParam.nCandidates;
+
+  mTwoStageMatching = matchingParam.useTwoStageMatching;
+  mNProxyCandidates = matchingParam.nProxyCandidates;
+  if (mTwoStageMatching) {
+    LOG(info) << "Two-stage MFTMCH matching: full matching function restricted to the best " << mNProxyCandidates << " proxy-ranked candidates";
+  }
 }
 
 //_________________________________________________________
@@ -461,10 +467,45 @@ void MatchGlobalFwd::ROFMatch(int MFTROFId, int firstMCHROFId, int lastMCHROFId)
   LOG(debug) << "   firstMCHROF: " << firstMCHROF;
   LOG(debug) << "   lastMCHROF:  " << lastMCHROF;
 
+  std::vector<std::pair<float, int>> proxyCand; // proxy-ranked candidates of the current MCH track in the two-stage mode
+
   // loop over all MCH tracks
   for (auto MCHId = firstMCHTrackID; MCHId <= lastMCHTrackID; MCHId++) {
     auto& thisMCHTrack = mMCHWork[MCHId];
     o2::MCCompLabel matchLabel;
+    if constexpr (saveAllMode == SaveMode::kBestMatch) {
+      if (mTwoStageMatching) { // stage 1: rank all pair candidates with the cheap chi2 proxy
+        proxyCand.clear();
+        for (auto MFTId = firstMFTTrackID; MFTId <= lastMFTTrackID; MFTId++) {
+          auto& thisMFTTrack = mMFTWork[MFTId];
+          if (mMCTruthON) {
+            matchLabel = computeLabel(MCHId, MFTId);
+          }
+          if (mCutFunc(thisMCHTrack, thisMFTTrack)) {
+            thisMCHTrack.countMFTCandidate();
+            if (mMCTruthON && matchLabel.isCorrect()) {
+              thisMCHTrack.setCloseMatch();
+            }
+            proxyCand.emplace_back(matchingProxyChi2(thisMCHTrack, thisMFTTrack), MFTId);
+          }
+        }
+        int nKeep = std::min<int>(proxyCand.size(), mNProxyCandidates);
+        std::partial_sort(proxyCand.begin(), proxyCand.begin() + nKeep, proxyCand.end(), compare);
+        for (int ic = 0; ic < nKeep; ic++) { // stage 2: full matching function on the best proxy candidates only
+          auto MFTId = proxyCand[ic].second;
+          auto& thisMFTTrack = mMFTWork[MFTId];
+          auto score = mMatchFunc(thisMCHTrack, thisMFTTrack);
+          if (score < thisMCHTrack.getMFTMCHMatchingScore()) {
+            thisMCHTrack.setMFTTrackID(MFTId);
+            auto chi2 = matchAllChi2(thisMCHTrack, thisMFTTrack); // Matching chi2 is stored independently
+            thisMCHTrack.setMFTMCHMatchingScore(score);
+            thisMCHTrack.setMFTMCHMatchingChi2(chi2);
+          }
+        }
+        LOG(debug) << "       Matching MCHId = " << MCHId << " ==> bestMFTMatchID = " << thisMCHTrack.getMFTTrackID() << " ; thisMCHTrack.getMFTMCHMatchingChi2() =  " << thisMCHTrack.getMFTMCHMatchingChi2();
+        continue;
+      }
+    }
     for (auto MFTId = firstMFTTrackID; MFTId <= lastMFTTrackID; MFTId++) {
       auto& thisMFTTrack = mMFTWork[MFTId];
       if (mMCTruthON) {
@@ -541,6 +582,25 @@ o2::MCCompLabel MatchGlobalFwd::computeLabel(const int MCHId, const int MFTId)
   return matchLabel;
 }
 
+//_________________________________________________________
+double MatchGlobalFwd::matchingProxyChi2(const GlobalFwdTrack& mchTrack, const TrackParCovFwd& mftTrack)
+{
+  // Cheap proxy of the matching chi2: the parameter residuals at the matching plane are
+  // normalized by the sum of the diagonal covariances of the two tracks, skipping the
+  // matrix inversion of the full matching functions. Only used to rank the candidates
+  // of a MCH track in the two-stage mode, the reported chi2 is always the full one.
+  const auto& mchCov = mchTrack.getCovariances();
+  const auto& mftCov = mftTrack.getCovariances();
+  SVector5 d = SVector5(mftTrack.getX(), mftTrack.getY(), mftTrack.getPhi(),
+                        mftTrack.getTanl(), mftTrack.getInvQPt()) -
+               mchTrack.getParameters();
+  double chi2 = 0.;
+  for (int i = 0; i < 5; i++) {
+    chi2 += d(i) * d(i) / (mftCov(i, i) + mchCov(i, i));
+  }
+  return chi2;
+}
+
 //_________________________________________________________
 void MatchGlobalFwd::doMCMatching()
 {
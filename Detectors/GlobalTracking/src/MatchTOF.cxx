@@ -591,22 +591,31 @@ void MatchTOF::propagateConstrTracks(int sec)
   std::array<float, 3> globalPos;
 
   auto& trkWork = mTracksWork[sec][trkType::CONSTR];
+  int nTracks = trkWork.size();
+
+  // gather the tracks and their length/TOF integrals in contiguous arrays to propagate them in a single batch
+  std::vector<o2::track::TrackParCov> trcBatch;
+  std::vector<o2::track::TrackLTIntegral> intLTBatch;
+  std::vector<uint8_t> statusBatch(nTracks);
+  trcBatch.reserve(nTracks);
+  intLTBatch.reserve(nTracks);
+  for (int it = 0; it < nTracks; it++) {
+    trcBatch.push_back(trkWork[it].first);
+    intLTBatch.push_back(mLTinfos[sec][trkType::CONSTR][it]);
+    // propagate to matching Xref: we first propagate to 371 cm without considering the covariance matrix
+    statusBatch[it] = propagateToRefXWithoutCov(trcBatch.back(), mXRef, 2, mBz);
+  }
+  // the "rough" propagation worked; now we can propagate considering also the cov matrix
+  propagateToRefX(nTracks, trcBatch.data(), intLTBatch.data(), statusBatch.data(), mXRef, 2);
 
-  for (int it = 0; it < trkWork.size(); it++) {
-    o2::track::TrackParCov& trc = trkWork[it].first;
-    o2::track::TrackLTIntegral& intLT0 = mLTinfos[sec][trkType::CONSTR][it];
-
-    // propagate to matching Xref
-    if (!propagateToRefXWithoutCov(trc, mXRef, 2, mBz)) { // we first propagate to 371 cm without considering the covariance matrix
-      mNotPropagatedToTOF[trkType::CONSTR]++;
-      continue;
-    }
-
-    // the "rough" propagation worked; now we can propagate considering also the cov matrix
-    if (!propagateToRefX(trc, mXRef, 2, intLT0) || std::abs(trc.getZ()) > Geo::MAXHZTOF) { // we check that the propagation with the cov matrix worked;>
+  for (int it = 0; it < nTracks; it++) {
+    if (!statusBatch[it] || std::abs(trcBatch[it].getZ()) > Geo::MAXHZTOF) { // we check that the propagation with the cov matrix worked;>
       mNotPropagatedToTOF[trkType::CONSTR]++;
       continue;
     }
+    o2::track::TrackParCov& trc = trkWork[it].first;
+    trc = trcBatch[it];
+    mLTinfos[sec][trkType::CONSTR][it] = intLTBatch[it];
 
     trc.getXYZGlo(globalPos);
 
@@ -1839,6 +1848,61 @@ bool MatchTOF::propagateToRefX(o2::track::TrackParCov& trc, float xRef, float st
   //Printf("propagateToRefX: snp of teh track is %f (--> %f grad)", trc.getSnp(), TMath::ASin(trc.getSnp())*TMath::RadToDeg());
   return refReached && std::abs(trc.getSnp()) < 0.95; // Here we need to put MAXSNP
 }
+//______________________________________________
+void MatchTOF::propagateToRefX(int nTracks, o2::track::TrackParCov* tracks, o2::track::TrackLTIntegral* intLT, uint8_t* status, float xRef, float stepInCm)
+{
+  // batched version of propagateToRefX: the tracks (those with non-zero status) are advanced in lockstep,
+  // so that the material budgets of all of them can be queried from the LUT layer by layer instead of track by track.
+  // On exit the status is non-zero only for the tracks which reached xRef with an acceptable snp
+  o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT; // material correction method
+  static const float tanHalfSector = tan(o2::constants::math::SectorSpanRad / 2);
+  std::vector<float> xTgt(nTracks);
+  std::vector<uint8_t> inProgress(nTracks);
+  std::vector<uint8_t> stepStatus(nTracks);
+  bool more = false;
+  for (int itr = 0; itr < nTracks; itr++) {
+    inProgress[itr] = status[itr];
+    more |= inProgress[itr];
+    // the first propagation will be from 2m, if the track is not at least at 2m
+    float xStart = tracks[itr].getX() < 50. ? 50. : tracks[itr].getX();
+    xTgt[itr] = xStart + stepInCm;
+    status[itr] = 0;
+  }
+  while (more) {
+    more = false;
+    stepStatus = inProgress;
+    o2::base::Propagator::Instance()->PropagateToXBxByBz(nTracks, tracks, xTgt.data(), stepStatus.data(), MAXSNP, stepInCm, matCorr, intLT);
+    for (int itr = 0; itr < nTracks; itr++) {
+      if (!inProgress[itr]) {
+        continue;
+      }
+      if (!stepStatus[itr]) { // propagation of this track failed, retire it
+        inProgress[itr] = 0;
+        continue;
+      }
+      auto& trc = tracks[itr];
+      bool refReached = trc.getX() > xRef;                     // we reached the 371cm reference
+      if (std::abs(trc.getY()) > trc.getX() * tanHalfSector) { // we are still in the same sector
+        // we need to rotate the track to go to the new sector
+        auto alphaNew = o2::math_utils::angle2Alpha(trc.getPhiPos());
+        if (!trc.rotate(alphaNew) != 0) {
+          // failed, see the comment in the scalar version: the scalar break still
+          // accepts the track if it already crossed xRef, so do the same here
+          inProgress[itr] = 0;
+          status[itr] = refReached && std::abs(trc.getSnp()) < 0.95; // Here we need to put MAXSNP
+          continue;
+        }
+      }
+      if (refReached) {
+        inProgress[itr] = 0;
+        status[itr] = std::abs(trc.getSnp()) < 0.95; // Here we need to put MAXSNP
+        continue;
+      }
+      xTgt[itr] += stepInCm;
+      more = true;
+    }
+  }
+}
 
 //______________________________________________
 bool MatchTOF::propagateToRefXWithoutCov(const o2::track::TrackParCov& trc, float xRef, float stepInCm, float bzField)
@@ -181,6 +181,7 @@ void MatchTPCITS::clear()
   for (int sec = o2::constants::math::NSectors; sec--;) {
     mITSSectIndexCache[sec].clear();
     mITSTimeStart[sec].clear();
+    mITSCellStart[sec].clear();
     mTPCSectIndexCache[sec].clear();
     mTPCTimeStart[sec].clear();
   }
@@ -819,12 +820,41 @@ bool MatchTPCITS::prepareITSData()
       return trackA.getTgl() < trackB.getTgl();
     });
   } // loop over tracks of single sector
+  buildITSCellIndex();
   mMatchRecordsITS.reserve(mITSWork.size() * mParams->maxMatchCandidates);
   mTimer[SWPrepITS].Stop();
 
   return nITSClus > 0;
 }
 
+//_____________________________________________________
+void MatchTPCITS::buildITSCellIndex()
+{
+  ///< build per sector (ITS ROF, tgl cell) index over the sorted ITS tracks cache, so that the matching
+  ///< retrieves for every TPC track only the candidates of time-compatible ROFs and tgl-compatible cells.
+  ///< The cache is already sorted in (ROF time, tgl), hence every cell is a contiguous range and it suffices
+  ///< to store its 1st entry, with empty cells borrowing the start of the next non-empty one.
+  int nROFs = mITSROFTimes.size();
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    const auto& indexCache = mITSSectIndexCache[sec];
+    auto& cellStart = mITSCellStart[sec];
+    cellStart.resize(nROFs * NTglIndexCells + 1, -1);
+    for (int itr = 0; itr < (int)indexCache.size(); itr++) {
+      const auto& trc = mITSWork[indexCache[itr]];
+      int cell = trc.roFrame * NTglIndexCells + tgl2ITSCell(trc.getTgl());
+      if (cellStart[cell] == -1) {
+        cellStart[cell] = itr;
+      }
+    }
+    cellStart.back() = indexCache.size();
+    for (int i = cellStart.size() - 1; i--;) {
+      if (cellStart[i] == -1) {
+        cellStart[i] = cellStart[i + 1];
+      }
+    }
+  }
+}
+
 //_____________________________________________________
 bool MatchTPCITS::prepareFITData()
 {
@@ -843,7 +873,7 @@ void MatchTPCITS::doMatching(int sec)
   auto& cacheITS = mITSSectIndexCache[sec]; // array of cached ITS track indices for this sector
   auto& cacheTPC = mTPCSectIndexCache[sec]; // array of cached ITS track indices for this sector
   auto& timeStartTPC = mTPCTimeStart[sec];  // array of 1st TPC track with timeMax in ITS ROFrame
-  auto& timeStartITS = mITSTimeStart[sec];
+  auto& cellStart = mITSCellStart[sec];     // (ITS ROF x tgl cell) candidate index of this sector
   int nTracksTPC = cacheTPC.size(), nTracksITS = cacheITS.size();
   if (!nTracksTPC || !nTracksITS) {
     if (mParams->verbosity > 0) {
@@ -869,7 +899,13 @@ void MatchTPCITS::doMatching(int sec)
   auto t2nbs = tpcTimeBin2MUS(mZ2TPCBin * mParams->tpcTimeICMatchingNSigma);
   bool checkInteractionCandidates = mUseFT0 && mParams->validateMatchByFIT != MatchTPCITSParams::Disable;
 
-  int itsROBin = 0;
+  // tgl window (expressed in index cells) guaranteeing that no candidate passing the crude tgl cut is skipped
+  float tglMargin = mParams->crudeAbsDiffCut[o2::track::kTgl];
+  bool noTglPresel = false;
+#ifdef _ALLOW_DEBUG_TREES_
+  noTglPresel = mDBGOut && isDebugFlag(MatchTreeAll); // the debug tree must see also the pairs rejected on tgl
+#endif
+  int itsROBin = 0, nITSROFs = mITSROFTimes.size();
   for (int itpc = idxMinTPC; itpc < nTracksTPC; itpc++) {
     auto& trefTPC = mTPCWork[cacheTPC[itpc]];
     // estimate ITS 1st ROframe bin this track may match to: TPC track are sorted according to their
@@ -877,116 +913,100 @@ void MatchTPCITS::doMatching(int sec)
     auto tmn = trefTPC.tBracket.getMax() - maxTDriftSafe;
     itsROBin = mITSTriggered ? time2ITSROFrameTrig(tmn, itsROBin) : time2ITSROFrameCont(tmn);
 
-    if (itsROBin >= int(timeStartITS.size())) { // time of TPC track exceeds the max time of ITS in the cache
+    if (itsROBin >= nITSROFs) { // time of TPC track exceeds the max time of ITS in the cache
       break;
     }
-    int iits0 = timeStartITS[itsROBin];
     nCheckTPCControl++;
-    for (auto iits = iits0; iits < nTracksITS; iits++) {
-      auto& trefITS = mITSWork[cacheITS[iits]];
-      // compare if the ITS and TPC tracks may overlap in time
-      LOG(debug) << "TPC bracket: " << trefTPC.tBracket.asString() << " ITS bracket: " << trefITS.tBracket.asString() << " TPCtgl: " << trefTPC.getTgl() << " ITStgl: " << trefITS.getTgl();
-      if (trefTPC.tBracket < trefITS.tBracket) { // since TPC tracks are sorted in timeMax and ITS tracks are sorted in timeMin all following ITS tracks also will not match
+    int cellLo = noTglPresel ? 0 : tgl2ITSCell(trefTPC.getTgl() - tglMargin);
+    int cellHi = noTglPresel ? NTglIndexCells - 1 : tgl2ITSCell(trefTPC.getTgl() + tglMargin);
+    for (int irof = itsROBin; irof < nITSROFs; irof++) {
+      // compare if the TPC track may overlap in time with this ROF (ITS track brackets are their ROF times)
+      if (trefTPC.tBracket < mITSROFTimes[irof]) { // all following ROFs start even later and also will not match
         break;
       }
-      if (trefTPC.tBracket > trefITS.tBracket) { // its bracket precedes TPC bracket
+      if (trefTPC.tBracket > mITSROFTimes[irof]) { // this ROF precedes the TPC bracket
         continue;
       }
-
-      // is corrected TPC track time compatible with ITS ROF expressed
-      auto deltaT = (trefITS.getZ() - trefTPC.getZ()) * mTPCVDriftInv;                                                    // drift time difference corresponding to Z differences
-      auto timeCorr = trefTPC.getCorrectedTime(deltaT);                                                                   // TPC time required to match to Z of ITS track
-      auto timeCorrErr = std::sqrt(trefITS.getSigmaZ2() + trefTPC.getSigmaZ2()) * t2nbs + mParams->safeMarginTimeCorrErr; // nsigma*error
-      if (mVDriftCalibOn) {
-        timeCorrErr += vdErrT * (250. - abs(trefITS.getZ())); // account for the extra error from TPC VDrift uncertainty
-      }
-      o2::math_utils::Bracketf_t trange(timeCorr - timeCorrErr, timeCorr + timeCorrErr);
-      LOG(debug) << "TPC range: " << trange.asString() << " ITS bracket: " << trefITS.tBracket.asString() << " DZ: " << (trefITS.getZ() - trefTPC.getZ()) << " DT: " << timeCorr;
-      // check if the assigned time is strictly within the ITS bracket
-      auto cmpITSBracket = trefITS.tBracket.isOutside(timeCorr);
-      if (cmpITSBracket) { // no, check if brackets are overlapping at all
-        if (trefITS.tBracket.isOutside(trange)) {
-          continue;
+      // retrieve only the candidates of tgl-compatible cells of this ROF
+      int iitsEnd = cellStart[irof * NTglIndexCells + cellHi + 1];
+      for (int iits = cellStart[irof * NTglIndexCells + cellLo]; iits < iitsEnd; iits++) {
+        auto& trefITS = mITSWork[cacheITS[iits]];
+        LOG(debug) << "TPC bracket: " << trefTPC.tBracket.asString() << " ITS bracket: " << trefITS.tBracket.asString() << " TPCtgl: " << trefTPC.getTgl() << " ITStgl: " << trefITS.getTgl();
+
+        // is corrected TPC track time compatible with ITS ROF expressed
+        auto deltaT = (trefITS.getZ() - trefTPC.getZ()) * mTPCVDriftInv;                                                    // drift time difference corresponding to Z differences
+        auto timeCorr = trefTPC.getCorrectedTime(deltaT);                                                                   // TPC time required to match to Z of ITS track
+        auto timeCorrErr = std::sqrt(trefITS.getSigmaZ2() + trefTPC.getSigmaZ2()) * t2nbs + mParams->safeMarginTimeCorrErr; // nsigma*error
+        if (mVDriftCalibOn) {
+          timeCorrErr += vdErrT * (250. - abs(trefITS.getZ())); // account for the extra error from TPC VDrift uncertainty
         }
-        if (mParams->ITSTimeOutliersPolicy == MatchTPCITSParams::TimeOutliersPolicy::Adjust) {
-          if (cmpITSBracket == o2::math_utils::Bracketf_t::Below) {
-            timeCorr = trefITS.tBracket.getMin();
-            trange.setMin(timeCorr);
-          } else {
-            timeCorr = trefITS.tBracket.getMax();
-            trange.setMax(timeCorr);
+        o2::math_utils::Bracketf_t trange(timeCorr - timeCorrErr, timeCorr + timeCorrErr);
+        LOG(debug) << "TPC range: " << trange.asString() << " ITS bracket: " << trefITS.tBracket.asString() << " DZ: " << (trefITS.getZ() - trefTPC.getZ()) << " DT: " << timeCorr;
+        // check if the assigned time is strictly within the ITS bracket
+        auto cmpITSBracket = trefITS.tBracket.isOutside(timeCorr);
+        if (cmpITSBracket) { // no, check if brackets are overlapping at all
+          if (trefITS.tBracket.isOutside(trange)) {
+            continue;
+          }
+          if (mParams->ITSTimeOutliersPolicy == MatchTPCITSParams::TimeOutliersPolicy::Adjust) {
+            if (cmpITSBracket == o2::math_utils::Bracketf_t::Below) {
+              timeCorr = trefITS.tBracket.getMin();
+              trange.setMin(timeCorr);
+            } else {
+              timeCorr = trefITS.tBracket.getMax();
+              trange.setMax(timeCorr);
+            }
+          } else if (mParams->ITSTimeOutliersPolicy == MatchTPCITSParams::TimeOutliersPolicy::Reject) {
+            continue;
           }
-        } else if (mParams->ITSTimeOutliersPolicy == MatchTPCITSParams::TimeOutliersPolicy::Reject) {
-          continue;
         }
-      }
 
-      nCheckITSControl++;
-      float chi2 = -1;
-      int rejFlag = compareTPCITSTracks(trefITS, trefTPC, chi2);
+        nCheckITSControl++;
+        float chi2 = -1;
+        int rejFlag = compareTPCITSTracks(trefITS, trefTPC, chi2);
 
 #ifdef _ALLOW_DEBUG_TREES_
-      if (mDBGOut && ((rejFlag == Accept && isDebugFlag(MatchTreeAccOnly)) || isDebugFlag(MatchTreeAll))) {
-        fillTPCITSmatchTree(cacheITS[iits], cacheTPC[itpc], rejFlag, chi2, timeCorr);
-      }
-#endif
-      /*
-      // RS: this might be dangerous for ITS tracks with different time coverages.
-      if (rejFlag == RejectOnTgl) {
-        // ITS tracks in each ROFrame are ordered in Tgl, hence if this check failed on Tgl check
-        // (i.e. tgl_its>tgl_tpc+tolerance), then all other ITS tracks in this ROFrame will also have tgl too large.
-        // Jump on the 1st ITS track of the next ROFrame
-        int rof = trefITS.roFrame;
-        bool stop = false;
-        do {
-          if (++rof >= int(timeStartITS.size())) {
-            stop = true;
-            break; // no more ITS ROFrames in cache
-          }
-          iits = timeStartITS[rof] - 1;                  // next track to be checked -1
-        } while (iits <= timeStartITS[trefITS.roFrame]); // skip empty bins
-        if (stop) {
-          break;
+        if (mDBGOut && ((rejFlag == Accept && isDebugFlag(MatchTreeAccOnly)) || isDebugFlag(MatchTreeAll))) {
+          fillTPCITSmatchTree(cacheITS[iits], cacheTPC[itpc], rejFlag, chi2, timeCorr);
         }
-        continue;
-      }
-      */
-      if (rejFlag != Accept) {
-        continue;
-      }
-      int matchedIC = MinusOne;
-      if (!isCosmics()) {
-        // validate by bunch filling scheme
-        if (mUseBCFilling) {
-          auto irBracket = tBracket2IRBracket(trange);
-          if (irBracket.isInvalid()) {
-            continue;
-          }
+#endif
+        if (rejFlag != Accept) {
+          continue;
         }
-        if (checkInteractionCandidates && mInteractions.size()) {
-          // check if corrected TPC track time is compatible with any of interaction times
-          int tmus = trange.getMin();
-          if (tmus < 0) {
-            tmus = 0;
-          }
-          auto entStart = tmus < int(mInteractionMUSLUT.size()) ? mInteractionMUSLUT[tmus] : (mInteractionMUSLUT.size() ? mInteractionMUSLUT.back() : 0);
-          for (int ent = entStart; ent < (int)mInteractions.size(); ent++) {
-            auto cmp = mInteractions[ent].tBracket.isOutside(trange);
-            if (cmp == o2::math_utils::Bracketf_t::Above) { // trange is above this interaction candidate, the following ones may match
+        int matchedIC = MinusOne;
+        if (!isCosmics()) {
+          // validate by bunch filling scheme
+          if (mUseBCFilling) {
+            auto irBracket = tBracket2IRBracket(trange);
+            if (irBracket.isInvalid()) {
               continue;
             }
-            if (cmp == o2::math_utils::Bracketf_t::Inside) {
-              matchedIC = ent;
+          }
+          if (checkInteractionCandidates && mInteractions.size()) {
+            // check if corrected TPC track time is compatible with any of interaction times
+            int tmus = trange.getMin();
+            if (tmus < 0) {
+              tmus = 0;
+            }
+            auto entStart = tmus < int(mInteractionMUSLUT.size()) ? mInteractionMUSLUT[tmus] : (mInteractionMUSLUT.size() ? mInteractionMUSLUT.back() : 0);
+            for (int ent = entStart; ent < (int)mInteractions.size(); ent++) {
+              auto cmp = mInteractions[ent].tBracket.isOutside(trange);
+              if (cmp == o2::math_utils::Bracketf_t::Above) { // trange is above this interaction candidate, the following ones may match
+                continue;
+              }
+              if (cmp == o2::math_utils::Bracketf_t::Inside) {
+                matchedIC = ent;
+              }
+              break; // we loop till 1st matching IC or the one above the trange (since IC are ordered, all others will be above too)
             }
-            break; // we loop till 1st matching IC or the one above the trange (since IC are ordered, all others will be above too)
+          }
+          if (mParams->validateMatchByFIT == MatchTPCITSParams::Require && matchedIC == MinusOne) {
+            continue;
           }
         }
-        if (mParams->validateMatchByFIT == MatchTPCITSParams::Require && matchedIC == MinusOne) {
-          continue;
-        }
+        registerMatchRecordTPC(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // register matching candidate
+        nMatchesControl++;
       }
-      registerMatchRecordTPC(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // register matching candidate
-      nMatchesControl++;
     }
   }
   if (mParams->verbosity > 0) {
@@ -2830,6 +2850,14 @@ void MatchTPCITS::reportSizes(pmr::vector<o2::dataformats::TrackTPCITS>& matched
     capTot += cap;
     LOGP(info, "Size RSS, mITSTimeStart         : size {:9} cap {:9}", siz, cap);
     //
+    for (int is = 0; is < o2::constants::math::NSectors; is++) {
+      siz += mITSCellStart[is].size() * sizeof(int);
+      cap += mITSCellStart[is].capacity() * sizeof(int);
+    }
+    sizTot += siz;
+    capTot += cap;
+    LOGP(info, "Size RSS, mITSCellStart         : size {:9} cap {:9}", siz, cap);
+    //
     siz = mITSTrackROFContMapping.size() * sizeof(int);
     cap = mITSTrackROFContMapping.capacity() * sizeof(int);
     sizTot += siz;
@@ -28,6 +28,7 @@
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/CCDBParamSpec.h"
 #include "Framework/DeviceSpec.h"
+#include "Framework/Monitoring.h"
 #include "FT0Reconstruction/InteractionTag.h"
 #include "ITSMFTBase/DPLAlpideParam.h"
 #include "DetectorsCommonDataFormats/DetID.h"
@@ -65,6 +66,7 @@ class PrimaryVertexingSpec : public Task
   bool mSkip{false};           ///< skip vertexing
   bool mUseMC{false};          ///< MC flag
   bool mValidateWithIR{false}; ///< require vertex validation with IR (e.g. from FT0)
+  bool mReportMetrics{false};  ///< publish timing and multiplicity metrics to DPL monitoring
   float mITSROFrameLengthMUS = 0.;
   float mITSROFBiasMUS = 0.;
   TStopwatch mTimer;
@@ -82,6 +84,7 @@ void PrimaryVertexingSpec::init(InitContext& ic)
   }
   mVertexer.setPoolDumpDirectory(dumpDir);
   mVertexer.setTrackSources(mTrackSrc);
+  mReportMetrics = ic.options().get<bool>("report-metrics");
 }
 
 void PrimaryVertexingSpec::run(ProcessingContext& pc)
@@ -195,6 +198,18 @@ void PrimaryVertexingSpec::run(ProcessingContext& pc)
        mVertexer.getTimeReAttach().CpuTime(), mVertexer.getTotTrials(), mVertexer.getNTZClusters(), mVertexer.getMaxTrialsPerCluster(),
        mVertexer.getLongestClusterTimeMS(), mVertexer.getLongestClusterMult(), mVertexer.getNIniFound(),
        mVertexer.getNKilledBCValid(), mVertexer.getNKilledIntCand(), mVertexer.getNKilledDebris(), mVertexer.getNKilledQuality(), mVertexer.getNKilledITSOnly());
+  if (mReportMetrics) { // publish per-stage cumulative timers (ms) and per-TF multiplicities
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mTimer.CpuTime() * 1000.), "pvertexing_time_Total"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getTimeDBScan().CpuTime() * 1000.), "pvertexing_time_DBScan"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getTimeVertexing().CpuTime() * 1000.), "pvertexing_time_Finder"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getTimeMADSel().CpuTime() * 1000.), "pvertexing_time_MADSel"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getTimeDebris().CpuTime() * 1000.), "pvertexing_time_Debris"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getTimeReAttach().CpuTime() * 1000.), "pvertexing_time_ReAttach"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getNTZClusters()), "pvertexing_tz_clusters"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(vertices.size()), "pvertexing_out_vertices"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(vertexTrackIDs.size()), "pvertexing_out_vertex_tracks"});
+  }
 }
 
 void PrimaryVertexingSpec::endOfStream(EndOfStreamContext& ec)
@@ -284,7 +299,8 @@ DataProcessorSpec getPrimaryVertexingSpec(GTrackID::mask_t src, bool skip, bool
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<PrimaryVertexingSpec>(dataRequest, ggRequest, src, skip, validateWithFT0, useMC)},
-    Options{{"pool-dumps-directory", VariantType::String, "", {"Destination directory for the tracks pool dumps"}}}};
+    Options{{"pool-dumps-directory", VariantType::String, "", {"Destination directory for the tracks pool dumps"}},
+            {"report-metrics", VariantType::Bool, false, {"Publish per-stage timing and multiplicity metrics to DPL monitoring"}}}};
 }
 
 } // namespace vertexing
@@ -34,6 +34,7 @@
 #include "TPCCalibration/CorrectionMapsLoader.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/DeviceSpec.h"
+#include "Framework/Monitoring.h"
 #include "TPCCalibration/CorrectionMapsLoader.h"
 
 using namespace o2::framework;
@@ -81,6 +82,7 @@ class SecondaryVertexingSpec : public Task
   bool mEnable3BodyVertices = false;
   bool mEnableStrangenessTracking = false;
   bool mUseMC = false;
+  bool mReportMetrics = false;
   o2::vertexing::SVertexer mVertexer;
   o2::strangeness_tracking::StrangenessTracker mStrTracker;
   TStopwatch mTimer;
@@ -96,6 +98,7 @@ void SecondaryVertexingSpec::init(InitContext& ic)
   mVertexer.setEnable3BodyDecays(mEnable3BodyVertices);
   mVertexer.setNThreads(ic.options().get<int>("threads"));
   mVertexer.setUseMC(mUseMC);
+  mReportMetrics = ic.options().get<bool>("report-metrics");
   if (mEnableStrangenessTracking) {
     mStrTracker.setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrLUT);
     mStrTracker.setConfigParams(&o2::strangeness_tracking::StrangenessTrackingParamConfig::Instance());
@@ -127,6 +130,17 @@ void SecondaryVertexingSpec::run(ProcessingContext& pc)
        mVertexer.getNV0s(), calls[0] - fitCalls[0], mVertexer.getNCascades(), calls[1] - fitCalls[1], mVertexer.getN3Bodies(), calls[2] - fitCalls[2], mVertexer.getNStrangeTracks(),
        mTimer.CpuTime() - timeCPU0, mTimer.RealTime() - timeReal0);
   fitCalls = calls;
+  if (mReportMetrics) { // publish cumulative timer (ms) and fitter calls, per-TF candidate multiplicities
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mTimer.CpuTime() * 1000.), "svertexing_time_Total"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(calls[0]), "svertexing_fits_v0"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(calls[1]), "svertexing_fits_cascade"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(calls[2]), "svertexing_fits_3body"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getNV0s()), "svertexing_out_v0s"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getNCascades()), "svertexing_out_cascades"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getN3Bodies()), "svertexing_out_3bodies"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mVertexer.getNStrangeTracks()), "svertexing_out_strange_tracks"});
+  }
 }
 
 void SecondaryVertexingSpec::endOfStream(EndOfStreamContext& ec)
@@ -244,7 +258,8 @@ DataProcessorSpec getSecondaryVertexingSpec(GTrackID::mask_t src, bool enableCas
   std::vector<OutputSpec> outputs;
   Options opts{
     {"material-lut-path", VariantType::String, "", {"Path of the material LUT file"}},
-    {"threads", VariantType::Int, 1, {"Number of threads"}}};
+    {"threads", VariantType::Int, 1, {"Number of threads"}},
+    {"report-metrics", VariantType::Bool, false, {"Publish per-stage timing and multiplicity metrics to DPL monitoring"}}};
   auto dataRequest = std::make_shared<DataRequest>();
   if (enableCCDBParams) {
     dataRequest->inputs.emplace_back("SVParam", "GLO", "SVPARAM", 0, Lifetime::Condition, ccdbParamSpec("GLO/Config/SVertexerParam"));
@@ -22,6 +22,7 @@
 #include "DataFormatsGlobalTracking/RecoContainer.h"
 #include "Framework/Task.h"
 #include "Framework/DataProcessorSpec.h"
+#include "Framework/Monitoring.h"
 #include "TPCCalibration/VDriftHelper.h"
 #include "TPCCalibration/CorrectionMapsLoader.h"
 
@@ -80,6 +81,7 @@ class TOFMatcherSpec : public Task
   bool mDoTPCRefit = false;
   bool mStrict = false;
   bool mPushMatchable = false;
+  bool mReportMetrics = false;
   float mExtraTolTRD = 0.;
   int mNlanes = 1;
   MatchTOF mMatcher; ///< Cluster finder
@@ -98,6 +100,7 @@ void TOFMatcherSpec::init(InitContext& ic)
   mMatcher.storeMatchable(mPushMatchable);
   mMatcher.setExtraTimeToleranceTRD(mExtraTolTRD);
   mMatcher.setNlanes(mNlanes);
+  mReportMetrics = ic.options().get<bool>("report-metrics");
 }
 
 void TOFMatcherSpec::updateTimeDependentParams(ProcessingContext& pc)
@@ -229,6 +232,21 @@ void TOFMatcherSpec::run(ProcessingContext& pc)
   }
 
   mTimer.Stop();
+  if (mReportMetrics) { // publish per-stage timers (ms) and per-TF matched multiplicities
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mMatcher.getTimerTot().CpuTime() * 1000.), "tof_matching_time_Total"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mMatcher.getTimerMatchITSTPC().CpuTime() * 1000.), "tof_matching_time_MatchITSTPC"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mMatcher.getTimerMatchTPC().CpuTime() * 1000.), "tof_matching_time_MatchTPC"});
+    using TrackType = o2::dataformats::MatchInfoTOFReco::TrackType;
+    const TrackType types[4] = {TrackType::TPC, TrackType::ITSTPC, TrackType::TPCTRD, TrackType::ITSTPCTRD};
+    const bool used[4] = {isTPCused, isITSTPCused, isTPCTRDused, isITSTPCTRDused};
+    const char* typeNames[4] = {"TPC", "ITSTPC", "TPCTRD", "ITSTPCTRD"};
+    for (int it = 0; it < 4; it++) {
+      if (used[it]) {
+        monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mMatcher.getMatchedTrackVector(types[it]).size()), fmt::format("tof_matching_out_tracks_{}", typeNames[it])});
+      }
+    }
+  }
 }
 
 void TOFMatcherSpec::endOfStream(EndOfStreamContext& ec)
@@ -240,7 +258,8 @@ void TOFMatcherSpec::endOfStream(EndOfStreamContext& ec)
 DataProcessorSpec getTOFMatcherSpec(GID::mask_t src, bool useMC, bool useFIT, bool tpcRefit, bool strict, float extratolerancetrd, bool pushMatchable, const o2::tpc::CorrectionMapsLoaderGloOpts& sclOpts, int nlanes)
 {
   uint32_t ss = o2::globaltracking::getSubSpec(strict ? o2::globaltracking::MatchingType::Strict : o2::globaltracking::MatchingType::Standard);
-  Options opts;
+  Options opts{
+    {"report-metrics", VariantType::Bool, false, {"Publish per-stage timing and multiplicity metrics to DPL monitoring"}}};
   auto dataRequest = std::make_shared<DataRequest>();
   if (strict) {
     dataRequest->setMatchingInputStrict();
@@ -22,6 +22,7 @@
 #include "Framework/DataRefUtils.h"
 #include "Framework/CCDBParamSpec.h"
 #include "Framework/DeviceSpec.h"
+#include "Framework/Monitoring.h"
 #include <string>
 #include "TStopwatch.h"
 #include "Framework/ConfigParamRegistry.h"
@@ -93,6 +94,7 @@ class TPCITSMatchingDPL : public Task
   bool mCalibMode = false;
   bool mSkipTPCOnly = false; // to use only externally constrained tracks (for test only)
   bool mUseMC = true;
+  bool mReportMetrics = false;
   TStopwatch mTimer;
 };
 
@@ -107,6 +109,7 @@ void TPCITSMatchingDPL::init(InitContext& ic)
   mMatching.setNThreads(std::max(1, ic.options().get<int>("nthreads")));
   mMatching.setUseBCFilling(!ic.options().get<bool>("ignore-bc-check"));
   mMatching.setDebugFlag(ic.options().get<int>("debug-tree-flags"));
+  mReportMetrics = ic.options().get<bool>("report-metrics");
   mTPCCorrMapsLoader.init(ic);
 }
 
@@ -130,6 +133,16 @@ void TPCITSMatchingDPL::run(ProcessingContext& pc)
   mMatching.run(recoData, matchedTracks, ABTrackletRefs, ABTrackletClusterIDs, matchLabels, ABTrackletLabels, calib);
 
   mTimer.Stop();
+  if (mReportMetrics) { // publish per-stage cumulative timers (ms) and per-TF multiplicities
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    for (int i = 0; i < mMatching.getNTimers(); i++) {
+      monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(mMatching.getTimer(i).CpuTime() * 1000.), fmt::format("itstpc_matching_time_{}", mMatching.getTimerName(i))});
+    }
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(recoData.getITSTracks().size()), "itstpc_matching_in_its_tracks"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(recoData.getTPCTracks().size()), "itstpc_matching_in_tpc_tracks"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(matchedTracks.size()), "itstpc_matching_out_tracks"});
+    monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(ABTrackletRefs.size()), "itstpc_matching_out_ab_tracklets"});
+  }
 }
 
 void TPCITSMatchingDPL::endOfStream(EndOfStreamContext& ec)
@@ -293,7 +306,8 @@ DataProcessorSpec getTPCITSMatchingSpec(GTrackID::mask_t src, bool useFT0, bool
   Options opts{
     {"nthreads", VariantType::Int, 1, {"Number of afterburner threads"}},
     {"ignore-bc-check", VariantType::Bool, false, {"Do not check match candidate against BC filling"}},
-    {"debug-tree-flags", VariantType::Int, 0, {"DebugFlagTypes bit-pattern for debug tree"}}};
+    {"debug-tree-flags", VariantType::Int, 0, {"DebugFlagTypes bit-pattern for debug tree"}},
+    {"report-metrics", VariantType::Bool, false, {"Publish per-stage timing and multiplicity metrics to DPL monitoring"}}};
 
   o2::tpc::VDriftHelper::requestCCDBInputs(dataRequest->inputs);
   o2::tpc::CorrectionMapsLoader::requestCCDBInputs(dataRequest->inputs, opts, sclOpts);
@@ -22,8 +22,6 @@
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "SimulationDataFormat/MCCompLabel.h"
 
-#include "TMatrixF.h" // ef: added
-
 namespace o2
 {
 
@@ -47,8 +45,8 @@ class Clusterer
   // void setMCTruthContainer(o2::dataformats::MCTruthContainer<o2::MCCompLabel>* truth) { mClsLabels = truth; }
 
   static void Dig2Clu(gsl::span<const o2::hmpid::Digit> digs, std::vector<o2::hmpid::Cluster>& clus, float* pUserCut, bool isUnfold = kTRUE); // digits->clusters
-  static void FormClu(Cluster& pClu, int pDig, gsl::span<const o2::hmpid::Digit> digs, TMatrixF& pDigMap);                                    // cluster formation recursive algorithm
-  static int UseDig(int padX, int padY, TMatrixF& pDigMap);                                                                                   // use this pad's digit to form a cluster
+  static void FormClu(Cluster& pClu, int pDig, gsl::span<const o2::hmpid::Digit> digs, std::vector<int>& pDigMap);                            // cluster formation via connected-component walk
+  static int UseDig(int padX, int padY, std::vector<int>& pDigMap);                                                                           // use this pad's digit to form a cluster
   inline bool IsDigSurvive(Digit* pDig) const;                                                                                                // check for sigma cut
 
  private:
@@ -12,6 +12,7 @@
 /// \file Clusterer.cxx
 /// \brief Implementation of the HMPID cluster finder
 #include <algorithm>
+#include <array>
 #include "FairLogger.h" // for LOG
 #include "Framework/Logger.h"
 #include "HMPIDBase/Param.h"
@@ -43,35 +44,41 @@ void Clusterer::Dig2Clu(gsl::span<const o2::hmpid::Digit> digs, std::vector<o2::
     int x, y, m;
   };
 
-  TMatrixF padMap(Param::kMinPx, Param::kMaxPcx, Param::kMinPy, Param::kMaxPcy); // pads map for single chamber 0..159 x 0..143
+  constexpr int nPadsY = Param::kMaxPcy + 1;
+  constexpr int nPadsX = Param::kMaxPcx + 1;
 
-  int pUsedDig = -1;
+  // decode each digit once and bucket it per chamber, instead of rescanning
+  // (and re-decoding) the whole digit list for every chamber
+  std::vector<Pad> vPad(digs.size());
+  std::array<std::vector<int>, Param::kMaxCh + 1> chDigits;
   int padChX = 0, padChY = 0, module = 0;
-  std::vector<Pad> vPad;
+  for (size_t iDig = 0; iDig < digs.size(); iDig++) {
+    o2::hmpid::Digit::pad2Absolute(digs[iDig].getPadID(), &module, &padChX, &padChY);
+    vPad[iDig] = {padChX, padChY, module};
+    if (module >= Param::kMinCh && module <= Param::kMaxCh) {
+      chDigits[module].push_back(iDig);
+    }
+  }
+
+  std::vector<int> padMap(nPadsX * nPadsY, -1); // pads map for single chamber 0..159 x 0..143, -1 means no digit for this pad
   std::vector<const Digit*> digVec;
   for (int iCh = Param::kMinCh; iCh <= Param::kMaxCh; iCh++) { // chambers loop
-    padMap = (Float_t)-1;                                      // reset map to -1 (means no digit for this pad)
-    for (size_t iDig = 0; iDig < digs.size(); iDig++) {
-      o2::hmpid::Digit::pad2Absolute(digs[iDig].getPadID(), &module, &padChX, &padChY);
-      vPad.push_back({padChX, padChY, module});
-      if (module == iCh) {
-        padMap(padChX, padChY) = iDig; // fill the map for the given chamber, (padx,pady) cell takes digit index
-      }
-    } // digits loop for current chamber
-
-    for (size_t iDig = 0; iDig < digs.size(); iDig++) { // digits loop for current chamber
-      // o2::hmpid::Digit::pad2Absolute(digs[iDig].getPadID(), &module, &padChX, &padChY);
-      if (vPad.at(iDig).m != iCh || (pUsedDig = UseDig(vPad.at(iDig).x, vPad.at(iDig).y, padMap)) == -1) { // this digit is from other module or already taken in FormClu(), go after next digit
+    for (auto iDig : chDigits[iCh]) {
+      padMap[vPad[iDig].x * nPadsY + vPad[iDig].y] = iDig; // fill the map for the given chamber, (padx,pady) cell takes digit index
+    }
+    for (auto iDig : chDigits[iCh]) {                                      // digits loop for current chamber
+      int pUsedDig = UseDig(vPad[iDig].x, vPad[iDig].y, padMap);
+      if (pUsedDig == -1) { // this digit is already taken in FormClu(), go after next digit
         continue;
       }
       digVec.clear();
       Cluster clu;
       clu.setDigits(&digVec);
       clu.setCh(iCh);
-      FormClu(clu, pUsedDig, digs, padMap); // form cluster starting from this digit by recursion
+      FormClu(clu, pUsedDig, digs, padMap); // form cluster starting from this digit as a connected component
       clu.solve(&clus, pUserCut, isUnfold); // solve this cluster and add all unfolded clusters to provided list
     }                                       // digits loop for current chamber
-    vPad.clear();
+    // no map reset is needed: every fired cell was consumed by UseDig above
   } // chambers loop
   return;
 } // Dig2Clu()
@@ -114,52 +121,57 @@ void Clusterer::Dig2Clu(gsl::span<const o2::hmpid::Digit> digs, std::vector<o2::
 } // Dig2Clu()
 */
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Clusterer::FormClu(Cluster& pClu, int pDig, gsl::span<const o2::hmpid::Digit> digs, TMatrixF& pDigMap)
+void Clusterer::FormClu(Cluster& pClu, int pDig, gsl::span<const o2::hmpid::Digit> digs, std::vector<int>& pDigMap)
 {
-  // Forms the initial cluster as a combination of all adjascent digits. Starts from the given digit then calls itself recursevly  for all neighbours.
+  // Forms the initial cluster as a combination of all adjascent digits: the
+  // connected component of the seed digit in the pad map. The explicit stack
+  // replays the former recursion in the same depth-first order (the pending
+  // entries are the not-yet-tested neighbours of the open frames), so the
+  // digits enter the cluster in the same sequence and the solved clusters
+  // are unchanged.
   // Arguments: pClu - pointer to cluster being formed
   //   Returns: none
 
-  pClu.digAdd(&digs[pDig]); // take this digit in cluster
-  int cnt = 0;
-  int cx[4];
-  int cy[4];
+  std::vector<std::pair<int, int>> pads; // pad coordinates still to be tested
+  pads.reserve(16);
+
   int padChX = 0;
   int padChY = 0;
   int module = 0;
-  o2::hmpid::Digit::pad2Absolute(digs[pDig].getPadID(), &module, &padChX, &padChY);
+  // neighbours are tested in the order left, right, down, up, hence they are
+  // stacked in the reversed order
+  auto pushNeighbours = [&pads](int x, int y) {
+    if (y < Param::kMaxPcy) {
+      pads.emplace_back(x, y + 1); // up
+    }
+    if (y > Param::kMinPy) {
+      pads.emplace_back(x, y - 1); // down
+    }
+    if (x < Param::kMaxPcx) {
+      pads.emplace_back(x + 1, y); // right
+    }
+    if (x > Param::kMinPx) {
+      pads.emplace_back(x - 1, y); // left
+    }
+  };
 
-  if (padChX > Param::kMinPx) {
-    cx[cnt] = padChX - 1;
-    cy[cnt] = padChY;
-    cnt++;
-  } // left
-  if (padChX < Param::kMaxPcx) {
-    cx[cnt] = padChX + 1;
-    cy[cnt] = padChY;
-    cnt++;
-  } // right
-  if (padChY > Param::kMinPy) {
-    cx[cnt] = padChX;
-    cy[cnt] = padChY - 1;
-    cnt++;
-  } // down
-  if (padChY < Param::kMaxPcy) {
-    cx[cnt] = padChX;
-    cy[cnt] = padChY + 1;
-    cnt++;
-  } // up
-
-  for (int i = 0; i < cnt; i++) { // neighbours loop
-    pDig = UseDig(cx[i], cy[i], pDigMap);
-    if (pDig != -1) {
-      FormClu(pClu, pDig, digs, pDigMap);
-    } // check if this neighbour pad fired and mark it as taken
-  }   // neighbours loop
+  pClu.digAdd(&digs[pDig]); // take the seed digit in cluster
+  o2::hmpid::Digit::pad2Absolute(digs[pDig].getPadID(), &module, &padChX, &padChY);
+  pushNeighbours(padChX, padChY);
+
+  while (!pads.empty()) {
+    auto [x, y] = pads.back();
+    pads.pop_back();
+    pDig = UseDig(x, y, pDigMap);
+    if (pDig != -1) { // this neighbour pad fired and is not yet taken
+      pClu.digAdd(&digs[pDig]);
+      pushNeighbours(x, y);
+    }
+  }
 } // FormClu()
 
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-int Clusterer::UseDig(int padX, int padY, TMatrixF& pPadMap)
+int Clusterer::UseDig(int padX, int padY, std::vector<int>& pPadMap)
 {
   // Digit map contains a matrix if digit numbers.
   // Main operation in forming initial cluster is done here. Requested digit pointer is returned and this digit marked as taken.
@@ -167,8 +179,9 @@ int Clusterer::UseDig(int padX, int padY, TMatrixF& pPadMap)
   //            pDigLst   - list of digits for one sector
   //            pDigMap   - map of those digits
   //   Returns: index to digit if not yet used or -1 if used
-  int iDig = (int)pPadMap(padX, padY);
-  pPadMap(padX, padY) = -1; // take digit number from the map and reset this map cell to -1
+  int& cell = pPadMap[padX * (Param::kMaxPcy + 1) + padY];
+  int iDig = cell;
+  cell = -1; // take digit number from the map and reset this map cell to -1
   return iDig;
 }
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
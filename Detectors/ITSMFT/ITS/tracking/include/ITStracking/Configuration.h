@@ -132,6 +132,7 @@ struct VertexingParameters {
   int zSpan = -1;
 
   int nThreads = 1;
+  int nROFsPerBatch = 16; // Number of ROFs handed to a worker as one batch in the seeding loops
 };
 
 struct TimeFrameGPUParameters {
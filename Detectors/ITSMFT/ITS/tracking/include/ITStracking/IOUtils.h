@@ -47,6 +47,8 @@ class MCTruthContainer;
 namespace its
 {
 
+class TimeFrame;
+
 namespace ioutils
 {
 constexpr float DefClusErrorRow = o2::itsmft::SegmentationAlpide::PitchRow * 0.5;
@@ -57,6 +59,11 @@ constexpr float DefClusError2Col = DefClusErrorCol * DefClusErrorCol;
 void loadEventData(ROframe& events, gsl::span<const itsmft::CompClusterExt> clusters,
                    gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary* dict,
                    const dataformats::MCTruthContainer<MCCompLabel>* clsLabels = nullptr);
+/// load a single standalone event into the pooled TimeFrame storage (presented as one ROF);
+/// reusing the same TimeFrame across events gives an allocation-free steady state
+void loadEventData(TimeFrame& tf, gsl::span<const itsmft::CompClusterExt> clusters,
+                   gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary* dict,
+                   const dataformats::MCTruthContainer<MCCompLabel>* clsLabels = nullptr);
 int loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& events, gsl::span<const itsmft::CompClusterExt> clusters,
                     gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary* dict,
                     const dataformats::MCTruthContainer<MCCompLabel>* mClsLabels = nullptr);
@@ -36,11 +36,15 @@ namespace its
 
 using Vertex = o2::dataformats::Vertex<o2::dataformats::TimeStamp<int>>;
 
+/// Compatibility facade for the standalone/cosmics tools: single-event view with pooled
+/// storage. Reuse the same instance across events (setROframeId + load) to keep the
+/// steady state allocation-free, as for the TimeFrame used by the production path.
 class ROframe final
 {
  public:
   ROframe(int ROframeId, int nLayers);
   int getROFrameId() const;
+  void setROframeId(int ROframeId);
   const float3& getPrimaryVertex(const int) const;
   int getPrimaryVerticesNum() const;
   void addPrimaryVertex(const float, const float, const float);
@@ -74,7 +78,7 @@ class ROframe final
   void clear();
 
  private:
-  const int mROframeId;
+  int mROframeId;
   const o2::dataformats::MCTruthContainer<MCCompLabel>* mMClabels = nullptr;
   std::vector<float3> mPrimaryVertices;
   std::vector<std::vector<Cluster>> mClusters;
@@ -84,6 +88,8 @@ class ROframe final
 
 inline int ROframe::getROFrameId() const { return mROframeId; }
 
+inline void ROframe::setROframeId(int ROframeId) { mROframeId = ROframeId; }
+
 inline const float3& ROframe::getPrimaryVertex(const int vertexIndex) const { return mPrimaryVertices[vertexIndex]; }
 
 inline int ROframe::getPrimaryVerticesNum() const { return mPrimaryVertices.size(); }
@@ -163,6 +169,7 @@ inline void ROframe::addClusterExternalIndexToLayer(int layer, const int idx)
 
 inline void ROframe::clear()
 {
+  // the per-layer vectors retain their capacity, reused by the next event
   for (unsigned int iL = 0; iL < mClusters.size(); ++iL) {
     mClusters[iL].clear();
     mTrackingFrameInfo[iL].clear();
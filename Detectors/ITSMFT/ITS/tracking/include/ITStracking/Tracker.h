@@ -74,6 +74,13 @@ class Tracker
   bool isMatLUT() const;
   void setNThreads(int n);
   int getNThreads() const;
+  /// Restrict the next clustersToTracks calls to the ROF window [firstROF, firstROF + nROFs);
+  /// nROFs < 0 restores full-TF processing. Tracks are filled only for the ROFs of the window.
+  void setROFWindow(int firstROF, int nROFs)
+  {
+    mFirstROFToProcess = firstROF > 0 ? firstROF : 0;
+    mNROFsToProcess = nROFs;
+  }
   std::uint32_t mTimeFrameCounter = 0;
 
  private:
@@ -108,6 +115,8 @@ class Tracker
   std::vector<TrackingParameters> mTrkParams;
   o2::gpu::GPUChainITS* mRecoChain = nullptr;
 
+  int mFirstROFToProcess = 0; /// first ROF of the processed window
+  int mNROFsToProcess = -1;   /// number of ROFs in the processed window, -1 for the full TF
   unsigned int mNumberOfRuns{0};
 };
 
@@ -87,6 +87,12 @@ class TrackerTraits
   bool getSmoothing() const { return mApplySmoothing; }
   void setNThreads(int n);
   int getNThreads() const { return mNThreads; }
+  /// Restrict the processing to the ROF window [first, first + n); n < 0 processes the full TF
+  void setROFWindow(int first, int n)
+  {
+    mFirstROFToProcess = first > 0 ? first : 0;
+    mNROFsToProcess = n;
+  }
 
   o2::gpu::GPUChainITS* getChain() const { return mChain; }
 
@@ -110,6 +116,8 @@ class TrackerTraits
   TimeFrame* mTimeFrame;
   std::vector<TrackingParameters> mTrkParams;
   bool mIsGPU = false;
+  int mFirstROFToProcess = 0; /// first ROF of the processed window
+  int mNROFsToProcess = -1;   /// number of ROFs in the processed window, -1 for the full TF
 };
 
 inline float TrackerTraits::getBz() const
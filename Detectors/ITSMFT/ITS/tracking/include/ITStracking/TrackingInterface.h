@@ -62,6 +62,13 @@ class ITSTrackingInterface
 
   // Custom
   void setTraitsFromProvider(VertexerTraits*, TrackerTraits*, TimeFrame*);
+  /// Track only the ROF window [firstROF, firstROF + nROFs) of each TF, e.g. for
+  /// calibration iterations; nROFs < 0 (default) restores full-TF processing
+  void setROFWindow(int firstROF, int nROFs)
+  {
+    mFirstROFToProcess = firstROF;
+    mNROFsToProcess = nROFs;
+  }
   void setTrackingMode(TrackingMode mode = TrackingMode::Unset)
   {
     if (mode == TrackingMode::Unset) {
@@ -84,6 +91,8 @@ class ITSTrackingInterface
   bool mRunVertexer = true;
   bool mCosmicsProcessing = false;
   int mUseTriggers = 0;
+  int mFirstROFToProcess = 0;
+  int mNROFsToProcess = -1;
   TrackingMode mMode = TrackingMode::Unset;
   bool mOverrideBeamEstimation = false;
   const o2::itsmft::TopologyDictionary* mDict = nullptr;
@@ -25,6 +25,7 @@
 
 #include "ITSBase/GeometryTGeo.h"
 #include "ITStracking/Constants.h"
+#include "ITStracking/TimeFrame.h"
 #include "ITStracking/json.h"
 #include "MathUtils/Utils.h"
 #include "SimulationDataFormat/MCCompLabel.h"
@@ -113,6 +114,22 @@ void ioutils::loadEventData(ROframe& event, gsl::span<const itsmft::CompClusterE
   }
 }
 
+void ioutils::loadEventData(TimeFrame& tf, gsl::span<const itsmft::CompClusterExt> clusters,
+                            gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary* dict,
+                            const dataformats::MCTruthContainer<MCCompLabel>* clsLabels)
+{
+  if (clusters.empty()) {
+    std::cerr << "Missing clusters." << std::endl;
+    return;
+  }
+  // present the event as a single ROF: the pooled TimeFrame vectors are cleared
+  // retaining their capacity, so repeated loads do not go through the allocator
+  std::vector<o2::itsmft::ROFRecord> rofs(1);
+  rofs[0].setFirstEntry(0);
+  rofs[0].setNEntries(clusters.size());
+  tf.loadROFrameData(rofs, clusters, pattIt, dict, clsLabels);
+}
+
 int ioutils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& event, gsl::span<const itsmft::CompClusterExt> clusters, gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary* dict,
                              const dataformats::MCTruthContainer<MCCompLabel>* mcLabels)
 {
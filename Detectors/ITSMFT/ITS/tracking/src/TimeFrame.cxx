@@ -185,16 +185,17 @@ int TimeFrame::loadROFrameData(gsl::span<o2::itsmft::ROFRecord> rofs,
                                const itsmft::TopologyDictionary* dict,
                                const dataformats::MCTruthContainer<MCCompLabel>* mcLabels)
 {
+  // keep the capacities allocated for the previous time frame, they settle at the high watermark
   for (int iLayer{0}; iLayer < mUnsortedClusters.size(); ++iLayer) {
-    deepVectorClear(mUnsortedClusters[iLayer]);
-    deepVectorClear(mTrackingFrameInfo[iLayer]);
-    deepVectorClear(mClusterExternalIndices[iLayer]);
+    mUnsortedClusters[iLayer].clear();
+    mTrackingFrameInfo[iLayer].clear();
+    mClusterExternalIndices[iLayer].clear();
     mROFramesClusters[iLayer].resize(1, 0);
 
     if (iLayer < 2) {
-      deepVectorClear(mTrackletsIndexROF[iLayer]);
-      deepVectorClear(mNTrackletsPerCluster[iLayer]);
-      deepVectorClear(mNTrackletsPerClusterSum[iLayer]);
+      mTrackletsIndexROF[iLayer].clear();
+      mNTrackletsPerCluster[iLayer].clear();
+      mNTrackletsPerClusterSum[iLayer].clear();
     }
   }
 
@@ -202,7 +203,7 @@ int TimeFrame::loadROFrameData(gsl::span<o2::itsmft::ROFRecord> rofs,
   geom->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::T2L, o2::math_utils::TransformType::L2G));
 
   mNrof = 0;
-  deepVectorClear(mClusterSize);
+  mClusterSize.clear();
   mClusterSize.reserve(clusters.size());
   for (auto& rof : rofs) {
     for (int clusterId{rof.getFirstEntry()}; clusterId < rof.getFirstEntry() + rof.getNEntries(); ++clusterId) {
@@ -279,6 +280,7 @@ void TimeFrame::prepareClusters(const TrackingParameters& trkParam, const int ma
 {
   std::vector<ClusterHelper> cHelper;
   std::vector<int> clsPerBin(trkParam.PhiBins * trkParam.ZBins, 0);
+  std::vector<int> lutPerBin(clsPerBin.size());
   for (int rof{0}; rof < mNrof; ++rof) {
     if ((int)mMultiplicityCutMask.size() == mNrof && !mMultiplicityCutMask[rof]) {
       continue;
@@ -288,7 +290,6 @@ void TimeFrame::prepareClusters(const TrackingParameters& trkParam, const int ma
       const auto unsortedClusters{getUnsortedClustersOnLayer(rof, iLayer)};
       const int clustersNum{static_cast<int>(unsortedClusters.size())};
 
-      deepVectorClear(cHelper);
       cHelper.resize(clustersNum);
 
       for (int iCluster{0}; iCluster < clustersNum; ++iCluster) {
@@ -315,7 +316,6 @@ void TimeFrame::prepareClusters(const TrackingParameters& trkParam, const int ma
         h.bin = bin;
         h.ind = clsPerBin[bin]++;
       }
-      std::vector<int> lutPerBin(clsPerBin.size());
       lutPerBin[0] = 0;
       for (unsigned int iB{1}; iB < lutPerBin.size(); ++iB) {
         lutPerBin[iB] = lutPerBin[iB - 1] + clsPerBin[iB - 1];
@@ -349,15 +349,19 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
       resetRofPV();
       deepVectorClear(mTotVertPerIteration);
     }
-    deepVectorClear(mTracks);
-    deepVectorClear(mTracksLabel);
-    deepVectorClear(mLinesLabels);
-    if (resetVertices) {
-      deepVectorClear(mVerticesMCRecInfo);
-    }
+    // transient containers are cleared but keep their arenas allocated, so after a few
+    // time frames they are sized by the high watermark and refills allocate nothing
     mTracks.resize(mNrof);
     mTracksLabel.resize(mNrof);
     mLinesLabels.resize(mNrof);
+    for (int iRof{0}; iRof < mNrof; ++iRof) {
+      mTracks[iRof].clear();
+      mTracksLabel[iRof].clear();
+      mLinesLabels[iRof].clear();
+    }
+    if (resetVertices) {
+      mVerticesMCRecInfo.clear();
+    }
     mCells.resize(trkParam.CellsPerRoad());
     mCellsLookupTable.resize(trkParam.CellsPerRoad() - 1);
     mCellsNeighbours.resize(trkParam.CellsPerRoad() - 1);
@@ -369,19 +373,24 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     mIndexTableUtils.setTrackingParameters(trkParam);
     mPositionResolution.resize(trkParam.NLayers);
     mBogusClusters.resize(trkParam.NLayers, 0);
-    deepVectorClear(mLines);
-    deepVectorClear(mTrackletClusters);
     for (unsigned int iLayer{0}; iLayer < std::min((int)mClusters.size(), maxLayers); ++iLayer) {
-      deepVectorClear(mClusters[iLayer]);
+      mClusters[iLayer].clear();
       mClusters[iLayer].resize(mUnsortedClusters[iLayer].size());
-      deepVectorClear(mUsedClusters[iLayer]);
+      mUsedClusters[iLayer].clear();
       mUsedClusters[iLayer].resize(mUnsortedClusters[iLayer].size(), false);
       mPositionResolution[iLayer] = o2::gpu::CAMath::Sqrt(0.5 * (trkParam.SystErrorZ2[iLayer] + trkParam.SystErrorY2[iLayer]) + trkParam.LayerResolution[iLayer] * trkParam.LayerResolution[iLayer]);
     }
-    deepVectorClear(mIndexTables);
-    mIndexTables.resize(mClusters.size(), std::vector<int>(mNrof * (trkParam.ZBins * trkParam.PhiBins + 1), 0));
+    // keep the index table arenas allocated across time frames, only reset the content
+    mIndexTables.resize(mClusters.size());
+    for (auto& table : mIndexTables) {
+      table.assign(mNrof * (trkParam.ZBins * trkParam.PhiBins + 1), 0);
+    }
     mLines.resize(mNrof);
     mTrackletClusters.resize(mNrof);
+    for (int iRof{0}; iRof < mNrof; ++iRof) {
+      mLines[iRof].clear();
+      mTrackletClusters[iRof].clear();
+    }
 
     for (int iLayer{0}; iLayer < trkParam.NLayers; ++iLayer) {
       if (trkParam.SystErrorY2[iLayer] > 0.f || trkParam.SystErrorZ2[iLayer] > 0.f) {
@@ -403,15 +412,15 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
   mTotalTracklets = {0, 0};
   if (maxLayers < trkParam.NLayers) { // Vertexer only, but in both iterations
     for (size_t iLayer{0}; iLayer < maxLayers; ++iLayer) {
-      deepVectorClear(mUsedClusters[iLayer]);
+      mUsedClusters[iLayer].clear();
       mUsedClusters[iLayer].resize(mUnsortedClusters[iLayer].size(), false);
     }
   }
 
   mTotVertPerIteration.resize(1 + iteration);
   mNoVertexROF = 0;
-  deepVectorClear(mRoads);
-  deepVectorClear(mRoadLabels);
+  mRoads.clear();
+  mRoadLabels.clear();
 
   mMSangles.resize(trkParam.NLayers);
   mPhiCuts.resize(mClusters.size() - 1, 0.f);
@@ -434,19 +443,18 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
   }
 
   for (int iLayer{0}; iLayer < std::min((int)mTracklets.size(), maxLayers); ++iLayer) {
-    deepVectorClear(mTracklets[iLayer]);
-    deepVectorClear(mTrackletLabels[iLayer]);
+    mTracklets[iLayer].clear();
+    mTrackletLabels[iLayer].clear();
     if (iLayer < (int)mCells.size()) {
-      deepVectorClear(mCells[iLayer]);
-      deepVectorClear(mTrackletsLookupTable[iLayer]);
-      mTrackletsLookupTable[iLayer].resize(mClusters[iLayer + 1].size(), 0);
-      deepVectorClear(mCellLabels[iLayer]);
+      mCells[iLayer].clear();
+      mTrackletsLookupTable[iLayer].assign(mClusters[iLayer + 1].size(), 0);
+      mCellLabels[iLayer].clear();
     }
 
     if (iLayer < (int)mCells.size() - 1) {
-      deepVectorClear(mCellsLookupTable[iLayer]);
-      deepVectorClear(mCellsNeighbours[iLayer]);
-      deepVectorClear(mCellsNeighboursLUT[iLayer]);
+      mCellsLookupTable[iLayer].clear();
+      mCellsNeighbours[iLayer].clear();
+      mCellsNeighboursLUT[iLayer].clear();
     }
   }
 }
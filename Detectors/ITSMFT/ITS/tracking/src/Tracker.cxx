@@ -49,6 +49,8 @@ void Tracker::clustersToTracks(std::function<void(std::string s)> logger, std::f
 {
   double total{0};
   mTraits->UpdateTrackingParameters(mTrkParams);
+  mTraits->setROFWindow(mFirstROFToProcess, mNROFsToProcess);
+  const int nROFsInWindow{mNROFsToProcess < 0 ? mTimeFrame->getNrof() : std::min(mNROFsToProcess, mTimeFrame->getNrof() - mFirstROFToProcess)};
   int maxNvertices{-1};
   if (mTrkParams[0].PerPrimaryVertexProcessing) {
     for (int iROF{0}; iROF < mTimeFrame->getNrof(); ++iROF) {
@@ -65,7 +67,7 @@ void Tracker::clustersToTracks(std::function<void(std::string s)> logger, std::f
     int nTracklets{0}, nCells{0}, nNeighbours{0}, nTracks{-static_cast<int>(mTimeFrame->getNumberOfTracks())};
 
     total += evaluateTask(&Tracker::initialiseTimeFrame, "Timeframe initialisation", logger, iteration);
-    int nROFsIterations = mTrkParams[iteration].nROFsPerIterations > 0 ? mTimeFrame->getNrof() / mTrkParams[iteration].nROFsPerIterations + bool(mTimeFrame->getNrof() % mTrkParams[iteration].nROFsPerIterations) : 1;
+    int nROFsIterations = mTrkParams[iteration].nROFsPerIterations > 0 ? nROFsInWindow / mTrkParams[iteration].nROFsPerIterations + bool(nROFsInWindow % mTrkParams[iteration].nROFsPerIterations) : 1;
     int iVertex{std::min(maxNvertices, 0)};
 
     do {
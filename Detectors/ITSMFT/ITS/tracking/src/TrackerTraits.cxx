@@ -70,8 +70,10 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
 
   const Vertex diamondVert({mTrkParams[iteration].Diamond[0], mTrkParams[iteration].Diamond[1], mTrkParams[iteration].Diamond[2]}, {25.e-6f, 0.f, 0.f, 25.e-6f, 0.f, 36.f}, 1, 1.f);
   gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
-  int startROF{mTrkParams[iteration].nROFsPerIterations > 0 ? iROFslice * mTrkParams[iteration].nROFsPerIterations : 0};
-  int endROF{mTrkParams[iteration].nROFsPerIterations > 0 ? (iROFslice + 1) * mTrkParams[iteration].nROFsPerIterations + mTrkParams[iteration].DeltaROF : tf->getNrof()};
+  const int firstWindowROF{mFirstROFToProcess};
+  const int lastWindowROF{mNROFsToProcess < 0 ? tf->getNrof() : std::min(tf->getNrof(), mFirstROFToProcess + mNROFsToProcess)};
+  int startROF{mTrkParams[iteration].nROFsPerIterations > 0 ? firstWindowROF + iROFslice * mTrkParams[iteration].nROFsPerIterations : firstWindowROF};
+  int endROF{mTrkParams[iteration].nROFsPerIterations > 0 ? std::min(lastWindowROF, startROF + mTrkParams[iteration].nROFsPerIterations + mTrkParams[iteration].DeltaROF) : lastWindowROF};
   for (int rof0{startROF}; rof0 < endROF; ++rof0) {
     gsl::span<const Vertex> primaryVertices = mTrkParams[iteration].UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
     const int startVtx{iVertex >= 0 ? iVertex : 0};
@@ -128,14 +130,15 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
             if (layer1.empty()) {
               continue;
             }
+            const gsl::span<const int> indexTable1{tf->getIndexTable(rof1, iLayer + 1)};
 
             for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
               int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
               const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
               const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
               if constexpr (debugLevel) {
-                if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
-                    maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
+                if (firstBinIndex < 0 || firstBinIndex > indexTable1.size() ||
+                    maxBinIndex < 0 || maxBinIndex > indexTable1.size()) {
                   std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams[iteration].NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
                   std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
                   std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
@@ -143,8 +146,8 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
                   exit(1);
                 }
               }
-              const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
-              const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
+              const int firstRowClusterIndex = indexTable1[firstBinIndex];
+              const int maxRowClusterIndex = indexTable1[maxBinIndex];
 
               for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
 
@@ -297,25 +300,27 @@ void TrackerTraits::computeLayerCells(const int iteration)
     float resolution{o2::gpu::CAMath::Sqrt(0.5f * (mTrkParams[iteration].SystErrorZ2[iLayer] + mTrkParams[iteration].SystErrorZ2[iLayer + 1] + mTrkParams[iteration].SystErrorZ2[iLayer + 2] + mTrkParams[iteration].SystErrorY2[iLayer] + mTrkParams[iteration].SystErrorY2[iLayer + 1] + mTrkParams[iteration].SystErrorY2[iLayer + 2])) / mTrkParams[iteration].LayerResolution[iLayer]};
     resolution = resolution > 1.e-12 ? resolution : 1.f;
 #endif
-    const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
+    // hoist the per-layer containers out of the tracklet loops
+    const auto& currentLayerTracklets{tf->getTracklets()[iLayer]};
+    const auto& nextLayerTracklets{tf->getTracklets()[iLayer + 1]};
+    const auto& trackletsLUT{tf->getTrackletsLookupTable()[iLayer]};
+    const int currentLayerTrackletsNum{static_cast<int>(currentLayerTracklets.size())};
     for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
 
-      const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
+      const Tracklet& currentTracklet{currentLayerTracklets[iTracklet]};
       const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
-      const int nextLayerFirstTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
-      const int nextLayerLastTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
+      const int nextLayerFirstTrackletIndex{trackletsLUT[nextLayerClusterIndex]};
+      const int nextLayerLastTrackletIndex{trackletsLUT[nextLayerClusterIndex + 1]};
 
       if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
         continue;
       }
 
       for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
-        if (tf->getTracklets()[iLayer + 1][iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
+        if (nextLayerTracklets[iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
           break;
         }
-        const Tracklet& nextTracklet{tf->getTracklets()[iLayer + 1][iNextTracklet]};
+        const Tracklet& nextTracklet{nextLayerTracklets[iNextTracklet]};
         const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
 
 #ifdef OPTIMISATION_OUTPUT
@@ -417,19 +422,23 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
       continue;
     }
 
-    int layerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer].size())};
+    const auto& layerCells{mTimeFrame->getCells()[iLayer]};
+    auto& nextLayerCells{mTimeFrame->getCells()[iLayer + 1]};
+    const auto& cellsLUT{mTimeFrame->getCellsLookupTable()[iLayer]};
+    auto& neighboursLUT{mTimeFrame->getCellsNeighboursLUT()[iLayer]};
+    int layerCellsNum{static_cast<int>(layerCells.size())};
     std::vector<std::pair<int, int>> cellsNeighbours;
     cellsNeighbours.reserve(nextLayerCellsNum);
 
     for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
 
-      const auto& currentCellSeed{mTimeFrame->getCells()[iLayer][iCell]};
+      const auto& currentCellSeed{layerCells[iCell]};
       const int nextLayerTrackletIndex{currentCellSeed.getSecondTrackletIndex()};
-      const int nextLayerFirstCellIndex{mTimeFrame->getCellsLookupTable()[iLayer][nextLayerTrackletIndex]};
-      const int nextLayerLastCellIndex{mTimeFrame->getCellsLookupTable()[iLayer][nextLayerTrackletIndex + 1]};
+      const int nextLayerFirstCellIndex{cellsLUT[nextLayerTrackletIndex]};
+      const int nextLayerLastCellIndex{cellsLUT[nextLayerTrackletIndex + 1]};
       for (int iNextCell{nextLayerFirstCellIndex}; iNextCell < nextLayerLastCellIndex; ++iNextCell) {
 
-        auto nextCellSeed{mTimeFrame->getCells()[iLayer + 1][iNextCell]}; /// copy
+        auto nextCellSeed{nextLayerCells[iNextCell]}; /// copy
         if (nextCellSeed.getFirstTrackletIndex() != nextLayerTrackletIndex) {
           break;
         }
@@ -449,24 +458,27 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
           continue;
         }
 
-        mTimeFrame->getCellsNeighboursLUT()[iLayer][iNextCell]++;
+        neighboursLUT[iNextCell]++;
         cellsNeighbours.push_back(std::make_pair(iCell, iNextCell));
         const int currentCellLevel{currentCellSeed.getLevel()};
 
         if (currentCellLevel >= nextCellSeed.getLevel()) {
-          mTimeFrame->getCells()[iLayer + 1][iNextCell].setLevel(currentCellLevel + 1);
+          nextLayerCells[iNextCell].setLevel(currentCellLevel + 1);
         }
       }
     }
-    std::sort(cellsNeighbours.begin(), cellsNeighbours.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
-      return a.second < b.second;
-    });
-    mTimeFrame->getCellsNeighbours()[iLayer].clear();
-    mTimeFrame->getCellsNeighbours()[iLayer].reserve(cellsNeighbours.size());
-    for (auto& cellNeighboursIndex : cellsNeighbours) {
-      mTimeFrame->getCellsNeighbours()[iLayer].push_back(cellNeighboursIndex.first);
+    // the per-cell counts in the LUT allow distributing the neighbours in a single linear
+    // pass instead of sorting the pairs: they are produced in increasing iCell order, so
+    // each per-cell list stays ordered
+    auto& neighbours{mTimeFrame->getCellsNeighbours()[iLayer]};
+    neighbours.clear();
+    neighbours.resize(cellsNeighbours.size());
+    std::vector<int> offsets(nextLayerCellsNum);
+    std::exclusive_scan(neighboursLUT.begin(), neighboursLUT.end(), offsets.begin(), 0);
+    for (const auto& [cellIndex, nextCellIndex] : cellsNeighbours) {
+      neighbours[offsets[nextCellIndex]++] = cellIndex;
     }
-    std::inclusive_scan(mTimeFrame->getCellsNeighboursLUT()[iLayer].begin(), mTimeFrame->getCellsNeighboursLUT()[iLayer].end(), mTimeFrame->getCellsNeighboursLUT()[iLayer].begin());
+    std::inclusive_scan(neighboursLUT.begin(), neighboursLUT.end(), neighboursLUT.begin());
   }
 }
 
@@ -899,6 +911,7 @@ bool TrackerTraits::trackFollowing(TrackITSExt* track, int rof, bool outward, co
       if (layer1.empty()) {
         continue;
       }
+      const gsl::span<const int> indexTable{mTimeFrame->getIndexTable(rof, iLayer)};
 
       TrackITSExt currentHypo{hypo}, newHypo{hypo};
       bool first{true};
@@ -906,8 +919,8 @@ bool TrackerTraits::trackFollowing(TrackITSExt* track, int rof, bool outward, co
         int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
         const int firstBinIndex{mTimeFrame->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
         const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-        const int firstRowClusterIndex = mTimeFrame->getIndexTable(rof, iLayer)[firstBinIndex];
-        const int maxRowClusterIndex = mTimeFrame->getIndexTable(rof, iLayer)[maxBinIndex];
+        const int firstRowClusterIndex = indexTable[firstBinIndex];
+        const int maxRowClusterIndex = indexTable[maxBinIndex];
 
         for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
           if (iNextCluster >= (int)layer1.size()) {
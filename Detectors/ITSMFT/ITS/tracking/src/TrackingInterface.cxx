@@ -267,6 +267,7 @@ void ITSTrackingInterface::run(framework::ProcessingContext& pc)
 
     mTimeFrame->setMultiplicityCutMask(processingMask);
     mTimeFrame->setROFMask(processUPCMask);
+    mTracker->setROFWindow(mFirstROFToProcess, mNROFsToProcess);
     // Run CA tracker
     if constexpr (isGPU) {
       if (mMode == o2::its::TrackingMode::Async) {
@@ -187,9 +187,13 @@ void VertexerTraits::updateVertexingParameters(const std::vector<VertexingParame
 // Main functions
 void VertexerTraits::computeTracklets(const int iteration)
 {
+  // Batching ROFs per task amortises the scheduling overhead at pp rates, where single
+  // ROFs hold few clusters. Results are bin-identical for any batch size: all writes go
+  // through per-cluster offsets computed in the evaluation pass.
+  const int rofBatch{std::max(1, mVrtParams[iteration].nROFsPerBatch)};
 #pragma omp parallel num_threads(mNThreads)
   {
-#pragma omp for schedule(dynamic)
+#pragma omp for schedule(dynamic, rofBatch)
     for (short pivotRofId = 0; pivotRofId < mTimeFrame->getNrof(); ++pivotRofId) { // Pivot rofId: the rof for which the tracklets are computed
       bool skipROF = iteration && (int)mTimeFrame->getPrimaryVertices(pivotRofId).size() > mVrtParams[iteration].vertPerRofThreshold;
       short startROF{std::max((short)0, static_cast<short>(pivotRofId - mVrtParams[iteration].deltaRof))};
@@ -232,7 +236,7 @@ void VertexerTraits::computeTracklets(const int iteration)
 #pragma omp single
     mTimeFrame->getTracklets()[1].resize(mTimeFrame->getTotalTrackletsTF(1));
 
-#pragma omp for schedule(dynamic)
+#pragma omp for schedule(dynamic, rofBatch)
     for (int pivotRofId = 0; pivotRofId < mTimeFrame->getNrof(); ++pivotRofId) {
       bool skipROF = iteration && (int)mTimeFrame->getPrimaryVertices(pivotRofId).size() > mVrtParams[iteration].vertPerRofThreshold;
       short startROF{std::max((short)0, static_cast<short>(pivotRofId - mVrtParams[iteration].deltaRof))};
@@ -337,33 +341,38 @@ void VertexerTraits::computeTracklets(const int iteration)
 
 void VertexerTraits::computeTrackletMatching(const int iteration)
 {
-#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
-  for (int pivotRofId = 0; pivotRofId < mTimeFrame->getNrof(); ++pivotRofId) {
-    if (iteration && (int)mTimeFrame->getPrimaryVertices(pivotRofId).size() > mVrtParams[iteration].vertPerRofThreshold) {
-      continue;
-    }
-    mTimeFrame->getLines(pivotRofId).reserve(mTimeFrame->getNTrackletsCluster(pivotRofId, 0).size());
-    std::vector<bool> usedTracklets(mTimeFrame->getFoundTracklets(pivotRofId, 0).size(), false);
-    int startROF{std::max((short)0, static_cast<short>(pivotRofId - mVrtParams[iteration].deltaRof))};
-    int endROF{std::min(static_cast<short>(mTimeFrame->getNrof()), static_cast<short>(pivotRofId + mVrtParams[iteration].deltaRof + 1))};
-    for (auto targetRofId = startROF; targetRofId < endROF; ++targetRofId) {
-      trackletSelectionKernelHost(
-        mTimeFrame->getClustersOnLayer(targetRofId, 0),
-        mTimeFrame->getClustersOnLayer(pivotRofId, 1),
-        mTimeFrame->getUsedClustersROF(targetRofId, 0),
-        mTimeFrame->getUsedClustersROF(targetRofId, 2),
-        mTimeFrame->getFoundTracklets(pivotRofId, 0),
-        mTimeFrame->getFoundTracklets(pivotRofId, 1),
-        usedTracklets,
-        mTimeFrame->getNTrackletsCluster(pivotRofId, 0),
-        mTimeFrame->getNTrackletsCluster(pivotRofId, 1),
-        mTimeFrame->getLines(pivotRofId),
-        mTimeFrame->getLabelsFoundTracklets(pivotRofId, 0),
-        mTimeFrame->getLinesLabel(pivotRofId),
-        pivotRofId,
-        targetRofId,
-        mVrtParams[iteration].tanLambdaCut,
-        mVrtParams[iteration].phiCut);
+  const int rofBatch{std::max(1, mVrtParams[iteration].nROFsPerBatch)};
+#pragma omp parallel num_threads(mNThreads)
+  {
+    std::vector<bool> usedTracklets; // reused across the ROFs of a batch
+#pragma omp for schedule(dynamic, rofBatch)
+    for (int pivotRofId = 0; pivotRofId < mTimeFrame->getNrof(); ++pivotRofId) {
+      if (iteration && (int)mTimeFrame->getPrimaryVertices(pivotRofId).size() > mVrtParams[iteration].vertPerRofThreshold) {
+        continue;
+      }
+      mTimeFrame->getLines(pivotRofId).reserve(mTimeFrame->getNTrackletsCluster(pivotRofId, 0).size());
+      usedTracklets.assign(mTimeFrame->getFoundTracklets(pivotRofId, 0).size(), false);
+      int startROF{std::max((short)0, static_cast<short>(pivotRofId - mVrtParams[iteration].deltaRof))};
+      int endROF{std::min(static_cast<short>(mTimeFrame->getNrof()), static_cast<short>(pivotRofId + mVrtParams[iteration].deltaRof + 1))};
+      for (auto targetRofId = startROF; targetRofId < endROF; ++targetRofId) {
+        trackletSelectionKernelHost(
+          mTimeFrame->getClustersOnLayer(targetRofId, 0),
+          mTimeFrame->getClustersOnLayer(pivotRofId, 1),
+          mTimeFrame->getUsedClustersROF(targetRofId, 0),
+          mTimeFrame->getUsedClustersROF(targetRofId, 2),
+          mTimeFrame->getFoundTracklets(pivotRofId, 0),
+          mTimeFrame->getFoundTracklets(pivotRofId, 1),
+          usedTracklets,
+          mTimeFrame->getNTrackletsCluster(pivotRofId, 0),
+          mTimeFrame->getNTrackletsCluster(pivotRofId, 1),
+          mTimeFrame->getLines(pivotRofId),
+          mTimeFrame->getLabelsFoundTracklets(pivotRofId, 0),
+          mTimeFrame->getLinesLabel(pivotRofId),
+          pivotRofId,
+          targetRofId,
+          mVrtParams[iteration].tanLambdaCut,
+          mVrtParams[iteration].phiCut);
+      }
     }
   }
 
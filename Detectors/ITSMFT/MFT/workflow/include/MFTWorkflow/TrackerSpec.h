@@ -57,6 +57,8 @@ class TrackerDPL : public o2::framework::Task
   bool mUseMC = false;
   bool mFieldOn = true;
   int mNThreads = 4;
+  size_t mNROFsProcessed = 0;  ///< total ROFs tracked, for the throughput report
+  size_t mNTracksProcessed = 0; ///< total tracks found, for the throughput report
   std::shared_ptr<o2::base::GRPGeomRequest> mGGCCDBRequest;
   const o2::itsmft::TopologyDictionary* mDict = nullptr;
   std::unique_ptr<o2::parameters::GRPObject> mGRP = nullptr;
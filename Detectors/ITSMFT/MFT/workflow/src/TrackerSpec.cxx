@@ -19,6 +19,7 @@
 #include "MFTTracking/TrackCA.h"
 #include "MFTBase/GeometryTGeo.h"
 
+#include <atomic>
 #include <vector>
 #include <future>
 
@@ -113,8 +114,7 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   std::uint32_t roFrameId = 0;
   int nROFs = rofs.size();
-  auto rofsPerWorker = std::max(1, nROFs / mNThreads);
-  LOG(debug) << "nROFs = " << nROFs << " rofsPerWorker = " << rofsPerWorker;
+  LOG(debug) << "nROFs = " << nROFs;
 
   auto loadData = [&, this](auto& trackerVec, auto& roFrameDataVec) {
     auto& tracker = trackerVec[0]; // Use first tracker to load the data: serial operation
@@ -123,20 +123,23 @@ void TrackerDPL::run(ProcessingContext& pc)
     auto iROF = 0;
 
     for (const auto& rof : rofs) {
-      int worker = std::min(int(iROF / rofsPerWorker), mNThreads - 1);
-      auto& roFrameData = roFrameDataVec[worker].emplace_back();
+      auto& roFrameData = roFrameDataVec.emplace_back();
       int nclUsed = ioutils::loadROFrameData(rof, roFrameData, compClusters, pattIt, mDict, labels, tracker.get(), filter);
-      LOG(debug) << "ROframeId: " << iROF << ", clusters loaded : " << nclUsed << " on worker " << worker;
+      LOG(debug) << "ROframeId: " << iROF << ", clusters loaded : " << nclUsed;
       iROF++;
     }
   };
 
-  auto launchTrackFinder = [](auto* tracker, auto* workerROFs) {
+  // the workers pull the next pending ROF from a shared queue: the occupancy varies a lot
+  // between ROFs, so a static partition leaves threads idle on the tail of the heavy ones
+  auto launchTrackFinder = [](auto* tracker, auto* roFrames, std::atomic<size_t>* nextROF) {
 #ifdef _TIMING_
     long tStart = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count(), tStartROF = tStart, tEnd = tStart;
     size_t rofCNT = 0;
 #endif
-    for (auto& rofData : *workerROFs) {
+    size_t iROF;
+    while ((iROF = nextROF->fetch_add(1)) < roFrames->size()) {
+      auto& rofData = (*roFrames)[iROF];
       tracker->findTracks(rofData);
 #ifdef _TIMING_
       long tEndROF = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
@@ -145,29 +148,34 @@ void TrackerDPL::run(ProcessingContext& pc)
 #endif
     }
 #ifdef _TIMING_
-    LOGP(info, "launchTrackFinder| done: tracker:{} processed {} ROFS in {} mus", tracker->getTrackerID(), workerROFs->size(), tEnd - tStart);
+    LOGP(info, "launchTrackFinder| done: tracker:{} processed {} ROFS in {} mus", tracker->getTrackerID(), rofCNT, tEnd - tStart);
 #endif
   };
 
-  auto launchFitter = [](auto* tracker, auto* workerROFs) {
+  auto launchFitter = [](auto* tracker, auto* roFrames, std::atomic<size_t>* nextROF) {
 #ifdef _TIMING_
     long tStart = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
+    size_t rofCNT = 0;
+#endif
+    size_t iROF;
+    while ((iROF = nextROF->fetch_add(1)) < roFrames->size()) {
+      tracker->fitTracks((*roFrames)[iROF]);
+#ifdef _TIMING_
+      rofCNT++;
 #endif
-    for (auto& rofData : *workerROFs) {
-      tracker->fitTracks(rofData);
     }
 #ifdef _TIMING_
     long tEnd = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-    LOGP(info, "launchTrackFitter| done: tracker:{} fitted  {} ROFS in {} mus", tracker->getTrackerID(), workerROFs->size(), tEnd - tStart);
+    LOGP(info, "launchTrackFitter| done: tracker:{} fitted  {} ROFS in {} mus", tracker->getTrackerID(), rofCNT, tEnd - tStart);
 #endif
   };
 
   auto runMFTTrackFinder = [&, this](auto& trackerVec, auto& roFrameDataVec) {
+    std::atomic<size_t> nextROF{0};
     std::vector<std::future<void>> finder;
     for (int i = 0; i < mNThreads; i++) {
       auto& tracker = trackerVec[i];
-      auto& workerData = roFrameDataVec[i];
-      auto f = std::async(std::launch::async, launchTrackFinder, tracker.get(), &workerData);
+      auto f = std::async(std::launch::async, launchTrackFinder, tracker.get(), &roFrameDataVec, &nextROF);
       finder.push_back(std::move(f));
     }
 
@@ -177,11 +185,11 @@ void TrackerDPL::run(ProcessingContext& pc)
   };
 
   auto runTrackFitter = [&, this](auto& trackerVec, auto& roFrameDataVec) {
+    std::atomic<size_t> nextROF{0};
     std::vector<std::future<void>> fitter;
     for (int i = 0; i < mNThreads; i++) {
       auto& tracker = trackerVec[i];
-      auto& workerData = roFrameDataVec[i];
-      auto f = std::async(std::launch::async, launchFitter, tracker.get(), &workerData);
+      auto f = std::async(std::launch::async, launchFitter, tracker.get(), &roFrameDataVec, &nextROF);
       fitter.push_back(std::move(f));
     }
 
@@ -208,12 +216,8 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   if (mFieldOn) {
 
-    std::vector<std::vector<o2::mft::ROframe<TrackLTF>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
-    }
+    std::vector<o2::mft::ROframe<TrackLTF>> roFrameVec; // ROFrames in readout order, shared by the workers
+    roFrameVec.reserve(nROFs);
     LOG(debug) << "Loading data into ROFs.";
 
     mTimer[SWLoadData].Start(false);
@@ -238,41 +242,33 @@ void TrackerDPL::run(ProcessingContext& pc)
       mTimer[SWComputeLabels].Start(false);
       auto& tracker = mTrackerVec[0];
 
-      for (int i = 0; i < mNThreads; i++) {
-        for (auto& rofData : roFrameVec[i]) {
-          tracker->computeTracksMClabels(rofData.getTracks());
-          trackLabels.swap(tracker->getTrackLabels());
-          std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
-          trackLabels.clear();
-        }
+      for (auto& rofData : roFrameVec) {
+        tracker->computeTracksMClabels(rofData.getTracks());
+        trackLabels.swap(tracker->getTrackLabels());
+        std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
+        trackLabels.clear();
       }
       mTimer[SWComputeLabels].Stop();
     }
 
     auto rof = rofs.begin();
 
-    for (int i = 0; i < mNThreads; i++) {
-      for (auto& rofData : roFrameVec[i]) {
-        int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
-        tracks.swap(rofData.getTracks());
-        ntracksROF = tracks.size();
-        copyTracks(tracks, allTracksMFT, allClusIdx);
-
-        rof->setFirstEntry(firstROFTrackEntry);
-        rof->setNEntries(ntracksROF);
-        *rof++;
-        roFrameId++;
-      }
+    for (auto& rofData : roFrameVec) {
+      int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
+      tracks.swap(rofData.getTracks());
+      ntracksROF = tracks.size();
+      copyTracks(tracks, allTracksMFT, allClusIdx);
+
+      rof->setFirstEntry(firstROFTrackEntry);
+      rof->setNEntries(ntracksROF);
+      *rof++;
+      roFrameId++;
     }
 
   } else {
     LOG(debug) << "Field is off! ";
-    std::vector<std::vector<o2::mft::ROframe<TrackLTFL>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
-    }
+    std::vector<o2::mft::ROframe<TrackLTFL>> roFrameVec; // ROFrames in readout order, shared by the workers
+    roFrameVec.reserve(nROFs);
     LOG(debug) << "Loading data into ROFs.";
 
     mTimer[SWLoadData].Start(false);
@@ -297,33 +293,31 @@ void TrackerDPL::run(ProcessingContext& pc)
       mTimer[SWComputeLabels].Start(false);
       auto& tracker = mTrackerLVec[0];
 
-      for (int i = 0; i < mNThreads; i++) {
-        for (auto& rofData : roFrameVec[i]) {
-          tracker->computeTracksMClabels(rofData.getTracks());
-          trackLabels.swap(tracker->getTrackLabels());
-          std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
-          trackLabels.clear();
-        }
+      for (auto& rofData : roFrameVec) {
+        tracker->computeTracksMClabels(rofData.getTracks());
+        trackLabels.swap(tracker->getTrackLabels());
+        std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
+        trackLabels.clear();
       }
       mTimer[SWComputeLabels].Stop();
     }
 
     auto rof = rofs.begin();
 
-    for (int i = 0; i < mNThreads; i++) {
-      for (auto& rofData : roFrameVec[i]) {
-        int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
-        tracksL.swap(rofData.getTracks());
-        ntracksROF = tracksL.size();
-        copyTracks(tracksL, allTracksMFT, allClusIdx);
-        rof->setFirstEntry(firstROFTrackEntry);
-        rof->setNEntries(ntracksROF);
-        *rof++;
-        roFrameId++;
-      }
+    for (auto& rofData : roFrameVec) {
+      int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
+      tracksL.swap(rofData.getTracks());
+      ntracksROF = tracksL.size();
+      copyTracks(tracksL, allTracksMFT, allClusIdx);
+      rof->setFirstEntry(firstROFTrackEntry);
+      rof->setNEntries(ntracksROF);
+      *rof++;
+      roFrameId++;
     }
   }
 
+  mNROFsProcessed += nROFs;
+  mNTracksProcessed += allTracksMFT.size();
   LOG(info) << "MFTTracker pushed " << allTracksMFT.size() << " tracks";
 
   if (mUseMC) {
@@ -339,6 +333,11 @@ void TrackerDPL::endOfStream(EndOfStreamContext& ec)
   for (int i = 0; i < NStopWatches; i++) {
     LOGF(info, "Timing %18s: Cpu: %.3e s; Real: %.3e s in %d slots", TimerName[i], mTimer[i].CpuTime(), mTimer[i].RealTime(), mTimer[i].Counter() - 1);
   }
+  double trackingTime = mTimer[SWFindMFTTracks].RealTime() + mTimer[SWFitTracks].RealTime();
+  if (trackingTime > 0.) {
+    LOGF(info, "Throughput: %.1f ROFs/s, %.1f tracks/s (%zu ROFs, %zu tracks, %d threads)",
+         mNROFsProcessed / trackingTime, mNTracksProcessed / trackingTime, mNROFsProcessed, mNTracksProcessed, mNThreads);
+  }
 }
 ///_______________________________________
 void TrackerDPL::updateTimeDependentParams(ProcessingContext& pc)
@@ -20,6 +20,7 @@
 #include "Framework/Logger.h"
 #include "PayLoadCont.h"
 #include <map>
+#include <algorithm>
 #include <fmt/format.h>
 #include <iomanip>
 
@@ -121,7 +122,7 @@ class AlpideCoder
 
   static bool isEmptyChip(uint8_t b) { return (b & CHIPEMPTY) == CHIPEMPTY; }
 
-  static void setNoisyPixels(const NoiseMap* noise) { mNoisyPixels = noise; }
+  static void setNoisyPixels(const NoiseMap* noise);
 
   /// decode alpide data for the next non-empty chip from the buffer
   template <class T, typename CG>
@@ -753,16 +754,32 @@ class AlpideCoder
   /// Output a non-noisy fired pixel
   static void addHit(ChipPixelData& chipData, short row, short col)
   {
-    if (mNoisyPixels) {
-      auto chipID = chipData.getChipID();
-      if (mNoisyPixels->isNoisy(chipID, row, col)) {
-        return;
-      }
+    if (mNoisyPixels && isPixelMasked(chipData.getChipID(), row, col)) {
+      return;
     }
     LOGP(debug, "Add hit#{} at r:{}/c:{} of chip:{}", chipData.getData().size(), row, col, chipData.getChipID());
     chipData.getData().emplace_back(row, col);
   }
 
+  ///< consult the per-chip representation compiled by setNoisyPixels instead of the NoiseMap itself
+  static bool isPixelMasked(int chipID, short row, short col)
+  {
+    if (chipID >= int(mNoiseFilterMode.size())) { // filter not compiled (e.g. coder was streamed in)
+      return mNoisyPixels->isNoisy(chipID, row, col);
+    }
+    auto mode = mNoiseFilterMode[chipID];
+    if (mode == NoiseChipClean) {
+      return false;
+    }
+    uint32_t key = NoiseMap::getKey(row, col);
+    if (mode == NoiseChipBitmap) {
+      const auto& bmp = mNoiseBitmaps[mNoiseFilterRef[chipID]];
+      return key < NoiseKeySpan && ((bmp[key >> 6] >> (key & 0x3f)) & 0x1);
+    }
+    const auto& keys = mNoiseSparseKeys[mNoiseFilterRef[chipID]];
+    return std::binary_search(keys.begin(), keys.end(), int(key));
+  }
+
   ///< add pixed to compressed matrix, the data must be provided sorted in row/col, no check is done
   void addPixel(short row, short col)
   {
@@ -846,6 +863,18 @@ class AlpideCoder
 
   static const NoiseMap* mNoisyPixels;
 
+  // noise map compiled to flat per-chip structures cheap to probe for every fired pixel
+  enum NoiseChipMode : uint8_t { NoiseChipClean = 0,  // no pixel masked on this chip
+                                 NoiseChipSparse = 1, // few masked pixels, sorted key array
+                                 NoiseChipBitmap = 2  // heavily masked chip, 1 bit per pixel
+  };
+  static constexpr uint32_t NoiseKeySpan = NRows << 10;    // range of NoiseMap keys on one chip, key = (row<<10)+col
+  static constexpr size_t NoiseBitmapThreshold = 1024;     // masked pixels above which a chip gets a bitmap
+  static std::vector<uint8_t> mNoiseFilterMode;            //! per-chip NoiseChipMode
+  static std::vector<int> mNoiseFilterRef;                 //! per-chip index into the sparse or bitmap storage
+  static std::vector<std::vector<int>> mNoiseSparseKeys;   //! sorted masked-pixel keys of sparse chips
+  static std::vector<std::vector<uint64_t>> mNoiseBitmaps; //! pixel masks of heavily masked chips
+
   // cluster map used for the ENCODING only
   std::vector<int> mFirstInRow;     //! entry of 1st pixel of each non-empty row in the mPix2Encode
   std::vector<PixLink> mPix2Encode; //! pool of links: fired pixel + index of the next one in the row
@@ -271,6 +271,7 @@ struct GBTLinkDecodingStat {
   // Note: packet here is meant as a group of CRU pages belonging to the same trigger
   uint32_t nPackets = 0;                                                        // total number of packets (RDH pages)
   uint32_t nTriggers = 0;                                                       // total number of triggers (ROFs)
+  size_t nBytesProcessed = 0;                                                   // total payload bytes decoded on this link
   std::array<uint32_t, NErrorsDefined> errorCounts = {};                        // error counters
   std::array<uint32_t, GBTDataTrailer::MaxStateCombinations> packetStates = {}; // packet status from the trailer
 
@@ -278,13 +279,14 @@ struct GBTLinkDecodingStat {
   {
     nPackets = 0;
     nTriggers = 0;
+    nBytesProcessed = 0;
     errorCounts.fill(0);
     packetStates.fill(0);
   }
 
   void print(bool skipNoErr = true) const;
 
-  ClassDefNV(GBTLinkDecodingStat, 3);
+  ClassDefNV(GBTLinkDecodingStat, 4);
 };
 
 } // namespace itsmft
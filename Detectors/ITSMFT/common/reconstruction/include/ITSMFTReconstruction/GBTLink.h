@@ -294,6 +294,7 @@ GBTLink::CollectedDataStatus GBTLink::collectROFCableData(const Mapping& chmap)
       //      GBTLINK_DECODE_ERRORCHECK(checkErrorsRDHStopPageEmpty(*rdh)); // end of HBF should be an empty page with stop
       dataOffset += sizeof(RDH);
       lastPageSize = RDHUtils::getMemorySize(*rdh);
+      statistics.nBytesProcessed += lastPageSize;
       if (lastPageSize == sizeof(RDH)) {
         continue; // filter out empty page
       }
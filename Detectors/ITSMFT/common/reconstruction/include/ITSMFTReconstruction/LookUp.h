@@ -23,6 +23,7 @@
 #ifndef ALICEO2_ITSMFT_LOOKUP_H
 #define ALICEO2_ITSMFT_LOOKUP_H
 #include <array>
+#include <vector>
 #include "DataFormatsITSMFT/ClusterTopology.h"
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 
@@ -46,8 +47,13 @@ class LookUp
   auto getDictionaty() const { return mDictionary; }
 
  private:
+  void buildFlatTable();
+
   TopologyDictionary mDictionary;
   int mTopologiesOverThreshold;
+  std::vector<unsigned long> mFlatHash; //!< open-addressing table of topology hashes, rebuilt at dictionary load
+  std::vector<int> mFlatID;             //!< dictionary entry for each slot of mFlatHash, -1 for empty slots
+  unsigned long mFlatMask = 0;          //!< size of the flat table minus one (the size is a power of two)
 
   ClassDefNV(LookUp, 3);
 };
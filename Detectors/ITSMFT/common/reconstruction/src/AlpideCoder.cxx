@@ -17,6 +17,54 @@
 using namespace o2::itsmft;
 
 const NoiseMap* AlpideCoder::mNoisyPixels = nullptr;
+std::vector<uint8_t> AlpideCoder::mNoiseFilterMode;
+std::vector<int> AlpideCoder::mNoiseFilterRef;
+std::vector<std::vector<int>> AlpideCoder::mNoiseSparseKeys;
+std::vector<std::vector<uint64_t>> AlpideCoder::mNoiseBitmaps;
+
+//_____________________________________
+void AlpideCoder::setNoisyPixels(const NoiseMap* noise)
+{
+  // compile the noise map to per-chip structures cheap to probe for every fired pixel:
+  // a sorted key array for sparsely masked chips, a 1 bit per pixel bitmap (8 KB) for
+  // heavily masked ones, avoiding the per-pixel std::map lookup in the decoding hot loop
+  mNoisyPixels = noise;
+  mNoiseFilterMode.clear();
+  mNoiseFilterRef.clear();
+  mNoiseSparseKeys.clear();
+  mNoiseBitmaps.clear();
+  if (!noise) {
+    return;
+  }
+  mNoiseFilterMode.resize(noise->size(), NoiseChipClean);
+  mNoiseFilterRef.resize(noise->size(), -1);
+  for (size_t chipID = 0; chipID < noise->size(); chipID++) {
+    std::vector<int> keys;
+    keys.reserve(noise->getChip(chipID).size());
+    for (const auto& pair : noise->getChip(chipID)) {
+      if (pair.first >= 0) { // the full-chip mask marker has a negative key and is never probed per pixel
+        keys.push_back(pair.first);
+      }
+    }
+    if (keys.empty()) {
+      continue;
+    }
+    if (keys.size() > NoiseBitmapThreshold) {
+      mNoiseFilterMode[chipID] = NoiseChipBitmap;
+      mNoiseFilterRef[chipID] = mNoiseBitmaps.size();
+      auto& bmp = mNoiseBitmaps.emplace_back(NoiseKeySpan / 64, 0);
+      for (auto key : keys) {
+        if (uint32_t(key) < NoiseKeySpan) {
+          bmp[key >> 6] |= 0x1ULL << (key & 0x3f);
+        }
+      }
+    } else { // the std::map iteration above delivers the keys already sorted
+      mNoiseFilterMode[chipID] = NoiseChipSparse;
+      mNoiseFilterRef[chipID] = mNoiseSparseKeys.size();
+      mNoiseSparseKeys.emplace_back(std::move(keys));
+    }
+  }
+}
 
 //_____________________________________
 void AlpideCoder::print() const
@@ -37,6 +37,7 @@ void LookUp::loadDictionary(std::string fileName)
 {
   mDictionary.readFromFile(fileName);
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildFlatTable();
 }
 
 void LookUp::setDictionary(const TopologyDictionary* dict)
@@ -45,6 +46,30 @@ void LookUp::setDictionary(const TopologyDictionary* dict)
     mDictionary = *dict;
   }
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildFlatTable();
+}
+
+void LookUp::buildFlatTable()
+{
+  // Flat open-addressing mirror of mCommonMap: probing contiguous arrays with
+  // linear steps avoids the node allocations and pointer chasing of the
+  // unordered_map in the per-cluster lookup. The table is kept at most half
+  // full, so probe sequences are short.
+  size_t tableSize = 2;
+  while (tableSize < 2 * mDictionary.mCommonMap.size()) {
+    tableSize *= 2;
+  }
+  mFlatMask = tableSize - 1;
+  mFlatHash.assign(tableSize, 0);
+  mFlatID.assign(tableSize, -1);
+  for (const auto& entry : mDictionary.mCommonMap) {
+    auto slot = (entry.first * 0x9e3779b97f4a7c15UL) & mFlatMask;
+    while (mFlatID[slot] >= 0) {
+      slot = (slot + 1) & mFlatMask;
+    }
+    mFlatHash[slot] = entry.first;
+    mFlatID[slot] = entry.second;
+  }
 }
 
 int LookUp::groupFinder(int nRow, int nCol)
@@ -76,9 +101,19 @@ int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPatt
     }
   } else { // Big unique topology
     unsigned long hash = ClusterTopology::getCompleteHash(nRow, nCol, patt);
-    auto ret = mDictionary.mCommonMap.find(hash);
-    if (ret != mDictionary.mCommonMap.end()) {
-      return ret->second;
+    if (mFlatMask) {
+      auto slot = (hash * 0x9e3779b97f4a7c15UL) & mFlatMask;
+      while (mFlatID[slot] >= 0) {
+        if (mFlatHash[slot] == hash) {
+          return mFlatID[slot];
+        }
+        slot = (slot + 1) & mFlatMask;
+      }
+    } else { // the object was streamed in, the transient flat table is not available
+      auto ret = mDictionary.mCommonMap.find(hash);
+      if (ret != mDictionary.mCommonMap.end()) {
+        return ret->second;
+      }
     }
   }
   if (!mDictionary.mGroupMap.empty()) { // rare valid topology group
@@ -88,34 +88,50 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger()
   int nru = mRUDecodeVec.size();
   int prevNTrig = mExtTriggers.size();
   do {
+    // single parallel region per ROF: the serial IR poll runs on one thread between
+    // the two worksharing loops, so the team is forked and joined only once per ROF
+    bool haveIR = false;
 #ifdef WITH_OPENMP
-#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#pragma omp parallel num_threads(mNThreads)
 #endif
-    for (int iru = 0; iru < nru; iru++) {
-      collectROFCableData(iru);
-    }
-
-    mROFCounter++;
+    {
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for (int iru = 0; iru < nru; iru++) {
+        collectROFCableData(iru);
+      }
 
-    if (!doIRMajorityPoll()) {
-      continue; // no links with data
-    }
+#ifdef WITH_OPENMP
+#pragma omp single
+#endif
+      {
+        mROFCounter++;
+        haveIR = doIRMajorityPoll();
+      } // implicit barrier: all threads see the polled IR
 
+      if (haveIR) {
 #ifdef WITH_OPENMP
-#pragma omp parallel for schedule(dynamic) num_threads(mNThreads) reduction(+ \
-                                                                            : mNChipsFiredROF, mNPixelsFiredROF)
+#pragma omp for schedule(dynamic) reduction(+ \
+                                            : mNChipsFiredROF, mNPixelsFiredROF)
 #endif
-    for (int iru = 0; iru < nru; iru++) {
-      auto& ru = mRUDecodeVec[iru];
-      if (ru.nNonEmptyLinks) {
-        ru.ROFRampUpStage = mROFRampUpStage;
-        mNPixelsFiredROF += ru.decodeROF(mMAP, mInteractionRecord, mVerifyDecoder);
-        mNChipsFiredROF += ru.nChipsFired;
-      } else {
-        ru.clearSeenChipIDs();
+        for (int iru = 0; iru < nru; iru++) {
+          auto& ru = mRUDecodeVec[iru];
+          if (ru.nNonEmptyLinks) {
+            ru.ROFRampUpStage = mROFRampUpStage;
+            mNPixelsFiredROF += ru.decodeROF(mMAP, mInteractionRecord, mVerifyDecoder);
+            mNChipsFiredROF += ru.nChipsFired;
+          } else {
+            ru.clearSeenChipIDs();
+          }
+        }
       }
     }
 
+    if (!haveIR) {
+      continue; // no links with data
+    }
+
     if (mNChipsFiredROF || (mAlloEmptyROFs && mNLinksDone < mNLinksInTF)) { // fill some statistics
       mTrigger = mLinkForTriggers ? mLinkForTriggers->trigger : 0;
       mNChipsFired += mNChipsFiredROF;
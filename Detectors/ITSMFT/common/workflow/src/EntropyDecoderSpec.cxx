@@ -153,7 +153,8 @@ DataProcessorSpec getEntropyDecoderSpec(o2::header::DataOrigin orig, int verbosi
       {"ctf-dict", VariantType::String, "ccdb", {"CTF dictionary: empty or ccdb=CCDB, none=no external dictionary otherwise: local filename"}},
       {"mask-noise", VariantType::Bool, false, {"apply noise mask to digits or clusters (involves reclusterization)"}},
       {"ignore-cluster-dictionary", VariantType::Bool, false, {"do not use cluster dictionary, always store explicit patterns"}},
-      {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}}};
+      {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}},
+      {"ans-threads", VariantType::Int, 1, {"number of threads to decode independent CTF blocks"}}}};
 }
 
 } // namespace itsmft
@@ -19,6 +19,8 @@
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <stdexcept>
 #include <string>
@@ -69,13 +71,31 @@ class ClusterFinderOriginalTask
 
     mAttachInitalPrecluster = ic.options().get<bool>("attach-initial-precluster");
 
+    // in the parallel mode each additional thread clusterizes with its own
+    // finder instance, whose internal buffers act as a per-thread memory pool
+    // reused across preclusters and timeframes
+    mNThreads = std::max(1, ic.options().get<int>("n-clustering-threads"));
+    for (int iThread = 1; iThread < mNThreads; ++iThread) {
+      mAuxClusterFinders.emplace_back(std::make_unique<ClusterFinderOriginal>());
+      mAuxClusterFinders.back()->init(run2Config);
+    }
+    if (mNThreads > 1) {
+      LOGP(info, "clusterizing the preclusters with {} threads", mNThreads);
+    }
+
     /// Print the timer and clear the clusterizer when the processing is over
     ic.services().get<CallbackService>().set<CallbackService::Id::Stop>([this]() {
       LOG(info) << "cluster finder duration = " << mTimeClusterFinder.count() << " s";
+      if (mTimeClusterFinder.count() > 0.) {
+        LOGP(info, "cluster finder throughput = {:.1f} preclusters / s", mNPreClusters / mTimeClusterFinder.count());
+      }
       mErrorMap.forEach([](Error error) {
         LOGP(warning, fmt::runtime(error.asString()));
       });
       this->mClusterFinder.deinit();
+      for (auto& finder : this->mAuxClusterFinders) {
+        finder->deinit();
+      }
     });
   }
 
@@ -97,38 +117,50 @@ class ClusterFinderOriginalTask
     clusterROFs.reserve(preClusterROFs.size());
     auto& errorMap = mClusterFinder.getErrorMap();
     errorMap.clear();
+    for (auto& finder : mAuxClusterFinders) {
+      finder->getErrorMap().clear();
+    }
     for (const auto& preClusterROF : preClusterROFs) {
 
       // prepare to clusterize the current ROF
       auto clusterOffset = clusters.size();
       mClusterFinder.reset();
 
-      for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
-
-        auto preclusterDigits = digits.subspan(preCluster.firstDigit, preCluster.nDigits);
-        auto firstClusterIdx = mClusterFinder.getClusters().size();
-
-        // clusterize the current precluster
-        auto tStart = std::chrono::high_resolution_clock::now();
-        mClusterFinder.findClusters(preclusterDigits);
-        auto tEnd = std::chrono::high_resolution_clock::now();
-        mTimeClusterFinder += tEnd - tStart;
-
-        if (mAttachInitalPrecluster) {
-          // store the new clusters and associate them to all the digits of the precluster
-          writeClusters(preclusterDigits, firstClusterIdx, clusters, usedDigits);
+      if (mNThreads > 1) {
+        clusterizeROFParallel(preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries()),
+                              digits, clusters, usedDigits);
+      } else {
+        for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
+
+          auto preclusterDigits = digits.subspan(preCluster.firstDigit, preCluster.nDigits);
+          auto firstClusterIdx = mClusterFinder.getClusters().size();
+
+          // clusterize the current precluster
+          auto tStart = std::chrono::high_resolution_clock::now();
+          mClusterFinder.findClusters(preclusterDigits);
+          auto tEnd = std::chrono::high_resolution_clock::now();
+          mTimeClusterFinder += tEnd - tStart;
+
+          if (mAttachInitalPrecluster) {
+            // store the new clusters and associate them to all the digits of the precluster
+            writeClusters(preclusterDigits, firstClusterIdx, clusters, usedDigits);
+          }
         }
-      }
 
-      if (!mAttachInitalPrecluster) {
-        // store all the clusters of the current ROF and the associated digits actually used in the clustering
-        writeClusters(clusters, usedDigits);
+        if (!mAttachInitalPrecluster) {
+          // store all the clusters of the current ROF and the associated digits actually used in the clustering
+          writeClusters(clusters, usedDigits);
+        }
       }
 
       // create the cluster ROF
       clusterROFs.emplace_back(preClusterROF.getBCData(), clusterOffset, clusters.size() - clusterOffset,
                                preClusterROF.getBCWidth());
     }
+    for (auto& finder : mAuxClusterFinders) {
+      errorMap.add(finder->getErrorMap());
+    }
+    mNPreClusters += preClusters.size();
 
     // create the output message for clustering errors
     auto& clusterErrors = pc.outputs().make<std::vector<Error>>(OutputRef{"clustererrors"});
@@ -142,6 +174,86 @@ class ClusterFinderOriginalTask
   }
 
  private:
+  //_________________________________________________________________________________________________
+  void clusterizeROFParallel(gsl::span<const PreCluster> rofPreClusters, gsl::span<const Digit> digits,
+                             std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
+                             std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits)
+  {
+    /// clusterize the preclusters of one ROF in parallel: the preclusters are
+    /// distributed round-robin over the finder instances (a precluster never
+    /// spans detection elements, so they are independent), each thread works
+    /// only on its own finder, and the per-precluster output ranges are merged
+    /// below in the original precluster order to keep the output deterministic
+
+    struct OutputRange {
+      size_t firstCluster = 0;
+      size_t lastCluster = 0;
+      size_t firstDigit = 0;
+      size_t lastDigit = 0;
+    };
+    std::vector<OutputRange> ranges(rofPreClusters.size());
+
+    for (auto& finder : mAuxClusterFinders) {
+      finder->reset();
+    }
+
+    auto tStart = std::chrono::high_resolution_clock::now();
+    auto clusterizeShare = [this, &rofPreClusters, &digits, &ranges](int tid) {
+      auto& finder = (tid == 0) ? mClusterFinder : *mAuxClusterFinders[tid - 1];
+      for (size_t ip = tid; ip < rofPreClusters.size(); ip += mNThreads) {
+        const auto& preCluster = rofPreClusters[ip];
+        auto& range = ranges[ip];
+        range.firstCluster = finder.getClusters().size();
+        range.firstDigit = finder.getUsedDigits().size();
+        finder.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+        range.lastCluster = finder.getClusters().size();
+        range.lastDigit = finder.getUsedDigits().size();
+      }
+    };
+    std::vector<std::thread> workers;
+    for (int tid = 1; tid < mNThreads; ++tid) {
+      workers.emplace_back(clusterizeShare, tid);
+    }
+    clusterizeShare(0);
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    mTimeClusterFinder += tEnd - tStart;
+
+    // merge the per-finder outputs in precluster order
+    for (size_t ip = 0; ip < rofPreClusters.size(); ++ip) {
+      const auto& finder = (ip % mNThreads == 0) ? mClusterFinder : *mAuxClusterFinders[ip % mNThreads - 1];
+      const auto& range = ranges[ip];
+      if (range.firstCluster == range.lastCluster) {
+        continue;
+      }
+
+      auto clusterOffset = clusters.size();
+      clusters.insert(clusters.end(), finder.getClusters().begin() + range.firstCluster,
+                      finder.getClusters().begin() + range.lastCluster);
+
+      auto digitOffset = usedDigits.size();
+      if (mAttachInitalPrecluster) {
+        // attach all the digits of the initial precluster to the new clusters
+        const auto& preCluster = rofPreClusters[ip];
+        auto preclusterDigits = digits.subspan(preCluster.firstDigit, preCluster.nDigits);
+        usedDigits.insert(usedDigits.end(), preclusterDigits.begin(), preclusterDigits.end());
+        for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
+          itCluster->firstDigit = digitOffset;
+          itCluster->nDigits = preclusterDigits.size();
+        }
+      } else {
+        // attach only the digits actually used in the clustering
+        usedDigits.insert(usedDigits.end(), finder.getUsedDigits().begin() + range.firstDigit,
+                          finder.getUsedDigits().begin() + range.lastDigit);
+        for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
+          itCluster->firstDigit += digitOffset - range.firstDigit;
+        }
+      }
+    }
+  }
+
   //_________________________________________________________________________________________________
   void writeClusters(const gsl::span<const Digit>& preclusterDigits, size_t firstClusterIdx,
                      std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
@@ -184,10 +296,13 @@ class ClusterFinderOriginalTask
     }
   }
 
-  bool mAttachInitalPrecluster = false;               ///< attach all digits of initial precluster to cluster
-  ClusterFinderOriginal mClusterFinder{};             ///< clusterizer
-  ErrorMap mErrorMap{};                               ///< counting of encountered errors
-  std::chrono::duration<double> mTimeClusterFinder{}; ///< timer
+  bool mAttachInitalPrecluster = false;                                 ///< attach all digits of initial precluster to cluster
+  ClusterFinderOriginal mClusterFinder{};                               ///< clusterizer
+  int mNThreads = 1;                                                    ///< number of clustering threads
+  std::vector<std::unique_ptr<ClusterFinderOriginal>> mAuxClusterFinders{}; ///< additional clusterizer instances for the parallel mode
+  ErrorMap mErrorMap{};                                                 ///< counting of encountered errors
+  std::chrono::duration<double> mTimeClusterFinder{};                   ///< timer
+  size_t mNPreClusters = 0;                                             ///< number of preclusters processed (for the throughput report)
 };
 
 //_________________________________________________________________________________________________
@@ -205,7 +320,8 @@ o2::framework::DataProcessorSpec getClusterFinderOriginalSpec(const char* specNa
     AlgorithmSpec{adaptFromTask<ClusterFinderOriginalTask>()},
     Options{{"mch-config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
             {"run2-config", VariantType::Bool, false, {"setup for run2 data"}},
-            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}}}};
+            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}},
+            {"n-clustering-threads", VariantType::Int, 1, {"number of threads clusterizing the preclusters in parallel (1 = serial)"}}}};
 }
 
 } // end namespace mch
@@ -17,6 +17,8 @@
 #ifndef O2_MUON_TRACKMATCHER_H_
 #define O2_MUON_TRACKMATCHER_H_
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include <gsl/span>
@@ -55,9 +57,21 @@ class TrackMatcher
   const std::vector<TrackMCHMID>& getMuons() const { return mMuons; }
 
  private:
+  /// spatial hash of the MID tracks of one ROF at the ROF reference z-plane
+  struct MIDTrackIndex {
+    bool built = false;                                   ///< the index has been filled
+    double zRef = 0.;                                     ///< z-position of the reference plane
+    std::unordered_map<uint64_t, std::vector<int>> cells; ///< MID track indices per (x,y) cell
+  };
+
+  void buildMIDTrackIndex(MIDTrackIndex& index, const mid::ROFRecord& midROF,
+                          gsl::span<const mid::Track>& midTracks) const;
+  void findMIDCandidates(const MIDTrackIndex& index, const mch::TrackMCH& mchTrack,
+                         std::vector<int>& candidates) const;
   double match(const mch::TrackMCH& mchTrack, const mid::Track& midTrack);
 
   double mMaxChi2 = 0.;              ///< maximum chi2 to validate a MCH-MID track matching
+  double mPositionCut = 0.;          ///< half-width of the position window to pre-select MID candidates
   std::vector<TrackMCHMID> mMuons{}; ///< list of MCH-MID matched tracks
 };
 
@@ -29,6 +29,11 @@ struct TrackMatcherParam : public o2::conf::ConfigurableParamHelper<TrackMatcher
 
   double sigmaCut = 4.; ///< to select compatible MCH and MID tracks according to their matching chi2
 
+  /// half-width (cm) of the coarse position window at the MID plane used to pre-select
+  /// the MID candidates probed for each MCH track; it must stay large compared to the
+  /// matching resolution times sigmaCut not to lose matches (<= 0: probe all pairs)
+  double positionCut = 100.;
+
   O2ParamDef(TrackMatcherParam, "MUONMatching");
 };
 
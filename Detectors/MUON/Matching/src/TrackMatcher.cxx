@@ -15,6 +15,7 @@
 /// \author Philippe Pillot, Subatech
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 
 #include <Math/SMatrix.h>
@@ -33,6 +34,15 @@ using SMatrixSym4 = ROOT::Math::SMatrix<double, 4, 4, ROOT::Math::MatRepSym<doub
 using SMatrix4 = ROOT::Math::SMatrix<double, 4, 4, ROOT::Math::MatRepStd<double, 4>>;
 using SVector4 = ROOT::Math::SVector<double, 4>;
 
+namespace
+{
+/// pack the (x,y) cell coordinates into the spatial hash key
+uint64_t cellKey(int32_t ix, int32_t iy)
+{
+  return (uint64_t(uint32_t(ix)) << 32) | uint32_t(iy);
+}
+} // namespace
+
 //_________________________________________________________________________________________________
 /// prepare to run the matching algorithm
 void TrackMatcher::init()
@@ -40,6 +50,9 @@ void TrackMatcher::init()
   // set the maximum chi2 used for matching (4 parameters matched)
   const auto& trackMatcherParam = TrackMatcherParam::Instance();
   mMaxChi2 = 4. * trackMatcherParam.sigmaCut * trackMatcherParam.sigmaCut;
+
+  // set the size of the position window (= cell size of the spatial hash) to pre-select MID candidates
+  mPositionCut = trackMatcherParam.positionCut;
 }
 
 //_________________________________________________________________________________________________
@@ -59,6 +72,10 @@ void TrackMatcher::match(gsl::span<const mch::ROFRecord>& mchROFs, gsl::span<con
     midSortedROFs[midROFs[i].interactionRecord] = i;
   }
 
+  // spatial hashes of the MID tracks, one per ROF, built on first use
+  std::vector<MIDTrackIndex> midIndices(mPositionCut > 0. ? midROFs.size() : 0);
+  std::vector<int> candidates{};
+
   for (const auto& mchROF : mchROFs) {
 
     // find the MID ROFs in time with the MCH ROF
@@ -71,18 +88,35 @@ void TrackMatcher::match(gsl::span<const mch::ROFRecord>& mchROFs, gsl::span<con
       int iBestMIDROF(-1);
       uint32_t iBestMIDTrack(0);
 
+      // try to match the current MCH track with this MID track and keep the best matching
+      auto tryMatch = [&](int iMIDTrack, int iMIDROF) {
+        double matchChi2 = match(mchTracks[iMCHTrack], midTracks[iMIDTrack]);
+        if (matchChi2 < bestMatchChi2) {
+          bestMatchChi2 = matchChi2;
+          iBestMIDROF = iMIDROF;
+          iBestMIDTrack = uint32_t(iMIDTrack);
+        }
+      };
+
       for (auto itMIDROF = itStartMIDROF; itMIDROF != itEndMIDROF; ++itMIDROF) {
 
         const auto& midROF = midROFs[itMIDROF->second];
-        for (auto iMIDTrack = midROF.firstEntry; iMIDTrack < midROF.firstEntry + midROF.nEntries; ++iMIDTrack) {
 
-          // try to match the current MCH track with the current MID track and keep the best matching
-          double matchChi2 = match(mchTracks[iMCHTrack], midTracks[iMIDTrack]);
-          if (matchChi2 < bestMatchChi2) {
-            bestMatchChi2 = matchChi2;
-            iBestMIDROF = itMIDROF->second;
-            iBestMIDTrack = uint32_t(iMIDTrack);
+        if (mPositionCut > 0.) {
+          // probe only the MID tracks found close to the MCH track extrapolation in the spatial hash
+          auto& index = midIndices[itMIDROF->second];
+          if (!index.built) {
+            buildMIDTrackIndex(index, midROF, midTracks);
           }
+          findMIDCandidates(index, mchTracks[iMCHTrack], candidates);
+          for (auto iMIDTrack : candidates) {
+            tryMatch(iMIDTrack, itMIDROF->second);
+          }
+          continue;
+        }
+
+        for (auto iMIDTrack = midROF.firstEntry; iMIDTrack < midROF.firstEntry + midROF.nEntries; ++iMIDTrack) {
+          tryMatch(iMIDTrack, itMIDROF->second);
         }
       }
 
@@ -100,6 +134,50 @@ void TrackMatcher::match(gsl::span<const mch::ROFRecord>& mchROFs, gsl::span<con
   });
 }
 
+//_________________________________________________________________________________________________
+/// fill the spatial hash of the MID tracks of this ROF: each track is attached to the cell of
+/// size mPositionCut containing its (x,y) position extrapolated to the ROF reference z-plane
+void TrackMatcher::buildMIDTrackIndex(MIDTrackIndex& index, const mid::ROFRecord& midROF,
+                                      gsl::span<const mid::Track>& midTracks) const
+{
+  index.built = true;
+  if (midROF.nEntries == 0) {
+    return;
+  }
+  index.zRef = midTracks[midROF.firstEntry].getPositionZ();
+  for (auto iMIDTrack = midROF.firstEntry; iMIDTrack < midROF.firstEntry + midROF.nEntries; ++iMIDTrack) {
+    const auto& midTrack = midTracks[iMIDTrack];
+    double dZ = index.zRef - midTrack.getPositionZ();
+    auto ix = int32_t(std::floor((midTrack.getPositionX() + midTrack.getDirectionX() * dZ) / mPositionCut));
+    auto iy = int32_t(std::floor((midTrack.getPositionY() + midTrack.getDirectionY() * dZ) / mPositionCut));
+    index.cells[cellKey(ix, iy)].push_back(iMIDTrack);
+  }
+}
+
+//_________________________________________________________________________________________________
+/// collect the MID tracks of this indexed ROF whose position at the reference plane is within
+/// mPositionCut of the MCH track extrapolation (i.e. in the cell containing the extrapolation or
+/// in one of the 8 surrounding cells), in increasing track index so that the candidates are
+/// tested in the same order as in the exhaustive scan
+void TrackMatcher::findMIDCandidates(const MIDTrackIndex& index, const mch::TrackMCH& mchTrack,
+                                     std::vector<int>& candidates) const
+{
+  candidates.clear();
+  const double* mchParam = mchTrack.getParametersAtMID();
+  double dZ = index.zRef - mchTrack.getZAtMID();
+  auto ix0 = int32_t(std::floor((mchParam[0] + mchParam[1] * dZ) / mPositionCut));
+  auto iy0 = int32_t(std::floor((mchParam[2] + mchParam[3] * dZ) / mPositionCut));
+  for (auto ix = ix0 - 1; ix <= ix0 + 1; ++ix) {
+    for (auto iy = iy0 - 1; iy <= iy0 + 1; ++iy) {
+      auto itCell = index.cells.find(cellKey(ix, iy));
+      if (itCell != index.cells.end()) {
+        candidates.insert(candidates.end(), itCell->second.begin(), itCell->second.end());
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+}
+
 //_________________________________________________________________________________________________
 /// compute the matching chi2/ndf between these MCH and MID tracks
 double TrackMatcher::match(const mch::TrackMCH& mchTrack, const mid::Track& midTrack)
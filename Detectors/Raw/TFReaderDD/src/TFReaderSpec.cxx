@@ -41,6 +41,8 @@
 #include <climits>
 #include <regex>
 #include <deque>
+#include <list>
+#include <mutex>
 #include <chrono>
 #include <thread>
 
@@ -60,6 +62,13 @@ class TFReaderSpec : public o2f::Task
 
   using TFMap = std::unordered_map<std::string, std::unique_ptr<fair::mq::Parts>>; // map of channel / TFparts
 
+  // TF built by one of the parallel builders, waiting in the reorder stage for its emission turn
+  struct BuiltTF {
+    size_t fileSeq = 0;  // fetch sequence number of the source file
+    size_t tfInFile = 0; // TF index within the file
+    std::unique_ptr<TFMap> tf;
+  };
+
   explicit TFReaderSpec(const TFReaderInp& rinp);
   void init(o2f::InitContext& ic) final;
   void run(o2f::ProcessingContext& ctx) final;
@@ -68,6 +77,8 @@ class TFReaderSpec : public o2f::Task
  private:
   void stopProcessing(o2f::ProcessingContext& ctx);
   void TFBuilder();
+  void TFBuilderMT();                  // parallel builder, every thread processes its own file
+  void drainStaged(bool flush = false); // release TFs from the reorder stage, mStageMtx must be held
 
  private:
   fair::mq::Device* mDevice = nullptr;
@@ -85,6 +96,19 @@ class TFReaderSpec : public o2f::Task
   bool mWaitSendingLast = false;
   TFReaderInp mInput; // command line inputs
   std::thread mTFBuilderThread{};
+  // >> bounded reorder stage for the parallel builders
+  std::vector<std::thread> mTFBuilderThreads;
+  std::mutex mFetchMtx;                          // arbitrates the file fetcher between the builders
+  std::mutex mStageMtx;                          // protects the reorder stage
+  std::list<BuiltTF> mStaged;                    // built TFs waiting for their emission turn
+  std::unordered_map<size_t, size_t> mDoneFiles; // fileSeq -> number of TFs the file provided
+  size_t mFileSeqCounter = 0;                    // next file sequence number to assign
+  size_t mNextFileSeq = 0;                       // file whose TFs are to be emitted next
+  size_t mNextTFInFile = 0;                      // next in-order TF of this file
+  size_t mEmittedTFs = 0;                        // TFs passed to the sending queue, defines the timeslice
+  size_t mLateTFs = 0;                           // TFs emitted out of order after the window got exhausted
+  int mActiveBuilders = 0;
+  // << bounded reorder stage
 };
 
 //___________________________________________________________
@@ -99,6 +123,10 @@ TFReaderSpec::TFReaderSpec(const TFReaderInp& rinp) : mInput(rinp)
 void TFReaderSpec::init(o2f::InitContext& ic)
 {
   mInput.tfIDs = o2::RangeTokenizer::tokenize<int>(ic.options().get<std::string>("select-tf-ids"));
+  if (mInput.nBuilderThreads > 1 && !mInput.tfIDs.empty()) {
+    LOG(warning) << "TF IDs selection is order-dependent, falling back to a single TF builder thread";
+    mInput.nBuilderThreads = 1;
+  }
   mFileFetcher = std::make_unique<o2::utils::FileFetcher>(mInput.inpdata, mInput.tffileRegex, mInput.remoteRegex, mInput.copyCmd);
   mFileFetcher->setMaxFilesInQueue(mInput.maxFileCache);
   mFileFetcher->setMaxLoops(mInput.maxLoops);
@@ -112,9 +140,25 @@ void TFReaderSpec::run(o2f::ProcessingContext& ctx)
   if (!mDevice) {
     mDevice = ctx.services().get<o2f::RawDeviceService>().device();
     mOutputRoutes = ctx.services().get<o2f::RawDeviceService>().spec().outputs; // copy!!!
-    // start TFBuilder thread
+    if (mInput.nBuilderThreads > 1) { // routing by timeslice cannot be predicted before the emission order is known
+      for (const auto& oroute : mOutputRoutes) {
+        if (oroute.maxTimeslices > 1) {
+          LOG(warning) << "Time-pipelined outputs are incompatible with parallel TF building, falling back to a single TF builder thread";
+          mInput.nBuilderThreads = 1;
+          break;
+        }
+      }
+    }
+    // start TFBuilder thread(s)
     mRunning = true;
-    mTFBuilderThread = std::thread(&TFReaderSpec::TFBuilder, this);
+    if (mInput.nBuilderThreads > 1) {
+      mActiveBuilders = mInput.nBuilderThreads;
+      for (int i = 0; i < mInput.nBuilderThreads; i++) {
+        mTFBuilderThreads.emplace_back(&TFReaderSpec::TFBuilderMT, this);
+      }
+    } else {
+      mTFBuilderThread = std::thread(&TFReaderSpec::TFBuilder, this);
+    }
   }
   static auto tLastTF = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
   auto device = ctx.services().get<o2f::RawDeviceService>().device();
@@ -298,6 +342,11 @@ void TFReaderSpec::endOfStream(o2f::EndOfStreamContext& ec)
   if (mTFBuilderThread.joinable()) {
     mTFBuilderThread.join();
   }
+  for (auto& th : mTFBuilderThreads) {
+    if (th.joinable()) {
+      th.join();
+    }
+  }
 }
 
 //___________________________________________________________
@@ -309,6 +358,9 @@ void TFReaderSpec::stopProcessing(o2f::ProcessingContext& ctx)
   }
   stopDone = true;
   LOGP(info, "{} TFs in {}  loops were sent, spent {:.2} s in {} data waiting states", mTFCounter, mFileFetcher->getNLoops(), 1e-6 * mTotalWaitTime, mNWaits);
+  if (mLateTFs) {
+    LOGP(warn, "{} TFs were emitted out of their build order after exhausting the reorder window of {}", mLateTFs, mInput.reorderWindow);
+  }
   mRunning = false;
   if (mFileFetcher) {
     mFileFetcher->stop();
@@ -317,6 +369,11 @@ void TFReaderSpec::stopProcessing(o2f::ProcessingContext& ctx)
   if (mTFBuilderThread.joinable()) {
     mTFBuilderThread.join();
   }
+  for (auto& th : mTFBuilderThreads) {
+    if (th.joinable()) {
+      th.join();
+    }
+  }
   if (!mInput.rawChannelConfig.empty()) {
     auto device = ctx.services().get<o2f::RawDeviceService>().device();
     o2f::SourceInfoHeader exitHdr;
@@ -435,6 +492,115 @@ void TFReaderSpec::TFBuilder()
   }
 }
 
+//____________________________________________________________
+void TFReaderSpec::TFBuilderMT()
+{
+  // parallel version of the TFBuilder: every thread processes its own file, the built TFs
+  // pass through the bounded reorder stage which restores the emission order
+  auto sleepTime = std::chrono::microseconds(mInput.delay_us > 10000 ? mInput.delay_us : 10000);
+  while (mRunning && mDevice) {
+    std::string tfFileName;
+    size_t fileSeq = 0;
+    {
+      std::lock_guard<std::mutex> lock(mFetchMtx);
+      tfFileName = mFileFetcher ? mFileFetcher->getNextFileInQueue() : "";
+      if (!mRunning ||
+          (tfFileName.empty() && !mFileFetcher->isRunning()) ||
+          mTFBuilderCounter >= mInput.maxTFs) {
+        break; // stopped or no more files in the queue is expected or needed
+      }
+      if (!tfFileName.empty()) { // detach the file from the queue so that other builders get the next one
+        fileSeq = mFileSeqCounter++;
+        mFileFetcher->popFromQueue(mFileFetcher->getNLoops() >= mInput.maxLoops);
+      }
+    }
+    if (tfFileName.empty()) {
+      std::this_thread::sleep_for(10ms); // wait for the files cache to be filled
+      continue;
+    }
+    LOG(info) << "Processing file " << tfFileName;
+    SubTimeFrameFileReader reader(tfFileName, mInput.detMask);
+    size_t locID = 0;
+    while (mRunning && mTFBuilderCounter < mInput.maxTFs) {
+      if (mTFQueue.size() >= size_t(mInput.maxTFCache)) {
+        std::this_thread::sleep_for(sleepTime);
+        continue;
+      }
+      // the slice is provisional, the header stacks are re-stamped when the emission order is known
+      auto tf = reader.read(mDevice, mOutputRoutes, mInput.rawChannelConfig, 0, mInput.sup0xccdb, mInput.verbosity);
+      if (!tf) {
+        break;
+      }
+      std::lock_guard<std::mutex> lock(mStageMtx);
+      mTFBuilderCounter++;
+      mStaged.push_back({fileSeq, locID++, std::move(tf)});
+      drainStaged();
+    }
+    std::lock_guard<std::mutex> lock(mStageMtx);
+    mDoneFiles[fileSeq] = locID; // allow the emission cursor to pass over this file
+    drainStaged();
+  }
+  std::lock_guard<std::mutex> lock(mStageMtx);
+  if (--mActiveBuilders == 0) { // last builder to finish: flush the stage and signal completion
+    drainStaged(true);
+    LOG(info) << "TFReader stops processing";
+    if (mFileFetcher) {
+      mFileFetcher->stop();
+    }
+    mRunning = false;
+    mWaitSendingLast = false;
+  }
+}
+
+//____________________________________________________________
+void TFReaderSpec::drainStaged(bool flush)
+{
+  // release in-order TFs from the reorder stage (mStageMtx must be held by the caller); when the
+  // window is exhausted while the next in-order TF is still being built, or at the final flush,
+  // the oldest staged TF is emitted ahead of it so that one slow file does not stall the stream
+  while (!mStaged.empty()) {
+    auto done = mDoneFiles.find(mNextFileSeq); // advance the cursor over fully emitted files
+    while (done != mDoneFiles.end() && mNextTFInFile >= done->second) {
+      mDoneFiles.erase(done);
+      mNextFileSeq++;
+      mNextTFInFile = 0;
+      done = mDoneFiles.find(mNextFileSeq);
+    }
+    auto oldest = mStaged.begin();
+    bool inOrder = false;
+    for (auto it = mStaged.begin(); it != mStaged.end(); ++it) {
+      if (it->fileSeq == mNextFileSeq && it->tfInFile == mNextTFInFile) {
+        oldest = it;
+        inOrder = true;
+        break;
+      }
+      if (it->fileSeq < oldest->fileSeq || (it->fileSeq == oldest->fileSeq && it->tfInFile < oldest->tfInFile)) {
+        oldest = it;
+      }
+    }
+    if (!inOrder && !flush && int(mStaged.size()) < mInput.reorderWindow) {
+      break; // keep waiting for the in-order TF within the window
+    }
+    if (inOrder) {
+      mNextTFInFile++;
+    } else if (!flush) {
+      mLateTFs++;
+      LOGP(warn, "Reorder window of {} TFs exhausted, emitting TF {} of file {} ahead of the in-order one", mInput.reorderWindow, oldest->tfInFile, oldest->fileSeq);
+    }
+    for (auto& msgIt : *oldest->tf) { // re-stamp the timeslice according to the emission order
+      auto& parts = *msgIt.second;
+      for (int ip = 0; ip < parts.Size(); ip += 2) {
+        auto* dph = const_cast<o2f::DataProcessingHeader*>(o2h::get<o2f::DataProcessingHeader*>(parts[ip].GetData()));
+        dph->startTime = mEmittedTFs;
+      }
+    }
+    mEmittedTFs++;
+    mWaitSendingLast = true;
+    mTFQueue.push(std::move(oldest->tf));
+    mStaged.erase(oldest);
+  }
+}
+
 //_________________________________________________________
 o2f::DataProcessorSpec o2::rawdd::getTFReaderSpec(o2::rawdd::TFReaderInp& rinp)
 {
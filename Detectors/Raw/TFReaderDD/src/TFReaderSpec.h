@@ -39,6 +39,8 @@ struct TFReaderInp {
   int tfRateLimit = -999;
   int maxTFCache = 1;
   int maxFileCache = 1;
+  int nBuilderThreads = 1;
+  int reorderWindow = 8;
   int verbosity = 0;
   int64_t delay_us = 0;
   int maxLoops = 0;
@@ -36,6 +36,8 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"remote-regex", VariantType::String, "^(alien://|)/alice/data/.+", {"regex string to identify remote files"}}); // Use "^/eos/aliceo2/.+" for direct EOS access
   options.push_back(ConfigParamSpec{"max-cached-tf", VariantType::Int, 3, {"max TFs to cache in memory"}});
   options.push_back(ConfigParamSpec{"max-cached-files", VariantType::Int, 3, {"max TF files queued (copied for remote source)"}});
+  options.push_back(ConfigParamSpec{"tf-builder-threads", VariantType::Int, 1, {"number of parallel TF builder threads, each processing its own file"}});
+  options.push_back(ConfigParamSpec{"tf-reorder-window", VariantType::Int, 8, {"max TFs built out of order to stage before emitting the oldest available one"}});
   options.push_back(ConfigParamSpec{"tf-reader-verbosity", VariantType::Int, 0, {"verbosity level (1 or 2: check RDH, print DH/DPH for 1st or all slices, >2 print RDH)"}});
   options.push_back(ConfigParamSpec{"raw-channel-config", VariantType::String, "", {"optional raw FMQ channel for non-DPL output"}});
   options.push_back(ConfigParamSpec{"send-diststf-0xccdb", VariantType::Bool, false, {"send explicit FLP/DISTSUBTIMEFRAME/0xccdb output"}});
@@ -76,6 +78,8 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   rinp.verbosity = configcontext.options().get<int>("tf-reader-verbosity");
   rinp.maxTFCache = std::max(1, configcontext.options().get<int>("max-cached-tf"));
   rinp.maxFileCache = std::max(1, configcontext.options().get<int>("max-cached-files"));
+  rinp.nBuilderThreads = std::max(1, configcontext.options().get<int>("tf-builder-threads"));
+  rinp.reorderWindow = std::max(1, configcontext.options().get<int>("tf-reorder-window"));
   rinp.copyCmd = configcontext.options().get<std::string>("copy-cmd");
   rinp.tffileRegex = configcontext.options().get<std::string>("tf-file-regex");
   rinp.remoteRegex = configcontext.options().get<std::string>("remote-regex");
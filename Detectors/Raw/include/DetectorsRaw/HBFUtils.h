@@ -16,6 +16,9 @@
 #define ALICEO2_HBFUTILS_H
 
 #include <Rtypes.h>
+#include <gsl/span>
+#include <stdexcept>
+#include <vector>
 #include "DetectorsRaw/RDHUtils.h"
 #include "CommonUtils/ConfigurableParam.h"
 #include "CommonUtils/ConfigurableParamHelper.h"
@@ -80,6 +83,77 @@ struct HBFUtils : public o2::conf::ConfigurableParamHelper<HBFUtils> {
     return std::pair<int, int>(hbf / nHBFPerTF, hbf);
   }
 
+  ///< batch version of getHBF: fill HBF IDs for a span of IRs.
+  ///< Since the reference IR starts at bc=0 the conversion needs no division
+  ///< per record, profitable when digitizers convert IRs for many hits.
+  void getHBFs(gsl::span<const IR> recs, gsl::span<uint32_t> hbfs) const;
+
+  ///< batch version of getTF
+  void getTFs(gsl::span<const IR> recs, gsl::span<uint32_t> tfs) const;
+
+  ///< batch version of getTFandHBinTF
+  void getTFsAndHBinTFs(gsl::span<const IR> recs, gsl::span<std::pair<int, int>> tfhb) const;
+
+  /*//-------------------------------------------------------------------------------------
+    Per-orbit lookup table for IR -> TF coordinates conversion: replaces the
+    division chain of the on-the-fly methods by a single table access per query.
+    Queries outside of the covered orbit range fall back to the direct
+    computation, so clamping of the covered range only costs performance,
+    never correctness. Create via HBFUtils::makeOrbitLUT.
+    //-------------------------------------------------------------------------------------*/
+  class OrbitLUT
+  {
+   public:
+    OrbitLUT() = default;
+
+    ///< get TF ID corresponding to this IR
+    uint32_t getTF(const IR& rec) const
+    {
+      return covered(rec.orbit) ? mEntries[rec.orbit - mOrbitMin].tf : calcHBF(rec.orbit) / mNHBFPerTF;
+    }
+
+    ///< get TF and HB (within TF) for this IR
+    std::pair<int, int> getTFandHBinTF(const IR& rec) const
+    {
+      if (covered(rec.orbit)) {
+        const auto& e = mEntries[rec.orbit - mOrbitMin];
+        return std::pair<int, int>(e.tf, e.hbInTF);
+      }
+      auto hbf = calcHBF(rec.orbit);
+      return std::pair<int, int>(hbf / mNHBFPerTF, hbf % mNHBFPerTF);
+    }
+
+    ///< get 1st IR of the TF corresponding to provided interaction record
+    IR getFirstIRofTF(const IR& rec) const { return IR{0, uint32_t(rec.orbit - getTFandHBinTF(rec).second)}; }
+
+    uint32_t getOrbitMin() const { return mOrbitMin; }
+    size_t getNOrbitsCovered() const { return mEntries.size(); }
+
+   private:
+    friend struct HBFUtils;
+    struct Entry {
+      uint32_t tf = 0;     ///< TF ID
+      uint16_t hbInTF = 0; ///< HB within the TF
+    };
+    bool covered(uint32_t orbit) const { return orbit >= mOrbitMin && orbit - mOrbitMin < mEntries.size(); }
+    uint32_t calcHBF(uint32_t orbit) const
+    {
+      if (orbit < mOrbitFirst) {
+        throw std::runtime_error("Requested IR is ahead of the reference IR");
+      }
+      return orbit - mOrbitFirst;
+    }
+    uint32_t mOrbitMin = 0;       ///< 1st orbit covered by the table
+    uint32_t mOrbitFirst = 0;     ///< orbit of 1st TF of the run
+    int mNHBFPerTF = 128;         ///< number of HBFs per TF
+    std::vector<Entry> mEntries;  ///< per-orbit TF coordinates
+  };
+
+  ///< create per-orbit LUT covering orbits [orbitMin, orbitMax]; the table
+  ///< needs 8 bytes per orbit, too long ranges are clamped and served by the
+  ///< fallback of the LUT
+  OrbitLUT makeOrbitLUT(uint32_t orbitMin, uint32_t orbitMax) const;
+
   ///< calculate TF timestamp in ms
   uint64_t getTFTimeStamp(const IR& rec) const
   {
@@ -25,6 +25,7 @@
 #endif
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
 #include "Headers/DAQID.h"
+#include <vector>
 #endif // GPUCA_GPUCODE / GPUCA_STANDALONE
 
 namespace o2
@@ -680,6 +681,28 @@ struct RDHUtils {
   static bool checkRDH(const RDHAny rdh, bool verbose = true, bool checkZeros = false) { return checkRDH(rdh.voidify(), verbose, checkZeros); }
   static bool checkRDH(const void* rdhP, bool verbose = true, bool checkZeros = false);
 
+  ///_______________________________
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  /// summary of a bulk scan over consecutive CRU pages, see scanPages
+  struct PageScan {
+    enum FaultBits : uint32_t { FaultVersion = 0x1,    // unknown RDH version
+                                FaultHeaderSize = 0x2, // header size is not sizeof(RDHAny)
+                                FaultPageSize = 0x4,   // memory size or offset to next out of range
+                                FaultCounter = 0x8 };  // non-contiguous packet counter on consecutive pages of a link
+    std::vector<size_t> hbfStarts;                     // offsets of the pages opening a new HBF
+    size_t scanned = 0;                                // number of bytes covered by fully contained valid pages
+    uint32_t faultMask = 0;                            // OR of the FaultBits seen
+    int nPages = 0;                                    // number of pages fully contained in the buffer
+    int nFaults = 0;                                   // number of pages with faults
+    bool truncated = false;                            // the last page extends beyond the buffer
+  };
+  /// validate the RDHs of all CRU pages of the buffer (e.g. a superpage) in a single pass and
+  /// index the HBF boundaries; returns true if no fault was seen. The scan stops at the first
+  /// page whose size fields cannot be trusted or which extends beyond the buffer: summary.scanned
+  /// tells how many bytes were covered, so that the caller can refill the buffer and resume.
+  static bool scanPages(const void* start, size_t size, PageScan& summary, bool verbose = false);
+#endif // GPUCA_GPUCODE / GPUCA_STANDALONE
+
   ///_______________________________
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
   static LinkSubSpec_t getSubSpec(uint16_t cru, uint8_t link, uint8_t endpoint, uint16_t feeId, o2::header::DAQID::ID srcid = o2::header::DAQID::INVALID)
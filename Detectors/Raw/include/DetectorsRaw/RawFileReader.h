@@ -52,8 +52,10 @@ struct ReaderInp {
   uint32_t errMap = 0xffffffff;
   uint32_t minTF = 0;
   uint32_t maxTF = 0xffffffff;
+  int prefetchWindow = 0;
   bool partPerSP = true;
   bool cache = false;
+  bool mmapFiles = false;
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
   bool sup0xccdb = false;
@@ -147,7 +149,8 @@ class RawFileReader
     enum { StartTF = 0x1,
            StartHB = 0x1 << 1,
            StartSP = 0x1 << 2,
-           EndHB = 0x1 << 3 };
+           EndHB = 0x1 << 3,
+           Prefetch = 0x1 << 4 }; // asynchronous read of the block was submitted
     size_t offset = 0;                 //! where data of the block starts
     uint32_t size = 0;                 //! block size
     uint32_t tfID = 0;                 //! tf counter (from 0)
@@ -272,6 +275,16 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  ///< memory-map the input files instead of reading them via stdio, must be set before init()
+  void setUseMMap(bool v) { mUseMMap = v; }
+  bool getUseMMap() const { return mUseMMap; }
+
+  ///< set the number of block reads to keep in flight per input file (0: synchronous freads)
+  void setPreFetchWindow(int n) { mPreFetchWindow = n > 0 ? n : 0; }
+  int getPreFetchWindow() const { return mPreFetchWindow; }
+  ///< submit asynchronous reads for the blocks of given TF, respecting the per-file window
+  void preFetchTF(uint32_t tf);
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -290,8 +303,20 @@ class RawFileReader
   static std::string nochk_expl(ErrTypes e);
 
  private:
+  struct PreFetchPool; // bookkeeping of outstanding asynchronous block reads, see RawFileReader.cxx
   int getLinkLocalID(const RDHAny& rdh, int fileID);
   bool preprocessFile(int ifl);
+  void preFetchMore();                  // account finished asynchronous reads, submit new ones up to the window
+  void preFetchComplete(LinkBlock& bl); // wait for completion of the asynchronous read of given block
+  void preFetchClear();                 // cancel outstanding asynchronous reads
+  void mapFiles();                      // create read-only memory mappings of the input files
+  void unmapFiles();
+  void madviseTF(uint32_t tf); // advise the kernel to page in the blocks of given TF
+  ///< pointer on the block data in the file mapping, null if the file is not mapped
+  const char* getMappedBlock(const LinkBlock& bl) const
+  {
+    return (mUseMMap && bl.fileID < mMaps.size() && mMaps[bl.fileID].first) ? mMaps[bl.fileID].first + bl.offset : nullptr;
+  }
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
@@ -320,6 +345,10 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  PreFetchPool* mPreFetch = nullptr;                                //! outstanding asynchronous block reads
+  int mPreFetchWindow = 0;                                          //! number of block reads to keep in flight per file, 0: synchronous freads
+  std::vector<std::pair<char*, size_t>> mMaps;                      //! mmapped views of the input files
+  bool mUseMMap = false;                                            //! read via memory mapping with madvise-driven readahead
   bool mStopProcessing = false;                                     //! stop processing after error
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
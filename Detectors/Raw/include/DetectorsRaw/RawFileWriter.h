@@ -173,6 +173,9 @@ class RawFileWriter
   }
   ~RawFileWriter();
   void useCaching();
+  ///< flush superpages to files from dedicated threads instead of the caller one, must be requested before feeding the data (0: synchronous writing)
+  void setNWriterThreads(int n);
+  int getNWriterThreads() const { return mNWriterThreads; }
   void doLazinessCheck(bool v) { mDoLazinessCheck = v; }
   void writeConfFile(std::string_view origin = "FLP", std::string_view description = "RAWDATA", std::string_view cfgname = "raw.cfg", bool fullPath = true) const;
   void close();
@@ -394,6 +397,9 @@ class RawFileWriter
 
  private:
   void fillFromCache();
+  void enqueueSuperPage(LinkData& lnk, size_t pgSize);
+  void waitWriterThreads();
+  void writerThread();
 
   enum RoMode_t { NotSet,
                   Continuous,
@@ -429,6 +435,12 @@ class RawFileWriter
   std::map<IR, CacheEntry> mCacheMap;
   //<< caching -------------
 
+  //>> parallel flushing ---------
+  struct FlushPool;              // worker threads and per-link output queues, defined in the implementation
+  FlushPool* mFlushPool = nullptr; //! raw owning pointer since the type is opaque here, deleted in waitWriterThreads
+  int mNWriterThreads = 0;         //!
+  //<< parallel flushing ---------
+
   TStopwatch mTimer;
   RoMode_t mROMode = NotSet;
   IR mFirstIRAdded; // 1st IR seen
@@ -33,6 +33,82 @@ uint32_t HBFUtils::getHBF(const IR& rec) const
   return diff / o2::constants::lhc::LHCMaxBunches;
 }
 
+//_________________________________________________
+void HBFUtils::getHBFs(gsl::span<const IR> recs, gsl::span<uint32_t> hbfs) const
+{
+  ///< batch version of getHBF: since the reference IR starts at bc=0 and the
+  ///< bc of the records is below LHCMaxBunches, the HBF ID is just the orbit
+  ///< difference, no division chain per record is needed
+  assert(recs.size() <= hbfs.size());
+  for (size_t i = 0; i < recs.size(); i++) {
+    if (recs[i].orbit < orbitFirst) {
+      LOG(error) << "IR " << recs[i].bc << '/' << recs[i].orbit << " is ahead of the reference IR "
+                 << "0/" << orbitFirst;
+      throw std::runtime_error("Requested IR is ahead of the reference IR");
+    }
+    hbfs[i] = recs[i].orbit - orbitFirst;
+  }
+}
+
+//_________________________________________________
+void HBFUtils::getTFs(gsl::span<const IR> recs, gsl::span<uint32_t> tfs) const
+{
+  ///< batch version of getTF
+  getHBFs(recs, tfs);
+  for (size_t i = 0; i < recs.size(); i++) {
+    tfs[i] /= nHBFPerTF;
+  }
+}
+
+//_________________________________________________
+void HBFUtils::getTFsAndHBinTFs(gsl::span<const IR> recs, gsl::span<std::pair<int, int>> tfhb) const
+{
+  ///< batch version of getTFandHBinTF
+  assert(recs.size() <= tfhb.size());
+  for (size_t i = 0; i < recs.size(); i++) {
+    if (recs[i].orbit < orbitFirst) {
+      LOG(error) << "IR " << recs[i].bc << '/' << recs[i].orbit << " is ahead of the reference IR "
+                 << "0/" << orbitFirst;
+      throw std::runtime_error("Requested IR is ahead of the reference IR");
+    }
+    uint32_t hbf = recs[i].orbit - orbitFirst;
+    tfhb[i] = std::pair<int, int>(hbf / nHBFPerTF, hbf % nHBFPerTF);
+  }
+}
+
+//_________________________________________________
+HBFUtils::OrbitLUT HBFUtils::makeOrbitLUT(uint32_t orbitMin, uint32_t orbitMax) const
+{
+  ///< create the per-orbit LUT covering orbits [orbitMin, orbitMax]
+  constexpr size_t MaxLUTEntries = 0x1 << 22; // 8 bytes per orbit, clamp the table to 32 MB
+  if (orbitMin < orbitFirst) {
+    LOG(error) << "Requested LUT start orbit " << orbitMin << " is ahead of the reference orbit " << orbitFirst;
+    throw std::runtime_error("Requested IR is ahead of the reference IR");
+  }
+  OrbitLUT lut;
+  lut.mOrbitMin = orbitMin;
+  lut.mOrbitFirst = orbitFirst;
+  lut.mNHBFPerTF = nHBFPerTF;
+  size_t n = orbitMax >= orbitMin ? size_t(orbitMax - orbitMin) + 1 : 0;
+  if (n > MaxLUTEntries) {
+    LOGP(warn, "orbit LUT range {}:{} clamped to {} orbits, queries beyond it are served by direct computation", orbitMin, orbitMax, MaxLUTEntries);
+    n = MaxLUTEntries;
+  }
+  lut.mEntries.resize(n);
+  uint32_t hbf = orbitMin - orbitFirst;
+  uint32_t tf = hbf / nHBFPerTF;
+  uint16_t hb = hbf % nHBFPerTF;
+  for (size_t i = 0; i < n; i++) {
+    lut.mEntries[i].tf = tf;
+    lut.mEntries[i].hbInTF = hb;
+    if (++hb == nHBFPerTF) {
+      hb = 0;
+      tf++;
+    }
+  }
+  return lut;
+}
+
 //_________________________________________________
 int HBFUtils::fillHBIRvector(std::vector<IR>& dst, const IR& fromIR, const IR& toIR) const
 {
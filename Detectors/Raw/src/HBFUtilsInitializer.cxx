@@ -187,7 +187,7 @@ void HBFUtilsInitializer::assignDataHeaderFromTFIDInfo(const std::vector<o2::dat
 void HBFUtilsInitializer::assignDataHeaderFromHBFUtils(o2::header::DataHeader& dh, o2::framework::DataProcessingHeader& dph)
 {
   const auto& hbfu = o2::raw::HBFUtils::Instance();
-  auto offset = hbfu.getFirstIRofTF({0, hbfu.orbitFirstSampled}).orbit;
+  static const auto offset = hbfu.getFirstIRofTF({0, hbfu.orbitFirstSampled}).orbit;
   dh.firstTForbit = offset + hbfu.nHBFPerTF * dh.tfCounter;
   dh.runNumber = hbfu.runNumber;
   dph.creation = hbfu.startTime + (dh.firstTForbit - hbfu.orbitFirst) * o2::constants::lhc::LHCOrbitMUS * 1.e-3;
@@ -200,6 +200,27 @@ void HBFUtilsInitializer::assignDataHeaderFromHBFUtilWithIRFrames(o2::header::Da
 {
   const auto& hbfu = o2::raw::HBFUtils::Instance();
   static int64_t offset = hbfu.getFirstIRofTF({0, hbfu.orbitFirstSampled}).orbit;
+  // the IR->TF conversions of the frames go via a LUT covering their orbit span,
+  // frames preceding the run start are left to the fallback which throws like
+  // the direct computation does
+  static const auto orbitLUT = [&hbfu]() {
+    uint32_t mn = 0xffffffff, mx = 0;
+    for (const auto& fr : IRFrames) {
+      if (fr.getMin().orbit < mn) {
+        mn = fr.getMin().orbit;
+      }
+      if (fr.getMax().orbit > mx) {
+        mx = fr.getMax().orbit;
+      }
+    }
+    if (mn > mx) {
+      mn = mx = hbfu.orbitFirstSampled;
+    }
+    if (mn < hbfu.orbitFirst) {
+      mn = hbfu.orbitFirst;
+    }
+    return hbfu.makeOrbitLUT(mn, mx);
+  }();
   dh.runNumber = hbfu.runNumber;
   dh.firstTForbit = offset + hbfu.nHBFPerTF * dh.tfCounter; // fallback settings
   IRFrameSel.getMin().clear();                              // invalidate
@@ -210,8 +231,8 @@ void HBFUtilsInitializer::assignDataHeaderFromHBFUtilWithIRFrames(o2::header::Da
   o2::InteractionRecord ir0Mn, ir0Mx;
   while (++LastIRFrameIndex < NTFs) {
     IRFrameSel = IRFrames[LastIRFrameIndex]; // copy!
-    ir0Mn = hbfu.getFirstIRofTF(IRFrameSel.getMin());
-    ir0Mx = hbfu.getFirstIRofTF(IRFrameSel.getMax());
+    ir0Mn = orbitLUT.getFirstIRofTF(IRFrameSel.getMin());
+    ir0Mx = orbitLUT.getFirstIRofTF(IRFrameSel.getMax());
     if (ir0Mn.orbit < offset) {
       if (ir0Mx.orbit < offset) {
         LOGP(warn, "IRFrame#{} ({}-{}) precedes 1st sampled TF {}, skipping",
@@ -129,6 +129,72 @@ bool RDHUtils::checkRDH(const void* rdhP, bool verbose, bool checkZeros)
   return ok;
 }
 
+//_____________________________________________________________________
+bool RDHUtils::scanPages(const void* start, size_t size, PageScan& summary, bool verbose)
+{
+  // single pass over consecutive CRU pages: validate the RDH fields and index the HBF boundaries.
+  // The per-page work is branch-free for conforming data: faults are accumulated in a mask instead
+  // of being examined field by field, and the header of the following page is prefetched while the
+  // current one is inspected, hiding the cache miss of the ~8 kB stride.
+  summary.hbfStarts.clear();
+  summary.scanned = 0;
+  summary.faultMask = 0;
+  summary.nPages = 0;
+  summary.nFaults = 0;
+  summary.truncated = false;
+  const char* ptr = reinterpret_cast<const char*>(start);
+  size_t offs = 0;
+  int linkPrev = -1;
+  uint8_t packetPrev = 0;
+  while (offs + sizeof(RDHAny) <= size) {
+    const void* rdhP = ptr + offs;
+    int version = getVersion(rdhP);
+    if (version < 3 || version > 7) { // the layout cannot be trusted, stop the scan
+      summary.faultMask |= PageScan::FaultVersion;
+      summary.nFaults++;
+      if (verbose) {
+        LOG(alarm) << "Unexpected RDH version " << version << " at offset " << offs << ", stopping the scan";
+      }
+      break;
+    }
+    uint32_t fault = 0;
+    int hsz = getHeaderSize(rdhP);
+    int msz = getMemorySize(rdhP);
+    int onx = getOffsetToNext(rdhP);
+    int link = getLinkID(rdhP);
+    uint8_t packet = getPacketCounter(rdhP);
+    fault |= (hsz != int(sizeof(RDHAny))) ? uint32_t(PageScan::FaultHeaderSize) : 0;
+    fault |= (onx < int(sizeof(RDHAny)) || msz < int(sizeof(RDHAny))) ? uint32_t(PageScan::FaultPageSize) : 0;
+    fault |= (link == linkPrev && uint8_t(packetPrev + 1) != packet) ? uint32_t(PageScan::FaultCounter) : 0;
+    if (fault) {
+      summary.faultMask |= fault;
+      summary.nFaults++;
+      if (verbose) {
+        checkRDH(rdhP, true); // field by field report
+      }
+      if (fault & PageScan::FaultPageSize) { // the offset to the next page cannot be trusted
+        break;
+      }
+    }
+    if (offs + onx > size) {
+      summary.truncated = true;
+      break;
+    }
+    if (getPageCounter(rdhP) == 0) { // page opening a new HBF
+      summary.hbfStarts.push_back(offs);
+    }
+    summary.nPages++;
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr + offs + onx);
+#endif
+    offs += onx;
+    summary.scanned = offs;
+    linkPrev = link;
+    packetPrev = packet;
+  }
+  return summary.nFaults == 0;
+}
+
 //_____________________________________________________________________
 bool RDHUtils::checkRDH(const RAWDataHeaderV4& rdh, bool verbose, bool checkZeros)
 {
@@ -20,7 +20,10 @@
 #include "CommonConstants/Triggers.h"
 #include "Algorithm/RangeTokenizer.h"
 #include <cstdio>
+#include <deque>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include <filesystem>
 
 namespace o2::raw
@@ -35,8 +38,25 @@ class RawDump : public Task
  public:
   static constexpr o2h::DataDescription DESCRaw{"RAWDATA"}, DESCCRaw{"CRAWDATA"};
 
-  struct LinkInfo {
+  ///< entry of the binary <file>.idx index accompanying each output file
+  struct IndexEntry {
+    uint32_t orbit = 0;    // 1st orbit of the block
+    uint32_t reserved = 0;
+    uint64_t offset = 0;   // offset of the block in the raw file
+  };
+  static_assert(sizeof(IndexEntry) == 16, "IndexEntry is written to file as is");
+
+  struct FileInfo {
     FILE* fileHandler = nullptr;
+    FILE* indexHandler = nullptr;
+    uint64_t offset = 0;                       // size of data written + pending
+    uint32_t lastOrbit = 0xffffffff;           // orbit of the last indexed block
+    std::vector<char> pending;                 // data staged for the next flush
+    std::vector<IndexEntry> pendingIndex;      // index entries staged for the next flush
+  };
+
+  struct LinkInfo {
+    FileInfo* file = nullptr;
     o2::header::RDHAny rdhSOX;
     o2::InteractionRecord firstIR{};
     bool hasSOX{false};
@@ -51,6 +71,9 @@ class RawDump : public Task
 
  private:
   LinkInfo& getLinkInfo(o2h::DataOrigin detOr, const header::RDHAny* rdh);
+  void writeData(FileInfo& fInfo, const void* data, size_t size, uint32_t orbit);
+  void flushFile(FileInfo& fInfo);
+  void flushPending();
   std::string getFileName(DetID detID, const header::RDHAny* rdh);
   std::string getBaseFileNameITS(const header::RDHAny* rdh);
   std::string getBaseFileNameTPC(const header::RDHAny* rdh);
@@ -75,11 +98,13 @@ class RawDump : public Task
   bool mImposeSOX{false};
   int mVerbosity{0};
   int mTFCount{0};
+  int mNWriterThreads{1};
   uint64_t mTPCLinkRej{0}; // pattern of TPC links to reject
   o2::InteractionRecord mFirstIR{};
   std::string mOutDir{};
+  std::deque<FileInfo> mFiles{}; // deque to keep the addresses stable
   std::unordered_map<uint64_t, LinkInfo> mLinksInfo{};
-  std::unordered_map<std::string, FILE*> mName2File{};
+  std::unordered_map<std::string, FileInfo*> mName2File{};
   std::unordered_map<int, DetID> mOrigin2DetID{};
   std::array<std::string, o2::detectors::DetID::getNDetectors()> mConfigEntries{};
   std::array<int, o2::detectors::DetID::getNDetectors()> mFilesPerDet{};
@@ -101,6 +126,10 @@ void RawDump::init(InitContext& ic)
   mOutDir = ic.options().get<std::string>("output-directory");
   mSkipDump = ic.options().get<bool>("skip-dump");
   mImposeSOX = !ic.options().get<bool>("skip-impose-sox");
+  mNWriterThreads = ic.options().get<int>("writer-threads");
+  if (mNWriterThreads < 1) {
+    mNWriterThreads = 1;
+  }
   auto vrej = o2::RangeTokenizer::tokenize<int>(ic.options().get<std::string>("reject-tpc-links"));
   for (auto i : vrej) {
     if (i < 63) {
@@ -186,7 +215,7 @@ void RawDump::run(ProcessingContext& pc)
     // now write RDH with SOX (if needed)
     for (auto& lit : mLinksInfo) {
       auto& lInfo = lit.second;
-      if (!lInfo.hasSOX && lInfo.fileHandler) {
+      if (!lInfo.hasSOX && lInfo.file) {
         auto trig = o2::raw::RDHUtils::getTriggerType(lInfo.rdhSOX);
         if (o2::raw::RDHUtils::getTriggerIR(lInfo.rdhSOX) != mFirstIR) { // need to write cooked header
           o2::raw::RDHUtils::setTriggerOrbit(lInfo.rdhSOX, mFirstIR.orbit);
@@ -200,13 +229,10 @@ void RawDump::run(ProcessingContext& pc)
             LOGP(info, "Writing cooked up RDH with SOX");
             o2::raw::RDHUtils::printRDH(lInfo.rdhSOX);
           }
-          auto ws = std::fwrite(&lInfo.rdhSOX, 1, sizeof(o2::header::RDHAny), lInfo.fileHandler);
-          if (ws != sizeof(o2::header::RDHAny)) {
-            LOGP(fatal, "Failed to write cooked up RDH with SOX");
-          }
+          writeData(*lInfo.file, &lInfo.rdhSOX, sizeof(o2::header::RDHAny), mFirstIR.orbit);
           lInfo.hasSOX = true; // flag that it is already written
         }                      // otherwhise data has RDH with orbit matching to SOX, we will simply set a flag while writing the data
-      } else if (lInfo.fileHandler && o2::raw::RDHUtils::getTriggerOrbit(lInfo.rdhSOX) != mFirstIR.orbit) {
+      } else if (lInfo.file && o2::raw::RDHUtils::getTriggerOrbit(lInfo.rdhSOX) != mFirstIR.orbit) {
         o2::raw::RDHUtils::printRDH(lInfo.rdhSOX);
         LOGP(error, "Original data had SOX set but the orbit differs from the smallest seen {}, keep original one", mFirstIR.orbit);
       }
@@ -226,11 +252,11 @@ void RawDump::run(ProcessingContext& pc)
     if (mVerbosity > 1) {
       o2::raw::RDHUtils::printRDH(rdh);
     }
-    FILE* fh = nullptr;
     auto& lInfo = getLinkInfo(dh->dataOrigin, rdh);
-    if (!mSkipDump && lInfo.fileHandler) {
+    if (!mSkipDump && lInfo.file) {
       auto sz = o2::raw::RDHUtils::getOffsetToNext(rdh);
       auto raw = it.raw();
+      auto orbit = o2::raw::RDHUtils::getTriggerOrbit(rdh);
       if (mTFCount == 0 && !lInfo.hasSOX && o2::raw::RDHUtils::getTriggerIR(rdh) == mFirstIR) { // need to add SOX bit to existing RDH
         auto trig = o2::raw::RDHUtils::getTriggerType(rdh);
         trig |= isRORC(lInfo.detID) ? o2::trigger::SOT : (o2::trigger::SOC | o2::trigger::ORBIT | o2::trigger::HB | o2::trigger::TF);
@@ -240,31 +266,91 @@ void RawDump::run(ProcessingContext& pc)
           LOGP(info, "Write existing RDH with SOX added");
           o2::raw::RDHUtils::printRDH(rdhC);
         }
-        auto ws = std::fwrite(&rdhC, 1, sizeof(o2::header::RDHAny), lInfo.fileHandler);
-        if (ws != sizeof(o2::header::RDHAny)) {
-          LOGP(fatal, "Failed to write RDH with SOX added");
-        }
+        writeData(*lInfo.file, &rdhC, sizeof(o2::header::RDHAny), orbit);
         raw += sizeof(o2::header::RDHAny);
         sz -= sizeof(o2::header::RDHAny);
         if (o2::raw::RDHUtils::getStop(rdhC)) {
           lInfo.hasSOX = true;
         }
       }
-      auto ws = std::fwrite(raw, 1, sz, lInfo.fileHandler);
-      if (ws != sz) {
-        LOGP(fatal, "Failed to write payload of {} bytes", sz);
-      }
+      writeData(*lInfo.file, raw, sz, orbit);
     }
   }
+  flushPending();
   mTFCount++;
 }
 
+//____________________________________________________________
+void RawDump::writeData(FileInfo& fInfo, const void* data, size_t size, uint32_t orbit)
+{
+  // stage the data for the next flush, starting a new index block if the orbit changed
+  if (orbit != fInfo.lastOrbit) {
+    fInfo.pendingIndex.emplace_back(IndexEntry{orbit, 0, fInfo.offset});
+    fInfo.lastOrbit = orbit;
+  }
+  auto p = reinterpret_cast<const char*>(data);
+  fInfo.pending.insert(fInfo.pending.end(), p, p + size);
+  fInfo.offset += size;
+}
+
+//____________________________________________________________
+void RawDump::flushFile(FileInfo& fInfo)
+{
+  if (!fInfo.pending.empty()) {
+    auto ws = std::fwrite(fInfo.pending.data(), 1, fInfo.pending.size(), fInfo.fileHandler);
+    if (ws != fInfo.pending.size()) {
+      LOGP(fatal, "Failed to write payload of {} bytes", fInfo.pending.size());
+    }
+    fInfo.pending.clear();
+  }
+  if (!fInfo.pendingIndex.empty()) {
+    auto ws = std::fwrite(fInfo.pendingIndex.data(), sizeof(IndexEntry), fInfo.pendingIndex.size(), fInfo.indexHandler);
+    if (ws != fInfo.pendingIndex.size()) {
+      LOGP(fatal, "Failed to write {} index entries", fInfo.pendingIndex.size());
+    }
+    fInfo.pendingIndex.clear();
+  }
+}
+
+//____________________________________________________________
+void RawDump::flushPending()
+{
+  // flush the data staged for all files, with files distributed over the writer threads
+  std::vector<FileInfo*> dirty;
+  for (auto& fInfo : mFiles) {
+    if (!fInfo.pending.empty() || !fInfo.pendingIndex.empty()) {
+      dirty.push_back(&fInfo);
+    }
+  }
+  int nThreads = mNWriterThreads < int(dirty.size()) ? mNWriterThreads : int(dirty.size());
+  if (nThreads < 2) {
+    for (auto* fInfo : dirty) {
+      flushFile(*fInfo);
+    }
+    return;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(nThreads);
+  for (int it = 0; it < nThreads; it++) {
+    workers.emplace_back([this, &dirty, it, nThreads]() {
+      for (size_t i = it; i < dirty.size(); i += nThreads) {
+        flushFile(*dirty[i]);
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
 //____________________________________________________________
 void RawDump::endOfStream(EndOfStreamContext& ec)
 {
+  flushPending();
   LOGP(info, "closing {} output files", mName2File.size());
-  for (auto h : mName2File) {
-    std::fclose(h.second);
+  for (auto& h : mName2File) {
+    std::fclose(h.second->fileHandler);
+    std::fclose(h.second->indexHandler);
   }
   for (DetID::ID id = DetID::First; id <= DetID::Last; id++) {
     if (mConfigEntries[id].empty()) {
@@ -290,19 +376,26 @@ RawDump::LinkInfo& RawDump::getLinkInfo(o2h::DataOrigin detOr, const header::RDH
   uint32_t feeid = RDHUtils::getFEEID(rdh);
   uint64_t id = (uint64_t(detOr) << 32) + feeid;
   auto& linkInfo = mLinksInfo[id];
-  if (!linkInfo.fileHandler) {
+  if (!linkInfo.file) {
     DetID detID = mOrigin2DetID[detOr];
     auto name = getFileName(detID, rdh);
     if (name.empty()) {
       return linkInfo; // reject data of this RDH
     }
-    linkInfo.fileHandler = mName2File[name];
-    if (!linkInfo.fileHandler) {
-      linkInfo.fileHandler = std::fopen(name.c_str(), "w");
-      if (!linkInfo.fileHandler) {
+    linkInfo.file = mName2File[name];
+    if (!linkInfo.file) {
+      auto& fInfo = mFiles.emplace_back();
+      fInfo.fileHandler = std::fopen(name.c_str(), "w");
+      if (!fInfo.fileHandler) {
         LOGP(fatal, "Failed to create file {} for Det={} / FeeID=0x{:05x}", name, detOr.str, feeid);
       }
-      mName2File[name] = linkInfo.fileHandler;
+      auto idxName = name + ".idx";
+      fInfo.indexHandler = std::fopen(idxName.c_str(), "w");
+      if (!fInfo.indexHandler) {
+        LOGP(fatal, "Failed to create index file {} for Det={} / FeeID=0x{:05x}", idxName, detOr.str, feeid);
+      }
+      linkInfo.file = &fInfo;
+      mName2File[name] = linkInfo.file;
       mConfigEntries[detID] += fmt::format(
         "[input-{}-{}]\n"
         "dataOrigin = {}\n"
@@ -687,6 +780,7 @@ DataProcessorSpec getRawDumpSpec(DetID::mask_t detMask, bool TOFUncompressed)
      ConfigParamSpec{"dump-verbosity", VariantType::Int, 0, {"0:minimal, 1:report Det/FeeID->filename, 2: print RDH"}},
      ConfigParamSpec{"reject-tpc-links", VariantType::String, "", {"comma-separated list TPC links to reject"}},
      ConfigParamSpec{"skip-impose-sox", VariantType::Bool, false, {"do not impose SOX for 1st TF"}},
+     ConfigParamSpec{"writer-threads", VariantType::Int, 4, {"number of threads flushing the output files in parallel"}},
      ConfigParamSpec{"output-directory", VariantType::String, "./", {"Output directory (create if needed)"}}}};
 }
 
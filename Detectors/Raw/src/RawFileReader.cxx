@@ -30,10 +30,32 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <aio.h>
+#include <list>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
 
+//====================== asynchronous block prefetcher ========================
+// POSIX AIO based read-ahead: a window of outstanding per-block reads is kept for every
+// input file, so that the TF assembly loop finds the data already in memory instead of
+// being bound by the seek latency of the synchronous fread per link chunk
+struct RawFileReader::PreFetchPool {
+  struct Req {
+    aiocb cb{};
+    LinkBlock* block = nullptr;
+    std::unique_ptr<char[]> buff;
+  };
+  std::list<Req> inFlight;   // outstanding requests, stable addresses needed by the aiocb
+  std::vector<int> nPerFile; // number of outstanding requests per file
+  uint32_t tf = 0xffffffff;  // TF the cursor is submitting for
+  uint32_t tfIDCurLink = 0;  // local tfID of the TF start block of the current link
+  int nextLink = 0;          // cursor: entry in the ordered links
+  int nextBlock = -1;        // cursor: block entry in the link, negative: position at the TF start
+};
+
 //====================== methods of LinkBlock ========================
 //____________________________________________
 void RawFileReader::LinkBlock::print(const std::string& pref) const
@@ -131,17 +153,27 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
       break;
     }
     ibl++;
-    if (blc.dataCache) {
-      memcpy(buff + sz, blc.dataCache.get(), blc.size);
+    if (const char* mp = reader->getMappedBlock(blc)) { // the file is mmapped, copy directly from the mapping
+      memcpy(buff + sz, mp, blc.size);
     } else {
-      auto fl = reader->mFiles[blc.fileID];
-      if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
-        LOGF(error, "Failed to read for the %s a bloc:", describe());
-        blc.print();
-        error = true;
-      } else if (reader->mCacheData) { // need to fill the cache at 1st reading
-        blc.dataCache = std::make_unique<char[]>(blc.size);
-        memcpy(blc.dataCache.get(), buff + sz, blc.size); // will be used at next reading
+      if (blc.testFlag(LinkBlock::Prefetch)) {
+        reader->preFetchComplete(blc); // wait for the asynchronous read of this block
+      }
+      if (blc.dataCache) {
+        memcpy(buff + sz, blc.dataCache.get(), blc.size);
+        if (!reader->mCacheData) { // the buffer was filled by the prefetcher, release it
+          blc.dataCache.reset();
+        }
+      } else {
+        auto fl = reader->mFiles[blc.fileID];
+        if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
+          LOGF(error, "Failed to read for the %s a bloc:", describe());
+          blc.print();
+          error = true;
+        } else if (reader->mCacheData) { // need to fill the cache at 1st reading
+          blc.dataCache = std::make_unique<char[]>(blc.size);
+          memcpy(blc.dataCache.get(), buff + sz, blc.size); // will be used at next reading
+        }
       }
     }
     sz += blc.size;
@@ -285,8 +317,30 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
     }
   }
   if (sz) {
-    if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
+    if (const char* mp = reader->getMappedBlock(blocks[nextBlock2Read])) { // mmapped file: the blocks of the superpage are contiguous
+      memcpy(buff, mp, sz);
+    } else if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
+    } else if (reader->mPreFetch && !reader->mCacheData) { // the blocks may have been prefetched individually
+      size_t soff = 0;
+      for (int i = nextBlock2Read; i < ibl; i++) {
+        auto& blc = blocks[i];
+        if (blc.testFlag(LinkBlock::Prefetch)) {
+          reader->preFetchComplete(blc);
+        }
+        if (blc.dataCache) {
+          memcpy(buff + soff, blc.dataCache.get(), blc.size);
+          blc.dataCache.reset(); // the buffer was filled by the prefetcher, release it
+        } else {
+          auto fl = reader->mFiles[blc.fileID];
+          if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + soff, 1, blc.size, fl) != blc.size) {
+            LOGF(error, "Failed to read for the %s a bloc:", describe());
+            blc.print();
+            error = true;
+          }
+        }
+        soff += blc.size;
+      }
     } else {
       auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
       if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
@@ -659,6 +713,8 @@ void RawFileReader::printStat(bool verbose) const
 //_____________________________________________________________________
 void RawFileReader::clear()
 {
+  preFetchClear();
+  unmapFiles();
   mLinkEntries.clear();
   mOrderedIDs.clear();
   mLinksData.clear();
@@ -673,6 +729,187 @@ void RawFileReader::clear()
   mInitDone = false;
 }
 
+//_____________________________________________________________________
+void RawFileReader::preFetchTF(uint32_t tf)
+{
+  // position the prefetch cursor on given TF and submit asynchronous reads for its blocks
+  if (mUseMMap) { // in the mmap mode the readahead is steered via madvise
+    madviseTF(tf);
+    return;
+  }
+  if (!mPreFetchWindow) {
+    return;
+  }
+  if (!mPreFetch) {
+    mPreFetch = new PreFetchPool;
+    mPreFetch->nPerFile.resize(mFiles.size(), 0);
+  }
+  if (mPreFetch->tf != tf) {
+    mPreFetch->tf = tf;
+    mPreFetch->nextLink = 0;
+    mPreFetch->nextBlock = -1;
+  }
+  preFetchMore();
+}
+
+//_____________________________________________________________________
+void RawFileReader::preFetchMore()
+{
+  // account finished asynchronous reads and submit new ones as long as the per-file window allows
+  auto& pool = *mPreFetch;
+  for (auto it = pool.inFlight.begin(); it != pool.inFlight.end();) {
+    if (aio_error(&it->cb) == EINPROGRESS) {
+      ++it;
+      continue;
+    }
+    if (aio_return(&it->cb) == ssize_t(it->block->size)) {
+      it->block->dataCache = std::move(it->buff); // released by the consumer unless persistent caching is on
+    } else { // failed read: clear the flag so that the consumer falls back to the synchronous fread
+      LOGF(error, "Prefetch of %u bytes at offset %zu of file %d failed, block will be re-read synchronously", it->block->size, it->block->offset, int(it->block->fileID));
+      it->block->setFlag(LinkBlock::Prefetch, false);
+    }
+    pool.nPerFile[it->block->fileID]--;
+    it = pool.inFlight.erase(it);
+  }
+  int nLinks = mOrderedIDs.size();
+  while (pool.nextLink < nLinks) {
+    auto& link = getLink(pool.nextLink);
+    if (pool.nextBlock < 0) { // position on the start of the TF to prefetch
+      if (pool.tf < link.tfStartBlock.size()) {
+        pool.nextBlock = link.tfStartBlock[pool.tf].first;
+        pool.tfIDCurLink = link.blocks[pool.nextBlock].tfID;
+      } else {
+        pool.nextBlock = link.blocks.size(); // no data for this TF
+      }
+    }
+    if (pool.nextBlock >= int(link.blocks.size()) || link.blocks[pool.nextBlock].tfID != pool.tfIDCurLink) { // this link is done
+      pool.nextLink++;
+      pool.nextBlock = -1;
+      continue;
+    }
+    auto& bl = link.blocks[pool.nextBlock];
+    if (bl.dataCache || bl.testFlag(LinkBlock::Prefetch)) { // already in memory or submitted
+      pool.nextBlock++;
+      continue;
+    }
+    if (pool.nPerFile[bl.fileID] >= mPreFetchWindow) { // stall on saturated file to keep the submission in consumption order
+      break;
+    }
+    auto& req = pool.inFlight.emplace_back();
+    req.block = &bl;
+    req.buff = std::make_unique<char[]>(bl.size);
+    req.cb.aio_fildes = fileno(mFiles[bl.fileID]);
+    req.cb.aio_buf = req.buff.get();
+    req.cb.aio_nbytes = bl.size;
+    req.cb.aio_offset = bl.offset;
+    if (aio_read(&req.cb)) { // submission failed (e.g. kernel queue exhausted), retry at the next call
+      pool.inFlight.pop_back();
+      break;
+    }
+    bl.setFlag(LinkBlock::Prefetch);
+    pool.nPerFile[bl.fileID]++;
+    pool.nextBlock++;
+  }
+}
+
+//_____________________________________________________________________
+void RawFileReader::preFetchComplete(LinkBlock& bl)
+{
+  // wait for the completion of the asynchronous read of given block
+  if (!mPreFetch) {
+    bl.setFlag(LinkBlock::Prefetch, false);
+    return;
+  }
+  for (auto& req : mPreFetch->inFlight) {
+    if (req.block == &bl) {
+      const aiocb* cbs[1] = {&req.cb};
+      while (aio_error(&req.cb) == EINPROGRESS) {
+        aio_suspend(cbs, 1, nullptr);
+      }
+      break;
+    }
+  }
+  preFetchMore(); // account finished requests (including this one) and refill the window
+}
+
+//_____________________________________________________________________
+void RawFileReader::preFetchClear()
+{
+  // cancel outstanding asynchronous reads and drop the bookkeeping
+  if (!mPreFetch) {
+    return;
+  }
+  for (auto& req : mPreFetch->inFlight) {
+    const aiocb* cbs[1] = {&req.cb};
+    if (aio_cancel(req.cb.aio_fildes, &req.cb) == AIO_NOTCANCELED) {
+      while (aio_error(&req.cb) == EINPROGRESS) {
+        aio_suspend(cbs, 1, nullptr);
+      }
+    }
+    aio_return(&req.cb);
+    req.block->setFlag(LinkBlock::Prefetch, false);
+  }
+  delete mPreFetch;
+  mPreFetch = nullptr;
+}
+
+//_____________________________________________________________________
+void RawFileReader::mapFiles()
+{
+  // create read-only memory mappings of the input files
+  mMaps.resize(mFiles.size(), {nullptr, 0});
+  for (size_t i = 0; i < mFiles.size(); i++) {
+    fseek(mFiles[i], 0L, SEEK_END);
+    size_t fsz = ftell(mFiles[i]);
+    rewind(mFiles[i]);
+    if (!fsz) {
+      continue;
+    }
+    auto* mp = mmap(nullptr, fsz, PROT_READ, MAP_SHARED, fileno(mFiles[i]), 0);
+    if (mp == MAP_FAILED) {
+      LOG(warning) << "Failed to mmap file " << mFileNames[i] << ", falling back to stdio reading";
+      continue;
+    }
+    posix_madvise(mp, fsz, POSIX_MADV_SEQUENTIAL); // consumption is mostly sequential per file
+    mMaps[i] = {reinterpret_cast<char*>(mp), fsz};
+  }
+}
+
+//_____________________________________________________________________
+void RawFileReader::unmapFiles()
+{
+  for (auto& mp : mMaps) {
+    if (mp.first) {
+      munmap(mp.first, mp.second);
+    }
+  }
+  mMaps.clear();
+}
+
+//_____________________________________________________________________
+void RawFileReader::madviseTF(uint32_t tf)
+{
+  // advise the kernel to page in the blocks of given TF ahead of their reading
+  static const size_t pgMask = ~(size_t(sysconf(_SC_PAGESIZE)) - 1);
+  int nLinks = mOrderedIDs.size();
+  for (int il = 0; il < nLinks; il++) {
+    auto& link = getLink(il);
+    if (tf >= link.tfStartBlock.size()) {
+      continue;
+    }
+    int ibl = link.tfStartBlock[tf].first, nbl = link.blocks.size();
+    auto tfID = link.blocks[ibl].tfID;
+    while (ibl < nbl && link.blocks[ibl].tfID == tfID) {
+      const auto& bl = link.blocks[ibl++];
+      if (bl.fileID >= mMaps.size() || !mMaps[bl.fileID].first) {
+        continue;
+      }
+      auto start = bl.offset & pgMask; // madvise needs page-aligned address
+      posix_madvise(mMaps[bl.fileID].first + start, bl.offset + bl.size - start, POSIX_MADV_WILLNEED);
+    }
+  }
+}
+
 //_____________________________________________________________________
 bool RawFileReader::addFile(const std::string& sname, o2::header::DataOrigin origin, o2::header::DataDescription desc, ReadoutCardType t)
 {
@@ -721,6 +958,9 @@ bool RawFileReader::init()
   if (mMaxTFToRead < 0xffffffff) {
     LOGF(info, "at most %u TF will be processed", mMaxTFToRead);
   }
+  if (mUseMMap) {
+    mapFiles();
+  }
 
   int nf = mFiles.size();
   mEmpty = true;
@@ -102,6 +102,8 @@ RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
   mReader->setMaxTFToRead(rinp.maxTF);
   mReader->setNominalSPageSize(rinp.spSize);
   mReader->setCacheData(rinp.cache);
+  mReader->setPreFetchWindow(rinp.prefetchWindow);
+  mReader->setUseMMap(rinp.mmapFiles);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
   LOG(info) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
@@ -220,6 +222,7 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     tfID = mMinTFID;
   }
   mReader->setNextTFToRead(tfID);
+  mReader->preFetchTF(tfID); // if enabled, submit asynchronous reads overlapping with the TF assembly
   std::vector<RawFileReader::PartStat> partsSP;
 
   static o2f::RateLimiter limiter;
@@ -337,6 +340,9 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
   mSentSize += tfSize;
   mSentMessages += tfNParts;
   mReader->setNextTFToRead(++tfID);
+  if (tfID <= mMaxTFID) {
+    mReader->preFetchTF(tfID); // start filling the window of the next TF while this one is in flight
+  }
   ++mTFCounter;
   if (tfID > mMaxTFID || mReader->isProcessingStopped()) {
     if (!mReader->isProcessingStopped() && !mReader->isEmpty() && --mLoop) {
@@ -18,6 +18,9 @@
 #include <sstream>
 #include <functional>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 #include "CommonUtils/NameConf.h"
 #include "DetectorsRaw/RawFileWriter.h"
 #include "DetectorsRaw/HBFUtils.h"
@@ -28,6 +31,23 @@
 using namespace o2::raw;
 using IR = o2::InteractionRecord;
 
+///=====================================================================================
+/// worker threads flushing the superpages enqueued by the links, in per-link FIFO order
+struct RawFileWriter::FlushPool {
+  struct LinkQueue {
+    std::deque<std::pair<std::vector<char>, OutputFile*>> jobs; // pages to write, in submission order
+    std::vector<std::vector<char>> spare;                       // preallocated page buffers recycled between the flushes
+    bool busy = false;                                          // a worker is writing the head of the queue
+  };
+  std::unordered_map<LinkSubSpec_t, LinkQueue> queues;
+  std::vector<std::thread> threads;
+  std::mutex mtx;
+  std::condition_variable cv;     // wakes up workers on new jobs or stop request
+  std::condition_variable cvDone; // wakes up the waiter on completed jobs
+  size_t nPending = 0;            // number of enqueued but not yet written pages
+  bool stop = false;
+};
+
 //_____________________________________________________________________
 RawFileWriter::~RawFileWriter()
 {
@@ -39,6 +59,7 @@ void RawFileWriter::close()
 {
   // finalize all links
   if (mFName2File.empty()) {
+    waitWriterThreads(); // threads might have been started before any link was registered
     return;
   }
   if (mCachingStage) {
@@ -61,6 +82,7 @@ void RawFileWriter::close()
       lnk.second.print();
     }
   }
+  waitWriterThreads(); // if parallel flushing was used, make sure all enqueued pages reached the files
   //
   // close all files
   for (auto& flh : mFName2File) {
@@ -171,6 +193,12 @@ RawFileWriter::LinkData& RawFileWriter::registerLink(uint16_t fee, uint16_t cru,
   linkData.writer = this;
   linkData.updateIR = mHBFUtils.obligatorySOR ? mHBFUtils.getFirstIR() : mHBFUtils.getFirstSampledTFIR();
   linkData.buffer.reserve(mSuperPageSize);
+  if (mFlushPool) { // preallocate the output queue of the link with a buffer of nominal superpage size
+    std::lock_guard<std::mutex> lock(mFlushPool->mtx);
+    auto& queue = mFlushPool->queues[sspec];
+    queue.spare.emplace_back();
+    queue.spare.back().reserve(mSuperPageSize);
+  }
   RDHUtils::printRDH(linkData.rdhCopy);
   LOGF(info, "Registered %s with output to %s", linkData.describe(), outFileName);
   return linkData;
@@ -280,6 +308,114 @@ void RawFileWriter::useCaching()
   LOG(info) << "Switched caching ON";
 }
 
+//___________________________________________________________________________________
+void RawFileWriter::setNWriterThreads(int n)
+{
+  // impose flushing of the superpages from dedicated threads, used when the output is writer-bound
+  if (!mFirstIRAdded.isDummy()) {
+    throw std::runtime_error("writer threads must be requested before feeding the data");
+  }
+  mNWriterThreads = n > 0 ? n : 0;
+  if (!mNWriterThreads) {
+    waitWriterThreads(); // switch back to synchronous writing
+    return;
+  }
+  if (!mFlushPool) {
+    mFlushPool = new FlushPool();
+    for (int i = 0; i < mNWriterThreads; i++) {
+      mFlushPool->threads.emplace_back(&RawFileWriter::writerThread, this);
+    }
+    LOG(info) << "Started " << mNWriterThreads << " superpage writer threads";
+  }
+}
+
+//___________________________________________________________________________________
+void RawFileWriter::enqueueSuperPage(LinkData& lnk, size_t pgSize)
+{
+  // copy the flushed part of the link buffer to a recycled page and queue it for the writer threads
+  auto& pool = *mFlushPool;
+  auto* outFile = &mFName2File.find(lnk.fileName)->second;
+  std::vector<char> page;
+  {
+    std::lock_guard<std::mutex> lock(pool.mtx);
+    auto& queue = pool.queues[lnk.subspec];
+    if (!queue.spare.empty()) {
+      page = std::move(queue.spare.back());
+      queue.spare.pop_back();
+    }
+  }
+  page.resize(pgSize); // no allocation if a spare buffer of nominal superpage capacity was recycled
+  memcpy(page.data(), lnk.buffer.data(), pgSize);
+  {
+    std::lock_guard<std::mutex> lock(pool.mtx);
+    auto& queue = pool.queues[lnk.subspec];
+    queue.jobs.emplace_back(std::move(page), outFile);
+    pool.nPending++;
+  }
+  pool.cv.notify_one();
+}
+
+//___________________________________________________________________________________
+void RawFileWriter::writerThread()
+{
+  // serve the per-link queues: at most one worker per link to preserve the pages order, different
+  // links are flushed concurrently, the output file mutex arbitrates those sharing a file
+  auto& pool = *mFlushPool;
+  std::unique_lock<std::mutex> lock(pool.mtx);
+  while (true) {
+    FlushPool::LinkQueue* queue = nullptr;
+    for (auto& entry : pool.queues) {
+      if (!entry.second.busy && !entry.second.jobs.empty()) {
+        queue = &entry.second;
+        break;
+      }
+    }
+    if (!queue) {
+      if (pool.stop) {
+        break;
+      }
+      pool.cv.wait(lock);
+      continue;
+    }
+    auto job = std::move(queue->jobs.front());
+    queue->jobs.pop_front();
+    queue->busy = true;
+    lock.unlock();
+    job.second->write(job.first.data(), job.first.size());
+    lock.lock();
+    queue->busy = false;
+    if (queue->spare.size() < 2) { // return the buffer to the link pool
+      queue->spare.push_back(std::move(job.first));
+    }
+    pool.nPending--;
+    if (!queue->jobs.empty()) { // the queue we blocked may be served by another worker
+      pool.cv.notify_one();
+    }
+    pool.cvDone.notify_all();
+  }
+}
+
+//___________________________________________________________________________________
+void RawFileWriter::waitWriterThreads()
+{
+  // drain the queues, stop and detach the writer threads
+  if (!mFlushPool) {
+    return;
+  }
+  auto& pool = *mFlushPool;
+  {
+    std::unique_lock<std::mutex> lock(pool.mtx);
+    pool.cvDone.wait(lock, [&pool]() { return pool.nPending == 0; });
+    pool.stop = true;
+  }
+  pool.cv.notify_all();
+  for (auto& t : pool.threads) {
+    t.join();
+  }
+  delete mFlushPool;
+  mFlushPool = nullptr;
+}
+
 //===================================================================================
 
 //___________________________________________________________________________________
@@ -602,7 +738,11 @@ void RawFileWriter::LinkData::flushSuperPage(bool keepLastPage)
   if (writer->mVerbosity) {
     LOGF(info, "Flushing super page of %u bytes for %s", pgSize, describe());
   }
-  writer->mFName2File.find(fileName)->second.write(buffer.data(), pgSize);
+  if (writer->mFlushPool) { // hand the page over to the writer threads
+    writer->enqueueSuperPage(*this, pgSize);
+  } else {
+    writer->mFName2File.find(fileName)->second.write(buffer.data(), pgSize);
+  }
   auto toMove = buffer.size() - pgSize;
   if (toMove) { // is there something left in the buffer, move it to the beginning of the buffer
     if (toMove > pgSize) {
@@ -18,14 +18,62 @@
 #include "Framework/Logger.h"
 #include <TStopwatch.h>
 #include <boost/program_options.hpp>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 namespace bpo = boost::program_options;
 
 using namespace o2::raw;
 
+// CRC32C (Castagnoli) over a buffer, using the dedicated instruction where
+// the target has one and a bitwise fallback otherwise. The polynomial is
+// the one iSCSI and ext4 use, so the checksums can be cross-checked with
+// standard tools on a copy of the file.
+static uint32_t crc32c(uint32_t crc, const char* data, size_t n)
+{
+  crc = ~crc;
+#if defined(__SSE4_2__)
+  while (n >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+    crc = (uint32_t)_mm_crc32_u64(crc, word);
+    data += 8;
+    n -= 8;
+  }
+  while (n--) {
+    crc = _mm_crc32_u8(crc, (uint8_t)*data++);
+  }
+#elif defined(__ARM_FEATURE_CRC32)
+  while (n >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+    crc = __crc32cd(crc, word);
+    data += 8;
+    n -= 8;
+  }
+  while (n--) {
+    crc = __crc32cb(crc, (uint8_t)*data++);
+  }
+#else
+  while (n--) {
+    crc ^= (uint8_t)*data++;
+    for (int k = 0; k < 8; k++) {
+      crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+    }
+  }
+#endif
+  return ~crc;
+}
+
 int main(int argc, char* argv[])
 {
   RawFileReader reader;
@@ -43,6 +91,9 @@ int main(int argc, char* argv[])
   desc_add_option("detect-tf0", "autodetect HBFUtils start Orbit/BC from 1st TF seen");
   desc_add_option("calculate-tf-start", "calculate TF start instead of using TType");
   desc_add_option("rorc", "impose RORC as default detector mode");
+  desc_add_option("quick-scan", "bulk RDH validation scan of the files, no per-link bookkeeping");
+  desc_add_option("threads,t", bpo::value<int>()->default_value(std::max(1u, std::thread::hardware_concurrency())), "number of files scanned in parallel in quick-scan mode");
+  desc_add_option("payload-crc", "compute the CRC32C of the scanned data of each file in quick-scan mode");
   desc_add_option("configKeyValues", bpo::value(&configKeyValues)->default_value(""), "semicolon separated key=value strings");
   for (int i = 0; i < RawFileReader::NErrorsDefined; i++) {
     auto ei = RawFileReader::ErrTypes(i);
@@ -108,6 +159,94 @@ int main(int argc, char* argv[])
     LOG(info) << ((errmap & (0x1 << i)) ? "apply " : "ignore") << " check for " << RawFileReader::ErrNames[i].data();
   }
 
+  if (vm.count("quick-scan")) { // bulk RDH validation pass over the files
+    if (!config.empty()) {
+      for (const auto& entry : RawFileReader::parseInput(config)) {
+        for (const auto& fnm : entry.second) {
+          fnames.push_back(fnm);
+        }
+      }
+    }
+    size_t buffSize = vm["buffer-size"].as<size_t>();
+    if (buffSize < size_t(0x1 << 20)) {
+      buffSize = 0x1 << 20;
+    }
+    bool doCRC = vm.count("payload-crc");
+    int nThreads = std::max(1, std::min<int>(vm["threads"].as<int>(), fnames.size()));
+    struct FileScan {
+      size_t bytes = 0, pages = 0, hbfs = 0, faults = 0;
+      uint32_t crc = 0;
+      bool openFailed = false;
+    };
+    std::vector<FileScan> results(fnames.size());
+    std::atomic<size_t> nextFile{0};
+    int verbosity = reader.getVerbosity();
+    // Each worker picks the next file to scan, with its own buffer, so the
+    // scan saturates as many cores (and NVMe queues) as requested.
+    auto scanFiles = [&]() {
+      std::vector<char> buffer(buffSize);
+      o2::raw::RDHUtils::PageScan summary;
+      for (auto fi = nextFile++; fi < fnames.size(); fi = nextFile++) {
+        auto& res = results[fi];
+        auto fl = fopen(fnames[fi].c_str(), "rb");
+        if (!fl) {
+          res.openFailed = true;
+          continue;
+        }
+        size_t pos = 0, nr = 0;
+        while ((nr = fread(buffer.data(), 1, buffer.size(), fl))) {
+          o2::raw::RDHUtils::scanPages(buffer.data(), nr, summary, verbosity > 0);
+          res.pages += summary.nPages;
+          res.hbfs += summary.hbfStarts.size();
+          res.faults += summary.nFaults;
+          if (doCRC) {
+            res.crc = crc32c(res.crc, buffer.data(), summary.scanned);
+          }
+          if (!summary.scanned) { // no progress possible: corrupted data or tail smaller than one page
+            break;
+          }
+          pos += summary.scanned;
+          if (fseek(fl, pos, SEEK_SET)) {
+            break;
+          }
+        }
+        fclose(fl);
+        res.bytes = pos;
+      }
+    };
+    TStopwatch swq;
+    swq.Start();
+    std::vector<std::thread> workers;
+    for (int ti = 0; ti < nThreads; ti++) {
+      workers.emplace_back(scanFiles);
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+    swq.Stop();
+    int nbad = 0;
+    size_t totalBytes = 0;
+    for (size_t fi = 0; fi < fnames.size(); fi++) {
+      const auto& res = results[fi];
+      if (res.openFailed) {
+        LOG(error) << "Failed to open file " << fnames[fi];
+        nbad++;
+        continue;
+      }
+      if (doCRC) {
+        LOGF(info, "File %s: scanned %zu bytes, %zu pages, %zu HBFs, %zu faulty pages, CRC32C %08x", fnames[fi].c_str(), res.bytes, res.pages, res.hbfs, res.faults, res.crc);
+      } else {
+        LOGF(info, "File %s: scanned %zu bytes, %zu pages, %zu HBFs, %zu faulty pages", fnames[fi].c_str(), res.bytes, res.pages, res.hbfs, res.faults);
+      }
+      totalBytes += res.bytes;
+      if (res.faults) {
+        nbad++;
+      }
+    }
+    LOGF(info, "Scanned %.3f GB in %.2f s (%.3f GB/s) with %d threads", totalBytes / 1e9, swq.RealTime(), swq.RealTime() > 0. ? totalBytes / 1e9 / swq.RealTime() : 0., nThreads);
+    return nbad ? -1 : 0;
+  }
+
   if (!config.empty()) {
     auto inp = o2::raw::RawFileReader::parseInput(config);
     reader.loadFromInputsMap(inp);
@@ -161,4 +161,43 @@ BOOST_AUTO_TEST_CASE(HBFUtils)
   BOOST_CHECK(nHBFOpen == nHBFClose);
   BOOST_CHECK(nHBF == nTF * sampler.getNOrbitsPerTF()); // make sure all TFs are complete
 }
+
+BOOST_AUTO_TEST_CASE(HBFUtilsBatchAndLUT)
+{
+  using IR = o2::InteractionRecord;
+  const auto& sampler = o2::raw::HBFUtils::Instance();
+
+  o2::steer::InteractionSampler irSampler;
+  irSampler.setInteractionRate(12000);
+  irSampler.setFirstIR(sampler.getFirstIR());
+  irSampler.init();
+  std::vector<o2::InteractionTimeRecord> irs(1000);
+  irSampler.generateCollisionTimes(irs);
+  std::vector<IR> recs(irs.begin(), irs.end());
+
+  // batch conversions must reproduce the per-call results
+  std::vector<uint32_t> hbfs(recs.size()), tfs(recs.size());
+  std::vector<std::pair<int, int>> tfhb(recs.size());
+  sampler.getHBFs(recs, hbfs);
+  sampler.getTFs(recs, tfs);
+  sampler.getTFsAndHBinTFs(recs, tfhb);
+
+  auto lut = sampler.makeOrbitLUT(recs.front().orbit, recs.back().orbit);
+  BOOST_CHECK(lut.getNOrbitsCovered() == recs.back().orbit - recs.front().orbit + 1);
+
+  for (size_t i = 0; i < recs.size(); i++) {
+    BOOST_CHECK(hbfs[i] == sampler.getHBF(recs[i]));
+    BOOST_CHECK(tfs[i] == sampler.getTF(recs[i]));
+    BOOST_CHECK(tfhb[i] == sampler.getTFandHBinTF(recs[i]));
+    BOOST_CHECK(lut.getTF(recs[i]) == sampler.getTF(recs[i]));
+    BOOST_CHECK(lut.getTFandHBinTF(recs[i]) == sampler.getTFandHBinTF(recs[i]));
+    BOOST_CHECK(lut.getFirstIRofTF(recs[i]) == sampler.getFirstIRofTF(recs[i]));
+  }
+
+  // queries outside of the covered orbit range fall back to direct computation
+  IR beyond{0, recs.back().orbit + 1000};
+  BOOST_CHECK(lut.getTF(beyond) == sampler.getTF(beyond));
+  BOOST_CHECK(lut.getTFandHBinTF(beyond) == sampler.getTFandHBinTF(beyond));
+  BOOST_CHECK(lut.getFirstIRofTF(beyond) == sampler.getFirstIRofTF(beyond));
+}
 } // namespace o2
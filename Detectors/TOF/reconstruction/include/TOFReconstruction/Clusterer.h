@@ -16,6 +16,7 @@
 
 #include <utility>
 #include <vector>
+#include <gsl/span>
 #include "DataFormatsTOF/Cluster.h"
 #include "DataFormatsTOF/CalibInfoCluster.h"
 #include "TOFBase/Geo.h"
@@ -64,6 +65,13 @@ class Clusterer
 
   void setDeltaTforClustering(float val) { mDeltaTforClustering = val; }
   float getDeltaTforClustering() const { return mDeltaTforClustering; }
+
+  /// pre-bucket the digits of each strip by calibrated time before the pairwise
+  /// clustering: digits separated by more than the clustering window can never
+  /// share a cluster, so each bucket is clusterized independently and the search
+  /// cost is bounded by the bucket occupancy instead of the strip occupancy
+  void setTimeBucketing(bool val = true) { mTimeBucketing = val; }
+  bool isTimeBucketing() const { return mTimeBucketing; }
   std::vector<o2::tof::CalibInfoCluster>* getInfoFromCluster() { return &mCalibInfosFromCluster; }
   void addDiagnostic(const Diagnostic& dia)
   {
@@ -82,6 +90,8 @@ class Clusterer
  private:
   void calibrateStrip();
   void processStrip(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
+  void processStripBucketed(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
+  void processTimeBucket(gsl::span<const int> bucket, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
   //void fetchMCLabels(const Digit* dig, std::array<Label, Cluster::maxLabels>& labels, int& nfilled) const;
 
   StripData mStripData; ///< single strip data provided by the reader
@@ -97,6 +107,8 @@ class Clusterer
   uint64_t mBCOffset = 0;        //! 1st orbit of the TF converted to BCs
 
   float mDeltaTforClustering = 5000; //! delta time (in ps) accepted for clustering
+  bool mTimeBucketing = false;       //! clusterize per time bucket instead of scanning the full strip
+  std::vector<int> mBucketOrder;     //! scratch: digit indices of the current strip ordered by calibrated time
   bool mCalibFromCluster = false;    //! if producing calib from clusters
   Diagnostic mDiagnosticFrequency;   //! diagnostic frquency in current TF
   bool mIsNoisy[Geo::NCHANNELS];     //! noisy channel map
@@ -12,6 +12,7 @@
 /// \file Clusterer.cxx
 /// \brief Implementation of the TOF cluster finder
 #include <algorithm>
+#include <numeric>
 #include <fairlogger/Logger.h> // for LOG
 #include "DataFormatsTOF/Cluster.h"
 #include "TOFReconstruction/Clusterer.h"
@@ -36,7 +37,11 @@ void Clusterer::process(DataReader& reader, std::vector<Cluster>& clusters, MCLa
     totNumDigits += mStripData.digits.size();
 
     calibrateStrip();
-    processStrip(clusters, digitMCTruth);
+    if (mTimeBucketing) {
+      processStripBucketed(clusters, digitMCTruth);
+    } else {
+      processStrip(clusters, digitMCTruth);
+    }
   }
 
   LOG(debug) << "We had " << totNumDigits << " digits in this event";
@@ -125,6 +130,85 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
 
   } // loop on the first digit
 }
+//__________________________________________________
+void Clusterer::processStripBucketed(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+{
+  // order the digits of the current strip by calibrated time and cut the
+  // sequence into independent buckets at every gap larger than the clustering
+  // window: digits of different buckets can never contribute to the same
+  // cluster, so each bucket is clusterized on its own. The ordering also
+  // guarantees the monotonicity in calibrated time which the early break of
+  // the pairwise search relies on (the reader sorts by raw TDC only).
+  auto& digits = mStripData.digits;
+  mBucketOrder.resize(digits.size());
+  std::iota(mBucketOrder.begin(), mBucketOrder.end(), 0);
+  std::sort(mBucketOrder.begin(), mBucketOrder.end(), [&digits](int lhs, int rhs) {
+    return digits[lhs].getCalibratedTime() < digits[rhs].getCalibratedTime();
+  });
+
+  size_t bucketStart = 0;
+  for (size_t idx = 1; idx <= mBucketOrder.size(); idx++) {
+    if (idx == mBucketOrder.size() ||
+        digits[mBucketOrder[idx]].getCalibratedTime() - digits[mBucketOrder[idx - 1]].getCalibratedTime() > mDeltaTforClustering) {
+      processTimeBucket(gsl::span<const int>(&mBucketOrder[bucketStart], idx - bucketStart), clusters, digitMCTruth);
+      bucketStart = idx;
+    }
+  }
+}
+
+//__________________________________________________
+void Clusterer::processTimeBucket(gsl::span<const int> bucket, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+{
+  // clusterize one time bucket of the current strip; same pairwise logic as
+  // processStrip, but restricted to the digits of the bucket
+
+  Int_t iphi, iphi2;
+  Int_t ieta, ieta2;
+
+  for (int ipos = 0; ipos < bucket.size(); ipos++) {
+    Digit* dig = &mStripData.digits[bucket[ipos]];
+    if (dig->isUsedInCluster() || dig->isProblematic()) {
+      continue; // the digit was already used to build a cluster, or it was declared problematic
+    }
+
+    mNumberOfContributingDigits = 0;
+    dig->getPhiAndEtaIndex(iphi, ieta);
+
+    // first we make a cluster out of the digit
+    int noc = clusters.size();
+    clusters.emplace_back();
+    Cluster& c = clusters[noc];
+    addContributingDigit(dig);
+    double timeDig = dig->getCalibratedTime();
+
+    for (int iposNext = ipos + 1; iposNext < bucket.size(); iposNext++) {
+      Digit* digNext = &mStripData.digits[bucket[iposNext]];
+      if (digNext->isUsedInCluster() || digNext->isProblematic()) {
+        continue;
+      }
+      // the bucket is ordered in calibrated time, so the first digit beyond
+      // the clustering window terminates the search
+      double timeDigNext = digNext->getCalibratedTime(); // in ps
+      if (timeDigNext - timeDig > mDeltaTforClustering) {
+        break;
+      }
+      digNext->getPhiAndEtaIndex(iphi2, ieta2);
+
+      // check if the fired pads are close in space
+      if ((std::abs(iphi - iphi2) > 1) || (std::abs(ieta - ieta2) > 1)) {
+        continue;
+      }
+
+      // if we are here, the digit contributes to the cluster
+      addContributingDigit(digNext);
+
+    } // loop on the second digit
+
+    buildCluster(c, digitMCTruth);
+
+  } // loop on the first digit
+}
+
 //______________________________________________________________________
 void Clusterer::addContributingDigit(Digit* dig)
 {
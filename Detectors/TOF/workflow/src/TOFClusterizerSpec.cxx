@@ -81,6 +81,7 @@ class TOFDPLClustererTask
     mClusterer.setCalibFromCluster(mIsCalib);
     mClusterer.setDeltaTforClustering(mTimeWin);
     mClusterer.setCalibStored(mForCalib);
+    mClusterer.setTimeBucketing(ic.options().get<bool>("time-bucketing"));
 
     mMultPerLongBC.resize(o2::base::GRPGeomHelper::instance().getNHBFPerTF() * o2::constants::lhc::LHCMaxBunches);
     std::fill(mMultPerLongBC.begin(), mMultPerLongBC.end(), 0);
@@ -357,7 +358,8 @@ o2::framework::DataProcessorSpec getTOFClusterizerSpec(bool useMC, bool useCCDB,
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<TOFDPLClustererTask>(ggRequest, useMC, useCCDB, doCalib, isCosmic, ccdb_url, isForCalib)},
-    Options{{"cluster-time-window", VariantType::Int, 5000, {"time window for clusterization in ps"}}}};
+    Options{{"cluster-time-window", VariantType::Int, 5000, {"time window for clusterization in ps"}},
+            {"time-bucketing", VariantType::Bool, false, {"clusterize per calibrated-time bucket (linear scaling in busy TFs)"}}}};
 }
 
 } // end namespace tof
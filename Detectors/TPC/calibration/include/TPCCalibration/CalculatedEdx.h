@@ -27,6 +27,7 @@
 #include "TPCCalibration/CorrectdEdxDistortions.h"
 
 #include <vector>
+#include <gsl/span>
 
 namespace o2::tpc
 {
@@ -142,6 +143,20 @@ class CalculatedEdx
   ///                                                      GainResidual = residuals gain map from calibration container, dEdxResidual = residual dEdx correction
   void calculatedEdx(TrackTPC& track, dEdxInfo& output, float low = 0.015f, float high = 0.6f, CorrectionFlags correctionMask = CorrectionFlags::TopologyPol | CorrectionFlags::dEdxResidual, ClusterFlags clusterMask = ClusterFlags::None, int subthresholdMethod = 0, const char* debugRootFile = "dEdxDebug.root");
 
+  /// batched version of the truncated mean calculation for a span of tracks
+  /// the per-cluster data of all tracks is gathered once into flat arrays and every enabled correction
+  /// then runs as one pass over those arrays, which avoids the per-cluster dispatch into the correction
+  /// maps of the track-by-track method; the results are identical to calling calculatedEdx() per track
+  /// the debug streamer is not filled by this method
+  /// \param tracks input tracks, modified by the refit or propagation like in the track-by-track method
+  /// \param outputs output dEdxInfo, resized to the number of tracks
+  /// \param low lower cluster cut
+  /// \param high higher cluster cut
+  /// \param correctionMask mask to apply different corrections, see above
+  /// \param clusterMask mask to exclude clusters, see above
+  /// \param subthresholdMethod method for filling missing clusters, see fillMissingClusters()
+  void calculatedEdx(gsl::span<TrackTPC> tracks, std::vector<dEdxInfo>& outputs, float low = 0.015f, float high = 0.6f, CorrectionFlags correctionMask = CorrectionFlags::TopologyPol | CorrectionFlags::dEdxResidual, ClusterFlags clusterMask = ClusterFlags::None, int subthresholdMethod = 0);
+
   /// get the truncated mean for the input charge vector and the truncation range low*nCl<nCl<high*nCl
   /// \param charge input vector
   /// \param low lower cluster cut (e.g. 0.015)
@@ -225,6 +240,25 @@ class CalculatedEdx
   unsigned int getOccupancy(const o2::tpc::ClusterNative& cl) const;
 
  private:
+  /// flat per-cluster data of a batch of tracks for the structure-of-arrays correction passes
+  struct ClusterBatch {
+    std::vector<unsigned int> trackFirstCl; ///< entry of the first cluster per track (number of tracks + 1 entries)
+    std::vector<unsigned char> sectorIndex; ///< sector of the cluster
+    std::vector<unsigned char> rowIndex;    ///< global pad row of the cluster
+    std::vector<unsigned char> pad;         ///< integer pad of the cluster
+    std::vector<unsigned char> stack;       ///< GEM stack of the cluster
+    std::vector<unsigned char> excludeCl;   ///< exclusion bit mask as in the track-by-track method, 0 = cluster is used
+    std::vector<float> snp;                 ///< track snp at the cluster x position
+    std::vector<float> tgl;                 ///< track tgl at the cluster x position
+    std::vector<float> z;                   ///< track z at the cluster x position
+    std::vector<float> absRelPad;           ///< fractional pad position of the cluster
+    std::vector<float> relTime;             ///< fractional time position of the cluster
+    std::vector<float> relTime0;            ///< cluster time relative to the track time0
+    std::vector<float> threshold;           ///< zero suppression threshold of the pad
+    std::vector<float> chargeTot;           ///< qTot, corrected in place by the correction passes
+    std::vector<float> chargeMax;           ///< qMax, corrected in place by the correction passes
+  };
+
   std::vector<TrackTPC>* mTracks{nullptr};                       ///< vector containing the tpc tracks which will be processed
   std::vector<TPCClRefElem>* mTPCTrackClIdxVecInput{nullptr};    ///< input vector with TPC tracks cluster indicies
   const o2::tpc::ClusterNativeAccess* mClusterIndex{nullptr};    ///< needed to access clusternative with tpctracks
@@ -245,6 +279,8 @@ class CalculatedEdx
   std::array<std::vector<float>, 5> mChargeTotROC;
   std::array<std::vector<float>, 5> mChargeMaxROC;
 
+  ClusterBatch mBatch; ///< reusable buffers of the batched calculatedEdx()
+
   CorrectdEdxDistortions mSCdEdxCorrection; ///< for space-charge correction of dE/dx
 };
 
@@ -0,0 +1,110 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PackedTimeSeries.h
+/// \brief compact storage for regularly sampled calibration time series
+/// \author Matthias Kleiner <mkleiner@ikf.uni-frankfurt.de>
+
+#ifndef ALICEO2_TPC_PACKEDTIMESERIES
+#define ALICEO2_TPC_PACKEDTIMESERIES
+
+#include <Rtypes.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2::tpc
+{
+
+/*
+Compact container for a regularly sampled time series (scalers, SAC currents, ...):
+a fixed header (start time, sampling interval, quantization range) followed by
+16-bit quantized samples. Compared to a std::vector<float> payload this halves the
+object size before ROOT compression and allows consumers to decode only the small
+time slice they need instead of the full object.
+*/
+
+class PackedTimeSeries
+{
+ public:
+  /// default constructor
+  PackedTimeSeries() = default;
+
+  /// constructor defining the time axis
+  /// \param startTimeMS time stamp in ms of the first sample
+  /// \param samplingTimeMS time in ms between consecutive samples
+  PackedTimeSeries(double startTimeMS, float samplingTimeMS) : mStartTimeMS{startTimeMS}, mSamplingTimeMS{samplingTimeMS} {}
+
+  /// quantize and store the given values (replaces the current content)
+  /// \param values samples to pack
+  void pack(const std::vector<float>& values);
+
+  /// append values to the stored series; if they exceed the current quantization
+  /// range the stored samples are re-quantized to the enlarged range
+  /// \param values samples to append
+  void append(const std::vector<float>& values);
+
+  /// \return returns the decoded sample at given index
+  float getValue(size_t idx) const { return mMin + mScale * mSamples[idx]; }
+
+  /// \return returns all decoded samples
+  std::vector<float> unpack() const;
+
+  /// decode only the samples overlapping with the given time window
+  /// \param startTimeMS begin of the window in ms
+  /// \param endTimeMS end of the window in ms
+  /// \return returns the decoded samples of the window
+  std::vector<float> getSlice(double startTimeMS, double endTimeMS) const;
+
+  /// \return returns index of the sample covering the given time stamp (clamped to the stored range)
+  size_t getIndex(double timeMS) const;
+
+  /// \return returns number of stored samples
+  size_t getNValues() const { return mSamples.size(); }
+
+  /// \return returns time stamp in ms of the first sample
+  double getStartTimeStampMS() const { return mStartTimeMS; }
+
+  /// \return returns time stamp in ms after the last sample
+  double getEndTimeStampMS() const { return mStartTimeMS + mSamplingTimeMS * mSamples.size(); }
+
+  /// \return returns time in ms between consecutive samples
+  float getSamplingTimeMS() const { return mSamplingTimeMS; }
+
+  /// \return returns smallest value representable by the current quantization
+  float getMin() const { return mMin; }
+
+  /// \return returns quantization step (0 for a constant series)
+  float getQuantizationStep() const { return mScale; }
+
+  /// \param startTimeMS time stamp in ms of the first sample
+  void setStartTimeStampMS(double startTimeMS) { mStartTimeMS = startTimeMS; }
+
+  /// \param samplingTimeMS time in ms between consecutive samples
+  void setSamplingTimeMS(float samplingTimeMS) { mSamplingTimeMS = samplingTimeMS; }
+
+ private:
+  static constexpr uint16_t FullScale = 0xFFFF; ///< largest stored sample value
+
+  double mStartTimeMS{};            ///< time stamp of the first sample in ms
+  float mSamplingTimeMS{1.};        ///< time between consecutive samples in ms
+  float mMin{};                     ///< value encoded as 0
+  float mScale{};                   ///< quantization step ((max - min) / FullScale)
+  std::vector<uint16_t> mSamples{}; ///< quantized samples
+
+  /// \return returns quantized representation of value (range must contain value)
+  uint16_t quantize(float value) const;
+
+  ClassDefNV(PackedTimeSeries, 1);
+};
+
+} // namespace o2::tpc
+#endif
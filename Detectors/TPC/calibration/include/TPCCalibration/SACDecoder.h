@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <array>
 #include <deque>
+#include <numeric>
 #include <unordered_map>
 #include <vector>
 #include <bitset>
@@ -70,6 +71,27 @@ struct DataPoint {
   ClassDefNV(DataPoint, 2);
 };
 
+/// Structure of arrays export of the decoded currents
+///
+/// Time series of one GEM stack are stored contiguously to allow vectorized
+/// processing in the consumers of the decoded currents
+struct DecodedDataSoA {
+  std::vector<uint32_t> time;                           ///< reference times of the entries
+  std::array<std::vector<int32_t>, GEMSTACKS> currents; ///< current time series per GEM stack, in signed ADC values
+
+  size_t getNSamples() const { return time.size(); }
+
+  void clear()
+  {
+    time.clear();
+    for (auto& stack : currents) {
+      stack.clear();
+    }
+  }
+
+  ClassDefNV(DecodedDataSoA, 1);
+};
+
 struct DecodedData {
   double referenceTime{-1.};               ///< reference time when sampling clock was started
   std::vector<DataPoint> data;             ///< decoded data
@@ -125,6 +147,9 @@ struct DecodedData {
   /// copy decoded data from single FE and mark FE as received
   void setData(const size_t pos, uint32_t time, const DecodedDataFE& decdata, const int feid);
 
+  /// transpose the good entries, for which all FEs were decoded, into structure of arrays format
+  void fillSoA(DecodedDataSoA& soa) const;
+
   ClassDefNV(DecodedData, 1);
 };
 
@@ -154,6 +179,10 @@ class Decoder
 
   bool process(const char* data, size_t size);
 
+  /// process a whole HBF payload of concatenated SAC packets
+  /// \return true if all packets were collected without errors
+  bool processBulk(const char* data, size_t size);
+
   void runDecoding();
 
   void finalize();
@@ -218,6 +247,18 @@ class Decoder
   /// \return returns the number of threads used for decoding
   static int getNThreads() { return sNThreads; }
 
+  /// \return total number of decoded channel currents
+  size_t getNDecodedValues() const { return std::accumulate(mNDecodedValuesFE.begin(), mNDecodedValuesFE.end(), size_t(0)); }
+
+  /// \return total number of decoded time stamps
+  size_t getNDecodedTimeStamps() const
+  {
+    return std::accumulate(mTSCountFEs.begin(), mTSCountFEs.end(), size_t(0), [](size_t sum, const auto& counts) { return sum + counts.first; });
+  }
+
+  /// \return average decoding rate in channel currents per second, accumulated over all `runDecoding` calls
+  double getDecodingRate() const { return (mDecodingTime > 0.) ? getNDecodedValues() / mDecodingTime : 0.; }
+
  private:
   inline static int sNThreads{1};                                   ///< number of threads for decoding FEs
   size_t mCollectedDataPackets{};                                   ///< Number of collected data packets
@@ -225,6 +266,8 @@ class Decoder
   std::array<uint32_t, NumberFEs> mPktCountFEs{};                   ///< Packet counter for the single FEs
   std::array<std::pair<uint32_t, uint32_t>, NumberFEs> mTSCountFEs; ///< Counter how often the time stamp was seen for the single FEs, all / valid
   std::array<std::string, NumberFEs> mDataStrings;                  ///< ASCI data sent by FE
+  std::array<size_t, NumberFEs> mNDecodedValuesFE{};                ///< Number of decoded channel currents per FE
+  double mDecodingTime{};                                           ///< Wall time spent in runDecoding in seconds
   DecodedData mDecodedData;                                         ///< decoded data
   std::unique_ptr<o2::utils::TreeStreamRedirector> mDebugStream;    ///< Debug output streamer
   std::string mDecodeAdditional;                                    ///< Decode these additional data for debugging purposes
@@ -95,6 +95,12 @@ class TPCFastSpaceChargeCorrectionHelper
 
   void fillSpaceChargeCorrectionFromMap(TPCFastSpaceChargeCorrection& correction);
 
+  /// incrementally updates the correction from the current content of the map:
+  /// only spline rows whose data points deviate from the stored correction by more than
+  /// the threshold (in cm) are refitted, together with their inverse.
+  /// Returns the number of refitted spline rows.
+  int updateSpaceChargeCorrectionFromMap(TPCFastSpaceChargeCorrection& correction, float threshold = 1.e-4f);
+
   void testGeometry(const TPCFastTransformGeo& geo) const;
 
   /// initialise inverse transformation
@@ -110,9 +116,18 @@ class TPCFastSpaceChargeCorrectionHelper
   /// get space charge correction in internal TPCFastTransform coordinates u,v->dx,du,dv
   void getSpaceChargeCorrection(const TPCFastSpaceChargeCorrection& correction, int slice, int row, o2::gpu::TPCFastSpaceChargeCorrectionMap::CorrectionPoint p, double& su, double& sv, double& dx, double& du, double& dv);
 
+  /// approximate the spline of one slice row with the map data points
+  void fitSplineRowFromMap(TPCFastSpaceChargeCorrection& correction, int slice, int row);
+
   /// initialise max drift length
   void initMaxDriftLength(o2::gpu::TPCFastSpaceChargeCorrection& correction, bool prn);
 
+  /// initialise max drift length of one slice row
+  void initMaxDriftLengthRow(o2::gpu::TPCFastSpaceChargeCorrection& correction, int slice, int row, double tpcR2min, double tpcR2max);
+
+  /// initialise the inverse transformation of one slice row
+  void initInverseRow(std::vector<o2::gpu::TPCFastSpaceChargeCorrection*>& corrections, const std::vector<float>& scaling, int slice, int row, bool prn);
+
   static TPCFastSpaceChargeCorrectionHelper* sInstance; ///< singleton instance
   bool mIsInitialized = 0;                              ///< initialization flag
   int mNthreads = 1;                                    ///< n of threads to use
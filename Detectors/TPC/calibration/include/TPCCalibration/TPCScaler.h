@@ -23,6 +23,8 @@ class TTree;
 namespace o2::tpc
 {
 
+class PackedTimeSeries;
+
 /*
 Class for storing the scalers which are used to calculate an estimate for the mean space-charge density for the last ion drift time
 */
@@ -144,6 +146,13 @@ class TPCScaler
   /// return if weights are used
   bool weightsUsed() const { return mUseWeights; }
 
+  /// \return returns the scalers of given side as compact quantized time series (half the payload size)
+  PackedTimeSeries getPackedScalers(o2::tpc::Side side) const;
+
+  /// set the scalers of given side from a packed time series (also sets start time and integration time)
+  /// \param packed packed scaler values
+  void setScalersFromPacked(const PackedTimeSeries& packed, o2::tpc::Side side);
+
  private:
   float mIonDriftTimeMS{200};        ///< ion drift time in ms
   int mRun{};                        ///< run for which this object is valid
@@ -93,6 +93,43 @@ class TrackDump
     ClassDefNV(TrackInfo, 1);
   };
 
+  /// output format of the dump
+  enum class OutputFormat {
+    Tree = 0,     ///< one entry per event, tracks and clusters stored as objects
+    Columnar = 1, ///< flat SoA buffers of track parameters and clusters, zstd-compressed
+  };
+
+  /// flat columnar buffers of the track parameters and the associated clusters.
+  /// One tree entry is written per processed chunk, the per-track cluster offsets
+  /// allow random access to the clusters of a single track without reading the full dump
+  struct ColumnarChunk {
+    std::vector<float> trackX{};              ///< local x parameter of the tracks
+    std::vector<float> trackAlpha{};          ///< sector rotation angle of the tracks
+    std::vector<float> trackY{};              ///< local y parameter of the tracks
+    std::vector<float> trackZ{};              ///< z parameter of the tracks
+    std::vector<float> trackSnp{};            ///< sine of the local azimuthal angle
+    std::vector<float> trackTgl{};            ///< tangent of the dip angle
+    std::vector<float> trackQ2Pt{};           ///< charge over transverse momentum
+    std::vector<float> trackTime0{};          ///< reference time of the tracks
+    std::vector<float> trackDEdxTot{};        ///< dE/dx from qTot
+    std::vector<float> trackDEdxMax{};        ///< dE/dx from qMax
+    std::vector<uint32_t> trackFirstCluster{}; ///< index of the first cluster of each track in the cluster columns
+    std::vector<uint16_t> trackNClusters{};    ///< number of clusters of each track
+    std::vector<float> clPad{};               ///< pad position of the clusters
+    std::vector<float> clTime{};              ///< time position of the clusters
+    std::vector<float> clSigmaPad{};          ///< pad resolution of the clusters
+    std::vector<float> clSigmaTime{};         ///< time resolution of the clusters
+    std::vector<uint16_t> clQMax{};           ///< QMax of the clusters
+    std::vector<uint16_t> clQTot{};           ///< total charge of the clusters
+    std::vector<uint8_t> clFlags{};           ///< cluster flags
+    std::vector<uint8_t> clSector{};          ///< sector of the clusters
+    std::vector<uint8_t> clPadrow{};          ///< global pad row of the clusters
+
+    void addTrack(const TrackTPC& track);
+    void addCluster(const ClusterNative& cl, uint8_t sector, uint8_t padrow);
+    void clear();
+  };
+
   /// how to store clusters associated to tracks
   enum class ClStorageType {
     InsideTrack = 0,
@@ -118,10 +155,15 @@ class TrackDump
   bool writeTracks{true};                                          ///< write global cluster information for quick drawing
   bool writeGlobal{false};                                         ///< write global cluster information for quick drawing
   bool writeMC{false};                                             ///< write MC track information for quick drawing
+  OutputFormat outputFormat{OutputFormat::Tree};                   ///< write per-track objects or flat columnar buffers
+  int compressionLevel{3};                                         ///< zstd compression level used for the columnar format
   ClStorageType clusterStorageType{ClStorageType::InsideTrack};    ///< instead of storing the clusters with the tracks, store them in a separate tree
   ClUnStorageType noTrackClusterType{ClUnStorageType::DontStore};  ///< store unassociated clusters in separate tree
 
  private:
+  /// write one chunk of tracks and clusters as flat columnar buffers
+  void filterColumnar(const gsl::span<const TrackTPC> tracks, ClusterNativeAccess const& clusterIndex, const gsl::span<const o2::tpc::TPCClRefElem> clRefs, const gsl::span<const MCCompLabel> mcLabels);
+
   std::unique_ptr<o2::utils::TreeStreamRedirector> mTreeDump;        ///< Tree writer tracks (+ clusters)
   std::unique_ptr<o2::utils::TreeStreamRedirector> mTreeDumpClOnly;  ///< Tree writer only clusters
   std::unique_ptr<o2::utils::TreeStreamRedirector> mTreeDumpUnassCl; ///< Tree writer unassociated clusters
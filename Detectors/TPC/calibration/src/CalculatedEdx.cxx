@@ -349,8 +349,6 @@ void CalculatedEdx::calculatedEdx(o2::tpc::TrackTPC& track, dEdxInfo& output, fl
       scCorr = mSCdEdxCorrection.getCorrection(time, sectorIndex, rowIndex, pad);
       if (scCorr > 0) {
         chargeTot /= scCorr;
-      };
-      if (corrMax > 0) {
         chargeMax /= scCorr;
       };
     }
@@ -482,6 +480,282 @@ void CalculatedEdx::calculatedEdx(o2::tpc::TrackTPC& track, dEdxInfo& output, fl
   }
 }
 
+void CalculatedEdx::calculatedEdx(gsl::span<o2::tpc::TrackTPC> tracks, std::vector<dEdxInfo>& outputs, float low, float high, CorrectionFlags correctionMask, ClusterFlags clusterMask, int subthresholdMethod)
+{
+  const size_t nTracks = tracks.size();
+  outputs.resize(nTracks);
+
+  auto& batch = mBatch;
+  batch.trackFirstCl.resize(nTracks + 1);
+  batch.trackFirstCl[0] = 0;
+  for (size_t iTrack = 0; iTrack < nTracks; iTrack++) {
+    batch.trackFirstCl[iTrack + 1] = batch.trackFirstCl[iTrack] + tracks[iTrack].getNClusterReferences();
+  }
+  const size_t nClTotal = batch.trackFirstCl[nTracks];
+
+  batch.sectorIndex.resize(nClTotal);
+  batch.rowIndex.resize(nClTotal);
+  batch.pad.resize(nClTotal);
+  batch.stack.resize(nClTotal);
+  batch.excludeCl.resize(nClTotal);
+  batch.snp.resize(nClTotal);
+  batch.tgl.resize(nClTotal);
+  batch.z.resize(nClTotal);
+  batch.absRelPad.resize(nClTotal);
+  batch.relTime.resize(nClTotal);
+  batch.relTime0.resize(nClTotal);
+  batch.threshold.resize(nClTotal);
+  batch.chargeTot.resize(nClTotal);
+  batch.chargeMax.resize(nClTotal);
+
+  // gather pass: collect the per-cluster data of all tracks into the flat arrays
+  const Mapper& mapper = Mapper::instance();
+  for (size_t iTrack = 0; iTrack < nTracks; iTrack++) {
+    auto& track = tracks[iTrack];
+    const int nClusters = track.getNClusterReferences();
+    for (int iCl = 0; iCl < nClusters; iCl++) {
+      const size_t entry = batch.trackFirstCl[iTrack] + iCl;
+      const o2::tpc::ClusterNative& cl = track.getCluster(*mTPCTrackClIdxVecInput, iCl, *mClusterIndex);
+
+      unsigned char sectorIndex = 0;
+      unsigned char rowIndex = 0;
+      unsigned int clusterIndexNumb = 0;
+      track.getClusterReference(*mTPCTrackClIdxVecInput, iCl, sectorIndex, rowIndex, clusterIndexNumb);
+
+      // check if the cluster is shared
+      const unsigned int absoluteIndex = mClusterIndex->clusterOffset[sectorIndex][rowIndex] + clusterIndexNumb;
+      const bool isShared = mRefit ? (mTPCRefitterShMap[absoluteIndex] & GPUCA_NAMESPACE::gpu::GPUTPCGMMergedTrackHit::flagShared) : 0;
+
+      const int region = Mapper::REGION[rowIndex];
+      const unsigned char pad = std::clamp(static_cast<unsigned int>(cl.getPad() + 0.5f), static_cast<unsigned int>(0), Mapper::PADSPERROW[region][Mapper::getLocalRowFromGlobalRow(rowIndex)] - 1); // the left side of the pad is defined at e.g. 3.5 and the right side at 4.5
+      const auto flagsCl = cl.getFlags();
+
+      int excludeCl = 0; // works as a bit mask
+      if (((clusterMask & ClusterFlags::ExcludeSingleCl) == ClusterFlags::ExcludeSingleCl) && ((flagsCl & ClusterNative::flagSingle) == ClusterNative::flagSingle)) {
+        excludeCl += 0b001; // 1 for single cluster
+      }
+      if (((clusterMask & ClusterFlags::ExcludeSplitCl) == ClusterFlags::ExcludeSplitCl) && (((flagsCl & ClusterNative::flagSplitPad) == ClusterNative::flagSplitPad) || ((flagsCl & ClusterNative::flagSplitTime) == ClusterNative::flagSplitTime))) {
+        excludeCl += 0b010; // 2 for split cluster
+      }
+      if (((clusterMask & ClusterFlags::ExcludeEdgeCl) == ClusterFlags::ExcludeEdgeCl) && ((flagsCl & ClusterNative::flagEdge) == ClusterNative::flagEdge)) {
+        excludeCl += 0b100; // 4 for edge cluster
+      }
+      if (((clusterMask & ClusterFlags::ExcludeSharedCl) == ClusterFlags::ExcludeSharedCl) && isShared) {
+        excludeCl += 0b10000; // for shared cluster
+      }
+
+      // get the x position of the track
+      const float xPosition = mapper.getPadCentre(PadPos(rowIndex, 0)).X();
+
+      bool check = true;
+      if (!mPropagateTrack) {
+        if (mRefit == nullptr) {
+          LOGP(error, "mRefit is a nullptr, call the function setRefit() before looping over the tracks.");
+        }
+        mRefit->setTrackReferenceX(xPosition);
+        check = (mRefit->RefitTrackAsGPU(track, false, true) < 0) ? false : true;
+      } else {
+        // propagate this track to the plane X=xk (cm) in the field "b" (kG)
+        track.rotate(o2::math_utils::detail::sector2Angle<float>(sectorIndex));
+        check = o2::base::Propagator::Instance()->PropagateToXBxByBz(track, xPosition, 0.999f, 2., o2::base::Propagator::MatCorrType::USEMatCorrLUT);
+      }
+
+      if (!check || std::isnan(track.getParam(1))) {
+        excludeCl += 0b1000; // 8 for failure of track propagation or refit
+      }
+
+      batch.sectorIndex[entry] = sectorIndex;
+      batch.rowIndex[entry] = rowIndex;
+      batch.pad[entry] = pad;
+      batch.stack[entry] = static_cast<unsigned char>(CRU(Sector(sectorIndex), region).gemStack());
+      batch.excludeCl[entry] = excludeCl;
+      batch.snp[entry] = track.getSnp();
+      batch.tgl[entry] = track.getTgl();
+      batch.z[entry] = track.getParam(1);
+      const float padTmp = cl.getPad();
+      batch.absRelPad[entry] = std::abs(padTmp - int(padTmp + 0.5f));
+      batch.relTime[entry] = cl.getTime() - int(cl.getTime() + 0.5f);
+      batch.relTime0[entry] = cl.getTime() - track.getTime0();
+      batch.threshold[entry] = mCalibCont.getZeroSupressionThreshold(sectorIndex, rowIndex, pad);
+      batch.chargeTot[entry] = cl.qTot;
+      batch.chargeMax[entry] = cl.qMax;
+    }
+  }
+
+  // correction passes: every enabled correction runs as one pass over the flat arrays
+  if ((correctionMask & CorrectionFlags::TopologySimple) == CorrectionFlags::TopologySimple) {
+    float padLength[Mapper::NREGIONS];
+    for (unsigned int region = 0; region < Mapper::NREGIONS; region++) {
+      padLength[region] = mapper.getPadRegionInfo(region).getPadHeight();
+    }
+    for (size_t entry = 0; entry < nClTotal; entry++) {
+      if (batch.excludeCl[entry]) {
+        continue;
+      }
+      const float snp2 = batch.snp[entry] * batch.snp[entry];
+      const float tgl2 = batch.tgl[entry] * batch.tgl[entry];
+      const float effectiveLength = padLength[Mapper::REGION[batch.rowIndex[entry]]] * std::sqrt((1 + tgl2) / (1 - snp2));
+      batch.chargeTot[entry] /= effectiveLength;
+      batch.chargeMax[entry] /= effectiveLength;
+    }
+  }
+  if ((correctionMask & CorrectionFlags::TopologyPol) == CorrectionFlags::TopologyPol) {
+    for (size_t entry = 0; entry < nClTotal; entry++) {
+      if (batch.excludeCl[entry]) {
+        continue;
+      }
+      const int region = Mapper::REGION[batch.rowIndex[entry]];
+      const float snp = std::abs(batch.snp[entry]);
+      const float sec2 = 1.f / (1.f - snp * snp);
+      const float tanTheta = std::sqrt(batch.tgl[entry] * batch.tgl[entry] * sec2);
+      const float z = std::abs(batch.z[entry]);
+      batch.chargeTot[entry] /= mCalibCont.getTopologyCorrection(region, ChargeType::Tot, tanTheta, snp, z, batch.absRelPad[entry], batch.relTime[entry], batch.threshold[entry], batch.chargeTot[entry]);
+      batch.chargeMax[entry] /= mCalibCont.getTopologyCorrection(region, ChargeType::Max, tanTheta, snp, z, batch.absRelPad[entry], batch.relTime[entry], batch.threshold[entry], batch.chargeMax[entry]);
+    }
+  }
+  if (((correctionMask & CorrectionFlags::GainFull) == CorrectionFlags::GainFull) || ((correctionMask & CorrectionFlags::GainResidual) == CorrectionFlags::GainResidual)) {
+    for (size_t entry = 0; entry < nClTotal; entry++) {
+      if (batch.excludeCl[entry]) {
+        continue;
+      }
+      float gain = 1.0f;
+      if ((correctionMask & CorrectionFlags::GainFull) == CorrectionFlags::GainFull) {
+        gain *= mCalibCont.getGain(batch.sectorIndex[entry], batch.rowIndex[entry], batch.pad[entry]);
+      }
+      if ((correctionMask & CorrectionFlags::GainResidual) == CorrectionFlags::GainResidual) {
+        gain *= mCalibCont.getResidualGain(batch.sectorIndex[entry], batch.rowIndex[entry], batch.pad[entry]);
+      }
+      batch.chargeTot[entry] /= gain;
+      batch.chargeMax[entry] /= gain;
+    }
+  }
+  if ((correctionMask & CorrectionFlags::dEdxResidual) == CorrectionFlags::dEdxResidual) {
+    for (size_t entry = 0; entry < nClTotal; entry++) {
+      if (batch.excludeCl[entry]) {
+        continue;
+      }
+      const StackID stackID{batch.sectorIndex[entry], static_cast<GEMstack>(batch.stack[entry])};
+      const float corrTot = mCalibCont.getResidualCorrection(stackID, ChargeType::Tot, batch.tgl[entry], batch.snp[entry]);
+      const float corrMax = mCalibCont.getResidualCorrection(stackID, ChargeType::Max, batch.tgl[entry], batch.snp[entry]);
+      if (corrTot > 0) {
+        batch.chargeTot[entry] /= corrTot;
+      }
+      if (corrMax > 0) {
+        batch.chargeMax[entry] /= corrMax;
+      }
+    }
+  }
+
+  // the minimum charge per track is determined before the space-charge correction, as in the track-by-track method
+  std::vector<float> minChargeTot(nTracks, 100000.f);
+  std::vector<float> minChargeMax(nTracks, 100000.f);
+  for (size_t iTrack = 0; iTrack < nTracks; iTrack++) {
+    for (size_t entry = batch.trackFirstCl[iTrack]; entry < batch.trackFirstCl[iTrack + 1]; entry++) {
+      if (batch.excludeCl[entry]) {
+        continue;
+      }
+      minChargeTot[iTrack] = std::min(minChargeTot[iTrack], batch.chargeTot[entry]);
+      minChargeMax[iTrack] = std::min(minChargeMax[iTrack], batch.chargeMax[entry]);
+    }
+  }
+
+  if ((correctionMask & CorrectionFlags::dEdxSC) == CorrectionFlags::dEdxSC) {
+    for (size_t entry = 0; entry < nClTotal; entry++) {
+      if (batch.excludeCl[entry]) {
+        continue;
+      }
+      const float scCorr = mSCdEdxCorrection.getCorrection(batch.relTime0[entry], batch.sectorIndex[entry], batch.rowIndex[entry], batch.pad[entry]);
+      if (scCorr > 0) {
+        batch.chargeTot[entry] /= scCorr;
+        batch.chargeMax[entry] /= scCorr;
+      }
+    }
+  }
+
+  // reduction pass: subthreshold cluster treatment and truncated mean per track
+  for (size_t iTrack = 0; iTrack < nTracks; iTrack++) {
+    dEdxInfo& output = outputs[iTrack];
+
+    int nClsROC[4] = {0, 0, 0, 0};
+    int nClsSubThreshROC[4] = {0, 0, 0, 0};
+
+    for (int roc = 0; roc < 5; roc++) {
+      mChargeTotROC[roc].clear();
+      mChargeMaxROC[roc].clear();
+    }
+
+    unsigned char rowIndexOld = 0;
+    unsigned char sectorIndexOld = 0;
+    for (size_t entry = batch.trackFirstCl[iTrack]; entry < batch.trackFirstCl[iTrack + 1]; entry++) {
+      const unsigned char rowIndex = batch.rowIndex[entry];
+      const unsigned char sectorIndex = batch.sectorIndex[entry];
+      if (batch.excludeCl[entry]) {
+        // to avoid counting the skipped cluster as a subthreshold cluster
+        rowIndexOld = rowIndex;
+        sectorIndexOld = sectorIndex;
+        continue;
+      }
+
+      const int stack = batch.stack[entry];
+
+      // find missing clusters
+      const int missingClusters = rowIndexOld - rowIndex - 1;
+      if ((missingClusters > 0) && (missingClusters <= mMaxMissingCl)) {
+        if (((clusterMask & ClusterFlags::ExcludeSectorBoundaries) != ClusterFlags::ExcludeSectorBoundaries) || (sectorIndexOld == sectorIndex)) {
+          nClsSubThreshROC[stack] += missingClusters;
+          nClsROC[stack] += missingClusters;
+        }
+      }
+      rowIndexOld = rowIndex;
+      sectorIndexOld = sectorIndex;
+
+      mChargeTotROC[stack].emplace_back(batch.chargeTot[entry]);
+      mChargeMaxROC[stack].emplace_back(batch.chargeMax[entry]);
+      nClsROC[stack]++;
+
+      mChargeTotROC[4].emplace_back(batch.chargeTot[entry]);
+      mChargeMaxROC[4].emplace_back(batch.chargeMax[entry]);
+    }
+
+    // number of clusters
+    output.NHitsSubThresholdIROC = nClsROC[0];
+    output.NHitsSubThresholdOROC1 = nClsROC[1];
+    output.NHitsSubThresholdOROC2 = nClsROC[2];
+    output.NHitsSubThresholdOROC3 = nClsROC[3];
+
+    // check if the lost clusters are subthreshold clusters based on the charge thresholds
+    if (minChargeTot[iTrack] <= mMinChargeTotThreshold && minChargeMax[iTrack] <= mMinChargeMaxThreshold) {
+      output.NHitsIROC = nClsROC[0] - nClsSubThreshROC[0];
+      output.NHitsOROC1 = nClsROC[1] - nClsSubThreshROC[1];
+      output.NHitsOROC2 = nClsROC[2] - nClsSubThreshROC[2];
+      output.NHitsOROC3 = nClsROC[3] - nClsSubThreshROC[3];
+
+      // fill subthreshold clusters if not excluded
+      if (((clusterMask & ClusterFlags::ExcludeSubthresholdCl) == ClusterFlags::None)) {
+        fillMissingClusters(nClsSubThreshROC, minChargeTot[iTrack], minChargeMax[iTrack], subthresholdMethod);
+      }
+    } else {
+      output.NHitsIROC = nClsROC[0];
+      output.NHitsOROC1 = nClsROC[1];
+      output.NHitsOROC2 = nClsROC[2];
+      output.NHitsOROC3 = nClsROC[3];
+    }
+
+    // calculate dEdx
+    output.dEdxTotIROC = getTruncMean(mChargeTotROC[0], low, high);
+    output.dEdxTotOROC1 = getTruncMean(mChargeTotROC[1], low, high);
+    output.dEdxTotOROC2 = getTruncMean(mChargeTotROC[2], low, high);
+    output.dEdxTotOROC3 = getTruncMean(mChargeTotROC[3], low, high);
+    output.dEdxTotTPC = getTruncMean(mChargeTotROC[4], low, high);
+
+    output.dEdxMaxIROC = getTruncMean(mChargeMaxROC[0], low, high);
+    output.dEdxMaxOROC1 = getTruncMean(mChargeMaxROC[1], low, high);
+    output.dEdxMaxOROC2 = getTruncMean(mChargeMaxROC[2], low, high);
+    output.dEdxMaxOROC3 = getTruncMean(mChargeMaxROC[3], low, high);
+    output.dEdxMaxTPC = getTruncMean(mChargeMaxROC[4], low, high);
+  }
+}
+
 float CalculatedEdx::getTruncMean(std::vector<float>& charge, float low, float high) const
 {
   // sort the charge vector
@@ -18,6 +18,7 @@
 #include "TFile.h"
 #include "TPCBase/CalDet.h"
 #include <functional>
+#include <algorithm>
 #include "MemoryResources/MemoryResources.h"
 #include "CommonConstants/LHCConstants.h"
 #include "TKey.h"
@@ -252,16 +253,27 @@ void o2::tpc::IDCFactorization::calcIDCZero(const bool norm)
     const auto side = cruTmp.side();
     const unsigned int region = cruTmp.region();
     const auto factorIndexGlob = mRegionOffs[region] + mNIDCsPerSector * (cruTmp.sector() % o2::tpc::SECTORSPERSIDE);
+    const unsigned int nIDCsPerCRU = mNIDCsPerCRU[region];
+    const float invPadArea = Mapper::INVPADAREA[region];
+    float* idcZero = mIDCZero[mSideIndex[side]].mIDCZero.data() + factorIndexGlob;
     for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        if ((mIDCs[cru][timeframe][idcs] == -1) || (mIDCs[cru][timeframe][idcs] == 0)) {
-          continue;
-        }
+      // process the IDCs in pad-plane-contiguous blocks of one integration interval to keep the loops vectorizable
+      const unsigned int nIDCs = mIDCs[cru][timeframe].size();
+      for (unsigned int idcs0 = 0; idcs0 < nIDCs; idcs0 += nIDCsPerCRU) {
+        float* idcsBlock = mIDCs[cru][timeframe].data() + idcs0;
+        const unsigned int nPads = std::min(nIDCsPerCRU, nIDCs - idcs0);
         if (norm) {
-          mIDCs[cru][timeframe][idcs] *= Mapper::INVPADAREA[region];
+#pragma omp simd
+          for (unsigned int localPad = 0; localPad < nPads; ++localPad) {
+            const float idc = idcsBlock[localPad];
+            idcsBlock[localPad] = ((idc == -1) || (idc == 0)) ? idc : idc * invPadArea;
+          }
+        }
+#pragma omp simd
+        for (unsigned int localPad = 0; localPad < nPads; ++localPad) {
+          const float idc = idcsBlock[localPad];
+          idcZero[localPad] += ((idc == -1) || (idc == 0)) ? 0.f : idc;
         }
-        const unsigned int indexGlob = (idcs % mNIDCsPerCRU[region]) + factorIndexGlob;
-        mIDCZero[mSideIndex[side]].fillValueIDCZero(mIDCs[cru][timeframe][idcs], indexGlob);
       }
     }
   }
@@ -444,36 +456,46 @@ void o2::tpc::IDCFactorization::calcIDCDelta()
     const unsigned int region = cruTmp.region();
     const auto side = cruTmp.side();
     const auto factorIndexGlob = mRegionOffs[region] + mNIDCsPerSector * (cruTmp.sector() % o2::tpc::SECTORSPERSIDE);
+    const unsigned int nIDCsPerCRU = mNIDCsPerCRU[region];
     unsigned int integrationIntervallast = 0;
     unsigned int integrationIntervallastLocal = 0;
     unsigned int lastChunk = 0;
 
+    // gather the pad status flags once per CRU instead of looking them up for every IDC value
+    std::vector<char> skipPad(nIDCsPerCRU, 0);
+    if (mUsePadStatusMap && !mInputGrouped && mPadFlagsMap) {
+      const auto& calArray = mPadFlagsMap->getCalArray(cru);
+      for (unsigned int localPad = 0; localPad < nIDCsPerCRU; ++localPad) {
+        const o2::tpc::PadFlags flag = calArray.getValue(localPad);
+        skipPad[localPad] = ((flag & PadFlags::flagSkip) == PadFlags::flagSkip);
+      }
+    }
+
+    const float* idcZero = mIDCZero[mSideIndex[side]].mIDCZero.data() + factorIndexGlob;
+
     for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
       const unsigned int chunk = getChunk(timeframe);
       if (lastChunk != chunk) {
         integrationIntervallastLocal = 0;
       }
 
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        if ((mIDCs[cru][timeframe][idcs] == -1) || (mIDCs[cru][timeframe][idcs] == 0)) {
-          continue;
-        }
-        const unsigned int intervallocal = idcs / mNIDCsPerCRU[region];
+      // process the IDCs in pad-plane-contiguous blocks of one integration interval to keep the loop vectorizable
+      const unsigned int nIDCs = mIDCs[cru][timeframe].size();
+      for (unsigned int idcs0 = 0; idcs0 < nIDCs; idcs0 += nIDCsPerCRU) {
+        const unsigned int intervallocal = idcs0 / nIDCsPerCRU;
         const unsigned int integrationIntervalGlobal = intervallocal + integrationIntervallast;
         const unsigned int integrationIntervalLocal = intervallocal + integrationIntervallastLocal;
-        const unsigned int localPad = idcs % mNIDCsPerCRU[region];
-        const unsigned int indexGlob = localPad + factorIndexGlob;
-        const auto idcZero = mIDCZero[mSideIndex[side]].mIDCZero[indexGlob];
-        const auto idcOne = mIDCOne[mSideIndex[side]].mIDCOne[integrationIntervalGlobal];
-        const auto mult = idcZero * idcOne;
-        auto val = (mult != 0) ? mIDCs[cru][timeframe][idcs] / mult - 1 : 0;
-        if (mUsePadStatusMap && !mInputGrouped && mPadFlagsMap) {
-          const o2::tpc::PadFlags flag = mPadFlagsMap->getCalArray(cru).getValue(localPad);
-          if ((flag & PadFlags::flagSkip) == PadFlags::flagSkip) {
-            val = 0;
-          }
+        const float idcOne = mIDCOne[mSideIndex[side]].mIDCOne[integrationIntervalGlobal];
+        const float* idcsBlock = mIDCs[cru][timeframe].data() + idcs0;
+        float* idcDelta = mIDCDelta[mSideIndex[side]][chunk].getIDCDelta().data() + factorIndexGlob + integrationIntervalLocal * nIDCsSide;
+        const unsigned int nPads = std::min(nIDCsPerCRU, nIDCs - idcs0);
+#pragma omp simd
+        for (unsigned int localPad = 0; localPad < nPads; ++localPad) {
+          const float idc = idcsBlock[localPad];
+          const float mult = idcZero[localPad] * idcOne;
+          const bool valid = (idc != -1) && (idc != 0) && (mult != 0) && !skipPad[localPad];
+          idcDelta[localPad] = valid ? idc / mult - 1 : 0;
         }
-        mIDCDelta[mSideIndex[side]][chunk].setIDCDelta(indexGlob + integrationIntervalLocal * nIDCsSide, val);
       }
 
       const unsigned int intervals = mIntegrationIntervalsPerTF[timeframe];
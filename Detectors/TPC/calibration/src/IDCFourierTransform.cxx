@@ -66,22 +66,41 @@ void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsNaive()
     for (unsigned int coeff = 0; coeff < lastCoeff; ++coeff) {
       const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * coeff); // index for storing real fourier coefficient
       const unsigned int indexDataImag = indexDataReal + 1;                                  // index for storing complex fourier coefficient
-      const float term0 = o2::constants::math::TwoPI * coeff / this->mRangeIDC;
+      const double term0 = o2::constants::math::TwoPI * coeff / this->mRangeIDC;
+      // rotate the phasor exp(i * term0) instead of calling cos/sin for every index
+      const double cosStep = std::cos(term0);
+      const double sinStep = std::sin(term0);
+      double cosTerm = 1;
+      double sinTerm = 0;
+      double real = 0;
+      double imag = 0;
       for (unsigned int index = 0; index < this->mRangeIDC; ++index) {
-        const float term = term0 * index;
-        const float idc0 = idcOneExpanded[index + offsetIndex[interval]];
-        mFourierCoefficients(indexDataReal) += idc0 * std::cos(term);
-        mFourierCoefficients(indexDataImag) -= idc0 * std::sin(term);
+        const double idc0 = idcOneExpanded[index + offsetIndex[interval]];
+        real += idc0 * cosTerm;
+        imag -= idc0 * sinTerm;
+        const double cosTmp = cosTerm;
+        cosTerm = cosTmp * cosStep - sinTerm * sinStep;
+        sinTerm = cosTmp * sinStep + sinTerm * cosStep;
       }
+      mFourierCoefficients(indexDataReal) += real;
+      mFourierCoefficients(indexDataImag) += imag;
     }
     if (add) {
       const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * lastCoeff); // index for storing real fourier coefficient
-      const float term0 = o2::constants::math::TwoPI * lastCoeff / this->mRangeIDC;
+      const double term0 = o2::constants::math::TwoPI * lastCoeff / this->mRangeIDC;
+      const double cosStep = std::cos(term0);
+      const double sinStep = std::sin(term0);
+      double cosTerm = 1;
+      double sinTerm = 0;
+      double real = 0;
       for (unsigned int index = 0; index < this->mRangeIDC; ++index) {
-        const float term = term0 * index;
-        const float idc0 = idcOneExpanded[index + offsetIndex[interval]];
-        mFourierCoefficients(indexDataReal) += idc0 * std::cos(term);
+        const double idc0 = idcOneExpanded[index + offsetIndex[interval]];
+        real += idc0 * cosTerm;
+        const double cosTmp = cosTerm;
+        cosTerm = cosTmp * cosStep - sinTerm * sinStep;
+        sinTerm = cosTmp * sinStep + sinTerm * cosStep;
       }
+      mFourierCoefficients(indexDataReal) += real;
     }
   }
   // normalize coefficient to number of used points
@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PackedTimeSeries.cxx
+/// \author Matthias Kleiner <mkleiner@ikf.uni-frankfurt.de>
+
+#include "TPCCalibration/PackedTimeSeries.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace o2::tpc;
+
+uint16_t PackedTimeSeries::quantize(float value) const
+{
+  if (mScale <= 0) {
+    return 0;
+  }
+  const float q = (value - mMin) / mScale + 0.5f;
+  return (q <= 0) ? 0 : (q >= FullScale) ? FullScale
+                                         : static_cast<uint16_t>(q);
+}
+
+void PackedTimeSeries::pack(const std::vector<float>& values)
+{
+  mSamples.clear();
+  if (values.empty()) {
+    mMin = mScale = 0;
+    return;
+  }
+  const auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+  mMin = *minIt;
+  mScale = (*maxIt - mMin) / FullScale;
+  mSamples.reserve(values.size());
+  for (const auto value : values) {
+    mSamples.emplace_back(quantize(value));
+  }
+}
+
+void PackedTimeSeries::append(const std::vector<float>& values)
+{
+  if (values.empty()) {
+    return;
+  }
+  if (mSamples.empty()) {
+    pack(values);
+    return;
+  }
+  const auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+  if (*minIt < mMin || *maxIt > mMin + mScale * FullScale) {
+    // enlarge the quantization range: decode and re-pack the stored samples first
+    auto all = unpack();
+    all.insert(all.end(), values.begin(), values.end());
+    pack(all);
+    return;
+  }
+  mSamples.reserve(mSamples.size() + values.size());
+  for (const auto value : values) {
+    mSamples.emplace_back(quantize(value));
+  }
+}
+
+std::vector<float> PackedTimeSeries::unpack() const
+{
+  std::vector<float> values;
+  values.reserve(mSamples.size());
+  for (const auto sample : mSamples) {
+    values.emplace_back(mMin + mScale * sample);
+  }
+  return values;
+}
+
+size_t PackedTimeSeries::getIndex(double timeMS) const
+{
+  if (mSamples.empty() || mSamplingTimeMS <= 0 || timeMS <= mStartTimeMS) {
+    return 0;
+  }
+  const auto idx = static_cast<size_t>((timeMS - mStartTimeMS) / mSamplingTimeMS);
+  return std::min(idx, mSamples.size() - 1);
+}
+
+std::vector<float> PackedTimeSeries::getSlice(double startTimeMS, double endTimeMS) const
+{
+  std::vector<float> values;
+  if (mSamples.empty() || endTimeMS <= startTimeMS || endTimeMS <= mStartTimeMS || startTimeMS >= getEndTimeStampMS()) {
+    return values;
+  }
+  const size_t first = getIndex(startTimeMS);
+  const size_t last = getIndex(endTimeMS - mSamplingTimeMS * 0.5) + 1;
+  values.reserve(last - first);
+  for (size_t i = first; i < last; i++) {
+    values.emplace_back(getValue(i));
+  }
+  return values;
+}
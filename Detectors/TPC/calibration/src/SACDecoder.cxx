@@ -11,7 +11,9 @@
 
 #include <chrono>
 #include <cassert>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <string_view>
 #if (defined(WITH_OPENMP) || defined(_OPENMP))
 #include <omp.h>
@@ -24,6 +26,39 @@
 using HighResClock = std::chrono::high_resolution_clock;
 using namespace o2::tpc::sac;
 
+namespace
+{
+constexpr int32_t InvalidChannelRecord = std::numeric_limits<int32_t>::min();
+
+/// branchless SWAR decoding of one fixed size channel record: channel number, 6 upper case hex characters, '\n'
+/// \param record the 8 record characters as little endian word, as sent by the FE
+/// \return the sign extended 24 bit current value, or InvalidChannelRecord if the hex characters or the terminator are invalid
+inline int32_t decodeChannelRecord(const uint64_t record)
+{
+  constexpr uint64_t ones = 0x0001010101010100ull; ///< one in each of the 6 hex character bytes
+  const uint64_t chars = record & 0x00FFFFFFFFFFFF00ull;
+  // '0'-'9' -> 0-9, 'A'-'F' -> 10-15, using bit 6 to distinguish letters from digits
+  const uint64_t nibbles = ((chars & (ones * 0xF)) + ((chars >> 6) & ones) * 9) & (ones * 0xF);
+  // reconstruct the characters from the nibbles, only valid hex characters round-trip
+  const uint64_t overNine = ((nibbles + ones * 6) >> 4) & ones;
+  const uint64_t expected = nibbles + ones * '0' + overNine * ('A' - '0' - 10);
+  if ((expected != chars) || ((record >> 56) != uint64_t('\n'))) {
+    return InvalidChannelRecord;
+  }
+
+  uint32_t value = 0;
+  for (int i = 1; i <= 6; ++i) {
+    value = (value << 4) | uint32_t((nibbles >> (8 * i)) & 0xF);
+  }
+  int32_t valueSigned = value & 0x00FFFFFF;
+  // negative value?
+  if ((valueSigned >> 23) & 1) {
+    valueSigned |= 0xff000000;
+  }
+  return valueSigned;
+}
+} // anonymous namespace
+
 void DecodedData::setData(const size_t pos, uint32_t time, const DecodedDataFE& decdata, const int feid)
 {
   data[pos].time = time;
@@ -35,6 +70,23 @@ void DecodedData::setData(const size_t pos, uint32_t time, const DecodedDataFE&
   fes[pos].set(feid);
 }
 
+//______________________________________________________________________________
+void DecodedData::fillSoA(DecodedDataSoA& soa) const
+{
+  const auto nGood = getNGoodEntries();
+  soa.time.resize(nGood);
+  for (auto& stack : soa.currents) {
+    stack.resize(nGood);
+  }
+
+  for (size_t ientry = 0; ientry < nGood; ++ientry) {
+    soa.time[ientry] = data[ientry].time;
+    for (size_t stack = 0; stack < GEMSTACKS; ++stack) {
+      soa.currents[stack][ientry] = data[ientry].currents[stack];
+    }
+  }
+}
+
 //______________________________________________________________________________
 bool Decoder::process(const char* data, size_t size)
 {
@@ -87,6 +139,21 @@ bool Decoder::process(const char* data, size_t size)
   return isOK;
 }
 
+//______________________________________________________________________________
+bool Decoder::processBulk(const char* data, size_t size)
+{
+  if (size % sizeof(sac::packet)) {
+    LOGP(error, "Bulk payload size {} is not a multiple of the SAC packet size {}", size, sizeof(sac::packet));
+    return false;
+  }
+
+  bool isOK = true;
+  for (size_t pos = 0; pos < size; pos += sizeof(sac::packet)) {
+    isOK &= process(data + pos, sizeof(sac::packet));
+  }
+  return isOK;
+}
+
 int Decoder::decodeChannels(DecodedDataFE& sacs, size_t& carry, int feid)
 {
   const auto& data = mDataStrings[feid];
@@ -99,6 +166,17 @@ int Decoder::decodeChannels(DecodedDataFE& sacs, size_t& carry, int feid)
     }
     if (data[carry] >= '0' && data[carry] <= '7') {
       const uint32_t channel = data[carry] - '0';
+      // fast path: channel records have a fixed 8 character layout, decode the hex
+      // value and validate the terminator branchless on the full record word
+      uint64_t record;
+      std::memcpy(&record, data.data() + carry, sizeof(record));
+      if (const auto value = decodeChannelRecord(record); value != InvalidChannelRecord) {
+        sacs.currents[channel] = value;
+        carry += 8;
+        ++mNDecodedValuesFE[feid];
+        continue;
+      }
+      // slow path, only taken on corrupt records to emit the detailed warnings
       ++carry;
       uint32_t value = 0;
       for (int i = 0; i < 6; ++i) {
@@ -371,10 +449,12 @@ void Decoder::runDecoding()
     decode(feid);
   }
 
+  auto endTime = HighResClock::now();
+  auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(endTime - startTime);
+  mDecodingTime += elapsed_seconds.count();
+
   if (mDebugLevel & (uint32_t)DebugFlags::TimingInfo) {
-    auto endTime = HighResClock::now();
-    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(endTime - startTime);
-    LOGP(detail, "Time to decode all feids {} s, {} s per packet ({})", elapsed_seconds.count(), elapsed_seconds.count() / mCollectedDataPackets, mCollectedDataPackets);
+    LOGP(detail, "Time to decode all feids {} s, {} s per packet ({}), average rate {:.0f} values/s", elapsed_seconds.count(), elapsed_seconds.count() / mCollectedDataPackets, mCollectedDataPackets, getDecodingRate());
   }
 }
 
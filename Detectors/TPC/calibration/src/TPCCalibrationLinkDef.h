@@ -91,6 +91,7 @@
 #pragma link C++ class o2::tpc::CalibratorPadGainTracks + ;
 #pragma link C++ class o2::tpc::sac::DataPoint + ;
 #pragma link C++ class o2::tpc::sac::DecodedData + ;
+#pragma link C++ class o2::tpc::sac::DecodedDataSoA + ;
 #pragma link C++ class o2::tpc::sac::Decoder;
 #pragma link C++ struct o2::tpc::ParameterSAC + ;
 #pragma link C++ struct o2::tpc::SACDelta < float> + ;
@@ -113,6 +114,7 @@
 
 #pragma link C++ class o2::tpc::CalculatedEdx + ;
 #pragma link C++ class o2::tpc::TPCScaler + ;
+#pragma link C++ class o2::tpc::PackedTimeSeries + ;
 #pragma link C++ struct o2::tpc::TPCScalerWeights + ;
 #pragma link C++ class o2::tpc::TPCMShapeCorrection + ;
 #pragma link C++ struct o2::tpc::TPCMShape + ;
@@ -133,32 +133,107 @@ void TPCFastSpaceChargeCorrectionHelper::fillSpaceChargeCorrectionFromMap(TPCFas
 
     auto myThread = [&](int iThread) {
       for (int row = iThread; row < correction.getGeometry().getNumberOfRows(); row += mNthreads) {
+        fitSplineRowFromMap(correction, slice, row);
+      } // row
+    };  // thread
+
+    std::vector<std::thread> threads(mNthreads);
+
+    // run n threads
+    for (int i = 0; i < mNthreads; i++) {
+      threads[i] = std::thread(myThread, i);
+    }
+
+    // wait for the threads to finish
+    for (auto& th : threads) {
+      th.join();
+    }
+
+  } // slice
+
+  initInverse(correction, 0);
+}
+
+void TPCFastSpaceChargeCorrectionHelper::fitSplineRowFromMap(TPCFastSpaceChargeCorrection& correction, int slice, int row)
+{
+  /// approximate the spline of one slice row with the map data points
+
+  TPCFastSpaceChargeCorrection::SplineType& spline = correction.getSpline(slice, row);
+  Spline2DHelper<float> helper;
+  float* splineParameters = correction.getSplineData(slice, row);
+  const std::vector<o2::gpu::TPCFastSpaceChargeCorrectionMap::CorrectionPoint>& data = mCorrectionMap.getPoints(slice, row);
+  int nDataPoints = data.size();
+  if (nDataPoints >= 4) {
+    std::vector<double> pointSU(nDataPoints);
+    std::vector<double> pointSV(nDataPoints);
+    std::vector<double> pointCorr(3 * nDataPoints); // 3 dimensions
+    for (int i = 0; i < nDataPoints; ++i) {
+      double su, sv, dx, du, dv;
+      getSpaceChargeCorrection(correction, slice, row, data[i], su, sv, dx, du, dv);
+      pointSU[i] = su;
+      pointSV[i] = sv;
+      pointCorr[3 * i + 0] = dx;
+      pointCorr[3 * i + 1] = du;
+      pointCorr[3 * i + 2] = dv;
+    }
+    helper.approximateDataPoints(spline, splineParameters, 0., spline.getGridX1().getNumberOfKnots() - 1, 0., spline.getGridX2().getNumberOfKnots() - 1, &pointSU[0],
+                                 &pointSV[0], &pointCorr[0], nDataPoints);
+  } else {
+    for (int i = 0; i < spline.getNumberOfParameters(); i++) {
+      splineParameters[i] = 0.f;
+    }
+  }
+}
+
+int TPCFastSpaceChargeCorrectionHelper::updateSpaceChargeCorrectionFromMap(TPCFastSpaceChargeCorrection& correction, float threshold)
+{
+  /// incremental update: refit only the spline rows where the map data points
+  /// deviate from the stored correction by more than the threshold
 
-        TPCFastSpaceChargeCorrection::SplineType& spline = correction.getSpline(slice, row);
-        Spline2DHelper<float> helper;
-        float* splineParameters = correction.getSplineData(slice, row);
+  if (!mIsInitialized) {
+    initGeometry();
+  }
+
+  if (!mCorrectionMap.isInitialized()) {
+    return 0;
+  }
+
+  TStopwatch watch;
+
+  const int nSlices = correction.getGeometry().getNumberOfSlices();
+  const int nRows = correction.getGeometry().getNumberOfRows();
+
+  std::vector<char> rowChanged(nSlices * nRows, 0);
+
+  for (int slice = 0; slice < nSlices; slice++) {
+
+    auto myThread = [&](int iThread) {
+      for (int row = iThread; row < nRows; row += mNthreads) {
         const std::vector<o2::gpu::TPCFastSpaceChargeCorrectionMap::CorrectionPoint>& data = mCorrectionMap.getPoints(slice, row);
         int nDataPoints = data.size();
-        if (nDataPoints >= 4) {
-          std::vector<double> pointSU(nDataPoints);
-          std::vector<double> pointSV(nDataPoints);
-          std::vector<double> pointCorr(3 * nDataPoints); // 3 dimensions
-          for (int i = 0; i < nDataPoints; ++i) {
-            double su, sv, dx, du, dv;
-            getSpaceChargeCorrection(correction, slice, row, data[i], su, sv, dx, du, dv);
-            pointSU[i] = su;
-            pointSV[i] = sv;
-            pointCorr[3 * i + 0] = dx;
-            pointCorr[3 * i + 1] = du;
-            pointCorr[3 * i + 2] = dv;
-          }
-          helper.approximateDataPoints(spline, splineParameters, 0., spline.getGridX1().getNumberOfKnots() - 1, 0., spline.getGridX2().getNumberOfKnots() - 1, &pointSU[0],
-                                       &pointSV[0], &pointCorr[0], nDataPoints);
-        } else {
-          for (int i = 0; i < spline.getNumberOfParameters(); i++) {
-            splineParameters[i] = 0.f;
+        if (nDataPoints < 4) { // too few points for a refit, keep the stored correction
+          continue;
+        }
+        const TPCFastSpaceChargeCorrection::SplineType& spline = correction.getSpline(slice, row);
+        const float* splineParameters = correction.getSplineData(slice, row);
+        double maxDeviation = 0.;
+        for (int i = 0; i < nDataPoints; ++i) {
+          double su, sv, dx, du, dv;
+          getSpaceChargeCorrection(correction, slice, row, data[i], su, sv, dx, du, dv);
+          float s[3] = {0.f, 0.f, 0.f};
+          spline.interpolateU(splineParameters, su, sv, s);
+          double f[3] = {dx, du, dv};
+          for (int j = 0; j < 3; j++) {
+            double d = fabs(f[j] - s[j]);
+            if (maxDeviation < d) {
+              maxDeviation = d;
+            }
           }
         }
+        if (maxDeviation > threshold) {
+          fitSplineRowFromMap(correction, slice, row);
+          rowChanged[slice * nRows + row] = 1;
+        }
       } // row
     };  // thread
 
@@ -176,7 +251,76 @@ void TPCFastSpaceChargeCorrectionHelper::fillSpaceChargeCorrectionFromMap(TPCFas
 
   } // slice
 
-  initInverse(correction, 0);
+  std::vector<std::pair<int, int>> changedRows;
+  for (int slice = 0; slice < nSlices; slice++) {
+    for (int row = 0; row < nRows; row++) {
+      if (rowChanged[slice * nRows + row]) {
+        changedRows.emplace_back(slice, row);
+      }
+    }
+  }
+
+  if (changedRows.empty()) {
+    LOG(info) << "fast space charge correction helper: incremental update: no rows above the threshold";
+    return 0;
+  }
+
+  // update the max drift length and the inverse transformation only for the refitted rows
+
+  double tpcR2min = mGeo.getRowInfo(0).x - 1.;
+  tpcR2min = tpcR2min * tpcR2min;
+  double tpcR2max = mGeo.getRowInfo(mGeo.getNumberOfRows() - 1).x;
+  tpcR2max = tpcR2max / cos(2 * M_PI / mGeo.getNumberOfSlicesA() / 2) + 1.;
+  tpcR2max = tpcR2max * tpcR2max;
+
+  std::vector<o2::gpu::TPCFastSpaceChargeCorrection*> corrections{&correction};
+  std::vector<float> scaling{1.f};
+
+  auto myThread = [&](int iThread) {
+    for (int i = iThread; i < (int)changedRows.size(); i += mNthreads) {
+      int slice = changedRows[i].first;
+      int row = changedRows[i].second;
+      initMaxDriftLengthRow(correction, slice, row, tpcR2min, tpcR2max);
+      initInverseRow(corrections, scaling, slice, row, false);
+    } // row
+  };  // thread
+
+  std::vector<std::thread> threads(mNthreads);
+
+  // run n threads
+  for (int i = 0; i < mNthreads; i++) {
+    threads[i] = std::thread(myThread, i);
+  }
+
+  // wait for the threads to finish
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  // re-aggregate the per-slice max drift length of the touched slices
+  for (int slice = 0; slice < nSlices; slice++) {
+    bool touched = false;
+    for (int row = 0; row < nRows; row++) {
+      touched = touched || rowChanged[slice * nRows + row];
+    }
+    if (!touched) {
+      continue;
+    }
+    TPCFastSpaceChargeCorrection::SliceInfo& sliceInfo = correction.getSliceInfo(slice);
+    sliceInfo.vMax = 0.f;
+    for (int row = 0; row < nRows; row++) {
+      TPCFastSpaceChargeCorrection::RowActiveArea& area = correction.getSliceRowInfo(slice, row).activeArea;
+      if (sliceInfo.vMax < area.vMax) {
+        sliceInfo.vMax = area.vMax;
+      }
+    }
+  }
+
+  float duration = watch.RealTime();
+  LOGP(info, "fast space charge correction helper: incremental update of {} of {} spline rows took: {}s",
+       changedRows.size(), nSlices * nRows, duration);
+
+  return changedRows.size();
 }
 
 void TPCFastSpaceChargeCorrectionHelper::getSpaceChargeCorrection(const TPCFastSpaceChargeCorrection& correction, int slice, int row, o2::gpu::TPCFastSpaceChargeCorrectionMap::CorrectionPoint p,
@@ -589,62 +733,16 @@ void TPCFastSpaceChargeCorrectionHelper::initMaxDriftLength(o2::gpu::TPCFastSpac
   tpcR2max = tpcR2max / cos(2 * M_PI / mGeo.getNumberOfSlicesA() / 2) + 1.;
   tpcR2max = tpcR2max * tpcR2max;
 
-  ChebyshevFit1D chebFitter;
-
   for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
     if (prn) {
       LOG(info) << "init MaxDriftLength for slice " << slice;
     }
-    double vLength = (slice < mGeo.getNumberOfSlicesA()) ? mGeo.getTPCzLengthA() : mGeo.getTPCzLengthC();
     TPCFastSpaceChargeCorrection::SliceInfo& sliceInfo = correction.getSliceInfo(slice);
     sliceInfo.vMax = 0.f;
 
     for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
+      initMaxDriftLengthRow(correction, slice, row, tpcR2min, tpcR2max);
       TPCFastSpaceChargeCorrection::RowActiveArea& area = correction.getSliceRowInfo(slice, row).activeArea;
-      area.cvMax = 0;
-      area.vMax = 0;
-      area.cuMin = mGeo.convPadToU(row, 0.f);
-      area.cuMax = -area.cuMin;
-      chebFitter.reset(4, 0., mGeo.getRowInfo(row).maxPad);
-      double x = mGeo.getRowInfo(row).x;
-      for (int pad = 0; pad < mGeo.getRowInfo(row).maxPad; pad++) {
-        float u = mGeo.convPadToU(row, (float)pad);
-        float v0 = 0;
-        float v1 = 1.1 * vLength;
-        float vLastValid = -1;
-        float cvLastValid = -1;
-        while (v1 - v0 > 0.1) {
-          float v = 0.5 * (v0 + v1);
-          float dx, du, dv;
-          correction.getCorrection(slice, row, u, v, dx, du, dv);
-          double cx = x + dx;
-          double cu = u + du;
-          double cv = v + dv;
-          double r2 = cx * cx + cu * cu;
-          if (cv < 0) {
-            v0 = v;
-          } else if (cv <= vLength && r2 >= tpcR2min && r2 <= tpcR2max) {
-            v0 = v;
-            vLastValid = v;
-            cvLastValid = cv;
-          } else {
-            v1 = v;
-          }
-        }
-        if (vLastValid > 0.) {
-          chebFitter.addMeasurement(pad, vLastValid);
-        }
-        if (area.vMax < vLastValid) {
-          area.vMax = vLastValid;
-        }
-        if (area.cvMax < cvLastValid) {
-          area.cvMax = cvLastValid;
-        }
-      }
-      chebFitter.fit();
-      for (int i = 0; i < 5; i++) {
-        area.maxDriftLengthCheb[i] = chebFitter.getCoefficients()[i];
-      }
       if (sliceInfo.vMax < area.vMax) {
         sliceInfo.vMax = area.vMax;
       }
@@ -652,6 +750,61 @@ void TPCFastSpaceChargeCorrectionHelper::initMaxDriftLength(o2::gpu::TPCFastSpac
   }   // slice
 }
 
+void TPCFastSpaceChargeCorrectionHelper::initMaxDriftLengthRow(o2::gpu::TPCFastSpaceChargeCorrection& correction, int slice, int row, double tpcR2min, double tpcR2max)
+{
+  /// initialise max drift length of one slice row
+
+  double vLength = (slice < mGeo.getNumberOfSlicesA()) ? mGeo.getTPCzLengthA() : mGeo.getTPCzLengthC();
+
+  ChebyshevFit1D chebFitter;
+
+  TPCFastSpaceChargeCorrection::RowActiveArea& area = correction.getSliceRowInfo(slice, row).activeArea;
+  area.cvMax = 0;
+  area.vMax = 0;
+  area.cuMin = mGeo.convPadToU(row, 0.f);
+  area.cuMax = -area.cuMin;
+  chebFitter.reset(4, 0., mGeo.getRowInfo(row).maxPad);
+  double x = mGeo.getRowInfo(row).x;
+  for (int pad = 0; pad < mGeo.getRowInfo(row).maxPad; pad++) {
+    float u = mGeo.convPadToU(row, (float)pad);
+    float v0 = 0;
+    float v1 = 1.1 * vLength;
+    float vLastValid = -1;
+    float cvLastValid = -1;
+    while (v1 - v0 > 0.1) {
+      float v = 0.5 * (v0 + v1);
+      float dx, du, dv;
+      correction.getCorrection(slice, row, u, v, dx, du, dv);
+      double cx = x + dx;
+      double cu = u + du;
+      double cv = v + dv;
+      double r2 = cx * cx + cu * cu;
+      if (cv < 0) {
+        v0 = v;
+      } else if (cv <= vLength && r2 >= tpcR2min && r2 <= tpcR2max) {
+        v0 = v;
+        vLastValid = v;
+        cvLastValid = cv;
+      } else {
+        v1 = v;
+      }
+    }
+    if (vLastValid > 0.) {
+      chebFitter.addMeasurement(pad, vLastValid);
+    }
+    if (area.vMax < vLastValid) {
+      area.vMax = vLastValid;
+    }
+    if (area.cvMax < cvLastValid) {
+      area.cvMax = cvLastValid;
+    }
+  }
+  chebFitter.fit();
+  for (int i = 0; i < 5; i++) {
+    area.maxDriftLengthCheb[i] = chebFitter.getCoefficients()[i];
+  }
+}
+
 void TPCFastSpaceChargeCorrectionHelper::initInverse(o2::gpu::TPCFastSpaceChargeCorrection& correction, bool prn)
 {
   std::vector<o2::gpu::TPCFastSpaceChargeCorrection*> corr{&correction};
@@ -672,131 +825,12 @@ void TPCFastSpaceChargeCorrectionHelper::initInverse(std::vector<o2::gpu::TPCFas
   auto& correction = *(corrections.front());
   initMaxDriftLength(correction, prn);
 
-  double tpcR2min = mGeo.getRowInfo(0).x - 1.;
-  tpcR2min = tpcR2min * tpcR2min;
-  double tpcR2max = mGeo.getRowInfo(mGeo.getNumberOfRows() - 1).x;
-  tpcR2max = tpcR2max / cos(2 * M_PI / mGeo.getNumberOfSlicesA() / 2) + 1.;
-  tpcR2max = tpcR2max * tpcR2max;
-
   for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
     // LOG(info) << "inverse transform for slice " << slice ;
-    double vLength = (slice < mGeo.getNumberOfSlicesA()) ? mGeo.getTPCzLengthA() : mGeo.getTPCzLengthC();
 
     auto myThread = [&](int iThread) {
-      Spline2DHelper<float> helper;
-      std::vector<float> splineParameters;
-      ChebyshevFit1D chebFitterX, chebFitterU, chebFitterV;
-
       for (int row = iThread; row < mGeo.getNumberOfRows(); row += mNthreads) {
-        TPCFastSpaceChargeCorrection::SplineType spline = correction.getSpline(slice, row);
-        helper.setSpline(spline, 10, 10);
-        std::vector<double> dataPointCU, dataPointCV, dataPointF;
-
-        float u0, u1, v0, v1;
-        mGeo.convScaledUVtoUV(slice, row, 0., 0., u0, v0);
-        mGeo.convScaledUVtoUV(slice, row, 1., 1., u1, v1);
-
-        double x = mGeo.getRowInfo(row).x;
-        int nPointsU = (spline.getGridX1().getNumberOfKnots() - 1) * 10;
-        int nPointsV = (spline.getGridX2().getNumberOfKnots() - 1) * 10;
-
-        double stepU = (u1 - u0) / (nPointsU - 1);
-        double stepV = (v1 - v0) / (nPointsV - 1);
-
-        if (prn) {
-          LOG(info) << "u0 " << u0 << " u1 " << u1 << " v0 " << v0 << " v1 " << v1;
-        }
-        TPCFastSpaceChargeCorrection::RowActiveArea& area = correction.getSliceRowInfo(slice, row).activeArea;
-        area.cuMin = 1.e10;
-        area.cuMax = -1.e10;
-
-        /*
-        v1 = area.vMax;
-        stepV = (v1 - v0) / (nPointsU - 1);
-        if (stepV < 1.f) {
-          stepV = 1.f;
-        }
-        */
-
-        for (double u = u0; u < u1 + stepU; u += stepU) {
-          for (double v = v0; v < v1 + stepV; v += stepV) {
-            float dx, du, dv;
-            correction.getCorrection(slice, row, u, v, dx, du, dv);
-            dx *= scaling[0];
-            du *= scaling[0];
-            dv *= scaling[0];
-            // add remaining corrections
-            for (int i = 1; i < corrections.size(); ++i) {
-              float dxTmp, duTmp, dvTmp;
-              corrections[i]->getCorrection(slice, row, u, v, dxTmp, duTmp, dvTmp);
-              dx += dxTmp * scaling[i];
-              du += duTmp * scaling[i];
-              dv += dvTmp * scaling[i];
-            }
-            double cx = x + dx;
-            double cu = u + du;
-            double cv = v + dv;
-            if (cu < area.cuMin) {
-              area.cuMin = cu;
-            }
-            if (cu > area.cuMax) {
-              area.cuMax = cu;
-            }
-
-            dataPointCU.push_back(cu);
-            dataPointCV.push_back(cv);
-            dataPointF.push_back(dx);
-            dataPointF.push_back(du);
-            dataPointF.push_back(dv);
-
-            if (prn) {
-              LOG(info) << "measurement cu " << cu << " cv " << cv << " dx " << dx << " du " << du << " dv " << dv;
-            }
-          } // v
-        }   // u
-
-        if (area.cuMax - area.cuMin < 0.2) {
-          area.cuMax = .1;
-          area.cuMin = -.1;
-        }
-        if (area.cvMax < 0.1) {
-          area.cvMax = .1;
-        }
-        if (prn) {
-          LOG(info) << "slice " << slice << " row " << row << " max drift L = " << correction.getMaxDriftLength(slice, row)
-                    << " active area: cuMin " << area.cuMin << " cuMax " << area.cuMax << " vMax " << area.vMax << " cvMax " << area.cvMax;
-        }
-
-        TPCFastSpaceChargeCorrection::SliceRowInfo& info = correction.getSliceRowInfo(slice, row);
-        info.gridCorrU0 = area.cuMin;
-        info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (area.cuMax - area.cuMin);
-        info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / area.cvMax;
-
-        info.gridCorrU0 = u0;
-        info.gridCorrV0 = info.gridV0;
-        info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (u1 - info.gridCorrU0);
-        info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / (v1 - info.gridCorrV0);
-
-        int nDataPoints = dataPointCU.size();
-        for (int i = 0; i < nDataPoints; i++) {
-          dataPointCU[i] = (dataPointCU[i] - info.gridCorrU0) * info.scaleCorrUtoGrid;
-          dataPointCV[i] = (dataPointCV[i] - info.gridCorrV0) * info.scaleCorrVtoGrid;
-        }
-
-        splineParameters.resize(spline.getNumberOfParameters());
-
-        helper.approximateDataPoints(spline, splineParameters.data(), 0., spline.getGridX1().getUmax(),
-                                     0., spline.getGridX2().getUmax(),
-                                     dataPointCU.data(), dataPointCV.data(),
-                                     dataPointF.data(), dataPointCU.size());
-
-        float* splineX = correction.getSplineData(slice, row, 1);
-        float* splineUV = correction.getSplineData(slice, row, 2);
-        for (int i = 0; i < spline.getNumberOfParameters() / 3; i++) {
-          splineX[i] = splineParameters[3 * i + 0];
-          splineUV[2 * i + 0] = splineParameters[3 * i + 1];
-          splineUV[2 * i + 1] = splineParameters[3 * i + 2];
-        }
+        initInverseRow(corrections, scaling, slice, row, prn);
       } // row
     };  // thread
 
@@ -817,5 +851,125 @@ void TPCFastSpaceChargeCorrectionHelper::initInverse(std::vector<o2::gpu::TPCFas
   LOGP(info, "Inverse took: {}s", duration);
 }
 
+void TPCFastSpaceChargeCorrectionHelper::initInverseRow(std::vector<o2::gpu::TPCFastSpaceChargeCorrection*>& corrections, const std::vector<float>& scaling, int slice, int row, bool prn)
+{
+  /// initialise the inverse transformation of one slice row
+
+  auto& correction = *(corrections.front());
+
+  Spline2DHelper<float> helper;
+  std::vector<float> splineParameters;
+
+  TPCFastSpaceChargeCorrection::SplineType spline = correction.getSpline(slice, row);
+  helper.setSpline(spline, 10, 10);
+  std::vector<double> dataPointCU, dataPointCV, dataPointF;
+
+  float u0, u1, v0, v1;
+  mGeo.convScaledUVtoUV(slice, row, 0., 0., u0, v0);
+  mGeo.convScaledUVtoUV(slice, row, 1., 1., u1, v1);
+
+  double x = mGeo.getRowInfo(row).x;
+  int nPointsU = (spline.getGridX1().getNumberOfKnots() - 1) * 10;
+  int nPointsV = (spline.getGridX2().getNumberOfKnots() - 1) * 10;
+
+  double stepU = (u1 - u0) / (nPointsU - 1);
+  double stepV = (v1 - v0) / (nPointsV - 1);
+
+  if (prn) {
+    LOG(info) << "u0 " << u0 << " u1 " << u1 << " v0 " << v0 << " v1 " << v1;
+  }
+  TPCFastSpaceChargeCorrection::RowActiveArea& area = correction.getSliceRowInfo(slice, row).activeArea;
+  area.cuMin = 1.e10;
+  area.cuMax = -1.e10;
+
+  /*
+  v1 = area.vMax;
+  stepV = (v1 - v0) / (nPointsU - 1);
+  if (stepV < 1.f) {
+    stepV = 1.f;
+  }
+  */
+
+  for (double u = u0; u < u1 + stepU; u += stepU) {
+    for (double v = v0; v < v1 + stepV; v += stepV) {
+      float dx, du, dv;
+      correction.getCorrection(slice, row, u, v, dx, du, dv);
+      dx *= scaling[0];
+      du *= scaling[0];
+      dv *= scaling[0];
+      // add remaining corrections
+      for (int i = 1; i < corrections.size(); ++i) {
+        float dxTmp, duTmp, dvTmp;
+        corrections[i]->getCorrection(slice, row, u, v, dxTmp, duTmp, dvTmp);
+        dx += dxTmp * scaling[i];
+        du += duTmp * scaling[i];
+        dv += dvTmp * scaling[i];
+      }
+      double cx = x + dx;
+      double cu = u + du;
+      double cv = v + dv;
+      if (cu < area.cuMin) {
+        area.cuMin = cu;
+      }
+      if (cu > area.cuMax) {
+        area.cuMax = cu;
+      }
+
+      dataPointCU.push_back(cu);
+      dataPointCV.push_back(cv);
+      dataPointF.push_back(dx);
+      dataPointF.push_back(du);
+      dataPointF.push_back(dv);
+
+      if (prn) {
+        LOG(info) << "measurement cu " << cu << " cv " << cv << " dx " << dx << " du " << du << " dv " << dv;
+      }
+    } // v
+  }   // u
+
+  if (area.cuMax - area.cuMin < 0.2) {
+    area.cuMax = .1;
+    area.cuMin = -.1;
+  }
+  if (area.cvMax < 0.1) {
+    area.cvMax = .1;
+  }
+  if (prn) {
+    LOG(info) << "slice " << slice << " row " << row << " max drift L = " << correction.getMaxDriftLength(slice, row)
+              << " active area: cuMin " << area.cuMin << " cuMax " << area.cuMax << " vMax " << area.vMax << " cvMax " << area.cvMax;
+  }
+
+  TPCFastSpaceChargeCorrection::SliceRowInfo& info = correction.getSliceRowInfo(slice, row);
+  info.gridCorrU0 = area.cuMin;
+  info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (area.cuMax - area.cuMin);
+  info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / area.cvMax;
+
+  info.gridCorrU0 = u0;
+  info.gridCorrV0 = info.gridV0;
+  info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (u1 - info.gridCorrU0);
+  info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / (v1 - info.gridCorrV0);
+
+  int nDataPoints = dataPointCU.size();
+  for (int i = 0; i < nDataPoints; i++) {
+    dataPointCU[i] = (dataPointCU[i] - info.gridCorrU0) * info.scaleCorrUtoGrid;
+    dataPointCV[i] = (dataPointCV[i] - info.gridCorrV0) * info.scaleCorrVtoGrid;
+  }
+
+  splineParameters.resize(spline.getNumberOfParameters());
+
+  helper.approximateDataPoints(spline, splineParameters.data(), 0., spline.getGridX1().getUmax(),
+                               0., spline.getGridX2().getUmax(),
+                               dataPointCU.data(), dataPointCV.data(),
+                               dataPointF.data(), dataPointCU.size());
+
+  float* splineX = correction.getSplineData(slice, row, 1);
+  float* splineUV = correction.getSplineData(slice, row, 2);
+  for (int i = 0; i < spline.getNumberOfParameters() / 3; i++) {
+    splineX[i] = splineParameters[3 * i + 0];
+    splineUV[2 * i + 0] = splineParameters[3 * i + 1];
+    splineUV[2 * i + 1] = splineParameters[3 * i + 2];
+  }
+}
+
 } // namespace tpc
 } // namespace o2
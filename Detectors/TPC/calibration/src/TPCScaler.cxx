@@ -15,6 +15,7 @@
 /// \author Matthias Kleiner <mkleiner@ikf.uni-frankfurt.de>
 
 #include "TPCCalibration/TPCScaler.h"
+#include "TPCCalibration/PackedTimeSeries.h"
 #include <TFile.h>
 #include <TTree.h>
 #include "Framework/Logger.h"
@@ -176,3 +177,17 @@ void TPCScaler::clampScalers(float minThreshold, float maxThreshold, Side side)
   auto& scaler = (side == o2::tpc::Side::A) ? mScalerA : mScalerC;
   std::transform(std::begin(scaler), std::end(scaler), std::begin(scaler), [minThreshold, maxThreshold](auto val) { return std::clamp(val, minThreshold, maxThreshold); });
 }
+
+PackedTimeSeries TPCScaler::getPackedScalers(o2::tpc::Side side) const
+{
+  PackedTimeSeries packed(mTimeStampMS, mIntegrationTimeMS);
+  packed.pack((side == o2::tpc::Side::A) ? mScalerA : mScalerC);
+  return packed;
+}
+
+void TPCScaler::setScalersFromPacked(const PackedTimeSeries& packed, o2::tpc::Side side)
+{
+  mTimeStampMS = packed.getStartTimeStampMS();
+  mIntegrationTimeMS = packed.getSamplingTimeMS();
+  setScaler(packed.unpack(), side);
+}
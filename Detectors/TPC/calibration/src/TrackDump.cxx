@@ -13,6 +13,7 @@
 #include <vector>
 #include <filesystem>
 #include <fmt/format.h>
+#include "Compression.h"
 #include "GPUTPCGeometry.h"
 
 #include "DataFormatsTPC/Defs.h"
@@ -28,6 +29,11 @@ o2::gpu::CorrectionMapsHelper o2::tpc::TrackDump::ClusterNativeAdd::sCorrHelper{
 
 void TrackDump::filter(const gsl::span<const TrackTPC> tracks, ClusterNativeAccess const& clusterIndex, const gsl::span<const o2::tpc::TPCClRefElem> clRefs, const gsl::span<const o2::MCCompLabel> mcLabels)
 {
+  if (outputFormat == OutputFormat::Columnar) {
+    filterColumnar(tracks, clusterIndex, clRefs, mcLabels);
+    return;
+  }
+
   if (!mTreeDump && outputFileName.size()) {
     mTreeDump = std::make_unique<utils::TreeStreamRedirector>(outputFileName.data(), "recreate");
     const auto fspath = fs::path(outputFileName);
@@ -130,6 +136,124 @@ void TrackDump::filter(const gsl::span<const TrackTPC> tracks, ClusterNativeAcce
   }
 }
 
+void TrackDump::filterColumnar(const gsl::span<const TrackTPC> tracks, ClusterNativeAccess const& clusterIndex, const gsl::span<const o2::tpc::TPCClRefElem> clRefs, const gsl::span<const o2::MCCompLabel> mcLabels)
+{
+  if (!mTreeDump && outputFileName.size()) {
+    mTreeDump = std::make_unique<utils::TreeStreamRedirector>(outputFileName.data(), "recreate");
+    // the flat buffers compress well and fast with zstd
+    mTreeDump->GetFile()->SetCompressionSettings(ROOT::CompressionSettings(ROOT::kZSTD, compressionLevel));
+  }
+
+  if (!mTreeDump) {
+    return;
+  }
+
+  ColumnarChunk cols;
+  std::vector<o2::MCCompLabel> tpcTracksMCTruth;
+
+  for (const auto& track : tracks) {
+    const int nCl = track.getNClusterReferences();
+    cols.addTrack(track);
+    cols.trackFirstCluster.emplace_back(static_cast<uint32_t>(cols.clPad.size()));
+    cols.trackNClusters.emplace_back(static_cast<uint16_t>(nCl));
+
+    for (int j = nCl - 1; j >= 0; j--) {
+      uint8_t sector, padrow;
+      uint32_t clusterIndexInRow;
+      track.getClusterReference(clRefs, j, sector, padrow, clusterIndexInRow);
+      const auto& cl = clusterIndex.clusters[sector][padrow][clusterIndexInRow];
+      cols.addCluster(cl, sector, padrow);
+    }
+  }
+
+  if (writeMC) {
+    for (const auto& mcLabel : mcLabels) {
+      tpcTracksMCTruth.emplace_back(mcLabel);
+    }
+  }
+
+  // each column is written as an own branch, so single columns can be read back selectively;
+  // the entry number together with trackFirstCluster/trackNClusters serves as random access index
+  auto& tree = (*mTreeDump) << "tpcrecColumnar";
+  tree << "trackX=" << cols.trackX
+       << "trackAlpha=" << cols.trackAlpha
+       << "trackY=" << cols.trackY
+       << "trackZ=" << cols.trackZ
+       << "trackSnp=" << cols.trackSnp
+       << "trackTgl=" << cols.trackTgl
+       << "trackQ2Pt=" << cols.trackQ2Pt
+       << "trackTime0=" << cols.trackTime0
+       << "trackDEdxTot=" << cols.trackDEdxTot
+       << "trackDEdxMax=" << cols.trackDEdxMax
+       << "trackFirstCluster=" << cols.trackFirstCluster
+       << "trackNClusters=" << cols.trackNClusters
+       << "clPad=" << cols.clPad
+       << "clTime=" << cols.clTime
+       << "clSigmaPad=" << cols.clSigmaPad
+       << "clSigmaTime=" << cols.clSigmaTime
+       << "clQMax=" << cols.clQMax
+       << "clQTot=" << cols.clQTot
+       << "clFlags=" << cols.clFlags
+       << "clSector=" << cols.clSector
+       << "clPadrow=" << cols.clPadrow;
+  if (writeMC) {
+    tree << "TPCTracksMCTruth=" << tpcTracksMCTruth;
+  }
+  tree << "\n";
+}
+
+void TrackDump::ColumnarChunk::addTrack(const TrackTPC& track)
+{
+  trackX.emplace_back(track.getX());
+  trackAlpha.emplace_back(track.getAlpha());
+  trackY.emplace_back(track.getY());
+  trackZ.emplace_back(track.getZ());
+  trackSnp.emplace_back(track.getSnp());
+  trackTgl.emplace_back(track.getTgl());
+  trackQ2Pt.emplace_back(track.getQ2Pt());
+  trackTime0.emplace_back(track.getTime0());
+  trackDEdxTot.emplace_back(track.getdEdx().dEdxTotTPC);
+  trackDEdxMax.emplace_back(track.getdEdx().dEdxMaxTPC);
+}
+
+void TrackDump::ColumnarChunk::addCluster(const ClusterNative& cl, uint8_t sector, uint8_t padrow)
+{
+  clPad.emplace_back(cl.getPad());
+  clTime.emplace_back(cl.getTime());
+  clSigmaPad.emplace_back(cl.getSigmaPad());
+  clSigmaTime.emplace_back(cl.getSigmaTime());
+  clQMax.emplace_back(cl.qMax);
+  clQTot.emplace_back(cl.qTot);
+  clFlags.emplace_back(cl.getFlags());
+  clSector.emplace_back(sector);
+  clPadrow.emplace_back(padrow);
+}
+
+void TrackDump::ColumnarChunk::clear()
+{
+  trackX.clear();
+  trackAlpha.clear();
+  trackY.clear();
+  trackZ.clear();
+  trackSnp.clear();
+  trackTgl.clear();
+  trackQ2Pt.clear();
+  trackTime0.clear();
+  trackDEdxTot.clear();
+  trackDEdxMax.clear();
+  trackFirstCluster.clear();
+  trackNClusters.clear();
+  clPad.clear();
+  clTime.clear();
+  clSigmaPad.clear();
+  clSigmaTime.clear();
+  clQMax.clear();
+  clQTot.clear();
+  clFlags.clear();
+  clSector.clear();
+  clPadrow.clear();
+}
+
 void TrackDump::finalize()
 {
   if (mTreeDump) {
@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  bench_IDCFactorization.cxx
+/// \brief benchmark for the factorization of the IDCs and the calculation of the fourier coefficients
+///
+/// \author  Matthias Kleiner <mkleiner@ikf.uni-frankfurt.de>
+
+#include "benchmark/benchmark.h"
+#include "TPCCalibration/IDCFactorization.h"
+#include "TPCCalibration/IDCFourierTransform.h"
+#include "TPCBase/Mapper.h"
+#include "TRandom.h"
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+constexpr unsigned int TimeFrames = 10;         ///< number of aggregated TFs
+constexpr unsigned int TimeFramesDeltaIDC = 5;  ///< number of TFs per IDCDelta object
+constexpr unsigned int IntervalsPerTF = 11;     ///< number of integration intervals per TF
+
+o2::tpc::IDCFactorization getIDCFactorization()
+{
+  std::vector<uint32_t> crus(o2::tpc::CRU::MaxCRU);
+  std::iota(crus.begin(), crus.end(), 0);
+  o2::tpc::IDCFactorization idcFactorization{TimeFrames, TimeFramesDeltaIDC, crus};
+  gRandom->SetSeed(42);
+  for (const auto cru : crus) {
+    const o2::tpc::CRU cruTmp(cru);
+    const unsigned int nIDCs = o2::tpc::Mapper::PADSPERREGION[cruTmp.region()] * IntervalsPerTF;
+    for (unsigned int tf = 0; tf < TimeFrames; ++tf) {
+      std::vector<float> idcs(nIDCs);
+      for (auto& idc : idcs) {
+        idc = gRandom->Gaus(1, 0.1);
+      }
+      idcFactorization.setIDCs(std::move(idcs), cru, tf);
+    }
+  }
+  return idcFactorization;
+}
+
+o2::tpc::IDCOne get1DIDCs(const std::vector<unsigned int>& integrationIntervals)
+{
+  const unsigned int nIDCs = std::accumulate(integrationIntervals.begin(), integrationIntervals.end(), static_cast<unsigned int>(0));
+  o2::tpc::IDCOne idcsOut;
+  std::vector<float> idcs(nIDCs);
+  gRandom->SetSeed(42);
+  for (auto& val : idcs) {
+    val = gRandom->Gaus(0, 0.2);
+  }
+  idcsOut.mIDCOne = std::move(idcs);
+  return idcsOut;
+}
+
+} // namespace
+
+static void BM_calcIDCZero(benchmark::State& state)
+{
+  auto idcFactorization = getIDCFactorization();
+  for (auto _ : state) {
+    idcFactorization.calcIDCZero(false);
+  }
+}
+
+static void BM_calcIDCOne(benchmark::State& state)
+{
+  auto idcFactorization = getIDCFactorization();
+  idcFactorization.calcIDCZero(false);
+  for (auto _ : state) {
+    idcFactorization.calcIDCOne();
+  }
+}
+
+static void BM_calcIDCDelta(benchmark::State& state)
+{
+  auto idcFactorization = getIDCFactorization();
+  idcFactorization.calcIDCZero(false);
+  idcFactorization.calcIDCOne();
+  for (auto _ : state) {
+    idcFactorization.calcIDCDelta();
+  }
+}
+
+static void BM_fourierCoefficients(benchmark::State& state)
+{
+  using FtType = o2::tpc::IDCFourierTransform<o2::tpc::IDCFourierTransformBaseAggregator>;
+  const unsigned int rangeIDC = 200;
+  FtType::setFFT(static_cast<bool>(state.range(0)));
+  FtType idcFourierTransform{rangeIDC, rangeIDC + 2};
+  const std::vector<unsigned int> intervalsPerTF(TimeFrames, IntervalsPerTF);
+  idcFourierTransform.setIDCs(get1DIDCs(intervalsPerTF), intervalsPerTF);
+  idcFourierTransform.setIDCs(get1DIDCs(intervalsPerTF), intervalsPerTF);
+  for (auto _ : state) {
+    idcFourierTransform.calcFourierCoefficients(TimeFrames);
+  }
+}
+
+BENCHMARK(BM_calcIDCZero);
+BENCHMARK(BM_calcIDCOne);
+BENCHMARK(BM_calcIDCDelta);
+BENCHMARK(BM_fourierCoefficients)->Arg(0)->Arg(1); // 0: naive DFT, 1: FFTW3
+
+BENCHMARK_MAIN();
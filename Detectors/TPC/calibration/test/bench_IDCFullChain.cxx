@@ -0,0 +1,241 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  bench_IDCFullChain.cxx
+/// \brief full-chain benchmark of the IDC aggregation: synthetic IDC streams at
+///        configurable pad occupancy drive factorization, averaging/grouping and
+///        the fourier transform, reporting per-stage throughput and allocations
+
+#include "benchmark/benchmark.h"
+#include "TPCCalibration/IDCFactorization.h"
+#include "TPCCalibration/IDCAverageGroup.h"
+#include "TPCCalibration/IDCFourierTransform.h"
+#include "TPCBase/Mapper.h"
+#include "TRandom.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <vector>
+
+// Count every heap allocation, so that the benchmarks can report how many
+// allocations each stage costs per processed stream: on the aggregation
+// nodes allocator pressure is as interesting as raw throughput.
+static std::atomic<uint64_t> gAllocations{0};
+
+void* operator new(std::size_t size)
+{
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+
+constexpr unsigned int TimeFrames = 10;        ///< number of aggregated TFs
+constexpr unsigned int TimeFramesDeltaIDC = 5; ///< number of TFs per IDCDelta object
+constexpr unsigned int IntervalsPerTF = 11;    ///< number of integration intervals per TF
+constexpr unsigned int RangeIDC = 200;         ///< number of IDCs used for the fourier coefficients
+
+/// synthetic IDC stream for all CRUs and TFs: @occupancyPercent of the pads
+/// carry a signal, the IDCs of the others are zero as after zero suppression
+std::vector<std::vector<std::vector<float>>> makeSyntheticStream(const int occupancyPercent)
+{
+  gRandom->SetSeed(42);
+  std::vector<std::vector<std::vector<float>>> stream(o2::tpc::CRU::MaxCRU);
+  for (unsigned int cru = 0; cru < o2::tpc::CRU::MaxCRU; ++cru) {
+    const o2::tpc::CRU cruTmp(cru);
+    const unsigned int nIDCs = o2::tpc::Mapper::PADSPERREGION[cruTmp.region()] * IntervalsPerTF;
+    stream[cru].resize(TimeFrames);
+    for (unsigned int tf = 0; tf < TimeFrames; ++tf) {
+      auto& idcs = stream[cru][tf];
+      idcs.resize(nIDCs);
+      for (auto& idc : idcs) {
+        idc = (gRandom->Integer(100) < (unsigned int)occupancyPercent) ? gRandom->Gaus(1, 0.1) : 0.f;
+      }
+    }
+  }
+  return stream;
+}
+
+size_t streamSizeBytes(const std::vector<std::vector<std::vector<float>>>& stream)
+{
+  size_t bytes = 0;
+  for (const auto& cru : stream) {
+    for (const auto& tf : cru) {
+      bytes += tf.size() * sizeof(float);
+    }
+  }
+  return bytes;
+}
+
+o2::tpc::IDCFactorization makeFactorization(const std::vector<std::vector<std::vector<float>>>& stream)
+{
+  std::vector<uint32_t> crus(o2::tpc::CRU::MaxCRU);
+  std::iota(crus.begin(), crus.end(), 0);
+  o2::tpc::IDCFactorization idcFactorization{TimeFrames, TimeFramesDeltaIDC, crus};
+  for (const auto cru : crus) {
+    for (unsigned int tf = 0; tf < TimeFrames; ++tf) {
+      auto idcs = stream[cru][tf];
+      idcFactorization.setIDCs(std::move(idcs), cru, tf);
+    }
+  }
+  return idcFactorization;
+}
+
+void reportAllocations(benchmark::State& state, const uint64_t allocationsBefore)
+{
+  state.counters["allocs/iter"] = benchmark::Counter((double)(gAllocations.load() - allocationsBefore) / state.iterations());
+}
+
+} // namespace
+
+/// stage 1: ingesting the IDC stream into the factorization object
+static void BM_chainIngest(benchmark::State& state)
+{
+  const auto stream = makeSyntheticStream(state.range(0));
+  const auto allocationsBefore = gAllocations.load();
+  for (auto _ : state) {
+    auto idcFactorization = makeFactorization(stream);
+    benchmark::DoNotOptimize(idcFactorization);
+  }
+  state.SetBytesProcessed(state.iterations() * streamSizeBytes(stream));
+  reportAllocations(state, allocationsBefore);
+}
+
+/// stage 2: factorization into IDC0, IDC1 and IDCDelta
+static void BM_chainFactorize(benchmark::State& state)
+{
+  const auto stream = makeSyntheticStream(state.range(0));
+  auto idcFactorization = makeFactorization(stream);
+  const auto allocationsBefore = gAllocations.load();
+  for (auto _ : state) {
+    idcFactorization.calcIDCZero(false);
+    idcFactorization.calcIDCOne();
+    idcFactorization.calcIDCDelta();
+  }
+  state.SetBytesProcessed(state.iterations() * streamSizeBytes(stream));
+  reportAllocations(state, allocationsBefore);
+}
+
+/// stage 3: averaging and grouping of the IDCDelta
+static void BM_chainGroup(benchmark::State& state)
+{
+  const auto stream = makeSyntheticStream(state.range(0));
+  auto idcFactorization = makeFactorization(stream);
+  idcFactorization.calcIDCZero(false);
+  idcFactorization.calcIDCOne();
+  idcFactorization.calcIDCDelta();
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grPad{};
+  std::fill(grPad.begin(), grPad.end(), 4);
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grRow{};
+  std::fill(grRow.begin(), grRow.end(), 4);
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grRowThr{};
+  std::fill(grRowThr.begin(), grRowThr.end(), 2);
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grPadThr{};
+  std::fill(grPadThr.begin(), grPadThr.end(), 2);
+  const auto allocationsBefore = gAllocations.load();
+  for (auto _ : state) {
+    for (unsigned int chunk = 0; chunk < idcFactorization.getNChunks(o2::tpc::Side::A); ++chunk) {
+      for (const auto side : {o2::tpc::Side::A, o2::tpc::Side::C}) {
+        o2::tpc::IDCAverageGroup<o2::tpc::IDCAverageGroupTPC> idcaverage(grPad, grRow, grRowThr, grPadThr);
+        idcaverage.setIDCs(idcFactorization.getIDCDeltaUncompressed(chunk, side), side);
+        idcaverage.processIDCs();
+        benchmark::DoNotOptimize(idcaverage);
+      }
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * streamSizeBytes(stream));
+  reportAllocations(state, allocationsBefore);
+}
+
+/// stage 4: fourier coefficients from the 1D IDCs
+static void BM_chainFourier(benchmark::State& state)
+{
+  using FtType = o2::tpc::IDCFourierTransform<o2::tpc::IDCFourierTransformBaseAggregator>;
+  const auto stream = makeSyntheticStream(state.range(0));
+  auto idcFactorization = makeFactorization(stream);
+  idcFactorization.calcIDCZero(false);
+  idcFactorization.calcIDCOne();
+  const std::vector<unsigned int> intervalsPerTF(TimeFrames, IntervalsPerTF);
+  FtType idcFourierTransform{RangeIDC, RangeIDC + 2};
+  idcFourierTransform.setIDCs(idcFactorization.getIDCOne(o2::tpc::Side::A), intervalsPerTF);
+  idcFourierTransform.setIDCs(idcFactorization.getIDCOne(o2::tpc::Side::A), intervalsPerTF);
+  const auto allocationsBefore = gAllocations.load();
+  for (auto _ : state) {
+    idcFourierTransform.calcFourierCoefficients(TimeFrames);
+  }
+  state.SetBytesProcessed(state.iterations() * streamSizeBytes(stream));
+  reportAllocations(state, allocationsBefore);
+}
+
+/// the full chain as the aggregation node runs it per aggregation interval
+static void BM_fullChain(benchmark::State& state)
+{
+  using FtType = o2::tpc::IDCFourierTransform<o2::tpc::IDCFourierTransformBaseAggregator>;
+  const auto stream = makeSyntheticStream(state.range(0));
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grPad{};
+  std::fill(grPad.begin(), grPad.end(), 4);
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grRow{};
+  std::fill(grRow.begin(), grRow.end(), 4);
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grRowThr{};
+  std::fill(grRowThr.begin(), grRowThr.end(), 2);
+  std::array<unsigned char, o2::tpc::Mapper::NREGIONS> grPadThr{};
+  std::fill(grPadThr.begin(), grPadThr.end(), 2);
+  const std::vector<unsigned int> intervalsPerTF(TimeFrames, IntervalsPerTF);
+  const auto allocationsBefore = gAllocations.load();
+  for (auto _ : state) {
+    auto idcFactorization = makeFactorization(stream);
+    idcFactorization.calcIDCZero(false);
+    idcFactorization.calcIDCOne();
+    idcFactorization.calcIDCDelta();
+    for (unsigned int chunk = 0; chunk < idcFactorization.getNChunks(o2::tpc::Side::A); ++chunk) {
+      for (const auto side : {o2::tpc::Side::A, o2::tpc::Side::C}) {
+        o2::tpc::IDCAverageGroup<o2::tpc::IDCAverageGroupTPC> idcaverage(grPad, grRow, grRowThr, grPadThr);
+        idcaverage.setIDCs(idcFactorization.getIDCDeltaUncompressed(chunk, side), side);
+        idcaverage.processIDCs();
+        benchmark::DoNotOptimize(idcaverage);
+      }
+    }
+    FtType idcFourierTransform{RangeIDC, RangeIDC + 2};
+    idcFourierTransform.setIDCs(idcFactorization.getIDCOne(o2::tpc::Side::A), intervalsPerTF);
+    idcFourierTransform.setIDCs(idcFactorization.getIDCOne(o2::tpc::Side::A), intervalsPerTF);
+    idcFourierTransform.calcFourierCoefficients(TimeFrames);
+  }
+  state.SetBytesProcessed(state.iterations() * streamSizeBytes(stream));
+  reportAllocations(state, allocationsBefore);
+}
+
+// the argument is the pad occupancy in percent
+BENCHMARK(BM_chainIngest)->Arg(10)->Arg(50)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_chainFactorize)->Arg(10)->Arg(50)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_chainGroup)->Arg(10)->Arg(50)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_chainFourier)->Arg(10)->Arg(50)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fullChain)->Arg(10)->Arg(50)->Arg(100)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
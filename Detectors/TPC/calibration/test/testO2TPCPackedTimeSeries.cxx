@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  testO2TPCPackedTimeSeries.cxx
+/// \brief this task tests the quantized packing of time series and the slice decoding
+///
+/// \author  Matthias Kleiner <mkleiner@ikf.uni-frankfurt.de>
+
+#define BOOST_TEST_MODULE Test TPC O2TPCPackedTimeSeries class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCCalibration/PackedTimeSeries.h"
+#include "TPCCalibration/TPCScaler.h"
+#include "TRandom.h"
+#include <cmath>
+
+namespace o2::tpc
+{
+
+BOOST_AUTO_TEST_CASE(PackedTimeSeries_test)
+{
+  const int nSamples = 10000;
+  const double startTimeMS = 1234567.;
+  const float samplingTimeMS = 1.f;
+  std::vector<float> values(nSamples);
+  for (auto& value : values) {
+    value = gRandom->Uniform(0.5f, 3.5f);
+  }
+
+  PackedTimeSeries packed(startTimeMS, samplingTimeMS);
+  packed.pack(values);
+  BOOST_CHECK_EQUAL(packed.getNValues(), nSamples);
+
+  // the quantization error is bounded by half the quantization step
+  const float tolerance = packed.getQuantizationStep();
+  const auto decoded = packed.unpack();
+  for (int i = 0; i < nSamples; ++i) {
+    BOOST_CHECK_SMALL(decoded[i] - values[i], tolerance);
+  }
+
+  // decoding a window returns the same values as the full decoding
+  const double sliceStartMS = startTimeMS + 100 * samplingTimeMS;
+  const auto slice = packed.getSlice(sliceStartMS, sliceStartMS + 50 * samplingTimeMS);
+  BOOST_REQUIRE_EQUAL(slice.size(), 50);
+  for (int i = 0; i < 50; ++i) {
+    BOOST_CHECK_EQUAL(slice[i], decoded[100 + i]);
+  }
+
+  // appending values outside of the quantization range triggers the re-quantization
+  std::vector<float> tail(100, 10.f);
+  packed.append(tail);
+  BOOST_CHECK_EQUAL(packed.getNValues(), nSamples + tail.size());
+  BOOST_CHECK_SMALL(packed.getValue(nSamples) - 10.f, packed.getQuantizationStep());
+  BOOST_CHECK_SMALL(packed.getValue(0) - values[0], packed.getQuantizationStep());
+
+  // round trip via the TPC scaler
+  TPCScaler scaler;
+  scaler.setStartTimeStampMS(startTimeMS);
+  scaler.setIntegrationTimeMS(samplingTimeMS);
+  scaler.setScaler(values, Side::A);
+  TPCScaler scalerBack;
+  scalerBack.setScalersFromPacked(scaler.getPackedScalers(Side::A), Side::A);
+  BOOST_CHECK_EQUAL(scalerBack.getNValues(Side::A), nSamples);
+  BOOST_CHECK_EQUAL(scalerBack.getStartTimeStampMS(), startTimeMS);
+  for (int i = 0; i < nSamples; ++i) {
+    BOOST_CHECK_SMALL(scalerBack.getScalers(i, Side::A) - values[i], tolerance);
+  }
+}
+
+} // namespace o2::tpc
@@ -0,0 +1,110 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DigitizerPool.h
+/// \brief Definition of the per-sector parallel mode of the TPC digitizer
+/// \author Andi Mathis, TU München, andreas.mathis@ph.tum.de
+
+#ifndef ALICEO2_TPC_DigitizerPool_H_
+#define ALICEO2_TPC_DigitizerPool_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TPCSimulation/Digitizer.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+/// \class DigitizerPool
+/// Per-sector parallel mode of the TPC digitizer.
+/// One Digitizer with an independent DigitContainer arena is kept per sector and the
+/// sectors are processed by a pool of persistent worker threads. At flush time each
+/// worker fills the output of its own arena, the per-sector outputs are merged in
+/// sector order afterwards. The digitization helpers (GEMAmplification,
+/// ElectronTransport, SAMPAProcessing) are thread_local, so every worker owns its
+/// own random generators and the common mode calculation only touches the arena of
+/// its own sector.
+
+class DigitizerPool
+{
+ public:
+  DigitizerPool() = default;
+
+  /// Destructor, stops the worker threads
+  ~DigitizerPool();
+
+  DigitizerPool(const DigitizerPool&) = delete;
+  DigitizerPool& operator=(const DigitizerPool&) = delete;
+
+  /// Create the per-sector digitizers and start the worker threads
+  /// \param sectors sectors to be digitized
+  /// \param nThreads number of worker threads
+  void init(const std::vector<Sector>& sectors, int nThreads);
+
+  /// Access the digitizer of one sector, e.g. for sector-specific configuration
+  /// \param sector sector, must be one of the sectors passed to init()
+  Digitizer& getDigitizer(const Sector& sector);
+
+  /// \return number of configured sectors
+  size_t getNSectors() const { return mSectors.size(); }
+
+  /// Settings forwarded to all per-sector digitizers
+  void setContinuousReadout(bool isContinuous);
+  void setOutputDigitTimeOffset(double offset);
+  void setStartTime(double time);
+  void setEventTime(double time);
+  void setVDrift(float v);
+  void setTDriftOffset(float t);
+
+  /// Process the hits of all configured sectors in parallel
+  /// \param hits hit containers, one per sector passed to init(), entries may be nullptr
+  /// \param eventID ID of the event to be processed
+  /// \param sourceID ID of the source to be processed
+  void process(const std::vector<const std::vector<o2::tpc::HitGroup>*>& hits, const int eventID, const int sourceID = 0);
+
+  /// Flush all sectors in parallel into per-sector output arenas and merge them in sector order
+  /// \param digits Container for the digits
+  /// \param labels Container for the MC labels
+  /// \param commonModeOutput Output container for the common mode
+  /// \param finalFlush Flag whether the whole container is dumped
+  void flush(std::vector<o2::tpc::Digit>& digits,
+             o2::dataformats::MCTruthContainer<o2::MCCompLabel>& labels,
+             std::vector<o2::tpc::CommonMode>& commonModeOutput, bool finalFlush = false);
+
+ private:
+  /// run one job per sector on the worker threads and wait for completion
+  void runParallel(std::function<void(size_t)> job);
+
+  std::vector<Sector> mSectors{};                      ///< sectors to be digitized
+  std::vector<std::unique_ptr<Digitizer>> mDigitizers{}; ///< one digitizer with an own DigitContainer arena per sector
+  std::vector<std::thread> mWorkers{};                 ///< persistent worker threads
+
+  std::mutex mMutex{};                    ///< protects the job state below
+  std::condition_variable mCondVar{};     ///< signals the workers that jobs are available
+  std::condition_variable mCondVarDone{}; ///< signals the caller that all jobs are done
+  std::function<void(size_t)> mJob{};     ///< current job, called with the sector index
+  size_t mNextJob = 0;                ///< next job index to be picked up by a worker
+  size_t mNJobs = 0;                  ///< number of jobs of the current batch
+  size_t mJobsDone = 0;               ///< number of finished jobs of the current batch
+  bool mShutdown = false;             ///< flag to stop the worker threads
+};
+
+} // namespace tpc
+} // namespace o2
+
+#endif // ALICEO2_TPC_DigitizerPool_H_
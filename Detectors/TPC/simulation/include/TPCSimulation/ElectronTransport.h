@@ -35,9 +35,11 @@ namespace tpc
 class ElectronTransport
 {
  public:
+  /// The instance is thread_local, so each thread of a per-sector parallel
+  /// digitization owns its own random generators
   static ElectronTransport& instance()
   {
-    static ElectronTransport electronTransport;
+    static thread_local ElectronTransport electronTransport;
     return electronTransport;
   }
 
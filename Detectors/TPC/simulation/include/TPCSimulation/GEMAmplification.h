@@ -37,9 +37,11 @@ class GEMAmplification
 {
  public:
   /// Default constructor
+  /// The instance is thread_local, so each thread of a per-sector parallel
+  /// digitization owns its own random generators
   static GEMAmplification& instance()
   {
-    static GEMAmplification gemAmplification;
+    static thread_local GEMAmplification gemAmplification;
     return gemAmplification;
   }
 
@@ -40,9 +40,11 @@ namespace tpc
 class SAMPAProcessing
 {
  public:
+  /// The instance is thread_local, so each thread of a per-sector parallel
+  /// digitization owns its own random generators
   static SAMPAProcessing& instance()
   {
-    static SAMPAProcessing sampaProcessing;
+    static thread_local SAMPAProcessing sampaProcessing;
     return sampaProcessing;
   }
   /// Destructor
@@ -63,7 +63,7 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   const int nShapedPoints = eleParam.NShapedPoints;
   const auto amplificationMode = gemParam.AmplMode;
-  static std::vector<float> signalArray;
+  static thread_local std::vector<float> signalArray; // thread_local to allow for per-sector parallel processing
   signalArray.resize(nShapedPoints);
 
   /// Reserve space in the digit container for the current event
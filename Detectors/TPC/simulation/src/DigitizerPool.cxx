@@ -0,0 +1,202 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DigitizerPool.cxx
+/// \brief Implementation of the per-sector parallel mode of the TPC digitizer
+
+#include "TPCSimulation/DigitizerPool.h"
+#include "TPCSimulation/ElectronTransport.h"
+#include "TPCSimulation/GEMAmplification.h"
+#include "TPCSimulation/SAMPAProcessing.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fairlogger/Logger.h>
+
+using namespace o2::tpc;
+
+DigitizerPool::~DigitizerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mShutdown = true;
+  }
+  mCondVar.notify_all();
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+}
+
+void DigitizerPool::init(const std::vector<Sector>& sectors, int nThreads)
+{
+  mSectors = sectors;
+  mDigitizers.clear();
+  for (const auto& sector : mSectors) {
+    auto& digitizer = mDigitizers.emplace_back(std::make_unique<Digitizer>());
+    digitizer->setSector(sector);
+  }
+
+  // initialize once on the calling thread, so the calibration objects are loaded
+  // from the CDB before the worker threads start to use them
+  if (!mDigitizers.empty()) {
+    mDigitizers.front()->init();
+  }
+
+  if (nThreads < 1) {
+    nThreads = 1;
+  }
+  const size_t nWorkers = std::min<size_t>(nThreads, mSectors.size());
+  LOGP(info, "TPC: digitizing {} sectors with {} worker threads", mSectors.size(), nWorkers);
+
+  for (size_t iWorker = mWorkers.size(); iWorker < nWorkers; ++iWorker) {
+    mWorkers.emplace_back([this]() {
+      {
+        // construct the thread_local helpers one worker at a time, their setup
+        // (e.g. the polya cache file of the GEM amplification) is not thread safe
+        static std::mutex initMutex;
+        std::lock_guard<std::mutex> lock(initMutex);
+        GEMAmplification::instance();
+        ElectronTransport::instance();
+        SAMPAProcessing::instance();
+      }
+      while (true) {
+        size_t index = 0;
+        {
+          std::unique_lock<std::mutex> lock(mMutex);
+          mCondVar.wait(lock, [this] { return mShutdown || mNextJob < mNJobs; });
+          if (mShutdown) {
+            return;
+          }
+          index = mNextJob++;
+        }
+        mJob(index);
+        {
+          std::lock_guard<std::mutex> lock(mMutex);
+          if (++mJobsDone == mNJobs) {
+            mCondVarDone.notify_one();
+          }
+        }
+      }
+    });
+  }
+}
+
+Digitizer& DigitizerPool::getDigitizer(const Sector& sector)
+{
+  for (size_t i = 0; i < mSectors.size(); ++i) {
+    if (mSectors[i] == sector) {
+      return *mDigitizers[i];
+    }
+  }
+  throw std::runtime_error("DigitizerPool: sector was not configured in init()");
+}
+
+void DigitizerPool::setContinuousReadout(bool isContinuous)
+{
+  for (auto& digitizer : mDigitizers) {
+    digitizer->setContinuousReadout(isContinuous);
+  }
+}
+
+void DigitizerPool::setOutputDigitTimeOffset(double offset)
+{
+  for (auto& digitizer : mDigitizers) {
+    digitizer->setOutputDigitTimeOffset(offset);
+  }
+}
+
+void DigitizerPool::setStartTime(double time)
+{
+  for (auto& digitizer : mDigitizers) {
+    digitizer->setStartTime(time);
+  }
+}
+
+void DigitizerPool::setEventTime(double time)
+{
+  for (auto& digitizer : mDigitizers) {
+    digitizer->setEventTime(time);
+  }
+}
+
+void DigitizerPool::setVDrift(float v)
+{
+  for (auto& digitizer : mDigitizers) {
+    digitizer->setVDrift(v);
+  }
+}
+
+void DigitizerPool::setTDriftOffset(float t)
+{
+  for (auto& digitizer : mDigitizers) {
+    digitizer->setTDriftOffset(t);
+  }
+}
+
+void DigitizerPool::process(const std::vector<const std::vector<o2::tpc::HitGroup>*>& hits, const int eventID, const int sourceID)
+{
+  if (hits.size() != mDigitizers.size()) {
+    LOGP(error, "TPC: number of hit containers ({}) does not match the number of configured sectors ({})", hits.size(), mDigitizers.size());
+    return;
+  }
+
+  runParallel([&](size_t i) {
+    if (hits[i]) {
+      mDigitizers[i]->init(); // update the parameters of the thread_local helpers
+      mDigitizers[i]->process(*hits[i], eventID, sourceID);
+    }
+  });
+}
+
+void DigitizerPool::flush(std::vector<o2::tpc::Digit>& digits,
+                          o2::dataformats::MCTruthContainer<o2::MCCompLabel>& labels,
+                          std::vector<o2::tpc::CommonMode>& commonModeOutput, bool finalFlush)
+{
+  // independent output arenas per sector, merged in sector order below
+  std::vector<std::vector<Digit>> digitsPerSector(mSectors.size());
+  std::vector<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> labelsPerSector(mSectors.size());
+  std::vector<std::vector<CommonMode>> commonModePerSector(mSectors.size());
+
+  runParallel([&](size_t i) {
+    mDigitizers[i]->init(); // update the parameters of the thread_local helpers
+    mDigitizers[i]->flush(digitsPerSector[i], labelsPerSector[i], commonModePerSector[i], finalFlush);
+  });
+
+  for (size_t i = 0; i < mSectors.size(); ++i) {
+    digits.insert(digits.end(), digitsPerSector[i].begin(), digitsPerSector[i].end());
+    labels.mergeAtBack(labelsPerSector[i]);
+    commonModeOutput.insert(commonModeOutput.end(), commonModePerSector[i].begin(), commonModePerSector[i].end());
+  }
+}
+
+void DigitizerPool::runParallel(std::function<void(size_t)> job)
+{
+  if (mWorkers.empty() || mSectors.size() == 1) {
+    for (size_t i = 0; i < mSectors.size(); ++i) {
+      job(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mJob = std::move(job);
+    mNextJob = 0;
+    mJobsDone = 0;
+    mNJobs = mSectors.size();
+  }
+  mCondVar.notify_all();
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  mCondVarDone.wait(lock, [this] { return mJobsDone == mNJobs; });
+  mNJobs = 0;
+}
@@ -18,6 +18,7 @@
 #include "DataFormatsTPC/CompressedClusters.h"
 #include "DataFormatsTPC/ZeroSuppression.h"
 #include "Framework/ConfigParamRegistry.h"
+#include "Framework/Monitoring.h"
 #include "Framework/CCDBParamSpec.h"
 #include "Headers/DataHeader.h"
 #include "TPCReconstruction/TPCFastTransformHelperO2.h"
@@ -292,6 +293,14 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
 
   auto iosize = mCTFCoder.encode(buffer, clusters, clustersFiltered, trigComp, mSelIR ? &rejectHits : nullptr, mSelIR ? &rejectTracks : nullptr, mSelIR ? &rejectTrackHits : nullptr, mSelIR ? &rejectTrackHitsReduced : nullptr);
   pc.outputs().snapshot({"ctfrep", 0}, iosize);
+  if (mCTFCoder.getReportColumnSizes()) {
+    // emit per-column sizes as DPL metrics, complementing the integral ctfrep accounting
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    const auto& stats = mCTFCoder.getColumnStats();
+    for (int i = 0; i < stats.getNColumns(); i++) {
+      monitoring.send(o2::monitoring::Metric{static_cast<uint64_t>(stats.sizeOut[i]), fmt::format("ctf_column_size_TPC_{}", i)});
+    }
+  }
   mTimer.Stop();
   if (mSelIR) {
     mCTFCoder.getIRFramesSelector().clear();
@@ -332,6 +341,7 @@ DataProcessorSpec getEntropyEncoderSpec(bool inputFromFile, bool selIR)
             {"irframe-clusters-maxeta", VariantType::Float, 1.5f, {"Max eta for non-assigned clusters"}},
             {"irframe-clusters-maxz", VariantType::Float, 25.f, {"Max z for non assigned clusters (combined with maxeta)"}},
             {"mem-factor", VariantType::Float, 1.f, {"Memory allocation margin factor"}},
+            {"ctf-columns-report", VariantType::Bool, false, {"report per-column CTF sizes and emit them as metrics"}},
             {"nThreads-tpc-encoder", VariantType::UInt32, 1u, {"number of threads to use for decoding"}},
             {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}}};
 }
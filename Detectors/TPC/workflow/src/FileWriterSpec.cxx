@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <gsl/span>
 #include "fmt/format.h"
 
 #include "TTree.h"
@@ -154,9 +155,10 @@ class FileWriterDevice : public Task
       if (dataStore.received.test(sector)) {
         LOGP(fatal, "data for sector {} and TF {} already received", sector, mPresentTF);
       }
-      auto data = pc.inputs().get<std::vector<T>>(inputRef);
+      // attach to the flat shared memory payload instead of deserializing it into a temporary vector
+      auto data = pc.inputs().get<gsl::span<T>>(inputRef);
       // LOGP(info, "Received data for sector {} with {} entries in TF {}, orbit {}", sector, data.size(), mPresentTF, mFirstTForbit);
-      dataStore.data[sector] = data;
+      dataStore.data[sector].assign(data.begin(), data.end());
       dataStore.received.set(sector);
       dataStore.firstOrbit = mFirstTForbit;
     }
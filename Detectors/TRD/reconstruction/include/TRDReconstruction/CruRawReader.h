@@ -100,6 +100,10 @@ class CruRawReader
   // reset the event storage and the counters
   void reset();
 
+  // absorb the decoded data, statistics and counters of another reader instance
+  // (used to combine the output of parallel decoders before buildDPLOutputs is called)
+  void mergeOutputFrom(CruRawReader& other);
+
   // the parsing starts here, payload from all available RDHs is copied into mHBFPayload and afterwards processHalfCRU() is called
   // returns the total number of bytes read, including RDH header
   int processHBFs();
@@ -47,11 +47,16 @@ class DataReaderTask : public Task
                         // we pull the data from the vectors build message and pass on.
                         // they will internally produce a vector of digits and a vector tracklets and associated indexing.
 
+  std::vector<CruRawReader> mThreadReaders; // additional reader instances for the link-parallel decoding mode;
+                                            // each worker thread decodes its share of the half-CRU payloads into
+                                            // its own reader and the results are merged into mReader afterwards
+
   bool mVerbose{false};          // verbos output general debuggign and info output.
   bool mDataVerbose{false};      // verbose output of data unpacking
   bool mHeaderVerbose{false};    // verbose output of headers
   bool mCompressedData{false};   // are we dealing with the compressed data from the flp (send via option)
   int mProcessEveryNthTF{1};     // to parse only every n-th TF and send empty output for the rest
+  int mDecodingThreads{1};       // number of threads for the link-parallel decoding mode (1 = serial decoding)
   bool mInitOnceDone{false};     // flag for requesting new CCDB object upon global run number change
   std::bitset<16> mOptions;            // stores the incoming of the above bools, useful to be able to send this on instead of the individual ones above
                                        // the above bools make the code more readable hence still here.
@@ -59,6 +59,10 @@ class EventRecord
   // sort the tracklets (and optionally digits) by detector, pad row, pad column
   void sortData(bool sortDigits);
 
+  // absorb the digits, tracklets and per-trigger counters of another record for the same bunch crossing
+  // (used to combine the output of parallel decoder instances)
+  void mergeFrom(const EventRecord& other);
+
   void incTrackletTime(float timeadd) { mTimeTakenForTracklets += timeadd; }
   void incDigitTime(float timeadd) { mTimeTakenForDigits += timeadd; }
   void incTime(float duration) { mTimeTaken += duration; }
@@ -111,6 +115,10 @@ class EventRecordContainer
   void reset();
   void accumulateStats();
 
+  // absorb the event records and per-link statistics of another container
+  // (used to combine the output of parallel decoder instances)
+  void mergeFrom(EventRecordContainer& other);
+
  private:
   int mCurrEventRecord = 0;
   std::vector<EventRecord> mEventRecords;
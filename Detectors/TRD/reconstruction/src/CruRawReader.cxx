@@ -1156,6 +1156,20 @@ void CruRawReader::reset()
   mWordsRejected = 0;
 }
 
+void CruRawReader::mergeOutputFrom(CruRawReader& other)
+{
+  mEventRecords.mergeFrom(other.mEventRecords);
+  mTrackletsFound += other.mTrackletsFound;
+  mDigitsFound += other.mDigitsFound;
+  mDigitWordsRead += other.mDigitWordsRead;
+  mDigitWordsRejected += other.mDigitWordsRejected;
+  mTrackletWordsRead += other.mTrackletWordsRead;
+  mTrackletWordsRejected += other.mTrackletWordsRejected;
+  mWordsRejected += other.mWordsRejected;
+  mHalfChamberHeaderOK.insert(other.mHalfChamberHeaderOK.begin(), other.mHalfChamberHeaderOK.end());
+  mHalfChamberMismatches.insert(other.mHalfChamberMismatches.begin(), other.mHalfChamberMismatches.end());
+}
+
 void CruRawReader::checkNoWarn(bool silently)
 {
   if (!mOptions[TRDVerboseErrorsBit]) {
@@ -26,6 +26,8 @@
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DataFormatsTRD/Constants.h"
 
+#include <thread>
+
 namespace o2::trd
 {
 
@@ -39,6 +41,18 @@ void DataReaderTask::init(InitContext& ic)
   }
   mReader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
   mProcessEveryNthTF = ic.options().get<int>("every-nth-tf");
+  mDecodingThreads = std::max(1, ic.options().get<int>("decoding-threads"));
+  if (mDecodingThreads > 1) {
+    LOGP(info, "Decoding the half-CRU payloads with {} threads", mDecodingThreads);
+    mThreadReaders.resize(mDecodingThreads - 1);
+    for (auto& reader : mThreadReaders) {
+      reader.setMaxErrWarnPrinted(ic.options().get<int>("log-max-errors"), ic.options().get<int>("log-max-warnings"));
+      if (nTimeBins >= 0) {
+        reader.setNumberOfTimeBins(nTimeBins);
+      }
+      reader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
+    }
+  }
 }
 
 void DataReaderTask::endOfStream(o2::framework::EndOfStreamContext& ec)
@@ -57,6 +71,9 @@ void DataReaderTask::finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
   } else if (matcher == ConcreteDataMatcher("TRD", "LinkToHcid", 0)) {
     LOG(info) << "Updated Link ID to HCID mapping";
     mReader.setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    for (auto& reader : mThreadReaders) {
+      reader.setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    }
     return;
   }
 }
@@ -113,22 +130,59 @@ void DataReaderTask::run(ProcessingContext& pc)
   size_t datasizeInTF = 0;
   std::vector<InputSpec> sel{InputSpec{"filter", ConcreteDataTypeMatcher{"TRD", "RAWDATA"}}};
   uint64_t tfCount = 0;
-  for (auto& ref : InputRecordWalker(pc.inputs(), sel)) {
-    // loop over incoming HBFs from all half-CRUs (typically 128 * 72 iterations per TF)
-    const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
-    tfCount = dh->tfCounter;
-    const char* payloadIn = ref.payload;
-    auto payloadInSize = DataRefUtils::getPayloadSize(ref);
-    if (mOptions[TRDVerboseBit]) {
-      LOGP(info, "Found input [{}/{}/{:#x}] TF#{} 1st_orbit:{} Payload {} : ",
-           dh->dataOrigin.str, dh->dataDescription.str, dh->subSpecification, dh->tfCounter, dh->firstTForbit, payloadInSize);
+  if (mDecodingThreads > 1) {
+    // link-parallel mode: collect the payloads of all half-CRU links first and
+    // distribute them round-robin over the available reader instances. Each
+    // worker decodes into its own digit/tracklet arenas (the per-reader
+    // EventRecordContainer), so no synchronization is needed while parsing;
+    // the per-thread results are merged below after the join. The static
+    // round-robin assignment keeps the output deterministic.
+    std::vector<std::pair<const char*, size_t>> payloads;
+    for (auto& ref : InputRecordWalker(pc.inputs(), sel)) {
+      const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+      tfCount = dh->tfCounter;
+      auto payloadInSize = DataRefUtils::getPayloadSize(ref);
+      payloads.emplace_back(ref.payload, payloadInSize);
+      datasizeInTF += payloadInSize;
     }
-    mReader.setDataBuffer(payloadIn);
-    mReader.setDataBufferSize(payloadInSize);
-    mReader.run();
-    datasizeInTF += payloadInSize;
-    if (mOptions[TRDVerboseBit]) {
-      LOG(info) << "relevant vectors to read : " << mReader.getTrackletsFound() << " tracklets and " << mReader.getDigitsFound() << " compressed digits";
+    auto decodeShare = [this, &payloads](int tid) {
+      CruRawReader& reader = (tid == 0) ? mReader : mThreadReaders[tid - 1];
+      for (size_t iPayload = tid; iPayload < payloads.size(); iPayload += mDecodingThreads) {
+        reader.setDataBuffer(payloads[iPayload].first);
+        reader.setDataBufferSize(payloads[iPayload].second);
+        reader.run();
+      }
+    };
+    std::vector<std::thread> workers;
+    for (int tid = 1; tid < mDecodingThreads; ++tid) {
+      workers.emplace_back(decodeShare, tid);
+    }
+    decodeShare(0);
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    for (auto& reader : mThreadReaders) {
+      mReader.mergeOutputFrom(reader);
+      reader.reset();
+    }
+  } else {
+    for (auto& ref : InputRecordWalker(pc.inputs(), sel)) {
+      // loop over incoming HBFs from all half-CRUs (typically 128 * 72 iterations per TF)
+      const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+      tfCount = dh->tfCounter;
+      const char* payloadIn = ref.payload;
+      auto payloadInSize = DataRefUtils::getPayloadSize(ref);
+      if (mOptions[TRDVerboseBit]) {
+        LOGP(info, "Found input [{}/{}/{:#x}] TF#{} 1st_orbit:{} Payload {} : ",
+             dh->dataOrigin.str, dh->dataDescription.str, dh->subSpecification, dh->tfCounter, dh->firstTForbit, payloadInSize);
+      }
+      mReader.setDataBuffer(payloadIn);
+      mReader.setDataBufferSize(payloadInSize);
+      mReader.run();
+      datasizeInTF += payloadInSize;
+      if (mOptions[TRDVerboseBit]) {
+        LOG(info) << "relevant vectors to read : " << mReader.getTrackletsFound() << " tracklets and " << mReader.getDigitsFound() << " compressed digits";
+      }
     }
   }
 
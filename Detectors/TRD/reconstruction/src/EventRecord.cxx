@@ -56,6 +56,22 @@ void EventRecord::sortData(bool sortDigits)
   }
 }
 
+void EventRecord::mergeFrom(const EventRecord& other)
+{
+  mDigits.insert(mDigits.end(), other.mDigits.begin(), other.mDigits.end());
+  mTracklets.insert(mTracklets.end(), other.mTracklets.begin(), other.mTracklets.end());
+  mTimeTaken += other.mTimeTaken;
+  mTimeTakenForDigits += other.mTimeTakenForDigits;
+  mTimeTakenForTracklets += other.mTimeTakenForTracklets;
+  if (other.mIsCalibTrigger) {
+    mIsCalibTrigger = true;
+  }
+  for (int hcid = 0; hcid < constants::MAXHALFCHAMBER; ++hcid) {
+    mCounters.mLinkWords[hcid] += other.mCounters.mLinkWords[hcid];
+    mCounters.mLinkErrorFlag[hcid] |= other.mCounters.mLinkErrorFlag[hcid];
+  }
+}
+
 void EventRecordContainer::sendData(o2::framework::ProcessingContext& pc, bool generatestats, bool sortDigits, bool sendLinkStats)
 {
   //at this point we know the total number of tracklets and digits and triggers.
@@ -130,4 +146,32 @@ void EventRecordContainer::reset()
   mEventRecords.clear();
   mTFStats.clear();
 }
+
+void EventRecordContainer::mergeFrom(EventRecordContainer& other)
+{
+  for (auto& event : other.mEventRecords) {
+    setCurrentEventRecord(event.getBCData());
+    getCurrentEventRecord().mergeFrom(event);
+  }
+  // the per-event statistics (digit and tracklet counts, parsing times) are
+  // derived in accumulateStats() from the merged event records, so only the
+  // per-link and per-error counters need to be combined here
+  for (int hcid = 0; hcid < constants::MAXHALFCHAMBER; ++hcid) {
+    mTFStats.mLinkErrorFlag[hcid] |= other.mTFStats.mLinkErrorFlag[hcid];
+    mTFStats.mLinkNoData[hcid] += other.mTFStats.mLinkNoData[hcid];
+    mTFStats.mLinkWords[hcid] += other.mTFStats.mLinkWords[hcid];
+    mTFStats.mLinkWordsRead[hcid] += other.mTFStats.mLinkWordsRead[hcid];
+    mTFStats.mLinkWordsRejected[hcid] += other.mTFStats.mLinkWordsRejected[hcid];
+    mTFStats.mParsingOK[hcid] += other.mTFStats.mParsingOK[hcid];
+  }
+  for (int err = 0; err < TRDLastParsingError; ++err) {
+    mTFStats.mParsingErrors[err] += other.mTFStats.mParsingErrors[err];
+  }
+  mTFStats.mParsingErrorsByLink.insert(mTFStats.mParsingErrorsByLink.end(),
+                                       other.mTFStats.mParsingErrorsByLink.begin(),
+                                       other.mTFStats.mParsingErrorsByLink.end());
+  for (size_t version = 0; version < mTFStats.mDataFormatRead.size(); ++version) {
+    mTFStats.mDataFormatRead[version] += other.mTFStats.mDataFormatRead[version];
+  }
+}
 } // namespace o2::trd
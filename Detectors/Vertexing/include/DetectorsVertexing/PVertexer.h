@@ -70,6 +70,17 @@ class PVertexer
 
   int processFromExternalPool(const std::vector<TrackVF>& pool, std::vector<PVertex>& vertices, std::vector<o2d::VtxTrackIndex>& vertexTrackIDs, std::vector<V2TRef>& v2tRefs);
 
+  ///< enable incremental vertexing over sliding time windows: winMUS is the window span, marginMUS is its
+  ///< trailing part whose vertices are withheld until the next window (bounds the reporting latency)
+  void startIncremental(float winMUS, float marginMUS);
+  bool isIncremental() const { return mIncremental; }
+
+  ///< incremental vertexing: collect the tracks which entered the window ending at winTMaxMUS, drop those
+  ///< which left it, vertex the window and report the vertices not yet reported by the previous windows
+  template <typename TR>
+  int processWindow(const TR& tracks, const gsl::span<o2d::GlobalTrackID> gids, float winTMaxMUS,
+                    std::vector<PVertex>& vertices, std::vector<o2d::VtxTrackIndex>& vertexTrackIDs, std::vector<V2TRef>& v2tRefs);
+
   bool findVertex(const VertexingInput& input, PVertex& vtx);
 
   void setStartIR(const o2::InteractionRecord& ir) { mStartIR = ir; } ///< set InteractionRecods for the beginning of the TF
@@ -194,6 +205,13 @@ class PVertexer
   // structure for the vertex refit
   o2d::VertexBase mVtxRefitOrig{};   ///< original vertex whose tracks are refitted
   std::vector<int> mRefitTrackIDs{}; ///< dummy IDs for refitted tracks
+  // state of the incremental vertexing over sliding time windows
+  std::vector<TrackVF> mWindowTracksPool{}; ///< persistent pool of the tracks of the current window, sorted in time
+  float mWinSpanMUS = 0.f;                  ///< span of the sliding window
+  float mWinMarginMUS = 0.f;                ///< trailing margin of the window, its vertices wait for the next window
+  float mWinCollectedTMUS = -kHugeF;        ///< time of the most recent track collected into the window
+  float mWinReportedTMUS = -kHugeF;         ///< vertices up to this time were already reported
+  bool mIncremental = false;                ///< incremental sliding window mode is activated
   //
 
   ///========== Parameters to be set externally, e.g. from CCDB ====================
@@ -380,6 +398,64 @@ bool PVertexer::prepareVertexRefit(const TR& tracks, const o2d::VertexBase& vtxS
   return true;
 }
 
+//___________________________________________________________________
+template <typename TR>
+int PVertexer::processWindow(const TR& tracks, const gsl::span<o2d::GlobalTrackID> gids, float winTMaxMUS,
+                             std::vector<PVertex>& vertices, std::vector<o2d::VtxTrackIndex>& vertexTrackIDs, std::vector<V2TRef>& v2tRefs)
+{
+  // Incremental vertexing over sliding time windows: the converted tracks persist across overlapping
+  // windows, so that only the tracks entering the window pay the preparation (propagation to the mean
+  // vertex) cost, and only the vertices matured since the previous window are reported. The vertices
+  // in the trailing marginMUS of the window may still be modified by the tracks of the next window,
+  // they are withheld until that window, bounding the reporting latency by the margin + window slide.
+  if (!mIncremental) {
+    LOG(fatal) << "processWindow called without startIncremental";
+  }
+  createTracksPool(tracks, gids); // prepare the tracks entering the window
+  float winTMin = winTMaxMUS - mWinSpanMUS;
+  size_t nLeft = 0; // tracks which left the window
+  while (nLeft < mWindowTracksPool.size() && mWindowTracksPool[nLeft].timeEst.getTimeStamp() < winTMin) {
+    nLeft++;
+  }
+  if (nLeft) {
+    mWindowTracksPool.erase(mWindowTracksPool.begin(), mWindowTracksPool.begin() + nLeft);
+  }
+  size_t nOld = mWindowTracksPool.size();
+  for (const auto& trc : mTracksPool) {
+    if (trc.timeEst.getTimeStamp() > mWinCollectedTMUS) { // protection against resubmission of collected tracks
+      mWindowTracksPool.push_back(trc);
+    }
+  }
+  std::inplace_merge(mWindowTracksPool.begin(), mWindowTracksPool.begin() + nOld, mWindowTracksPool.end(),
+                     [](const TrackVF& a, const TrackVF& b) { return a.timeEst.getTimeStamp() < b.timeEst.getTimeStamp(); });
+  if (!mWindowTracksPool.empty()) {
+    mWinCollectedTMUS = mWindowTracksPool.back().timeEst.getTimeStamp();
+  }
+  mTracksPool.clear();
+  int nv = processFromExternalPool(mWindowTracksPool, vertices, vertexTrackIDs, v2tRefs);
+  // report only the vertices which matured since the previous window, compacting the output in place
+  float tReportMax = winTMaxMUS - mWinMarginMUS;
+  int nvKept = 0, trOut = 0;
+  for (int iv = 0; iv < nv; iv++) { // the vertices are time-sorted
+    float t = vertices[iv].getTimeStamp().getTimeStamp();
+    if (t <= mWinReportedTMUS || t > tReportMax) {
+      continue;
+    }
+    int it = v2tRefs[iv].getFirstEntry(), nent = v2tRefs[iv].getEntries(), dest0 = trOut;
+    for (int itEnd = it + nent; it < itEnd; it++) {
+      vertexTrackIDs[trOut++] = vertexTrackIDs[it];
+    }
+    v2tRefs[nvKept] = V2TRef(dest0, nent);
+    vertices[nvKept] = vertices[iv];
+    nvKept++;
+  }
+  vertices.resize(nvKept);
+  v2tRefs.resize(nvKept);
+  vertexTrackIDs.resize(trOut);
+  mWinReportedTMUS = tReportMax;
+  return nvKept;
+}
+
 } // namespace vertexing
 } // namespace o2
 #endif
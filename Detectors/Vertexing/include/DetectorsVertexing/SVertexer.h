@@ -151,9 +151,40 @@ class SVertexer
   void setSources(GIndex::mask_t src) { mSrc = src; }
 
  private:
+  ///< SoA arrays with the cheap per-track discriminating variables of the seeds pools, used to evaluate
+  ///< the pair cuts in compiled passes emitting candidate index lists before any DCAFitter call
+  struct PrefilterSoA {
+    std::vector<int> vtxMin;        // min vertex ID of the track bracket (the pools are sorted on it)
+    std::vector<int> vtxMax;        // max vertex ID of the track bracket
+    std::vector<float> tgl;         // tangent(lambda)
+    std::vector<float> xC;          // X of the track circle center in the transverse plane
+    std::vector<float> yC;          // Y of the track circle center
+    std::vector<float> rC;          // radius of the track circle
+    std::vector<uint8_t> pvContrib; // the track is a PV contributor
+    std::vector<uint8_t> tpcOnly;   // the track source is unconstrained TPC
+  };
+
+  ///< per-thread scratchpad with the flat kinematics of the V0 candidate under validation:
+  ///< the candidate cuts operate on these scalars, and the full V0 object (own + prongs
+  ///< covariances) is materialized from them only once something actually consumes it,
+  ///< instead of being assembled for every candidate probing the cuts
+  struct V0Scratch {
+    std::array<float, 3> xyz{};  // decay vertex position
+    std::array<float, 3> pxyz{}; // momentum at the decay vertex
+    std::array<float, 6> cov{};  // decay vertex position covariance
+    float cosPA = 0;             // best pointing angle cosine
+    float dcaChi2 = 0;           // chi2 at PCA
+    V0 v0{};                     // candidate materialized from the arrays above
+    bool built = false;          // v0 is in sync with the arrays
+  };
+
   template <class TVI, class TCI, class T3I, class TR>
   void extractPVReferences(const TVI& v0s, TR& vtx2V0Refs, const TCI& cascades, TR& vtx2CascRefs, const T3I& vtxs3, TR& vtx2body3Refs);
   bool checkV0(const TrackCand& seed0, const TrackCand& seed1, int iP, int iN, int ithread);
+  bool checkV0Fitted(DCAFitterN<2>& fitterV0, const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread);
+  void buildPrefilterSoA();
+  int prefilterV0Pairs(int itp, int firstN, std::vector<int>& candN) const;
+  void processV0sOnGPU(int ntrP); // defined only in GPU-enabled builds, see WITH_DCAFITTER_GPU
   int checkCascades(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   int check3bodyDecays(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   void setupThreads();
@@ -187,6 +218,9 @@ class SVertexer
   std::vector<std::vector<Decay3BodyIndex>> m3bodyIdxTmp;
   std::array<std::vector<TrackCand>, 2> mTracksPool{}; // pools of positive and negative seeds sorted in min VtxID
   std::array<std::vector<int>, 2> mVtxFirstTrack{};    // 1st pos. and neg. track of the pools for each vertex
+  std::array<PrefilterSoA, 2> mPrefilterSoA{};         // per-track variables of the pools repacked for the pair pre-filter
+  std::vector<std::vector<int>> mV0CandIDs;            // per-thread lists of negative candidates surviving the pre-filter
+  std::vector<V0Scratch> mV0Scratch;                   // per-thread scratchpads for the V0 candidate being validated
 
   o2::dataformats::VertexBase mMeanVertex{{0., 0., 0.}, {0.1 * 0.1, 0., 0.1 * 0.1, 0., 0., 6. * 6.}};
   const SVertexerParams* mSVParams = nullptr;
@@ -51,6 +51,7 @@ struct SVertexerParams : public o2::conf::ConfigurableParamHelper<SVertexerParam
   float minXSeed = -1.;                                                 ///< minimal X of seed in prong frame (within the radial resolution track should not go to negative X)
   bool usePropagator = false;                                           ///< use external propagator
   bool refitWithMatCorr = false;                                        ///< refit V0 applying material corrections
+  bool useGPUBatchFitterV0 = false;                                     ///< offload the V0 DCA fits to the GPU batch fitter (effective only in GPU-enabled builds)
   //
   int maxPVContributors = 2;              ///< max number PV contributors to allow in V0
   float minDCAToPV = 0.05;                ///< min DCA to PV of single track to accept
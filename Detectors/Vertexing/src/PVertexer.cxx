@@ -1379,6 +1379,18 @@ int PVertexer::processFromExternalPool(const std::vector<TrackVF>& pool, std::ve
   return runVertexing(gids, intCand, vertices, vertexTrackIDs, v2tRefs, lblTracks, lblVtx);
 }
 
+//______________________________________________
+void PVertexer::startIncremental(float winMUS, float marginMUS)
+{
+  // (re)start the incremental vertexing over sliding time windows, see processWindow
+  mIncremental = true;
+  mWinSpanMUS = winMUS;
+  mWinMarginMUS = marginMUS;
+  mWinCollectedTMUS = -kHugeF;
+  mWinReportedTMUS = -kHugeF;
+  mWindowTracksPool.clear();
+}
+
 //______________________________________________
 void PVertexer::setTrackSources(GTrackID::mask_t s)
 {
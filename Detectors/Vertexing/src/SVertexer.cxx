@@ -22,6 +22,7 @@
 #include "Framework/ProcessingContext.h"
 #include "Framework/DataProcessorSpec.h"
 #include "ReconstructionDataFormats/StrangeTrack.h"
+#include "ReconstructionDataFormats/VtxTrackRefCompressed.h"
 #include "CommonConstants/GeomConstants.h"
 #include "DataFormatsITSMFT/TrkClusRef.h"
 
@@ -46,29 +47,29 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
   updateTimeDependentParams(); // TODO RS: strictly speaking, one should do this only in case of the CCDB objects update
   mPVertices = recoData.getPrimaryVertices();
   buildT2V(recoData); // build track->vertex refs from vertex->track (if other workflow will need this, consider producing a message in the VertexTrackMatcher)
-  int ntrP = mTracksPool[POS].size(), ntrN = mTracksPool[NEG].size();
+  buildPrefilterSoA(); // repack the cheap per-track variables for the pair pre-filter
+  int ntrP = mTracksPool[POS].size();
   if (mStrTracker) {
     mStrTracker->loadData(recoData);
     mStrTracker->prepareITStracks();
   }
+  bool fitOnGPU = false;
+#ifdef WITH_DCAFITTER_GPU
+  fitOnGPU = mSVParams->useGPUBatchFitterV0;
+  if (fitOnGPU) {
+    processV0sOnGPU(ntrP);
+  }
+#endif
+  if (!fitOnGPU) {
 #ifdef WITH_OPENMP
-  int dynGrp = std::min(4, std::max(1, mNThreads / 2));
+    int dynGrp = std::min(4, std::max(1, mNThreads / 2));
 #pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
 #endif
-  for (int itp = 0; itp < ntrP; itp++) {
-    auto& seedP = mTracksPool[POS][itp];
-    const int firstN = mVtxFirstTrack[NEG][seedP.vBracket.getMin()];
-    if (firstN < 0) {
-      LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
-      continue;
-    }
-    for (int itn = firstN; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
-      auto& seedN = mTracksPool[NEG][itn];
-      if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
-        LOG(debug) << "Brackets do not match";
-        break;
-      }
-      if (mSVParams->maxPVContributors < 2 && seedP.gid.isPVContributor() + seedN.gid.isPVContributor() > mSVParams->maxPVContributors) {
+    for (int itp = 0; itp < ntrP; itp++) {
+      auto& seedP = mTracksPool[POS][itp];
+      const int firstN = mVtxFirstTrack[NEG][seedP.vBracket.getMin()];
+      if (firstN < 0) {
+        LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
         continue;
       }
 #ifdef WITH_OPENMP
@@ -76,7 +77,11 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
 #else
       int iThread = 0;
 #endif
-      checkV0(seedP, seedN, itp, itn, iThread);
+      // evaluate the cheap pair cuts on the SoA arrays, only the candidates surviving them are fitted
+      prefilterV0Pairs(itp, firstN, mV0CandIDs[iThread]);
+      for (int itn : mV0CandIDs[iThread]) {
+        checkV0(seedP, mTracksPool[NEG][itn], itp, itn, iThread);
+      }
     }
   }
 
@@ -345,6 +350,8 @@ void SVertexer::setupThreads()
   mV0sIdxTmp.resize(mNThreads);
   mCascadesIdxTmp.resize(mNThreads);
   m3bodyIdxTmp.resize(mNThreads);
+  mV0CandIDs.resize(mNThreads);
+  mV0Scratch.resize(mNThreads);
   mFitterV0.resize(mNThreads);
   mBz = o2::base::Propagator::Instance()->getNominalBz();
   int fitCounter = 0;
@@ -461,14 +468,15 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
 
   std::unordered_map<GIndex, std::pair<int, int>> tmap;
   std::unordered_map<GIndex, bool> rejmap;
-  int nv = vtxRefs.size() - 1; // The last entry is for unassigned tracks, ignore them
+  o2::dataformats::VtxTrackRefCompressed vtxRefsC(vtxRefs); // compressed table for cache-linear iteration
+  int nv = vtxRefs.size() - 1;                              // The last entry is for unassigned tracks, ignore them
   for (int i = 0; i < 2; i++) {
     mTracksPool[i].clear();
     mVtxFirstTrack[i].clear();
     mVtxFirstTrack[i].resize(nv, -1);
   }
   for (int iv = 0; iv < nv; iv++) {
-    const auto& vtref = vtxRefs[iv];
+    const auto vtref = vtxRefsC.getRange(iv);
     int it = vtref.getFirstEntry(), itLim = it + vtref.getEntries();
     for (; it < itLim; it++) {
       auto tvid = trackIndex[it];
@@ -577,41 +585,138 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
 }
 
 //__________________________________________________________________
-bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
+void SVertexer::buildPrefilterSoA()
 {
-  auto& fitterV0 = mFitterV0[ithread];
-  // Fast rough cuts on pairs before feeding to DCAFitter, tracks are not in the same Frame or at same X
-  bool isTPConly = (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC);
-  if (mSVParams->mTPCTrackPhotonTune && isTPConly) {
-    // Check if Tgl is close enough
-    if (std::abs(seedP.getTgl() - seedN.getTgl()) > mSVParams->maxV0TglAbsDiff) {
-      LOG(debug) << "RejTgl";
-      return false;
+  // repack the cheap per-track discriminating variables of the seeds pools into SoA arrays,
+  // so that the pair cuts can be evaluated in tight compiled loops before any DCAFitter call
+  bool needCircles = mSVParams->mTPCTrackPhotonTune;
+  for (int pn = 0; pn < 2; pn++) {
+    auto& soa = mPrefilterSoA[pn];
+    const auto& tracksPool = mTracksPool[pn];
+    size_t ntr = tracksPool.size();
+    soa.vtxMin.resize(ntr);
+    soa.vtxMax.resize(ntr);
+    soa.tgl.resize(ntr);
+    soa.xC.resize(ntr);
+    soa.yC.resize(ntr);
+    soa.rC.resize(ntr);
+    soa.pvContrib.resize(ntr);
+    soa.tpcOnly.resize(ntr);
+    for (size_t i = 0; i < ntr; i++) {
+      const auto& t = tracksPool[i];
+      soa.vtxMin[i] = t.vBracket.getMin();
+      soa.vtxMax[i] = t.vBracket.getMax();
+      soa.tgl[i] = t.getTgl();
+      soa.pvContrib[i] = t.gid.isPVContributor();
+      soa.tpcOnly[i] = t.gid.getSource() == GIndex::TPC;
+      if (needCircles) {
+        float sna, csa;
+        o2::math_utils::CircleXYf_t circle;
+        t.getCircleParams(mBz, circle, sna, csa);
+        soa.xC[i] = circle.xC;
+        soa.yC[i] = circle.yC;
+        soa.rC[i] = circle.rC;
+      }
     }
-    // Check in transverse plane
-    float sna, csa;
-    o2::math_utils::CircleXYf_t trkPosCircle;
-    seedP.getCircleParams(mBz, trkPosCircle, sna, csa);
-    o2::math_utils::CircleXYf_t trkEleCircle;
-    seedN.getCircleParams(mBz, trkEleCircle, sna, csa);
-    // Does the radius of both tracks compare to their absolute circle center distance
-    float c2c = std::hypot(trkPosCircle.xC - trkEleCircle.xC,
-                           trkPosCircle.yC - trkEleCircle.yC);
-    float r2r = trkPosCircle.rC + trkEleCircle.rC;
-    float dcr = c2c - r2r;
-    if (std::abs(dcr) > mSVParams->mTPCTrackD2R) {
-      LOG(debug) << "RejD2R " << c2c << " " << r2r << " " << dcr;
-      return false;
+  }
+}
+
+//__________________________________________________________________
+int SVertexer::prefilterV0Pairs(int itp, int firstN, std::vector<int>& candN) const
+{
+  // evaluate the cheap pair cuts for the positive seed itp against the negative seeds starting from
+  // firstN, emitting the indices of the candidates to be passed to the DCAFitter. The cuts replicate
+  // the rejections formerly done per pair in the pair loop and in checkV0.
+  candN.clear();
+  const auto& soaP = mPrefilterSoA[POS];
+  const auto& soaN = mPrefilterSoA[NEG];
+  // all vertices compatible with the negative seeds beyond this bound are in future wrt that of the positive one
+  int itnEnd = std::upper_bound(soaN.vtxMin.begin() + firstN, soaN.vtxMin.end(), soaP.vtxMax[itp]) - soaN.vtxMin.begin();
+  bool cutPVC = mSVParams->maxPVContributors < 2;
+  int pvcP = soaP.pvContrib[itp], maxPVC = mSVParams->maxPVContributors;
+  bool photonTune = mSVParams->mTPCTrackPhotonTune;
+  bool tpcOnlyP = soaP.tpcOnly[itp];
+  float tglP = soaP.tgl[itp], xCP = soaP.xC[itp], yCP = soaP.yC[itp], rCP = soaP.rC[itp];
+  for (int itn = firstN; itn < itnEnd; itn++) {
+    if (cutPVC && pvcP + soaN.pvContrib[itn] > maxPVC) {
+      continue;
     }
-    // Will the conversion point look somewhat reasonable
-    float r1_r = trkPosCircle.rC / r2r;
-    float r2_r = trkEleCircle.rC / r2r;
-    float dR = std::hypot(r2_r * trkPosCircle.xC + r1_r * trkEleCircle.xC, r2_r * trkPosCircle.yC + r1_r * trkEleCircle.yC);
-    if (dR > mSVParams->mTPCTrackDR) {
-      LOG(debug) << "RejDR" << dR;
-      return false;
+    if (photonTune && (tpcOnlyP || soaN.tpcOnly[itn])) {
+      // fast rough cuts on TPC-only pairs, tracks are not in the same frame or at same X
+      if (std::abs(tglP - soaN.tgl[itn]) > mSVParams->maxV0TglAbsDiff) { // is Tgl close enough?
+        continue;
+      }
+      // does the radius of both tracks compare to their absolute circle center distance?
+      float c2c = std::hypot(xCP - soaN.xC[itn], yCP - soaN.yC[itn]);
+      float r2r = rCP + soaN.rC[itn];
+      if (std::abs(c2c - r2r) > mSVParams->mTPCTrackD2R) {
+        continue;
+      }
+      // will the conversion point look somewhat reasonable?
+      float r1_r = rCP / r2r, r2_r = soaN.rC[itn] / r2r;
+      float dR = std::hypot(r2_r * xCP + r1_r * soaN.xC[itn], r2_r * yCP + r1_r * soaN.yC[itn]);
+      if (dR > mSVParams->mTPCTrackDR) {
+        continue;
+      }
     }
+    candN.push_back(itn);
+  }
+  return candN.size();
+}
+
+#ifdef WITH_DCAFITTER_GPU
+//__________________________________________________________________
+void SVertexer::processV0sOnGPU(int ntrP)
+{
+  // stage the track pairs surviving the pre-filter into SoA arrays, fit them on the GPU in a single
+  // batch and run the host post-processing (V0 validation, cascades, 3-body checks) on the found
+  // vertices. The batch broadcasts a single fitter configuration, so the TPC-only pairs needing the
+  // per-pair photon-tune fitter setup are fitted inline on the host.
+  std::vector<o2::track::TrackParCov> trcP, trcN;
+  std::vector<std::pair<int, int>> pairIdx;
+  std::vector<DCAFitterN<2>> fitters;
+  std::vector<int> results;
+  auto& candN = mV0CandIDs[0];
+  for (int itp = 0; itp < ntrP; itp++) {
+    auto& seedP = mTracksPool[POS][itp];
+    const int firstN = mVtxFirstTrack[NEG][seedP.vBracket.getMin()];
+    if (firstN < 0) {
+      LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
+      continue;
+    }
+    prefilterV0Pairs(itp, firstN, candN);
+    for (int itn : candN) {
+      auto& seedN = mTracksPool[NEG][itn];
+      if (mSVParams->mTPCTrackPhotonTune && (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC)) {
+        checkV0(seedP, seedN, itp, itn, 0); // needs the per-pair fitter tuning, keep on the host
+        continue;
+      }
+      trcP.push_back(seedP);
+      trcN.push_back(seedN);
+      pairIdx.emplace_back(itp, itn);
+    }
+  }
+  LOG(info) << "Fitting " << pairIdx.size() << " V0 candidate pairs on GPU";
+  if (pairIdx.empty()) {
+    return;
+  }
+  fitters.resize(pairIdx.size(), mFitterV0[0]); // the first fitter carries the configuration for the batch
+  device::processBatch(fitters, results, trcP, trcN);
+  for (size_t ip = 0; ip < pairIdx.size(); ip++) {
+    if (results[ip] != 0) {
+      checkV0Fitted(fitters[ip], mTracksPool[POS][pairIdx[ip].first], mTracksPool[NEG][pairIdx[ip].second], pairIdx[ip].first, pairIdx[ip].second, 0);
+    }
+  }
+}
+#endif
 
+//__________________________________________________________________
+bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
+{
+  auto& fitterV0 = mFitterV0[ithread];
+  // the fast rough cuts on the pair were already applied on the SoA arrays in prefilterV0Pairs
+  bool isTPConly = (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC);
+  if (mSVParams->mTPCTrackPhotonTune && isTPConly) {
     // Setup looser cuts for the DCAFitter
     fitterV0.setMaxDZIni(mSVParams->mTPCTrackMaxDZIni);
     fitterV0.setMaxDXYIni(mSVParams->mTPCTrackMaxDXYIni);
@@ -633,6 +738,14 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
     LOG(debug) << "RejDCAFitter";
     return false;
   }
+  return checkV0Fitted(fitterV0, seedP, seedN, iP, iN, ithread);
+}
+
+//__________________________________________________________________
+bool SVertexer::checkV0Fitted(DCAFitterN<2>& fitterV0, const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
+{
+  // validate and process a V0 candidate already fitted by the DCAFitter (inline or in a GPU batch)
+  bool isTPConly = (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC);
   const auto& v0XYZ = fitterV0.getPCACandidate();
   // validate V0 radial position
   // check closeness to the beam-line
@@ -769,7 +882,8 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
   bool candFound = false;
   auto bestCosPA = checkForCascade ? mSVParams->minCosPACascV0 : mSVParams->minCosPA;
   bestCosPA = checkFor3BodyDecays ? std::min(mSVParams->minCosPA3bodyV0, bestCosPA) : bestCosPA;
-  V0 v0new;
+  auto& scr = mV0Scratch[ithread]; // accumulate the flat candidate kinematics, the V0 object is built from them lazily
+  scr.built = false;
   V0Index v0Idxnew;
 
   for (int iv = vlist.getMin(); iv <= vlist.getMax(); iv++) {
@@ -783,18 +897,31 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
       continue;
     }
     if (!candFound) {
-      new (&v0new) V0(v0XYZ, pV0, fitterV0.calcPCACovMatrixFlat(cand), trPProp, trNProp);
+      scr.xyz = {v0XYZ[0], v0XYZ[1], v0XYZ[2]};
+      scr.pxyz = pV0;
+      scr.cov = fitterV0.calcPCACovMatrixFlat(cand);
+      scr.dcaChi2 = fitterV0.getChi2AtPCACandidate(cand);
       new (&v0Idxnew) V0Index(-1, seedP.gid, seedN.gid);
-      v0new.setDCA(fitterV0.getChi2AtPCACandidate(cand));
       candFound = true;
     }
-    v0new.setCosPA(cosPA);
+    scr.cosPA = cosPA;
     v0Idxnew.setVertexID(iv);
     bestCosPA = cosPA;
   }
   if (!candFound) {
     return false;
   }
+  // materialize the full V0 (own + prongs covariances) from the scratchpad only when something
+  // actually consumes the object; candidates failing the remaining cuts never pay for it
+  auto& v0new = scr.v0;
+  auto materializeV0 = [&scr, &v0new, &trPProp, &trNProp]() {
+    if (!scr.built) {
+      new (&v0new) V0(scr.xyz, scr.pxyz, scr.cov, trPProp, trNProp);
+      v0new.setDCA(scr.dcaChi2);
+      scr.built = true;
+    }
+    v0new.setCosPA(scr.cosPA);
+  };
   if (bestCosPA < mSVParams->minCosPACascV0) {
     rejectAfter3BodyCheck = true;
   }
@@ -804,6 +931,7 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
   int nV0Ini = mV0sIdxTmp[ithread].size();
   // check 3 body decays
   if (checkFor3BodyDecays) {
+    materializeV0();
     int n3bodyDecays = 0;
     n3bodyDecays += check3bodyDecays(v0Idxnew, v0new, rv0, pV0, p2V0, iN, NEG, vlist, ithread);
     n3bodyDecays += check3bodyDecays(v0Idxnew, v0new, rv0, pV0, p2V0, iP, POS, vlist, ithread);
@@ -815,6 +943,7 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
   // check cascades
   int nCascIni = mCascadesIdxTmp[ithread].size(), nV0Used = 0; // number of times this particular v0 (with assigned PV) was used (not counting using its clones with other PV)
   if (checkForCascade) {
+    materializeV0();
     if (goodLamForCascade || !mSVParams->checkCascadeHypothesis) {
       nV0Used += checkCascades(v0Idxnew, v0new, rv0, pV0, p2V0, iN, NEG, vlist, ithread);
     }
@@ -842,11 +971,13 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
     }
 
     if (mSVParams->createFullV0s) {
+      materializeV0();
       mV0sTmp[ithread].push_back(v0new);
     }
   }
 
   if (mStrTracker) {
+    materializeV0();
     for (int iv = nV0Ini; iv < (int)mV0sIdxTmp[ithread].size(); iv++) {
       mStrTracker->processV0(iv, v0new, v0Idxnew, ithread);
     }
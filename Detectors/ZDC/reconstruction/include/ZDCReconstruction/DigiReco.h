@@ -171,6 +171,7 @@ class DigiReco
 
   O2_ZDC_DIGIRECO_FLT getPoint(int itdc, int ibeg, int iend, int i); /// Interpolation for current TDC
   void setPoint(int itdc, int ibeg, int iend, int i);                /// Interpolation for current TDC
+  void interpolateBulk(int isig, int ibeg, int iend);                /// Polyphase interpolation of a whole group of bunches
 
   void assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
   void findSignals(int ibeg, int iend);                                       /// Find signals around main-main that satisfy condition on TDC
@@ -189,6 +190,9 @@ class DigiReco
   const RecoConfigZDC* mRecoConfigZDC = nullptr; /// CCDB configuration parameters
   int32_t mVerbosity = DbgMinimal;
   O2_ZDC_DIGIRECO_FLT mTS[NTS];                     /// Tapered sinc function
+  O2_ZDC_DIGIRECO_FLT mTSPoly[TSN][2 * TSL];        /// Polyphase view of the tapered sinc (taps per interpolation phase)
+  O2_ZDC_DIGIRECO_FLT mTSPolySum[TSN];              /// Normalization per interpolation phase
+  std::vector<O2_ZDC_DIGIRECO_FLT> mSampleBuffer;   /// Padded contiguous samples of the group being interpolated
   bool mTreeDbg = false;                            /// Write reconstructed data in debug output file
   std::unique_ptr<TFile> mDbg = nullptr;            /// Debug output file
   std::unique_ptr<TTree> mTDbg = nullptr;           /// Debug tree
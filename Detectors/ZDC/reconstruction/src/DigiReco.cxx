@@ -480,6 +480,19 @@ void DigiReco::prepareInterpolation()
     mTS[n + tsi] = fs * fg;
     mTS[n - tsi] = mTS[n + tsi]; // Function is even
   }
+  // Polyphase view of the tapered sinc: for each interpolation phase the
+  // 2*TSL taps and their normalization are gathered once so that the bulk
+  // interpolation can run fixed-length dot products on a contiguous sample
+  // buffer (phase 0 corresponds to the acquired points and has no taps)
+  for (int im = 1; im < TSN; im++) {
+    int k = 0;
+    O2_ZDC_DIGIRECO_FLT sum = 0;
+    for (int is = TSN - im; is < NTS; is += TSN, k++) {
+      mTSPoly[im][k] = mTS[is];
+      sum += mTS[is];
+    }
+    mTSPolySum[im] = sum;
+  }
   LOG(info) << "Interpolation numeric precision is " << sizeof(O2_ZDC_DIGIRECO_FLT);
   LOG(info) << "Interpolation alpha = " << mAlpha;
 }
@@ -1459,6 +1472,53 @@ void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
   }
 } // setPoint
 
+void DigiReco::interpolateBulk(int isig, int ibeg, int iend)
+{
+  // Polyphase interpolation of a whole group of bunches: the acquired samples
+  // are packed once into a contiguous buffer padded with the constant
+  // extrapolation values, and every interpolated point becomes a fixed-length
+  // dot product with the precomputed taps of its phase. The results are
+  // identical to repeated setPoint calls, but the regular inner loops run on
+  // packed data and can be unrolled and vectorized by the compiler instead of
+  // re-deriving indices and boundaries point by point.
+  // The group data members (mNsam, mNtot, ...) must be set by the caller.
+  constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
+  constexpr int ntaps = 2 * TSL;              // Taps per interpolation phase
+
+  // Pack the samples of the group with TSL padding points on both sides
+  mSampleBuffer.resize(mNsam + 2 * TSL);
+  for (int j = 0; j < TSL; j++) {
+    mSampleBuffer[j] = mFirstSample;
+    mSampleBuffer[TSL + mNsam + j] = mLastSample;
+  }
+  for (int ii = 0; ii < mNsam; ii++) {
+    mSampleBuffer[TSL + ii] = mReco[ibeg + ii / NTimeBinsPerBC].data[isig][ii % NTimeBinsPerBC];
+  }
+
+  auto setInter = [&](int i, O2_ZDC_DIGIRECO_FLT val) {
+    mReco[ibeg + i / nsbun].inter[isig][i % nsbun] = val;
+  };
+  // Constant extrapolation at the beginning and at the end of the array
+  for (int i = 0; i < TSNH; i++) {
+    setInter(i, mFirstSample);
+  }
+  for (int i = mIlast; i < mNtot; i++) {
+    setInter(i, mLastSample);
+  }
+  // Interpolation region: for each acquired sample the TSN-1 following phases
+  for (int ip = 0; ip < mNsam - 1; ip++) {
+    const O2_ZDC_DIGIRECO_FLT* samples = mSampleBuffer.data() + ip + 1;
+    setInter(ip * TSN + TSNH, samples[TSL - 1]); // acquired (filtered) point
+    for (int im = 1; im < TSN; im++) {
+      O2_ZDC_DIGIRECO_FLT y = 0;
+      for (int k = 0; k < ntaps; k++) {
+        y += samples[k] * mTSPoly[im][k];
+      }
+      setInter(ip * TSN + im + TSNH, y / mTSPolySum[im]);
+    }
+  }
+} // interpolateBulk
+
 int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
 {
   // Interpolation of signal isig, in consecutive bunches from ibeg to iend
@@ -1497,9 +1557,7 @@ int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
   for (int ibun = ibeg; ibun <= iend; ibun++) {
     mReco[ibun].allocate(isig);
   }
-  for (int i = 0; i < mNtot; i++) {
-    setPoint(isig, ibeg, iend, i);
-  }
+  interpolateBulk(isig, ibeg, iend);
   if (mInError) {
     return __LINE__;
   }
@@ -1554,9 +1612,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
     for (int ibun = ibeg; ibun <= iend; ibun++) {
       mReco[ibun].allocate(isig);
     }
-    for (int i = 0; i < mNtot; i++) {
-      setPoint(isig, ibeg, iend, i);
-    }
+    interpolateBulk(isig, ibeg, iend);
   }
   if (mInError) {
     return __LINE__;
@@ -78,6 +78,13 @@ class VisualisationEvent
     return &mTracks.back();
   }
 
+  /// re-add an already converted track (including its clusters)
+  VisualisationTrack* addTrack(const VisualisationTrack& track)
+  {
+    mTracks.push_back(track);
+    return &mTracks.back();
+  }
+
   VisualisationCluster& addCluster(const float* xyz)
   {
     // float pos[] = {X, Y, Z};
@@ -96,12 +103,25 @@ class VisualisationEvent
     result.mTime = time;
   }
 
+  /// re-add an already converted global cluster
+  void addGlobalCluster(const VisualisationCluster& cluster)
+  {
+    mClusters.push_back(cluster);
+  }
+
   VisualisationCalo* addCalo(VisualisationCalo::VisualisationCaloVO vo)
   {
     mCalo.emplace_back(vo);
     return &mCalo.back();
   }
 
+  /// re-add an already converted calorimeter object
+  VisualisationCalo* addCalo(const VisualisationCalo& calo)
+  {
+    mCalo.push_back(calo);
+    return &mCalo.back();
+  }
+
   // Multiplicity getter
   int GetMultiplicity() const
   {
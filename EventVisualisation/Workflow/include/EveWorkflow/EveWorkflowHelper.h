@@ -212,6 +212,15 @@ class EveWorkflowHelper
   std::unordered_map<std::size_t, std::vector<GID>> mPrimaryVertexTrackGIDs;
   std::unordered_map<std::size_t, std::vector<GID>> mPrimaryVertexTriggerGIDs;
   std::unordered_map<GID, unsigned int> mGIDTrackTime;
+  /// already converted trigger primitives: calorimeter objects and global clusters
+  struct ConvertedTrigger {
+    std::vector<VisualisationCalo> calos;
+    std::vector<VisualisationCluster> clusters;
+  };
+  /// cache of already converted primitives, keyed by GID; data shared between
+  /// several primary vertices of the same time frame is converted only once
+  std::unordered_map<GID, std::vector<VisualisationTrack>> mConvertedTracks;
+  std::unordered_map<GID, ConvertedTrigger> mConvertedTriggers;
   std::vector<Bracket> mItsROFBrackets;
   std::vector<o2::BaseCluster<float>> mITSClustersArray;
   std::vector<o2::BaseCluster<float>> mMFTClustersArray;
@@ -382,6 +382,14 @@ void EveWorkflowHelper::draw(std::size_t primaryVertexIdx, bool sortTracks)
       const auto& gid = tracks[it];
       auto tim = unflagTime(mGIDTrackTime.at(gid));
       mTotalAcceptedDataTypes.insert(gid);
+      // reuse primitives converted for another primary vertex of this time frame
+      if (const auto cached = mConvertedTracks.find(gid); cached != mConvertedTracks.end()) {
+        for (const auto& track : cached->second) {
+          mEvent.addTrack(track);
+        }
+        continue;
+      }
+      const auto firstConverted = mEvent.getTrackCount();
       // LOG(info) << "EveWorkflowHelper::draw " << gid.asString();
       switch (gid.getSource()) {
         case GID::ITS:
@@ -433,6 +441,11 @@ void EveWorkflowHelper::draw(std::size_t primaryVertexIdx, bool sortTracks)
           LOGF(info, "Track type %s not handled", gid.getSourceName());
           break;
       }
+      // remember the converted primitives for this GID
+      auto& converted = mConvertedTracks[gid];
+      for (auto i = firstConverted; i < mEvent.getTrackCount(); i++) {
+        converted.emplace_back(mEvent.getTrack(i));
+      }
     }
   }
 
@@ -444,6 +457,18 @@ void EveWorkflowHelper::draw(std::size_t primaryVertexIdx, bool sortTracks)
     for (std::size_t it = 0; it < triggers.size(); it++) {
       const auto& gid = triggers[it];
       mTotalAcceptedDataTypes.insert(gid);
+      // same caching for the trigger primitives
+      if (const auto cached = mConvertedTriggers.find(gid); cached != mConvertedTriggers.end()) {
+        for (const auto& calo : cached->second.calos) {
+          mEvent.addCalo(calo);
+        }
+        for (const auto& cluster : cached->second.clusters) {
+          mEvent.addGlobalCluster(cluster);
+        }
+        continue;
+      }
+      const auto firstConvertedCalo = mEvent.getCaloCount();
+      const auto firstConvertedCluster = mEvent.getClusterCount();
       switch (gid.getSource()) {
         case GID::PHS:
           drawPHS(gid);
@@ -458,6 +483,13 @@ void EveWorkflowHelper::draw(std::size_t primaryVertexIdx, bool sortTracks)
           LOGF(info, "Trigger type %s not handled", gid.getSourceName());
           break;
       }
+      auto& converted = mConvertedTriggers[gid];
+      for (auto i = firstConvertedCalo; i < mEvent.getCaloCount(); i++) {
+        converted.calos.emplace_back(mEvent.getCalorimetersSpan()[i]);
+      }
+      for (auto i = firstConvertedCluster; i < mEvent.getClusterCount(); i++) {
+        converted.clusters.emplace_back(mEvent.getCluster(i));
+      }
     }
   }
 }
@@ -13,6 +13,9 @@
 #include <list>
 #include <fstream>
 #include <getopt.h>
+#include <thread>
+#include <vector>
+#include <string>
 
 #include "TSystem.h"
 #include "TFile.h"
@@ -24,71 +27,19 @@
 #include <TGrid.h>
 #include <TMap.h>
 #include <TLeaf.h>
+#include <TROOT.h>
 
 #include "aodMerger.h"
 #include <cinttypes>
 
-// AOD merger with correct index rewriting
-// No need to know the datamodel because the branch names follow a canonical standard (identified by fIndex)
-int main(int argc, char* argv[])
+// Merge the given input files into outputFileName.
+// Returns 0 on success, a positive exit code otherwise.
+int mergeFiles(std::vector<std::string> const& inputFileNames, std::string const& outputFileName,
+               long maxDirSize, bool skipNonExistingFiles, bool skipParentFilesList, bool forceFastCopy,
+               int verbosity)
 {
-  std::string inputCollection("input.txt");
-  std::string outputFileName("AO2D.root");
-  long maxDirSize = 100000000;
-  bool skipNonExistingFiles = false;
-  bool skipParentFilesList = false;
-  int verbosity = 2;
   int exitCode = 0; // 0: success, >0: failure
 
-  int option_index = 0;
-  static struct option long_options[] = {
-    {"input", required_argument, nullptr, 0},
-    {"output", required_argument, nullptr, 1},
-    {"max-size", required_argument, nullptr, 2},
-    {"skip-non-existing-files", no_argument, nullptr, 3},
-    {"skip-parent-files-list", no_argument, nullptr, 4},
-    {"verbosity", required_argument, nullptr, 5},
-    {"help", no_argument, nullptr, 6},
-    {nullptr, 0, nullptr, 0}};
-
-  while (true) {
-    int c = getopt_long(argc, argv, "", long_options, &option_index);
-    if (c == -1) {
-      break;
-    } else if (c == 0) {
-      inputCollection = optarg;
-    } else if (c == 1) {
-      outputFileName = optarg;
-    } else if (c == 2) {
-      maxDirSize = atol(optarg);
-    } else if (c == 3) {
-      skipNonExistingFiles = true;
-    } else if (c == 4) {
-      skipParentFilesList = true;
-    } else if (c == 5) {
-      verbosity = atoi(optarg);
-    } else if (c == 6) {
-      printf("AO2D merging tool. Options: \n");
-      printf("  --input <inputfile.txt>      Contains path to files to be merged. Default: %s\n", inputCollection.c_str());
-      printf("  --output <outputfile.root>   Target output ROOT file. Default: %s\n", outputFileName.c_str());
-      printf("  --max-size <size in Bytes>   Target directory size. Default: %ld. Set to 0 if file is not self-contained.\n", maxDirSize);
-      printf("  --skip-non-existing-files    Flag to allow skipping of non-existing files in the input list.\n");
-      printf("  --skip-parent-files-list     Flag to allow skipping the merging of the parent files list.\n");
-      printf("  --verbosity <flag>           Verbosity of output (default: %d).\n", verbosity);
-      return -1;
-    } else {
-      return -2;
-    }
-  }
-
-  printf("AOD merger started with:\n");
-  printf("  Input file: %s\n", inputCollection.c_str());
-  printf("  Output file name: %s\n", outputFileName.c_str());
-  printf("  Maximal folder size (uncompressed): %ld\n", maxDirSize);
-  if (skipNonExistingFiles) {
-    printf("  WARNING: Skipping non-existing files.\n");
-  }
-
   std::map<std::string, TTree*> trees;
   std::map<std::string, uint64_t> sizeCompressed;
   std::map<std::string, uint64_t> sizeUncompressed;
@@ -99,16 +50,16 @@ int main(int argc, char* argv[])
   TDirectory* outputDir = nullptr;
   long currentDirSize = 0;
 
-  std::ifstream in;
-  in.open(inputCollection);
-  TString line;
   bool connectedToAliEn = false;
   TMap* metaData = nullptr;
   TMap* parentFiles = nullptr;
   int totalMergedDFs = 0;
   int mergedDFs = 0;
-  while (in.good() && exitCode == 0) {
-    in >> line;
+  for (auto const& inputFileName : inputFileNames) {
+    if (exitCode != 0) {
+      break;
+    }
+    TString line(inputFileName.c_str());
 
     if (line.Length() == 0) {
       continue;
@@ -134,6 +85,10 @@ int main(int argc, char* argv[])
       }
     }
 
+    // raw basket copying is only valid when the baskets do not have to be
+    // recompressed for the output
+    bool compressionMatches = inputFile->GetCompressionSettings() == outputFile->GetCompressionSettings();
+
     TList* keyList = inputFile->GetListOfKeys();
     keyList->Sort();
 
@@ -221,7 +176,9 @@ int main(int argc, char* argv[])
         foundTrees.push_back(treeName);
 
         auto inputTree = (TTree*)inputFile->Get(Form("%s/%s", dfName, treeName));
-        bool fastCopy = (inputTree->GetTotBytes() > 10000000); // Only do this for large enough trees to avoid that baskets are too small
+        // Only do this for large enough trees to avoid that baskets are too small,
+        // unless raw basket copying was explicitly requested and is valid
+        bool fastCopy = (inputTree->GetTotBytes() > 10000000) || (forceFastCopy && compressionMatches);
         if (verbosity > 1) {
           printf("    Processing tree %s with %lld entries with total size %lld (fast copy: %d)\n", treeName, inputTree->GetEntries(), inputTree->GetTotBytes(), fastCopy);
         }
@@ -268,7 +225,7 @@ int main(int argc, char* argv[])
             int maximum = ((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount()->GetMaximum();
 
             // get type
-            static TClass* cls;
+            TClass* cls = nullptr;
             EDataType type;
             br->GetExpectedType(cls, type);
             auto typeSize = TDataType::GetDataType(type)->Size();
@@ -459,3 +416,134 @@ int main(int argc, char* argv[])
 
   return exitCode;
 }
+
+// AOD merger with correct index rewriting
+// No need to know the datamodel because the branch names follow a canonical standard (identified by fIndex)
+int main(int argc, char* argv[])
+{
+  std::string inputCollection("input.txt");
+  std::string outputFileName("AO2D.root");
+  long maxDirSize = 100000000;
+  bool skipNonExistingFiles = false;
+  bool skipParentFilesList = false;
+  bool forceFastCopy = false;
+  int jobs = 1;
+  int verbosity = 2;
+
+  int option_index = 0;
+  static struct option long_options[] = {
+    {"input", required_argument, nullptr, 0},
+    {"output", required_argument, nullptr, 1},
+    {"max-size", required_argument, nullptr, 2},
+    {"skip-non-existing-files", no_argument, nullptr, 3},
+    {"skip-parent-files-list", no_argument, nullptr, 4},
+    {"verbosity", required_argument, nullptr, 5},
+    {"help", no_argument, nullptr, 6},
+    {"jobs", required_argument, nullptr, 7},
+    {"fast-copy", no_argument, nullptr, 8},
+    {nullptr, 0, nullptr, 0}};
+
+  while (true) {
+    int c = getopt_long(argc, argv, "", long_options, &option_index);
+    if (c == -1) {
+      break;
+    } else if (c == 0) {
+      inputCollection = optarg;
+    } else if (c == 1) {
+      outputFileName = optarg;
+    } else if (c == 2) {
+      maxDirSize = atol(optarg);
+    } else if (c == 3) {
+      skipNonExistingFiles = true;
+    } else if (c == 4) {
+      skipParentFilesList = true;
+    } else if (c == 5) {
+      verbosity = atoi(optarg);
+    } else if (c == 6) {
+      printf("AO2D merging tool. Options: \n");
+      printf("  --input <inputfile.txt>      Contains path to files to be merged. Default: %s\n", inputCollection.c_str());
+      printf("  --output <outputfile.root>   Target output ROOT file. Default: %s\n", outputFileName.c_str());
+      printf("  --max-size <size in Bytes>   Target directory size. Default: %ld. Set to 0 if file is not self-contained.\n", maxDirSize);
+      printf("  --skip-non-existing-files    Flag to allow skipping of non-existing files in the input list.\n");
+      printf("  --skip-parent-files-list     Flag to allow skipping the merging of the parent files list.\n");
+      printf("  --jobs <N>                   Merge with N parallel workers, each writing an intermediate file, followed by a concatenation stage. Default: 1.\n");
+      printf("  --fast-copy                  Copy baskets without re-decompression also for small trees when compression settings match.\n");
+      printf("  --verbosity <flag>           Verbosity of output (default: %d).\n", verbosity);
+      return -1;
+    } else if (c == 7) {
+      jobs = atoi(optarg);
+    } else if (c == 8) {
+      forceFastCopy = true;
+    } else {
+      return -2;
+    }
+  }
+
+  printf("AOD merger started with:\n");
+  printf("  Input file: %s\n", inputCollection.c_str());
+  printf("  Output file name: %s\n", outputFileName.c_str());
+  printf("  Maximal folder size (uncompressed): %ld\n", maxDirSize);
+  if (jobs > 1) {
+    printf("  Parallel workers: %d\n", jobs);
+  }
+  if (skipNonExistingFiles) {
+    printf("  WARNING: Skipping non-existing files.\n");
+  }
+
+  std::vector<std::string> inputFileNames;
+  std::ifstream in;
+  in.open(inputCollection);
+  TString line;
+  while (in.good()) {
+    in >> line;
+    if (line.Length() > 0) {
+      inputFileNames.emplace_back(line.Data());
+    }
+  }
+
+  if (jobs <= 1 || inputFileNames.size() < 2) {
+    return mergeFiles(inputFileNames, outputFileName, maxDirSize, skipNonExistingFiles, skipParentFilesList, forceFastCopy, verbosity);
+  }
+
+  // Parallel mode: each worker merges a contiguous share of the input list
+  // into an intermediate file, then the intermediates are concatenated
+  // in order with the same index rewriting.
+  if ((size_t)jobs > inputFileNames.size()) {
+    jobs = inputFileNames.size();
+  }
+  ROOT::EnableThreadSafety();
+
+  std::vector<std::string> partFileNames(jobs);
+  std::vector<int> partExitCodes(jobs, 0);
+  std::vector<std::thread> workers;
+  workers.reserve(jobs);
+  for (int worker = 0; worker < jobs; ++worker) {
+    partFileNames[worker] = outputFileName + Form(".part%d", worker);
+    size_t begin = inputFileNames.size() * worker / jobs;
+    size_t end = inputFileNames.size() * (worker + 1) / jobs;
+    std::vector<std::string> share(inputFileNames.begin() + begin, inputFileNames.begin() + end);
+    workers.emplace_back([share = std::move(share), partFileName = partFileNames[worker], &partExitCodes, worker,
+                          maxDirSize, skipNonExistingFiles, skipParentFilesList, forceFastCopy, verbosity]() {
+      partExitCodes[worker] = mergeFiles(share, partFileName, maxDirSize, skipNonExistingFiles, skipParentFilesList, forceFastCopy, verbosity);
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  int exitCode = 0;
+  for (auto partExitCode : partExitCodes) {
+    exitCode = std::max(exitCode, partExitCode);
+  }
+  if (exitCode == 0) {
+    // concatenation stage: the intermediate files have matching compression,
+    // so this pass can copy baskets without re-decompressing them
+    printf("Concatenating %d intermediate files\n", jobs);
+    exitCode = mergeFiles(partFileNames, outputFileName, maxDirSize, false, skipParentFilesList, true, verbosity);
+  }
+  for (auto const& partFileName : partFileNames) {
+    gSystem->Unlink(partFileName.c_str());
+  }
+
+  return exitCode;
+}
@@ -15,7 +15,7 @@ const char* removeVersionSuffix(const char* treeName)
 {
   // remove version suffix, e.g. O2v0_001 becomes O2v0
   // it is also intended that O2track_iu becomes O2track
-  static TString tmp;
+  thread_local TString tmp;
   tmp = treeName;
   if (auto pos = tmp.First('_'); pos >= 0) {
     tmp.Remove(pos);
@@ -30,7 +30,7 @@ const char* getTableName(const char* branchName, const char* treeName)
   //   fIndexArray<Table>[_<Suffix>]
   //   fIndexSlice<Table>[_<Suffix>]
   // if <Table> is empty it is a self index and treeName is used as table name
-  static TString tableName;
+  thread_local TString tableName;
   tableName = branchName;
   if (tableName.BeginsWith("fIndexArray") || tableName.BeginsWith("fIndexSlice")) {
     tableName.Remove(0, 11);
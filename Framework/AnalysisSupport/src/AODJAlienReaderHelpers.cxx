@@ -41,6 +41,8 @@
 #include <arrow/table.h>
 #include <arrow/util/key_value_metadata.h>
 
+#include <sstream>
+
 using namespace o2;
 using namespace o2::aod;
 
@@ -158,6 +160,12 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         LOGP(error, "Check the JSON document! Can not be properly parsed!");
       }
     }
+    if (options.isSet("aod-file-readahead-depth")) {
+      didir->setFilePrefetchDepth(options.get<int>("aod-file-readahead-depth"));
+    }
+    if (options.isSet("aod-decode-threads")) {
+      didir->setDecodeThreadCount(options.get<int>("aod-decode-threads"));
+    }
 
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
@@ -184,6 +192,30 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       }
     }
 
+    // restrict branch reading to the columns the subscribing tasks declare
+    if (options.isSet("aod-prune-unused-columns") && options.get<bool>("aod-prune-unused-columns")) {
+      for (auto& route : requestedTables) {
+        auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+        auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
+        for (auto& entry : route.matcher.metadata) {
+          if (entry.type != VariantType::String || entry.name.rfind("columns:", 0) != 0) {
+            continue;
+          }
+          std::vector<std::string> columns;
+          std::stringstream ss(entry.defaultValue.get<std::string>());
+          std::string column;
+          while (std::getline(ss, column, ',')) {
+            if (!column.empty()) {
+              columns.emplace_back(column);
+            }
+          }
+          if (!columns.empty()) {
+            didir->setTreeColumns(dh, std::move(columns));
+          }
+        }
+      }
+    }
+
     auto fileCounter = std::make_shared<int>(0);
     auto numTF = std::make_shared<int>(-1);
     return adaptStateless([TFNumberHeader,
@@ -26,24 +26,18 @@
 #include "TGrid.h"
 #include "TObjString.h"
 #include "TMap.h"
+#include "TROOT.h"
 
 #include <uv.h>
 
+#include <mutex>
+
 #if __has_include(<TJAlienFile.h>)
 #include <TJAlienFile.h>
 
 #include <utility>
 #endif
 
-std::vector<std::string> getColumnNames(o2::header::DataHeader dh)
-{
-  auto description = std::string(dh.dataDescription.str);
-  auto origin = std::string(dh.dataOrigin.str);
-
-  // default: column names = {}
-  return {};
-}
-
 namespace o2::framework
 {
 using namespace rapidjson;
@@ -123,11 +117,30 @@ bool DataInputDescriptor::setFile(int counter)
     }
     closeInputFile();
   }
-  mcurrentFile = TFile::Open(filename.c_str());
+  // use the file which was opened ahead of time, if we have one
+  TFile* prefetched = nullptr;
+  while (!mPrefetchedFiles.empty()) {
+    auto& front = mPrefetchedFiles.front();
+    if (front.counter < counter) {
+      if (auto* stale = front.file.get()) {
+        stale->Close();
+        delete stale;
+      }
+      mPrefetchedFiles.pop_front();
+      continue;
+    }
+    if (front.counter == counter) {
+      prefetched = front.file.get();
+      mPrefetchedFiles.pop_front();
+    }
+    break;
+  }
+  mcurrentFile = prefetched != nullptr ? prefetched : TFile::Open(filename.c_str());
   if (!mcurrentFile) {
     throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
   }
   mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
+  schedulePrefetch(counter + 1);
 
   // get the parent file map if exists
   mParentFileMap = (TMap*)mcurrentFile->Get("parentFiles"); // folder name (DF_XXX) --> parent file (absolute path)
@@ -255,6 +268,7 @@ DataInputDescriptor* DataInputDescriptor::getParentFile(int counter, int numTF,
 
   LOGP(info, "Opening parent file {} for DF {}", parentFileName->GetString().Data(), folderName.c_str());
   mParentFile = new DataInputDescriptor(mAlienSupport, mLevel + 1, mMonitoring, mAllowedParentLevel, mParentFileReplacement);
+  mParentFile->setDecodeThreadCount(mDecodeThreads);
   mParentFile->mdefaultFilenamesPtr = new std::vector<FileNameHolder*>;
   mParentFile->mdefaultFilenamesPtr->emplace_back(makeFileNameHolder(parentFileName->GetString().Data()));
   mParentFile->fillInputfiles();
@@ -292,6 +306,34 @@ void DataInputDescriptor::printFileStatistics()
   LOGP(info, "Read info: {}", monitoringInfo);
 }
 
+void DataInputDescriptor::schedulePrefetch(int fromCounter)
+{
+  if (mPrefetchDepth <= 0) {
+    return;
+  }
+  // TFile::Open happens on a background thread.
+  static std::once_flag once;
+  std::call_once(once, []() { ROOT::EnableThreadSafety(); });
+  int next = mPrefetchedFiles.empty() ? fromCounter : mPrefetchedFiles.back().counter + 1;
+  for (; next < getNumberInputfiles() && next < fromCounter + mPrefetchDepth; ++next) {
+    auto filename = mfilenames[next]->fileName;
+    mPrefetchedFiles.push_back({next, std::async(std::launch::async, [filename]() -> TFile* {
+                                  return TFile::Open(filename.c_str());
+                                })});
+  }
+}
+
+void DataInputDescriptor::discardPrefetchedFiles()
+{
+  for (auto& prefetched : mPrefetchedFiles) {
+    if (auto* file = prefetched.file.get()) {
+      file->Close();
+      delete file;
+    }
+  }
+  mPrefetchedFiles.clear();
+}
+
 void DataInputDescriptor::closeInputFile()
 {
   if (mcurrentFile) {
@@ -363,7 +405,7 @@ int DataInputDescriptor::findDFNumber(int file, std::string dfName)
   return it - dfList.begin();
 }
 
-bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
+bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, std::vector<std::string> const& colnames, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
 {
   auto ioStart = uv_hrtime();
 
@@ -384,7 +426,7 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
         throw std::runtime_error(fmt::format(R"(DF {} listed in parent file map but not found in the corresponding file "{}")", fileAndFolder.folderName, parentFile->mcurrentFile->GetName()));
       }
       // first argument is 0 as the parent file object contains only 1 file
-      return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, totalSizeCompressed, totalSizeUncompressed);
+      return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, colnames, totalSizeCompressed, totalSizeUncompressed);
     }
     throw std::runtime_error(fmt::format(R"(Couldn't get TTree "{}" from "{}". Please check https://aliceo2group.github.io/analysis-framework/docs/troubleshooting/#tree-not-found for more information.)", fileAndFolder.folderName + "/" + treename, fileAndFolder.file->GetName()));
   }
@@ -395,7 +437,6 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
 
   // add branches to read
   // fill the table
-  auto colnames = getColumnNames(dh);
   t2t->setLabel(tree->GetName());
   if (colnames.size() == 0) {
     totalSizeCompressed += tree->GetZipBytes();
@@ -404,12 +445,15 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   } else {
     for (auto& colname : colnames) {
       TBranch* branch = tree->GetBranch(colname.c_str());
+      if (branch == nullptr) {
+        continue;
+      }
       totalSizeCompressed += branch->GetZipBytes("*");
       totalSizeUncompressed += branch->GetTotBytes("*");
     }
-    t2t->addAllColumns(tree, std::move(colnames));
+    t2t->addAllColumns(tree, std::vector<std::string>{colnames});
   }
-  t2t->fill(tree);
+  t2t->fill(tree, mDecodeThreads);
   delete tree;
 
   mIOTime += (uv_hrtime() - ioStart);
@@ -761,14 +805,39 @@ bool DataInputDirector::readTree(DataAllocator& outputs, header::DataHeader dh,
     treename = aod::datamodel::getTreeName(dh);
   }
 
-  return didesc->readTree(outputs, dh, counter, numTF, treename, totalSizeCompressed, totalSizeUncompressed);
+  static const std::vector<std::string> allColumns;
+  auto columns = mTreeColumns.find(dh.dataOrigin.as<std::string>() + "/" + dh.dataDescription.as<std::string>());
+  return didesc->readTree(outputs, dh, counter, numTF, treename, columns != mTreeColumns.end() ? columns->second : allColumns, totalSizeCompressed, totalSizeUncompressed);
+}
+
+void DataInputDirector::setTreeColumns(header::DataHeader dh, std::vector<std::string> columns)
+{
+  mTreeColumns[dh.dataOrigin.as<std::string>() + "/" + dh.dataDescription.as<std::string>()] = std::move(columns);
 }
 
 void DataInputDirector::closeInputFiles()
 {
   mdefaultDataInputDescriptor->closeInputFile();
+  mdefaultDataInputDescriptor->discardPrefetchedFiles();
   for (auto didesc : mdataInputDescriptors) {
     didesc->closeInputFile();
+    didesc->discardPrefetchedFiles();
+  }
+}
+
+void DataInputDirector::setFilePrefetchDepth(int depth)
+{
+  mdefaultDataInputDescriptor->setFilePrefetchDepth(depth);
+  for (auto didesc : mdataInputDescriptors) {
+    didesc->setFilePrefetchDepth(depth);
+  }
+}
+
+void DataInputDirector::setDecodeThreadCount(int threads)
+{
+  mdefaultDataInputDescriptor->setDecodeThreadCount(threads);
+  for (auto didesc : mdataInputDescriptors) {
+    didesc->setDecodeThreadCount(threads);
   }
 }
 
@@ -16,7 +16,10 @@
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/DataAllocator.h"
 
+#include <deque>
+#include <future>
 #include <regex>
+#include <unordered_map>
 #include "rapidjson/fwd.h"
 
 namespace o2::monitoring
@@ -83,12 +86,21 @@ class DataInputDescriptor
   int getTimeFramesInFile(int counter);
   int getReadTimeFramesInFile(int counter);
 
-  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
+  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, std::vector<std::string> const& colnames, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
 
   void printFileStatistics();
   void closeInputFile();
   bool isAlienSupportOn() { return mAlienSupport; }
 
+  /// Set how many input files ahead of the current one are opened
+  /// asynchronously. 0 disables the prefetching.
+  void setFilePrefetchDepth(int depth) { mPrefetchDepth = depth; }
+  /// Set how many threads decompress and convert branches when reading
+  /// a tree. 1 keeps the single-threaded behaviour.
+  void setDecodeThreadCount(int threads) { mDecodeThreads = threads; }
+  /// Discard any file which was opened ahead but never used.
+  void discardPrefetchedFiles();
+
  private:
   std::string minputfilesFile = "";
   std::string* minputfilesFilePtr = nullptr;
@@ -112,6 +124,18 @@ class DataInputDescriptor
 
   uint64_t mIOTime = 0;
   uint64_t mCurrentFileStartedAt = 0;
+
+  /// Files opened ahead of time on a background thread, so that on
+  /// remote storage the open latency is hidden behind the processing
+  /// of the current file.
+  struct PrefetchedFile {
+    int counter = -1;
+    std::future<TFile*> file;
+  };
+  void schedulePrefetch(int fromCounter);
+  std::deque<PrefetchedFile> mPrefetchedFiles;
+  int mPrefetchDepth = 0;
+  int mDecodeThreads = 1;
 };
 
 class DataInputDirector
@@ -136,6 +160,13 @@ class DataInputDirector
   void setFilenamesRegex(std::string dfn) { mFilenameRegex = dfn; }
   bool readJson(std::string const& fnjson);
   void closeInputFiles();
+  /// Forward the file readahead depth to all the input descriptors.
+  void setFilePrefetchDepth(int depth);
+  /// Forward the branch decode thread count to all the input descriptors.
+  void setDecodeThreadCount(int threads);
+  /// Restrict the branches read for the table identified by dh to the
+  /// given column names. An empty list (the default) reads everything.
+  void setTreeColumns(header::DataHeader dh, std::vector<std::string> columns);
 
   // getters
   DataInputDescriptor* getDataInputDescriptor(header::DataHeader dh);
@@ -165,6 +196,9 @@ class DataInputDirector
   bool mDebugMode = false;
   bool mAlienSupport = false;
 
+  // per-table column selection, keyed by "origin/description"
+  std::unordered_map<std::string, std::vector<std::string>> mTreeColumns;
+
   bool readJsonDocument(rapidjson::Document* doc);
   bool isValid();
 };
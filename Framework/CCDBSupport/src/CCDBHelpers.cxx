@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "CCDBHelpers.h"
+#include "SharedConditionCache.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/Logger.h"
 #include "Framework/TimingInfo.h"
@@ -23,7 +24,11 @@
 #include <typeinfo>
 #include <TError.h>
 #include <TMemFile.h>
+#include <chrono>
+#include <cstring>
 #include <functional>
+#include <future>
+#include <vector>
 
 O2_DECLARE_DYNAMIC_LOG(ccdb);
 
@@ -42,6 +47,15 @@ struct CCDBFetcherHelper {
     int lastCheckedTF = 0;
   };
 
+  /// Result of a background fetch for the next validity interval of a path.
+  /// An empty payload means the prefetch failed and the synchronous path
+  /// should be used as before.
+  struct PrefetchedCondition {
+    o2::pmr::vector<char> payload;
+    std::string etag;
+    size_t cacheValidUntil = 0;
+  };
+
   struct RemapMatcher {
     std::string path;
   };
@@ -61,6 +75,10 @@ struct CCDBFetcherHelper {
   int queryPeriodGlo = 1;
   int queryPeriodFactor = 1;
   int64_t timeToleranceMS = 5000;
+  bool shareConditions = false;    // share fetched payloads with peer fetchers on this node
+  bool prefetchConditions = false; // fetch the next validity interval's objects in the background
+  int64_t prefetchMarginMS = 10000;
+  std::unordered_map<std::string, std::future<PrefetchedCondition>> prefetches;
 
   o2::ccdb::CcdbApi& getAPI(const std::string& path)
   {
@@ -197,57 +215,193 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
 
   auto sid = _o2_signpost_id_t{(int64_t)timingInfo.timeslice};
   O2_SIGNPOST_START(ccdb, sid, "populateCacheWith", "Starting to populate cache with CCDB objects");
-  for (auto& route : helper->routes) {
-    int64_t timestampToUse = timestamp;
-    O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Fetching object for route %{public}s", DataSpecUtils::describe(route.matcher).data());
-    objCnt++;
-    auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
-    Output output{concrete.origin, concrete.description, concrete.subSpec};
-    auto&& v = allocator.makeVector<char>(output);
-    std::map<std::string, std::string> metadata;
-    std::map<std::string, std::string> headers;
+  // First pass: parse the per-route query configuration and decide which paths
+  // are due for a validity check. All cached paths due for one are then polled
+  // with a single batch of overlapped HEAD requests, so the polling cost stays
+  // a single round trip regardless of the topology size; only the paths for
+  // which a newer version exists go through the conditional GET below.
+  struct RouteState {
     std::string path = "";
+    std::map<std::string, std::string> metadata;
+    int64_t timestampToUse;
     std::string etag = "";
-    int chRate = helper->queryPeriodGlo;
     bool checkValidity = false;
+    bool headUpToDate = false;                        // the batched poll confirmed the cached version
+    std::map<std::string, std::string> headHeaders{}; // reply headers of the batched poll
+  };
+  std::vector<RouteState> routeStates;
+  routeStates.reserve(helper->routes.size());
+  for (auto& route : helper->routes) {
+    auto& state = routeStates.emplace_back();
+    state.timestampToUse = timestamp;
+    int chRate = helper->queryPeriodGlo;
     for (auto& meta : route.matcher.metadata) {
       if (meta.name == "ccdb-path") {
-        path = meta.defaultValue.get<std::string>();
+        state.path = meta.defaultValue.get<std::string>();
       } else if (meta.name == "ccdb-run-dependent" && meta.defaultValue.get<int>() > 0) {
         if (meta.defaultValue.get<int>() == 1) {
-          metadata["runNumber"] = dtc.runNumber;
+          state.metadata["runNumber"] = dtc.runNumber;
         } else if (meta.defaultValue.get<int>() == 2) {
-          timestampToUse = std::stoi(dtc.runNumber);
+          state.timestampToUse = std::stoi(dtc.runNumber);
         } else {
+          auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
           LOGP(fatal, "Undefined run-dependent option {} for spec {}/{}/{}", meta.defaultValue.get<int>(), concrete.origin.as<std::string>(), concrete.description.as<std::string>(), int(concrete.subSpec));
         }
       } else if (isPrefix(ccdbMetadataPrefix, meta.name)) {
         std::string key = meta.name.substr(ccdbMetadataPrefix.size());
         auto value = meta.defaultValue.get<std::string>();
         O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Adding metadata %{public}s: %{public}s to the request", key.data(), value.data());
-        metadata[key] = value;
+        state.metadata[key] = value;
       } else if (meta.name == "ccdb-query-rate") {
         chRate = meta.defaultValue.get<int>() * helper->queryPeriodFactor;
       }
     }
-    const auto url2uuid = helper->mapURL2UUID.find(path);
+    const auto url2uuid = helper->mapURL2UUID.find(state.path);
     if (url2uuid != helper->mapURL2UUID.end()) {
-      etag = url2uuid->second.etag;
+      state.etag = url2uuid->second.etag;
       // We check validity every chRate timeslices or if the cache is expired
       uint64_t validUntil = url2uuid->second.cacheValidUntil;
       // When the cache was populated. If the cache was populated after the timestamp, we need to check validity.
       uint64_t cachePopulatedAt = url2uuid->second.cachePopulatedAt;
       // If timestamp is before the time the element was cached or after the claimed validity, we need to check validity, again
       // when online.
-      bool cacheExpired = (validUntil <= timestampToUse) || (timestamp < cachePopulatedAt);
-      checkValidity = (std::abs(int(timingInfo.tfCounter - url2uuid->second.lastCheckedTF)) >= chRate) && (isOnline || cacheExpired);
+      bool cacheExpired = (validUntil <= (uint64_t)state.timestampToUse) || (timestamp < (int64_t)cachePopulatedAt);
+      state.checkValidity = (std::abs(int(timingInfo.tfCounter - url2uuid->second.lastCheckedTF)) >= chRate) && (isOnline || cacheExpired);
     } else {
-      checkValidity = true; // never skip check if the cache is empty
+      state.checkValidity = true; // never skip check if the cache is empty
+    }
+  }
+  std::unordered_map<o2::ccdb::CcdbApi*, std::vector<size_t>> pollPlan;
+  for (size_t i = 0; i < routeStates.size(); i++) {
+    auto& state = routeStates[i];
+    auto& api = helper->getAPI(state.path);
+    if (state.checkValidity && !state.etag.empty() && !api.isSnapshotMode()) {
+      pollPlan[&api].push_back(i);
+    }
+  }
+  for (auto& [api, indices] : pollPlan) {
+    if (indices.size() < 2) {
+      continue; // nothing to gain from batching a single request
+    }
+    std::vector<o2::ccdb::CcdbApi::UpdateCheck> updateChecks;
+    updateChecks.reserve(indices.size());
+    for (auto i : indices) {
+      auto& state = routeStates[i];
+      updateChecks.emplace_back(state.path, state.metadata, state.timestampToUse, state.etag);
+      updateChecks.back().createdNotAfter = helper->createdNotAfter;
+      updateChecks.back().createdNotBefore = helper->createdNotBefore;
     }
+    api->checkBatchUpToDate(updateChecks);
+    for (size_t j = 0; j < indices.size(); j++) {
+      routeStates[indices[j]].headUpToDate = updateChecks[j].upToDate;
+      routeStates[indices[j]].headHeaders = std::move(updateChecks[j].headers);
+    }
+  }
+  for (auto& route : helper->routes) {
+    O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Fetching object for route %{public}s", DataSpecUtils::describe(route.matcher).data());
+    objCnt++;
+    auto& state = routeStates[objCnt];
+    int64_t timestampToUse = state.timestampToUse;
+    auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+    Output output{concrete.origin, concrete.description, concrete.subSpec};
+    auto&& v = allocator.makeVector<char>(output);
+    std::map<std::string, std::string>& metadata = state.metadata;
+    std::map<std::string, std::string> headers;
+    std::string& path = state.path;
+    std::string etag = state.etag;
+    bool checkValidity = state.checkValidity;
+    const auto url2uuid = helper->mapURL2UUID.find(path);
 
     O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "checkValidity is %{public}s for tfID %d of %{public}s", checkValidity ? "true" : "false", timingInfo.tfCounter, path.data());
 
     const auto& api = helper->getAPI(path);
+    // Before the very first fetch, check whether a peer fetcher on this node
+    // already published a payload for this path. If so, use its etag for the
+    // conditional query: when the server confirms it is still current we can
+    // copy the payload locally instead of downloading it again.
+    std::vector<char> sharedPayload;
+    bool etagFromShm = false;
+    if (helper->shareConditions && etag.empty() && !api.isSnapshotMode()) {
+      auto sharedEtag = SharedConditionCache::publishedEtag(path);
+      if (!sharedEtag.empty() && SharedConditionCache::lookup(path, sharedEtag, sharedPayload)) {
+        etag = sharedEtag;
+        etagFromShm = true;
+      }
+    }
+    // When prefetching is enabled we try to hide the latency of the fetch at a
+    // validity boundary: once the end of validity of the cached object comes
+    // close, the object for the next interval is requested in the background
+    // and crossing the boundary then amounts to adopting the staged blob
+    // rather than stalling the processing for a full round trip to the server.
+    if (helper->prefetchConditions && !api.isSnapshotMode()) {
+      auto slot = helper->prefetches.find(path);
+      if (slot != helper->prefetches.end() && slot->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto fetched = slot->second.get();
+        helper->prefetches.erase(slot);
+        bool cacheExpired = url2uuid == helper->mapURL2UUID.end() || url2uuid->second.cacheValidUntil <= (size_t)timestampToUse;
+        if (checkValidity && cacheExpired && !fetched.payload.empty() && fetched.cacheValidUntil > (size_t)timestampToUse) {
+          // the prefetched blob already carries its flat header, appended by
+          // the background task
+          v.resize(fetched.payload.size());
+          std::memcpy(v.data(), fetched.payload.data(), fetched.payload.size());
+          helper->mapURL2UUID[path].lastCheckedTF = timingInfo.tfCounter;
+          helper->mapURL2UUID[path].etag = fetched.etag;
+          helper->mapURL2UUID[path].cachePopulatedAt = timestampToUse;
+          helper->mapURL2UUID[path].cacheValidUntil = fetched.cacheValidUntil;
+          helper->mapURL2UUID[path].cacheMiss++;
+          helper->mapURL2UUID[path].minSize = std::min(v.size(), helper->mapURL2UUID[path].minSize);
+          helper->mapURL2UUID[path].maxSize = std::max(v.size(), helper->mapURL2UUID[path].maxSize);
+          if (helper->shareConditions) {
+            SharedConditionCache::publish(path, fetched.etag, v.data(), v.size());
+          }
+          auto cacheId = allocator.adoptContainer(output, std::move(v), DataAllocator::CacheStrategy::Always, header::gSerializationMethodCCDB);
+          helper->mapURL2DPLCache[path] = cacheId;
+          O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Using prefetched %{public}s for %{public}s (DPL id %" PRIu64 ")", path.data(), fetched.etag.data(), cacheId.value);
+          continue;
+        }
+        // a prefetch which does not cover the current timestamp is simply
+        // dropped and we fall through to the synchronous query below
+      }
+      // Schedule a prefetch for the next validity interval once we are within
+      // the configured margin of the end of validity of the cached object.
+      if (url2uuid != helper->mapURL2UUID.end() && helper->prefetches.count(path) == 0) {
+        auto validUntil = (int64_t)url2uuid->second.cacheValidUntil;
+        if (validUntil > timestampToUse && validUntil - timestampToUse < helper->prefetchMarginMS) {
+          O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Prefetching %{public}s for timestamp %" PRId64, path.data(), validUntil);
+          auto host = api.getURL();
+          auto notAfter = helper->createdNotAfter;
+          auto notBefore = helper->createdNotBefore;
+          helper->prefetches[path] = std::async(std::launch::async, [host, path, metadata, validUntil, notAfter, notBefore]() {
+            CCDBFetcherHelper::PrefetchedCondition fetched;
+            // CcdbApi is not meant to be shared between threads, use a
+            // private instance for the background query.
+            o2::ccdb::CcdbApi prefetchApi;
+            prefetchApi.init(host);
+            std::map<std::string, std::string> prefetchHeaders;
+            std::string noEtag;
+            o2::pmr::vector<char> payload;
+            prefetchApi.loadFileToMemory(payload, path, metadata, validUntil, &prefetchHeaders, noEtag, notAfter, notBefore);
+            if (prefetchHeaders.count("Error") != 0 || payload.empty()) {
+              return fetched;
+            }
+            fetched.etag = prefetchHeaders["ETag"];
+            fetched.cacheValidUntil = prefetchHeaders["Cache-Valid-Until"].empty() ? 0 : std::stoul(prefetchHeaders["Cache-Valid-Until"]);
+            o2::ccdb::CcdbApi::appendFlatHeader(payload, prefetchHeaders);
+            fetched.payload = std::move(payload);
+            return fetched;
+          });
+        }
+      }
+    }
+    if (checkValidity && state.headUpToDate) {
+      // the batched HEAD poll already confirmed that the cached object is still
+      // the current version: refresh the bookkeeping and skip the conditional GET
+      helper->mapURL2UUID[path].lastCheckedTF = timingInfo.tfCounter;
+      if (!state.headHeaders["Cache-Valid-Until"].empty()) {
+        helper->mapURL2UUID[path].cacheValidUntil = std::stoul(state.headHeaders["Cache-Valid-Until"]);
+      }
+      checkValidity = false;
+    }
     if (checkValidity && (!api.isSnapshotMode() || etag.empty())) { // in the snapshot mode the object needs to be fetched only once
       LOGP(detail, "Loading {} for timestamp {}", path, timestampToUse);
       api.loadFileToMemory(v, path, metadata, timestampToUse, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
@@ -256,6 +410,24 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
         // FIXME: I should send a dummy message.
         continue;
       }
+      if (etagFromShm && v.empty()) {
+        // the payload published on this node is still current: adopt it
+        // without transferring the object again. The shared blob already
+        // carries its flat header, appended by whoever published it.
+        v.resize(sharedPayload.size());
+        std::memcpy(v.data(), sharedPayload.data(), sharedPayload.size());
+        helper->mapURL2UUID[path].lastCheckedTF = timingInfo.tfCounter;
+        helper->mapURL2UUID[path].etag = etag;
+        helper->mapURL2UUID[path].cachePopulatedAt = timestampToUse;
+        helper->mapURL2UUID[path].cacheValidUntil = headers["Cache-Valid-Until"].empty() ? 0 : std::stoul(headers["Cache-Valid-Until"]);
+        helper->mapURL2UUID[path].cacheMiss++;
+        helper->mapURL2UUID[path].minSize = std::min(v.size(), helper->mapURL2UUID[path].minSize);
+        helper->mapURL2UUID[path].maxSize = std::max(v.size(), helper->mapURL2UUID[path].maxSize);
+        auto cacheId = allocator.adoptContainer(output, std::move(v), DataAllocator::CacheStrategy::Always, header::gSerializationMethodCCDB);
+        helper->mapURL2DPLCache[path] = cacheId;
+        O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Sharing %{public}s for %{public}s from the node-local cache (DPL id %" PRIu64 ")", path.data(), etag.data(), cacheId.value);
+        continue;
+      }
       // printing in case we find a default entry
       if (headers.find("default") != headers.end()) {
         LOGP(detail, "******** Default entry used for {} ********", path);
@@ -268,6 +440,9 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
         helper->mapURL2UUID[path].minSize = std::min(v.size(), helper->mapURL2UUID[path].minSize);
         helper->mapURL2UUID[path].maxSize = std::max(v.size(), helper->mapURL2UUID[path].maxSize);
         api.appendFlatHeader(v, headers);
+        if (helper->shareConditions) {
+          SharedConditionCache::publish(path, headers["ETag"], v.data(), v.size());
+        }
         auto cacheId = allocator.adoptContainer(output, std::move(v), DataAllocator::CacheStrategy::Always, header::gSerializationMethodCCDB);
         helper->mapURL2DPLCache[path] = cacheId;
         O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Caching %{public}s for %{public}s (DPL id %" PRIu64 ")", path.data(), headers["ETag"].data(), cacheId.value);
@@ -282,6 +457,9 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
         helper->mapURL2UUID[path].minSize = std::min(v.size(), helper->mapURL2UUID[path].minSize);
         helper->mapURL2UUID[path].maxSize = std::max(v.size(), helper->mapURL2UUID[path].maxSize);
         api.appendFlatHeader(v, headers);
+        if (helper->shareConditions) {
+          SharedConditionCache::publish(path, headers["ETag"], v.data(), v.size());
+        }
         auto cacheId = allocator.adoptContainer(output, std::move(v), DataAllocator::CacheStrategy::Always, header::gSerializationMethodCCDB);
         helper->mapURL2DPLCache[path] = cacheId;
         O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Caching %{public}s for %{public}s (DPL id %" PRIu64 ")", path.data(), headers["ETag"].data(), cacheId.value);
@@ -314,6 +492,17 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
       helper->timeToleranceMS = options.get<int64_t>("condition-time-tolerance");
       helper->queryPeriodGlo = checkRate > 0 ? checkRate : std::numeric_limits<int>::max();
       helper->queryPeriodFactor = checkMult > 0 ? checkMult : 1;
+      helper->shareConditions = options.isSet("condition-shm-cache") && options.get<bool>("condition-shm-cache");
+      if (helper->shareConditions) {
+        LOGP(info, "Sharing fetched condition payloads with peer fetchers on this node");
+      }
+      helper->prefetchConditions = options.isSet("condition-prefetch") && options.get<bool>("condition-prefetch");
+      if (helper->prefetchConditions) {
+        if (options.isSet("condition-prefetch-margin")) {
+          helper->prefetchMarginMS = options.get<int64_t>("condition-prefetch-margin");
+        }
+        LOGP(info, "Prefetching condition objects {} ms before their end of validity", helper->prefetchMarginMS);
+      }
       LOGP(info, "CCDB Backend at: {}, validity check for every {} TF{}", defHost, helper->queryPeriodGlo, helper->queryPeriodFactor == 1 ? std::string{} : fmt::format(", (query for high-rate objects downscaled by {})", helper->queryPeriodFactor));
       LOGP(info, "Hook to enable signposts for CCDB messages at {}", (void*)&private_o2_log_ccdb->stacktrace);
       auto remapString = options.get<std::string>("condition-remap");
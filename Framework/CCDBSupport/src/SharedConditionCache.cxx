@@ -0,0 +1,182 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "SharedConditionCache.h"
+#include "Framework/Logger.h"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <fmt/format.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace bip = boost::interprocess;
+
+namespace
+{
+constexpr uint64_t BLOB_MAGIC = 0x4f32434342424c4fULL;  // "O2CCBBLO"
+constexpr uint64_t INDEX_MAGIC = 0x4f32434342494458ULL; // "O2CCBIDX"
+
+/// Header of an immutable payload segment. The path and the etag follow the
+/// header, the payload follows the strings. The ready flag is set last, with
+/// release semantics, once everything else is in place.
+struct BlobHeader {
+  uint64_t magic = BLOB_MAGIC;
+  std::atomic<uint32_t> ready{0};
+  uint32_t pathLen = 0;
+  uint32_t etagLen = 0;
+  uint64_t payloadSize = 0;
+};
+
+/// Per-path mutable index recording the etag published last. The version
+/// counter is odd while a writer updates the entry (seqlock style), so
+/// readers can detect a torn read and simply give up.
+struct IndexSegment {
+  uint64_t magic = INDEX_MAGIC;
+  std::atomic<uint32_t> version{0};
+  uint32_t pathLen = 0;
+  uint32_t etagLen = 0;
+  char path[2048] = {};
+  char etag[512] = {};
+};
+
+uint64_t fnv1a(std::string const& s)
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : s) {
+    hash ^= (unsigned char)c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+std::string indexName(std::string const& path)
+{
+  return fmt::format("o2_ccdb_idx_{:016x}", fnv1a(path));
+}
+
+std::string blobName(std::string const& path, std::string const& etag)
+{
+  return fmt::format("o2_ccdb_obj_{:016x}", fnv1a(path + "@" + etag));
+}
+} // namespace
+
+namespace o2::framework
+{
+
+std::string SharedConditionCache::publishedEtag(std::string const& path)
+{
+  try {
+    bip::shared_memory_object shm(bip::open_only, indexName(path).c_str(), bip::read_only);
+    bip::mapped_region region(shm, bip::read_only);
+    if (region.get_size() < sizeof(IndexSegment)) {
+      return "";
+    }
+    auto* index = static_cast<IndexSegment const*>(region.get_address());
+    if (index->magic != INDEX_MAGIC) {
+      return "";
+    }
+    auto before = index->version.load(std::memory_order_acquire);
+    if (before & 1) {
+      return ""; // a writer is updating the entry right now
+    }
+    if (index->pathLen != path.size() || index->pathLen >= sizeof(index->path) ||
+        index->etagLen == 0 || index->etagLen >= sizeof(index->etag) ||
+        std::memcmp(index->path, path.data(), path.size()) != 0) {
+      return ""; // stale entry or a hash collision with a different path
+    }
+    std::string etag(index->etag, index->etagLen);
+    if (index->version.load(std::memory_order_acquire) != before) {
+      return "";
+    }
+    return etag;
+  } catch (bip::interprocess_exception const&) {
+    return ""; // nothing published for this path yet
+  }
+}
+
+bool SharedConditionCache::lookup(std::string const& path, std::string const& etag, std::vector<char>& dest)
+{
+  try {
+    bip::shared_memory_object shm(bip::open_only, blobName(path, etag).c_str(), bip::read_only);
+    bip::mapped_region region(shm, bip::read_only);
+    if (region.get_size() < sizeof(BlobHeader)) {
+      return false;
+    }
+    auto* header = static_cast<BlobHeader const*>(region.get_address());
+    if (header->magic != BLOB_MAGIC || header->ready.load(std::memory_order_acquire) != 1) {
+      return false;
+    }
+    if (header->pathLen != path.size() || header->etagLen != etag.size() ||
+        region.get_size() < sizeof(BlobHeader) + header->pathLen + header->etagLen + header->payloadSize) {
+      return false;
+    }
+    auto* strings = static_cast<char const*>(region.get_address()) + sizeof(BlobHeader);
+    if (std::memcmp(strings, path.data(), path.size()) != 0 ||
+        std::memcmp(strings + header->pathLen, etag.data(), etag.size()) != 0) {
+      return false; // hash collision with a different object
+    }
+    dest.resize(header->payloadSize);
+    std::memcpy(dest.data(), strings + header->pathLen + header->etagLen, header->payloadSize);
+    return true;
+  } catch (bip::interprocess_exception const&) {
+    return false;
+  }
+}
+
+void SharedConditionCache::publish(std::string const& path, std::string const& etag, char const* data, size_t size)
+{
+  if (path.size() >= sizeof(IndexSegment::path) || etag.empty() || etag.size() >= sizeof(IndexSegment::etag)) {
+    return;
+  }
+  try {
+    // Publish the payload first, so that whoever sees the index entry finds
+    // the matching segment. If the segment exists already some other process
+    // beat us to it and there is nothing to do.
+    try {
+      bip::shared_memory_object shm(bip::create_only, blobName(path, etag).c_str(), bip::read_write);
+      shm.truncate(sizeof(BlobHeader) + path.size() + etag.size() + size);
+      bip::mapped_region region(shm, bip::read_write);
+      auto* header = new (region.get_address()) BlobHeader;
+      auto* strings = static_cast<char*>(region.get_address()) + sizeof(BlobHeader);
+      std::memcpy(strings, path.data(), path.size());
+      std::memcpy(strings + path.size(), etag.data(), etag.size());
+      std::memcpy(strings + path.size() + etag.size(), data, size);
+      header->pathLen = path.size();
+      header->etagLen = etag.size();
+      header->payloadSize = size;
+      header->ready.store(1, std::memory_order_release);
+    } catch (bip::interprocess_exception const&) {
+      // already published by a peer
+    }
+    bip::shared_memory_object index(bip::open_or_create, indexName(path).c_str(), bip::read_write);
+    bip::offset_t indexSize = 0;
+    if (!index.get_size(indexSize) || indexSize < (bip::offset_t)sizeof(IndexSegment)) {
+      index.truncate(sizeof(IndexSegment));
+    }
+    bip::mapped_region region(index, bip::read_write);
+    auto* entry = static_cast<IndexSegment*>(region.get_address());
+    if (entry->magic != INDEX_MAGIC) {
+      new (entry) IndexSegment;
+    }
+    entry->version.fetch_add(1, std::memory_order_acq_rel); // odd: update in progress
+    entry->pathLen = path.size();
+    entry->etagLen = etag.size();
+    std::memcpy(entry->path, path.data(), path.size());
+    std::memcpy(entry->etag, etag.data(), etag.size());
+    entry->version.fetch_add(1, std::memory_order_release);
+  } catch (bip::interprocess_exception const& e) {
+    LOGP(warning, "Could not publish {} to the node-local condition cache: {}", path, e.what());
+  }
+}
+
+} // namespace o2::framework
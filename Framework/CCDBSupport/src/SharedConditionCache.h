@@ -0,0 +1,56 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_SHAREDCONDITIONCACHE_H_
+#define O2_FRAMEWORK_SHAREDCONDITIONCACHE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Node-local shared cache for fetched CCDB payloads.
+///
+/// On a node running many workflows each fetcher device downloads and keeps
+/// its own copy of every condition payload, so large objects (e.g. the
+/// material LUT) end up duplicated once per workflow. This helper publishes
+/// the serialised payload (with its flat header already appended) in a named
+/// shared memory segment keyed by CCDB path + ETag, so that peer fetchers on
+/// the same node can skip the download and copy the blob locally after a
+/// cheap validity check against the server.
+///
+/// A small per-path index segment records the ETag published last, which
+/// peers use for their conditional query: if the server confirms the ETag is
+/// still current, the payload is taken from the shared segment instead of
+/// being transferred again. Payload segments are immutable once published;
+/// all operations are best effort and any failure simply falls back to a
+/// regular fetch.
+///
+/// Note that the segments outlive the publishing process (they sit in
+/// /dev/shm as o2_ccdb_*), which is what allows later starting workflows to
+/// profit from them. They are bounded by the turnover of distinct condition
+/// objects on the node.
+struct SharedConditionCache {
+  /// ETag of the payload last published for this path on this node,
+  /// empty if none is available.
+  static std::string publishedEtag(std::string const& path);
+  /// Copy the payload published for path + etag into dest. Returns false
+  /// if no matching segment is available.
+  static bool lookup(std::string const& path, std::string const& etag, std::vector<char>& dest);
+  /// Make the payload for path + etag visible to the other processes on
+  /// this node. Best effort: failures are logged and ignored.
+  static void publish(std::string const& path, std::string const& etag, char const* data, size_t size);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_SHAREDCONDITIONCACHE_H_
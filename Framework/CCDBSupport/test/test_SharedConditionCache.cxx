@@ -0,0 +1,52 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework SharedConditionCache
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "../src/SharedConditionCache.h"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestPublishAndLookup)
+{
+  // make the path unique per run, the segments are node-global
+  auto path = fmt::format("Test/SharedConditionCache/{}", getpid());
+
+  BOOST_CHECK_EQUAL(SharedConditionCache::publishedEtag(path), "");
+  std::vector<char> dest;
+  BOOST_CHECK_EQUAL(SharedConditionCache::lookup(path, "\"deadbeef\"", dest), false);
+
+  std::vector<char> payload{'c', 'o', 'n', 'd', '\0', 'o', 'b', 'j'};
+  SharedConditionCache::publish(path, "\"deadbeef\"", payload.data(), payload.size());
+
+  BOOST_CHECK_EQUAL(SharedConditionCache::publishedEtag(path), "\"deadbeef\"");
+  BOOST_CHECK_EQUAL(SharedConditionCache::lookup(path, "\"deadbeef\"", dest), true);
+  BOOST_REQUIRE_EQUAL(dest.size(), payload.size());
+  BOOST_CHECK(std::equal(dest.begin(), dest.end(), payload.begin()));
+
+  // only the matching etag resolves
+  BOOST_CHECK_EQUAL(SharedConditionCache::lookup(path, "\"cafe\"", dest), false);
+
+  // publishing a newer object moves the index to the new etag, the old
+  // payload stays reachable for whoever still holds its etag
+  std::vector<char> payload2{'n', 'e', 'w'};
+  SharedConditionCache::publish(path, "\"cafe\"", payload2.data(), payload2.size());
+  BOOST_CHECK_EQUAL(SharedConditionCache::publishedEtag(path), "\"cafe\"");
+  BOOST_CHECK_EQUAL(SharedConditionCache::lookup(path, "\"cafe\"", dest), true);
+  BOOST_REQUIRE_EQUAL(dest.size(), payload2.size());
+  BOOST_CHECK_EQUAL(SharedConditionCache::lookup(path, "\"deadbeef\"", dest), true);
+}
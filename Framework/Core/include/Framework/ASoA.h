@@ -671,6 +671,7 @@ struct FilteredIndexPolicy : IndexPolicyBase {
       mMaxSelection(selection.size()),
       nRows{rows}
   {
+    detectContiguous();
     this->setCursor(0);
   }
 
@@ -678,6 +679,7 @@ struct FilteredIndexPolicy : IndexPolicyBase {
   {
     mSelectedRows = selection;
     mMaxSelection = selection.size();
+    detectContiguous();
     this->setCursor(0);
   }
 
@@ -756,12 +758,35 @@ struct FilteredIndexPolicy : IndexPolicyBase {
  private:
   inline void updateRow()
   {
-    this->mRowIndex = O2_BUILTIN_LIKELY(mSelectionRow < mMaxSelection) ? mSelectedRows[mSelectionRow] : -1;
+    // For a contiguous selection we can compute the row directly, which
+    // spares the data-dependent load from the selection vector and lets
+    // the surrounding loop advance linearly over the columns.
+    this->mRowIndex = O2_BUILTIN_LIKELY(mSelectionRow < mMaxSelection)
+                        ? (mContiguous ? mFirstSelectedRow + mSelectionRow : mSelectedRows[mSelectionRow])
+                        : -1;
+  }
+
+  /// Filters which survive as a single dense range (e.g. slices or time
+  /// windows) are extremely common, so we detect them once per selection
+  /// instead of paying the gather on every dereference.
+  void detectContiguous()
+  {
+    mContiguous = mMaxSelection != 0;
+    mFirstSelectedRow = mMaxSelection != 0 ? mSelectedRows[0] : 0;
+    for (int64_t i = 1; i < mMaxSelection; ++i) {
+      if (mSelectedRows[i] != mFirstSelectedRow + i) {
+        mContiguous = false;
+        break;
+      }
+    }
   }
+
   gsl::span<int64_t const> mSelectedRows;
   int64_t mSelectionRow = 0;
   int64_t mMaxSelection = 0;
+  int64_t mFirstSelectedRow = 0;
   int64_t nRows = 0;
+  bool mContiguous = false;
 };
 
 struct DefaultIndexPolicy : IndexPolicyBase {
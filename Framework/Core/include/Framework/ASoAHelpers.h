@@ -17,6 +17,7 @@
 #include "Framework/RuntimeError.h"
 #include <arrow/table.h>
 
+#include <algorithm>
 #include <iterator>
 #include <tuple>
 #include <utility>
@@ -198,6 +199,99 @@ void syncCategories(std::array<std::vector<BinningIndex>, K>& groupedIndices)
   }
 }
 
+/// Emits the strictly-upper pair combinations (i < j) of a single index
+/// range in flat blocks, as an alternative to advancing a pair of table
+/// iterators one combination at a time. The fill loops run over contiguous
+/// runs of the second index with no data-dependent branches, so they
+/// autovectorize, and the consumer iterates plain arrays:
+///
+///   SelfPairIndexBlockGenerator gen{tracks.size()};
+///   std::array<int64_t, SelfPairIndexBlockGenerator::DefaultBlockSize> i0, i1;
+///   while (auto n = gen.nextBlock(i0.data(), i1.data(), i0.size())) {
+///     for (auto k = 0U; k < n; ++k) {
+///       process(tracks.rawIteratorAt(i0[k]), tracks.rawIteratorAt(i1[k]));
+///     }
+///   }
+struct SelfPairIndexBlockGenerator {
+  constexpr static size_t DefaultBlockSize = 1024;
+
+  SelfPairIndexBlockGenerator(int64_t size) : mSize{size} {}
+
+  /// Fill first/second with up to n index pairs, returning how many were
+  /// produced. Zero signals that all combinations have been emitted.
+  size_t nextBlock(int64_t* first, int64_t* second, size_t n)
+  {
+    size_t filled = 0;
+    while (filled < n && mFirst < mSize - 1) {
+      auto run = std::min(static_cast<int64_t>(n - filled), mSize - mSecond);
+      for (int64_t k = 0; k < run; ++k) {
+        first[filled + k] = mFirst;
+        second[filled + k] = mSecond + k;
+      }
+      filled += run;
+      mSecond += run;
+      if (mSecond == mSize) {
+        ++mFirst;
+        mSecond = mFirst + 1;
+      }
+    }
+    return filled;
+  }
+
+ private:
+  int64_t mSize;
+  int64_t mFirst = 0;
+  int64_t mSecond = 1;
+};
+
+/// Same as SelfPairIndexBlockGenerator for strictly-upper triples
+/// (i < j < k) of a single index range.
+struct SelfTripleIndexBlockGenerator {
+  constexpr static size_t DefaultBlockSize = 1024;
+
+  SelfTripleIndexBlockGenerator(int64_t size) : mSize{size} {}
+
+  size_t nextBlock(int64_t* first, int64_t* second, int64_t* third, size_t n)
+  {
+    size_t filled = 0;
+    while (filled < n && mFirst < mSize - 2) {
+      auto run = std::min(static_cast<int64_t>(n - filled), mSize - mThird);
+      for (int64_t k = 0; k < run; ++k) {
+        first[filled + k] = mFirst;
+        second[filled + k] = mSecond;
+        third[filled + k] = mThird + k;
+      }
+      filled += run;
+      mThird += run;
+      if (mThird == mSize) {
+        ++mSecond;
+        if (mSecond == mSize - 1) {
+          ++mFirst;
+          mSecond = mFirst + 1;
+        }
+        mThird = mSecond + 1;
+      }
+    }
+    return filled;
+  }
+
+ private:
+  int64_t mSize;
+  int64_t mFirst = 0;
+  int64_t mSecond = 1;
+  int64_t mThird = 2;
+};
+
+/// Remap a block of positional indices through a selection, e.g. the
+/// selected rows of a Filtered table, so that block-generated combinations
+/// can address the underlying table directly.
+inline void mapIndexBlock(gsl::span<int64_t const> selection, int64_t* indices, size_t n)
+{
+  for (size_t k = 0; k < n; ++k) {
+    indices[k] = selection[indices[k]];
+  }
+}
+
 template <typename... Ts>
 struct CombinationsIndexPolicyBase {
   using CombinationType = std::tuple<typename Ts::iterator...>;
@@ -127,6 +127,17 @@ struct AnalysisDataProcessorBuilder {
     using metadata = typename aod::MetadataTrait<std::decay_t<O>>::metadata;
     std::vector<ConfigParamSpec> inputMetadata;
     inputMetadata.emplace_back(ConfigParamSpec{std::string{"control:"} + name, VariantType::Bool, value, {"\"\""}});
+    // record the column labels of the subscribed table, so that the reader
+    // can restrict branch reading to what the declared data model contains
+    auto fields = soa::createFieldsFromColumns(typename std::decay_t<O>::persistent_columns_t{});
+    std::string columns;
+    for (auto& field : fields) {
+      if (!columns.empty()) {
+        columns += ",";
+      }
+      columns += field->name();
+    }
+    inputMetadata.emplace_back(ConfigParamSpec{std::string{"columns:"} + metadata::tableLabel(), VariantType::String, columns, {"\"\""}});
     if constexpr (soa::is_soa_index_table_v<std::decay_t<O>> || soa::is_soa_extension_table_v<std::decay_t<O>>) {
       auto inputSources = getInputMetadata<std::decay_t<O>>();
       inputMetadata.insert(inputMetadata.end(), inputSources.begin(), inputSources.end());
@@ -50,13 +50,33 @@ struct ArrowTableSlicingCacheDef {
 struct ArrowTableSlicingCache {
   constexpr static ServiceKind service_kind = ServiceKind::Stream;
 
+  // Identity of the input a cache entry was computed from, so that
+  // repeated updates for the same dataframe can be skipped. The buffer is
+  // kept alive so that its address cannot be recycled for a new dataframe.
+  struct InputFingerprint {
+    std::shared_ptr<arrow::Buffer> buffer;
+    int64_t rows = -1;
+
+    bool matches(InputFingerprint const& other) const
+    {
+      return buffer != nullptr && other.buffer != nullptr &&
+             buffer->data() == other.buffer->data() && rows == other.rows;
+    }
+  };
+
   std::vector<StringPair> bindingsKeys;
   std::vector<std::shared_ptr<arrow::NumericArray<arrow::Int32Type>>> values;
   std::vector<std::shared_ptr<arrow::NumericArray<arrow::Int64Type>>> counts;
+  std::vector<InputFingerprint> fingerprints;
 
   std::vector<StringPair> bindingsKeysUnsorted;
   std::vector<std::vector<int>> valuesUnsorted;
   std::vector<ListVector> groups;
+  std::vector<InputFingerprint> fingerprintsUnsorted;
+
+  // hit/miss accounting, published as slicing_cache_hits / slicing_cache_misses
+  int64_t cacheHits = 0;
+  int64_t cacheMisses = 0;
 
   ArrowTableSlicingCache(std::vector<StringPair>&& bsks, std::vector<StringPair>&& bsksUnsorted = {});
 
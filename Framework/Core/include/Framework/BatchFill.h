@@ -0,0 +1,149 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_BATCHFILL_H_
+#define O2_FRAMEWORK_BATCHFILL_H_
+
+#include "Framework/BinningPolicy.h"
+#include "Framework/RuntimeError.h"
+
+#include <TH1.h>
+#include <TH2.h>
+
+#include <gsl/span>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Helpers to fill histograms from column spans in one pass instead of one
+/// TH1::Fill() per row. Bin indices for the whole batch are computed first
+/// in tight loops over the value spans, counts are accumulated in a flat
+/// array and scattered into the histogram bins once, together with a single
+/// statistics update. For fill-dominated QA tasks this avoids the per-entry
+/// ROOT call overhead.
+namespace batch_fill
+{
+
+/// Compute the bin index for every row of the given column spans with the
+/// given binning policy. The result uses the policy convention: -1 marks
+/// under-/overflow when the policy ignores them.
+template <std::size_t N, typename... Ts>
+void computeBins(BinningPolicyBase<N> const& policy, std::vector<int>& bins, gsl::span<Ts const>... columns)
+{
+  static_assert(sizeof...(Ts) == N, "There must be the same number of binning axes and value spans");
+  auto size = std::get<0>(std::tie(columns...)).size();
+  ((void)(columns.size() == size ? 0 : throw runtime_error("Batch fill: value spans differ in length")), ...);
+  bins.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    bins[i] = policy.getBin(std::make_tuple(columns[i]...));
+  }
+}
+
+/// Fill a 1-d histogram from a span of values in a single scatter pass.
+/// Equivalent to calling hist.Fill(x) for every element, but bin lookup,
+/// bin update and the statistics update are done batch-wise.
+inline void fill(TH1& hist, gsl::span<double const> xs)
+{
+  if (hist.GetSumw2N() > 0) {
+    // batched counting does not maintain the per-bin sum of squared
+    // weights, so fall back to per-entry filling
+    for (auto x : xs) {
+      hist.Fill(x);
+    }
+    return;
+  }
+  auto* axis = hist.GetXaxis();
+  std::vector<double> counts(hist.GetNbinsX() + 2, 0.);
+  double sumw = 0.;
+  double sumwx = 0.;
+  double sumwx2 = 0.;
+  for (auto x : xs) {
+    auto bin = axis->FindFixBin(x);
+    counts[bin] += 1.;
+    if (bin > 0 && bin <= hist.GetNbinsX()) {
+      sumw += 1.;
+      sumwx += x;
+      sumwx2 += x * x;
+    }
+  }
+  for (size_t bin = 0; bin < counts.size(); ++bin) {
+    if (counts[bin] != 0.) {
+      hist.AddBinContent(static_cast<int>(bin), counts[bin]);
+    }
+  }
+  double stats[4];
+  hist.GetStats(stats);
+  stats[0] += sumw;
+  stats[1] += sumw;
+  stats[2] += sumwx;
+  stats[3] += sumwx2;
+  hist.PutStats(stats);
+  hist.SetEntries(hist.GetEntries() + xs.size());
+}
+
+/// Fill a 2-d histogram from spans of x and y values in a single scatter pass.
+inline void fill(TH2& hist, gsl::span<double const> xs, gsl::span<double const> ys)
+{
+  if (xs.size() != ys.size()) {
+    throw runtime_error("Batch fill: value spans differ in length");
+  }
+  if (hist.GetSumw2N() > 0) {
+    for (size_t i = 0; i < xs.size(); ++i) {
+      hist.Fill(xs[i], ys[i]);
+    }
+    return;
+  }
+  auto* xAxis = hist.GetXaxis();
+  auto* yAxis = hist.GetYaxis();
+  auto nx = hist.GetNbinsX() + 2;
+  std::vector<double> counts(nx * (hist.GetNbinsY() + 2), 0.);
+  double sumw = 0.;
+  double sumwx = 0.;
+  double sumwx2 = 0.;
+  double sumwy = 0.;
+  double sumwy2 = 0.;
+  double sumwxy = 0.;
+  for (size_t i = 0; i < xs.size(); ++i) {
+    auto xBin = xAxis->FindFixBin(xs[i]);
+    auto yBin = yAxis->FindFixBin(ys[i]);
+    counts[xBin + nx * yBin] += 1.;
+    if (xBin > 0 && xBin <= hist.GetNbinsX() && yBin > 0 && yBin <= hist.GetNbinsY()) {
+      sumw += 1.;
+      sumwx += xs[i];
+      sumwx2 += xs[i] * xs[i];
+      sumwy += ys[i];
+      sumwy2 += ys[i] * ys[i];
+      sumwxy += xs[i] * ys[i];
+    }
+  }
+  for (size_t bin = 0; bin < counts.size(); ++bin) {
+    if (counts[bin] != 0.) {
+      hist.AddBinContent(static_cast<int>(bin), counts[bin]);
+    }
+  }
+  double stats[7];
+  hist.GetStats(stats);
+  stats[0] += sumw;
+  stats[1] += sumw;
+  stats[2] += sumwx;
+  stats[3] += sumwx2;
+  stats[4] += sumwy;
+  stats[5] += sumwy2;
+  stats[6] += sumwxy;
+  hist.PutStats(stats);
+  hist.SetEntries(hist.GetEntries() + xs.size());
+}
+
+} // namespace batch_fill
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_BATCHFILL_H_
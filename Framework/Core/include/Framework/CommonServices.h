@@ -71,11 +71,13 @@ struct CommonServices {
   static ServiceSpec dataRelayer();
   static ServiceSpec dataSender();
   static ServiceSpec tracingSpec();
+  static ServiceSpec profilerSpec();
   static ServiceSpec summaryServiceSpec();
   static ServiceSpec threadPool(int numWorkers);
   static ServiceSpec dataProcessingStats();
   static ServiceSpec dataProcessingStates();
   static ServiceSpec objectCache();
+  static ServiceSpec timesliceArenaSpec();
   static ServiceSpec timingInfoSpec();
   static ServiceSpec ccdbSupportSpec();
   static ServiceSpec decongestionSpec();
@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_COMPILEDMATCHER_H_
+#define O2_FRAMEWORK_COMPILEDMATCHER_H_
+
+#include "Framework/DataDescriptorMatcher.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace o2::framework::data_matcher
+{
+
+/// A DataDescriptorMatcher tree lowered once into a flat program which can
+/// be executed per message without walking the tree. The header stack is
+/// parsed a single time per invocation, leaves are dispatched via a plain
+/// switch and And / Or short-circuiting is preserved via jump instructions,
+/// so the matching semantics (including which variables get bound in the
+/// VariableContext) are identical to DataDescriptorMatcher::match.
+///
+/// Use this when the same matcher is evaluated at high rate, e.g. for the
+/// input routes of a device with many incoming messages.
+class CompiledMatcher
+{
+ public:
+  CompiledMatcher() = default;
+  /// Lower @a tree into a flat program. The tree is only needed during
+  /// compilation, leaf matchers are copied into the program.
+  explicit CompiledMatcher(DataDescriptorMatcher const& tree);
+
+  /// Equivalent to DataDescriptorMatcher::match(char const*, VariableContext&)
+  /// on the tree this was compiled from.
+  bool match(char const* d, VariableContext& context) const;
+
+  /// Number of instructions in the lowered program. Mostly for debugging
+  /// and tests.
+  [[nodiscard]] size_t size() const { return mProgram.size(); }
+
+ private:
+  enum struct OpCode : uint8_t {
+    MatchOrigin,      /// result = origins[arg].match(dh)
+    MatchDescription, /// result = descriptions[arg].match(dh)
+    MatchSubSpec,     /// result = subSpecs[arg].match(dh)
+    MatchStartTime,   /// result = startTimes[arg].match(dh, dph)
+    LoadConstant,     /// result = constants[arg]
+    Negate,           /// result = !result
+    Push,             /// push result on the operand stack
+    Xor,              /// result = pop() ^ result
+    JumpIfFalse,      /// if (!result) goto arg
+    JumpIfTrue        /// if (result) goto arg
+  };
+
+  struct Instruction {
+    OpCode code;
+    uint16_t arg = 0; /// leaf index or jump target, depending on the opcode
+  };
+
+  void lower(DataDescriptorMatcher const& node);
+  void lowerNode(Node const& node);
+  size_t emit(OpCode code, uint16_t arg = 0);
+
+  std::vector<Instruction> mProgram;
+  std::vector<OriginValueMatcher> mOrigins;
+  std::vector<DescriptionValueMatcher> mDescriptions;
+  std::vector<SubSpecificationTypeValueMatcher> mSubSpecs;
+  std::vector<StartTimeValueMatcher> mStartTimes;
+  std::vector<bool> mConstants;
+  bool mNeedsDataProcessingHeader = false;
+};
+
+} // namespace o2::framework::data_matcher
+
+#endif // O2_FRAMEWORK_COMPILEDMATCHER_H_
@@ -148,6 +148,12 @@ class DataAllocator
     static_assert(std::is_fundamental<T>::value, "UninitializedVector only allowed for fundamental types");
     using value_type = T;
   };
+  /// Growth policy for vectors created via @a make: the payload buffer is grown once to the
+  /// requested capacity up front instead of being repeatedly reallocated (and copied) in the
+  /// transport memory while the producer fills the vector.
+  struct Reserve {
+    size_t nElements = 0;
+  };
 
   DataAllocator(ServiceRegistryRef ref);
 
@@ -182,9 +188,18 @@ class DataAllocator
 
       // Note: initial payload size is 0 and will be set by the context before sending
       fair::mq::MessagePtr headerMessage = headerMessageFromOutput(spec, routeIndex, o2::header::gSerializationMethodNone, 0);
-      return context.add<MessageContext::VectorObject<ValueType, MessageContext::ContainerRefObject<std::vector<ValueType, o2::pmr::NoConstructAllocator<ValueType>>>>>(
-                      std::move(headerMessage), routeIndex, 0, std::forward<Args>(args)...)
-        .get();
+      if constexpr (sizeof...(Args) == 1 && std::is_same_v<std::tuple_element_t<0, std::tuple<Args..., void>>, Reserve>) {
+        auto [policy] = std::make_tuple(args...);
+        auto& buffer = context.add<MessageContext::VectorObject<ValueType, MessageContext::ContainerRefObject<std::vector<ValueType, o2::pmr::NoConstructAllocator<ValueType>>>>>(
+                                  std::move(headerMessage), routeIndex, 0)
+                         .get();
+        buffer.reserve(policy.nElements);
+        return buffer;
+      } else {
+        return context.add<MessageContext::VectorObject<ValueType, MessageContext::ContainerRefObject<std::vector<ValueType, o2::pmr::NoConstructAllocator<ValueType>>>>>(
+                        std::move(headerMessage), routeIndex, 0, std::forward<Args>(args)...)
+          .get();
+      }
     } else if constexpr (is_specialization_v<T, std::vector> && has_messageable_value_type<T>::value) {
       auto routeIndex = matchDataHeader(spec, timingInfo.timeslice);
       // this catches all std::vector objects with messageable value type before checking if is also
@@ -193,7 +208,14 @@ class DataAllocator
 
       // Note: initial payload size is 0 and will be set by the context before sending
       fair::mq::MessagePtr headerMessage = headerMessageFromOutput(spec, routeIndex, o2::header::gSerializationMethodNone, 0);
-      return context.add<MessageContext::VectorObject<ValueType>>(std::move(headerMessage), routeIndex, 0, std::forward<Args>(args)...).get();
+      if constexpr (sizeof...(Args) == 1 && std::is_same_v<std::tuple_element_t<0, std::tuple<Args..., void>>, Reserve>) {
+        auto [policy] = std::make_tuple(args...);
+        auto& buffer = context.add<MessageContext::VectorObject<ValueType>>(std::move(headerMessage), routeIndex, 0).get();
+        buffer.reserve(policy.nElements);
+        return buffer;
+      } else {
+        return context.add<MessageContext::VectorObject<ValueType>>(std::move(headerMessage), routeIndex, 0, std::forward<Args>(args)...).get();
+      }
     } else if constexpr (has_root_dictionary<T>::value == true && is_messageable<T>::value == false) {
       auto routeIndex = matchDataHeader(spec, timingInfo.timeslice);
       // Extended support for types implementing the Root ClassDef interface, both TObject
@@ -32,12 +32,14 @@ struct FileAndFolder {
 struct DataOutputDescriptor {
   /// Holds information concerning the writing of aod tables.
   /// The information includes the table specification, treename,
-  /// columns to save, and the file name
+  /// columns to save, the file name and the output format
 
   std::string tablename;
   std::string treename;
   std::string version;
   std::vector<std::string> colnames;
+  std::string outputFormat;
+  std::string compression;
   std::unique_ptr<data_matcher::DataDescriptorMatcher> matcher;
 
   DataOutputDescriptor(std::string sin);
@@ -86,6 +88,9 @@ struct DataOutputDirector {
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::string parentFileName);
 
+  // get the output file name for an Arrow-native (feather) descriptor
+  std::string getArrowFilePath(DataOutputDescriptor* dodesc, uint64_t folderNumber);
+
   // check file sizes
   bool checkFileSizes();
   // close all files
@@ -107,6 +112,7 @@ struct DataOutputDirector {
   std::vector<std::string> mfilenameBases;
   std::vector<TFile*> mfilePtrs;
   std::vector<TMap*> mParentMaps;
+  std::vector<std::string> mArrowFilenames;
   bool mdebugmode = false;
   int mfileCounter = 1;
   float mmaxfilesize = -1.;
@@ -65,6 +65,13 @@ enum struct ProcessingStatsId : short {
   RESOURCES_MISSING,
   RESOURCES_INSUFFICIENT,
   RESOURCES_SATISFACTORY,
+  RELAYER_SLOT_OCCUPANCY,
+  SLICING_CACHE_HITS,
+  SLICING_CACHE_MISSES,
+  LAST_QUEUE_LATENCY,
+  LAST_TF_LIFETIME,
+  TIMEFRAMES_IN_FLIGHT,
+  OLDEST_TF_AGE_MS,
   AVAILABLE_MANAGED_SHM_BASE = 512,
 };
 
@@ -73,6 +80,12 @@ struct DataProcessingStats {
   // Parameters for the default behaviour
   struct DefaultConfig {
     int64_t minOnlinePublishInterval = 0;
+    /// Cap (in ms) for the exponential backoff of the forced refresh of
+    /// unchanged metrics. Every refresh which finds a metric unchanged
+    /// doubles the latency of the next one, up to this value, so that
+    /// static metrics stop flooding the driver in large topologies.
+    /// 0 keeps the fixed per-metric maxRefreshLatency behaviour.
+    int64_t maxUnchangedRefreshLatency = 0;
   };
 
   DefaultConfig config = {};
@@ -142,8 +155,9 @@ struct DataProcessingStats {
   // It also prevents that we send the same metric multiple times, because
   // we keep track of the time of the last update.
   struct UpdateInfo {
-    int64_t timestamp = 0;     // When the update actually took place
-    int64_t lastPublished = 0; // When the update was last published
+    int64_t timestamp = 0;      // When the update actually took place
+    int64_t lastPublished = 0;  // When the update was last published
+    int unchangedRefreshes = 0; // Consecutive forced refreshes which found the metric unchanged
   };
 
   struct MetricSpec {
@@ -15,10 +15,30 @@
 
 namespace o2
 {
+namespace header
+{
+struct BaseHeader;
+struct DataHeader;
+} // namespace header
+
 namespace framework
 {
 
 struct InputSpec;
+struct DataProcessingHeader;
+
+/// Decoded pointers to the standard headers of the stack behind a DataRef,
+/// filled in once when the ref is materialized so that the accessors in
+/// DataRefUtils are plain member loads rather than a walk of the header
+/// stack per query. All pointers nullptr means the stack was not decoded
+/// (e.g. for refs built by hand in tests) and accessors fall back to
+/// walking it.
+struct DecodedHeaders {
+  const o2::header::DataHeader* dataHeader = nullptr;
+  const DataProcessingHeader* processingHeader = nullptr;
+  /// first header in the stack which is neither of the two above, if any
+  const o2::header::BaseHeader* firstOther = nullptr;
+};
 
 struct DataRef {
   // FIXME: had to remove the second 'const' in const T* const
@@ -27,6 +47,7 @@ struct DataRef {
   const char* header = nullptr;
   const char* payload = nullptr;
   size_t payloadSize = 0;
+  DecodedHeaders decoded = {};
 };
 
 } // namespace framework
@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_DATAREFUTILS_H_
 
 #include "Framework/DataRef.h"
+#include "Framework/DataProcessingHeader.h"
 #include "Framework/RootSerializationSupport.h"
 #include "Framework/SerializationMethods.h"
 #include "Framework/DataSpecUtils.h"
@@ -181,10 +182,33 @@ struct DataRefUtils {
   static void* decodeCCDB(DataRef const& ref, std::type_info const& info);
   static std::map<std::string, std::string> extractCCDBHeaders(DataRef const& ref);
 
+  /// Decode the standard headers of the stack behind @a ref once, so that
+  /// the accessors below become plain member loads for them. Done when the
+  /// ref is materialized from the relayed messages; the full stack walk
+  /// per call is then only left for non-standard headers.
+  static void decodeHeaders(DataRef& ref)
+  {
+    using namespace o2::header;
+    if (ref.header == nullptr) {
+      return;
+    }
+    const BaseHeader* current = BaseHeader::get(reinterpret_cast<const std::byte*>(ref.header));
+    while (current != nullptr) {
+      if (current->description == DataHeader::sHeaderType && current->sanityCheck(DataHeader::sVersion)) {
+        ref.decoded.dataHeader = reinterpret_cast<const DataHeader*>(current);
+      } else if (current->description == DataProcessingHeader::sHeaderType && current->sanityCheck(DataProcessingHeader::sVersion)) {
+        ref.decoded.processingHeader = reinterpret_cast<const DataProcessingHeader*>(current);
+      } else if (ref.decoded.firstOther == nullptr) {
+        ref.decoded.firstOther = current;
+      }
+      current = current->next();
+    }
+  }
+
   static o2::header::DataHeader::PayloadSizeType getPayloadSize(const DataRef& ref)
   {
     using DataHeader = o2::header::DataHeader;
-    auto* header = o2::header::get<const DataHeader*>(ref.header);
+    auto* header = ref.decoded.dataHeader != nullptr ? ref.decoded.dataHeader : o2::header::get<const DataHeader*>(ref.header);
     if (!header) {
       return 0;
     }
@@ -204,6 +228,16 @@ struct DataRefUtils {
     using HeaderT = typename std::remove_pointer<T>::type;
     static_assert(std::is_pointer<T>::value && std::is_base_of<o2::header::BaseHeader, HeaderT>::value,
                   "pointer to BaseHeader-derived type required");
+    // the standard headers are decoded once per ref, use them when available
+    if constexpr (std::is_same_v<std::remove_const_t<HeaderT>, o2::header::DataHeader>) {
+      if (ref.decoded.dataHeader != nullptr) {
+        return static_cast<const HeaderT*>(ref.decoded.dataHeader);
+      }
+    } else if constexpr (std::is_same_v<std::remove_const_t<HeaderT>, DataProcessingHeader>) {
+      if (ref.decoded.processingHeader != nullptr) {
+        return static_cast<const HeaderT*>(ref.decoded.processingHeader);
+      }
+    }
     return o2::header::get<T>(ref.header);
   }
 
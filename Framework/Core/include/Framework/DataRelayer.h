@@ -14,6 +14,7 @@
 #include "Framework/RootSerializationSupport.h"
 #include "Framework/InputRoute.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/CompiledMatcher.h"
 #include "Framework/ForwardRoute.h"
 #include "Framework/CompletionPolicy.h"
 #include "Framework/MessageSet.h"
@@ -22,6 +23,8 @@
 #include "Framework/TimesliceSlot.h"
 #include "Framework/ServiceRegistryRef.h"
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <mutex>
 #include <vector>
@@ -130,6 +133,12 @@ class DataRelayer
   ///              separate parts
   /// @a onDrop function to be called if an message is dropped
   /// Notice that we expect that the header is an O2 Header Stack
+  /// Notice also that when multiple threads relay concurrently, a
+  /// caller which would otherwise block on the relayer lock stages
+  /// the messages in a per-channel shard and returns immediately with
+  /// `WillRelay`. Staged messages are drained by the next uncontended
+  /// `relay()` or by `getReadyToProcess()`, so completion always sees
+  /// them before deciding what to process.
   RelayChoice relay(void const* rawHeader,
                     std::unique_ptr<fair::mq::Message>* messages,
                     InputInfo const& info,
@@ -180,6 +189,16 @@ class DataRelayer
   uint32_t getRunNumberForSlot(TimesliceSlot slot);
   /// Get the creation time associated to a given slot
   uint64_t getCreationTimeForSlot(TimesliceSlot slot);
+  /// Get the time (ms since epoch) the first message for a given slot
+  /// was relayed, 0 if the slot never received anything.
+  uint64_t getFirstArrivalTimeForSlot(TimesliceSlot slot);
+  /// Occupied pipeline slots and the creation time of the oldest one,
+  /// used for the per node backpressure telemetry.
+  struct InFlightStats {
+    int count = 0;
+    uint64_t oldestCreation = 0; ///< 0 when no slot is occupied
+  };
+  InFlightStats getInFlightStats();
   /// Remove all pending messages
   void clear();
 
@@ -192,6 +211,45 @@ class DataRelayer
   [[nodiscard]] size_t getNumberOfUniqueInputs() const { return mDistinctRoutesIndex.size(); }
 
  private:
+  /// The actual relaying logic. Requires mMutex to be held.
+  RelayChoice relayLocked(void const* rawHeader,
+                          std::unique_ptr<fair::mq::Message>* messages,
+                          InputInfo const& info,
+                          size_t nMessages,
+                          size_t nPayloads,
+                          OnDropCallback onDrop);
+
+  /// A set of messages staged by a relay() invocation which lost the
+  /// race for the relayer lock. Ownership stays with the shard until
+  /// the next drain point.
+  struct StagedInput {
+    void const* rawHeader;
+    std::vector<std::unique_ptr<fair::mq::Message>> messages;
+    InputInfo info;
+    size_t nPayloads;
+    OnDropCallback onDrop;
+  };
+
+  /// Per-channel staging shard. Channels are mapped on the shards via
+  /// their ChannelIndex, so that producers on different channels never
+  /// contend on the same stage lock.
+  struct StagingShard {
+    std::mutex lock;
+    std::vector<StagedInput> pending;
+  };
+
+  /// Move the messages to the shard associated to the incoming channel.
+  RelayChoice stage(void const* rawHeader,
+                    std::unique_ptr<fair::mq::Message>* messages,
+                    InputInfo const& info,
+                    size_t nMessages,
+                    size_t nPayloads,
+                    OnDropCallback onDrop);
+
+  /// Relay whatever was staged by contended relay() calls.
+  /// Requires mMutex to be held.
+  void drainStaged();
+
   ServiceRegistryRef mContext;
 
   /// This is the actual cache of all the parts in flight.
@@ -208,11 +266,21 @@ class DataRelayer
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<InputSpec> mInputs;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  /// The input matchers, lowered once into flat programs for the
+  /// per-message matching in relay().
+  std::vector<data_matcher::CompiledMatcher> mCompiledMatchers;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
+  /// When the first message of the timeslice currently occupying each
+  /// slot was relayed, so that the queueing latency can be reported.
+  std::vector<uint64_t> mFirstArrivalTimes;
   std::vector<PruneOp> mPruneOps;
   size_t mMaxLanes;
 
+  static constexpr size_t NUM_STAGING_SHARDS = 16;
+  std::array<StagingShard, NUM_STAGING_SHARDS> mStagingShards;
+  std::atomic<size_t> mStagedCount = 0;
+
   O2_LOCKABLE_NAMED(std::recursive_mutex, mMutex, "data relayer mutex");
 };
 
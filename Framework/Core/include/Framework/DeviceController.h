@@ -13,6 +13,8 @@
 #define O2_FRAMEWORK_DEVICECONTROLLER_H_
 
 #include <cstddef>
+#include <string>
+#include <vector>
 
 namespace o2::framework
 {
@@ -23,6 +25,9 @@ struct DeviceController {
   DeviceController(WSDPLHandler* handler);
   void hello();
   void write(const char* message, size_t s);
+  /// Send a batch of messages as individual frames with a single write
+  /// on the control connection.
+  void write(std::vector<std::string> const& messages);
 
   WSDPLHandler* mHandler;
 };
@@ -14,6 +14,7 @@
 
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/RuntimeError.h"
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
@@ -120,6 +121,26 @@ struct DeviceMetricsHelper {
     };
   }
 
+  /// @return the given percentile (0-100) computed over the stored history
+  /// of a numeric metric, or -1 if nothing was stored for it. Since the
+  /// backing store is a circular buffer, this covers the last
+  /// metricStorageSize<T>() values published by the device.
+  template <typename T>
+  static float getNumericMetricPercentile(DeviceMetricsInfo& metrics, size_t metricIndex, float percentile)
+  {
+    static_assert(std::is_same_v<T, int> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float>, "Unsupported metric type");
+    auto& metric = metrics.metrics[metricIndex];
+    auto& store = getMetricsStore<T>(metrics)[metric.storeIdx];
+    size_t filled = std::min(metric.filledMetrics, store.size());
+    if (filled == 0) {
+      return -1;
+    }
+    std::vector<T> sorted(store.begin(), store.begin() + filled);
+    std::sort(sorted.begin(), sorted.end());
+    auto rank = (size_t)(percentile / 100.f * (float)(filled - 1));
+    return (float)sorted[rank];
+  }
+
   static size_t bookMetricInfo(DeviceMetricsInfo& metrics, char const* name, MetricType type);
 
   /// @return helper to insert a given value in the metrics
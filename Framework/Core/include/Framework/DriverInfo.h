@@ -151,6 +151,11 @@ struct DriverInfo {
   unsigned short resourcesMonitoringInterval = 0;
   /// Metrics gathering dump to disk interval
   unsigned short resourcesMonitoringDumpInterval = 0;
+  /// Requested device pinning mode: "none", "auto" or "auto:<settle seconds>"
+  std::string devicePinningMode = "none";
+  /// Deadline (steady clock seconds) for the measured-load pinning.
+  /// 0 means not scheduled yet, max means already applied.
+  uint64_t devicePinningDeadline = 0;
   /// Port used by the websocket control. 0 means not initialised.
   unsigned short port = 0;
   /// The minimum level after which the device will exit with 1
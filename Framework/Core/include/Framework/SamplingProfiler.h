@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_SAMPLINGPROFILER_H_
+#define O2_FRAMEWORK_SAMPLINGPROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace o2::monitoring
+{
+class Monitoring;
+}
+
+namespace o2::framework
+{
+
+/// An opt-in, in-process sampling profiler. A SIGPROF itimer samples the
+/// stack of whatever thread is burning CPU at a low, configurable
+/// frequency; the signal handler only appends raw program counters to a
+/// lock-free ring, while draining, symbolisation and aggregation into
+/// folded stacks (the flamegraph collapsed format) happen on the main
+/// loop. The aggregate is published through the monitoring channel, so
+/// hotspots of a deployed topology can be inspected without attaching
+/// perf to every process.
+struct SamplingProfiler {
+  static constexpr int MaxDepth = 32;
+  static constexpr uint32_t RingSize = 1024;
+
+  struct RawSample {
+    std::atomic<int> ready{0};
+    int depth = 0;
+    void* pcs[MaxDepth];
+  };
+
+  /// Install the SIGPROF handler and arm the profiling timer.
+  void start(int frequencyHz);
+  /// Disarm the timer and uninstall the handler.
+  void stop();
+  /// Move the samples accumulated by the handler into the aggregate.
+  /// Must be called from the main loop.
+  void drain();
+  /// Send the folded stacks collected so far through monitoring.
+  void publish(o2::monitoring::Monitoring& monitoring);
+
+  /// Written by the signal handler, consumed by drain().
+  std::array<RawSample, RingSize> mRing;
+  std::atomic<uint32_t> mHead{0};
+  uint32_t mTail = 0;
+  std::atomic<uint32_t> mOverruns{0};
+
+  /// Occurrence count per unique stack, keyed by the raw pc chain.
+  std::map<std::vector<void*>, uint64_t> mAggregate;
+  /// Cache of symbolised frames, the expensive part of folding.
+  std::map<void*, std::string> mSymbolCache;
+  uint64_t mSamples = 0;
+  uint64_t mLastPublished = 0;
+  /// Sampling frequency in Hz, fixed at init from DPL_PROFILE_SAMPLING.
+  int mFrequency = 0;
+  /// Next periodic publication deadline (steady clock, ns).
+  uint64_t mNextPublish = 0;
+
+  std::string foldStack(std::vector<void*> const& pcs);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_SAMPLINGPROFILER_H_
@@ -70,6 +70,13 @@ class ServiceRegistryRef
     return mSalt.streamId == 0;
   }
 
+  // The stream this reference is associated to. See above for
+  // the meaning of the different values.
+  short streamId() const
+  {
+    return mSalt.streamId;
+  }
+
   /// Check if service of type T is currently active.
   template <typename T>
   std::enable_if_t<std::is_const_v<T> == false, bool> active() const
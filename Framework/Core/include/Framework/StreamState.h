@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_STREAMSTATE_H_
+#define O2_FRAMEWORK_STREAMSTATE_H_
+
+#include "Framework/ProcessingContext.h"
+#include "Framework/ServiceRegistryRef.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Helper to declare the lifetime of state captured by a stateful process
+/// callback when a device processes several timeframes concurrently (see
+/// DPL_THREADPOOL_SIZE). State captured in a plain shared_ptr is persistent
+/// and shared by all in-flight timeframes, so it must either be immutable or
+/// synchronised by the task. Wrapping it in a StreamState instead gives every
+/// processing stream its own lazily created instance, which only ever sees
+/// one timeframe at a time:
+///
+///   auto decoder = std::make_shared<StreamState<Decoder>>();
+///   auto calib = std::make_shared<CalibTables>();   // persistent, shared
+///   return [decoder, calib](ProcessingContext& pc) {
+///     auto& mine = decoder->get(pc);                // owned by this stream
+///     ...
+///   };
+///
+/// In the single stream, synchronous case this degenerates to exactly one
+/// instance, so tasks can use it unconditionally.
+template <typename T>
+class StreamState
+{
+ public:
+  /// Default constructs the per-stream instances.
+  StreamState()
+    : mMake([]() { return std::make_unique<T>(); })
+  {
+  }
+  /// Create the per-stream instances with the given factory, e.g. to pass
+  /// configuration captured at init time.
+  StreamState(std::function<std::unique_ptr<T>()> make)
+    : mMake(std::move(make))
+  {
+  }
+
+  /// The instance owned by the stream processing the current timeframe.
+  T& get(ProcessingContext& pc)
+  {
+    return get(pc.services());
+  }
+
+  T& get(ServiceRegistryRef ref)
+  {
+    // Stream 0 is the main thread (synchronous processing), 1..N are the
+    // worker threads. Unknown threads (negative ids) share the slot of the
+    // main thread, which is safe because they never process timeframes.
+    size_t index = std::max<short>(0, ref.streamId());
+    std::scoped_lock lock{mMutex};
+    if (mStates.size() <= index) {
+      mStates.resize(index + 1);
+    }
+    if (mStates[index] == nullptr) {
+      mStates[index] = mMake();
+    }
+    return *mStates[index];
+  }
+
+  /// Invoke f on every per-stream instance created so far, e.g. to merge
+  /// partial results at end of stream. Must not run concurrently with
+  /// processing.
+  template <typename F>
+  void forEach(F&& f)
+  {
+    std::scoped_lock lock{mMutex};
+    for (auto& state : mStates) {
+      if (state != nullptr) {
+        f(*state);
+      }
+    }
+  }
+
+ private:
+  std::mutex mMutex;
+  std::vector<std::unique_ptr<T>> mStates;
+  std::function<std::unique_ptr<T>()> mMake;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_STREAMSTATE_H_
@@ -128,7 +128,10 @@ class TreeToTable
   TreeToTable(arrow::MemoryPool* pool = arrow::default_memory_pool());
   void setLabel(const char* label);
   void addAllColumns(TTree* tree, std::vector<std::string>&& names = {});
-  void fill(TTree*);
+  /// read all registered branches and convert them to arrow columns; with
+  /// nDecodeThreads > 1 the per-branch basket decompression and conversion
+  /// run on that many threads
+  void fill(TTree*, int nDecodeThreads = 1);
   std::shared_ptr<arrow::Table> finalize();
 
  private:
@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TIMESLICEARENA_H_
+#define O2_FRAMEWORK_TIMESLICEARENA_H_
+
+#include "Framework/ServiceHandle.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// A bump allocator for transient, per-timeslice allocations. Memory is
+/// handed out by advancing a pointer into large slabs and is only
+/// reclaimed in bulk when reset() is invoked, which the framework does
+/// after each processing callback completes. Slabs are retained across
+/// timeslices, so after warmup a device serves all its transient small
+/// allocations without touching malloc.
+///
+/// Usage from a processing callback:
+///
+///   auto& arena = ctx.services().get<TimesliceArena>();
+///   auto tracks = arena.makeVector<TrackCandidate>();
+///
+/// Objects allocated from the arena must not outlive the processing
+/// callback: anything which has to survive belongs in an output or in
+/// task state.
+class TimesliceArena
+{
+ public:
+  constexpr static ServiceKind service_kind = ServiceKind::Stream;
+  constexpr static size_t DEFAULT_SLAB_SIZE = 1024 * 1024;
+
+  TimesliceArena(size_t slabSize = DEFAULT_SLAB_SIZE);
+  ~TimesliceArena();
+  TimesliceArena(TimesliceArena const&) = delete;
+  TimesliceArena& operator=(TimesliceArena const&) = delete;
+
+  /// The memory resource backed by the arena, for direct use with
+  /// pmr-aware containers.
+  std::pmr::memory_resource* resource() { return &mResource; }
+
+  /// A vector drawing from the arena. Same interface as std::vector,
+  /// but freeing is a no-op and the whole storage is reclaimed at the
+  /// end of the processing callback.
+  template <typename T>
+  std::pmr::vector<T> makeVector()
+  {
+    return std::pmr::vector<T>{&mResource};
+  }
+
+  template <typename T>
+  std::pmr::vector<T> makeVector(size_t size)
+  {
+    return std::pmr::vector<T>(size, &mResource);
+  }
+
+  /// Reclaim all allocations at once, keeping the slabs for reuse.
+  /// Invoked by the framework after each processing callback.
+  void reset();
+
+  /// Bytes handed out since the last reset.
+  [[nodiscard]] size_t used() const { return mUsed; }
+  /// Total bytes held in slabs.
+  [[nodiscard]] size_t capacity() const;
+
+ private:
+  struct Slab {
+    char* data = nullptr;
+    size_t size = 0;
+  };
+
+  class Resource : public std::pmr::memory_resource
+  {
+   public:
+    Resource(TimesliceArena& arena) : mArena{arena} {}
+
+   private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+      return this == &other;
+    }
+    TimesliceArena& mArena;
+  };
+
+  void* allocate(size_t bytes, size_t alignment);
+  void addSlab(size_t minSize);
+
+  std::vector<Slab> mSlabs;
+  size_t mCurrentSlab = 0;
+  size_t mCurrentOffset = 0;
+  size_t mSlabSize;
+  size_t mUsed = 0;
+  Resource mResource{*this};
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TIMESLICEARENA_H_
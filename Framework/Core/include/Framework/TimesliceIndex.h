@@ -132,6 +132,11 @@ class TimesliceIndex
   OldestOutputInfo updateOldestPossibleOutput(bool rewinded);
   [[nodiscard]] InputChannelInfo const& getChannelInfo(ChannelIndex channel) const;
 
+  /// Number of slots which had a valid timeslice associated the last time
+  /// the oldest possible output was computed. Meant to be published as a
+  /// metric, so that pipeline lengths can be sized from measured occupancy.
+  [[nodiscard]] size_t validSlotCount() const { return mValidSlotCount; }
+
   // Reset the TimesliceIndex to its initial state
   auto reset() -> void;
 
@@ -158,6 +163,15 @@ class TimesliceIndex
   OldestInputInfo mOldestPossibleInput = {};
   OldestOutputInfo mOldestPossibleOutput = {};
 
+  /// Cached minimum timeslice over the valid slots, so that
+  /// updateOldestPossibleOutput does not need to rescan all the slots
+  /// when nothing was mutated since the previous call. Any access which
+  /// can change the per-slot variables marks the cache dirty.
+  TimesliceId mOldestValidSlotTimeslice = {TimesliceId::INVALID};
+  TimesliceSlot mOldestValidSlot = {TimesliceSlot::INVALID};
+  size_t mValidSlotCount = 0;
+  bool mSlotMinDirty = true;
+
   /// What to do in case of backpressure
   BackpressureOp mBackpressurePolicy = BackpressureOp::Wait;
   /// The maximum number of lanes for this timeslice index
@@ -22,6 +22,11 @@
 #include "TMap.h"
 #include "TObjString.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/feather.h>
+#include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+
 template class std::vector<o2::framework::OutputObjectInfo>;
 template class std::vector<o2::framework::OutputTaskInfo>;
 
@@ -315,6 +320,68 @@ DataProcessorSpec AnalysisSupportHelpers::getOutputObjHistSink(std::vector<Outpu
   return spec;
 }
 
+// write an arrow table to a Feather V2 file, skipping the TTree conversion
+static void writeTableToFeather(std::shared_ptr<arrow::Table> table,
+                                DataOutputDescriptor* dodesc,
+                                std::string const& outputPath,
+                                std::vector<TString> const& metaDataKeys,
+                                std::vector<TString> const& metaDataVals)
+{
+  // reduce the table to the requested columns
+  if (!dodesc->colnames.empty()) {
+    std::vector<int> indices;
+    for (auto& cn : dodesc->colnames) {
+      auto idx = table->schema()->GetFieldIndex(cn);
+      if (idx != -1) {
+        indices.emplace_back(idx);
+      }
+    }
+    auto selection = table->SelectColumns(indices);
+    if (!selection.ok()) {
+      LOGP(error, "Column selection for table \"{}\" failed: {}", dodesc->tablename, selection.status().ToString());
+      return;
+    }
+    table = selection.ValueOrDie();
+  }
+
+  // the AOD metadata goes into the schema metadata instead of a ROOT TMap
+  if (!metaDataKeys.empty() && !metaDataVals.empty()) {
+    std::vector<std::string> keys;
+    std::vector<std::string> vals;
+    for (auto imd = 0U; imd < metaDataKeys.size(); imd++) {
+      keys.emplace_back(metaDataKeys[imd].Data());
+      vals.emplace_back(metaDataVals[imd].Data());
+    }
+    table = table->ReplaceSchemaMetadata(arrow::key_value_metadata(keys, vals));
+  }
+
+  auto outputStream = arrow::io::FileOutputStream::Open(outputPath);
+  if (!outputStream.ok()) {
+    LOGP(error, "Could not open {}: {}", outputPath, outputStream.status().ToString());
+    return;
+  }
+
+  auto properties = arrow::ipc::feather::WriteProperties::Defaults();
+  if (dodesc->compression == "lz4") {
+    properties.compression = arrow::Compression::LZ4_FRAME;
+  } else if (dodesc->compression == "zstd") {
+    properties.compression = arrow::Compression::ZSTD;
+  } else if (dodesc->compression == "uncompressed") {
+    properties.compression = arrow::Compression::UNCOMPRESSED;
+  } else if (!dodesc->compression.empty()) {
+    LOGP(error, "Unknown compression codec \"{}\", using the default!", dodesc->compression);
+  }
+
+  auto status = arrow::ipc::feather::WriteTable(*table, outputStream.ValueOrDie().get(), properties);
+  if (!status.ok()) {
+    LOGP(error, "Writing table \"{}\" to {} failed: {}", dodesc->tablename, outputPath, status.ToString());
+  }
+  status = outputStream.ValueOrDie()->Close();
+  if (!status.ok()) {
+    LOGP(error, "Could not close {}: {}", outputPath, status.ToString());
+  }
+}
+
 // add sink for the AODs
 DataProcessorSpec
   AnalysisSupportHelpers::getGlobalAODSink(std::shared_ptr<DataOutputDirector> dod,
@@ -457,6 +524,12 @@ DataProcessorSpec
         // a table can be saved in multiple ways
         // e.g. different selections of columns to different files
         for (auto d : ds) {
+          // Arrow-native output: write the table as it is, skipping the
+          // arrow -> TTree conversion
+          if (d->outputFormat == "feather") {
+            writeTableToFeather(table, d, dod->getArrowFilePath(d, tfNumber), aodMetaDataKeys, aodMetaDataVals);
+            continue;
+          }
           auto fileAndFolder = dod->getFileFolder(d, tfNumber, aodInputFile);
           auto treename = fileAndFolder.folderName + "/" + d->treename;
           TableToTree ta2tr(table,
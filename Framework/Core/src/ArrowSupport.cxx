@@ -586,7 +586,10 @@ o2::framework::ServiceSpec ArrowSupport::arrowTableSlicingCacheSpec()
             throw runtime_error_f("failed to update slice cache (unsorted) for %s/%s", unsortedCaches[i].first.c_str(), unsortedCaches[i].second.c_str());
           }
         }
-      } },
+      }
+      auto& stats = pc.services().get<DataProcessingStats>();
+      stats.updateStats({static_cast<short>(ProcessingStatsId::SLICING_CACHE_HITS), DataProcessingStats::Op::Set, service->cacheHits});
+      stats.updateStats({static_cast<short>(ProcessingStatsId::SLICING_CACHE_MISSES), DataProcessingStats::Op::Set, service->cacheMisses}); },
     .kind = ServiceKind::Stream};
 }
 
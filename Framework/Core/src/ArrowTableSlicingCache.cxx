@@ -19,6 +19,26 @@
 namespace o2::framework
 {
 
+namespace
+{
+// Identify the key column of a dataframe by the address of its value buffer
+// together with the number of rows. Messages are kept alive for the duration
+// of the computation, so a matching fingerprint means the entry was computed
+// from this very input and can be reused as is.
+ArrowTableSlicingCache::InputFingerprint inputFingerprint(std::shared_ptr<arrow::Table> const& table, std::string const& key)
+{
+  auto column = table->GetColumnByName(key);
+  if (column == nullptr || column->num_chunks() == 0) {
+    return {nullptr, table->num_rows()};
+  }
+  auto const& data = column->chunk(0)->data();
+  if (data->buffers.size() < 2 || data->buffers[1] == nullptr) {
+    return {nullptr, table->num_rows()};
+  }
+  return {data->buffers[1], table->num_rows()};
+}
+} // namespace
+
 void updatePairList(std::vector<StringPair>& list, std::string const& binding, std::string const& key)
 {
   if (std::find_if(list.begin(), list.end(), [&binding, &key](auto const& entry) { return (entry.first == binding) && (entry.second == key); }) == list.end()) {
@@ -81,9 +101,11 @@ ArrowTableSlicingCache::ArrowTableSlicingCache(std::vector<StringPair>&& bsks, s
 {
   values.resize(bindingsKeys.size());
   counts.resize(bindingsKeys.size());
+  fingerprints.resize(bindingsKeys.size());
 
   valuesUnsorted.resize(bindingsKeysUnsorted.size());
   groups.resize(bindingsKeysUnsorted.size());
+  fingerprintsUnsorted.resize(bindingsKeysUnsorted.size());
 }
 
 void ArrowTableSlicingCache::setCaches(std::vector<StringPair>&& bsks, std::vector<StringPair>&& bsksUnsorted)
@@ -94,10 +116,14 @@ void ArrowTableSlicingCache::setCaches(std::vector<StringPair>&& bsks, std::vect
   values.resize(bindingsKeys.size());
   counts.clear();
   counts.resize(bindingsKeys.size());
+  fingerprints.clear();
+  fingerprints.resize(bindingsKeys.size());
   valuesUnsorted.clear();
   valuesUnsorted.resize(bindingsKeysUnsorted.size());
   groups.clear();
   groups.resize(bindingsKeysUnsorted.size());
+  fingerprintsUnsorted.clear();
+  fingerprintsUnsorted.resize(bindingsKeysUnsorted.size());
 }
 
 arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<arrow::Table> const& table)
@@ -105,8 +131,16 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<
   if (table->num_rows() == 0) {
     values[pos].reset();
     counts[pos].reset();
+    fingerprints[pos] = {};
+    return arrow::Status::OK();
+  }
+  auto fingerprint = inputFingerprint(table, bindingsKeys[pos].second);
+  if (fingerprint.matches(fingerprints[pos])) {
+    ++cacheHits;
     return arrow::Status::OK();
   }
+  ++cacheMisses;
+  fingerprints[pos] = fingerprint;
   validateOrder(bindingsKeys[pos], table);
   arrow::Datum value_counts;
   auto options = arrow::compute::ScalarAggregateOptions::Defaults();
@@ -123,12 +157,26 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<
 
 arrow::Status ArrowTableSlicingCache::updateCacheEntryUnsorted(int pos, const std::shared_ptr<arrow::Table>& table)
 {
-  valuesUnsorted[pos].clear();
-  groups[pos].clear();
   if (table->num_rows() == 0) {
+    valuesUnsorted[pos].clear();
+    groups[pos].clear();
+    fingerprintsUnsorted[pos] = {};
     return arrow::Status::OK();
   }
   auto& [b, k] = bindingsKeysUnsorted[pos];
+  auto fingerprint = inputFingerprint(table, k);
+  if (fingerprint.matches(fingerprintsUnsorted[pos])) {
+    ++cacheHits;
+    return arrow::Status::OK();
+  }
+  ++cacheMisses;
+  fingerprintsUnsorted[pos] = fingerprint;
+  valuesUnsorted[pos].clear();
+  // empty the per-value index lists in place, so their storage is reused
+  // from one dataframe to the next
+  for (auto& group : groups[pos]) {
+    group.clear();
+  }
   auto column = table->GetColumnByName(k);
   auto row = 0;
   for (auto iChunk = 0; iChunk < column->num_chunks(); ++iChunk) {
@@ -136,9 +184,6 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntryUnsorted(int pos, const st
     for (auto iElement = 0; iElement < chunk.length(); ++iElement) {
       auto v = chunk.Value(iElement);
       if (v >= 0) {
-        if (std::find(valuesUnsorted[pos].begin(), valuesUnsorted[pos].end(), v) == valuesUnsorted[pos].end()) {
-          valuesUnsorted[pos].push_back(v);
-        }
         if (groups[pos].size() <= v) {
           groups[pos].resize(v + 1);
         }
@@ -147,7 +192,13 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntryUnsorted(int pos, const st
       ++row;
     }
   }
-  std::sort(valuesUnsorted[pos].begin(), valuesUnsorted[pos].end());
+  // groups are keyed by value, so collecting the non-empty ones yields the
+  // sorted value list without the per-row lookup the old code did
+  for (auto v = 0U; v < groups[pos].size(); ++v) {
+    if (!(groups[pos])[v].empty()) {
+      valuesUnsorted[pos].push_back(static_cast<int>(v));
+    }
+  }
   return arrow::Status::OK();
 }
 
@@ -23,6 +23,7 @@
 #include "Framework/LocalRootFileService.h"
 #include "Framework/DataRelayer.h"
 #include "Framework/Signpost.h"
+#include "Framework/SamplingProfiler.h"
 #include "Framework/DataProcessingStats.h"
 #include "Framework/DataProcessingStates.h"
 #include "Framework/TimingHelpers.h"
@@ -40,6 +41,7 @@
 #include "Framework/DeviceContext.h"
 #include "Framework/DataProcessingContext.h"
 #include "Framework/StreamContext.h"
+#include "Framework/TimesliceArena.h"
 #include "Framework/DeviceState.h"
 #include "Framework/DeviceConfig.h"
 #include "Framework/DefaultsHelpers.h"
@@ -471,6 +473,64 @@ o2::framework::ServiceSpec CommonServices::tracingSpec()
     .kind = ServiceKind::Serial};
 }
 
+// Opt-in sampling profiler. Enabled by setting DPL_PROFILE_SAMPLING to
+// the desired sampling frequency in Hz; the folded stacks end up in the
+// monitoring stream as dpl/profiled_stack metrics.
+o2::framework::ServiceSpec CommonServices::profilerSpec()
+{
+  return ServiceSpec{
+    .name = "sampling-profiler",
+    .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+      int frequency = 0;
+      if (auto* hz = getenv("DPL_PROFILE_SAMPLING")) {
+        frequency = atoi(hz);
+      }
+      if (frequency <= 0) {
+        return ServiceHandle{.hash = TypeIdHelpers::uniqueId<SamplingProfiler>(), .instance = nullptr, .kind = ServiceKind::Serial};
+      }
+      auto* profiler = new SamplingProfiler();
+      // Cap well below the signal handler's drain rate assumptions.
+      profiler->mFrequency = std::min(frequency, 1000);
+      return ServiceHandle{.hash = TypeIdHelpers::uniqueId<SamplingProfiler>(), .instance = profiler, .kind = ServiceKind::Serial};
+    },
+    .configure = noConfiguration(),
+    .postProcessing = [](ProcessingContext& context, void* service) {
+      if (!service) {
+        return;
+      }
+      auto* profiler = (SamplingProfiler*)service;
+      profiler->drain();
+      // Publish periodically, so long running topologies do not need a
+      // state transition to expose their profile.
+      auto now = uv_hrtime();
+      if (profiler->mNextPublish == 0) {
+        profiler->mNextPublish = now + 60 * 1000000000ull;
+      } else if (now > profiler->mNextPublish) {
+        profiler->publish(context.services().get<Monitoring>());
+        profiler->mNextPublish = now + 60 * 1000000000ull;
+      } },
+    .start = [](ServiceRegistryRef, void* service) {
+      if (!service) {
+        return;
+      }
+      auto* profiler = (SamplingProfiler*)service;
+      profiler->start(profiler->mFrequency); },
+    .stop = [](ServiceRegistryRef services, void* service) {
+      if (!service) {
+        return;
+      }
+      auto* profiler = (SamplingProfiler*)service;
+      profiler->stop();
+      profiler->drain();
+      profiler->publish(services.get<Monitoring>()); },
+    .exit = [](ServiceRegistryRef, void* service) {
+      if (!service) {
+        return;
+      }
+      delete (SamplingProfiler*)service; },
+    .kind = ServiceKind::Serial};
+}
+
 struct CCDBSupport {
 };
 
@@ -868,7 +928,8 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
       uv_update_time(state.loop);
       uint64_t offset = now.tv_sec * 1000 - uv_now(state.loop);
       DataProcessingStats::DefaultConfig config = {
-        .minOnlinePublishInterval = std::stoi(options.GetProperty<std::string>("dpl-stats-min-online-publishing-interval").c_str()) * 1000};
+        .minOnlinePublishInterval = std::stoi(options.GetProperty<std::string>("dpl-stats-min-online-publishing-interval").c_str()) * 1000,
+        .maxUnchangedRefreshLatency = std::stoi(options.GetProperty<std::string>("dpl-stats-unchanged-refresh-backoff").c_str()) * 1000};
       auto* stats = new DataProcessingStats(TimingHelpers::defaultRealtimeBaseConfigurator(offset, state.loop),
                                             TimingHelpers::defaultCPUTimeConfigurator(state.loop),
                                             config);
@@ -962,6 +1023,25 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
                    .metricId = (int)ProcessingStatsId::LAST_MAX_LATENCY,
                    .kind = Kind::UInt64,
                    .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "queue_latency_ms",
+                   .metricId = (int)ProcessingStatsId::LAST_QUEUE_LATENCY,
+                   .kind = Kind::UInt64,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "tf_lifetime_ms",
+                   .metricId = (int)ProcessingStatsId::LAST_TF_LIFETIME,
+                   .kind = Kind::UInt64,
+                   .scope = Scope::Online,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "timeframes_in_flight",
+                   .metricId = (int)ProcessingStatsId::TIMEFRAMES_IN_FLIGHT,
+                   .kind = Kind::UInt64,
+                   .scope = Scope::Online,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "oldest_tf_age_ms",
+                   .metricId = (int)ProcessingStatsId::OLDEST_TF_AGE_MS,
+                   .kind = Kind::UInt64,
+                   .scope = Scope::Online,
+                   .minPublishInterval = quickUpdateInterval},
         MetricSpec{.name = "total_rate_in_mb_s",
                    .metricId = (int)ProcessingStatsId::TOTAL_RATE_IN_MB_S,
                    .kind = Kind::Rate,
@@ -1023,6 +1103,9 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
         MetricSpec{.name = "dropped_computations", .metricId = static_cast<short>(ProcessingStatsId::DROPPED_COMPUTATIONS), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
         MetricSpec{.name = "dropped_incoming_messages", .metricId = static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
         MetricSpec{.name = "relayed_messages", .metricId = static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "relayer_slot_occupancy", .metricId = static_cast<short>(ProcessingStatsId::RELAYER_SLOT_OCCUPANCY), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "slicing_cache_hits", .metricId = static_cast<short>(ProcessingStatsId::SLICING_CACHE_HITS), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "slicing_cache_misses", .metricId = static_cast<short>(ProcessingStatsId::SLICING_CACHE_MISSES), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
         MetricSpec{.name = "arrow-bytes-destroyed",
                    .enabled = arrowAndResourceLimitingMetrics,
                    .metricId = static_cast<short>(ProcessingStatsId::ARROW_BYTES_DESTROYED),
@@ -1209,6 +1292,18 @@ o2::framework::ServiceSpec CommonServices::objectCache()
     .kind = ServiceKind::Serial};
 }
 
+o2::framework::ServiceSpec CommonServices::timesliceArenaSpec()
+{
+  return ServiceSpec{
+    .name = "timeslice-arena",
+    .uniqueId = simpleServiceId<TimesliceArena>(),
+    .init = simpleServiceInit<TimesliceArena, TimesliceArena, ServiceKind::Stream>(),
+    .configure = noConfiguration(),
+    .postProcessing = [](ProcessingContext& context, void* service) {
+      static_cast<TimesliceArena*>(service)->reset(); },
+    .kind = ServiceKind::Stream};
+}
+
 o2::framework::ServiceSpec CommonServices::dataProcessorContextSpec()
 {
   return ServiceSpec{
@@ -1273,7 +1368,9 @@ std::vector<ServiceSpec> CommonServices::defaultServices(std::string extraPlugin
     CommonMessageBackends::fairMQDeviceProxy(),
     dataSender(),
     objectCache(),
-    ccdbSupportSpec()};
+    timesliceArenaSpec(),
+    ccdbSupportSpec(),
+    profilerSpec()};
 
   if (!DefaultsHelpers::onlineDeploymentMode() && DefaultsHelpers::deploymentMode() != DeploymentMode::FST) {
     specs.push_back(ArrowSupport::arrowBackendSpec());
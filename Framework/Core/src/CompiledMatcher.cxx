@@ -0,0 +1,156 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/CompiledMatcher.h"
+#include "Framework/RuntimeError.h"
+#include "Headers/Stack.h"
+
+#include <array>
+
+namespace o2::framework::data_matcher
+{
+
+CompiledMatcher::CompiledMatcher(DataDescriptorMatcher const& tree)
+{
+  lower(tree);
+  if (mProgram.size() > UINT16_MAX) {
+    throw runtime_error("Matcher tree too large to compile");
+  }
+}
+
+size_t CompiledMatcher::emit(OpCode code, uint16_t arg)
+{
+  mProgram.push_back(Instruction{code, arg});
+  return mProgram.size() - 1;
+}
+
+void CompiledMatcher::lowerNode(Node const& node)
+{
+  if (auto pval0 = std::get_if<OriginValueMatcher>(&node)) {
+    emit(OpCode::MatchOrigin, (uint16_t)mOrigins.size());
+    mOrigins.push_back(*pval0);
+  } else if (auto pval1 = std::get_if<DescriptionValueMatcher>(&node)) {
+    emit(OpCode::MatchDescription, (uint16_t)mDescriptions.size());
+    mDescriptions.push_back(*pval1);
+  } else if (auto pval2 = std::get_if<SubSpecificationTypeValueMatcher>(&node)) {
+    emit(OpCode::MatchSubSpec, (uint16_t)mSubSpecs.size());
+    mSubSpecs.push_back(*pval2);
+  } else if (auto pval3 = std::get_if<std::unique_ptr<DataDescriptorMatcher>>(&node)) {
+    lower(**pval3);
+  } else if (auto pval4 = std::get_if<ConstantValueMatcher>(&node)) {
+    emit(OpCode::LoadConstant, (uint16_t)mConstants.size());
+    mConstants.push_back(pval4->match());
+  } else if (auto pval5 = std::get_if<StartTimeValueMatcher>(&node)) {
+    emit(OpCode::MatchStartTime, (uint16_t)mStartTimes.size());
+    mStartTimes.push_back(*pval5);
+    mNeedsDataProcessingHeader = true;
+  } else {
+    throw runtime_error("Bad parsing tree");
+  }
+}
+
+void CompiledMatcher::lower(DataDescriptorMatcher const& node)
+{
+  switch (node.getOp()) {
+    case DataDescriptorMatcher::Op::Just:
+      lowerNode(node.getLeft());
+      break;
+    case DataDescriptorMatcher::Op::Not:
+      lowerNode(node.getLeft());
+      emit(OpCode::Negate);
+      break;
+    case DataDescriptorMatcher::Op::And: {
+      lowerNode(node.getLeft());
+      auto jump = emit(OpCode::JumpIfFalse);
+      lowerNode(node.getRight());
+      mProgram[jump].arg = (uint16_t)mProgram.size();
+    } break;
+    case DataDescriptorMatcher::Op::Or: {
+      lowerNode(node.getLeft());
+      auto jump = emit(OpCode::JumpIfTrue);
+      lowerNode(node.getRight());
+      mProgram[jump].arg = (uint16_t)mProgram.size();
+    } break;
+    case DataDescriptorMatcher::Op::Xor:
+      lowerNode(node.getLeft());
+      emit(OpCode::Push);
+      lowerNode(node.getRight());
+      emit(OpCode::Xor);
+      break;
+  }
+}
+
+bool CompiledMatcher::match(char const* d, VariableContext& context) const
+{
+  // Unlike the tree walk, which extracts the headers again at every leaf,
+  // we parse the header stack exactly once per invocation.
+  auto const* dh = o2::header::get<header::DataHeader*>(d);
+  if (dh == nullptr) {
+    throw runtime_error("Cannot find DataHeader");
+  }
+  DataProcessingHeader const* dph = nullptr;
+  if (mNeedsDataProcessingHeader) {
+    dph = o2::header::get<DataProcessingHeader*>(d);
+    if (dph == nullptr) {
+      throw runtime_error("Cannot find DataProcessingHeader");
+    }
+  }
+
+  constexpr size_t MAX_OPERAND_STACK = 32;
+  std::array<bool, MAX_OPERAND_STACK> stack;
+  size_t sp = 0;
+  bool result = false;
+
+  for (size_t pc = 0; pc < mProgram.size(); ++pc) {
+    auto const& ins = mProgram[pc];
+    switch (ins.code) {
+      case OpCode::MatchOrigin:
+        result = mOrigins[ins.arg].match(*dh, context);
+        break;
+      case OpCode::MatchDescription:
+        result = mDescriptions[ins.arg].match(*dh, context);
+        break;
+      case OpCode::MatchSubSpec:
+        result = mSubSpecs[ins.arg].match(*dh, context);
+        break;
+      case OpCode::MatchStartTime:
+        result = mStartTimes[ins.arg].match(*dh, *dph, context);
+        break;
+      case OpCode::LoadConstant:
+        result = mConstants[ins.arg];
+        break;
+      case OpCode::Negate:
+        result = !result;
+        break;
+      case OpCode::Push:
+        if (sp == MAX_OPERAND_STACK) {
+          throw runtime_error("Matcher operand stack overflow");
+        }
+        stack[sp++] = result;
+        break;
+      case OpCode::Xor:
+        result = stack[--sp] ^ result;
+        break;
+      case OpCode::JumpIfFalse:
+        if (!result) {
+          pc = ins.arg - 1;
+        }
+        break;
+      case OpCode::JumpIfTrue:
+        if (result) {
+          pc = ins.arg - 1;
+        }
+        break;
+    }
+  }
+  return result;
+}
+
+} // namespace o2::framework::data_matcher
@@ -14,7 +14,9 @@
 #include "Framework/RuntimeError.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/DeviceController.h"
+#include "Framework/DeviceMetricsHelper.h"
 #include "Framework/DevicesManager.h"
+#include "Framework/DriverInfo.h"
 #include "DriverServerContext.h"
 #include "DriverClientContext.h"
 #include "ControlWebSocketHandler.h"
@@ -54,6 +56,20 @@ void ws_error_write_callback(uv_write_t* h, int status)
   free(h);
 }
 
+/// Write callback for the plain HTTP replies: free the buffer and
+/// close the connection once the reply has been flushed.
+void http_reply_write_callback(uv_write_t* h, int status)
+{
+  if (status) {
+    LOG(error) << "uv_write error: " << uv_err_name(status);
+  }
+  if (h->data) {
+    free(h->data);
+  }
+  uv_close((uv_handle_t*)h->handle, websocket_server_close_callback);
+  free(h);
+}
+
 /// Actually replies to any incoming websocket stuff.
 void websocket_server_callback(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf)
 {
@@ -93,6 +109,19 @@ void ws_handshake_done_callback(uv_write_t* h, int status)
   uv_read_start((uv_stream_t*)h->handle, (uv_alloc_cb)my_alloc_cb, websocket_server_callback);
 }
 
+/// Interval in milliseconds between two frames served to a remote
+/// viewer. Can be raised via DPL_REMOTE_GUI_INTERVAL on production
+/// topologies where even the sampling rate should be kept low; it also
+/// acts as a floor for the rate a viewer is allowed to request.
+static int remoteGuiInterval()
+{
+  int interval = 200;
+  if (auto* ms = getenv("DPL_REMOTE_GUI_INTERVAL")) {
+    interval = std::max(20, atoi(ms));
+  }
+  return interval;
+}
+
 enum struct GUIOpcodes : uint8_t {
   Mousepos = 1,
   Mouseclick = 2,
@@ -146,7 +175,10 @@ struct GUIWebSocketHandler : public WebSocketHandler {
       }
       case GUIOpcodes::Latency: {
         int lat = *((int*)frame);
-        lat = lat < 20 ? 20 : lat;
+        // the viewer may slow the sampling down but not push it below
+        // the rate configured on the driver side
+        int minLat = getenv("DPL_REMOTE_GUI_INTERVAL") != nullptr ? remoteGuiInterval() : 20;
+        lat = lat < minLat ? minLat : lat;
         uv_timer_set_repeat(&(mRenderer->drawTimer), lat);
         break;
       }
@@ -193,9 +225,10 @@ void WSDPLHandler::method(std::string_view const& s)
 
 void WSDPLHandler::target(std::string_view const& s)
 {
-  if (s != "/") {
+  if (s != "/" && s != "/node-signal") {
     throw WSError{404, "Unknown"};
   }
+  mTarget = s;
 }
 
 void populateHeader(std::map<std::string, std::string>& headers, std::string_view const& k, std::string_view const& v)
@@ -255,8 +288,84 @@ void WSDPLHandler::header(std::string_view const& k, std::string_view const& v)
   populateHeader(mHeaders, k, v);
 }
 
+namespace
+{
+/// Latest value of a Uint64 metric kept by the driver, 0 if it never
+/// got filled.
+uint64_t latestUint64MetricAt(DeviceMetricsInfo& metrics, size_t metricIndex)
+{
+  auto& metric = metrics.metrics[metricIndex];
+  if (metric.type != MetricType::Uint64 || metric.filledMetrics == 0) {
+    return 0;
+  }
+  auto& store = DeviceMetricsHelper::getMetricsStore<uint64_t>(metrics)[metric.storeIdx];
+  return store[(metric.pos + store.size() - 1) % store.size()];
+}
+
+uint64_t latestUint64Metric(DeviceMetricsInfo& metrics, std::string const& name)
+{
+  auto mi = DeviceMetricsHelper::metricIdxByName(name, metrics);
+  if (mi == metrics.metricLabels.size()) {
+    return 0;
+  }
+  return latestUint64MetricAt(metrics, mi);
+}
+
+/// Aggregate the per device backpressure metrics into the per node
+/// signal served on /node-signal: how many timeframes this node is
+/// currently holding, the age of the oldest of them and how much
+/// managed shared memory is left. A timeframe distribution layer can
+/// poll this to throttle slow nodes before they hit hard backpressure.
+std::string buildNodeSignal(DriverServerContext* context)
+{
+  uint64_t totalInFlight = 0;
+  uint64_t oldestAgeMs = 0;
+  uint64_t shmFreeBytes = 0;
+  bool haveShm = false;
+  static constexpr char const* shmPrefix = "available_managed_shm";
+  std::string devices;
+  for (size_t di = 0; di < context->specs->size() && di < context->metrics->size(); ++di) {
+    auto& metrics = (*context->metrics)[di];
+    auto inFlight = latestUint64Metric(metrics, "timeframes_in_flight");
+    auto age = latestUint64Metric(metrics, "oldest_tf_age_ms");
+    totalInFlight += inFlight;
+    oldestAgeMs = std::max(oldestAgeMs, age);
+    // Every device attached to a segment reports its free size, so we
+    // keep the most conservative (smallest) non zero report.
+    for (size_t li = 0; li < metrics.metricLabels.size(); ++li) {
+      if (strncmp(metrics.metricLabels[li].label, shmPrefix, strlen(shmPrefix)) != 0) {
+        continue;
+      }
+      auto value = latestUint64MetricAt(metrics, li);
+      if (value != 0 && (haveShm == false || value < shmFreeBytes)) {
+        shmFreeBytes = value;
+        haveShm = true;
+      }
+    }
+    if (devices.empty() == false) {
+      devices += ",";
+    }
+    devices += fmt::format(R"({{"name":"{}","timeframesInFlight":{},"oldestTfAgeMs":{}}})",
+                           (*context->specs)[di].name, inFlight, age);
+  }
+  return fmt::format(R"({{"workflowId":"{}","timeframesInFlight":{},"oldestTfAgeMs":{},"freeManagedShmBytes":{},"devices":[{}]}})",
+                     context->driver->uniqueWorkflowId, totalInFlight, oldestAgeMs, shmFreeBytes, devices);
+}
+} // namespace
+
 void WSDPLHandler::endHeaders()
 {
+  // Plain HTTP endpoint with the per node backpressure signal. Reply
+  // and close, no websocket upgrade involved.
+  if (mTarget == "/node-signal") {
+    std::string reply = fmt::format("HTTP/1.1 200 OK\r\ncontent-type: application/json\r\n\r\n{}\r\n", buildNodeSignal(mServerContext));
+    char* buffer = strdup(reply.data());
+    uv_buf_t bfr = uv_buf_init(buffer, reply.size());
+    auto* write_req = (uv_write_t*)malloc(sizeof(uv_write_t));
+    write_req->data = buffer;
+    uv_write(write_req, (uv_stream_t*)mStream, &bfr, 1, http_reply_write_callback);
+    return;
+  }
   /// Make sure this is a websocket upgrade request.
   if (mHeaders["upgrade"] != "websocket") {
     throw WSError{400, "Bad Request: not a websocket upgrade"};
@@ -302,7 +411,7 @@ void WSDPLHandler::endHeaders()
       renderer->handler = this;
       uv_timer_init(mServerContext->loop, &(renderer->drawTimer));
       renderer->drawTimer.data = renderer;
-      uv_timer_start(&(renderer->drawTimer), remoteGuiCallback, 0, 200);
+      uv_timer_start(&(renderer->drawTimer), remoteGuiCallback, 0, remoteGuiInterval());
       mHandler = std::make_unique<GUIWebSocketHandler>(*mServerContext, renderer);
       mHandler->headers(mHeaders);
       mServerContext->gui->renderers.insert(renderer);
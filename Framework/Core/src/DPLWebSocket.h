@@ -61,6 +61,9 @@ struct WSDPLHandler : public HTTPParser {
   std::unique_ptr<WebSocketHandler> mHandler;
   bool mHandshaken = false;
   uv_stream_t* mStream = nullptr;
+  /// The request target, so that plain HTTP endpoints (e.g. /node-signal)
+  /// can be told apart from the websocket upgrade on /.
+  std::string mTarget;
   std::map<std::string, std::string> mHeaders;
   DriverServerContext* mServerContext;
 };
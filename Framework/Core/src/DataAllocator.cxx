@@ -166,23 +166,46 @@ void DataAllocator::adopt(const Output& spec, std::string* ptr)
 
 void doWriteTable(std::shared_ptr<FairMQResizableBuffer> b, arrow::Table* table)
 {
-  auto mock = std::make_shared<arrow::io::MockOutputStream>();
+  // The IPC stream is written exactly once, directly into the
+  // transport-owned buffer. On shared memory channels the consumer maps
+  // those very same bytes (see TableConsumer), so this write is the only
+  // copy of the payload on the node. To size the buffer in one go we do
+  // not serialize the table twice: we only serialize the schema header
+  // plus end-of-stream marker and add the framed size of each batch.
   int64_t expectedSize = 0;
-  auto mockWriter = arrow::ipc::MakeStreamWriter(mock.get(), table->schema());
-  arrow::Status outStatus;
+  {
+    auto mock = std::make_shared<arrow::io::MockOutputStream>();
+    auto mockWriter = arrow::ipc::MakeStreamWriter(mock.get(), table->schema());
+    if (mockWriter.ValueOrDie()->Close().ok() == false) {
+      throw std::runtime_error("Unable to compute schema size");
+    }
+    expectedSize = mock->Tell().ValueOrDie();
+  }
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
   if (O2_BUILTIN_LIKELY(table->num_rows() != 0)) {
-    outStatus = mockWriter.ValueOrDie()->WriteTable(*table);
+    arrow::TableBatchReader reader(*table);
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (reader.ReadNext(&batch).ok() && batch != nullptr) {
+      batches.push_back(std::move(batch));
+    }
   } else {
     std::vector<std::shared_ptr<arrow::Array>> columns;
     columns.resize(table->columns().size());
     for (size_t ci = 0; ci < table->columns().size(); ci++) {
       columns[ci] = table->column(ci)->chunk(0);
     }
-    auto batch = arrow::RecordBatch::Make(table->schema(), 0, columns);
-    outStatus = mockWriter.ValueOrDie()->WriteRecordBatch(*batch);
+    batches.push_back(arrow::RecordBatch::Make(table->schema(), 0, columns));
+  }
+
+  for (auto& batch : batches) {
+    int64_t batchSize = 0;
+    if (arrow::ipc::GetRecordBatchSize(*batch, &batchSize).ok() == false) {
+      throw std::runtime_error("Unable to compute batch size");
+    }
+    expectedSize += batchSize;
   }
 
-  expectedSize = mock->Tell().ValueOrDie();
   auto reserve = b->Reserve(expectedSize);
   if (reserve.ok() == false) {
     throw std::runtime_error("Unable to reserve memory for table");
@@ -193,17 +216,12 @@ void doWriteTable(std::shared_ptr<FairMQResizableBuffer> b, arrow::Table* table)
   if (outBatch.ok() == false) {
     throw ::std::runtime_error("Unable to create batch writer");
   }
-
-  if (O2_BUILTIN_UNLIKELY(table->num_rows() == 0)) {
-    std::vector<std::shared_ptr<arrow::Array>> columns;
-    columns.resize(table->columns().size());
-    for (size_t ci = 0; ci < table->columns().size(); ci++) {
-      columns[ci] = table->column(ci)->chunk(0);
-    }
-    auto batch = arrow::RecordBatch::Make(table->schema(), 0, columns);
+  arrow::Status outStatus;
+  for (auto& batch : batches) {
     outStatus = outBatch.ValueOrDie()->WriteRecordBatch(*batch);
-  } else {
-    outStatus = outBatch.ValueOrDie()->WriteTable(*table);
+    if (outStatus.ok() == false) {
+      break;
+    }
   }
 
   if (outStatus.ok() == false) {
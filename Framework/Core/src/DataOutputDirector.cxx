@@ -32,16 +32,21 @@ using namespace rapidjson;
 
 DataOutputDescriptor::DataOutputDescriptor(std::string inString)
 {
-  // inString is an item consisting of 4 parts which are separated by a ':'
-  // "origin/description/subSpec:treename:col1/col2/col3:filename"
+  // inString is an item consisting of 5 parts which are separated by a ':'
+  // "origin/description/subSpec:treename:col1/col2/col3:filename:format"
   // the 1st part is used to create a DataDescriptorMatcher
-  // the other parts are used to fill treename, colnames, and filename
+  // the other parts are used to fill treename, colnames, filename, and
+  // the output format; the format defaults to a ROOT TTree, "feather"
+  // selects the Arrow-native output and can be followed by a compression
+  // codec, e.g. "feather/zstd"
   // remove all spaces
   inString.erase(std::remove_if(inString.begin(), inString.end(), isspace), inString.end());
 
   // reset
   treename = "";
   colnames.clear();
+  outputFormat = "";
+  compression = "";
   mfilenameBase = "";
 
   // analyze the  parts of the input string
@@ -109,6 +114,26 @@ DataOutputDescriptor::DataOutputDescriptor(std::string inString)
   if (!iter1->str().empty()) {
     mfilenameBase = iter1->str();
   }
+
+  // get the output format
+  ++iter1;
+  if (iter1 == end) {
+    return;
+  }
+  if (!iter1->str().empty()) {
+    auto fmt = iter1->str();
+    auto pos = fmt.find('/');
+    if (pos != std::string::npos) {
+      compression = fmt.substr(pos + 1);
+      fmt = fmt.substr(0, pos);
+    }
+    if (!fmt.empty() && fmt != "root") {
+      if (fmt != "feather") {
+        LOGP(fatal, "Unknown output format \"{}\"! Available formats are \"root\" and \"feather\".", fmt);
+      }
+      outputFormat = fmt;
+    }
+  }
 }
 
 std::string DataOutputDescriptor::getFilenameBase()
@@ -130,6 +155,9 @@ void DataOutputDescriptor::printOut()
   for (auto cn : colnames) {
     LOGP(info, "    {}", cn);
   }
+  if (!outputFormat.empty()) {
+    LOGP(info, "  Output format  : {}{}", outputFormat, compression.empty() ? "" : "/" + compression);
+  }
 }
 
 DataOutputDirector::DataOutputDirector()
@@ -144,6 +172,7 @@ void DataOutputDirector::reset()
   mtreeFilenames.clear();
   closeDataFiles();
   mfilePtrs.clear();
+  mArrowFilenames.clear();
   mfilenameBase = std::string("");
   mfileCounter = 1;
 };
@@ -408,6 +437,25 @@ std::tuple<std::string, std::string, std::string, float, int> DataOutputDirector
           return memptyanswer;
         }
       }
+      dodString += smc;
+      itemName = "format";
+      if (dodescItem.HasMember(itemName)) {
+        if (dodescItem[itemName].IsString()) {
+          dodString += dodescItem[itemName].GetString();
+        } else {
+          LOGP(error, "Check the JSON document! \"{}\" must be a string!", itemName);
+          return memptyanswer;
+        }
+      }
+      itemName = "compression";
+      if (dodescItem.HasMember(itemName)) {
+        if (dodescItem[itemName].IsString()) {
+          dodString += slh + dodescItem[itemName].GetString();
+        } else {
+          LOGP(error, "Check the JSON document! \"{}\" must be a string!", itemName);
+          return memptyanswer;
+        }
+      }
 
       // convert s to DataOutputDescription object
       readString(dodString);
@@ -508,6 +556,42 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+std::string DataOutputDirector::getArrowFilePath(DataOutputDescriptor* dodesc, uint64_t folderNumber)
+{
+  // Arrow-native outputs are plain files, one per table and DF folder:
+  // <resdir>/<filename base>/DF_<folderNumber>/<treename>.feather
+
+  // output directory
+  auto resdirname = mresultDirectory;
+  // is the maximum-file-size check enabled?
+  if (mmaxfilesize > 0.) {
+    // subdirectory ./xxx
+    char chcnt[4];
+    std::snprintf(chcnt, sizeof(chcnt), "%03d", mfileCounter);
+    resdirname += "/" + std::string(chcnt);
+  }
+  auto dirname = resdirname + "/" + dodesc->getFilenameBase() + "/DF_" + std::to_string(folderNumber);
+  auto resdir = fs::path{dirname.c_str()};
+
+  if (!fs::is_directory(resdir)) {
+    if (!fs::create_directories(resdir)) {
+      LOGF(fatal, "Could not create output directory %s", dirname.c_str());
+    }
+  }
+
+  // feather files are written in one go, so when several time frames are
+  // merged into the same DF folder each of them gets its own part file
+  auto base = dirname + "/" + dodesc->treename;
+  auto fn = base + ".feather";
+  int cnt = 0;
+  while (std::find(mArrowFilenames.begin(), mArrowFilenames.end(), fn) != mArrowFilenames.end()) {
+    fn = base + "_" + std::to_string(++cnt) + ".feather";
+  }
+  mArrowFilenames.emplace_back(fn);
+
+  return fn;
+}
+
 bool DataOutputDirector::checkFileSizes()
 {
   // is the maximum-file-size check enabled?
@@ -537,12 +621,30 @@ bool DataOutputDirector::checkFileSizes()
     LOGF(debug, "File %s: %f MBytes", fn.c_str(), fsize);
     if (fsize >= mmaxfilesize) {
       closeDataFiles();
+      // files written after the rotation go to a new subdirectory
+      mArrowFilenames.clear();
       // increment the subdirectory counter
       mfileCounter++;
       return false;
     }
   }
 
+  // same check for the Arrow-native files
+  for (auto& fn : mArrowFilenames) {
+    auto resfile = fs::path{fn.c_str()};
+    if (!fs::exists(resfile)) {
+      continue;
+    }
+    auto fsize = (float)fs::file_size(resfile) / 1.E6; // MBytes
+    LOGF(debug, "File %s: %f MBytes", fn.c_str(), fsize);
+    if (fsize >= mmaxfilesize) {
+      closeDataFiles();
+      mArrowFilenames.clear();
+      mfileCounter++;
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -593,6 +695,7 @@ void DataOutputDirector::setFilenameBase(std::string dfn)
   mtreeFilenames.clear();
   closeDataFiles();
   mfilePtrs.clear();
+  mArrowFilenames.clear();
 
   // loop over DataOutputDescritors
   for (auto dodesc : mDataOutputDescriptors) {
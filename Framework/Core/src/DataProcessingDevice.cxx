@@ -223,9 +223,17 @@ DataProcessingDevice::DataProcessingDevice(RunningDeviceRef running, ServiceRegi
   // 99 is to execute DPL callbacks last
   this->SubscribeToStateChange("99-dpl", stateWatcher);
 
-  // One task for now.
-  mStreams.resize(1);
-  mHandles.resize(1);
+  // One stream per thread requested via DPL_THREADPOOL_SIZE, so that
+  // independent timeslices of the same data processor can be in flight
+  // concurrently while sharing one device (and therefore one shmem
+  // segment and one copy of the conditions). Without the environment
+  // variable we keep the single stream, synchronous behaviour.
+  int poolSize = 1;
+  if (auto* threads = getenv("DPL_THREADPOOL_SIZE")) {
+    poolSize = std::max(1, atoi(threads));
+  }
+  mStreams.resize(poolSize);
+  mHandles.resize(poolSize);
 
   ServiceRegistryRef ref{mServiceRegistry};
   mAwakeHandle = (uv_async_t*)malloc(sizeof(uv_async_t));
@@ -1312,7 +1320,10 @@ void DataProcessingDevice::Run()
 
   bool dplEnableMultithreding = getenv("DPL_THREADPOOL_SIZE") != nullptr;
   if (dplEnableMultithreding) {
-    setenv("UV_THREADPOOL_SIZE", "1", 1);
+    // Size the libuv worker pool after the number of streams, so that
+    // every idle stream can actually be scheduled concurrently.
+    auto poolSize = std::to_string(mStreams.size());
+    setenv("UV_THREADPOOL_SIZE", poolSize.c_str(), 1);
   }
 
   while (state.transitionHandling != TransitionHandlingState::Expired) {
@@ -2218,7 +2229,11 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
         headerptr = static_cast<char const*>(headerMsg->GetData());
         payloadptr = payloadMsg ? static_cast<char const*>(payloadMsg->GetData()) : nullptr;
         payloadSize = payloadMsg ? payloadMsg->GetSize() : 0;
-        return DataRef{nullptr, headerptr, payloadptr, payloadSize};
+        DataRef ref{nullptr, headerptr, payloadptr, payloadSize};
+        // decode the standard headers once, accesses through DataRefUtils
+        // on the materialized ref are then plain member loads
+        DataRefUtils::decodeHeaders(ref);
+        return ref;
       }
       return DataRef{};
     };
@@ -2362,6 +2377,24 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     auto latency = calculateInputRecordLatency(record, tStartMilli);
     stats.updateStats({(int)ProcessingStatsId::LAST_MIN_LATENCY, DataProcessingStats::Op::Set, (int)latency.minLatency});
     stats.updateStats({(int)ProcessingStatsId::LAST_MAX_LATENCY, DataProcessingStats::Op::Set, (int)latency.maxLatency});
+    // Per-stage watermarks for the timeframe latency: how long the
+    // timeframe waited in the relayer before processing could start, and
+    // how old it was (with respect to its creation upstream) when this
+    // device was done with it.
+    auto arrival = ref.get<DataRelayer>().getFirstArrivalTimeForSlot(action.slot);
+    if (arrival != 0) {
+      int64_t queueLatencyMs = (0x7fffffffffffffff & tStartMilli) - (0x7fffffffffffffff & arrival);
+      stats.updateStats({(int)ProcessingStatsId::LAST_QUEUE_LATENCY, DataProcessingStats::Op::Set, queueLatencyMs < 0 ? 0 : queueLatencyMs});
+    }
+    stats.updateStats({(int)ProcessingStatsId::LAST_TF_LIFETIME, DataProcessingStats::Op::Set, (int64_t)(latency.maxLatency + wallTimeMs)});
+    // Per node backpressure telemetry: how many timeframes currently
+    // occupy relayer slots and the age of the oldest of them, so that
+    // the timeframe distribution layer can throttle slow nodes before
+    // they hit hard backpressure.
+    auto inFlight = ref.get<DataRelayer>().getInFlightStats();
+    stats.updateStats({(int)ProcessingStatsId::TIMEFRAMES_IN_FLIGHT, DataProcessingStats::Op::Set, inFlight.count});
+    int64_t oldestAgeMs = inFlight.oldestCreation == 0 ? 0 : (0x7fffffffffffffff & tStartMilli) - (int64_t)inFlight.oldestCreation;
+    stats.updateStats({(int)ProcessingStatsId::OLDEST_TF_AGE_MS, DataProcessingStats::Op::Set, oldestAgeMs < 0 ? 0 : oldestAgeMs});
     static int count = 0;
     stats.updateStats({(int)ProcessingStatsId::PROCESSING_RATE_HZ, DataProcessingStats::Op::CumulativeRate, 1});
     count++;
@@ -111,6 +111,7 @@ void DataProcessingStats::processCommandQueue()
           metrics[cmd.id] = cmd.value;
           updated[cmd.id] = true;
           update.timestamp = cmd.timestamp;
+          update.unchangedRefreshes = 0;
           pushedMetricsLapse++;
         }
         break;
@@ -119,6 +120,7 @@ void DataProcessingStats::processCommandQueue()
           metrics[cmd.id] += cmd.value;
           updated[cmd.id] = true;
           update.timestamp = cmd.timestamp;
+          update.unchangedRefreshes = 0;
           pushedMetricsLapse++;
         }
         break;
@@ -127,6 +129,7 @@ void DataProcessingStats::processCommandQueue()
           metrics[cmd.id] -= cmd.value;
           updated[cmd.id] = true;
           update.timestamp = cmd.timestamp;
+          update.unchangedRefreshes = 0;
           pushedMetricsLapse++;
         }
         break;
@@ -135,6 +138,7 @@ void DataProcessingStats::processCommandQueue()
           metrics[cmd.id] = cmd.value;
           updated[cmd.id] = true;
           update.timestamp = cmd.timestamp;
+          update.unchangedRefreshes = 0;
           pushedMetricsLapse++;
         }
         break;
@@ -143,6 +147,7 @@ void DataProcessingStats::processCommandQueue()
           metrics[cmd.id] = cmd.value;
           updated[cmd.id] = true;
           update.timestamp = cmd.timestamp;
+          update.unchangedRefreshes = 0;
           pushedMetricsLapse++;
         }
         break;
@@ -151,6 +156,7 @@ void DataProcessingStats::processCommandQueue()
           metrics[cmd.id] = cmd.value;
           updated[cmd.id] = true;
           update.timestamp = cmd.timestamp;
+          update.unchangedRefreshes = 0;
           pushedMetricsLapse++;
         }
         break;
@@ -163,6 +169,7 @@ void DataProcessingStats::processCommandQueue()
         // at the moment of publishing.
         metrics[cmd.id] = cmd.value;
         updated[cmd.id] = true;
+        update.unchangedRefreshes = 0;
         if (update.timestamp == 0) {
           update.timestamp = cmd.timestamp;
         }
@@ -177,6 +184,7 @@ void DataProcessingStats::processCommandQueue()
         // at the moment of publishing.
         metrics[cmd.id] += cmd.value;
         updated[cmd.id] = true;
+        update.unchangedRefreshes = 0;
         if (update.timestamp == 0) {
           update.timestamp = cmd.timestamp;
         }
@@ -206,9 +214,19 @@ void DataProcessingStats::flushChangedMetrics(std::function<void(DataProcessingS
       LOGP(debug, "Metric {} is disabled", spec.name);
       continue;
     }
-    if (updated[mi] == false && currentTimestamp - update.timestamp > spec.maxRefreshLatency) {
+    uint64_t refreshLatency = spec.maxRefreshLatency;
+    if (config.maxUnchangedRefreshLatency > 0 && spec.maxRefreshLatency != (uint64_t)-1) {
+      // Unchanged metrics back off exponentially: every forced refresh which
+      // finds the same value doubles the latency of the next one, up to the
+      // configured cap. Any real update resets the backoff.
+      refreshLatency = std::min<uint64_t>(spec.maxRefreshLatency << std::min(update.unchangedRefreshes, 31),
+                                          (uint64_t)config.maxUnchangedRefreshLatency);
+      refreshLatency = std::max<uint64_t>(refreshLatency, spec.maxRefreshLatency);
+    }
+    if (updated[mi] == false && currentTimestamp - update.timestamp > refreshLatency) {
       updated[mi] = true;
       update.timestamp = currentTimestamp;
+      update.unchangedRefreshes++;
     }
     if (updated[mi] == false) {
       continue;
@@ -18,6 +18,7 @@
 #include "Framework/DataSpecUtils.h"
 #include "Framework/DataProcessingHeader.h"
 #include "Framework/DataRef.h"
+#include "Framework/DataRefUtils.h"
 #include "Framework/InputRecord.h"
 #include "Framework/InputSpan.h"
 #include "Framework/CompletionPolicy.h"
@@ -35,6 +36,7 @@
 #include "Framework/DataProcessingStates.h"
 #include "Framework/DataTakingContext.h"
 #include "Framework/DefaultsHelpers.h"
+#include "Framework/TimingHelpers.h"
 
 #include "Headers/DataHeaderHelpers.h"
 #include "Framework/Formatters.h"
@@ -46,6 +48,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <gsl/span>
+#include <iterator>
 #include <numeric>
 #include <string>
 
@@ -98,6 +101,13 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
   states.registerState({.name = "data_queries", .stateId = stateId, .sendInitialValue = true, .defaultEnabled = true});
   states.updateState(DataProcessingStates::CommandSpec{.id = stateId, .size = (int)queries.size(), .data = queries.data()});
   states.processCommandQueue();
+
+  // Lower the matcher trees once, so that the per-message matching in
+  // relay() does not need to walk them.
+  mCompiledMatchers.reserve(mInputMatchers.size());
+  for (auto& matcher : mInputMatchers) {
+    mCompiledMatchers.emplace_back(matcher);
+  }
 }
 
 TimesliceId DataRelayer::getTimesliceForSlot(TimesliceSlot slot)
@@ -197,10 +207,12 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
         if (partial[idx].size() > 0 && partial[idx].header(part).get()) {
           auto header = partial[idx].header(part).get();
           auto payload = partial[idx].payload(part).get();
-          return DataRef{nullptr,
-                         reinterpret_cast<const char*>(header->GetData()),
-                         reinterpret_cast<char const*>(payload ? payload->GetData() : nullptr),
-                         payload ? payload->GetSize() : 0};
+          DataRef ref{nullptr,
+                      reinterpret_cast<const char*>(header->GetData()),
+                      reinterpret_cast<char const*>(payload ? payload->GetData() : nullptr),
+                      payload ? payload->GetSize() : 0};
+          DataRefUtils::decodeHeaders(ref);
+          return ref;
         }
         return DataRef{};
       };
@@ -236,7 +248,7 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
 size_t matchToContext(void const* data,
-                      std::vector<DataDescriptorMatcher> const& matchers,
+                      std::vector<CompiledMatcher> const& matchers,
                       std::vector<size_t> const& index,
                       VariableContext& context)
 {
@@ -416,7 +428,99 @@ DataRelayer::RelayChoice
                      size_t nPayloads,
                      std::function<void(TimesliceSlot, std::vector<MessageSet>&, TimesliceIndex::OldestOutputInfo)> onDrop)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  // When multiple threads pull from different channels, do not serialize
+  // them on the relayer lock: the loser of the race parks the messages in
+  // its channel shard and returns, the winner drains the shards while it
+  // holds the lock anyway.
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return stage(rawHeader, messages, info, nMessages, nPayloads, onDrop);
+  }
+  drainStaged();
+  return relayLocked(rawHeader, messages, info, nMessages, nPayloads, onDrop);
+}
+
+DataRelayer::RelayChoice
+  DataRelayer::stage(void const* rawHeader,
+                     std::unique_ptr<fair::mq::Message>* messages,
+                     InputInfo const& info,
+                     size_t nMessages,
+                     size_t nPayloads,
+                     OnDropCallback onDrop)
+{
+  auto shardIndex = info.index.value == ChannelIndex::INVALID ? 0 : info.index.value % NUM_STAGING_SHARDS;
+  auto& shard = mStagingShards[shardIndex];
+  // The timeslice must be read before the messages are published to the
+  // shard: once they are visible there the lock holder may drain and
+  // even free them, so rawHeader cannot be touched anymore.
+  auto const* dph = o2::header::get<DataProcessingHeader*>(rawHeader);
+  auto timeslice = TimesliceId{dph->startTime};
+  StagedInput staged{rawHeader, {}, info, nPayloads, std::move(onDrop)};
+  staged.messages.reserve(nMessages);
+  for (size_t mi = 0; mi < nMessages; ++mi) {
+    staged.messages.emplace_back(std::move(messages[mi]));
+  }
+  {
+    std::scoped_lock<std::mutex> stageLock(shard.lock);
+    shard.pending.emplace_back(std::move(staged));
+    // Bumped under the shard lock, so that the drain point can never
+    // subtract an entry whose increment has not landed yet.
+    mStagedCount.fetch_add(1, std::memory_order_release);
+  }
+  // We report the optimistic outcome. If the staged messages end up being
+  // dropped, the drain point accounts for it via the usual statistics and
+  // the onDrop callback.
+  return RelayChoice{.type = RelayChoice::Type::WillRelay, .timeslice = timeslice};
+}
+
+void DataRelayer::drainStaged()
+{
+  if (mStagedCount.load(std::memory_order_acquire) == 0) {
+    return;
+  }
+  for (auto& shard : mStagingShards) {
+    std::vector<StagedInput> pending;
+    {
+      std::scoped_lock<std::mutex> stageLock(shard.lock);
+      pending.swap(shard.pending);
+    }
+    if (pending.empty()) {
+      continue;
+    }
+    mStagedCount.fetch_sub(pending.size(), std::memory_order_release);
+    std::vector<StagedInput> backpressured;
+    for (auto& staged : pending) {
+      auto choice = relayLocked(staged.rawHeader, staged.messages.data(), staged.info,
+                                staged.messages.size(), staged.nPayloads, staged.onDrop);
+      // A backpressured input is not consumed by relayLocked. Keep it
+      // staged so that a later drain retries it, mirroring how a direct
+      // relay() caller retains the parts in the channel and retries.
+      if (choice.type == RelayChoice::Type::Backpressured) {
+        backpressured.emplace_back(std::move(staged));
+      }
+    }
+    if (backpressured.empty() == false) {
+      auto retried = backpressured.size();
+      std::scoped_lock<std::mutex> stageLock(shard.lock);
+      // Prepend to whatever was staged meanwhile, so that the per
+      // channel ordering is preserved.
+      backpressured.insert(backpressured.end(),
+                           std::make_move_iterator(shard.pending.begin()),
+                           std::make_move_iterator(shard.pending.end()));
+      shard.pending.swap(backpressured);
+      mStagedCount.fetch_add(retried, std::memory_order_release);
+    }
+  }
+}
+
+DataRelayer::RelayChoice
+  DataRelayer::relayLocked(void const* rawHeader,
+                           std::unique_ptr<fair::mq::Message>* messages,
+                           InputInfo const& info,
+                           size_t nMessages,
+                           size_t nPayloads,
+                           OnDropCallback onDrop)
+{
   DataProcessingHeader const* dph = o2::header::get<DataProcessingHeader*>(rawHeader);
   // IMPLEMENTATION DETAILS
   //
@@ -427,7 +531,7 @@ DataRelayer::RelayChoice
   // This returns the identifier for the given input. We use a separate
   // function because while it's trivial now, the actual matchmaking will
   // become more complicated when we will start supporting ranges.
-  auto getInputTimeslice = [&matchers = mInputMatchers,
+  auto getInputTimeslice = [&matchers = mCompiledMatchers,
                             &distinctRoutes = mDistinctRoutesIndex,
                             &rawHeader,
                             &index = mTimesliceIndex](VariableContext& context)
@@ -655,6 +759,8 @@ DataRelayer::RelayChoice
       if (saved == 0) {
         return RelayChoice{.type = RelayChoice::Type::Dropped, .timeslice = timeslice};
       }
+      // This is the first message for the timeslice now occupying the slot.
+      mFirstArrivalTimes[slot.index] = TimingHelpers::getRealtimeSinceEpochStandalone();
       index.publishSlot(slot);
       index.markAsDirty(slot, true);
       return RelayChoice{.type = RelayChoice::Type::WillRelay};
@@ -666,6 +772,9 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
 {
   LOGP(debug, "DataRelayer::getReadyToProcess");
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  // Make sure whatever was staged by contended relay() calls is in the
+  // cache before we decide what is complete.
+  drainStaged();
 
   // THE STATE
   const auto& cache = mCache;
@@ -736,10 +845,12 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
       if (partial[idx].size() > 0 && partial[idx].header(part).get()) {
         auto header = partial[idx].header(part).get();
         auto payload = partial[idx].payload(part).get();
-        return DataRef{nullptr,
-                       reinterpret_cast<const char*>(header->GetData()),
-                       reinterpret_cast<char const*>(payload ? payload->GetData() : nullptr),
-                       payload ? payload->GetSize() : 0};
+        DataRef ref{nullptr,
+                    reinterpret_cast<const char*>(header->GetData()),
+                    reinterpret_cast<char const*>(payload ? payload->GetData() : nullptr),
+                    payload ? payload->GetSize() : 0};
+        DataRefUtils::decodeHeaders(ref);
+        return ref;
       }
       return DataRef{};
     };
@@ -791,6 +902,9 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
     }
   }
   mTimesliceIndex.updateOldestPossibleOutput(false);
+  mContext.get<DataProcessingStats>().updateStats({static_cast<short>(ProcessingStatsId::RELAYER_SLOT_OCCUPANCY),
+                                                   DataProcessingStats::Op::Set,
+                                                   (int64_t)mTimesliceIndex.validSlotCount()});
   LOGP(debug, "DataRelayer::getReadyToProcess results notDirty:{}, consume:{}, consumeExisting:{}, process:{}, discard:{}, wait:{}",
        notDirty, countConsume, countConsumeExisting, countProcess,
        countDiscard, countWait);
@@ -915,6 +1029,11 @@ void DataRelayer::clear()
 {
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
 
+  for (auto& shard : mStagingShards) {
+    std::scoped_lock<std::mutex> stageLock(shard.lock);
+    mStagedCount.fetch_sub(shard.pending.size(), std::memory_order_release);
+    shard.pending.clear();
+  }
   for (auto& cache : mCache) {
     cache.clear();
   }
@@ -939,6 +1058,7 @@ void DataRelayer::setPipelineLength(size_t s)
 
   mTimesliceIndex.resize(s);
   mVariableContextes.resize(s);
+  mFirstArrivalTimes.resize(s, 0);
   publishMetrics();
 }
 
@@ -1003,6 +1123,33 @@ uint64_t DataRelayer::getCreationTimeForSlot(TimesliceSlot slot)
   return VariableContextHelpers::getCreationTime(mTimesliceIndex.getVariablesForSlot(slot));
 }
 
+uint64_t DataRelayer::getFirstArrivalTimeForSlot(TimesliceSlot slot)
+{
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  if (slot.index >= mFirstArrivalTimes.size()) {
+    return 0;
+  }
+  return mFirstArrivalTimes[slot.index];
+}
+
+DataRelayer::InFlightStats DataRelayer::getInFlightStats()
+{
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  InFlightStats stats;
+  for (size_t si = 0; si < mTimesliceIndex.size(); ++si) {
+    TimesliceSlot slot{si};
+    if (!mTimesliceIndex.isValid(slot)) {
+      continue;
+    }
+    stats.count++;
+    auto creation = 0x7fffffffffffffff & getCreationTimeForSlot(slot);
+    if (creation != 0 && (stats.oldestCreation == 0 || creation < stats.oldestCreation)) {
+      stats.oldestCreation = creation;
+    }
+  }
+  return stats;
+}
+
 void DataRelayer::sendContextState()
 {
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
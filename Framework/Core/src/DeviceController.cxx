@@ -40,4 +40,17 @@ void DeviceController::write(char const* message, size_t s)
   mHandler->write(outputs);
 }
 
+void DeviceController::write(std::vector<std::string> const& messages)
+{
+  if (messages.empty()) {
+    return;
+  }
+  std::vector<uv_buf_t> outputs;
+  for (auto& message : messages) {
+    LOGP(debug, "Saying {} to device", message);
+    encode_websocket_frames(outputs, message.c_str(), message.size(), WebSocketOpCode::Binary, 0);
+  }
+  mHandler->write(outputs);
+}
+
 } // namespace o2::framework
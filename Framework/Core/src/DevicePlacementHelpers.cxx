@@ -0,0 +1,297 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "DevicePlacementHelpers.h"
+#include "Framework/DeviceInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DriverInfo.h"
+#include "Framework/Logger.h"
+#include "Framework/RunningWorkflowInfo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace o2::framework
+{
+
+namespace
+{
+/// Parse a sysfs cpu range list, e.g. "0-3,8,10-11".
+std::vector<int> parseCpuList(std::string const& list)
+{
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string token;
+  while (std::getline(ss, token, ',')) {
+    auto dash = token.find('-');
+    if (dash == std::string::npos) {
+      cpus.push_back(atoi(token.c_str()));
+    } else {
+      int first = atoi(token.substr(0, dash).c_str());
+      int last = atoi(token.substr(dash + 1).c_str());
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+bool readFirstLine(std::string const& path, std::string& line)
+{
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::getline(file, line);
+  return !line.empty();
+}
+
+/// Average over the filled part of the circular history of a numeric metric.
+template <typename T>
+float averageMetric(DeviceMetricsInfo& metrics, size_t metricIndex)
+{
+  auto& metric = metrics.metrics[metricIndex];
+  auto& store = DeviceMetricsHelper::getMetricsStore<T>(metrics)[metric.storeIdx];
+  size_t filled = std::min(metric.filledMetrics, store.size());
+  if (filled == 0) {
+    return 0;
+  }
+  double sum = 0;
+  for (size_t i = 0; i < filled; ++i) {
+    sum += (double)store[i];
+  }
+  return (float)(sum / (double)filled);
+}
+} // namespace
+
+CpuTopology DevicePlacementHelpers::readCpuTopology(std::string const& sysfsRoot)
+{
+  CpuTopology topology;
+  std::string line;
+  if (!readFirstLine(sysfsRoot + "/devices/system/cpu/online", line)) {
+    return topology;
+  }
+  auto online = parseCpuList(line);
+  if (online.empty()) {
+    return topology;
+  }
+  // NUMA node of each cpu from the per node cpu lists.
+  std::map<int, int> nodeOfCpu;
+  for (int node = 0;; ++node) {
+    if (!readFirstLine(sysfsRoot + "/devices/system/node/node" + std::to_string(node) + "/cpulist", line)) {
+      break;
+    }
+    for (auto cpu : parseCpuList(line)) {
+      nodeOfCpu[cpu] = node;
+    }
+  }
+  for (auto cpu : online) {
+    CpuTopology::LogicalCpu entry;
+    entry.cpu = cpu;
+    entry.numaNode = nodeOfCpu.count(cpu) ? nodeOfCpu[cpu] : 0;
+    auto cpuDir = sysfsRoot + "/devices/system/cpu/cpu" + std::to_string(cpu);
+    // the lowest cpu sharing the L3 identifies the L3 group
+    entry.l3Group = cpu;
+    if (readFirstLine(cpuDir + "/cache/index3/shared_cpu_list", line)) {
+      auto sharing = parseCpuList(line);
+      if (!sharing.empty()) {
+        entry.l3Group = *std::min_element(sharing.begin(), sharing.end());
+      }
+    }
+    entry.smtPrimary = cpu;
+    if (readFirstLine(cpuDir + "/topology/thread_siblings_list", line)) {
+      auto siblings = parseCpuList(line);
+      if (!siblings.empty()) {
+        entry.smtPrimary = *std::min_element(siblings.begin(), siblings.end());
+      }
+    }
+    topology.cpus.push_back(entry);
+  }
+  topology.valid = true;
+  return topology;
+}
+
+std::map<std::string, int> DevicePlacementHelpers::computePinningMap(CpuTopology const& topology, std::vector<DeviceLoadInfo> loads)
+{
+  std::map<std::string, int> pinning;
+  if (!topology.valid || topology.cpus.empty() || loads.empty()) {
+    return pinning;
+  }
+  // The slots are the physical cores first, interleaved over NUMA nodes
+  // and L3 groups so that successively assigned (i.e. similarly heavy)
+  // devices do not share a cache, the SMT siblings follow with the same
+  // ordering.
+  auto roundRobin = [](std::vector<CpuTopology::LogicalCpu> const& in, auto key) {
+    std::map<int, std::vector<CpuTopology::LogicalCpu>> groups;
+    for (auto& slot : in) {
+      groups[key(slot)].push_back(slot);
+    }
+    std::vector<CpuTopology::LogicalCpu> out;
+    for (size_t i = 0; out.size() < in.size(); ++i) {
+      for (auto& [k, group] : groups) {
+        if (i < group.size()) {
+          out.push_back(group[i]);
+        }
+      }
+    }
+    return out;
+  };
+  std::vector<CpuTopology::LogicalCpu> primaries;
+  std::vector<CpuTopology::LogicalCpu> siblings;
+  for (auto& slot : topology.cpus) {
+    (slot.cpu == slot.smtPrimary ? primaries : siblings).push_back(slot);
+  }
+  std::vector<CpuTopology::LogicalCpu> slots;
+  for (auto* half : {&primaries, &siblings}) {
+    auto spread = roundRobin(*half, [](CpuTopology::LogicalCpu const& slot) { return slot.l3Group; });
+    spread = roundRobin(spread, [](CpuTopology::LogicalCpu const& slot) { return slot.numaNode; });
+    slots.insert(slots.end(), spread.begin(), spread.end());
+  }
+  std::stable_sort(loads.begin(), loads.end(), [](DeviceLoadInfo const& a, DeviceLoadInfo const& b) {
+    return a.cpuLoad > b.cpuLoad;
+  });
+  for (size_t di = 0; di < loads.size(); ++di) {
+    pinning[loads[di].name] = slots[di % slots.size()].cpu;
+  }
+  return pinning;
+}
+
+bool DevicePlacementHelpers::loadPinningMap(std::string const& path, std::map<std::string, int>& pinning)
+{
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::string name;
+  int cpu;
+  while (file >> name >> cpu) {
+    pinning[name] = cpu;
+  }
+  return !pinning.empty();
+}
+
+void DevicePlacementHelpers::savePinningMap(std::string const& path, std::map<std::string, int> const& pinning)
+{
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    LOGP(error, "device placement: could not persist the pinning map to {}", path);
+    return;
+  }
+  for (auto const& [name, cpu] : pinning) {
+    file << name << " " << cpu << "\n";
+  }
+}
+
+namespace
+{
+void applyPinning(std::map<std::string, int> const& pinning,
+                  RunningWorkflowInfo const& runningWorkflow,
+                  std::vector<DeviceInfo> const& infos)
+{
+#if defined(__linux__)
+  for (size_t di = 0; di < infos.size() && di < runningWorkflow.devices.size(); ++di) {
+    auto entry = pinning.find(runningWorkflow.devices[di].id);
+    if (entry == pinning.end() || infos[di].active == false) {
+      continue;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(entry->second, &set);
+    if (sched_setaffinity(infos[di].pid, sizeof(set), &set) != 0) {
+      LOGP(error, "device placement: could not pin {} (pid {}) to cpu {}", entry->first, infos[di].pid, entry->second);
+    } else {
+      LOGP(info, "device placement: pinned {} (pid {}) to cpu {}", entry->first, infos[di].pid, entry->second);
+    }
+  }
+#else
+  LOGP(warning, "device placement: pinning is only supported on Linux");
+#endif
+}
+} // namespace
+
+void DevicePlacementHelpers::processPlacement(DriverInfo& driverInfo,
+                                              RunningWorkflowInfo const& runningWorkflow,
+                                              std::vector<DeviceInfo> const& infos,
+                                              std::vector<DeviceMetricsInfo>& metricsInfos)
+{
+  static constexpr uint64_t donePinning = -1;
+  if (driverInfo.devicePinningMode == "none" || driverInfo.devicePinningDeadline == donePinning) {
+    return;
+  }
+  if (infos.empty() || infos.size() != runningWorkflow.devices.size()) {
+    return;
+  }
+  auto now = (uint64_t)std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  auto mapPath = "dpl-pinning-" + runningWorkflow.uniqueWorkflowId + ".map";
+  if (driverInfo.devicePinningDeadline == 0) {
+    // First invocation: a pinning persisted by a previous run of this
+    // workflow is applied right away, otherwise wait for the devices to
+    // reach their steady state before measuring.
+    std::map<std::string, int> persisted;
+    if (loadPinningMap(mapPath, persisted)) {
+      LOGP(info, "device placement: applying the pinning persisted in {}", mapPath);
+      applyPinning(persisted, runningWorkflow, infos);
+      driverInfo.devicePinningDeadline = donePinning;
+      return;
+    }
+    uint64_t settle = 60;
+    if (driverInfo.devicePinningMode.rfind("auto:", 0) == 0) {
+      settle = strtoull(driverInfo.devicePinningMode.c_str() + strlen("auto:"), nullptr, 10);
+    }
+    driverInfo.devicePinningDeadline = now + settle;
+    return;
+  }
+  if (now < driverInfo.devicePinningDeadline) {
+    return;
+  }
+  auto topology = readCpuTopology();
+  if (!topology.valid) {
+    LOGP(warning, "device placement: could not read the cpu topology, not pinning");
+    driverInfo.devicePinningDeadline = donePinning;
+    return;
+  }
+  std::vector<DeviceLoadInfo> loads;
+  for (size_t di = 0; di < runningWorkflow.devices.size() && di < metricsInfos.size(); ++di) {
+    DeviceLoadInfo load{.name = runningWorkflow.devices[di].id};
+    auto& metrics = metricsInfos[di];
+    auto mi = DeviceMetricsHelper::metricIdxByName("cpu_usage_fraction", metrics);
+    if (mi != metrics.metricLabels.size() && metrics.metrics[mi].filledMetrics != 0) {
+      switch (metrics.metrics[mi].type) {
+        case MetricType::Uint64:
+          load.cpuLoad = averageMetric<uint64_t>(metrics, mi);
+          break;
+        case MetricType::Int:
+          load.cpuLoad = averageMetric<int>(metrics, mi);
+          break;
+        case MetricType::Float:
+          load.cpuLoad = averageMetric<float>(metrics, mi);
+          break;
+        default:
+          break;
+      }
+    }
+    loads.push_back(load);
+  }
+  auto pinning = computePinningMap(topology, loads);
+  applyPinning(pinning, runningWorkflow, infos);
+  savePinningMap(mapPath, pinning);
+  driverInfo.devicePinningDeadline = donePinning;
+}
+
+} // namespace o2::framework
@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEPLACEMENTHELPERS_H_
+#define O2_FRAMEWORK_DEVICEPLACEMENTHELPERS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+struct DriverInfo;
+struct DeviceInfo;
+struct DeviceMetricsInfo;
+struct RunningWorkflowInfo;
+
+/// Hardware topology of the node, one entry per online logical cpu,
+/// as read from sysfs.
+struct CpuTopology {
+  struct LogicalCpu {
+    int cpu = -1;       //!< logical cpu id
+    int numaNode = 0;   //!< NUMA node the cpu belongs to
+    int l3Group = 0;    //!< id of the L3 group (lowest cpu sharing the L3 cache)
+    int smtPrimary = 0; //!< lowest cpu id among the SMT siblings of this cpu
+  };
+  std::vector<LogicalCpu> cpus;
+  bool valid = false;
+};
+
+/// Measured steady state load of a device, used to drive the pinning.
+struct DeviceLoadInfo {
+  std::string name;
+  float cpuLoad = 0;
+};
+
+/// Helpers to pin devices to cpus based on the hardware topology of the
+/// node and on the load measured by the driver, replacing the hand
+/// written taskset maps which had to be redone for each node revision.
+struct DevicePlacementHelpers {
+  /// Read the NUMA nodes, L3 groups and SMT pairs of the node from
+  /// @a sysfsRoot (overridable for tests). The result has valid == false
+  /// when the topology cannot be read, e.g. on non Linux hosts.
+  static CpuTopology readCpuTopology(std::string const& sysfsRoot = "/sys");
+
+  /// Compute a device to cpu pinning: heaviest devices first, each on its
+  /// own physical core, spread over NUMA nodes and L3 groups; the SMT
+  /// siblings are used only once the physical cores are exhausted.
+  static std::map<std::string, int> computePinningMap(CpuTopology const& topology, std::vector<DeviceLoadInfo> loads);
+
+  /// Load / persist a pinning map (one "name cpu" pair per line).
+  static bool loadPinningMap(std::string const& path, std::map<std::string, int>& pinning);
+  static void savePinningMap(std::string const& path, std::map<std::string, int> const& pinning);
+
+  /// Invoked from the driver event loop. Applies a previously persisted
+  /// pinning for this workflow right away, otherwise waits for the
+  /// settle time, derives the pinning from the measured per device cpu
+  /// usage, applies it to the running children and persists it.
+  static void processPlacement(DriverInfo& driverInfo,
+                               RunningWorkflowInfo const& runningWorkflow,
+                               std::vector<DeviceInfo> const& infos,
+                               std::vector<DeviceMetricsInfo>& metricsInfos);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEPLACEMENTHELPERS_H_
@@ -13,6 +13,7 @@
 #include "Framework/RuntimeError.h"
 #include "Framework/Logger.h"
 #include "Framework/DeviceController.h"
+#include <unordered_map>
 
 namespace o2::framework
 {
@@ -30,6 +31,10 @@ void DevicesManager::flush()
 {
   static bool notifiedUnavailable = false;
   static bool notifiedAvailable = false;
+  // Coalesce all the messages for a given device into one write on its
+  // control connection, so that a workflow wide command costs one write
+  // per device rather than one per message.
+  std::unordered_map<int, std::vector<std::string>> batches;
   for (auto& handle : messages) {
     auto controller = controls[handle.ref.index].controller;
     // Device might not be started yet, by the time we write to it.
@@ -44,7 +49,10 @@ void DevicesManager::flush()
       LOGP(info, "Controller for {} now available.", specs[handle.ref.index].id);
       notifiedAvailable = true;
     }
-    controller->write(handle.message.c_str(), handle.message.size());
+    batches[handle.ref.index].push_back(handle.message);
+  }
+  for (auto& [di, batch] : batches) {
+    controls[di].controller->write(batch);
   }
 
   auto checkIfController = [this](DeviceMessageHandle const& handle) {
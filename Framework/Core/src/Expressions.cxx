@@ -16,6 +16,7 @@
 #include "gandiva/tree_expr_builder.h"
 #include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <set>
 #include <stack>
 #include <unordered_map>
@@ -430,6 +431,25 @@ Operations createOperations(Filter const& expression)
   return OperationSpecs;
 }
 
+namespace
+{
+/// Gandiva JIT-compiles a new LLVM module for every Filter/Projector it
+/// makes, which costs seconds at startup for trains with many identical
+/// filters. Compiled kernels only depend on the schema and on the
+/// expression tree, so we memoize them process-wide on those two.
+std::mutex gKernelCacheMutex;
+std::unordered_map<std::string, std::shared_ptr<gandiva::Filter>> gFilterCache;
+std::unordered_map<std::string, std::shared_ptr<gandiva::Projector>> gProjectorCache;
+
+std::string kernelCacheKey(gandiva::SchemaPtr const& schema, std::string const& expressionSignature)
+{
+  std::string key = schema->ToString();
+  key += '|';
+  key += expressionSignature;
+  return key;
+}
+} // namespace
+
 gandiva::ConditionPtr makeCondition(gandiva::NodePtr node)
 {
   return gandiva::TreeExprBuilder::MakeCondition(std::move(node));
@@ -443,19 +463,20 @@ gandiva::ExpressionPtr makeExpression(gandiva::NodePtr node, gandiva::FieldPtr r
 std::shared_ptr<gandiva::Filter>
   createFilter(gandiva::SchemaPtr const& Schema, Operations const& opSpecs)
 {
-  std::shared_ptr<gandiva::Filter> filter;
-  auto s = gandiva::Filter::Make(Schema,
-                                 makeCondition(createExpressionTree(opSpecs, Schema)),
-                                 &filter);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
-  }
-  return filter;
+  return createFilter(Schema, makeCondition(createExpressionTree(opSpecs, Schema)));
 }
 
 std::shared_ptr<gandiva::Filter>
   createFilter(gandiva::SchemaPtr const& Schema, gandiva::ConditionPtr condition)
 {
+  auto key = kernelCacheKey(Schema, condition->ToString());
+  {
+    std::lock_guard<std::mutex> lock(gKernelCacheMutex);
+    auto cached = gFilterCache.find(key);
+    if (cached != gFilterCache.end()) {
+      return cached->second;
+    }
+  }
   std::shared_ptr<gandiva::Filter> filter;
   auto s = gandiva::Filter::Make(Schema,
                                  std::move(condition),
@@ -463,19 +484,32 @@ std::shared_ptr<gandiva::Filter>
   if (!s.ok()) {
     throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
   }
+  std::lock_guard<std::mutex> lock(gKernelCacheMutex);
+  gFilterCache.emplace(std::move(key), filter);
   return filter;
 }
 
 std::shared_ptr<gandiva::Projector>
   createProjector(gandiva::SchemaPtr const& Schema, Operations const& opSpecs, gandiva::FieldPtr result)
 {
+  auto expression = makeExpression(createExpressionTree(opSpecs, Schema), std::move(result));
+  auto key = kernelCacheKey(Schema, expression->ToString());
+  {
+    std::lock_guard<std::mutex> lock(gKernelCacheMutex);
+    auto cached = gProjectorCache.find(key);
+    if (cached != gProjectorCache.end()) {
+      return cached->second;
+    }
+  }
   std::shared_ptr<gandiva::Projector> projector;
   auto s = gandiva::Projector::Make(Schema,
-                                    {makeExpression(createExpressionTree(opSpecs, Schema), std::move(result))},
+                                    {std::move(expression)},
                                     &projector);
   if (!s.ok()) {
     throw runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
   }
+  std::lock_guard<std::mutex> lock(gKernelCacheMutex);
+  gProjectorCache.emplace(std::move(key), projector);
   return projector;
 }
 
@@ -500,12 +534,28 @@ std::shared_ptr<gandiva::Projector> createProjectorHelper(size_t nColumns, expre
         fields[ci]));
   }
 
+  std::string signature;
+  for (auto& expression : expressions) {
+    signature += expression->ToString();
+    signature += ';';
+  }
+  auto key = kernelCacheKey(schema, signature);
+  {
+    std::lock_guard<std::mutex> lock(gKernelCacheMutex);
+    auto cached = gProjectorCache.find(key);
+    if (cached != gProjectorCache.end()) {
+      return cached->second;
+    }
+  }
+
   std::shared_ptr<gandiva::Projector> projector;
   auto s = gandiva::Projector::Make(
     schema,
     expressions,
     &projector);
   if (s.ok()) {
+    std::lock_guard<std::mutex> lock(gKernelCacheMutex);
+    gProjectorCache.emplace(std::move(key), projector);
     return projector;
   }
   throw o2::framework::runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
@@ -206,13 +206,38 @@ InjectorFunction o2DataModelAdaptor(OutputSpec const& spec, uint64_t startTime,
 {
   return [spec](TimingInfo&, ServiceRegistryRef const& ref, fair::mq::Parts& parts, ChannelRetriever channelRetriever, size_t newTimesliceId, bool& stop) -> bool {
     auto* device = ref.get<RawDeviceService>().device();
+    // Messages which can be forwarded as they are, grouped by output channel.
+    std::unordered_map<std::string, fair::mq::Parts> forwards;
     for (int i = 0; i < parts.Size() / 2; ++i) {
       auto dh = o2::header::get<DataHeader*>(parts.At(i * 2)->GetData());
 
-      DataProcessingHeader dph{newTimesliceId, 0};
-      o2::header::Stack headerStack{*dh, dph};
+      // If the incoming message already carries a complete header stack whose
+      // DataHeader matches the configured spec, we do not need to re-wrap it:
+      // the only thing to adjust is the timeslice in the DataProcessingHeader
+      // and that can be patched in place. Header and payload messages are then
+      // re-addressed to the output channel as they are, without any allocation
+      // or copy; for shared memory messages the transport only passes the
+      // region reference on, keeping the data alive via its reference count.
+      auto dph = dh ? o2::header::get<DataProcessingHeader*>(parts.At(i * 2)->GetData()) : nullptr;
+      if (dph != nullptr && DataSpecUtils::match(spec, OutputSpec{dh->dataOrigin, dh->dataDescription, dh->subSpecification})) {
+        auto channelName = channelRetriever(spec, newTimesliceId);
+        if (channelName.empty()) {
+          LOG(warning) << "can not find matching channel for " << DataSpecUtils::describe(spec);
+          continue;
+        }
+        const_cast<DataProcessingHeader*>(dph)->startTime = newTimesliceId;
+        forwards[channelName].AddPart(std::move(parts.At(i * 2)));
+        forwards[channelName].AddPart(std::move(parts.At(i * 2 + 1)));
+        continue;
+      }
+
+      DataProcessingHeader dph2{newTimesliceId, 0};
+      o2::header::Stack headerStack{*dh, dph2};
       sendOnChannel(*device, std::move(headerStack), std::move(parts.At(i * 2 + 1)), spec, channelRetriever);
     }
+    for (auto& [channelName, channelParts] : forwards) {
+      sendOnChannel(*device, channelParts, channelName, newTimesliceId);
+    }
     return parts.Size() > 0;
   };
 }
@@ -0,0 +1,163 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/SamplingProfiler.h"
+#include "Framework/Logger.h"
+
+#include <Monitoring/Monitoring.h>
+
+#include <algorithm>
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+
+namespace o2::framework
+{
+
+namespace
+{
+// The profiler the signal handler feeds. There is at most one per process.
+std::atomic<SamplingProfiler*> gProfiler{nullptr};
+
+// Append the current stack to the ring. Runs in signal context, so it
+// must not allocate, lock or do I/O; backtrace() itself is safe after
+// the first call, which start() takes care of triggering.
+void profilerSignalHandler(int)
+{
+  auto* profiler = gProfiler.load(std::memory_order_acquire);
+  if (profiler == nullptr) {
+    return;
+  }
+  uint32_t claimed = profiler->mHead.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = profiler->mRing[claimed % SamplingProfiler::RingSize];
+  if (slot.ready.load(std::memory_order_acquire) != 0) {
+    // The main loop did not drain fast enough, drop the sample.
+    profiler->mOverruns.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Skip the two innermost frames, the handler and the signal trampoline.
+  void* raw[SamplingProfiler::MaxDepth + 2];
+  int depth = backtrace(raw, SamplingProfiler::MaxDepth + 2);
+  slot.depth = depth > 2 ? depth - 2 : 0;
+  memcpy(slot.pcs, raw + 2, slot.depth * sizeof(void*));
+  slot.ready.store(1, std::memory_order_release);
+}
+} // namespace
+
+void SamplingProfiler::start(int frequencyHz)
+{
+  // Warm up backtrace() outside of signal context, it may dlopen on first use.
+  void* dummy[4];
+  backtrace(dummy, 4);
+
+  gProfiler.store(this, std::memory_order_release);
+  struct sigaction action = {};
+  action.sa_handler = profilerSignalHandler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGPROF, &action, nullptr);
+
+  itimerval interval = {};
+  interval.it_interval.tv_sec = 0;
+  interval.it_interval.tv_usec = 1000000 / frequencyHz;
+  interval.it_value = interval.it_interval;
+  setitimer(ITIMER_PROF, &interval, nullptr);
+  LOGP(info, "Sampling profiler armed at {} Hz", frequencyHz);
+}
+
+void SamplingProfiler::stop()
+{
+  itimerval interval = {};
+  setitimer(ITIMER_PROF, &interval, nullptr);
+  gProfiler.store(nullptr, std::memory_order_release);
+  signal(SIGPROF, SIG_IGN);
+}
+
+void SamplingProfiler::drain()
+{
+  uint32_t head = mHead.load(std::memory_order_acquire);
+  while (mTail != head) {
+    auto& slot = mRing[mTail % RingSize];
+    if (slot.ready.load(std::memory_order_acquire) == 0) {
+      // Claimed but not yet filled, retry on the next drain.
+      break;
+    }
+    std::vector<void*> pcs(slot.pcs, slot.pcs + slot.depth);
+    slot.ready.store(0, std::memory_order_release);
+    mTail++;
+    mAggregate[pcs]++;
+    mSamples++;
+  }
+}
+
+std::string SamplingProfiler::foldStack(std::vector<void*> const& pcs)
+{
+  std::string folded;
+  // Folded stacks grow from the outermost frame, backtrace() returns the
+  // innermost one first.
+  for (auto pc = pcs.rbegin(); pc != pcs.rend(); ++pc) {
+    auto cached = mSymbolCache.find(*pc);
+    if (cached == mSymbolCache.end()) {
+      std::string name = "[unknown]";
+      void* frame[1] = {*pc};
+      char** symbols = backtrace_symbols(frame, 1);
+      if (symbols != nullptr) {
+        // Format is "module(mangled+0x0f) [0x...]", extract the mangled part.
+        char* begin = strchr(symbols[0], '(');
+        char* end = begin ? strchr(begin, '+') : nullptr;
+        if (begin && end && end > begin + 1) {
+          std::string mangled{begin + 1, end};
+          int status = 0;
+          char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+          name = status == 0 ? demangled : mangled;
+          free(demangled);
+        }
+        free(symbols);
+      }
+      cached = mSymbolCache.emplace(*pc, std::move(name)).first;
+    }
+    if (!folded.empty()) {
+      folded += ";";
+    }
+    folded += cached->second;
+  }
+  return folded;
+}
+
+void SamplingProfiler::publish(o2::monitoring::Monitoring& monitoring)
+{
+  if (mSamples == mLastPublished) {
+    return;
+  }
+  // Largest counts first, so that a capped backend keeps the hotspots.
+  std::vector<std::pair<uint64_t, std::vector<void*> const*>> byWeight;
+  byWeight.reserve(mAggregate.size());
+  for (auto& [pcs, count] : mAggregate) {
+    byWeight.emplace_back(count, &pcs);
+  }
+  std::sort(byWeight.begin(), byWeight.end(), [](auto const& a, auto const& b) { return a.first > b.first; });
+
+  constexpr size_t maxStacks = 128;
+  for (size_t i = 0; i < byWeight.size() && i < maxStacks; ++i) {
+    o2::monitoring::Metric metric{"dpl/profiled_stack"};
+    metric.addValue(foldStack(*byWeight[i].second), "stack");
+    metric.addValue(byWeight[i].first, "count");
+    monitoring.send(std::move(metric));
+  }
+  uint32_t overruns = mOverruns.load(std::memory_order_relaxed);
+  LOGP(info, "Sampling profiler: {} samples, {} unique stacks ({} published), {} dropped",
+       mSamples, mAggregate.size(), std::min(byWeight.size(), maxStacks), overruns);
+  mLastPublished = mSamples;
+}
+
+} // namespace o2::framework
@@ -15,7 +15,11 @@
 #include "arrow/type_traits.h"
 #include <arrow/util/key_value_metadata.h>
 #include <TBufferFile.h>
+#include <TROOT.h>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <utility>
 namespace TableTreeHelpers
 {
@@ -562,16 +566,53 @@ void TreeToTable::setLabel(const char* label)
   mTableLabel = label;
 }
 
-void TreeToTable::fill(TTree*)
+void TreeToTable::fill(TTree*, int nDecodeThreads)
 {
-  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
-  std::vector<std::shared_ptr<arrow::Field>> fields;
-  static TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
-  for (auto& reader : mBranchReaders) {
-    buffer.Reset();
-    auto arrayAndField = reader->read(&buffer);
-    columns.push_back(arrayAndField.first);
-    fields.push_back(arrayAndField.second);
+  auto nReaders = mBranchReaders.size();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(nReaders);
+  std::vector<std::shared_ptr<arrow::Field>> fields(nReaders);
+  auto nThreads = std::min<size_t>(std::max(nDecodeThreads, 1), nReaders);
+  if (nThreads > 1) {
+    // branches are independent: decompress and convert them in parallel,
+    // each worker with its own transient buffer
+    ROOT::EnableThreadSafety();
+    std::atomic<size_t> nextReader{0};
+    std::exception_ptr readError;
+    std::mutex readErrorLock;
+    std::vector<std::thread> workers;
+    workers.reserve(nThreads);
+    for (size_t t = 0; t < nThreads; ++t) {
+      workers.emplace_back([&]() {
+        TBufferFile workerBuffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
+        for (auto i = nextReader++; i < nReaders; i = nextReader++) {
+          try {
+            auto arrayAndField = mBranchReaders[i]->read(&workerBuffer);
+            columns[i] = arrayAndField.first;
+            fields[i] = arrayAndField.second;
+          } catch (...) {
+            std::lock_guard lock{readErrorLock};
+            if (!readError) {
+              readError = std::current_exception();
+            }
+            return;
+          }
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    if (readError) {
+      std::rethrow_exception(readError);
+    }
+  } else {
+    static TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
+    for (size_t i = 0; i < nReaders; ++i) {
+      buffer.Reset();
+      auto arrayAndField = mBranchReaders[i]->read(&buffer);
+      columns[i] = arrayAndField.first;
+      fields[i] = arrayAndField.second;
+    }
   }
 
   auto schema = std::make_shared<arrow::Schema>(fields, std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{mTableLabel}));
@@ -0,0 +1,82 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TimesliceArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace o2::framework
+{
+
+TimesliceArena::TimesliceArena(size_t slabSize)
+  : mSlabSize{slabSize}
+{
+}
+
+TimesliceArena::~TimesliceArena()
+{
+  for (auto& slab : mSlabs) {
+    std::free(slab.data);
+  }
+}
+
+void* TimesliceArena::Resource::do_allocate(size_t bytes, size_t alignment)
+{
+  return mArena.allocate(bytes, alignment);
+}
+
+void* TimesliceArena::allocate(size_t bytes, size_t alignment)
+{
+  while (mCurrentSlab < mSlabs.size()) {
+    auto& slab = mSlabs[mCurrentSlab];
+    size_t aligned = (mCurrentOffset + alignment - 1) & ~(alignment - 1);
+    if (aligned + bytes <= slab.size) {
+      mCurrentOffset = aligned + bytes;
+      mUsed += bytes;
+      return slab.data + aligned;
+    }
+    mCurrentSlab++;
+    mCurrentOffset = 0;
+  }
+  addSlab(bytes + alignment);
+  return allocate(bytes, alignment);
+}
+
+void TimesliceArena::addSlab(size_t minSize)
+{
+  size_t size = std::max(mSlabSize, minSize);
+  char* data = static_cast<char*>(std::aligned_alloc(alignof(std::max_align_t), (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1)));
+  if (data == nullptr) {
+    throw std::bad_alloc{};
+  }
+  mSlabs.push_back({data, size});
+  mCurrentSlab = mSlabs.size() - 1;
+  mCurrentOffset = 0;
+}
+
+void TimesliceArena::reset()
+{
+  mCurrentSlab = 0;
+  mCurrentOffset = 0;
+  mUsed = 0;
+}
+
+size_t TimesliceArena::capacity() const
+{
+  size_t total = 0;
+  for (auto& slab : mSlabs) {
+    total += slab.size;
+  }
+  return total;
+}
+
+} // namespace o2::framework
@@ -28,6 +28,7 @@ void TimesliceIndex::resize(size_t s)
   mVariables.resize(s);
   mPublishedVariables.resize(s);
   mDirty.resize(s, false);
+  mSlotMinDirty = true;
 }
 
 void TimesliceIndex::associate(TimesliceId timestamp, TimesliceSlot slot)
@@ -36,6 +37,7 @@ void TimesliceIndex::associate(TimesliceId timestamp, TimesliceSlot slot)
   mVariables[slot.index].put({0, static_cast<uint64_t>(timestamp.value)});
   mVariables[slot.index].commit();
   mDirty[slot.index] = true;
+  mSlotMinDirty = true;
   O2_SIGNPOST_ID_GENERATE(tid, timeslice_index);
   O2_SIGNPOST_EVENT_EMIT(timeslice_index, tid, "associate", "Associating timestamp %zu to slot %zu", timestamp.value, slot.index);
 }
@@ -68,6 +70,7 @@ TimesliceSlot TimesliceIndex::findOldestSlot(TimesliceId timestamp) const
 std::tuple<TimesliceIndex::ActionTaken, TimesliceSlot> TimesliceIndex::replaceLRUWith(data_matcher::VariableContext& newContext, TimesliceId timestamp)
 {
   auto oldestSlot = findOldestSlot(timestamp);
+  mSlotMinDirty = true;
   O2_SIGNPOST_ID_GENERATE(tid, timeslice_index);
   if (TimesliceIndex::isValid(oldestSlot) == false) {
     mVariables[oldestSlot.index] = newContext;
@@ -148,18 +151,27 @@ TimesliceIndex::OldestInputInfo TimesliceIndex::setOldestPossibleInput(Timeslice
                                  timestamp.value, channel.value, mChannels[channel.value].oldestForChannel.value);
   }
   mChannels[channel.value].oldestForChannel = timestamp;
-  OldestInputInfo result{timestamp, channel};
+  // The per-channel values are monotonically increasing, so the minimum
+  // can only move when the channel currently holding it advances (or when
+  // we never computed it). Only in that case we need to look at the other
+  // channels again, which makes this O(1) for the common case of updates
+  // on non-minimum channels.
   bool changed = false;
-  for (int ci = 0; ci < mChannels.size(); ci++) {
-    // Check if this is a real channel. Skip otherwise.
-    auto& channelRef = mChannels[ci];
-    if (channelRef.channelType != ChannelAccountingType::DPL) {
-      continue;
-    }
-    auto& a = channelRef.oldestForChannel;
-    if (a.value < result.timeslice.value) {
-      changed = true;
-      result = {a, ChannelIndex{ci}};
+  OldestInputInfo result = mOldestPossibleInput;
+  if (mOldestPossibleInput.channel.value == ChannelIndex::INVALID ||
+      mOldestPossibleInput.channel.value == channel.value) {
+    result = {timestamp, channel};
+    for (int ci = 0; ci < mChannels.size(); ci++) {
+      // Check if this is a real channel. Skip otherwise.
+      auto& channelRef = mChannels[ci];
+      if (channelRef.channelType != ChannelAccountingType::DPL) {
+        continue;
+      }
+      auto& a = channelRef.oldestForChannel;
+      if (a.value < result.timeslice.value) {
+        changed = true;
+        result = {a, ChannelIndex{ci}};
+      }
     }
   }
   if (changed && mOldestPossibleInput.timeslice.value != result.timeslice.value) {
@@ -197,19 +209,32 @@ TimesliceIndex::OldestOutputInfo TimesliceIndex::updateOldestPossibleOutput(bool
   auto oldestInput = getOldestPossibleInput();
   OldestOutputInfo result{oldestInput.timeslice, oldestInput.channel};
 
-  bool changed = false;
-  for (size_t i = 0; i < mVariables.size(); i++) {
-    // We do not check invalid slots.
-    if (isValid(TimesliceSlot{i}) == false) {
-      continue;
-    }
-    auto timestamp = std::get_if<uint64_t>(&mVariables[i].get(0));
-    if (timestamp != nullptr && *timestamp < result.timeslice.value) {
-      changed = true;
-      result.timeslice = TimesliceId{*timestamp};
-      result.slot = {i};
-      result.channel = {(int)-1};
+  // Rescan the slots only if something mutated them since the last
+  // computation, otherwise reuse the cached minimum.
+  if (mSlotMinDirty) {
+    mOldestValidSlotTimeslice = {TimesliceId::INVALID};
+    mOldestValidSlot = {TimesliceSlot::INVALID};
+    mValidSlotCount = 0;
+    for (size_t i = 0; i < mVariables.size(); i++) {
+      // We do not check invalid slots.
+      if (isValid(TimesliceSlot{i}) == false) {
+        continue;
+      }
+      mValidSlotCount++;
+      auto timestamp = std::get_if<uint64_t>(&mVariables[i].get(0));
+      if (timestamp != nullptr && (TimesliceId::isValid(mOldestValidSlotTimeslice) == false || *timestamp < mOldestValidSlotTimeslice.value)) {
+        mOldestValidSlotTimeslice = TimesliceId{*timestamp};
+        mOldestValidSlot = {i};
+      }
     }
+    mSlotMinDirty = false;
+  }
+  bool changed = false;
+  if (TimesliceId::isValid(mOldestValidSlotTimeslice) && mOldestValidSlotTimeslice.value < result.timeslice.value) {
+    changed = true;
+    result.timeslice = mOldestValidSlotTimeslice;
+    result.slot = mOldestValidSlot;
+    result.channel = {(int)-1};
   }
   O2_SIGNPOST_ID_GENERATE(tid, timeslice_index);
   if (mOldestPossibleOutput.timeslice.value != result.timeslice.value) {
@@ -249,6 +274,7 @@ auto TimesliceIndex::reset() -> void
   for (auto& channel : mChannels) {
     channel.oldestForChannel = {0};
   }
+  mSlotMinDirty = true;
 }
 
 } // namespace o2::framework
@@ -31,7 +31,10 @@
 #include "Framework/Variant.h"
 #include "Headers/DataHeader.h"
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <list>
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -177,6 +180,9 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
                 {"condition-tf-per-query", VariantType::Int, defaultConditionQueryRate(), {"check condition validity per requested number of TFs, fetch only once if <=0"}},
                 {"condition-tf-per-query-multiplier", VariantType::Int, defaultConditionQueryRateMultiplier(), {"check conditions once per this amount of nominal checks"}},
                 {"condition-time-tolerance", VariantType::Int64, 5000ll, {"prefer creation time if its difference to orbit-derived time exceeds threshold (ms), impose if <0"}},
+                {"condition-shm-cache", VariantType::Bool, false, {"share fetched condition payloads between the workflows on this node via shared memory"}},
+                {"condition-prefetch", VariantType::Bool, false, {"fetch the next validity interval's condition objects in the background before they are needed"}},
+                {"condition-prefetch-margin", VariantType::Int64, 10000ll, {"how long before the end of validity of a cached object its successor is prefetched (ms)"}},
                 {"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
                 {"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
                 {"start-value-enumeration", VariantType::Int64, 0ll, {"initial value for the enumeration"}},
@@ -215,6 +221,9 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
     .algorithm = AlgorithmSpec::dummyAlgorithm(),
     .options = {ConfigParamSpec{"aod-file-private", VariantType::String, ctx.options().get<std::string>("aod-file"), {"AOD file"}},
                 ConfigParamSpec{"aod-max-io-rate", VariantType::Float, 0.f, {"Maximum I/O rate in MB/s"}},
+                ConfigParamSpec{"aod-file-readahead-depth", VariantType::Int, 0, {"Number of input files to open ahead asynchronously (0 disables readahead)"}},
+                ConfigParamSpec{"aod-decode-threads", VariantType::Int, static_cast<int>(ctx.options().get<int64_t>("readers")), {"Number of threads decompressing and converting branches per reader, defaults to the --readers value"}},
+                ConfigParamSpec{"aod-prune-unused-columns", VariantType::Bool, false, {"Read only the branches the subscribing tasks declare. Branches not part of the declared data model are skipped"}},
                 ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
                 ConfigParamSpec{"aod-parent-access-level", VariantType::String, {"Allow parent file access up to specified level. Default: no (0)"}},
                 ConfigParamSpec{"aod-parent-base-path-replacement", VariantType::String, {R"(Replace base path of parent files. Syntax: FROM;TO. E.g. "alien:///path/in/alien;/local/path". Enclose in "" on the command line.)"}},
@@ -749,6 +758,105 @@ void WorkflowHelpers::adjustTopology(WorkflowSpec& workflow, ConfigContext const
   }
 }
 
+void WorkflowHelpers::optimizeTopology(WorkflowSpec& workflow)
+{
+  // Devices which declare themselves as pass-through replicate their inputs
+  // on their outputs without altering the data. Since DPL routes by data
+  // spec and not by device name, dropping such a device leaves its
+  // consumers matched to the original producer directly, saving a process,
+  // its shmem registrations and two message hops per timeframe. Generated
+  // topologies can contain dozens of them.
+  DataProcessorLabel passThroughLabel{"pass-through"};
+  auto removable = [&passThroughLabel](DataProcessorSpec const& spec) {
+    if (std::find(spec.labels.begin(), spec.labels.end(), passThroughLabel) == spec.labels.end()) {
+      return false;
+    }
+    if (spec.outputs.empty()) {
+      return false;
+    }
+    for (auto& output : spec.outputs) {
+      bool replicated = std::any_of(spec.inputs.begin(), spec.inputs.end(),
+                                    [&output](InputSpec const& input) { return DataSpecUtils::match(input, output); });
+      if (!replicated) {
+        LOGP(error, "workflow optimization: {} is labeled pass-through but its output {} does not replicate any input, keeping it",
+             spec.name, DataSpecUtils::describe(output));
+        return false;
+      }
+    }
+    return true;
+  };
+  for (size_t i = workflow.size(); i > 0; --i) {
+    if (removable(workflow[i - 1])) {
+      LOGP(info, "workflow optimization: dropping pass-through device {}, its consumers are connected to the original producers", workflow[i - 1].name);
+      workflow.erase(workflow.begin() + (i - 1));
+    }
+  }
+
+  for (size_t pi = 0; pi < workflow.size(); ++pi) {
+    auto const& producer = workflow[pi];
+    if (producer.outputs.empty()) {
+      continue;
+    }
+    // Producers whose outputs are all consumed by one and the same device
+    // are candidates for being merged with it. We cannot fuse the two user
+    // algorithms into one process here, so we report the chains and leave
+    // the merging to the topology generators.
+    std::set<size_t> consumers;
+    bool allConsumed = true;
+    for (auto const& output : producer.outputs) {
+      bool consumed = false;
+      for (size_t ci = 0; ci < workflow.size(); ++ci) {
+        if (ci == pi) {
+          continue;
+        }
+        for (auto const& input : workflow[ci].inputs) {
+          if (DataSpecUtils::match(input, output)) {
+            consumers.insert(ci);
+            consumed = true;
+          }
+        }
+      }
+      allConsumed &= consumed;
+    }
+    if (allConsumed && consumers.size() == 1) {
+      LOGP(info, "workflow optimization: all outputs of {} are consumed by {} alone, candidate for merging at topology generation time",
+           producer.name, workflow[*consumers.begin()].name);
+    }
+    // Predicted channel loads from declared output sizes: a device may
+    // declare "expected-output-size:<binding>" metadata with the average
+    // number of bytes per timeframe of the corresponding output.
+    std::map<size_t, int64_t> predictedLoad;
+    for (auto const& entry : producer.metadata) {
+      constexpr char const* prefix = "expected-output-size:";
+      if (entry.key.rfind(prefix, 0) != 0) {
+        continue;
+      }
+      auto binding = entry.key.substr(strlen(prefix));
+      auto spec = std::find_if(producer.outputs.begin(), producer.outputs.end(),
+                               [&binding](OutputSpec const& output) { return output.binding.value == binding; });
+      if (spec == producer.outputs.end()) {
+        LOGP(error, "workflow optimization: {} declares {} but has no output bound to {}", producer.name, entry.key, binding);
+        continue;
+      }
+      auto bytes = strtoll(entry.value.c_str(), nullptr, 10);
+      for (size_t ci = 0; ci < workflow.size(); ++ci) {
+        if (ci == pi) {
+          continue;
+        }
+        for (auto const& input : workflow[ci].inputs) {
+          if (DataSpecUtils::match(input, *spec)) {
+            predictedLoad[ci] += bytes;
+          }
+        }
+      }
+    }
+    for (auto const& [ci, bytes] : predictedLoad) {
+      LOGP(info, "workflow optimization: predicted channel load {} -> {}: {} bytes/timeframe",
+           producer.name, workflow[ci].name, bytes);
+    }
+  }
+}
+
 void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
                                      std::vector<DeviceConnectionEdge>& logicalEdges,
                                      std::vector<OutputSpec>& outputs,
@@ -185,6 +185,17 @@ struct WorkflowHelpers {
   // Final adjustments to @a workflow after service devices have been injected.
   static void adjustTopology(WorkflowSpec& workflow, ConfigContext const& ctx);
 
+  // Static optimization pass over @a workflow, run before the service
+  // devices are injected:
+  // - devices labeled "pass-through" whose outputs all replicate one of
+  //   their inputs are dropped, their consumers then match the original
+  //   producer directly;
+  // - producers whose outputs are all consumed by a single device are
+  //   reported as candidates for merging at topology generation time;
+  // - channel loads predicted from "expected-output-size:<binding>"
+  //   metadata are reported.
+  static void optimizeTopology(WorkflowSpec& workflow);
+
   static void constructGraph(const WorkflowSpec& workflow,
                              std::vector<DeviceConnectionEdge>& logicalEdges,
                              std::vector<OutputSpec>& outputs,
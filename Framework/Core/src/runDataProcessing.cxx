@@ -72,6 +72,7 @@
 #include "ComputingResourceHelpers.h"
 #include "DataProcessingStatus.h"
 #include "DDSConfigHelpers.h"
+#include "DevicePlacementHelpers.h"
 #include "O2ControlHelpers.h"
 #include "DeviceSpecHelpers.h"
 #include "GraphvizHelpers.h"
@@ -100,6 +101,7 @@
 #include <TEnv.h>
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
 #include <cstdio>
@@ -108,6 +110,7 @@
 #include <csignal>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <regex>
 #include <set>
 #include <string>
@@ -523,15 +526,17 @@ void ws_connect_callback(uv_stream_t* server, int status)
 }
 
 struct StreamConfigContext {
-  std::string configuration;
+  // Shared between all the children, the workflow can be sizable
+  // and there is no point in copying it once per device.
+  std::shared_ptr<const std::string> configuration;
   int fd;
 };
 
 void stream_config(uv_work_t* req)
 {
   auto* context = (StreamConfigContext*)req->data;
-  size_t result = write(context->fd, context->configuration.data(), context->configuration.size());
-  if (result != context->configuration.size()) {
+  size_t result = write(context->fd, context->configuration->data(), context->configuration->size());
+  if (result != context->configuration->size()) {
     LOG(error) << "Unable to pass configuration to children";
   }
   {
@@ -599,7 +604,7 @@ void handleSignals()
 }
 
 void handleChildrenStdio(DriverServerContext* serverContext,
-                         std::string const& forwardedStdin,
+                         std::shared_ptr<const std::string> forwardedStdin,
                          std::vector<DeviceStdioContext>& childFds,
                          std::vector<uv_poll_t*>& handles)
 {
@@ -1050,6 +1055,7 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
     char const* defaultSignposts = getenv("DPL_SIGNPOSTS");
     optsDesc.add_options()("monitoring-backend", bpo::value<std::string>()->default_value("default"), "monitoring backend info")                                                                   //
       ("dpl-stats-min-online-publishing-interval", bpo::value<std::string>()->default_value("0"), "minimum flushing interval for online metrics (in s)")                                           //
+      ("dpl-stats-unchanged-refresh-backoff", bpo::value<std::string>()->default_value("0"), "cap (in s) for the exponential backoff of unchanged metrics refreshes, 0 to disable")                //
       ("driver-client-backend", bpo::value<std::string>()->default_value(defaultDriverClient), "backend for device -> driver communicataon: stdout://: use stdout, ws://: use websockets")         //
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                                   //
       ("dpl-tracing-flags", bpo::value<std::string>()->default_value(""), "pipe `|` separate list of events to be traced")                                                                         //
@@ -1275,6 +1281,36 @@ void dumpRunSummary(DriverServerContext& context, DriverInfo const& driverInfo,
       LOGP(info, "   - Last error: {}", info.lastError);
     }
   }
+  // Report per-stage watermarks of the timeframe latency, so that one can
+  // tell at a glance in which device of the chain timeframes spent their
+  // time. The percentiles are computed over the history of the metrics
+  // kept by the driver, i.e. the last 1024 timeframes of each device.
+  static char const* latencyMetrics[] = {"queue_latency_ms", "max_input_latency_ms", "tf_lifetime_ms"};
+  bool printedLatencyHeader = false;
+  for (size_t di = 0; di < infos.size(); ++di) {
+    auto& metricsInfo = (*context.metrics)[di];
+    auto& spec = specs[di];
+    for (auto* name : latencyMetrics) {
+      auto mi = DeviceMetricsHelper::metricIdxByName(name, metricsInfo);
+      if (mi == metricsInfo.metricLabels.size()) {
+        continue;
+      }
+      auto& metric = metricsInfo.metrics[mi];
+      if (metric.type != MetricType::Uint64 || metric.filledMetrics == 0) {
+        continue;
+      }
+      if (!printedLatencyHeader) {
+        LOGP(info, "### Timeframe latency watermarks (ms):");
+        printedLatencyHeader = true;
+      }
+      LOGP(info, " - {} {}: p50 {:.0f} p90 {:.0f} p99 {:.0f} max {:.0f}",
+           spec.name, name,
+           DeviceMetricsHelper::getNumericMetricPercentile<uint64_t>(metricsInfo, mi, 50),
+           DeviceMetricsHelper::getNumericMetricPercentile<uint64_t>(metricsInfo, mi, 90),
+           DeviceMetricsHelper::getNumericMetricPercentile<uint64_t>(metricsInfo, mi, 99),
+           metricsInfo.max[mi]);
+    }
+  }
   for (auto& summary : *context.summaryCallbacks) {
     summary(ServiceMetricsInfo{*context.metrics, *context.specs, *context.infos, context.driver->metrics, driverInfo});
   }
@@ -1996,8 +2032,15 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           guiContext.window = window;
 
           if (gui_timer) {
+            // Redraw cadence of the local GUI. On large topologies the
+            // rendering itself competes with the rest of the driver loop,
+            // so allow decoupling it from the default.
+            int guiInterval = 20;
+            if (auto* ms = getenv("DPL_GUI_INTERVAL")) {
+              guiInterval = std::max(20, atoi(ms));
+            }
             gui_timer->data = &guiContext;
-            uv_timer_start(gui_timer, gui_callback, 0, 20);
+            uv_timer_start(gui_timer, gui_callback, 0, guiInterval);
           }
           guiDeployedOnce = true;
         }
@@ -2028,6 +2071,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--aod-writer-maxfilesize",
             "--aod-writer-keep",
             "--aod-max-io-rate",
+            "--aod-file-readahead-depth",
+            "--aod-decode-threads",
+            "--aod-prune-unused-columns",
             "--aod-parent-access-level",
             "--aod-parent-base-path-replacement",
             "--driver-client-backend",
@@ -2072,8 +2118,18 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         LOG(info) << "Redeployment of configuration asked.";
         std::ostringstream forwardedStdin;
         WorkflowSerializationHelpers::dump(forwardedStdin, workflow, dataProcessorInfos, commandInfo);
+        auto configBlob = std::make_shared<const std::string>(forwardedStdin.str());
         infos.reserve(runningWorkflow.devices.size());
 
+        // The configuration is streamed to every child over its stdin from
+        // the libuv thread pool, whose default size (4) would configure a
+        // large topology almost sequentially: each worker stays blocked
+        // until its child drains the pipe during init. Size the pool after
+        // the number of devices, before its creation by the first use,
+        // unless the user tuned it already.
+        auto streamersCount = std::to_string(std::clamp((int)runningWorkflow.devices.size(), 4, 128));
+        setenv("UV_THREADPOOL_SIZE", streamersCount.c_str(), 0);
+
         // This is guaranteed to be a single CPU.
         unsigned parentCPU = -1;
         unsigned parentNode = -1;
@@ -2109,7 +2165,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           }
         }
         handleSignals();
-        handleChildrenStdio(&serverContext, forwardedStdin.str(), childFds, pollHandles);
+        handleChildrenStdio(&serverContext, configBlob, childFds, pollHandles);
         for (auto& callback : postScheduleCallbacks) {
           callback(serviceRegistry, {varmap});
         }
@@ -2130,6 +2186,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         // any, so that we do not consume CPU time when the driver is
         // idle.
         devicesManager->flush();
+        // Topology aware pinning of the devices, when requested. A no-op
+        // until the settle deadline and after the pinning was applied.
+        DevicePlacementHelpers::processPlacement(driverInfo, runningWorkflow, infos, metricsInfos);
         // We print the event loop for the gui only once every
         // 6000 iterations (i.e. ~2 minutes). To avoid spamming, while still
         // being able to see the event loop in case of a deadlock / systematic failure.
@@ -2846,7 +2905,8 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("no-IPC", bpo::value<bool>()->zero_tokens()->default_value(false), "disable IPC topology optimization")                                                           //                                                                                                                                        //
     ("o2-control,o2", bpo::value<std::string>()->default_value(""), "dump O2 Control workflow configuration under the specified name")                                 //
     ("resources-monitoring", bpo::value<unsigned short>()->default_value(0), "enable cpu/memory monitoring for provided interval in seconds")                          //
-    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds");              //
+    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds")               //
+    ("pin-devices", bpo::value<std::string>()->default_value("none"), "pin devices to cpus from hardware topology and measured load: none, auto or auto:<settle seconds>");
   // some of the options must be forwarded by default to the device
   executorOptions.add(DeviceSpecHelpers::getForwardedDeviceOptions());
 
@@ -2925,6 +2985,11 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   /// This is the earlies the services are actually needed
   OverrideServiceSpecs driverServicesOverride = ServiceSpecHelpers::parseOverrides(getenv("DPL_DRIVER_OVERRIDE_SERVICES"));
   ServiceSpecs driverServices = ServiceSpecHelpers::filterDisabled(CommonDriverServices::defaultServices(), driverServicesOverride);
+  // Run the static optimization passes before the service devices are
+  // injected, so that e.g. dropped pass-through devices do not get
+  // proxies or sinks attached to them.
+  WorkflowHelpers::optimizeTopology(physicalWorkflow);
+
   // We insert the hash for the internal devices.
   WorkflowHelpers::injectServiceDevices(physicalWorkflow, configContext);
   auto reader = std::find_if(physicalWorkflow.begin(), physicalWorkflow.end(), [](DataProcessorSpec& spec) { return spec.name == "internal-dpl-aod-reader"; });
@@ -3163,6 +3228,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.deployHostname = varmap["hostname"].as<std::string>();
   driverInfo.resources = varmap["resources"].as<std::string>();
   driverInfo.resourcesMonitoringInterval = varmap["resources-monitoring"].as<unsigned short>();
+  driverInfo.devicePinningMode = varmap["pin-devices"].as<std::string>();
   driverInfo.resourcesMonitoringDumpInterval = varmap["resources-monitoring-dump-interval"].as<unsigned short>();
 
   // FIXME: should use the whole dataProcessorInfos, actually...
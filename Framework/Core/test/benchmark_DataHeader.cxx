@@ -0,0 +1,87 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+#include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
+#include "Framework/DataProcessingHeader.h"
+
+using namespace o2::header;
+using namespace o2::framework;
+
+// Every message DPL sends carries a header Stack, so the cost of
+// serialising headers into the flat buffer and of looking them up
+// again on the receiving side is paid once per message per device.
+
+static void BM_DataHeaderConstruction(benchmark::State& state)
+{
+  for (auto _ : state) {
+    DataHeader header{"TRACKLET", "TRD", 0, 4096};
+    benchmark::DoNotOptimize(header);
+  }
+}
+
+BENCHMARK(BM_DataHeaderConstruction);
+
+static void BM_StackCreation(benchmark::State& state)
+{
+  DataHeader dh{"TRACKLET", "TRD", 0, 4096};
+  DataProcessingHeader dph{1, 0};
+
+  for (auto _ : state) {
+    Stack stack{dh, dph};
+    benchmark::DoNotOptimize(stack.data());
+  }
+}
+
+BENCHMARK(BM_StackCreation);
+
+static void BM_StackLookupFirstHeader(benchmark::State& state)
+{
+  DataHeader dh{"TRACKLET", "TRD", 0, 4096};
+  DataProcessingHeader dph{1, 0};
+  Stack stack{dh, dph};
+
+  for (auto _ : state) {
+    auto const* header = get<DataHeader*>(stack.data());
+    benchmark::DoNotOptimize(header);
+  }
+}
+
+BENCHMARK(BM_StackLookupFirstHeader);
+
+static void BM_StackLookupLastHeader(benchmark::State& state)
+{
+  DataHeader dh{"TRACKLET", "TRD", 0, 4096};
+  DataProcessingHeader dph{1, 0};
+  Stack stack{dh, dph};
+
+  for (auto _ : state) {
+    auto const* header = get<DataProcessingHeader*>(stack.data());
+    benchmark::DoNotOptimize(header);
+  }
+}
+
+BENCHMARK(BM_StackLookupLastHeader);
+
+static void BM_DataHeaderMatching(benchmark::State& state)
+{
+  DataHeader dh{"TRACKLET", "TRD", 0, 4096};
+  DataHeader probe{"TRACKLET", "TRD", 0, 4096};
+
+  for (auto _ : state) {
+    bool same = dh == probe;
+    benchmark::DoNotOptimize(same);
+  }
+}
+
+BENCHMARK(BM_DataHeaderMatching);
+
+BENCHMARK_MAIN();
@@ -1400,3 +1400,59 @@ TEST_CASE("BlockCombinationsCounters")
     previousEvent = c0.index();
   }
 }
+
+TEST_CASE("IndexBlockGenerators")
+{
+  // pairs of 5 elements: 10 combinations, in the iteration order of
+  // strictly-upper combinations
+  o2::soa::SelfPairIndexBlockGenerator pairGen{5};
+  std::array<int64_t, 4> p0;
+  std::array<int64_t, 4> p1;
+  std::vector<std::pair<int64_t, int64_t>> pairs;
+  while (auto n = pairGen.nextBlock(p0.data(), p1.data(), p0.size())) {
+    for (auto k = 0U; k < n; ++k) {
+      pairs.emplace_back(p0[k], p1[k]);
+    }
+  }
+  REQUIRE(pairs.size() == 10);
+  auto expected = 0U;
+  for (int64_t i = 0; i < 5; ++i) {
+    for (int64_t j = i + 1; j < 5; ++j) {
+      REQUIRE(pairs[expected].first == i);
+      REQUIRE(pairs[expected].second == j);
+      ++expected;
+    }
+  }
+
+  // degenerate sizes produce nothing
+  o2::soa::SelfPairIndexBlockGenerator emptyGen{1};
+  REQUIRE(emptyGen.nextBlock(p0.data(), p1.data(), p0.size()) == 0);
+
+  // triples of 5 elements: 10 combinations
+  o2::soa::SelfTripleIndexBlockGenerator tripleGen{5};
+  std::array<int64_t, 3> t0;
+  std::array<int64_t, 3> t1;
+  std::array<int64_t, 3> t2;
+  std::vector<std::tuple<int64_t, int64_t, int64_t>> triples;
+  while (auto n = tripleGen.nextBlock(t0.data(), t1.data(), t2.data(), t0.size())) {
+    for (auto k = 0U; k < n; ++k) {
+      triples.emplace_back(t0[k], t1[k], t2[k]);
+    }
+  }
+  REQUIRE(triples.size() == 10);
+  expected = 0U;
+  for (int64_t i = 0; i < 5; ++i) {
+    for (int64_t j = i + 1; j < 5; ++j) {
+      for (int64_t k = j + 1; k < 5; ++k) {
+        REQUIRE(triples[expected] == std::make_tuple(i, j, k));
+        ++expected;
+      }
+    }
+  }
+
+  // remapping through a selection yields table row numbers
+  std::vector<int64_t> selection{2, 3, 5, 8, 13};
+  std::array<int64_t, 3> mapped{0, 2, 4};
+  o2::soa::mapIndexBlock(selection, mapped.data(), mapped.size());
+  REQUIRE(mapped == std::array<int64_t, 3>{2, 5, 13});
+}
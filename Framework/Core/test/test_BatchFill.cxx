@@ -0,0 +1,83 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/BatchFill.h"
+#include <catch_amalgamated.hpp>
+
+using namespace o2::framework;
+
+TEST_CASE("BatchFill1D")
+{
+  std::vector<double> values;
+  for (auto i = 0; i < 1000; ++i) {
+    values.push_back(-1.5 + 0.0035 * i);
+  }
+
+  TH1F reference("ref1d", "ref1d", 20, -1., 1.);
+  for (auto x : values) {
+    reference.Fill(x);
+  }
+
+  TH1F batched("batch1d", "batch1d", 20, -1., 1.);
+  batch_fill::fill(batched, values);
+
+  REQUIRE(batched.GetEntries() == reference.GetEntries());
+  for (auto bin = 0; bin <= batched.GetNbinsX() + 1; ++bin) {
+    REQUIRE(batched.GetBinContent(bin) == reference.GetBinContent(bin));
+  }
+  REQUIRE(batched.GetMean() == Catch::Approx(reference.GetMean()));
+  REQUIRE(batched.GetStdDev() == Catch::Approx(reference.GetStdDev()));
+}
+
+TEST_CASE("BatchFill2D")
+{
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (auto i = 0; i < 1000; ++i) {
+    xs.push_back(-1.5 + 0.0035 * i);
+    ys.push_back(1.5 - 0.0042 * i);
+  }
+
+  TH2F reference("ref2d", "ref2d", 10, -1., 1., 12, -1.2, 1.2);
+  for (auto i = 0U; i < xs.size(); ++i) {
+    reference.Fill(xs[i], ys[i]);
+  }
+
+  TH2F batched("batch2d", "batch2d", 10, -1., 1., 12, -1.2, 1.2);
+  batch_fill::fill(batched, xs, ys);
+
+  REQUIRE(batched.GetEntries() == reference.GetEntries());
+  for (auto xBin = 0; xBin <= batched.GetNbinsX() + 1; ++xBin) {
+    for (auto yBin = 0; yBin <= batched.GetNbinsY() + 1; ++yBin) {
+      REQUIRE(batched.GetBinContent(xBin, yBin) == reference.GetBinContent(xBin, yBin));
+    }
+  }
+  REQUIRE(batched.GetMean(1) == Catch::Approx(reference.GetMean(1)));
+  REQUIRE(batched.GetMean(2) == Catch::Approx(reference.GetMean(2)));
+}
+
+TEST_CASE("BatchFillBinningPolicy")
+{
+  BinningPolicyBase<2> policy{{std::vector<double>{VARIABLE_WIDTH, 0., 1., 2., 3.},
+                               std::vector<double>{VARIABLE_WIDTH, 0., 2., 4.}},
+                              true};
+  std::vector<double> xs{0.5, 1.5, 2.5, -1., 0.5};
+  std::vector<double> ys{1., 1., 3., 1., 5.};
+
+  std::vector<int> bins;
+  batch_fill::computeBins(policy, bins, gsl::span<double const>{xs}, gsl::span<double const>{ys});
+  REQUIRE(bins.size() == xs.size());
+  for (auto i = 0U; i < xs.size(); ++i) {
+    REQUIRE(bins[i] == policy.getBin(std::make_tuple(xs[i], ys[i])));
+  }
+  // underflow in x is flagged with -1 when overflows are ignored
+  REQUIRE(bins[3] == -1);
+}
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/CompiledMatcher.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/InputSpec.h"
 #include "Framework/DataSpecUtils.h"
@@ -720,3 +721,76 @@ TEST_CASE("MatchSubspec")
 
   REQUIRE(matcher.match(header0, context) == false);
 }
+
+// The compiled program must behave exactly like the tree it was
+// lowered from, including short-circuiting and variable binding.
+TEST_CASE("CompiledMatcherParity")
+{
+  DataHeader dh;
+  dh.dataOrigin = "TPC";
+  dh.dataDescription = "CLUSTERS";
+  dh.subSpecification = 1;
+
+  DataProcessingHeader dph;
+  dph.startTime = 123;
+  Stack s{dh, dph};
+
+  DataHeader otherDh;
+  otherDh.dataOrigin = "ITS";
+  otherDh.dataDescription = "TRACKLET";
+  otherDh.subSpecification = 2;
+  Stack otherS{otherDh, dph};
+
+  DataDescriptorMatcher matcher{
+    DataDescriptorMatcher::Op::And,
+    OriginValueMatcher{"TPC"},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      DescriptionValueMatcher{"CLUSTERS"},
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::And,
+        SubSpecificationTypeValueMatcher{1},
+        StartTimeValueMatcher{ContextRef{0}}))};
+
+  CompiledMatcher compiled{matcher};
+  REQUIRE(compiled.size() != 0);
+
+  VariableContext treeContext;
+  VariableContext compiledContext;
+  REQUIRE(matcher.match(reinterpret_cast<char const*>(s.data()), treeContext) == true);
+  REQUIRE(compiled.match(reinterpret_cast<char const*>(s.data()), compiledContext) == true);
+  compiledContext.commit();
+  auto vPtr = std::get_if<uint64_t>(&compiledContext.get(0));
+  REQUIRE(vPtr != nullptr);
+  REQUIRE(*vPtr == 123);
+
+  VariableContext missContext;
+  REQUIRE(compiled.match(reinterpret_cast<char const*>(otherS.data()), missContext) == false);
+
+  // Or / Not / Xor lowering
+  DataDescriptorMatcher orMatcher{
+    DataDescriptorMatcher::Op::Or,
+    OriginValueMatcher{"ITS"},
+    OriginValueMatcher{"TPC"}};
+  CompiledMatcher compiledOr{orMatcher};
+  VariableContext orContext;
+  REQUIRE(compiledOr.match(reinterpret_cast<char const*>(s.data()), orContext) == true);
+  REQUIRE(compiledOr.match(reinterpret_cast<char const*>(otherS.data()), orContext) == true);
+
+  DataDescriptorMatcher notMatcher{
+    DataDescriptorMatcher::Op::Not,
+    OriginValueMatcher{"ITS"}};
+  CompiledMatcher compiledNot{notMatcher};
+  VariableContext notContext;
+  REQUIRE(compiledNot.match(reinterpret_cast<char const*>(s.data()), notContext) == true);
+  REQUIRE(compiledNot.match(reinterpret_cast<char const*>(otherS.data()), notContext) == false);
+
+  DataDescriptorMatcher xorMatcher{
+    DataDescriptorMatcher::Op::Xor,
+    OriginValueMatcher{"TPC"},
+    DescriptionValueMatcher{"CLUSTERS"}};
+  CompiledMatcher compiledXor{xorMatcher};
+  VariableContext xorContext;
+  REQUIRE(compiledXor.match(reinterpret_cast<char const*>(s.data()), xorContext) == false);
+  REQUIRE(compiledXor.match(reinterpret_cast<char const*>(otherS.data()), xorContext) == false);
+}
@@ -26,24 +26,30 @@ TEST_CASE("TestDataOutputDirector")
   std::string mydfn("myresultfile");
 
   // test keepString reader
-  std::string keepString("AOD/UNO/0:tr1:c1/c2/c3:fn1,AOD/UNO/0::c4");
+  std::string keepString("AOD/UNO/0:tr1:c1/c2/c3:fn1,AOD/UNO/0::c4,AOD/UNO/0:tr2::fn2:feather/zstd");
   dod.readString(keepString);
   dod.setFilenameBase(mydfn);
 
   auto ds = dod.getDataOutputDescriptors(dh);
 
-  REQUIRE(ds.size() == 2);
+  REQUIRE(ds.size() == 3);
 
   REQUIRE(ds[0]->tablename == std::string("UNO"));
   REQUIRE(ds[0]->treename == std::string("tr1"));
   REQUIRE(ds[0]->colnames.size() == 3);
   REQUIRE(ds[0]->getFilenameBase() == std::string("fn1"));
+  REQUIRE(ds[0]->outputFormat.empty());
 
   REQUIRE(ds[1]->tablename == std::string("UNO"));
   REQUIRE(ds[1]->treename == std::string("O2uno"));
   REQUIRE(ds[1]->colnames.size() == 1);
   REQUIRE(ds[1]->getFilenameBase() == std::string("myresultfile"));
 
+  REQUIRE(ds[2]->treename == std::string("tr2"));
+  REQUIRE(ds[2]->getFilenameBase() == std::string("fn2"));
+  REQUIRE(ds[2]->outputFormat == std::string("feather"));
+  REQUIRE(ds[2]->compression == std::string("zstd"));
+
   // test jsonString reader
   std::string rdn("./");
   std::string dfn("");
@@ -54,7 +60,7 @@ TEST_CASE("TestDataOutputDirector")
   dh = DataHeader(DataDescription{"DUE"},
                   DataOrigin{"AOD"},
                   DataHeader::SubSpecificationType{0});
-  std::string jsonString(R"({"OutputDirector": {"resfile": "defresults", "resfilemode": "RECREATE", "ntfmerge": 10, "OutputDescriptors": [{"table": "AOD/UNO/0", "columns": ["fEta1","fMom1"], "treename": "uno", "filename": "unoresults"}, {"table": "AOD/DUE/0", "columns": ["fPhi2"], "treename": "due"}]}})");
+  std::string jsonString(R"({"OutputDirector": {"resfile": "defresults", "resfilemode": "RECREATE", "ntfmerge": 10, "OutputDescriptors": [{"table": "AOD/UNO/0", "columns": ["fEta1","fMom1"], "treename": "uno", "filename": "unoresults"}, {"table": "AOD/DUE/0", "columns": ["fPhi2"], "treename": "due", "format": "feather", "compression": "lz4"}]}})");
 
   dod.reset();
   std::tie(rdn, dfn, fmode, mfs, ntf) = dod.readJsonString(jsonString);
@@ -69,6 +75,8 @@ TEST_CASE("TestDataOutputDirector")
   REQUIRE(ds[0]->treename == std::string("due"));
   REQUIRE(ds[0]->colnames.size() == 1);
   REQUIRE(ds[0]->getFilenameBase() == std::string("defresults"));
+  REQUIRE(ds[0]->outputFormat == std::string("feather"));
+  REQUIRE(ds[0]->compression == std::string("lz4"));
 
   // test json file reader
   std::string jsonFile("testO2config.json");
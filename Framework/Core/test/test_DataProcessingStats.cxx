@@ -341,6 +341,58 @@ TEST_CASE("DataProcessingStatsPublishing")
   REQUIRE(updated.size() == 1);
 }
 
+// Unchanged metrics which get refreshed only because of maxRefreshLatency
+// must back off exponentially up to the configured cap, and a real update
+// must reset the backoff.
+TEST_CASE("DataProcessingStatsUnchangedBackoff")
+{
+  auto realtimeTimestamp = [](int64_t& base, int64_t& offset) {
+    base = 0;
+    offset = 0;
+  };
+  int64_t count = 0;
+  static int64_t timestamps[] = {1000, 2000, 2100, 3100, 4500, 5200, 8000, 9500, 16000, 16500, 16600, 17700};
+  auto cpuTimeTimestamp = [&count](int64_t base, int64_t offset) -> int64_t {
+    return base + timestamps[count++] - offset;
+  };
+
+  DataProcessingStats stats(realtimeTimestamp, cpuTimeTimestamp,
+                            {.maxUnchangedRefreshLatency = 8000});
+  stats.registerMetric({.name = "dummy_metric", .metricId = DummyMetric, .maxRefreshLatency = 1000});
+
+  std::vector<std::string> updated;
+  auto simpleFlush = [&updated](o2::framework::DataProcessingStats::MetricSpec const& spec, int64_t timestamp, int64_t value) {
+    updated.emplace_back(spec.name);
+  };
+
+  stats.updateStats({DummyMetric, DataProcessingStats::Op::Set, 10});
+  stats.processCommandQueue();
+  stats.flushChangedMetrics(simpleFlush); // t=2100: real update published
+  REQUIRE(updated.size() == 1);
+  stats.flushChangedMetrics(simpleFlush); // t=3100: first refresh after 1000ms
+  REQUIRE(updated.size() == 2);
+  REQUIRE(stats.updateInfos[DummyMetric].unchangedRefreshes == 1);
+  stats.flushChangedMetrics(simpleFlush); // t=4500: backed off to 2000ms, too early
+  REQUIRE(updated.size() == 2);
+  stats.flushChangedMetrics(simpleFlush); // t=5200: refresh
+  REQUIRE(updated.size() == 3);
+  stats.flushChangedMetrics(simpleFlush); // t=8000: backed off to 4000ms, too early
+  REQUIRE(updated.size() == 3);
+  stats.flushChangedMetrics(simpleFlush); // t=9500: refresh
+  REQUIRE(updated.size() == 4);
+  stats.flushChangedMetrics(simpleFlush); // t=16000: capped at 8000ms, too early
+  REQUIRE(updated.size() == 4);
+
+  // A real update resets the backoff
+  stats.updateStats({DummyMetric, DataProcessingStats::Op::Set, 20});
+  stats.processCommandQueue();
+  REQUIRE(stats.updateInfos[DummyMetric].unchangedRefreshes == 0);
+  stats.flushChangedMetrics(simpleFlush); // t=16600: real update published
+  REQUIRE(updated.size() == 5);
+  stats.flushChangedMetrics(simpleFlush); // t=17700: refresh after 1000ms again
+  REQUIRE(updated.size() == 6);
+}
+
 TEST_CASE("DataProcessingStatsPublishingRepeated")
 {
   auto realtimeTimestamp = [](int64_t& base, int64_t& offset) {
@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "../src/DevicePlacementHelpers.h"
+#include <catch_amalgamated.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace o2::framework;
+
+namespace
+{
+void writeFile(std::filesystem::path const& path, std::string const& contents)
+{
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream file(path);
+  file << contents << "\n";
+}
+
+// A fake sysfs tree for a 2 NUMA node, 4 physical core, SMT-2 machine:
+// cpus 0,1 / 2,3 are the cores of node 0 / 1, cpus 4-7 their siblings,
+// one L3 per node.
+std::string makeFakeSysfs()
+{
+  auto root = std::filesystem::temp_directory_path() / "dpl_placement_test";
+  std::filesystem::remove_all(root);
+  writeFile(root / "devices/system/cpu/online", "0-7");
+  writeFile(root / "devices/system/node/node0/cpulist", "0-1,4-5");
+  writeFile(root / "devices/system/node/node1/cpulist", "2-3,6-7");
+  for (int cpu = 0; cpu < 8; ++cpu) {
+    auto cpuDir = root / ("devices/system/cpu/cpu" + std::to_string(cpu));
+    int core = cpu % 4;
+    writeFile(cpuDir / "topology/thread_siblings_list", std::to_string(core) + "," + std::to_string(core + 4));
+    writeFile(cpuDir / "cache/index3/shared_cpu_list", core < 2 ? "0-1,4-5" : "2-3,6-7");
+  }
+  return root.string();
+}
+} // namespace
+
+TEST_CASE("TestReadCpuTopology")
+{
+  auto topology = DevicePlacementHelpers::readCpuTopology(makeFakeSysfs());
+  REQUIRE(topology.valid);
+  REQUIRE(topology.cpus.size() == 8);
+  REQUIRE(topology.cpus[0].numaNode == 0);
+  REQUIRE(topology.cpus[2].numaNode == 1);
+  REQUIRE(topology.cpus[5].numaNode == 0);
+  REQUIRE(topology.cpus[0].smtPrimary == 0);
+  REQUIRE(topology.cpus[4].smtPrimary == 0);
+  REQUIRE(topology.cpus[7].smtPrimary == 3);
+  REQUIRE(topology.cpus[1].l3Group == 0);
+  REQUIRE(topology.cpus[6].l3Group == 2);
+
+  // An unreadable root yields an invalid topology.
+  REQUIRE(DevicePlacementHelpers::readCpuTopology("/nonexistent").valid == false);
+}
+
+TEST_CASE("TestComputePinningMap")
+{
+  auto topology = DevicePlacementHelpers::readCpuTopology(makeFakeSysfs());
+  REQUIRE(topology.valid);
+  std::vector<DeviceLoadInfo> loads{
+    {"reader", 0.2f},
+    {"tracker", 0.9f},
+    {"writer", 0.1f},
+    {"matcher", 0.8f},
+  };
+  auto pinning = DevicePlacementHelpers::computePinningMap(topology, loads);
+  REQUIRE(pinning.size() == 4);
+  // The two heaviest devices land on physical cores of different NUMA nodes.
+  REQUIRE(pinning["tracker"] == 0);
+  REQUIRE(pinning["matcher"] == 2);
+  REQUIRE(pinning["reader"] == 1);
+  REQUIRE(pinning["writer"] == 3);
+
+  // More devices than cpus wrap around instead of being left unpinned.
+  std::vector<DeviceLoadInfo> many;
+  for (int i = 0; i < 10; ++i) {
+    many.push_back({"dev" + std::to_string(i), 1.f});
+  }
+  auto wrapped = DevicePlacementHelpers::computePinningMap(topology, many);
+  REQUIRE(wrapped.size() == 10);
+  REQUIRE(wrapped["dev8"] == wrapped["dev0"]);
+
+  REQUIRE(DevicePlacementHelpers::computePinningMap(CpuTopology{}, loads).empty());
+}
+
+TEST_CASE("TestPinningMapPersistence")
+{
+  auto path = (std::filesystem::temp_directory_path() / "dpl_placement_test.map").string();
+  std::map<std::string, int> pinning{{"reader", 1}, {"tracker", 0}};
+  DevicePlacementHelpers::savePinningMap(path, pinning);
+  std::map<std::string, int> loaded;
+  REQUIRE(DevicePlacementHelpers::loadPinningMap(path, loaded));
+  REQUIRE(loaded == pinning);
+  std::remove(path.c_str());
+  loaded.clear();
+  REQUIRE(DevicePlacementHelpers::loadPinningMap(path, loaded) == false);
+}
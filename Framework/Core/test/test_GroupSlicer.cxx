@@ -716,6 +716,49 @@ TEST_CASE("ArrowDirectSlicing")
   }
 }
 
+TEST_CASE("TestSlicingCacheReuse")
+{
+  TableBuilder builderE;
+  auto evtsWriter = builderE.cursor<aod::Events>();
+  for (auto i = 0; i < 20; ++i) {
+    evtsWriter(0, i / 4, 0.5f * i, 2.f * i, 3.f * i);
+  }
+  auto evtTable = builderE.finalize();
+
+  auto bk = std::make_pair(soa::getLabelFromType<aod::Events>(), "fID");
+  ArrowTableSlicingCache cache({bk});
+  auto s = cache.updateCacheEntry(0, evtTable);
+  REQUIRE(s.ok());
+  REQUIRE(cache.cacheMisses == 1);
+  REQUIRE(cache.cacheHits == 0);
+
+  // a second update from the same dataframe reuses the entry
+  s = cache.updateCacheEntry(0, evtTable);
+  REQUIRE(s.ok());
+  REQUIRE(cache.cacheMisses == 1);
+  REQUIRE(cache.cacheHits == 1);
+  auto lcache = cache.getCacheFor(bk);
+  auto [offset, count] = lcache.getSliceFor(2);
+  REQUIRE(offset == 8);
+  REQUIRE(count == 4);
+
+  // a different dataframe invalidates it
+  TableBuilder builderE2;
+  auto evtsWriter2 = builderE2.cursor<aod::Events>();
+  for (auto i = 0; i < 10; ++i) {
+    evtsWriter2(0, i / 2, 0.5f * i, 2.f * i, 3.f * i);
+  }
+  auto evtTable2 = builderE2.finalize();
+  s = cache.updateCacheEntry(0, evtTable2);
+  REQUIRE(s.ok());
+  REQUIRE(cache.cacheMisses == 2);
+  REQUIRE(cache.cacheHits == 1);
+  lcache = cache.getCacheFor(bk);
+  std::tie(offset, count) = lcache.getSliceFor(2);
+  REQUIRE(offset == 4);
+  REQUIRE(count == 2);
+}
+
 TEST_CASE("TestSlicingException")
 {
   int offsets[] = {0, 5, 10, 15, 19, 20};
@@ -0,0 +1,57 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/StreamState.h"
+#include "Framework/ServiceRegistry.h"
+#include <catch_amalgamated.hpp>
+
+using namespace o2::framework;
+
+TEST_CASE("TestStreamStatePerStreamInstances")
+{
+  ServiceRegistry registry;
+  ServiceRegistryRef main{registry, ServiceRegistry::globalStreamSalt(0)};
+  ServiceRegistryRef stream1{registry, ServiceRegistry::globalStreamSalt(1)};
+  ServiceRegistryRef stream2{registry, ServiceRegistry::globalStreamSalt(2)};
+
+  StreamState<int> state;
+  auto& v1 = state.get(stream1);
+  auto& v2 = state.get(stream2);
+  REQUIRE(&v1 != &v2);
+  // Repeated access from the same stream returns the same instance
+  REQUIRE(&state.get(stream1) == &v1);
+  REQUIRE(&state.get(stream2) == &v2);
+
+  v1 = 10;
+  v2 = 32;
+  int total = 0;
+  size_t instances = 0;
+  state.forEach([&total, &instances](int& value) {
+    total += value;
+    instances++;
+  });
+  // The main thread instance was never created, only the two streams count
+  REQUIRE(instances == 2);
+  REQUIRE(total == 42);
+
+  REQUIRE(state.get(main) == 0);
+}
+
+TEST_CASE("TestStreamStateFactory")
+{
+  ServiceRegistry registry;
+  ServiceRegistryRef stream1{registry, ServiceRegistry::globalStreamSalt(1)};
+
+  StreamState<std::vector<int>> state{[]() { return std::make_unique<std::vector<int>>(3, 42); }};
+  auto& values = state.get(stream1);
+  REQUIRE(values.size() == 3);
+  REQUIRE(values[0] == 42);
+}
@@ -0,0 +1,57 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/TimesliceArena.h"
+#include <catch_amalgamated.hpp>
+#include <cstring>
+
+using namespace o2::framework;
+
+TEST_CASE("TestTimesliceArenaBasics")
+{
+  TimesliceArena arena{256};
+  REQUIRE(arena.used() == 0);
+
+  auto* p = arena.resource()->allocate(64, 8);
+  REQUIRE(p != nullptr);
+  REQUIRE(reinterpret_cast<uintptr_t>(p) % 8 == 0);
+  REQUIRE(arena.used() == 64);
+  std::memset(p, 0xab, 64);
+
+  // Allocations larger than the slab size get a dedicated slab.
+  auto* big = arena.resource()->allocate(1024, 16);
+  REQUIRE(big != nullptr);
+  REQUIRE(arena.used() == 64 + 1024);
+  size_t capacityBefore = arena.capacity();
+
+  // After a reset the slabs are retained and reused.
+  arena.reset();
+  REQUIRE(arena.used() == 0);
+  REQUIRE(arena.capacity() == capacityBefore);
+  auto* q = arena.resource()->allocate(64, 8);
+  REQUIRE(q == p);
+}
+
+TEST_CASE("TestTimesliceArenaVector")
+{
+  TimesliceArena arena{};
+  auto v = arena.makeVector<int>();
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(i);
+  }
+  REQUIRE(v.size() == 1000);
+  REQUIRE(v[999] == 999);
+  REQUIRE(arena.used() >= 1000 * sizeof(int));
+
+  auto w = arena.makeVector<double>(16);
+  REQUIRE(w.size() == 16);
+  REQUIRE(w[0] == 0.);
+}
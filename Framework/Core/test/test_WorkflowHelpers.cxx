@@ -648,3 +648,40 @@ TEST_CASE("TestOriginWildcard")
     }
   }
 }
+
+TEST_CASE("TestOptimizeTopology")
+{
+  // B is a forwarding-only device which replicates its input on its
+  // output: once dropped, C matches the output of A directly.
+  WorkflowSpec workflow{
+    {"A", {}, {OutputSpec{"TST", "A"}}},
+    {"B", {InputSpec{"x", "TST", "A"}}, {OutputSpec{"TST", "A"}}},
+    {"C", {InputSpec{"x", "TST", "A"}}, {}},
+  };
+  workflow[1].labels.push_back(DataProcessorLabel{"pass-through"});
+  WorkflowHelpers::optimizeTopology(workflow);
+  REQUIRE(workflow.size() == 2);
+  REQUIRE(workflow[0].name == "A");
+  REQUIRE(workflow[1].name == "C");
+
+  // A device labeled pass-through whose output does not replicate any of
+  // its inputs cannot be dropped and is kept.
+  WorkflowSpec mislabeled{
+    {"A", {}, {OutputSpec{"TST", "A"}}},
+    {"B", {InputSpec{"x", "TST", "A"}}, {OutputSpec{"TST", "B"}}},
+    {"C", {InputSpec{"x", "TST", "B"}}, {}},
+  };
+  mislabeled[1].labels.push_back(DataProcessorLabel{"pass-through"});
+  WorkflowHelpers::optimizeTopology(mislabeled);
+  REQUIRE(mislabeled.size() == 3);
+
+  // Devices without the label are never touched, even when their outputs
+  // replicate their inputs.
+  WorkflowSpec unlabeled{
+    {"A", {}, {OutputSpec{"TST", "A"}}},
+    {"B", {InputSpec{"x", "TST", "A"}}, {OutputSpec{"TST", "A"}}},
+    {"C", {InputSpec{"x", "TST", "A"}}, {}},
+  };
+  WorkflowHelpers::optimizeTopology(unlabeled);
+  REQUIRE(unlabeled.size() == 3);
+}
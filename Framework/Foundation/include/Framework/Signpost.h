@@ -177,6 +177,8 @@ struct _o2_log_t {
 #ifdef __APPLE__
   os_log_t os_log = nullptr;
 #endif
+  // The name the log was registered with, used by the binary tracing sink.
+  char const* name = nullptr;
   // A circular buffer of available slots. Each unique interval pulls an id from this buffer.
   _o2_lock_free_stack slots;
   // Up to 256 activities can be active at the same time.
@@ -193,12 +195,33 @@ struct _o2_log_t {
   // 0 means the log is disabled.
   // 1 means only the current signpost is printed.
   // >1 means the current signpost and n levels of the stacktrace are printed.
+  // <0 means the signposts are written as fixed-size binary events to a
+  //    per-thread shm ring buffer, to be harvested with o2-trace-extract,
+  //    and nothing is formatted or printed.
   int stacktrace = 0;
 
   // Default stacktrace level for the log, when enabled.
   int defaultStacktrace = 1;
 };
 
+// One fixed-size entry of the binary tracing sink. The layout is shared
+// with o2-trace-extract, bump the magic in the header below when changing it.
+struct _o2_trace_event_t {
+  uint64_t timestamp; // CLOCK_MONOTONIC, in ns
+  int64_t id;         // the signpost id, to correlate intervals
+  uint32_t tid;       // the thread which emitted the event
+  char kind;          // 'i' event, 'B' interval begin, 'E' interval end
+  char name[43];      // "<log>:<signpost>", truncated
+};
+
+// Header of one per-thread shm ring buffer, followed by nRecords events.
+struct _o2_trace_header_t {
+  char magic[8];       // "O2TRACE1"
+  uint32_t recordSize; // sizeof(_o2_trace_event_t)
+  uint32_t nRecords;   // ring capacity
+  std::atomic<uint64_t> head;
+};
+
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin = false);
 bool _o2_lock_free_stack_pop(_o2_lock_free_stack& stack, int& value, bool spin = false);
 void* _o2_log_create(char const* name, int stacktrace);
@@ -206,6 +229,7 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_signpost_interval_end(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace);
+void _o2_signpost_trace(_o2_log_t* log, _o2_signpost_id_t id, char kind, char const* name);
 
 // This generates a unique id for a signpost. Do not use this directly, use O2_SIGNPOST_ID_GENERATE instead.
 // Notice that this is only valid on a given computer.
@@ -234,11 +258,106 @@ inline _o2_signpost_id_t _o2_signpost_id_make_with_pointer(_o2_log_t* log, void
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <execinfo.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <pthread.h>
+#endif
 #include "Framework/RuntimeError.h"
 #include "Framework/BacktraceHelpers.h"
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
 
+static_assert(sizeof(_o2_trace_event_t) == 64, "trace events must stay fixed size");
+
+// The per-thread ring buffer of the binary tracing sink. Created lazily
+// as a shm segment named o2trace-<pid>-<tid>, so that o2-trace-extract
+// can harvest it from outside without stopping the process.
+struct _o2_trace_buffer_t {
+  _o2_trace_header_t* header = nullptr;
+  _o2_trace_event_t* records = nullptr;
+  uint32_t tid = 0;
+  bool failed = false;
+};
+
+static _o2_trace_buffer_t& _o2_trace_buffer()
+{
+  static thread_local _o2_trace_buffer_t buffer;
+  if (buffer.header || buffer.failed) {
+    return buffer;
+  }
+  // Until proven otherwise, so that a failure below does not retry on
+  // every single event.
+  buffer.failed = true;
+#ifdef __APPLE__
+  uint64_t tid64 = 0;
+  pthread_threadid_np(nullptr, &tid64);
+  buffer.tid = (uint32_t)tid64;
+#else
+  buffer.tid = (uint32_t)gettid();
+#endif
+  uint32_t nRecords = 65536;
+  if (auto* env = getenv("DPL_TRACE_RING_SIZE")) {
+    int requested = atoi(env);
+    if (requested > 0) {
+      nRecords = (uint32_t)requested;
+    }
+  }
+  char shmName[64];
+  snprintf(shmName, sizeof(shmName), "/o2trace-%d-%u", (int)getpid(), buffer.tid);
+  int fd = shm_open(shmName, O_CREAT | O_RDWR, 0600);
+  if (fd < 0) {
+    return buffer;
+  }
+  size_t size = sizeof(_o2_trace_header_t) + (size_t)nRecords * sizeof(_o2_trace_event_t);
+  if (ftruncate(fd, (off_t)size) != 0) {
+    close(fd);
+    return buffer;
+  }
+  void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    return buffer;
+  }
+  buffer.header = (_o2_trace_header_t*)mapped;
+  buffer.records = (_o2_trace_event_t*)((char*)mapped + sizeof(_o2_trace_header_t));
+  buffer.header->recordSize = sizeof(_o2_trace_event_t);
+  buffer.header->nRecords = nRecords;
+  buffer.header->head.store(0, std::memory_order_relaxed);
+  memcpy(buffer.header->magic, "O2TRACE1", 8);
+  buffer.failed = false;
+  return buffer;
+}
+
+// Append one fixed-size event to the ring of the calling thread. Only the
+// owning thread writes, so no synchronisation beyond the release on the
+// head counter is needed; the oldest events get overwritten when full.
+void _o2_signpost_trace(_o2_log_t* log, _o2_signpost_id_t id, char kind, char const* name)
+{
+  auto& buffer = _o2_trace_buffer();
+  if (buffer.header == nullptr) {
+    return;
+  }
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t head = buffer.header->head.load(std::memory_order_relaxed);
+  _o2_trace_event_t& event = buffer.records[head % buffer.header->nRecords];
+  event.timestamp = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+  event.id = id.value;
+  event.tid = buffer.tid;
+  event.kind = kind;
+  // Strip the common prefix so that more of the interesting part fits.
+  char const* logName = log->name ? log->name : "";
+  char const* prefix = "ch.cern.aliceo2.";
+  if (strncmp(logName, prefix, strlen(prefix)) == 0) {
+    logName += strlen(prefix);
+  }
+  snprintf(event.name, sizeof(event.name), "%s:%s", logName, name);
+  buffer.header->head.store(head + 1, std::memory_order_release);
+}
+
 // returns true if the push was successful, false if the stack was full
 // @param spin if true, will spin until the stack is not full
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin)
@@ -334,6 +453,7 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
   }
 #endif
   newHandle->name = strdup(name);
+  log->name = newHandle->name;
   newHandle->next = o2_get_logs_tail().load();
   // Until I manage to replace the log I have in next, keep trying.
   // Notice this does not protect against two threads trying to insert
@@ -351,6 +471,10 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
 // If the slot is empty, it will return the id and increment the indentation level.
 void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...)
 {
+  if (O2_BUILTIN_UNLIKELY(log->stacktrace < 0)) {
+    _o2_signpost_trace(log, id, 'i', name);
+    return;
+  }
   va_list args;
   va_start(args, format);
 
@@ -391,6 +515,10 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 // If the slot is empty, it will return the id and increment the indentation level.
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...)
 {
+  if (O2_BUILTIN_UNLIKELY(log->stacktrace < 0)) {
+    _o2_signpost_trace(log, id, 'B', name);
+    return;
+  }
   va_list args;
   va_start(args, format);
   // This is a unique slot for this interval.
@@ -411,6 +539,10 @@ void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char cons
 
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args)
 {
+  if (O2_BUILTIN_UNLIKELY(log->stacktrace < 0)) {
+    _o2_signpost_trace(log, id, 'E', name);
+    return;
+  }
   if (log->stacktrace == 0) {
     return;
   }
@@ -0,0 +1,177 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/Signpost.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Extracts the per-thread shm ring buffers written by the signposts binary
+// tracing sink (see Signpost.h, enabled with a negative stacktrace level,
+// e.g. DPL_SIGNPOSTS="device:-1" or o2-log -s -1) and converts them to the
+// Chrome trace event format, which Perfetto and chrome://tracing can load.
+// The buffers can be harvested while the traced process is still running.
+
+namespace
+{
+struct ExtractStats {
+  uint64_t events = 0;
+  uint64_t dropped = 0;
+};
+
+// Emit the events of a single ring buffer file as Chrome trace events.
+// Returns false if the file is not a valid trace segment.
+bool extractFile(char const* path, int pid, uint32_t tid, FILE* out, bool& first, ExtractStats& stats)
+{
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "o2-trace-extract: cannot open %s\n", path);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(_o2_trace_header_t)) {
+    fprintf(stderr, "o2-trace-extract: %s is too small to be a trace segment\n", path);
+    close(fd);
+    return false;
+  }
+  void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    fprintf(stderr, "o2-trace-extract: cannot map %s\n", path);
+    return false;
+  }
+  auto* header = (_o2_trace_header_t*)mapped;
+  if (memcmp(header->magic, "O2TRACE1", 8) != 0 || header->recordSize != sizeof(_o2_trace_event_t)) {
+    fprintf(stderr, "o2-trace-extract: %s is not an O2TRACE1 segment\n", path);
+    munmap(mapped, (size_t)st.st_size);
+    return false;
+  }
+  auto* records = (_o2_trace_event_t*)((char*)mapped + sizeof(_o2_trace_header_t));
+  uint64_t head = header->head.load(std::memory_order_acquire);
+  uint64_t count = head < header->nRecords ? head : header->nRecords;
+  uint64_t start = head < header->nRecords ? 0 : head;
+  stats.dropped += head - count;
+  for (uint64_t i = 0; i < count; ++i) {
+    _o2_trace_event_t const& event = records[(start + i) % header->nRecords];
+    // The name is truncated on write, make sure it is terminated here.
+    char name[sizeof(event.name) + 1];
+    memcpy(name, event.name, sizeof(event.name));
+    name[sizeof(event.name)] = 0;
+    char const* ph = event.kind == 'B' ? "B" : (event.kind == 'E' ? "E" : "i");
+    fprintf(out, "%s\n  {\"name\": \"%s\", \"ph\": \"%s\", \"ts\": %.3f, \"pid\": %d, \"tid\": %u%s, \"args\": {\"id\": %lld}}",
+            first ? "" : ",",
+            name, ph, event.timestamp / 1000.0, pid, event.tid != 0 ? event.tid : tid,
+            event.kind == 'i' ? ", \"s\": \"t\"" : "",
+            (long long)event.id);
+    first = false;
+    stats.events++;
+  }
+  munmap(mapped, (size_t)st.st_size);
+  return true;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  static struct option long_options[] = {
+    {"pid", required_argument, nullptr, 'p'},
+    {"output", required_argument, nullptr, 'o'},
+    {"delete", no_argument, nullptr, 'd'},
+    {nullptr, 0, nullptr, 0}};
+  int opt;
+  int pid = -1;
+  bool deleteSegments = false;
+  char const* outputName = nullptr;
+  while ((opt = getopt_long(argc, argv, "p:o:d", long_options, nullptr)) != -1) {
+    switch (opt) {
+      case 'p':
+        pid = atoi(optarg);
+        break;
+      case 'o':
+        outputName = optarg;
+        break;
+      case 'd':
+        deleteSegments = true;
+        break;
+      default:
+        fprintf(stderr, "Usage: %s [-p pid] [-o output.json] [-d] [segment...]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+  }
+
+  std::vector<std::string> segments;
+  for (int i = optind; i < argc; ++i) {
+    segments.emplace_back(argv[i]);
+  }
+  if (pid > 0) {
+    // shm_open backed segments show up under /dev/shm on Linux.
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "o2trace-%d-", pid);
+    DIR* dir = opendir("/dev/shm");
+    if (dir == nullptr) {
+      fprintf(stderr, "o2-trace-extract: cannot open /dev/shm, pass the segment files explicitly\n");
+      exit(EXIT_FAILURE);
+    }
+    while (auto* entry = readdir(dir)) {
+      if (strncmp(entry->d_name, prefix, strlen(prefix)) == 0) {
+        segments.emplace_back(std::string{"/dev/shm/"} + entry->d_name);
+      }
+    }
+    closedir(dir);
+  }
+  if (segments.empty()) {
+    fprintf(stderr, "Usage: %s [-p pid] [-o output.json] [-d] [segment...]\n", argv[0]);
+    exit(EXIT_FAILURE);
+  }
+
+  FILE* out = stdout;
+  if (outputName) {
+    out = fopen(outputName, "w");
+    if (out == nullptr) {
+      fprintf(stderr, "o2-trace-extract: cannot write %s\n", outputName);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  ExtractStats stats;
+  bool first = true;
+  fprintf(out, "{\"traceEvents\": [");
+  for (auto& segment : segments) {
+    // Recover pid / tid from the o2trace-<pid>-<tid> name for hand-picked files.
+    int segmentPid = pid > 0 ? pid : 0;
+    uint32_t segmentTid = 0;
+    if (auto* base = strstr(segment.c_str(), "o2trace-")) {
+      sscanf(base, "o2trace-%d-%u", &segmentPid, &segmentTid);
+    }
+    bool valid = extractFile(segment.c_str(), segmentPid, segmentTid, out, first, stats);
+    if (valid && deleteSegments) {
+      unlink(segment.c_str());
+    }
+  }
+  fprintf(out, "\n]}\n");
+  if (out != stdout) {
+    fclose(out);
+  }
+  fprintf(stderr, "o2-trace-extract: %llu events from %zu segment(s), %llu overwritten before extraction\n",
+          (unsigned long long)stats.events, segments.size(), (unsigned long long)stats.dropped);
+  return 0;
+}
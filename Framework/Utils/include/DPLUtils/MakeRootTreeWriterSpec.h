@@ -22,7 +22,10 @@
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/CallbackService.h"
 #include "Framework/ControlService.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/TimingInfo.h"
 #include <algorithm>
+#include <fstream>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -68,11 +71,23 @@ namespace framework
 ///     --nevents
 ///     --autosave
 ///     --terminate
+///     --tf-per-file
 ///
 /// \par
 /// In addition to that, a custom option can be added for every branch to configure the
 /// branch name, see below.
 ///
+/// \par TF-based output sharding:
+/// By default all time frames are serialized into one file. With option \c --tf-per-file
+/// the output is sharded into multiple files of n time frames each, keyed by the TF
+/// counter of the DPL TimingInfo (the same counter TFIDInfoHelper propagates to
+/// o2::dataformats::TFIDInfo). Shards are named <tt>basename_tf<first>.root</tt> and an
+/// accompanying manifest <tt>basename_manifest.txt</tt> lists for each closed shard the
+/// file name, the first and last TF counter written, and the number of time frames, for
+/// downstream discovery. When the process runs with multiple pipeline instances, the
+/// instance id is appended to the base name, so the instances can write in parallel
+/// without clashing.
+///
 /// \par Constructor arguments:
 /// Default file name can be configured alone, tree name can only be specified after
 /// file name. The default number of events can be specified at arbitrary place between
@@ -353,6 +368,21 @@ class MakeRootTreeWriterSpec
       Preprocessor preprocessor;
       // the total number of served branches on the n inputs
       size_t nofBranches;
+      // number of time frames per file shard, -1 (default) for a single file
+      int nTFPerFile = -1;
+      // base for shard file names, without the .root extension
+      std::string fileBase;
+      // tree name and title, needed to reinit the writer on shard rotation
+      std::string treeName;
+      std::string treeTitle;
+      // manifest file accompanying the shards
+      std::string manifestFileName;
+      // current shard file, range of TF counters and number of TFs written to it
+      std::string currentFileName;
+      int64_t currentShard = -1;
+      uint32_t firstTFInShard = 0;
+      uint32_t lastTFInShard = 0;
+      int nTFsInShard = 0;
     };
     auto processAttributes = std::make_shared<ProcessAttributes>();
     processAttributes->writer = mWriter;
@@ -403,15 +433,44 @@ class MakeRootTreeWriterSpec
         }
         filename = outdir + filename;
       }
-      processAttributes->writer->init(filename.c_str(), treename.c_str(), treetitle.c_str());
+      processAttributes->nTFPerFile = ic.options().get<int>("tf-per-file");
+      if (processAttributes->nTFPerFile > 0) {
+        // output is sharded into files of n time frames, the first shard is
+        // opened when the first time frame arrives
+        auto base = filename;
+        if (base.length() >= 5 && base.compare(base.length() - 5, 5, ".root") == 0) {
+          base.resize(base.length() - 5);
+        }
+        auto const& deviceSpec = ic.services().get<o2::framework::DeviceSpec const>();
+        if (deviceSpec.maxInputTimeslices > 1) {
+          // parallel pipeline instances write to separate shards and manifests
+          base += "_p" + std::to_string(deviceSpec.inputTimesliceId);
+        }
+        processAttributes->fileBase = base;
+        processAttributes->treeName = treename;
+        processAttributes->treeTitle = treetitle;
+        processAttributes->manifestFileName = base + "_manifest.txt";
+      } else {
+        processAttributes->writer->init(filename.c_str(), treename.c_str(), treetitle.c_str());
+      }
+      // close the writer and record the finished shard in the manifest
+      auto closeWriter = [](ProcessAttributes* attributes) {
+        attributes->writer->close();
+        if (!attributes->currentFileName.empty()) {
+          std::ofstream manifest(attributes->manifestFileName, std::ios_base::app);
+          manifest << attributes->currentFileName << " " << attributes->firstTFInShard << " "
+                   << attributes->lastTFInShard << " " << attributes->nTFsInShard << "\n";
+          attributes->currentFileName.clear();
+        }
+      };
       // the callback to be set as hook at stop of processing for the framework
-      auto finishWriting = [processAttributes]() {
-        processAttributes->writer->close();
+      auto finishWriting = [processAttributes, closeWriter]() {
+        closeWriter(processAttributes.get());
       };
 
       ic.services().get<CallbackService>().set<CallbackService::Id::Stop>(finishWriting);
 
-      auto processingFct = [processAttributes](ProcessingContext& pc) {
+      auto processingFct = [processAttributes, closeWriter](ProcessingContext& pc) {
         auto& writer = processAttributes->writer;
         auto& terminationPolicy = processAttributes->terminationPolicy;
         auto& terminationCondition = processAttributes->terminationCondition;
@@ -468,12 +527,27 @@ class MakeRootTreeWriterSpec
           preprocessor(pc);
         }
         if (checkProcessing(pc.inputs())) {
+          if (processAttributes->nTFPerFile > 0) {
+            // open or rotate the file shard covering the current time frame
+            auto tfCounter = pc.services().get<o2::framework::TimingInfo>().tfCounter;
+            auto shard = int64_t(tfCounter / processAttributes->nTFPerFile);
+            if (shard != processAttributes->currentShard) {
+              closeWriter(processAttributes.get());
+              processAttributes->currentFileName = processAttributes->fileBase + "_tf" + std::to_string(shard * processAttributes->nTFPerFile) + ".root";
+              writer->rotate(processAttributes->currentFileName.c_str(), processAttributes->treeName.c_str(), processAttributes->treeTitle.c_str());
+              processAttributes->currentShard = shard;
+              processAttributes->firstTFInShard = tfCounter;
+              processAttributes->nTFsInShard = 0;
+            }
+            processAttributes->lastTFInShard = tfCounter;
+            processAttributes->nTFsInShard++;
+          }
           (*writer)(pc.inputs());
           counter = counter + 1;
         }
 
         if ((nEvents >= 0 && counter == nEvents) || checkReady(pc.inputs())) {
-          writer->close();
+          closeWriter(processAttributes.get());
           pc.services().get<ControlService>().readyToQuit(terminationPolicy == TerminationPolicy::Workflow ? QuitRequest::All : QuitRequest::Me);
         } else if (nEventsAutoSave > 0 && counter && (counter % nEventsAutoSave) == 0) {
           writer->autoSave();
@@ -492,6 +566,7 @@ class MakeRootTreeWriterSpec
       {"nevents", VariantType::Int, mDefaultNofEvents, {"Number of events to execute"}},
       {"autosave", VariantType::Int, mDefaultAutoSave, {"Autosave after number of events"}},
       {"terminate", VariantType::String, mDefaultTerminationPolicy.c_str(), {"Terminate the 'process' or 'workflow'"}},
+      {"tf-per-file", VariantType::Int, -1, {"Number of time frames per file shard, -1 for a single file"}},
     };
     for (size_t branchIndex = 0; branchIndex < mBranchNameOptions.size(); branchIndex++) {
       // adding option definitions for those ones defined in the branch definition
@@ -315,6 +315,19 @@ class RootTreeWriter
     mTreeStructure->setup(mBranchSpecs, mTree.get());
   }
 
+  /// Close the current file (if any) and continue writing to a new one.
+  /// @param filename output file of the new shard
+  /// @param treename output tree
+  ///
+  /// The branches are recreated in the new tree according to the branch
+  /// definitions, which allows to shard the output over multiple files.
+  void rotate(const char* filename, const char* treename, const char* treetitle = nullptr)
+  {
+    close();
+    mIsClosed = false;
+    init(filename, treename, treetitle);
+  }
+
   /// Set the branch name for a branch definition from the constructor argument list
   /// @param index       position in the argument list
   /// @param branchName  (base)branch name
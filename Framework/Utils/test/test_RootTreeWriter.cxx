@@ -235,6 +235,11 @@ TEST_CASE("test_RootTreeWriter")
     registry};
 
   writer(inputs);
+
+  // rotate to a second file shard, the branches are recreated in the new tree
+  std::string filename2 = "test_RootTreeWriter_shard.root";
+  writer.rotate(filename2.c_str(), treename);
+  writer(inputs);
   writer.close();
 
   checkTree(filename.c_str(), treename,
@@ -245,6 +250,15 @@ TEST_CASE("test_RootTreeWriter")
             BranchContent<decltype(intvec)>{"intvecbranch", intvec},
             BranchContent<decltype(trivvec)>{"trivvecbranch", trivvec},
             BranchContent<decltype(trivvec)>{"srlzdvecbranch", trivvec});
+
+  checkTree(filename2.c_str(), treename,
+            BranchContent<decltype(a)>{"intbranch", a},
+            BranchContent<decltype(b)>{"containerbranch_0", b},
+            BranchContent<decltype(c)>{"containerbranch_1", c},
+            BranchContent<decltype(msgable)>{"msgablebranch", msgable},
+            BranchContent<decltype(intvec)>{"intvecbranch", intvec},
+            BranchContent<decltype(trivvec)>{"trivvecbranch", trivvec},
+            BranchContent<decltype(trivvec)>{"srlzdvecbranch", trivvec});
 }
 
 template <typename T>
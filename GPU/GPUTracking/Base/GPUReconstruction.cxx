@@ -364,6 +364,10 @@ int32_t GPUReconstruction::InitPhaseBeforeDevice()
     GPUError("Must use double pipeline mode only with exactly one chain that must support it");
     return 1;
   }
+  if (mProcessingSettings.pipelineContexts && !mProcessingSettings.doublePipeline) {
+    GPUError("pipelineContexts requires the double pipeline mode, ignoring");
+    mProcessingSettings.pipelineContexts = 0;
+  }
 
   if (mMaster == nullptr && mProcessingSettings.doublePipeline) {
     mPipelineContext.reset(new GPUReconstructionPipelineContext);
@@ -950,13 +954,26 @@ int32_t GPUReconstruction::registerMemoryForGPU(const void* ptr, size_t size)
   if (mProcessingSettings.noGPUMemoryRegistration) {
     return 0;
   }
+  if (isRegisteredMemory(ptr, size)) { // buffer lies inside an already registered range, e.g. a shm segment registered at init
+    return 0;
+  }
   int32_t retVal = registerMemoryForGPU_internal(ptr, size);
   if (retVal == 0) {
-    mRegisteredMemoryPtrs.emplace(ptr);
+    mRegisteredMemoryPtrs.emplace(ptr, size);
   }
   return retVal;
 }
 
+bool GPUReconstruction::isRegisteredMemory(const void* ptr, size_t size) const
+{
+  auto pos = mRegisteredMemoryPtrs.upper_bound(ptr);
+  if (pos == mRegisteredMemoryPtrs.begin()) {
+    return false;
+  }
+  pos--;
+  return (const char*)ptr + size <= (const char*)pos->first + pos->second;
+}
+
 int32_t GPUReconstruction::unregisterMemoryForGPU(const void* ptr)
 {
   if (mProcessingSettings.noGPUMemoryRegistration) {
@@ -967,6 +984,9 @@ int32_t GPUReconstruction::unregisterMemoryForGPU(const void* ptr)
     mRegisteredMemoryPtrs.erase(pos);
     return unregisterMemoryForGPU_internal(ptr);
   }
+  if (isRegisteredMemory(ptr, 1)) { // buffer inside a live registered range: registerMemoryForGPU reported success without registering it separately, so unregistering is a no-op success as well
+    return 0;
+  }
   return 1;
 }
 
@@ -22,6 +22,7 @@
 #include <memory>
 #include <iosfwd>
 #include <vector>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -142,10 +143,12 @@ class GPUReconstruction
 
   void PrepareEvent();
   virtual int32_t RunChains() = 0;
+  virtual int32_t WriteTimingResults(const char* fname) = 0;
   uint32_t getNEventsProcessed() { return mNEventsProcessed; }
   uint32_t getNEventsProcessedInStat() { return mStatNEvents; }
   int32_t registerMemoryForGPU(const void* ptr, size_t size);
   int32_t unregisterMemoryForGPU(const void* ptr);
+  bool isRegisteredMemory(const void* ptr, size_t size) const;
   virtual void* getGPUPointer(void* ptr) { return ptr; }
   virtual void startGPUProfiling() {}
   virtual void endGPUProfiling() {}
@@ -328,7 +331,7 @@ class GPUReconstruction
   void* mVolatileMemoryStart = nullptr;     // Ptr to beginning of temporary volatile memory allocation, nullptr if uninitialized
   size_t mDeviceMemoryUsedMax = 0;          //
 
-  std::unordered_set<const void*> mRegisteredMemoryPtrs; // List of pointers registered for GPU
+  std::map<const void*, size_t> mRegisteredMemoryPtrs; // Ranges of memory registered for GPU, keyed by start pointer
 
   GPUReconstruction* mMaster = nullptr;    // Ptr to a GPUReconstruction object serving as master, sharing GPU memory, events, etc.
   std::vector<GPUReconstruction*> mSlaves; // Ptr to slave GPUReconstructions
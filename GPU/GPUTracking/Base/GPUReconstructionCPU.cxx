@@ -316,6 +316,42 @@ int32_t GPUReconstructionCPU::RunChains()
   return 0;
 }
 
+int32_t GPUReconstructionCPU::WriteTimingResults(const char* fname)
+{
+  // machine-readable counterpart of the timing report printed at debugLevel >= 1,
+  // meant for trend tracking of per-kernel timings over standalone benchmark runs
+  FILE* fp = fopen(fname, "w");
+  if (fp == nullptr) {
+    GPUError("Error opening timing results file %s", fname);
+    return 1;
+  }
+  const uint32_t n = std::max(mStatNEvents, 1u);
+  double kernelTotal = 0;
+  fprintf(fp, "type,name,count,time_us\n");
+  for (uint32_t i = 0; i < mTimers.size(); i++) {
+    if (mTimers[i] == nullptr) {
+      continue;
+    }
+    double time = 0;
+    for (int32_t j = 0; j < mTimers[i]->num; j++) {
+      time += mTimers[i]->timer[j].GetElapsedTime();
+    }
+    if (mTimers[i]->type == 0) {
+      kernelTotal += time;
+    }
+    fprintf(fp, "%s,%s,%u,%.0f\n", mTimers[i]->type == 0 ? "kernel" : "cpu", mTimers[i]->name.c_str(), mTimers[i]->count, time * 1000000 / n);
+  }
+  for (int32_t i = 0; i < GPUDataTypes::N_RECO_STEPS; i++) {
+    if (mTimersRecoSteps[i].timerTotal.GetElapsedTime() != 0.) {
+      fprintf(fp, "step,%s,%u,%.0f\n", GPUDataTypes::RECO_STEP_NAMES[i], mStatNEvents, mTimersRecoSteps[i].timerTotal.GetElapsedTime() * 1000000 / n);
+    }
+  }
+  fprintf(fp, "total,Total Kernel,%u,%.0f\n", mStatNEvents, kernelTotal * 1000000 / n);
+  fprintf(fp, "total,Total Wall,%u,%.0f\n", mStatNEvents, timerTotal.GetElapsedTime() * 1000000 / n);
+  fclose(fp);
+  return 0;
+}
+
 void GPUReconstructionCPU::ResetDeviceProcessorTypes()
 {
   for (uint32_t i = 0; i < mProcessors.size(); i++) {
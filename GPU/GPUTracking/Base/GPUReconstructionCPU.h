@@ -77,6 +77,7 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
   void AddGPUEvents(T*& events);
 
   int32_t RunChains() override;
+  int32_t WriteTimingResults(const char* fname) override;
 
   HighResTimer& getRecoStepTimer(RecoStep step) { return mTimersRecoSteps[getRecoStepNum(step)].timerTotal; }
   HighResTimer& getGeneralStepTimer(GeneralStep step) { return mTimersGeneralSteps[getGeneralStepNum(step)]; }
@@ -117,6 +118,9 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
   virtual void RecordMarker(deviceEvent ev, int32_t stream) {}
   virtual void SynchronizeGPU() {}
   virtual void ReleaseEvent(deviceEvent ev) {}
+  virtual bool CanUseGraphCapture() { return false; }
+  virtual void StartGraphCapture(int32_t stream) {}
+  virtual void EndGraphCaptureAndLaunch(int32_t stream, uint32_t graphKey) {}
   virtual int32_t StartHelperThreads() { return 0; }
   virtual int32_t StopHelperThreads() { return 0; }
   virtual void RunHelperThreads(int32_t (GPUReconstructionHelpers::helperDelegateBase::*function)(int32_t, int32_t, GPUReconstructionHelpers::helperParam*), GPUReconstructionHelpers::helperDelegateBase* functionCls, int32_t count) {}
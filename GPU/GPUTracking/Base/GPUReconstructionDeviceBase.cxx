@@ -313,7 +313,7 @@ int32_t GPUReconstructionDeviceBase::unregisterMemoryForGPU_internal(const void*
 void GPUReconstructionDeviceBase::unregisterRemainingRegisteredMemory()
 {
   for (auto& ptr : mRegisteredMemoryPtrs) {
-    unregisterMemoryForGPU_internal(ptr);
+    unregisterMemoryForGPU_internal(ptr.first);
   }
   mRegisteredMemoryPtrs.clear();
 }
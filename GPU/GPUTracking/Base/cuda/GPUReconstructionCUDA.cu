@@ -468,6 +468,11 @@ int32_t GPUReconstructionCUDA::ExitDevice_Runtime()
   SynchronizeGPU();
   unregisterRemainingRegisteredMemory();
 
+  for (auto& exec : mInternals->graphExecs) {
+    GPUFailedMsgI(cudaGraphExecDestroy(exec.second));
+  }
+  mInternals->graphExecs.clear();
+
   for (uint32_t i = 0; i < mEvents.size(); i++) {
     cudaEvent_t* events = (cudaEvent_t*)mEvents[i].data();
     for (uint32_t j = 0; j < mEvents[i].size(); j++) {
@@ -559,6 +564,41 @@ std::unique_ptr<GPUReconstruction::GPUThreadContext> GPUReconstructionCUDA::GetT
 void GPUReconstructionCUDA::SynchronizeGPU() { GPUFailedMsg(cudaDeviceSynchronize()); }
 void GPUReconstructionCUDA::SynchronizeStream(int32_t stream) { GPUFailedMsg(cudaStreamSynchronize(mInternals->Streams[stream])); }
 
+void GPUReconstructionCUDA::StartGraphCapture(int32_t stream)
+{
+  GPUFailedMsg(cudaStreamBeginCapture(mInternals->Streams[stream], cudaStreamCaptureModeThreadLocal));
+}
+
+void GPUReconstructionCUDA::EndGraphCaptureAndLaunch(int32_t stream, uint32_t graphKey)
+{
+  cudaGraph_t graph;
+  GPUFailedMsg(cudaStreamEndCapture(mInternals->Streams[stream], &graph));
+  cudaGraphExec_t& exec = mInternals->graphExecs[graphKey];
+  if (exec) {
+#ifndef __HIPCC__ // CUDA
+    cudaGraphExecUpdateResultInfo updateResult;
+    if (cudaGraphExecUpdate(exec, graph, &updateResult) != cudaSuccess) {
+#else // HIP
+    cudaGraphNode_t errorNode;
+    cudaGraphExecUpdateResult updateResult;
+    if (cudaGraphExecUpdate(exec, graph, &errorNode, &updateResult) != cudaSuccess) {
+#endif
+      cudaGetLastError(); // Topology changed, clear the error and reinstantiate the executable graph
+      GPUFailedMsgI(cudaGraphExecDestroy(exec));
+      exec = nullptr;
+    }
+  }
+  if (exec == nullptr) {
+#ifndef __HIPCC__ // CUDA
+    GPUFailedMsg(cudaGraphInstantiate(&exec, graph, 0));
+#else // HIP
+    GPUFailedMsg(cudaGraphInstantiate(&exec, graph, nullptr, nullptr, 0));
+#endif
+  }
+  GPUFailedMsg(cudaGraphDestroy(graph));
+  GPUFailedMsg(cudaGraphLaunch(exec, mInternals->Streams[stream]));
+}
+
 void GPUReconstructionCUDA::SynchronizeEvents(deviceEvent* evList, int32_t nEvents)
 {
   for (int32_t i = 0; i < nEvents; i++) {
@@ -75,6 +75,9 @@ class GPUReconstructionCUDA : public GPUReconstructionKernels<GPUReconstructionC
   void SynchronizeGPU() override;
   int32_t GPUDebug(const char* state = "UNKNOWN", int32_t stream = -1, bool force = false) override;
   void SynchronizeStream(int32_t stream) override;
+  bool CanUseGraphCapture() override { return true; }
+  void StartGraphCapture(int32_t stream) override;
+  void EndGraphCaptureAndLaunch(int32_t stream, uint32_t graphKey) override;
   void SynchronizeEvents(deviceEvent* evList, int32_t nEvents = 1) override;
   void StreamWaitForEvents(int32_t stream, deviceEvent* evList, int32_t nEvents = 1) override;
   bool IsEventDone(deviceEvent* evList, int32_t nEvents = 1) override;
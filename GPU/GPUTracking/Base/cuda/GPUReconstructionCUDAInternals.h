@@ -22,6 +22,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace GPUCA_NAMESPACE
 {
@@ -35,6 +36,7 @@ struct GPUReconstructionCUDAInternals {
   std::vector<std::unique_ptr<CUfunction>> kernelFunctions; // vector of ptrs to RTC kernels
   std::vector<std::string> kernelNames;                     // names of kernels
   cudaStream_t Streams[GPUCA_MAX_STREAMS];                  // Pointer to array of CUDA Streams
+  std::unordered_map<uint32_t, cudaGraphExec_t> graphExecs; // Instantiated graphs for stream capture, keyed by capture site
 
   static void getArgPtrs(const void** pArgs) {}
   template <typename T, typename... Args>
@@ -444,6 +444,9 @@
   #ifndef GPUCA_LB_GPUTPCGMMergerMergeLoopers_step2
     #define GPUCA_LB_GPUTPCGMMergerMergeLoopers_step2 256
   #endif
+  #ifndef GPUCA_LB_GPUTPCGMMergerFilldEdxHist
+    #define GPUCA_LB_GPUTPCGMMergerFilldEdxHist 256
+  #endif
   #ifndef GPUCA_LB_GPUTPCGMO2Output_prepare
     #define GPUCA_LB_GPUTPCGMO2Output_prepare 256
   #endif
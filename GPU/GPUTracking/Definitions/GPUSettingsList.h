@@ -224,6 +224,7 @@ AddOption(globalInitMutex, bool, false, "", 0, "Use global mutex to synchronize
 AddOption(stuckProtection, int32_t, 0, "", 0, "Timeout in us, When AMD GPU is stuck, just continue processing and skip tracking, do not crash or stall the chain")
 AddOption(trdNCandidates, int32_t, 3, "", 0, "Number of branching track candidates for single input track during propagation")
 AddOption(trdTrackModelO2, bool, false, "", 0, "Use O2 track model instead of GPU track model for TRD tracking")
+AddOption(trdTrackingConcurrent, bool, false, "", 0, "Run the TRD tracking kernel on a separate stream and synchronize only after the TPC refit, overlapping both steps")
 AddOption(debugLevel, int32_t, -1, "debug", 'd', "Set debug level (-2 = silent, -1 = autoselect (-2 for O2, 0 for standalone))")
 AddOption(allocDebugLevel, int32_t, 0, "allocDebug", 0, "Some debug output for memory allocations (without messing with normal debug level)")
 AddOption(debugMask, int32_t, 262143, "", 0, "Mask for debug output dumps to file")
@@ -255,19 +256,25 @@ AddOption(trackletSelectorSlices, int8_t, -1, "", 0, "Number of slices to proces
 AddOption(trackletConstructorInPipeline, int8_t, -1, "", 0, "Run tracklet constructor in the pipeline")
 AddOption(trackletSelectorInPipeline, int8_t, -1, "", 0, "Run tracklet selector in the pipeline")
 AddOption(fullMergerOnGPU, bool, true, "", 0, "Perform full TPC track merging on GPU instead of only refit")
+AddOption(tpcMixedCpuGpuTracking, int32_t, 0, "", 0, "Process this many TPC sectors with the CPU tracking path while the GPU tracks the remaining sectors (-1 = balance automatically from measured per-sector times, 0 = disabled)")
 AddOption(delayedOutput, bool, true, "", 0, "Delay output to be parallel to track fit")
 AddOption(mergerSortTracks, int8_t, -1, "", 0, "Sort track indizes for GPU track fit")
+AddOption(refitSortTracks, bool, false, "", 0, "Sort track indizes by descending cluster count for the global refit, reducing warp divergence")
 AddOption(alternateBorderSort, int8_t, -1, "", 0, "Alternative implementation for sorting of border tracks")
 AddOption(tpcCompressionGatherMode, int8_t, -1, "", 0, "TPC Compressed Clusters Gather Mode (0: DMA transfer gather gpu to host, 1: serial DMA to host and gather by copy on CPU, 2. gather via GPU kernal DMA access, 3. gather on GPU via kernel, dma afterwards")
 AddOption(tpcCompressionGatherModeKernel, int8_t, -1, "", 0, "TPC Compressed Clusters Gather Mode Kernel (0: unbufferd, 1-3: buffered, 4: multi-block)")
 AddOption(tpccfGatherKernel, bool, true, "", 0, "Use a kernel instead of the DMA engine to gather the clusters")
+AddOption(tpccfOccupancyBatching, bool, true, "", 0, "Balance the sector batches of the TPC clusterizer lanes using the digit counts per fragment instead of using a fixed batch size")
+AddOption(tpccfGraphCapture, bool, false, "", 0, "Use CUDA/HIP graph capture to submit the kernel batches of the TPC clusterizer fragment loop with a single launch each")
 AddOption(doublePipeline, bool, false, "", 0, "Double pipeline mode")
 AddOption(doublePipelineClusterizer, bool, true, "", 0, "Include the input data of the clusterizer in the double-pipeline")
+AddOption(pipelineContexts, int8_t, 0, "", 0, "Number of overlapped processing contexts in pipeline mode (0 = 2, requires doublePipeline)")
 AddOption(prefetchTPCpageScan, int8_t, 0, "", 0, "Prefetch Data for TPC page scan in CPU cache")
 AddOption(runMC, bool, false, "", 0, "Process MC labels")
 AddOption(runQA, int32_t, 0, "qa", 'q', "Enable tracking QA (negative number to provide bitmask for QA tasks)", message("Running QA: %s"), def(1))
 AddOption(qcRunFraction, float, 100.f, "", 0, "Percentage of events to process with QC")
 AddOption(outputSharedClusterMap, bool, false, "", 0, "Ship optional shared cluster map as output for further use")
+AddOption(rundEdxCalibHist, bool, false, "", 0, "Accumulate a CalibdEdx-compatible dE/dx histogram on the GPU over multiple TFs, shipped on request instead of the per-track dEdx values")
 AddOption(disableTPCNoisyPadFilter, bool, false, "", 0, "Disables all TPC noisy pad filters (Not the normal noise filter!)")
 AddOption(createO2Output, int8_t, 2, "", 0, "Create Track output in O2 format (2 = skip non-O2 output in GPU track format (reverts to =1 if QA is requested))")
 AddOption(clearO2OutputFromGPU, bool, false, "", 0, "Free the GPU memory used for O2 output after copying to host, prevents further O2 processing on the GPU")
@@ -392,6 +399,7 @@ AddOption(smoothFont, int32_t, -1, "", 0, "Smoth font when rendering (-1 for aut
 AddOption(noFreetype, bool, false, "", 0, "Do not use Freetype for font rendering (can only draw text if supported by frontend)")
 AddOption(displayRenderer, std::string, "auto", "renderer", 0, "Renderer for event display: opengl | vulkan | auto")
 AddOption(displayFrontend, std::string, "auto", "displayFrontend", 0, "Frontend to use for event display: auto | win32 | x11 | glut | glfw | wayland")
+AddOption(remoteStreamPort, int32_t, 0, "", 0, "Stream quantized incremental event data to remote display clients via TCP on this port (0 = disabled)")
 AddOptionVec(filterMacros, std::string, "", 0, "ROOT macros used as track filter")
 AddSubConfig(GPUSettingsDisplayLight, light)
 AddSubConfig(GPUSettingsDisplayHeavy, heavy)
@@ -496,6 +504,7 @@ AddOption(memoryStat, bool, false, "", 0, "Print memory statistics")
 AddOption(testSyncAsync, bool, false, "syncAsync", 0, "Test first synchronous and then asynchronous processing")
 AddOption(testSync, bool, false, "sync", 0, "Test settings for synchronous phase")
 AddOption(timeFrameTime, bool, false, "tfTime", 0, "Print some debug information about time frame processing time")
+AddOption(timingResultsFile, std::string, "", "timingFile", 0, "Write per-kernel and per-step timing results in CSV form to this file, for regression tracking")
 AddOption(controlProfiler, bool, false, "", 0, "Issues GPU profiler stop and start commands to profile only the relevant processing part")
 AddOption(preloadEvents, bool, false, "", 0, "Preload events into host memory before start processing")
 AddOption(recoSteps, int32_t, -1, "", 0, "Bitmask for RecoSteps")
@@ -112,6 +112,9 @@ class GPUChain
     }
   }
   inline void StreamWaitForEvents(int32_t stream, deviceEvent* evList, int32_t nEvents = 1) { mRec->StreamWaitForEvents(stream, evList, nEvents); }
+  inline bool CanUseGraphCapture() { return mRec->CanUseGraphCapture(); }
+  inline void StartGraphCapture(int32_t stream) { mRec->StartGraphCapture(stream); }
+  inline void EndGraphCaptureAndLaunch(int32_t stream, uint32_t graphKey) { mRec->EndGraphCaptureAndLaunch(stream, graphKey); }
   template <class T>
   void RunHelperThreads(T function, GPUReconstructionHelpers::helperDelegateBase* functionCls, int32_t count);
   inline void WaitForHelperThreads() { mRec->WaitForHelperThreads(); }
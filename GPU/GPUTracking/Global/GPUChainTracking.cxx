@@ -796,6 +796,12 @@ int32_t GPUChainTracking::RunChain()
     return 1;
   }
 
+#ifdef GPUCA_HAVE_O2HEADERS
+  if (GetProcessingSettings().trdTrackModelO2 ? FinishTRDTracking<GPUTRDTrackerKernels::o2Version>() : FinishTRDTracking<GPUTRDTrackerKernels::gpuVersion>()) { // No-op unless TRD tracking was launched asynchronously above
+    return 1;
+  }
+#endif
+
   if (!GetProcessingSettings().doublePipeline) { // Synchronize with output copies running asynchronously
     SynchronizeStream(OutputStream());
   }
@@ -67,6 +67,7 @@ struct GPUChainTrackingFinalContext;
 struct GPUTPCCFChainContext;
 struct GPUNewCalibValues;
 struct GPUTriggerOutputs;
+struct GPUdEdxCalibHist;
 
 class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelegateBase
 {
@@ -169,11 +170,14 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   int32_t RunTPCTrackingMerger(bool synchronizeOutput = true);
   template <int32_t I>
   int32_t RunTRDTracking();
+  template <int32_t I>
+  int32_t FinishTRDTracking();
   template <int32_t I, class T = GPUTRDTracker>
-  int32_t DoTRDGPUTracking(T* externalInstance = nullptr);
+  int32_t DoTRDGPUTracking(T* externalInstance = nullptr, bool synchronize = true);
   int32_t RunTPCCompression();
   int32_t RunTPCDecompression();
   int32_t RunRefit();
+  int32_t RetrievedEdxCalibHist(GPUdEdxCalibHist* dst, bool reset = true); // Ship the accumulated dEdx calibration histogram to the host
 
   // Getters / setters for parameters
   const CorrectionMapsHelper* GetTPCTransformHelper() const { return processors()->calibObjects.fastTransformHelper; }
@@ -280,6 +284,9 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   // (Ptrs to) configuration objects
   std::unique_ptr<GPUTPCCFChainContext> mCFContext;
   bool mTPCSliceScratchOnStack = false;
+  bool mTRDTrackingPending = false; // TRD tracking launched asynchronously, results not collected yet
+  bool mdEdxCalibHistInitialized = false; // dEdx calibration histogram on the GPU was cleared and is accumulating
+  uint32_t mMixedTrackingCPUSectors = 1; // Current CPU sector share when mixed CPU-GPU sector tracking balances automatically
   std::unique_ptr<GPUCalibObjectsConst> mNewCalibObjects;
   bool mUpdateNewCalibObjects = false;
   std::unique_ptr<GPUNewCalibValues> mNewCalibValues;
@@ -305,6 +312,7 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   int32_t RunTPCClusterizer_prepare(bool restorePointers);
 #ifdef GPUCA_TPC_GEOMETRY_O2
   std::pair<uint32_t, uint32_t> RunTPCClusterizer_transferZS(int32_t iSlice, const CfFragment& fragment, int32_t lane);
+  void RunTPCClusterizer_computeBatches();
   void RunTPCClusterizer_compactPeaks(GPUTPCClusterFinder& clusterer, GPUTPCClusterFinder& clustererShadow, int32_t stage, bool doGPU, int32_t lane);
   std::pair<uint32_t, uint32_t> TPCClusterizerDecodeZSCount(uint32_t iSlice, const CfFragment& fragment);
   std::pair<uint32_t, uint32_t> TPCClusterizerDecodeZSCountUpdate(uint32_t iSlice, const CfFragment& fragment);
@@ -451,10 +451,76 @@ std::pair<uint32_t, uint32_t> GPUChainTracking::RunTPCClusterizer_transferZS(int
       nPagesSector += nPages;
     }
     GPUMemCpy(RecoStep::TPCClusterFinding, clustererShadow.mPzsOffsets, clusterer.mPzsOffsets, clusterer.mNMaxPages * sizeof(*clusterer.mPzsOffsets), lane, true);
+    RecordMarker(mEvents->slice[iSlice], lane); // ZS copy complete marker, the decode stream waits for it on the device
   }
   return retVal;
 }
 
+void GPUChainTracking::RunTPCClusterizer_computeBatches()
+{
+  const uint32_t nLanes = GetProcessingSettings().nTPCClustererLanes;
+  mCFContext->sliceBatches.clear();
+  if (!GetProcessingSettings().tpccfOccupancyBatching || nLanes <= 1 || mCFContext->abandonTimeframe) {
+    for (uint32_t iSlice = 0; iSlice < NSLICES; iSlice += nLanes) {
+      mCFContext->sliceBatches.emplace_back(iSlice, std::min<uint32_t>(nLanes, NSLICES - iSlice));
+    }
+    return;
+  }
+
+  // The lanes of one batch process the same time fragment concurrently, so the time of a batch is the
+  // sum over the fragments of the largest digit count any of its sectors has in that fragment. The
+  // occupancy is far from uniform (peripheral sectors at low interaction rate vs. time bins around the
+  // central membrane), thus batching a fixed number of sectors leaves lanes idle. Instead, pick the
+  // batch boundaries that minimize the summed per-fragment maxima, using the digit counts obtained
+  // during the ZS page scan. The batches stay contiguous in sector number, which keeps the cluster
+  // output ordering and the stream / event usage identical to the fixed batching.
+  const bool perFragment = mIOPtrs.tpcZS && mCFContext->zsVersion != -1;
+  const uint32_t nFragments = perFragment ? mCFContext->nFragments : 1;
+  std::vector<uint64_t> counts(nFragments * NSLICES, 0);
+  for (uint32_t iSlice = 0; iSlice < NSLICES; iSlice++) {
+    if (perFragment) {
+      for (uint32_t f = 0; f < nFragments; f++) {
+        for (uint32_t j = 0; j < GPUTrackingInOutZS::NENDPOINTS; j++) {
+          counts[f * NSLICES + iSlice] += mCFContext->fragmentData[f].nDigits[iSlice][j];
+        }
+      }
+    } else if (mIOPtrs.tpcPackedDigits) {
+      counts[iSlice] = mIOPtrs.tpcPackedDigits->nTPCDigits[iSlice]; // No digit counts per fragment available for digit input
+    }
+  }
+
+  auto batchCost = [&](uint32_t first, uint32_t n) {
+    uint64_t cost = 0;
+    for (uint32_t f = 0; f < nFragments; f++) {
+      uint64_t max = 0;
+      for (uint32_t iSlice = first; iSlice < first + n; iSlice++) {
+        max = std::max(max, counts[f * NSLICES + iSlice]);
+      }
+      cost += max;
+    }
+    return cost;
+  };
+
+  uint64_t cost[NSLICES + 1];     // Minimal cost of processing the sectors from iSlice on
+  uint32_t nInBatch[NSLICES + 1]; // Size of the first batch realizing it
+  cost[NSLICES] = 0;
+  for (int32_t iSlice = NSLICES - 1; iSlice >= 0; iSlice--) {
+    for (uint32_t n = 1; n <= nLanes && iSlice + n <= NSLICES; n++) {
+      const uint64_t c = batchCost(iSlice, n) + cost[iSlice + n];
+      if (n == 1 || c <= cost[iSlice]) { // Prefer larger batches on equal cost
+        cost[iSlice] = c;
+        nInBatch[iSlice] = n;
+      }
+    }
+  }
+  for (uint32_t iSlice = 0; iSlice < NSLICES; iSlice += nInBatch[iSlice]) {
+    mCFContext->sliceBatches.emplace_back(iSlice, nInBatch[iSlice]);
+  }
+  if (GetProcessingSettings().debugLevel >= 3) {
+    GPUInfo("TPC clusterizer occupancy batching: %d batches for %d lanes", (int32_t)mCFContext->sliceBatches.size(), (int32_t)nLanes);
+  }
+}
+
 int32_t GPUChainTracking::RunTPCClusterizer_prepare(bool restorePointers)
 {
   if (restorePointers) {
@@ -548,9 +614,11 @@ int32_t GPUChainTracking::RunTPCClusterizer_prepare(bool restorePointers)
   }
 
   mCFContext->fragmentFirst = CfFragment{std::max<int32_t>(mCFContext->tpcMaxTimeBin + 1, maxFragmentLen), maxFragmentLen};
-  for (int32_t iSlice = 0; iSlice < GetProcessingSettings().nTPCClustererLanes && iSlice < NSLICES; iSlice++) {
+  RunTPCClusterizer_computeBatches();
+  for (uint32_t lane = 0; lane < mCFContext->sliceBatches.front().second; lane++) {
+    const uint32_t iSlice = mCFContext->sliceBatches.front().first + lane;
     if (mIOPtrs.tpcZS && mCFContext->nPagesSector[iSlice] && mCFContext->zsVersion != -1) {
-      mCFContext->nextPos[iSlice] = RunTPCClusterizer_transferZS(iSlice, mCFContext->fragmentFirst, GetProcessingSettings().nTPCClustererLanes + iSlice);
+      mCFContext->nextPos[iSlice] = RunTPCClusterizer_transferZS(iSlice, mCFContext->fragmentFirst, GetProcessingSettings().nTPCClustererLanes + lane);
     }
   }
 
@@ -645,6 +713,9 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
     mcLinearLabels.data.reserve(mRec->MemoryScalers()->nTPCHits);
   }
 
+  // Graph capture batches the kernel launches of one lane phase into a single submission. Requires that nothing in the captured region synchronizes the stream or records / waits for events, so it is incompatible with the debugging / serialization modes and with the host-side parts of the MC label propagation.
+  const bool useGraphCapture = doGPU && GetProcessingSettings().tpccfGraphCapture && CanUseGraphCapture() && !propagateMCLabels && GetProcessingSettings().debugLevel == 0 && !GetProcessingSettings().serializeGPU && !GetProcessingSettings().deterministicGPUReconstruction;
+
   int8_t transferRunning[NSLICES] = {0};
   uint32_t outputQueueStart = mOutputQueue.size();
 
@@ -660,13 +731,14 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
   };
   bool synchronizeCalibUpdate = false;
 
-  for (uint32_t iSliceBase = 0; iSliceBase < NSLICES; iSliceBase += GetProcessingSettings().nTPCClustererLanes) {
-    std::vector<bool> laneHasData(GetProcessingSettings().nTPCClustererLanes, false);
+  for (uint32_t iBatch = 0; iBatch < mCFContext->sliceBatches.size(); iBatch++) {
+    const uint32_t iSliceBase = mCFContext->sliceBatches[iBatch].first;
+    const int32_t maxLane = mCFContext->sliceBatches[iBatch].second;
+    std::vector<bool> laneHasData(maxLane, false);
     static_assert(NSLICES <= GPUCA_MAX_STREAMS, "Stream events must be able to hold all slices");
-    const int32_t maxLane = std::min<int32_t>(GetProcessingSettings().nTPCClustererLanes, NSLICES - iSliceBase);
     for (CfFragment fragment = mCFContext->fragmentFirst; !fragment.isEnd(); fragment = fragment.next()) {
       if (GetProcessingSettings().debugLevel >= 3) {
-        GPUInfo("Processing time bins [%d, %d) for sectors %d to %d", fragment.start, fragment.last(), iSliceBase, iSliceBase + GetProcessingSettings().nTPCClustererLanes - 1);
+        GPUInfo("Processing time bins [%d, %d) for sectors %d to %d", fragment.start, fragment.last(), iSliceBase, iSliceBase + maxLane - 1);
       }
       GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, GetProcessingSettings().nTPCClustererLanes)))
       for (int32_t lane = 0; lane < maxLane; lane++) {
@@ -714,9 +786,10 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
         DoDebugAndDump(RecoStep::TPCClusterFinding, 262144, clusterer, &GPUTPCClusterFinder::DumpChargeMap, *mDebugFile, "Zeroed Charges");
 
         if (doGPU) {
-          if (mIOPtrs.tpcZS && mCFContext->nPagesSector[iSlice] && mCFContext->zsVersion != -1) {
+          if (mIOPtrs.tpcZS && mCFContext->nPagesSector[iSlice] && mCFContext->zsVersion != -1 && !mCFContext->abandonTimeframe) {
             TransferMemoryResourceLinkToGPU(RecoStep::TPCClusterFinding, mInputsHost->mResourceZS, lane);
-            SynchronizeStream(GetProcessingSettings().nTPCClustererLanes + lane);
+            StreamWaitForEvents(lane, &mEvents->slice[iSlice]); // wait for the ZS copy on the device instead of blocking the host, so copies of other sectors overlap with the decoding
+            ReleaseEvent(mEvents->slice[iSlice], doGPU);
           }
           SynchronizeStream(mRec->NStreams() - 1); // Wait for copying to constant memory
         }
@@ -782,13 +855,18 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
         }
         if (mIOPtrs.tpcZS) {
           CfFragment f = fragment.next();
-          int32_t nextSlice = iSlice;
           if (f.isEnd()) {
-            nextSlice += GetProcessingSettings().nTPCClustererLanes;
-            f = mCFContext->fragmentFirst;
-          }
-          if (nextSlice < NSLICES && mIOPtrs.tpcZS && mCFContext->nPagesSector[nextSlice] && mCFContext->zsVersion != -1 && !mCFContext->abandonTimeframe) {
-            mCFContext->nextPos[nextSlice] = RunTPCClusterizer_transferZS(nextSlice, f, GetProcessingSettings().nTPCClustererLanes + lane);
+            if (iBatch + 1 < mCFContext->sliceBatches.size()) {
+              // Prefetch the first fragment of the next batch, which may hold more sectors than this one, so each lane takes a strided share
+              for (uint32_t next = lane; next < mCFContext->sliceBatches[iBatch + 1].second; next += maxLane) {
+                const uint32_t nextSlice = mCFContext->sliceBatches[iBatch + 1].first + next;
+                if (mCFContext->nPagesSector[nextSlice] && mCFContext->zsVersion != -1 && !mCFContext->abandonTimeframe) {
+                  mCFContext->nextPos[nextSlice] = RunTPCClusterizer_transferZS(nextSlice, mCFContext->fragmentFirst, GetProcessingSettings().nTPCClustererLanes + lane);
+                }
+              }
+            }
+          } else if (mCFContext->nPagesSector[iSlice] && mCFContext->zsVersion != -1 && !mCFContext->abandonTimeframe) {
+            mCFContext->nextPos[iSlice] = RunTPCClusterizer_transferZS(iSlice, f, GetProcessingSettings().nTPCClustererLanes + lane);
           }
         }
         GPUTPCClusterFinder& clusterer = processors()->tpcClusterer[iSlice];
@@ -796,6 +874,9 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
         if (clusterer.mPmemory->counters.nPositions == 0) {
           continue;
         }
+        if (useGraphCapture) {
+          StartGraphCapture(lane);
+        }
         if (!mIOPtrs.tpcZS) {
           runKernel<GPUTPCCFChargeMapFiller, GPUTPCCFChargeMapFiller::fillFromDigits>({GetGrid(clusterer.mPmemory->counters.nPositions, lane), {iSlice}});
         }
@@ -824,6 +905,9 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
 
         RunTPCClusterizer_compactPeaks(clusterer, clustererShadow, 0, doGPU, lane);
         TransferMemoryResourceLinkToHost(RecoStep::TPCClusterFinding, clusterer.mMemoryId, lane);
+        if (useGraphCapture) {
+          EndGraphCaptureAndLaunch(lane, 0 * NSLICES + iSlice);
+        }
         DoDebugAndDump(RecoStep::TPCClusterFinding, 262144 << 2, clusterer, &GPUTPCClusterFinder::DumpPeaksCompacted, *mDebugFile);
       }
       GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, GetProcessingSettings().nTPCClustererLanes)))
@@ -837,6 +921,9 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
         if (clusterer.mPmemory->counters.nPeaks == 0) {
           continue;
         }
+        if (useGraphCapture) {
+          StartGraphCapture(lane);
+        }
         runKernel<GPUTPCCFNoiseSuppression, GPUTPCCFNoiseSuppression::noiseSuppression>({GetGrid(clusterer.mPmemory->counters.nPeaks, lane), {iSlice}});
         runKernel<GPUTPCCFNoiseSuppression, GPUTPCCFNoiseSuppression::updatePeaks>({GetGrid(clusterer.mPmemory->counters.nPeaks, lane), {iSlice}});
         if (DoDebugAndDump(RecoStep::TPCClusterFinding, 262144 << 3, clusterer, &GPUTPCClusterFinder::DumpSuppressedPeaks, *mDebugFile)) {
@@ -845,6 +932,9 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
 
         RunTPCClusterizer_compactPeaks(clusterer, clustererShadow, 1, doGPU, lane);
         TransferMemoryResourceLinkToHost(RecoStep::TPCClusterFinding, clusterer.mMemoryId, lane);
+        if (useGraphCapture) {
+          EndGraphCaptureAndLaunch(lane, 1 * NSLICES + iSlice);
+        }
         DoDebugAndDump(RecoStep::TPCClusterFinding, 262144 << 3, clusterer, &GPUTPCClusterFinder::DumpSuppressedPeaksCompacted, *mDebugFile);
       }
       GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, GetProcessingSettings().nTPCClustererLanes)))
@@ -865,6 +955,9 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
           continue;
         }
 
+        if (useGraphCapture) {
+          StartGraphCapture(lane);
+        }
         runKernel<GPUTPCCFDeconvolution>({GetGrid(clusterer.mPmemory->counters.nPositions, lane), {iSlice}});
         DoDebugAndDump(RecoStep::TPCClusterFinding, 262144 << 4, clusterer, &GPUTPCClusterFinder::DumpChargeMap, *mDebugFile, "Split Charges");
 
@@ -881,6 +974,9 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
         }
 
         TransferMemoryResourcesToHost(RecoStep::TPCClusterFinding, &clusterer, lane);
+        if (useGraphCapture) {
+          EndGraphCaptureAndLaunch(lane, 2 * NSLICES + iSlice);
+        }
         laneHasData[lane] = true;
         // Include clusters in default debug mask, exclude other debug output by default
         DoDebugAndDump(RecoStep::TPCClusterFinding, 131072, clusterer, &GPUTPCClusterFinder::DumpClusters, *mDebugFile);
@@ -950,10 +1046,10 @@ int32_t GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
       }
     }
 
-    if (mWaitForFinalInputs && iSliceBase >= 21 && (int32_t)iSliceBase < 21 + GetProcessingSettings().nTPCClustererLanes) {
+    if (mWaitForFinalInputs && iSliceBase >= 21 && (iBatch == 0 || mCFContext->sliceBatches[iBatch - 1].first < 21)) {
       notifyForeignChainFinished();
     }
-    if (mWaitForFinalInputs && iSliceBase >= 30 && (int32_t)iSliceBase < 30 + GetProcessingSettings().nTPCClustererLanes) {
+    if (mWaitForFinalInputs && iSliceBase >= 30 && (iBatch == 0 || mCFContext->sliceBatches[iBatch - 1].first < 30)) {
       mWaitForFinalInputs();
       synchronizeCalibUpdate = DoQueuedUpdates(0, false);
     }
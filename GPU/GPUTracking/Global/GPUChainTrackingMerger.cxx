@@ -16,6 +16,7 @@
 #include "GPULogging.h"
 #include "GPUO2DataTypes.h"
 #include "GPUQA.h"
+#include "GPUdEdxCalibHist.h"
 #include "utils/strtag.h"
 #include <fstream>
 
@@ -228,6 +229,13 @@ int32_t GPUChainTracking::RunTPCTrackingMerger(bool synchronizeOutput)
   if (param().rec.tpc.looperInterpolationInExtraPass) {
     runKernel<GPUTPCGMMergerFollowLoopers>(GetGridAuto(0));
   }
+  if (GetProcessingSettings().rundEdxCalibHist && param().par.dodEdx && param().dodEdxDownscaled) {
+    if (!mdEdxCalibHistInitialized) {
+      runKernel<GPUMemClean16>({{numBlocks, -ThreadCount(), 0, deviceType, RecoStep::TPCMerging}}, MergerShadowAll.dEdxCalibHist(), sizeof(*MergerShadowAll.dEdxCalibHist()));
+      mdEdxCalibHistInitialized = true;
+    }
+    runKernel<GPUTPCGMMergerFilldEdxHist>(GetGridAuto(0, deviceType));
+  }
   if (doGPU && !doGPUall) {
     TransferMemoryResourcesToHost(RecoStep::TPCMerging, &Merger, 0);
     SynchronizeStream(0);
@@ -365,3 +373,22 @@ int32_t GPUChainTracking::RunTPCTrackingMerger(bool synchronizeOutput)
   }
   return 0;
 }
+
+int32_t GPUChainTracking::RetrievedEdxCalibHist(GPUdEdxCalibHist* dst, bool reset)
+{
+  if (!GetProcessingSettings().rundEdxCalibHist || processors()->tpcMerger.dEdxCalibHist() == nullptr) {
+    return 1;
+  }
+  if (!mdEdxCalibHistInitialized) {
+    memset((void*)dst, 0, sizeof(*dst)); // nothing accumulated yet
+    return 0;
+  }
+  const auto& threadContext = GetThreadContext();
+  TransferMemoryResourceLinkToHost(RecoStep::TPCMerging, processors()->tpcMerger.MemoryResdEdxCalibHist(), 0);
+  SynchronizeStream(0);
+  memcpy((void*)dst, (const void*)processors()->tpcMerger.dEdxCalibHist(), sizeof(*dst));
+  if (reset) {
+    mdEdxCalibHistInitialized = false; // the device histogram is cleared again before the next fill
+  }
+  return 0;
+}
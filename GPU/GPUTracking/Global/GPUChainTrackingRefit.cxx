@@ -15,6 +15,7 @@
 #include "GPUChainTracking.h"
 #include "GPULogging.h"
 #include "GPUO2DataTypes.h"
+#include "utils/strtag.h"
 
 using namespace GPUCA_NAMESPACE::gpu;
 
@@ -28,11 +29,24 @@ int32_t GPUChainTracking::RunRefit()
   const auto& threadContext = GetThreadContext();
   (void)threadContext;
   SetupGPUProcessor(&Refit, false);
+  const bool sortTracks = doGPU && GetProcessingSettings().refitSortTracks && mIOPtrs.nMergedTracks;
+  if (sortTracks) {
+    mRec->PushNonPersistentMemory(qStr2Tag("REFTSORT"));
+    Refit.mMaxTracks = mIOPtrs.nMergedTracks;
+    AllocateRegisteredMemory(Refit.mMemoryResSort);
+  }
   RefitShadow.SetPtrsFromGPUConstantMem(processorsShadow(), doGPU ? &processorsDevice()->param : nullptr);
   RefitShadow.SetPropagator(doGPU ? processorsShadow()->calibObjects.o2Propagator : GetO2Propagator());
   RefitShadow.mPTracks = (doGPU ? processorsShadow() : processors())->tpcMerger.OutputTracks();
+  if (!sortTracks) {
+    RefitShadow.mPTrackOrder = nullptr;
+  }
   WriteToConstantMemory(RecoStep::Refit, (char*)&processors()->trackingRefit - (char*)processors(), &RefitShadow, sizeof(RefitShadow), 0);
   //TransferMemoryResourcesToGPU(RecoStep::Refit, &Refit, 0);
+  if (sortTracks) {
+    runKernel<GPUitoa>({GetGridAutoStep(0, RecoStep::Refit)}, RefitShadow.mPTrackOrder, mIOPtrs.nMergedTracks);
+    runKernel<GPUTrackingRefitKernel, GPUTrackingRefitKernel::sortTracks>(GetGridAuto(0));
+  }
   if (param().rec.trackingRefitGPUModel) {
     runKernel<GPUTrackingRefitKernel, GPUTrackingRefitKernel::mode0asGPU>(GetGrid(mIOPtrs.nMergedTracks, 0));
   } else {
@@ -40,6 +54,9 @@ int32_t GPUChainTracking::RunRefit()
   }
   //TransferMemoryResourcesToHost(RecoStep::Refit, &Refit, 0);
   SynchronizeStream(0);
+  if (sortTracks) {
+    mRec->PopNonPersistentMemory(RecoStep::Refit, qStr2Tag("REFTSORT"));
+  }
 #endif
   return 0;
 }
@@ -71,6 +71,13 @@ int32_t GPUChainTracking::RunTPCTrackingSlices_internal()
   }
   bool doGPU = GetRecoStepsGPU() & RecoStep::TPCSliceTracking;
   bool doSliceDataOnGPU = processors()->tpcTrackers[0].SliceDataOnGPU();
+  // Mixed CPU-GPU tracking assigns the last sectors to the CPU tracking path, processed on the host while the GPU works on the rest. Requires the host slice data path and the pipelined constructor / selector, and is disabled for the debugging modes that compare or dump per-sector results.
+  uint32_t nCpuSectors = 0;
+  if (doGPU && GetProcessingSettings().tpcMixedCpuGpuTracking && !doSliceDataOnGPU && GetProcessingSettings().trackletConstructorInPipeline > 0 && GetProcessingSettings().trackletSelectorInPipeline > 0 && !GetProcessingSettings().deterministicGPUReconstruction && !GetProcessingSettings().keepAllMemory && !GetProcessingSettings().keepDisplayMemory) {
+    nCpuSectors = GetProcessingSettings().tpcMixedCpuGpuTracking > 0 ? (uint32_t)GetProcessingSettings().tpcMixedCpuGpuTracking : mMixedTrackingCPUSectors;
+    nCpuSectors = CAMath::Min<uint32_t>(nCpuSectors, NSLICES / 2);
+  }
+  const uint32_t nGpuSectors = NSLICES - nCpuSectors;
   if (!param().par.earlyTpcTransform) {
     for (uint32_t i = 0; i < NSLICES; i++) {
       processors()->tpcTrackers[i].Data().SetClusterData(nullptr, mIOPtrs.clustersNative->nClustersSector[i], mIOPtrs.clustersNative->clusterOffset[i][0]);
@@ -177,6 +184,10 @@ int32_t GPUChainTracking::RunTPCTrackingSlices_internal()
     GPUTPCTracker& trkShadow = doGPU ? processorsShadow()->tpcTrackers[iSlice] : trk;
     int32_t useStream = (iSlice % mRec->NStreams());
 
+    if (iSlice >= nGpuSectors) {
+      continue; // Processed on the host below, overlapping with the GPU sectors
+    }
+
     if (GetProcessingSettings().debugLevel >= 3) {
       GPUInfo("Creating Slice Data (Slice %d)", iSlice);
     }
@@ -294,6 +305,60 @@ int32_t GPUChainTracking::RunTPCTrackingSlices_internal()
     return (3);
   }
 
+  if (nCpuSectors) {
+    // Track the CPU share of the sectors on the host while the GPU works on the sectors submitted above, and ship the results to the GPU so that global tracking and the merger see the same state as for GPU sectors
+    HighResTimer timerCpuSectors;
+    timerCpuSectors.Start();
+    for (uint32_t iSlice = nGpuSectors; iSlice < NSLICES; iSlice++) {
+      GPUTPCTracker& trk = processors()->tpcTrackers[iSlice];
+      int32_t useStream = (iSlice % mRec->NStreams());
+      if (iSlice % (GetProcessingSettings().nDeviceHelperThreads + 1) == 0) {
+        if (ReadEvent(iSlice, 0)) {
+          GPUError("Error reading event");
+          return (3);
+        }
+      } else {
+        while (HelperDone(iSlice % (GetProcessingSettings().nDeviceHelperThreads + 1) - 1) < (int32_t)iSlice) {
+        }
+        if (HelperError(iSlice % (GetProcessingSettings().nDeviceHelperThreads + 1) - 1)) {
+          return (3);
+        }
+      }
+      memset((void*)trk.Data().HitWeights(), 0, trk.Data().NumberOfHitsPlusAlign() * sizeof(*trk.Data().HitWeights()));
+      runKernel<GPUTPCNeighboursFinder>({GetGridBlk(GPUCA_ROW_COUNT, useStream, GPUReconstruction::krnlDeviceType::CPU), {iSlice}});
+      runKernel<GPUTPCNeighboursCleaner>({GetGridBlk(GPUCA_ROW_COUNT - 2, useStream, GPUReconstruction::krnlDeviceType::CPU), {iSlice}});
+      runKernel<GPUTPCStartHitsFinder>({GetGridBlk(GPUCA_ROW_COUNT - 6, useStream, GPUReconstruction::krnlDeviceType::CPU), {iSlice}});
+      if (GetProcessingSettings().memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_INDIVIDUAL) {
+        trk.UpdateMaxData();
+        AllocateRegisteredMemory(trk.MemoryResTracklets());
+        AllocateRegisteredMemory(trk.MemoryResOutput());
+      }
+      runKernel<GPUTPCTrackletConstructor>({GetGridAuto(useStream, GPUReconstruction::krnlDeviceType::CPU), {iSlice}});
+      runKernel<GPUTPCTrackletSelector>({GetGridAuto(useStream, GPUReconstruction::krnlDeviceType::CPU), {iSlice}});
+      runKernel<GPUTPCGlobalTrackingCopyNumbers>({{1, -ThreadCount(), useStream, GPUReconstruction::krnlDeviceType::CPU}, {iSlice}}, 1);
+      if (GetProcessingSettings().debugLevel >= 3) {
+        GPUInfo("Slice %u (CPU), Number of tracks: %d", iSlice, *trk.NTracks());
+      }
+      TransferMemoryResourcesToGPU(RecoStep::TPCSliceTracking, &trk, useStream);
+      TransferMemoryResourceLinkToGPU(RecoStep::TPCSliceTracking, trk.MemoryResOutput(), useStream);
+      RecordMarker(mEvents->slice[iSlice], useStream);
+      streamMap[iSlice] = useStream;
+    }
+    if (GetProcessingSettings().tpcMixedCpuGpuTracking == -1) {
+      // Rebalance the split for the next TF: the GPU has been busy since the submission loop started, so its remaining wait time on top of the CPU block measures the imbalance
+      float tCpu = timerCpuSectors.GetCurrentElapsedTime();
+      SynchronizeEvents(&mEvents->slice[nGpuSectors - 1]);
+      float tGpu = timerCpuSectors.GetCurrentElapsedTime();
+      float rCpu = tCpu / nCpuSectors;
+      float rGpu = tGpu / nGpuSectors;
+      uint32_t target = CAMath::Float2UIntRn(NSLICES * rGpu / CAMath::Max(rCpu + rGpu, 1.e-9f));
+      mMixedTrackingCPUSectors = CAMath::Max<uint32_t>(1, CAMath::Min<uint32_t>((mMixedTrackingCPUSectors + target + 1) / 2, NSLICES / 2));
+      if (GetProcessingSettings().debugLevel >= 3) {
+        GPUInfo("Mixed sector tracking: %u CPU sectors took %f s, GPU sectors finished after %f s, new CPU share %u", nCpuSectors, tCpu, tGpu, mMixedTrackingCPUSectors);
+      }
+    }
+  }
+
   if (doGPU || GetProcessingSettings().debugLevel >= 1) {
     ReleaseEvent(mEvents->init);
     if (!doSliceDataOnGPU) {
@@ -371,7 +436,7 @@ int32_t GPUChainTracking::RunTPCTrackingSlices_internal()
         }
         while (tmpSlice < NSLICES && (tmpSlice == iSlice || IsEventDone(&mEvents->slice[tmpSlice]))) {
           ReleaseEvent(mEvents->slice[tmpSlice]);
-          if (*processors()->tpcTrackers[tmpSlice].NTracks() > 0) {
+          if (tmpSlice < nGpuSectors && *processors()->tpcTrackers[tmpSlice].NTracks() > 0) { // CPU sector output is already on the host
             TransferMemoryResourceLinkToHost(RecoStep::TPCSliceTracking, processors()->tpcTrackers[tmpSlice].MemoryResOutput(), streamMap[tmpSlice], &mEvents->slice[tmpSlice]);
           } else {
             transferRunning[tmpSlice] = false;
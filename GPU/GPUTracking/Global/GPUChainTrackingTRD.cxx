@@ -115,8 +115,32 @@ int32_t GPUChainTracking::RunTRDTracking()
 #endif
   }
 
-  DoTRDGPUTracking<I>();
+  bool concurrent = GetProcessingSettings().trdTrackingConcurrent && (GetRecoStepsGPU() & RecoStep::TRDTracking);
+  DoTRDGPUTracking<I>(nullptr, !concurrent);
 
+  mTRDTrackingPending = true;
+  if (concurrent) { // Results are collected in FinishTRDTracking after the refit step, hiding the TRD kernel underneath it
+    return 0;
+  }
+  return FinishTRDTracking<I>();
+#else
+  return 0;
+#endif // GPUCA_ALIROOT_LIB
+}
+
+template <int32_t I>
+int32_t GPUChainTracking::FinishTRDTracking()
+{
+#ifndef GPUCA_ALIROOT_LIB
+  if (!mTRDTrackingPending) {
+    return 0;
+  }
+  mTRDTrackingPending = false;
+  if (GetProcessingSettings().trdTrackingConcurrent && (GetRecoStepsGPU() & RecoStep::TRDTracking)) {
+    SynchronizeStream(1);
+  }
+
+  auto& Tracker = processors()->getTRDTracker<I>();
   mIOPtrs.nTRDTracks = Tracker.NTracks();
   if constexpr (I == GPUTRDTrackerKernels::gpuVersion) {
     mIOPtrs.trdTracks = Tracker.Tracks();
@@ -134,7 +158,7 @@ int32_t GPUChainTracking::RunTRDTracking()
 }
 
 template <int32_t I, class T>
-int32_t GPUChainTracking::DoTRDGPUTracking(T* externalInstance)
+int32_t GPUChainTracking::DoTRDGPUTracking(T* externalInstance, bool synchronize)
 {
 #ifdef GPUCA_HAVE_O2HEADERS
   bool doGPU = GetRecoStepsGPU() & RecoStep::TRDTracking;
@@ -149,11 +173,16 @@ int32_t GPUChainTracking::DoTRDGPUTracking(T* externalInstance)
   }
   Tracker->PrepareTracking(this);
 
-  int32_t useStream = 0;
+  int32_t useStream = synchronize ? 0 : 1;
 
   const auto& threadContext = GetThreadContext();
   SetupGPUProcessor(Tracker, false);
   if (doGPU) {
+    if (!synchronize) { // The TRD input was produced on stream 0, order the side stream behind it
+      RecordMarker(mEvents->single, 0);
+      StreamWaitForEvents(useStream, &mEvents->single);
+      ReleaseEvent(mEvents->single);
+    }
     TrackerShadow->OverrideGPUGeometry(reinterpret_cast<GPUTRDGeometry*>(mFlatObjectsDevice.mCalibObjects.trdGeometry));
     mInputsHost->mNTRDTracklets = mInputsShadow->mNTRDTracklets = processorsShadow()->ioPtrs.nTRDTracklets = mIOPtrs.nTRDTracklets;
     mInputsHost->mNTRDTriggerRecords = mInputsShadow->mNTRDTriggerRecords = processorsShadow()->ioPtrs.nTRDTriggerRecords = mIOPtrs.nTRDTriggerRecords;
@@ -188,7 +217,9 @@ int32_t GPUChainTracking::DoTRDGPUTracking(T* externalInstance)
   TransferMemoryResourcesToGPU(RecoStep::TRDTracking, Tracker, useStream);
   runKernel<GPUTRDTrackerKernels, I>(GetGridAuto(useStream), externalInstance ? Tracker : nullptr);
   TransferMemoryResourcesToHost(RecoStep::TRDTracking, Tracker, useStream);
-  SynchronizeStream(useStream);
+  if (synchronize) {
+    SynchronizeStream(useStream);
+  }
 
   if (GetProcessingSettings().debugLevel >= 2) {
     GPUInfo("GPU TRD tracker Finished");
@@ -198,8 +229,10 @@ int32_t GPUChainTracking::DoTRDGPUTracking(T* externalInstance)
 }
 
 template int32_t GPUChainTracking::RunTRDTracking<GPUTRDTrackerKernels::gpuVersion>();
-template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTrackerGPU*);
-template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTracker*);
+template int32_t GPUChainTracking::FinishTRDTracking<GPUTRDTrackerKernels::gpuVersion>();
+template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTrackerGPU*, bool);
+template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::gpuVersion>(GPUTRDTracker*, bool);
 template int32_t GPUChainTracking::RunTRDTracking<GPUTRDTrackerKernels::o2Version>();
-template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTracker*);
-template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTrackerGPU*);
+template int32_t GPUChainTracking::FinishTRDTracking<GPUTRDTrackerKernels::o2Version>();
+template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTracker*, bool);
+template int32_t GPUChainTracking::DoTRDGPUTracking<GPUTRDTrackerKernels::o2Version>(GPUTRDTrackerGPU*, bool);
@@ -50,8 +50,10 @@
 #include "GPUTPCGMTrackParam.h"
 #include "GPUTPCGMSliceTrack.h"
 #include "GPUTPCGMBorderTrack.h"
+#include "GPUdEdxCalibHist.h"
 
 #ifdef GPUCA_HAVE_O2HEADERS
+#include "CalibdEdxContainer.h"
 #include "DataFormatsTPC/ClusterNative.h"
 #include "DataFormatsTPC/TrackTPC.h"
 #ifndef GPUCA_GPUCODE
@@ -91,7 +93,7 @@ struct MergeLooperParam {
 #include "GPUMemorySizeScalers.h"
 
 GPUTPCGMMerger::GPUTPCGMMerger()
-  : mTrackLinks(nullptr), mNTotalSliceTracks(0), mNMaxTracks(0), mNMaxSingleSliceTracks(0), mNMaxOutputTrackClusters(0), mNMaxClusters(0), mMemoryResMemory(-1), mNClusters(0), mOutputTracks(nullptr), mSliceTrackInfos(nullptr), mSliceTrackInfoIndex(nullptr), mClusters(nullptr), mClustersXYZ(nullptr), mGlobalClusterIDs(nullptr), mClusterAttachment(nullptr), mOutputTracksTPCO2(nullptr), mOutputClusRefsTPCO2(nullptr), mOutputTracksTPCO2MC(nullptr), mTrackOrderAttach(nullptr), mTrackOrderProcess(nullptr), mBorderMemory(nullptr), mBorderRangeMemory(nullptr), mMemory(nullptr), mRetryRefitIds(nullptr), mLoopData(nullptr)
+  : mTrackLinks(nullptr), mNTotalSliceTracks(0), mNMaxTracks(0), mNMaxSingleSliceTracks(0), mNMaxOutputTrackClusters(0), mNMaxClusters(0), mMemoryResMemory(-1), mNClusters(0), mOutputTracks(nullptr), mSliceTrackInfos(nullptr), mSliceTrackParam2(nullptr), mSliceTrackInfoIndex(nullptr), mClusters(nullptr), mClustersXYZ(nullptr), mGlobalClusterIDs(nullptr), mClusterAttachment(nullptr), mOutputTracksTPCO2(nullptr), mOutputClusRefsTPCO2(nullptr), mOutputTracksTPCO2MC(nullptr), mTrackOrderAttach(nullptr), mTrackOrderProcess(nullptr), mBorderMemory(nullptr), mBorderRangeMemory(nullptr), mMemory(nullptr), mRetryRefitIds(nullptr), mLoopData(nullptr), mdEdxCalibHist(nullptr)
 {
   //* constructor
 
@@ -260,6 +262,9 @@ void GPUTPCGMMerger::InitializeProcessor() {}
 void* GPUTPCGMMerger::SetPointersMerger(void* mem)
 {
   computePointerWithAlignment(mem, mSliceTrackInfos, mNTotalSliceTracks);
+  if (mRec->GetParam().rec.tpc.mergerCovSource == 2) {
+    computePointerWithAlignment(mem, mSliceTrackParam2, mNTotalSliceTracks);
+  }
   computePointerWithAlignment(mem, mSliceTrackInfoIndex, NSLICES * 2 + 1);
   if (mRec->GetParam().rec.nonConsecutiveIDs) {
     computePointerWithAlignment(mem, mGlobalClusterIDs, mNMaxOutputTrackClusters);
@@ -374,6 +379,12 @@ void* GPUTPCGMMerger::SetPointersOutputO2Scratch(void* mem)
   return mem;
 }
 
+void* GPUTPCGMMerger::SetPointersdEdxCalibHist(void* mem)
+{
+  computePointerWithAlignment(mem, mdEdxCalibHist, 1);
+  return mem;
+}
+
 void GPUTPCGMMerger::RegisterMemoryAllocation()
 {
   AllocateAndInitializeLate();
@@ -390,6 +401,9 @@ void GPUTPCGMMerger::RegisterMemoryAllocation()
     }
   }
   mMemoryResMemory = mRec->RegisterMemoryAllocation(this, &GPUTPCGMMerger::SetPointersMemory, GPUMemoryResource::MEMORY_PERMANENT, "TPCMergerMemory");
+  if (mRec->GetProcessingSettings().rundEdxCalibHist) {
+    mMemoryResdEdxCalibHist = mRec->RegisterMemoryAllocation(this, &GPUTPCGMMerger::SetPointersdEdxCalibHist, GPUMemoryResource::MEMORY_PERMANENT, "TPCMergerdEdxCalibHist");
+  }
 }
 
 void GPUTPCGMMerger::SetMaxData(const GPUTrackingInOutPointers& io)
@@ -447,7 +461,7 @@ GPUd() void GPUTPCGMMerger::ClearTrackLinks(int32_t nBlocks, int32_t nThreads, i
   }
 }
 
-GPUd() int32_t GPUTPCGMMerger::RefitSliceTrack(GPUTPCGMSliceTrack& sliceTrack, const GPUTPCTrack* inTrack, float alpha, int32_t slice)
+GPUd() int32_t GPUTPCGMMerger::RefitSliceTrack(GPUTPCGMSliceTrack& sliceTrack, GPUTPCGMSliceTrack::sliceTrackParam& param2, const GPUTPCTrack* inTrack, float alpha, int32_t slice)
 {
   GPUTPCGMPropagator prop;
   prop.SetMaterialTPC();
@@ -465,7 +479,7 @@ GPUd() int32_t GPUTPCGMMerger::RefitSliceTrack(GPUTPCGMSliceTrack& sliceTrack, c
   trk.QPt() = inTrack->Param().GetQPt();
   trk.TZOffset() = Param().par.earlyTpcTransform ? inTrack->Param().GetZOffset() : GetConstantMem()->calibObjects.fastTransformHelper->getCorrMap()->convZOffsetToVertexTime(slice, inTrack->Param().GetZOffset(), Param().continuousMaxTimeBin);
   trk.ShiftZ(this, slice, sliceTrack.ClusterZT0(), sliceTrack.ClusterZTN(), inTrack->Param().GetX(), inTrack->Param().GetX()); // We do not store the inner / outer cluster X, so we just use the track X instead
-  sliceTrack.SetX2(0.f);
+  param2.mX = 0.f;
   for (int32_t way = 0; way < 2; way++) {
     if (way) {
       prop.SetFitInProjections(true);
@@ -516,7 +530,7 @@ GPUd() int32_t GPUTPCGMMerger::RefitSliceTrack(GPUTPCGMSliceTrack& sliceTrack, c
       trk.ConstrainSinPhi();
     }
     if (way) {
-      sliceTrack.SetParam2(trk);
+      GPUTPCGMSliceTrack::SetParam2(trk, param2);
     } else {
       sliceTrack.Set(trk, inTrack, alpha, slice);
     }
@@ -607,6 +621,8 @@ GPUd() void GPUTPCGMMerger::RefitSliceTracks(int32_t nBlocks, int32_t nThreads,
       sliceTr = sliceTr->GetNextTrack();
     }
     GPUTPCGMSliceTrack track;
+    GPUTPCGMSliceTrack::sliceTrackParam param2;
+    param2.mX = 0.f;
     SetTrackClusterZT(track, iSlice, sliceTr);
     if (Param().rec.tpc.mergerCovSource == 0) {
       track.Set(this, sliceTr, alpha, iSlice);
@@ -617,7 +633,7 @@ GPUd() void GPUTPCGMMerger::RefitSliceTracks(int32_t nBlocks, int32_t nThreads,
       track.Set(this, sliceTr, alpha, iSlice);
       track.CopyBaseTrackCov();
     } else if (Param().rec.tpc.mergerCovSource == 2) {
-      if (RefitSliceTrack(track, sliceTr, alpha, iSlice)) {
+      if (RefitSliceTrack(track, param2, sliceTr, alpha, iSlice)) {
         track.Set(this, sliceTr, alpha, iSlice); // TODO: Why does the refit fail, it shouldn't, this workaround should be removed
         if (!track.FilterErrors(this, iSlice, GPUCA_MAX_SIN_PHI, 0.1f)) {
           continue;
@@ -635,6 +651,9 @@ GPUd() void GPUTPCGMMerger::RefitSliceTracks(int32_t nBlocks, int32_t nThreads,
     uint32_t myTrack = CAMath::AtomicAdd(&mMemory->nUnpackedTracks, 1u);
     mTrackIDs[iSlice * mNMaxSingleSliceTracks + sliceTr->LocalTrackId()] = myTrack;
     mSliceTrackInfos[myTrack] = track;
+    if (Param().rec.tpc.mergerCovSource == 2) {
+      mSliceTrackParam2[myTrack] = param2;
+    }
   }
   if (!Param().rec.tpc.mergerReadFromTrackerDirectly) {
     mMemory->firstGlobalTracks[iSlice] = nLocalTracks ? sliceTr->GetNextTrack() : mkSlices[iSlice]->GetFirstTrack();
@@ -701,8 +720,8 @@ GPUd() void GPUTPCGMMerger::MergeSlicesPrepareStep2(int32_t nBlocks, int32_t nTh
       }
       trackTmp = *trackMin;
       track = &trackTmp;
-      if (Param().rec.tpc.mergerCovSource == 2 && trackTmp.X2() != 0.f) {
-        trackTmp.UseParam2();
+      if (Param().rec.tpc.mergerCovSource == 2 && mSliceTrackParam2[trackMin - mSliceTrackInfos].mX != 0.f) {
+        trackTmp.UseParam2(mSliceTrackParam2[trackMin - mSliceTrackInfos]);
       } else {
         trackTmp.Set(this, trackMin->OrigTrack(), trackMin->Alpha(), trackMin->Slice());
       }
@@ -2316,3 +2335,59 @@ GPUd() void GPUTPCGMMerger::MergeLoopersMain(int32_t nBlocks, int32_t nThreads,
   }
 #endif*/
 }
+
+GPUd() void GPUTPCGMMerger::FilldEdxCalibHist(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread)
+{
+#if defined(GPUCA_HAVE_O2HEADERS) && !defined(GPUCA_OPENCL1)
+  // Accumulate the per-track dEdx values of this TF into the multi-TF calibration histogram,
+  // mirroring the track selection of o2::tpc::CalibdEdx::fill. The track parameters at the inner
+  // point are used for all ROC types instead of propagating to the individual stack centers, and
+  // no Bethe-Bloch scaling is applied, which is close to unity inside the MIP momentum window.
+  const auto* calibContainer = GetConstantMem()->calibObjects.dEdxCalibContainer;
+  for (uint32_t i = get_global_id(0); i < mMemory->nOutputTracks; i += get_global_size(0)) {
+    const GPUTPCGMMergedTrack& trk = mOutputTracks[i];
+    if (!trk.OK() || trk.CCE() || trk.MergedLooper()) {
+      continue;
+    }
+    if (trk.NClusters() < 60) { // MIP selection as in the default CalibdEdx TrackCuts
+      continue;
+    }
+    const float tgl = trk.GetParam().GetDzDs();
+    const float snp = trk.GetParam().GetSinPhi();
+    const float p = CAMath::Sqrt(1.f + tgl * tgl) / CAMath::Max(CAMath::Abs(trk.GetParam().GetQPt()), 1.e-10f);
+    if (p < 0.3f || p > 0.7f) {
+      continue;
+    }
+    const GPUdEdxInfo& dEdx = mOutputTracksdEdx[i];
+    if (dEdx.dEdxTotTPC <= 0.f) {
+      continue;
+    }
+    float alpha = trk.GetAlpha();
+    if (alpha < 0.f) {
+      alpha += CAMath::TwoPi();
+    }
+    int32_t sector = (int32_t)(alpha * ((float)SECTORSPERSIDE / CAMath::TwoPi()));
+    if (sector >= SECTORSPERSIDE) {
+      sector = SECTORSPERSIDE - 1;
+    }
+    if (trk.CSide()) {
+      sector += SECTORSPERSIDE;
+    }
+    const float dEdxMax[4] = {dEdx.dEdxMaxIROC, dEdx.dEdxMaxOROC1, dEdx.dEdxMaxOROC2, dEdx.dEdxMaxOROC3};
+    const float dEdxTot[4] = {dEdx.dEdxTotIROC, dEdx.dEdxTotOROC1, dEdx.dEdxTotOROC2, dEdx.dEdxTotOROC3};
+    for (int32_t roc = 0; roc < GPUdEdxCalibHist::NStacks; roc++) {
+      if (dEdxTot[roc] == 0.f && dEdxMax[roc] == 0.f) {
+        continue;
+      }
+      const float scaledTgl = CAMath::Abs(tgl) / conf_dedx_corr::TglScale[roc];
+      // undo the residual correction applied during the dEdx computation, like the undoing of the
+      // calibration input in the CPU fill, so the histogram holds the uncalibrated values
+      const StackID stack{sector, static_cast<GEMstack>(roc)};
+      const float corrMax = calibContainer ? calibContainer->getResidualCorrection(stack, ChargeType::Max, tgl, snp) : 1.f;
+      const float corrTot = calibContainer ? calibContainer->getResidualCorrection(stack, ChargeType::Tot, tgl, snp) : 1.f;
+      mdEdxCalibHist->fill(ChargeType::Max, dEdxMax[roc] * GPUdEdxCalibHist::MipScale * corrMax, scaledTgl, snp, sector, roc);
+      mdEdxCalibHist->fill(ChargeType::Tot, dEdxTot[roc] * GPUdEdxCalibHist::MipScale * corrTot, scaledTgl, snp, sector, roc);
+    }
+  }
+#endif
+}
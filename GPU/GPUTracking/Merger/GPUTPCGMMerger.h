@@ -54,6 +54,7 @@ class GPUChainTracking;
 class GPUTPCGMPolynomialField;
 struct GPUTPCGMLoopData;
 struct MergeLooperParam;
+struct GPUdEdxCalibHist;
 
 /**
  * @class GPUTPCGMMerger
@@ -106,6 +107,7 @@ class GPUTPCGMMerger : public GPUProcessor
   void* SetPointersOutputO2Scratch(void* mem);
   void* SetPointersOutputState(void* mem);
   void* SetPointersMemory(void* mem);
+  void* SetPointersdEdxCalibHist(void* mem);
 
   void SetSliceData(int32_t index, const GPUTPCSliceOutput* sliceData) { mkSlices[index] = sliceData; }
 
@@ -114,6 +116,7 @@ class GPUTPCGMMerger : public GPUProcessor
   GPUhdi() GPUTPCGMMergedTrack* OutputTracks() { return mOutputTracks; }
   GPUhdi() const GPUdEdxInfo* OutputTracksdEdx() const { return mOutputTracksdEdx; }
   GPUhdi() GPUdEdxInfo* OutputTracksdEdx() { return mOutputTracksdEdx; }
+  GPUhdi() GPUdEdxCalibHist* dEdxCalibHist() { return mdEdxCalibHist; }
   GPUhdi() uint32_t NClusters() const { return mNClusters; }
   GPUhdi() uint32_t NMaxClusters() const { return mNMaxClusters; }
   GPUhdi() uint32_t NMaxTracks() const { return mNMaxTracks; }
@@ -156,8 +159,9 @@ class GPUTPCGMMerger : public GPUProcessor
   GPUd() uint16_t MemoryResOutputO2Clus() const { return mMemoryResOutputO2Clus; }
   GPUd() uint16_t MemoryResOutputO2MC() const { return mMemoryResOutputO2MC; }
   GPUd() uint16_t MemoryResOutputO2Scratch() const { return mMemoryResOutputO2Scratch; }
+  GPUd() uint16_t MemoryResdEdxCalibHist() const { return mMemoryResdEdxCalibHist; }
 
-  GPUd() int32_t RefitSliceTrack(GPUTPCGMSliceTrack& sliceTrack, const GPUTPCTrack* inTrack, float alpha, int32_t slice);
+  GPUd() int32_t RefitSliceTrack(GPUTPCGMSliceTrack& sliceTrack, GPUTPCGMSliceTrack::sliceTrackParam& param2, const GPUTPCTrack* inTrack, float alpha, int32_t slice);
   GPUd() void SetTrackClusterZT(GPUTPCGMSliceTrack& track, int32_t iSlice, const GPUTPCTrack* sliceTr);
 
   int32_t CheckSlices();
@@ -193,6 +197,7 @@ class GPUTPCGMMerger : public GPUProcessor
   GPUd() void MergeLoopersInit(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread);
   GPUd() void MergeLoopersSort(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread);
   GPUd() void MergeLoopersMain(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread);
+  GPUd() void FilldEdxCalibHist(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread);
 
 #ifndef GPUCA_GPUCODE
   void DumpSliceTracks(std::ostream& out) const;
@@ -265,11 +270,14 @@ class GPUTPCGMMerger : public GPUProcessor
   uint16_t mMemoryResOutputO2Clus;
   uint16_t mMemoryResOutputO2MC;
   uint16_t mMemoryResOutputO2Scratch;
+  uint16_t mMemoryResdEdxCalibHist;
 
   int32_t mNClusters;                   // Total number of incoming clusters (from slice tracks)
   GPUTPCGMMergedTrack* mOutputTracks;   //* array of output merged tracks
   GPUdEdxInfo* mOutputTracksdEdx;       //* dEdx information
+  GPUdEdxCalibHist* mdEdxCalibHist;     //* dEdx calibration histogram accumulated over TFs
   GPUTPCGMSliceTrack* mSliceTrackInfos; //* additional information for slice tracks
+  GPUTPCGMSliceTrack::sliceTrackParam* mSliceTrackParam2; //* parameters at the other side of the slice tracks, only accessed during CE / looper merging
   int32_t* mSliceTrackInfoIndex;
   GPUTPCGMMergedTrackHit* mClusters;
   GPUTPCGMMergedTrackHitXYZ* mClustersXYZ;
@@ -220,4 +220,10 @@ GPUdii() void GPUTPCGMMergerMergeLoopers::Thread<2>(int32_t nBlocks, int32_t nTh
 {
   merger.MergeLoopersMain(nBlocks, nThreads, iBlock, iThread);
 }
+
+template <>
+GPUdii() void GPUTPCGMMergerFilldEdxHist::Thread<0>(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread, GPUsharedref() GPUSharedMemory& smem, processorType& GPUrestrict() merger)
+{
+  merger.FilldEdxCalibHist(nBlocks, nThreads, iBlock, iThread);
+}
 #endif // !defined(GPUCA_GPUCODE) || !defined(GPUCA_ALIROOT_LIB)
@@ -224,6 +224,15 @@ class GPUTPCGMMergerMergeLoopers : public GPUTPCGMMergerGeneral
 #endif
 };
 
+class GPUTPCGMMergerFilldEdxHist : public GPUTPCGMMergerGeneral
+{
+ public:
+#if !defined(GPUCA_ALIROOT_LIB) || !defined(GPUCA_GPUCODE)
+  template <int32_t iKernel = defaultKernel>
+  GPUd() static void Thread(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread, GPUsharedref() GPUSharedMemory& smem, processorType& merger);
+#endif
+};
+
 } // namespace gpu
 } // namespace GPUCA_NAMESPACE
 
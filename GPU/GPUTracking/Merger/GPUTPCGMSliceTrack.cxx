@@ -71,25 +71,25 @@ GPUd() void GPUTPCGMSliceTrack::Set(const GPUTPCGMTrackParam& trk, const GPUTPCT
   mParam.mC14 = trk.GetCov(14);
 }
 
-GPUd() void GPUTPCGMSliceTrack::SetParam2(const GPUTPCGMTrackParam& trk)
+GPUd() void GPUTPCGMSliceTrack::SetParam2(const GPUTPCGMTrackParam& trk, sliceTrackParam& param2)
 {
-  mParam2.mX = trk.GetX();
-  mParam2.mY = trk.GetY();
-  mParam2.mZ = trk.GetZ();
-  mParam2.mDzDs = trk.GetDzDs();
-  mParam2.mSinPhi = trk.GetSinPhi();
-  mParam2.mQPt = trk.GetQPt();
-  mParam2.mCosPhi = CAMath::Sqrt(1.f - mParam2.mSinPhi * mParam2.mSinPhi);
-  mParam2.mSecPhi = 1.f / mParam2.mCosPhi;
-  mParam2.mC0 = trk.GetCov(0);
-  mParam2.mC2 = trk.GetCov(2);
-  mParam2.mC3 = trk.GetCov(3);
-  mParam2.mC5 = trk.GetCov(5);
-  mParam2.mC7 = trk.GetCov(7);
-  mParam2.mC9 = trk.GetCov(9);
-  mParam2.mC10 = trk.GetCov(10);
-  mParam2.mC12 = trk.GetCov(12);
-  mParam2.mC14 = trk.GetCov(14);
+  param2.mX = trk.GetX();
+  param2.mY = trk.GetY();
+  param2.mZ = trk.GetZ();
+  param2.mDzDs = trk.GetDzDs();
+  param2.mSinPhi = trk.GetSinPhi();
+  param2.mQPt = trk.GetQPt();
+  param2.mCosPhi = CAMath::Sqrt(1.f - param2.mSinPhi * param2.mSinPhi);
+  param2.mSecPhi = 1.f / param2.mCosPhi;
+  param2.mC0 = trk.GetCov(0);
+  param2.mC2 = trk.GetCov(2);
+  param2.mC3 = trk.GetCov(3);
+  param2.mC5 = trk.GetCov(5);
+  param2.mC7 = trk.GetCov(7);
+  param2.mC9 = trk.GetCov(9);
+  param2.mC10 = trk.GetCov(10);
+  param2.mC12 = trk.GetCov(12);
+  param2.mC14 = trk.GetCov(14);
 }
 
 GPUd() bool GPUTPCGMSliceTrack::FilterErrors(const GPUTPCGMMerger* merger, int32_t iSlice, float maxSinPhi, float sinPhiMargin)
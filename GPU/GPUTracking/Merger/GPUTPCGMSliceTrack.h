@@ -75,12 +75,15 @@ class GPUTPCGMSliceTrack
     mClusterZT[1] = v2;
   }
 
+  struct sliceTrackParam {
+    float mX, mY, mZ, mSinPhi, mDzDs, mQPt, mCosPhi, mSecPhi; // parameters
+    float mC0, mC2, mC3, mC5, mC7, mC9, mC10, mC12, mC14;     // covariances
+  };
+
   GPUd() void Set(const GPUTPCGMTrackParam& trk, const GPUTPCTrack* sliceTr, float alpha, int32_t slice);
-  GPUd() void SetParam2(const GPUTPCGMTrackParam& trk);
+  GPUd() static void SetParam2(const GPUTPCGMTrackParam& trk, sliceTrackParam& param2);
   GPUd() void Set(const GPUTPCGMMerger* merger, const GPUTPCTrack* sliceTr, float alpha, int32_t slice);
-  GPUd() void UseParam2() { mParam = mParam2; }
-  GPUd() void SetX2(float v) { mParam2.mX = v; }
-  GPUd() float X2() const { return mParam2.mX; }
+  GPUd() void UseParam2(const sliceTrackParam& param2) { mParam = param2; }
 
   GPUd() void SetGlobalSectorTrackCov()
   {
@@ -120,15 +123,10 @@ class GPUTPCGMSliceTrack
   GPUd() bool TransportToX(GPUTPCGMMerger* merger, float x, float Bz, GPUTPCGMBorderTrack& b, float maxSinPhi, bool doCov = true) const;
   GPUd() bool TransportToXAlpha(GPUTPCGMMerger* merger, float x, float sinAlpha, float cosAlpha, float Bz, GPUTPCGMBorderTrack& b, float maxSinPhi) const;
   GPUd() void CopyBaseTrackCov();
-  struct sliceTrackParam {
-    float mX, mY, mZ, mSinPhi, mDzDs, mQPt, mCosPhi, mSecPhi; // parameters
-    float mC0, mC2, mC3, mC5, mC7, mC9, mC10, mC12, mC14;     // covariances
-  };
 
  private:
   const GPUTPCTrack* mOrigTrack; // pointer to original slice track
   sliceTrackParam mParam;        // Track parameters
-  sliceTrackParam mParam2;       // Parameters at other side
   float mTZOffset;               // Z offset with early transform, T offset otherwise
   float mAlpha;                  // alpha angle
   float mClusterZT[2];           // Minimum maximum cluster Z / T
@@ -140,7 +138,7 @@ class GPUTPCGMSliceTrack
   uint8_t mSlice;                // slice of this track segment
   uint8_t mLeg;                  // Leg of this track segment
 
-  ClassDefNV(GPUTPCGMSliceTrack, 1);
+  ClassDefNV(GPUTPCGMSliceTrack, 2);
 };
 } // namespace gpu
 } // namespace GPUCA_NAMESPACE
@@ -20,6 +20,9 @@
 #include "GPUTPCGMMergedTrack.h"
 #include "GPUTPCGMPropagator.h"
 #include "GPUConstantMem.h"
+#ifndef GPUCA_GPUCODE_DEVICE
+#include "GPUReconstruction.h"
+#endif
 #include "ReconstructionDataFormats/Track.h"
 #include "CorrectionMapsHelper.h"
 #include "DetectorsBase/Propagator.h"
@@ -56,11 +59,20 @@ void GPUTrackingRefitProcessor::InitializeProcessor()
 void GPUTrackingRefitProcessor::RegisterMemoryAllocation()
 {
   AllocateAndInitializeLate();
+  mMemoryResSort = mRec->RegisterMemoryAllocation(this, &GPUTrackingRefitProcessor::SetPointersSortScratch, GPUMemoryResource::MEMORY_SCRATCH | GPUMemoryResource::MEMORY_STACK, "TrackingRefitSortScratch");
 }
 
 void GPUTrackingRefitProcessor::SetMaxData(const GPUTrackingInOutPointers& io)
 {
 }
+
+void* GPUTrackingRefitProcessor::SetPointersSortScratch(void* mem)
+{
+  if (mRec->GetProcessingSettings().refitSortTracks) {
+    computePointerWithAlignment(mem, mPTrackOrder, mMaxTracks);
+  }
+  return mem;
+}
 #endif
 
 namespace
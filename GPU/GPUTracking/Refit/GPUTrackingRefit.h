@@ -113,8 +113,12 @@ class GPUTrackingRefitProcessor : public GPUTrackingRefit, public GPUProcessor
   void InitializeProcessor();
   void RegisterMemoryAllocation();
   void SetMaxData(const GPUTrackingInOutPointers& io);
+  void* SetPointersSortScratch(void* mem);
 #endif
   GPUTPCGMMergedTrack* mPTracks = nullptr;
+  int32_t* mPTrackOrder = nullptr; // Processing order of the refit kernel, sorted by descending cluster count to reduce divergence
+  uint32_t mMaxTracks = 0;
+  uint16_t mMemoryResSort = (uint16_t)-1;
 };
 
 } // namespace o2::gpu
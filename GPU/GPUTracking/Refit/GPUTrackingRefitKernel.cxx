@@ -14,6 +14,7 @@
 
 #include "GPUTrackingRefitKernel.h"
 #include "GPUTrackingRefit.h"
+#include "GPUCommonAlgorithm.h"
 #include "GPUROOTDump.h"
 
 using namespace GPUCA_NAMESPACE::gpu;
@@ -22,24 +23,37 @@ template <int32_t I>
 GPUdii() void GPUTrackingRefitKernel::Thread(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread, GPUsharedref() GPUSharedMemory& smem, processorType& GPUrestrict() processors)
 {
   auto& refit = processors.trackingRefit;
-  for (uint32_t i = get_global_id(0); i < processors.ioPtrs.nMergedTracks; i += get_global_size(0)) {
-    if (refit.mPTracks[i].OK()) {
-      GPUTPCGMMergedTrack trk = refit.mPTracks[i];
-      int32_t retval;
-      if constexpr (I == mode0asGPU) {
-        retval = refit.RefitTrackAsGPU(trk, false, true);
-      } else if constexpr (I == mode1asTrackParCov) {
-        retval = refit.RefitTrackAsTrackParCov(trk, false, true);
-      }
-      /*#pragma omp critical
-      if (retval > 0) {
-        static auto cldump = GPUROOTDump<GPUTPCGMMergedTrack, GPUTPCGMMergedTrack>::getNew("org", "refit", "debugTree");
-        cldump.Fill(refit.mPTracks[i], trk);
-      }*/
-      if (retval > 0) {
-        refit.mPTracks[i] = trk;
-      } else {
-        refit.mPTracks[i].SetOK(false);
+  if constexpr (I == sortTracks) {
+#ifndef GPUCA_SPECIALIZE_THRUST_SORTS
+    if (iThread || iBlock) {
+      return;
+    }
+    auto comp = [cmp = refit.mPTracks](const int32_t aa, const int32_t bb) {
+      return cmp[aa].NClusters() > cmp[bb].NClusters();
+    };
+    GPUCommonAlgorithm::sortDeviceDynamic(refit.mPTrackOrder, refit.mPTrackOrder + processors.ioPtrs.nMergedTracks, comp);
+#endif
+  } else {
+    for (uint32_t ii = get_global_id(0); ii < processors.ioPtrs.nMergedTracks; ii += get_global_size(0)) {
+      const uint32_t i = refit.mPTrackOrder ? refit.mPTrackOrder[ii] : ii;
+      if (refit.mPTracks[i].OK()) {
+        GPUTPCGMMergedTrack trk = refit.mPTracks[i];
+        int32_t retval;
+        if constexpr (I == mode0asGPU) {
+          retval = refit.RefitTrackAsGPU(trk, false, true);
+        } else if constexpr (I == mode1asTrackParCov) {
+          retval = refit.RefitTrackAsTrackParCov(trk, false, true);
+        }
+        /*#pragma omp critical
+        if (retval > 0) {
+          static auto cldump = GPUROOTDump<GPUTPCGMMergedTrack, GPUTPCGMMergedTrack>::getNew("org", "refit", "debugTree");
+          cldump.Fill(refit.mPTracks[i], trk);
+        }*/
+        if (retval > 0) {
+          refit.mPTracks[i] = trk;
+        } else {
+          refit.mPTracks[i].SetOK(false);
+        }
       }
     }
   }
@@ -47,4 +61,24 @@ GPUdii() void GPUTrackingRefitKernel::Thread(int32_t nBlocks, int32_t nThreads,
 #if !defined(GPUCA_GPUCODE) || defined(GPUCA_GPUCODE_DEVICE) // FIXME: DR: WORKAROUND to avoid CUDA bug creating host symbols for device code.
 template GPUdni() void GPUTrackingRefitKernel::Thread<0>(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread, GPUsharedref() GPUSharedMemory& smem, processorType& GPUrestrict() processors);
 template GPUdni() void GPUTrackingRefitKernel::Thread<1>(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread, GPUsharedref() GPUSharedMemory& smem, processorType& GPUrestrict() processors);
+template GPUdni() void GPUTrackingRefitKernel::Thread<2>(int32_t nBlocks, int32_t nThreads, int32_t iBlock, int32_t iThread, GPUsharedref() GPUSharedMemory& smem, processorType& GPUrestrict() processors);
 #endif
+
+#if defined(GPUCA_SPECIALIZE_THRUST_SORTS) && !defined(GPUCA_GPUCODE_COMPILEKERNELS) // Specialize GPUTrackingRefitKernel::Thread<GPUTrackingRefitKernel::sortTracks>
+struct GPUTrackingRefitKernelSort_comp {
+  const GPUTPCGMMergedTrack* const mCmp;
+  GPUhd() GPUTrackingRefitKernelSort_comp(GPUTPCGMMergedTrack* cmp) : mCmp(cmp) {}
+  GPUd() bool operator()(const int32_t aa, const int32_t bb)
+  {
+    return mCmp[aa].NClusters() > mCmp[bb].NClusters();
+  }
+};
+
+template <>
+inline void GPUCA_KRNL_BACKEND_CLASS::runKernelBackendInternal<GPUTrackingRefitKernel, GPUTrackingRefitKernel::sortTracks>(const krnlSetupTime& _xyz)
+{
+  thrust::device_ptr<int32_t> trackSort(mProcessorsShadow->trackingRefit.mPTrackOrder);
+  ThrustVolatileAsyncAllocator alloc(this);
+  thrust::sort(GPUCA_THRUST_NAMESPACE::par(alloc).on(mInternals->Streams[_xyz.x.stream]), trackSort, trackSort + processors()->trackingRefit.mMaxTracks, GPUTrackingRefitKernelSort_comp(mProcessorsShadow->trackingRefit.mPTracks));
+}
+#endif // GPUCA_SPECIALIZE_THRUST_SORTS - Specialize GPUTrackingRefitKernel::Thread<GPUTrackingRefitKernel::sortTracks>
@@ -29,6 +29,7 @@ class GPUTrackingRefitKernel : public GPUKernelTemplate
   enum K : int32_t {
     mode0asGPU = 0,
     mode1asTrackParCov = 1,
+    sortTracks = 2,
   };
 
   template <int32_t iKernel = defaultKernel>
@@ -974,6 +974,11 @@ breakrun:
   if (rec->GetProcessingSettings().memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_GLOBAL) {
     rec->PrintMemoryMax();
   }
+  if (configStandalone.timingResultsFile.size()) {
+    if (rec->WriteTimingResults(configStandalone.timingResultsFile.c_str())) {
+      printf("Error writing timing results\n");
+    }
+  }
 
 #ifndef _WIN32
   if (configStandalone.proc.runQA && configStandalone.fpe) {
@@ -51,6 +51,7 @@ struct GPUTPCCFChainContext {
   bool abandonTimeframe;
   uint32_t nFragments;
   CfFragment fragmentFirst;
+  std::vector<std::pair<uint32_t, uint32_t>> sliceBatches; // (first sector, number of sectors) of the balanced lane batches
   std::pair<uint32_t, uint32_t> nextPos[GPUCA_NSLICES];
   PtrSave ptrSave[GPUCA_NSLICES];
   const o2::tpc::ClusterNativeAccess* ptrClusterNativeSave;
@@ -59,6 +60,7 @@ struct GPUTPCCFChainContext {
   {
     abandonTimeframe = false;
     nPagesTotal = nPagesFragmentMax = 0;
+    sliceBatches.clear();
     for (uint32_t i = 0; i < GPUCA_NSLICES; i++) {
       nPagesSector[i] = 0;
       nDigitsEndpointMax[i] = 0;
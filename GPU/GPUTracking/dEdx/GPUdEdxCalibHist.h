@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GPUdEdxCalibHist.h
+/// \author David Rohr
+
+#ifndef GPUDEDXCALIBHIST_H
+#define GPUDEDXCALIBHIST_H
+
+#include "GPUDef.h"
+#include "GPUCommonMath.h"
+#if defined(GPUCA_HAVE_O2HEADERS) && !defined(GPUCA_OPENCL1)
+#include "DataFormatsTPC/Defs.h"
+#endif
+
+namespace GPUCA_NAMESPACE
+{
+namespace gpu
+{
+#if !defined(GPUCA_HAVE_O2HEADERS) || defined(GPUCA_OPENCL1)
+
+struct GPUdEdxCalibHist {
+  GPUd() void fill(int32_t charge, float dEdx, float scaledTgl, float snp, int32_t sector, int32_t stack) {}
+};
+
+#else
+
+// dE/dx histogram with fixed binning that can be filled on the GPU and accumulated over multiple TFs.
+// The bin layout matches the default axes of o2::tpc::CalibdEdx (dEdx, Tgl, Snp, sector, stack type,
+// charge type, with the first axis varying fastest), so the counts can be added bin by bin to the
+// calibration histogram on the host.
+struct GPUdEdxCalibHist {
+  static constexpr float MipScale = 1.f / 50.f; // Must match o2::tpc::CalibdEdx::MipScale
+  static constexpr int32_t NBinsdEdx = 60;
+  static constexpr float MindEdx = 20.f * MipScale;
+  static constexpr float MaxdEdx = 90.f * MipScale;
+  static constexpr int32_t NBinsTgl = 36;
+  static constexpr int32_t NBinsSnp = 1; // CalibdEdx default is fitSnp = false, collapsing the Snp axis
+  static constexpr int32_t NSectors = o2::tpc::SECTORSPERSIDE * o2::tpc::SIDES;
+  static constexpr int32_t NStacks = o2::tpc::GEMSTACKSPERSECTOR;
+  static constexpr int32_t NCharges = o2::tpc::CHARGETYPES;
+  static constexpr uint32_t NBinsTotal = (uint32_t)NBinsdEdx * NBinsTgl * NBinsSnp * NSectors * NStacks * NCharges;
+
+  GPUAtomic(uint32_t) mBins[NBinsTotal]; // bin counts
+
+  // The axes carry no under / overflow bins, out of range entries are dropped as in CalibdEdx
+  GPUd() void fill(int32_t charge, float dEdx, float scaledTgl, float snp, int32_t sector, int32_t stack)
+  {
+    const int32_t bindEdx = (int32_t)((dEdx - MindEdx) * ((float)NBinsdEdx / (MaxdEdx - MindEdx)));
+    if (bindEdx < 0 || bindEdx >= NBinsdEdx) {
+      return;
+    }
+    const int32_t binTgl = (int32_t)(scaledTgl * (float)NBinsTgl);
+    if (binTgl < 0 || binTgl >= NBinsTgl) {
+      return;
+    }
+    const int32_t binSnp = (int32_t)((snp + 1.f) * 0.5f * (float)NBinsSnp);
+    if (binSnp < 0 || binSnp >= NBinsSnp) {
+      return;
+    }
+    const uint32_t bin = (uint32_t)bindEdx + NBinsdEdx * ((uint32_t)binTgl + NBinsTgl * ((uint32_t)binSnp + NBinsSnp * ((uint32_t)sector + NSectors * ((uint32_t)stack + NStacks * (uint32_t)charge))));
+    CAMath::AtomicAdd(&mBins[bin], 1u);
+  }
+};
+
+#endif // !GPUCA_HAVE_O2HEADERS || GPUCA_OPENCL1
+} // namespace gpu
+} // namespace GPUCA_NAMESPACE
+
+#endif
@@ -182,6 +182,9 @@ int32_t GPUDisplay::InitDisplay_internal()
   if (mBackend->InitBackend()) {
     return 1;
   }
+  if (mConfig.remoteStreamPort && mDeltaServer.startServer(mConfig.remoteStreamPort)) {
+    return 1;
+  }
   mYFactor = mBackend->getYFactor();
   mDrawTextInCompatMode = !mBackend->mFreetypeInitialized && mFrontend->mCanDrawText == 1;
   int32_t height = 0, width = 0;
@@ -196,6 +199,7 @@ int32_t GPUDisplay::InitDisplay_internal()
 
 void GPUDisplay::ExitDisplay()
 {
+  mDeltaServer.stopServer();
   mBackend->ExitBackend();
 }
 
@@ -18,6 +18,7 @@
 #include "GPUSettings.h"
 #include "frontend/GPUDisplayFrontend.h"
 #include "backend/GPUDisplayBackend.h"
+#include "helpers/GPUDisplayDeltaServer.h"
 #include "GPUDisplayInterface.h"
 
 #include "GPUChainTracking.h"
@@ -277,6 +278,7 @@ class GPUDisplay : public GPUDisplayInterface
   vecpod<bool> mITSStandaloneTracks;
   std::vector<bool> mTrackFilter;
   bool mUpdateTrackFilter = false;
+  GPUDisplayDeltaServer mDeltaServer;
 
   int32_t mUpdateVertexLists = 1;
   int32_t mUpdateEventData = 0;
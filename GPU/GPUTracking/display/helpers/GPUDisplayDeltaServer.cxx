@@ -0,0 +1,178 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GPUDisplayDeltaServer.cxx
+/// \author David Rohr
+
+#include "GPUDisplayDeltaServer.h"
+#include "GPULogging.h"
+#include "GPUDataTypes.h"
+#include "GPUTPCGMMergedTrack.h"
+#include "GPUTPCGMMergedTrackHit.h"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace GPUCA_NAMESPACE::gpu;
+
+#ifndef _WIN32
+
+int32_t GPUDisplayDeltaServer::startServer(int32_t port)
+{
+  mListenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (mListenFd == -1) {
+    GPUError("Could not create socket for remote display streaming");
+    return 1;
+  }
+  int32_t reuse = 1;
+  setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = INADDR_ANY;
+  addr.sin_port = htons((uint16_t)port);
+  if (bind(mListenFd, (sockaddr*)&addr, sizeof(addr)) || listen(mListenFd, 4) || fcntl(mListenFd, F_SETFL, O_NONBLOCK)) {
+    GPUError("Could not listen on port %d for remote display streaming", port);
+    close(mListenFd);
+    mListenFd = -1;
+    return 1;
+  }
+  GPUInfo("Streaming event display data to remote clients on port %d", port);
+  return 0;
+}
+
+void GPUDisplayDeltaServer::stopServer()
+{
+  for (const auto& client : mClients) {
+    close(client.fd);
+  }
+  mClients.clear();
+  if (mListenFd != -1) {
+    close(mListenFd);
+    mListenFd = -1;
+  }
+}
+
+void GPUDisplayDeltaServer::pollConnections()
+{
+  int32_t fd;
+  while ((fd = accept(mListenFd, nullptr, nullptr)) != -1) {
+    timeval timeout{1, 0}; // Drop clients that block the sender for more than a second, a stuck viewer must not stall the node
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    int32_t noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    mClients.push_back({fd, false});
+  }
+}
+
+bool GPUDisplayDeltaServer::sendAll(int32_t fd, const void* data, size_t size)
+{
+  const char* ptr = (const char*)data;
+  while (size) {
+    ssize_t n = send(fd, ptr, size, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return false;
+    }
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+void GPUDisplayDeltaServer::sendEvent(const float4* clusterPos, uint32_t nClusters, const GPUTrackingInOutPointers* ioPtrs)
+{
+  if (!active()) {
+    return;
+  }
+  pollConnections();
+  if (mClients.empty()) {
+    mClusters.clear();
+    mTrackRefs.clear();
+    mNTracks = 0;
+    return;
+  }
+
+  auto quant = [](float v) { v *= QUANT_SCALE; return (int16_t)(v > 32767.f ? 32767.f : v < -32768.f ? -32768.f : v); };
+  std::vector<QuantPos> clusters(nClusters);
+  for (uint32_t i = 0; i < nClusters; i++) {
+    clusters[i] = {quant(clusterPos[i].x), quant(clusterPos[i].y), quant(clusterPos[i].z)};
+  }
+  std::vector<uint32_t> trackRefs;
+  uint32_t nTracks = 0;
+  trackRefs.reserve(mTrackRefs.size());
+  for (uint32_t i = 0; i < ioPtrs->nMergedTracks; i++) {
+    const GPUTPCGMMergedTrack& track = ioPtrs->mergedTracks[i];
+    if (!track.OK()) {
+      continue;
+    }
+    trackRefs.push_back(track.NClusters());
+    for (uint32_t k = 0; k < track.NClusters(); k++) {
+      trackRefs.push_back(ioPtrs->mergedTrackHits[track.FirstClusterRef() + k].num);
+    }
+    nTracks++;
+  }
+
+  // The previous packet content is a prefix of the new one if only data was appended, then synced clients need just the added part
+  bool isDelta = mClusters.size() <= clusters.size() && mTrackRefs.size() <= trackRefs.size() && (mClusters.empty() || memcmp(mClusters.data(), clusters.data(), mClusters.size() * sizeof(QuantPos)) == 0) && (mTrackRefs.empty() || memcmp(mTrackRefs.data(), trackRefs.data(), mTrackRefs.size() * sizeof(uint32_t)) == 0);
+
+  PacketHeader full;
+  full.eventCount = mEventCount;
+  full.nClusters = clusters.size();
+  full.nTracks = nTracks;
+  full.nTrackClusterRefs = trackRefs.size();
+  PacketHeader delta = full;
+  delta.flags = 1;
+  delta.firstCluster = mClusters.size();
+  delta.nClusters = clusters.size() - mClusters.size();
+  delta.firstTrack = mNTracks;
+  delta.nTracks = nTracks - mNTracks;
+  delta.nTrackClusterRefs = trackRefs.size() - mTrackRefs.size();
+
+  for (uint32_t i = 0; i < mClients.size(); i++) {
+    Client& client = mClients[i];
+    bool sendDelta = isDelta && client.synced;
+    const PacketHeader& header = sendDelta ? delta : full;
+    bool ok = sendAll(client.fd, &header, sizeof(header)) &&
+              sendAll(client.fd, clusters.data() + header.firstCluster, header.nClusters * sizeof(QuantPos)) &&
+              sendAll(client.fd, trackRefs.data() + (sendDelta ? mTrackRefs.size() : 0), header.nTrackClusterRefs * sizeof(uint32_t));
+    if (ok) {
+      client.synced = true;
+    } else {
+      close(client.fd);
+      mClients.erase(mClients.begin() + i--);
+    }
+  }
+  mClusters = std::move(clusters);
+  mTrackRefs = std::move(trackRefs);
+  mNTracks = nTracks;
+  mEventCount++;
+}
+
+#else // _WIN32
+
+int32_t GPUDisplayDeltaServer::startServer(int32_t port)
+{
+  GPUError("Remote display streaming not supported on Windows");
+  return 1;
+}
+void GPUDisplayDeltaServer::stopServer() {}
+void GPUDisplayDeltaServer::pollConnections() {}
+bool GPUDisplayDeltaServer::sendAll(int32_t fd, const void* data, size_t size) { return false; }
+void GPUDisplayDeltaServer::sendEvent(const float4* clusterPos, uint32_t nClusters, const GPUTrackingInOutPointers* ioPtrs) {}
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GPUDisplayDeltaServer.h
+/// \author David Rohr
+
+#ifndef GPUDISPLAYDELTASERVER_H
+#define GPUDISPLAYDELTASERVER_H
+
+#include "GPUCommonDef.h"
+#include <cstdint>
+#include <vector>
+
+namespace GPUCA_NAMESPACE::gpu
+{
+struct GPUTrackingInOutPointers;
+
+// Streams the event data shown by GPUDisplay to remote display clients over TCP.
+// Cluster positions are quantized to 16 bit fixed point in display coordinates, and a packet
+// carries only the clusters and tracks added since the previous packet when the previously sent
+// content is a prefix of the new one, so following a live run does not require pulling full
+// snapshots of every TF.
+class GPUDisplayDeltaServer
+{
+ public:
+  ~GPUDisplayDeltaServer() { stopServer(); }
+
+  static constexpr uint32_t MAGIC = 0x44555047; // "GPUD"
+  static constexpr uint32_t VERSION = 1;
+  static constexpr float QUANT_SCALE = 4096.f; // Quantization unit, int16_t range covers +-8 display units = +-800 cm
+
+  struct PacketHeader {
+    uint32_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t flags = 0;        // 1 = delta packet, contents append to the previously sent event
+    uint32_t eventCount = 0;   // Incremented once per event sent
+    uint32_t firstCluster = 0; // Index of the first cluster contained in this packet
+    uint32_t nClusters = 0;
+    uint32_t firstTrack = 0;
+    uint32_t nTracks = 0;
+    uint32_t nTrackClusterRefs = 0; // Number of uint32_t track entries following the clusters: per track the cluster count, then the cluster ids
+  };
+
+  struct QuantPos {
+    int16_t x, y, z;
+  };
+
+  int32_t startServer(int32_t port);
+  void stopServer();
+  bool active() const { return mListenFd != -1; }
+
+  // Send the current event, cluster positions in display coordinates as filled by GPUDisplay
+  void sendEvent(const float4* clusterPos, uint32_t nClusters, const GPUTrackingInOutPointers* ioPtrs);
+
+ private:
+  struct Client {
+    int32_t fd;
+    bool synced; // Received a full packet, eligible for delta packets
+  };
+
+  void pollConnections();
+  bool sendAll(int32_t fd, const void* data, size_t size);
+
+  int32_t mListenFd = -1;
+  std::vector<Client> mClients;
+  uint32_t mEventCount = 0;
+  std::vector<QuantPos> mClusters;  // Content of the last sent packet, for the delta prefix check
+  std::vector<uint32_t> mTrackRefs; // Track entries of the last sent packet
+  uint32_t mNTracks = 0;
+};
+} // namespace GPUCA_NAMESPACE::gpu
+
+#endif
@@ -273,4 +273,8 @@ void GPUDisplay::DrawGLScene_updateEventData()
     }
 #endif
   }
+
+  if (mDeltaServer.active()) {
+    mDeltaServer.sendEvent(mGlobalPos, mCurrentClusters, mIOPtrs);
+  }
 }
@@ -88,6 +88,7 @@ o2_gpu_add_kernel("GPUTPCGMMergerFinalize, step2"                     "GPUTPCGMM
 o2_gpu_add_kernel("GPUTPCGMMergerMergeLoopers, step0"                 "GPUTPCGMMergerGPU TPCMERGER"                           LB      simple)
 o2_gpu_add_kernel("GPUTPCGMMergerMergeLoopers, step1"                 "GPUTPCGMMergerGPU TPCMERGER"                           LB      simple)
 o2_gpu_add_kernel("GPUTPCGMMergerMergeLoopers, step2"                 "GPUTPCGMMergerGPU TPCMERGER"                           LB      simple)
+o2_gpu_add_kernel("GPUTPCGMMergerFilldEdxHist"                        "GPUTPCGMMergerGPU TPCMERGER"                           LB      simple)
 
 if(ALIGPU_BUILD_TYPE STREQUAL "O2" OR GPUCA_CONFIG_O2_EXTENSIONS)
 o2_gpu_add_kernel("GPUTPCGMO2Output, prepare"                         "= TPCMERGER"                                           LB      simple)
@@ -130,4 +131,5 @@ o2_gpu_add_kernel("GPUTPCCFDecodeZSDenseLink"                         "GPUTPCCFD
 o2_gpu_add_kernel("GPUTPCCFGather"                                    "="                                                     LB      single o2::tpc::ClusterNative* dest)
 o2_gpu_add_kernel("GPUTrackingRefitKernel, mode0asGPU"                "= GLOBALREFIT "                                        LB      simple)
 o2_gpu_add_kernel("GPUTrackingRefitKernel, mode1asTrackParCov"        "= GLOBALREFIT "                                        LB      simple)
+o2_gpu_add_kernel("GPUTrackingRefitKernel, sortTracks"                "= GLOBALREFIT "                                        NO      simple)
 endif()
@@ -160,10 +160,24 @@ int32_t BandMatrixSolver<0>::test(bool prn)
     auto stop = std::chrono::high_resolution_clock::now();
     duration += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
 
+    // solve the same systems once more through the factorization-reuse interface
+    double B2[n][d];
+    double B2type1[n][d];
+    for (int32_t i = 0; i < n; i++) {
+      for (int32_t k = 0; k < d; k++) {
+        B2[i][k] = B[i][k];
+        B2type1[i][k] = Btype1[i][k];
+      }
+    }
+    band.solveFor(&B2[0][0], d);
+    bandType1.solveForType1(&B2type1[0][0], d);
+
     for (int32_t i = 0; i < n; i++) {
       for (int32_t k = 0; k < d; k++) {
         double t = fabs(x[i][k] - band.B(i, k));
         double t1 = fabs(x[i][k] - bandType1.B(i, k));
+        t = std::max(t, fabs(x[i][k] - B2[i][k]));
+        t1 = std::max(t1, fabs(x[i][k] - B2type1[i][k]));
         if (!std::isfinite(t) || maxDiff < t) {
           maxDiff = t;
         }
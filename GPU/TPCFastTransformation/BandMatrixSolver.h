@@ -94,6 +94,14 @@ class BandMatrixSolver
   /// solve an equation of a special type
   void solveType1();
 
+  /// solve for a batch of additional right-hand sides b[N x bdim] (row-major),
+  /// reusing the factorization stored in mA by a previous solve().
+  /// The solution is returned in b.
+  void solveFor(double* b, int32_t bdim);
+
+  /// same as solveFor(), for a factorization stored by solveType1()
+  void solveForType1(double* b, int32_t bdim);
+
   /// Test the class functionality. Returns 1 when ok, 0 when not ok
   static int32_t test(bool prn = 0)
   {
@@ -107,6 +115,12 @@ class BandMatrixSolver
   template <int32_t nCols>
   void dioganalizeBlock(double A[], double b[]);
 
+  template <int32_t nRows>
+  void triangulateBlockB(const double AA[], double bb[], int32_t bdim);
+
+  template <int32_t nCols>
+  void dioganalizeBlockB(const double A[], double b[], int32_t bdim);
+
  private:
   int32_t mN = 0;
   int32_t mBdim = 0;
@@ -182,6 +196,49 @@ inline void BandMatrixSolver<BandWidthT>::dioganalizeBlock(double AA[], double b
   }
 }
 
+template <int32_t BandWidthT>
+template <int32_t nRows>
+inline void BandMatrixSolver<BandWidthT>::triangulateBlockB(const double AA[], double bb[], int32_t bdim)
+{
+  // the B part of triangulateBlock(), with the multipliers already stored in A
+  for (int32_t k = 0; k < bdim; k++) {
+    int32_t m = BandWidthT;
+    const double* A = AA;
+    double* b = bb;
+    for (int32_t rows = 0; rows < nRows; rows++) {
+      double bk = b[k];
+      for (int32_t i = 1; i < m; i++) {
+        b[bdim * i + k] -= A[i] * bk;
+      }
+      b[k] *= A[0]; // A[0] holds 1/a[0][0]
+      m--;
+      A += BandWidthT;
+      b += bdim;
+    }
+  }
+}
+
+template <int32_t BandWidthT>
+template <int32_t nCols>
+inline void BandMatrixSolver<BandWidthT>::dioganalizeBlockB(const double AA[], double bb[], int32_t bdim)
+{
+  // the B part of dioganalizeBlock(), with the multipliers already stored in A
+  for (int32_t k = 0; k < bdim; k++) {
+    int32_t rows = BandWidthT;
+    const double* A = AA;
+    double* b = bb;
+    for (int32_t col = 0; col < nCols; col++) {
+      double bk = b[k];
+      for (int32_t i = 1; i < rows; i++) {
+        b[-i * bdim + k] -= A[BandWidthT * (-i) + i] * bk;
+      }
+      A -= BandWidthT;
+      b -= bdim;
+      rows--;
+    }
+  }
+}
+
 template <int32_t BandWidthT>
 inline void BandMatrixSolver<BandWidthT>::solve()
 {
@@ -259,6 +316,69 @@ inline void BandMatrixSolver<BandWidthT>::solveType1()
   }
 }
 
+template <int32_t BandWidthT>
+inline void BandMatrixSolver<BandWidthT>::solveFor(double* b, int32_t bdim)
+{
+  /// Mirrors solve(), using the 1/pivot values and multipliers stored in mA
+
+  const int32_t stepA = BandWidthT;
+  // Upper Triangulization
+  {
+    int32_t k = 0;
+    const double* Ak = &mA[0];
+    double* bk = b;
+    for (; k < mN - BandWidthT; k += 1, Ak += stepA, bk += bdim) { // for each row k
+      triangulateBlockB<1>(Ak, bk, bdim);
+    }
+    // last m rows
+    triangulateBlockB<BandWidthT>(Ak, bk, bdim);
+  }
+
+  // Diagonalization
+  {
+    int32_t k = mN - 1;
+    const double* Ak = &mA[BandWidthT * k];
+    double* bk = b + bdim * k;
+    for (; k > BandWidthT - 1; k -= 1, Ak -= stepA, bk -= bdim) { // for each row k
+      dioganalizeBlockB<1>(Ak, bk, bdim);
+    }
+    // first m rows
+    dioganalizeBlockB<BandWidthT>(Ak, bk, bdim);
+  }
+}
+
+template <int32_t BandWidthT>
+inline void BandMatrixSolver<BandWidthT>::solveForType1(double* b, int32_t bdim)
+{
+  /// Mirrors solveType1(), using the 1/pivot values and multipliers stored in mA
+
+  const int32_t stepA = 2 * BandWidthT;
+  const int32_t stepB = 2 * bdim;
+  // Upper Triangulization
+  {
+    int32_t k = 0;
+    const double* Ak = &mA[0];
+    double* bk = b;
+    for (; k < mN - BandWidthT; k += 2, Ak += stepA, bk += stepB) { // for each row k
+      triangulateBlockB<2>(Ak, bk, bdim);
+    }
+    // last m rows
+    triangulateBlockB<BandWidthT>(Ak, bk, bdim);
+  }
+
+  // Diagonalization
+  {
+    int32_t k = mN - 1;
+    const double* Ak = &mA[BandWidthT * k];
+    double* bk = b + bdim * k;
+    for (; k > BandWidthT - 1; k -= 2, Ak -= stepA, bk -= stepB) { // for each row k
+      dioganalizeBlockB<2>(Ak, bk, bdim);
+    }
+    // first m rows
+    dioganalizeBlockB<BandWidthT>(Ak, bk, bdim);
+  }
+}
+
 } // namespace gpu
 } // namespace GPUCA_NAMESPACE
 
@@ -0,0 +1,114 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  Float16.h
+/// \brief Definition of Float16 class
+///
+/// \author  Sergey Gorbunov <sergey.gorbunov@cern.ch>
+
+#ifndef ALICEO2_GPUCOMMON_TPCFASTTRANSFORMATION_FLOAT16_H
+#define ALICEO2_GPUCOMMON_TPCFASTTRANSFORMATION_FLOAT16_H
+
+#include "GPUCommonDef.h"
+
+namespace GPUCA_NAMESPACE
+{
+namespace gpu
+{
+
+/// ==================================================================================================
+/// The class Float16 stores a float in the IEEE 754 half-precision format (1+5+10 bits).
+///
+/// It is a storage-only type for flat buffers: the values are expanded to float on every read.
+/// The conversions are done with plain bit manipulations, therefore they work identically
+/// on the host and on all GPU backends. The rounding is to the nearest, ties to even.
+/// Values outside of the half-precision range are stored as +/- infinity.
+///
+class Float16
+{
+ public:
+  Float16() CON_DEFAULT;
+
+  GPUd() Float16(float v) : mBits(compress(v)) {}
+
+  GPUd() Float16& operator=(float v)
+  {
+    mBits = compress(v);
+    return *this;
+  }
+
+  GPUd() operator float() const { return expand(mBits); }
+
+  /// get the stored bit pattern
+  GPUd() uint16_t getBits() const { return mBits; }
+
+  /// convert a float to the half-precision bit pattern
+  GPUd() static uint16_t compress(float v)
+  {
+    union {
+      float f;
+      uint32_t i;
+    } u = {v};
+    uint32_t bits = u.i;
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    bits &= 0x7fffffffu;
+    if (bits >= 0x7f800000u) { // infinity or NaN
+      return sign | ((bits > 0x7f800000u) ? 0x7e00u : 0x7c00u);
+    }
+    if (bits >= 0x47800000u) { // too large for half: store infinity
+      return sign | 0x7c00u;
+    }
+    if (bits >= 0x38800000u) { // normal half
+      bits += 0xfffu + ((bits >> 13) & 1u); // round to nearest, ties to even
+      return sign | ((bits - 0x38000000u) >> 13);
+    }
+    if (bits >= 0x33000000u) { // subnormal half
+      int32_t shift = 125 - (int32_t)(bits >> 23);
+      uint32_t mant = (bits & 0x7fffffu) | 0x800000u;
+      uint32_t h = mant >> (shift + 1);
+      uint32_t rest = mant & ((1u << (shift + 1)) - 1u);
+      uint32_t mid = 1u << shift;
+      if (rest > mid || (rest == mid && (h & 1u))) {
+        h++;
+      }
+      return sign | (uint16_t)h;
+    }
+    return sign; // underflows to +/- 0
+  }
+
+  /// expand a half-precision bit pattern to float
+  GPUd() static float expand(uint16_t h)
+  {
+    uint32_t sign = ((uint32_t)(h & 0x8000u)) << 16;
+    uint32_t em = h & 0x7fffu;
+    union {
+      uint32_t i;
+      float f;
+    } u;
+    if (em >= 0x7c00u) { // infinity or NaN
+      u.i = sign | 0x7f800000u | (((uint32_t)(em & 0x3ffu)) << 13);
+    } else if (em >= 0x0400u) { // normal half
+      u.i = sign | ((((em >> 10) + 112u) << 23) | (((uint32_t)(em & 0x3ffu)) << 13));
+    } else { // subnormal half or zero: the value is an exact multiple of 2^-24
+      u.f = em * 5.9604644775390625e-08f; // 2^-24
+      u.i |= sign;
+    }
+    return u.f;
+  }
+
+ private:
+  uint16_t mBits = 0; ///< the IEEE 754 half-precision bit pattern
+};
+
+} // namespace gpu
+} // namespace GPUCA_NAMESPACE
+
+#endif
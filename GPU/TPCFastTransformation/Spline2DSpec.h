@@ -245,8 +245,8 @@ class Spline2DSpec<DataT, YdimT, 0>
   }
 
   /// Get interpolated value for an inpYdim-dimensional S(u1,u2) using spline parameters Parameters.
-  template <SafetyLevel SafeT = SafetyLevel::kSafe>
-  GPUd() void interpolateUold(int32_t inpYdim, GPUgeneric() const DataT Parameters[],
+  template <SafetyLevel SafeT = SafetyLevel::kSafe, typename StorageT = DataT>
+  GPUd() void interpolateUold(int32_t inpYdim, GPUgeneric() const StorageT Parameters[],
                               DataT u1, DataT u2, GPUgeneric() DataT S[/*inpYdim*/]) const
   {
 
@@ -268,10 +268,10 @@ class Spline2DSpec<DataT, YdimT, 0>
     const typename TBase::Knot& knotU = mGridX1.template getKnot<SafetyLevel::kNotSafe>(iu);
     const typename TBase::Knot& knotV = mGridX2.template getKnot<SafetyLevel::kNotSafe>(iv);
 
-    const DataT* par00 = Parameters + (nu * iv + iu) * nYdim4; // values { {Y1,Y2,Y3}, {Y1,Y2,Y3}'v, {Y1,Y2,Y3}'u, {Y1,Y2,Y3}''vu } at {u0, v0}
-    const DataT* par10 = par00 + nYdim4;                       // values { ... } at {u1, v0}
-    const DataT* par01 = par00 + nYdim4 * nu;                  // values { ... } at {u0, v1}
-    const DataT* par11 = par01 + nYdim4;                       // values { ... } at {u1, v1}
+    const StorageT* par00 = Parameters + (nu * iv + iu) * nYdim4; // values { {Y1,Y2,Y3}, {Y1,Y2,Y3}'v, {Y1,Y2,Y3}'u, {Y1,Y2,Y3}''vu } at {u0, v0}
+    const StorageT* par10 = par00 + nYdim4;                       // values { ... } at {u1, v0}
+    const StorageT* par01 = par00 + nYdim4 * nu;                  // values { ... } at {u0, v1}
+    const StorageT* par11 = par01 + nYdim4;                       // values { ... } at {u1, v1}
 
     DataT Su0[maxYdim4]; // values { {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v0), {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v1) }, at u0
     DataT Du0[maxYdim4]; // derivatives {}'_u  at u0
@@ -310,8 +310,10 @@ class Spline2DSpec<DataT, YdimT, 0>
   }
 
   /// Get interpolated value for an inpYdim-dimensional S(u1,u2) using spline parameters Parameters.
-  template <SafetyLevel SafeT = SafetyLevel::kSafe>
-  GPUd() void interpolateU(int32_t inpYdim, GPUgeneric() const DataT Parameters[],
+  /// The parameters may be stored with a reduced precision (e.g. Float16),
+  /// they are expanded to DataT on the fly.
+  template <SafetyLevel SafeT = SafetyLevel::kSafe, typename StorageT = DataT>
+  GPUd() void interpolateU(int32_t inpYdim, GPUgeneric() const StorageT Parameters[],
                            DataT u1, DataT u2, GPUgeneric() DataT S[/*inpYdim*/]) const
   {
 
@@ -333,8 +335,8 @@ class Spline2DSpec<DataT, YdimT, 0>
     const typename TBase::Knot& knotU = mGridX1.template getKnot<SafetyLevel::kNotSafe>(iu);
     const typename TBase::Knot& knotV = mGridX2.template getKnot<SafetyLevel::kNotSafe>(iv);
 
-    const DataT* A = Parameters + (nu * iv + iu) * nYdim4; // values { {Y1,Y2,Y3}, {Y1,Y2,Y3}'v, {Y1,Y2,Y3}'u, {Y1,Y2,Y3}''vu } at {u0, v0}
-    const DataT* B = A + nYdim4 * nu;                      // values { ... } at {u0, v1}
+    const StorageT* A = Parameters + (nu * iv + iu) * nYdim4; // values { {Y1,Y2,Y3}, {Y1,Y2,Y3}'v, {Y1,Y2,Y3}'u, {Y1,Y2,Y3}''vu } at {u0, v0}
+    const StorageT* B = A + nYdim4 * nu;                      // values { ... } at {u0, v1}
 
     DataT dSl, dDl, dSr, dDr;
     mGridX1.getUderivatives(knotU, u, dSl, dDl, dSr, dDr);
@@ -431,16 +433,17 @@ class Spline2DSpec<DataT, YdimT, 1>
   ///  _______  Expert tools: interpolation with given nYdim and external Parameters _______
 
   /// Get interpolated value for an YdimT-dimensional S(u1,u2) using spline parameters Parameters.
-  template <SafetyLevel SafeT = SafetyLevel::kSafe>
-  GPUd() void interpolateU(GPUgeneric() const DataT Parameters[],
+  /// The parameters may be stored with a reduced precision (e.g. Float16).
+  template <SafetyLevel SafeT = SafetyLevel::kSafe, typename StorageT = DataT>
+  GPUd() void interpolateU(GPUgeneric() const StorageT Parameters[],
                            DataT u1, DataT u2, GPUgeneric() DataT S[/*nYdim*/]) const
   {
     TBase::template interpolateU<SafeT>(YdimT, Parameters, u1, u2, S);
   }
 
   /// Get interpolated value for an YdimT-dimensional S(u1,u2) using spline parameters Parameters.
-  template <SafetyLevel SafeT = SafetyLevel::kSafe>
-  GPUd() void interpolateUold(GPUgeneric() const DataT Parameters[],
+  template <SafetyLevel SafeT = SafetyLevel::kSafe, typename StorageT = DataT>
+  GPUd() void interpolateUold(GPUgeneric() const StorageT Parameters[],
                               DataT u1, DataT u2, GPUgeneric() DataT S[/*nYdim*/]) const
   {
     TBase::template interpolateUold<SafeT>(YdimT, Parameters, u1, u2, S);
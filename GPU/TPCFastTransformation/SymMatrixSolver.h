@@ -62,6 +62,11 @@ class SymMatrixSolver
   ///
   void solve();
 
+  /// solve A * X = b for a batch of additional right-hand sides b[N x nCols]
+  /// (row-major), reusing the factorization stored by a previous solve().
+  /// The solution is returned in b.
+  void solveFor(double* b, int32_t nCols);
+
   ///
   void print();
 
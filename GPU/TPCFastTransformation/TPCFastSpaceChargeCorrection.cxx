@@ -20,6 +20,7 @@
 #if !defined(GPUCA_GPUCODE)
 #include <iostream>
 #include <cmath>
+#include <vector>
 #include "Spline2DHelper.h"
 #endif
 
@@ -120,6 +121,8 @@ void TPCFastSpaceChargeCorrection::cloneFromObject(const TPCFastSpaceChargeCorre
   mSliceDataSizeBytes[1] = obj.mSliceDataSizeBytes[1];
   mSliceDataSizeBytes[2] = obj.mSliceDataSizeBytes[2];
 
+  mSplineDataType = obj.mSplineDataType;
+
   // variable-size data
   mRowInfoPtr = obj.mRowInfoPtr;
   mSliceRowInfoPtr = obj.mSliceRowInfoPtr;
@@ -212,6 +215,7 @@ void TPCFastSpaceChargeCorrection::print() const
   LOG(info) << "  mNumberOfScenarios = " << mNumberOfScenarios;
   LOG(info) << "  mTimeStamp = " << mTimeStamp;
   LOG(info) << "  mSliceDataSizeBytes = " << mSliceDataSizeBytes[0] << " " << mSliceDataSizeBytes[1] << " " << mSliceDataSizeBytes[2];
+  LOG(info) << "  mSplineDataType = " << ((mSplineDataType == DataTypeFloat16) ? "float16" : "float32");
   if (mRowInfoPtr) {
     LOG(info) << "  TPC rows: ";
     for (int32_t i = 0; i < mGeo.getNumberOfRows(); i++) {
@@ -235,7 +239,8 @@ void TPCFastSpaceChargeCorrection::print() const
         int32_t k = 0;
         for (int32_t i = 0; i < spline.getGridX1().getNumberOfKnots(); i++) {
           for (int32_t j = 0; j < spline.getGridX2().getNumberOfKnots(); j++, k++) {
-            LOG(info) << d[k] << " ";
+            float v = (mSplineDataType == DataTypeFloat16) ? (float)reinterpret_cast<const Float16*>(d)[k] : d[k];
+            LOG(info) << v << " ";
           }
           LOG(info) << "";
         }
@@ -453,6 +458,79 @@ void TPCFastSpaceChargeCorrection::constructWithNoCorrection(const TPCFastTransf
   setNoCorrection();
 }
 
+void TPCFastSpaceChargeCorrection::convertToHalfPrecision()
+{
+  /// Converts the spline coefficients to the half precision storage and rebuilds the flat buffer.
+  /// The part of the buffer before the spline data (row infos, spline scenarios) keeps its layout,
+  /// only the spline data region shrinks.
+
+  if (mSplineDataType == DataTypeFloat16) {
+    return;
+  }
+
+  assert(isConstructed() && isBufferInternal());
+
+  // calculate the new layout of the spline data
+
+  size_t headSize = (size_t)(mSplineData[0] - mFlatBufferPtr);
+
+  std::vector<size_t> newRowDataOffset[3];
+  size_t newSliceDataOffset[3];
+  size_t newSliceDataSize[3];
+  size_t newBufferSize = headSize;
+  for (int32_t is = 0; is < 3; is++) {
+    newSliceDataOffset[is] = alignSize(newBufferSize, SplineType::getParameterAlignmentBytes());
+    newRowDataOffset[is].resize(mGeo.getNumberOfRows());
+    size_t size = 0;
+    for (int32_t row = 0; row < mGeo.getNumberOfRows(); row++) {
+      newRowDataOffset[is][row] = alignSize(size, SplineType::getParameterAlignmentBytes());
+      size = newRowDataOffset[is][row] + sizeof(Float16) * getSpline(0, row).getNumberOfParameters();
+    }
+    newSliceDataSize[is] = alignSize(size, SplineType::getParameterAlignmentBytes());
+    newBufferSize = newSliceDataOffset[is] + newSliceDataSize[is] * mGeo.getNumberOfSlices();
+  }
+
+  // build the converted buffer image in a temporary array
+
+  std::vector<char> tmp(newBufferSize, 0);
+  memcpy(tmp.data(), mFlatBufferPtr, headSize);
+
+  for (int32_t is = 0; is < 3; is++) {
+    for (int32_t slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
+      for (int32_t row = 0; row < mGeo.getNumberOfRows(); row++) {
+        const float* src = getSplineData(slice, row, is);
+        Float16* dst = reinterpret_cast<Float16*>(tmp.data() + newSliceDataOffset[is] + newSliceDataSize[is] * slice + newRowDataOffset[is][row]);
+        int32_t nPar = getSpline(slice, row).getNumberOfParameters();
+        for (int32_t i = 0; i < nPar; i++) {
+          dst[i] = src[i];
+        }
+      }
+    }
+  }
+
+  // the row infos are stored at the beginning of the buffer, update the data offsets there
+
+  RowInfo* newRowInfos = reinterpret_cast<RowInfo*>(tmp.data());
+  for (int32_t row = 0; row < mGeo.getNumberOfRows(); row++) {
+    for (int32_t is = 0; is < 3; is++) {
+      newRowInfos[row].dataOffsetBytes[is] = newRowDataOffset[is][row];
+    }
+  }
+
+  // replace the flat buffer with the converted one
+
+  FlatObject::startConstruction();
+  FlatObject::finishConstruction(newBufferSize);
+  memcpy(mFlatBufferPtr, tmp.data(), newBufferSize);
+
+  for (int32_t is = 0; is < 3; is++) {
+    mSliceDataSizeBytes[is] = newSliceDataSize[is];
+  }
+  mSplineDataType = DataTypeFloat16;
+
+  setActualBufferAddress(mFlatBufferPtr);
+}
+
 double TPCFastSpaceChargeCorrection::testInverse(bool prn)
 {
   if (prn) {
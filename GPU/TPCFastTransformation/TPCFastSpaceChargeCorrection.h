@@ -18,6 +18,7 @@
 #define ALICEO2_GPUCOMMON_TPCFASTTRANSFORMATION_TPCFASTSPACECHARGECORRECTION_H
 
 #include "Spline2D.h"
+#include "Float16.h"
 #include "TPCFastTransformGeo.h"
 #include "FlatObject.h"
 #include "GPUCommonDef.h"
@@ -82,6 +83,12 @@ class TPCFastSpaceChargeCorrection : public FlatObject
 
   typedef Spline2D<float, 3> SplineType;
 
+  /// Storage type of the spline coefficients in the flat buffer
+  enum SplineDataType : int32_t {
+    DataTypeFloat32 = 0, ///< full precision
+    DataTypeFloat16 = 1  ///< IEEE half precision, expanded to float on the fly
+  };
+
   /// _____________  Constructors / destructors __________________________
 
   /// Default constructor: creates an empty uninitialized object
@@ -134,6 +141,13 @@ class TPCFastSpaceChargeCorrection : public FlatObject
 
   void constructWithNoCorrection(const TPCFastTransformGeo& geo);
 
+#if !defined(GPUCA_GPUCODE)
+  /// Converts the spline coefficients to the half precision storage, shrinking the flat buffer.
+  /// Has to be called on the host-side object owning its buffer, after the object is filled
+  /// and before any copy to the GPU. Does nothing when the data is already converted.
+  void convertToHalfPrecision();
+#endif
+
   /// _______________  Initialization interface  ________________________
 
   /// Set no correction
@@ -158,6 +172,9 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   /// Gives pointer to spline data
   GPUd() const float* getSplineData(int32_t slice, int32_t row, int32_t iSpline = 0) const;
 
+  /// Gives the storage type of the spline coefficients
+  GPUd() int32_t getSplineDataType() const { return mSplineDataType; }
+
   /// _______________ The main method: cluster correction  _______________________
   ///
   GPUd() int32_t getCorrection(int32_t slice, int32_t row, float u, float v, float& dx, float& du, float& dv) const;
@@ -275,10 +292,12 @@ class TPCFastSpaceChargeCorrection : public FlatObject
 
   size_t mSliceDataSizeBytes[3]; ///< size of the data for one slice in the flat buffer
 
+  int32_t mSplineDataType{DataTypeFloat32}; ///< storage type of the spline coefficients
+
   float fInterpolationSafetyMargin{0.1f}; // 10% area around the TPC row. Outside of this area the interpolation returns the boundary values.
 
 #ifndef GPUCA_ALIROOT_LIB
-  ClassDefNV(TPCFastSpaceChargeCorrection, 3);
+  ClassDefNV(TPCFastSpaceChargeCorrection, 4);
 #endif
 };
 
@@ -414,7 +433,11 @@ GPUdi() int32_t TPCFastSpaceChargeCorrection::getCorrection(int32_t slice, int32
   float gridU = 0, gridV = 0;
   convUVtoGrid(slice, row, u, v, gridU, gridV);
   float dxuv[3];
-  spline.interpolateU(splineData, gridU, gridV, dxuv);
+  if (mSplineDataType == DataTypeFloat16) {
+    spline.interpolateU(reinterpret_cast<const Float16*>(splineData), gridU, gridV, dxuv);
+  } else {
+    spline.interpolateU(splineData, gridU, gridV, dxuv);
+  }
   if (CAMath::Abs(dxuv[0]) > 100 || CAMath::Abs(dxuv[1]) > 100 || CAMath::Abs(dxuv[2]) > 100) {
     dxuv[0] = dxuv[1] = dxuv[2] = 0;
   }
@@ -431,7 +454,11 @@ GPUdi() int32_t TPCFastSpaceChargeCorrection::getCorrectionOld(int32_t slice, in
   float gridU = 0, gridV = 0;
   convUVtoGrid(slice, row, u, v, gridU, gridV);
   float dxuv[3];
-  spline.interpolateUold(splineData, gridU, gridV, dxuv);
+  if (mSplineDataType == DataTypeFloat16) {
+    spline.interpolateUold(reinterpret_cast<const Float16*>(splineData), gridU, gridV, dxuv);
+  } else {
+    spline.interpolateUold(splineData, gridU, gridV, dxuv);
+  }
   if (CAMath::Abs(dxuv[0]) > 100 || CAMath::Abs(dxuv[1]) > 100 || CAMath::Abs(dxuv[2]) > 100) {
     dxuv[0] = dxuv[1] = dxuv[2] = 0;
   }
@@ -450,7 +477,11 @@ GPUdi() void TPCFastSpaceChargeCorrection::getCorrectionInvCorrectedX(
   const Spline2D<float, 1>& spline = reinterpret_cast<const Spline2D<float, 1>&>(getSpline(slice, row));
   const float* splineData = getSplineData(slice, row, 1);
   float dx = 0;
-  spline.interpolateU(splineData, gridU, gridV, &dx);
+  if (mSplineDataType == DataTypeFloat16) {
+    spline.interpolateU(reinterpret_cast<const Float16*>(splineData), gridU, gridV, &dx);
+  } else {
+    spline.interpolateU(splineData, gridU, gridV, &dx);
+  }
   if (CAMath::Abs(dx) > 100) {
     dx = 0;
   }
@@ -467,7 +498,11 @@ GPUdi() void TPCFastSpaceChargeCorrection::getCorrectionInvUV(
   const float* splineData = getSplineData(slice, row, 2);
 
   float duv[2];
-  spline.interpolateU(splineData, gridU, gridV, duv);
+  if (mSplineDataType == DataTypeFloat16) {
+    spline.interpolateU(reinterpret_cast<const Float16*>(splineData), gridU, gridV, duv);
+  } else {
+    spline.interpolateU(splineData, gridU, gridV, duv);
+  }
   if (CAMath::Abs(duv[0]) > 100 || CAMath::Abs(duv[1]) > 100) {
     duv[0] = duv[1] = 0;
   }
@@ -117,6 +117,13 @@ class GeneratorPythia8 : public Generator
   /** Set the user hooks (defined in a Pythia8::UserHooks object) for
    * the event generator. */
   void setUserHooks(Pythia8::UserHooks* hooks);
+  /** Set the file with the serialized multiparton-interaction
+   * initialization state.  If the file exists, the expensive MPI
+   * initialization is restored from it instead of being recomputed;
+   * otherwise it is written there after a cold init, so that
+   * subsequent workers/jobs with the same settings start warm.
+   * Must be called before Init. */
+  void setReuseInitFile(std::string val) { mReuseInitFile = val; };
   /** @} */
 
   /** @{
@@ -272,6 +279,8 @@ class GeneratorPythia8 : public Generator
   /** Function in `mHooksFileName` to execute to return pointer to
    * Pythia8::UserHooks object */
   std::string mHooksFuncName;
+  /** File with the serialized MPI initialization state to reuse */
+  std::string mReuseInitFile;
   /** @} */
 
   UserFilterFcn mUserFilterFcn = [](Pythia8::Particle const&) -> bool { return true; };
@@ -59,6 +59,7 @@ GeneratorPythia8::GeneratorPythia8() : Generator("ALICEo2", "ALICEo2 Pythia8 Gen
   setConfig(param.config);
   setHooksFileName(param.hooksFileName);
   setHooksFuncName(param.hooksFuncName);
+  setReuseInitFile(param.reuseInitFile);
 }
 
 /*****************************************************************/
@@ -185,6 +186,22 @@ Bool_t GeneratorPythia8::Init()
       mPythia.setUserHooksPtr((Pythia8::UserHooksPtr)powhegHooks);
     }
   }
+  /** warm-state reuse of the expensive multiparton-interaction
+      initialization: with a file configured, Pythia restores the
+      serialized MPI tables from it when present and writes them out
+      after a cold init otherwise (reuseInit = 3 means "read if
+      possible, else save"), so only the first worker/job with a given
+      configuration pays the full initialization **/
+  if (!mReuseInitFile.empty()) {
+#if PYTHIA_VERSION_INTEGER >= 8307
+    LOG(info) << "Pythia8 MPI warm-state file: " << mReuseInitFile;
+    mPythia.readString("MultipartonInteractions:reuseInit = 3");
+    mPythia.readString("MultipartonInteractions:initFile = " + mReuseInitFile);
+#else
+    LOG(warning) << "MPI init-state reuse requires Pythia >= 8.307; ignoring " << mReuseInitFile;
+#endif
+  }
+
   /** initialise **/
   if (!mPythia.init()) {
     LOG(fatal) << "Failed to init \'Pythia8\': init returned with error";
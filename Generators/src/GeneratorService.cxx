@@ -44,6 +44,9 @@ void GeneratorService::initService(std::string const& genName,
   }
 
   mStack.setExternalMode(true);
+  // the service only ever produces generator-level events, so the stack can run in
+  // the pooled primaries-only mode (buffers reused across events, no transport bookkeeping)
+  mStack.setPrimariesOnlyMode(true);
   mPrimGen.Init();
 }
 
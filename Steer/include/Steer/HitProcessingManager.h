@@ -60,6 +60,11 @@ class HitProcessingManager
 
   void registerRunFunction(RunFunct_t&& f);
 
+  // distribute the registered run functions over n worker threads when running;
+  // the functions must be mutually independent (each one processing its own
+  // detector and owning its outputs); n <= 1 keeps the serial execution
+  void setRunFunctionConcurrency(int n) { mRunFunctionConcurrency = n; }
+
   // setup the run with ncollisions to treat
   // if -1 and only background chain will do number of entries in chain
   void setupRun(int ncollisions = -1);
@@ -92,6 +97,7 @@ class HitProcessingManager
 
   int mNumberOfCollisions; // how many collisions we want to generate and process
   bool mSampleCollisionsRandomly = false; // if we sample the sequence of event ids randomly (with possible repetition)
+  int mRunFunctionConcurrency = 1;        // how many worker threads execute the registered run functions
 
   std::vector<TChain*> mSimChains;
   // ClassDefOverride(HitProcessingManager, 0);
@@ -11,6 +11,8 @@
 
 #include "Steer/HitProcessingManager.h"
 #include <fairlogger/Logger.h>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <map>
 #include <iostream>
@@ -212,8 +214,27 @@ void HitProcessingManager::run()
 {
   setupRun();
   // sample other stuff
-  for (auto& f : mRegisteredRunFunctions) {
-    f(mDigitizationContext);
+  const int nworkers = std::min<int>(mRunFunctionConcurrency, mRegisteredRunFunctions.size());
+  if (nworkers <= 1) {
+    for (auto& f : mRegisteredRunFunctions) {
+      f(mDigitizationContext);
+    }
+    return;
+  }
+  // the registered functions are independent of each other (each one processes
+  // its own detector and owns its outputs), so they can be distributed over a
+  // small worker pool, all sharing the read-only digitization context
+  std::atomic<size_t> nextFunction{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nworkers; ++t) {
+    workers.emplace_back([this, &nextFunction]() {
+      for (size_t i = nextFunction++; i < mRegisteredRunFunctions.size(); i = nextFunction++) {
+        mRegisteredRunFunctions[i](mDigitizationContext);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
   }
 }
 
@@ -17,6 +17,7 @@
 #include "Steer/HitProcessingManager.h"
 #include <TFile.h>
 #include <TTree.h>
+#include <atomic>
 #include <string>
 
 namespace o2
@@ -49,6 +50,18 @@ BOOST_AUTO_TEST_CASE(HitProcessingTest)
 
   // setup run (without giving number of collision)
   mgr.setupRun(100);
+
+  // register a few independent "detector" functions and run them on a worker pool
+  std::atomic<int> nCalls{0};
+  for (int i = 0; i < 8; ++i) {
+    mgr.registerRunFunction([&nCalls](const o2::steer::DigitizationContext& context) {
+      BOOST_CHECK(context.getNCollisions() > 0);
+      nCalls++;
+    });
+  }
+  mgr.setRunFunctionConcurrency(4);
+  mgr.run();
+  BOOST_CHECK_EQUAL(nCalls.load(), 8);
 }
 } // namespace steer
 } // namespace o2
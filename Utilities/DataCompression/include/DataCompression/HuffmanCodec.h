@@ -32,6 +32,8 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream> // stringstream in configuration parsing
+#include <atomic>
+#include <thread>
 #include "CommonUtils/CompStream.h"
 
 namespace o2
@@ -194,6 +196,90 @@ class HuffmanCodec
     return true;
   }
 
+  /// Build the canonical decoding table of the coding model
+  ///
+  /// Must be called after the Huffman tree has been generated or loaded,
+  /// enables the fast decoding methods below.
+  /// @param tableBits  number of bits per table window, memory grows with 2^tableBits
+  bool makeDecodingTable(uint32_t tableBits = 16)
+  {
+    return mCodingModel.GenerateDecodingTable(tableBits);
+  }
+
+  /// Decode a value using the decoding table of the coding model
+  ///
+  /// Same interface as Decode, symbols are resolved with a single table probe
+  /// instead of a bit-by-bit tree walk.
+  template <typename ReturnType>
+  bool DecodeFast(ReturnType& v, code_type code, uint16_t& codeLength) const
+  {
+    v = mCodingModel.DecodeFast(code, codeLength);
+    return true;
+  }
+
+  /**
+   * @brief Descriptor of an independently encoded block of the payload
+   *
+   * Blocked payloads store the codes of consecutive symbol ranges in separate,
+   * word-aligned sections, so the sections can be decoded in parallel.
+   */
+  template <typename TargetType>
+  struct DecoderBlock {
+    const TargetType* payload = nullptr; // encoded words, bits packed MSB first
+    std::size_t payloadWords = 0;        // number of valid words in the payload
+    std::size_t nSymbols = 0;            // number of symbols encoded in the block
+    value_type* target = nullptr;        // preallocated output for at least nSymbols values
+  };
+
+  /// Decode a contiguous stream of encoded words via the decoding table
+  ///
+  /// The stream format corresponds to the output of DataDeflater, i.e. codes
+  /// packed MSB first into words of TargetType.
+  template <typename TargetType, typename InsertIterator>
+  std::size_t DecodeStream(const TargetType* stream, std::size_t nWords, std::size_t nSymbols, InsertIterator out) const
+  {
+    return mCodingModel.DecodeStream(stream, nWords, nSymbols, out);
+  }
+
+  /// Decode independently encoded blocks in parallel
+  ///
+  /// The blocks are distributed over the requested number of worker threads,
+  /// each block is decoded with the table based stream decoder.
+  /// @return total number of decoded symbols
+  template <typename TargetType>
+  std::size_t DecodeBlocks(const std::vector<DecoderBlock<TargetType>>& blocks, unsigned nThreads = std::thread::hardware_concurrency()) const
+  {
+    if (nThreads == 0) {
+      nThreads = 1;
+    }
+    if (nThreads > blocks.size()) {
+      nThreads = blocks.size();
+    }
+    std::atomic<std::size_t> blockIndex{0};
+    std::atomic<std::size_t> nDecoded{0};
+    auto worker = [&]() {
+      std::size_t decoded = 0;
+      for (std::size_t i = blockIndex++; i < blocks.size(); i = blockIndex++) {
+        const auto& block = blocks[i];
+        decoded += DecodeStream(block.payload, block.payloadWords, block.nSymbols, block.target);
+      }
+      nDecoded += decoded;
+    };
+    if (nThreads < 2) {
+      worker();
+    } else {
+      std::vector<std::thread> threads;
+      threads.reserve(nThreads);
+      for (unsigned i = 0; i < nThreads; i++) {
+        threads.emplace_back(worker);
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+    return nDecoded;
+  }
+
   /// Get the underlying coding model
   model_type const& getCodingModel() const
   {
@@ -331,6 +417,209 @@ class HuffmanModel : public _BASE
     return v;
   }
 
+  /// maximum number of symbols stored per decoding table entry
+  static constexpr uint16_t MaxTableSymbols = 3;
+
+  /**
+   * @brief Entry of the canonical decoding table
+   *
+   * Each entry describes the outcome of decoding a bit window of
+   * mDecodingTableBits bits: the completely decoded symbols together with the
+   * cumulated number of consumed bits after each of them. Windows starting
+   * with a code longer than the table width hold no symbol but the tree node
+   * reached after consuming the full window, the decoding continues bit by
+   * bit from there.
+   */
+  struct TableEntry {
+    value_type symbols[MaxTableSymbols];  // symbols completely contained in the window
+    uint8_t symbolBits[MaxTableSymbols];  // cumulated number of bits after each symbol
+    uint8_t nSymbols = 0;                 // number of valid symbols, 0 indicates continuation
+    const node_type* node = nullptr;      // subtree to continue in for codes longer than the window
+  };
+
+  /**
+   * @brief Build the table for fast decoding from the Huffman tree
+   *
+   * For every possible bit window of tableBits bits the decoded symbols (up
+   * to MaxTableSymbols per entry) are precalculated, so the stream decoding
+   * can consume several symbols per table probe instead of walking the tree
+   * bit by bit. Memory grows with 2^tableBits, the default of 16 bits keeps
+   * the table of the order of MB and resolves all codes of the typical
+   * detector alphabets in one probe.
+   *
+   * The table has to be regenerated whenever the tree changes, i.e. after
+   * GenerateHuffmanTree or read.
+   */
+  bool GenerateDecodingTable(uint32_t tableBits = 16)
+  {
+    mDecodingTable.clear();
+    mDecodingTableBits = 0;
+    if (mTreeNodes.size() == 0) {
+      return false;
+    }
+    const node_type* topNode = (*mTreeNodes.begin()).get();
+    if (topNode->getLeftChild() == nullptr) {
+      // degenerate tree of a single symbol, no meaningful code length
+      return false;
+    }
+    mDecodingTableBits = tableBits;
+    mDecodingTable.resize(std::size_t(1) << tableBits);
+    for (std::size_t index = 0; index < mDecodingTable.size(); index++) {
+      auto& entry = mDecodingTable[index];
+      const node_type* node = topNode;
+      uint32_t bitPos = 0;
+      while (true) {
+        if (node->getLeftChild() == nullptr) {
+          // complete symbol within the window, record it and start over
+          entry.symbols[entry.nSymbols] = _BASE::alphabet_type::getSymbol(node->getIndex());
+          entry.symbolBits[entry.nSymbols] = bitPos;
+          if (++entry.nSymbols == MaxTableSymbols) {
+            break;
+          }
+          node = topNode;
+          continue;
+        }
+        if (bitPos == tableBits) {
+          if (entry.nSymbols == 0) {
+            // the first code is longer than the window, decoding continues in the tree
+            entry.node = node;
+          }
+          break;
+        }
+        bool bit = false;
+        if (OrderMSB) { // compile time switch, bit order as in Decode
+          bit = (index >> (tableBits - 1 - bitPos)) & 0x1;
+        } else {
+          bit = (index >> bitPos) & 0x1;
+        }
+        ++bitPos;
+        if (bit) {
+          node = node->getLeftChild();
+        } else {
+          node = node->getRightChild();
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Decode bit pattern using the decoding table
+   *
+   * Same interface and semantics as Decode, but the symbol is resolved with
+   * a single table probe instead of a tree walk; only codes longer than the
+   * table width fall back to walking the remaining subtree. Requires a prior
+   * call to GenerateDecodingTable, falls back to Decode otherwise.
+   */
+  value_type DecodeFast(code_type code, uint16_t& codeLength) const
+  {
+    if (mDecodingTable.empty()) {
+      return Decode(code, codeLength);
+    }
+    codeLength = 0;
+    static_assert(OrderMSB, "table based decoding requires MSB first bit order");
+    const std::size_t index = ((code >> (code.size() - mDecodingTableBits)).to_ulong());
+    const auto& entry = mDecodingTable[index];
+    if (entry.nSymbols > 0) {
+      codeLength = entry.symbolBits[0];
+      return entry.symbols[0];
+    }
+    // code longer than the table width, continue bit by bit in the subtree
+    codeLength = mDecodingTableBits;
+    uint16_t codeMSB = code.size() - 1;
+    const node_type* node = entry.node;
+    while (node->getLeftChild() != nullptr) {
+      if (codeLength > codeMSB) {
+        throw std::range_error("code type length insufficient for Huffman tree length");
+      }
+      bool bit = code.test(codeMSB - codeLength);
+      ++codeLength;
+      if (bit) {
+        node = node->getLeftChild();
+      } else {
+        node = node->getRightChild();
+      }
+    }
+    return _BASE::alphabet_type::getSymbol(node->getIndex());
+  }
+
+  /**
+   * @brief Decode a contiguous stream of encoded words
+   *
+   * The stream is expected in the format produced by DataDeflater: codes
+   * packed MSB first into words of TargetType. Exactly nSymbols symbols are
+   * decoded into the output iterator using the decoding table, a 64 bit
+   * reservoir amortizes the per-word bit shuffling over several table probes.
+   *
+   * @param stream    pointer to the encoded words
+   * @param nWords    number of valid words in the stream
+   * @param nSymbols  number of symbols encoded in the stream
+   * @param out       output (insert) iterator for the decoded values
+   * @return number of decoded symbols
+   */
+  template <typename TargetType, typename InsertIterator>
+  std::size_t DecodeStream(const TargetType* stream, std::size_t nWords, std::size_t nSymbols, InsertIterator out) const
+  {
+    static_assert(OrderMSB, "table based decoding requires MSB first bit order");
+    static_assert(8 * sizeof(TargetType) <= 64, "the bit reservoir can hold at most one 64 bit word");
+    if (mDecodingTable.empty()) {
+      throw std::runtime_error("decoding table not initialized, call GenerateDecodingTable first");
+    }
+    constexpr uint32_t wordBits = 8 * sizeof(TargetType);
+    uint64_t reservoir = 0;
+    uint32_t reservoirBits = 0;
+    std::size_t wordIndex = 0;
+    auto refill = [&]() {
+      while (reservoirBits + wordBits <= 64 && wordIndex < nWords) {
+        reservoir |= static_cast<uint64_t>(stream[wordIndex++]) << (64 - wordBits - reservoirBits);
+        reservoirBits += wordBits;
+      }
+    };
+    auto consume = [&](uint32_t nBits) {
+      reservoir <<= nBits;
+      reservoirBits = nBits > reservoirBits ? 0 : reservoirBits - nBits;
+    };
+    std::size_t decoded = 0;
+    while (decoded < nSymbols) {
+      refill();
+      const auto& entry = mDecodingTable[reservoir >> (64 - mDecodingTableBits)];
+      if (entry.nSymbols > 0) {
+        // take no more symbols than requested, consume only the corresponding bits
+        uint32_t take = entry.nSymbols;
+        if (decoded + take > nSymbols) {
+          take = nSymbols - decoded;
+        }
+        for (uint32_t i = 0; i < take; i++) {
+          *out++ = entry.symbols[i];
+        }
+        decoded += take;
+        consume(entry.symbolBits[take - 1]);
+        continue;
+      }
+      // code longer than the table width, walk the remaining subtree
+      consume(mDecodingTableBits);
+      const node_type* node = entry.node;
+      while (node->getLeftChild() != nullptr) {
+        if (reservoirBits == 0) {
+          refill();
+          if (reservoirBits == 0 && wordIndex >= nWords) {
+            throw std::runtime_error("stream exhausted while decoding Huffman code");
+          }
+        }
+        bool bit = (reservoir >> 63) & 0x1;
+        consume(1);
+        if (bit) {
+          node = node->getLeftChild();
+        } else {
+          node = node->getRightChild();
+        }
+      }
+      *out++ = _BASE::alphabet_type::getSymbol(node->getIndex());
+      ++decoded;
+    }
+    return decoded;
+  }
+
   /**
    * 'less' functor used in the multiset for sorting in the order less
    * probable to more probable
@@ -376,6 +665,8 @@ class HuffmanModel : public _BASE
   bool GenerateHuffmanTree()
   {
     mLeaveNodes.clear();
+    mDecodingTable.clear();
+    mDecodingTableBits = 0;
 
     // probability model provides map of {symbol, weight}-pairs
     _BASE& model = *this;
@@ -509,6 +800,8 @@ class HuffmanModel : public _BASE
   {
     mLeaveNodes.clear();
     mTreeNodes.clear();
+    mDecodingTable.clear();
+    mDecodingTableBits = 0;
     int lineNo = -1;
     std::string node, left, right, parameters;
     std::set<int> nodeIndices;
@@ -658,6 +951,10 @@ class HuffmanModel : public _BASE
   std::vector<std::shared_ptr<node_type>> mLeaveNodes;
   // multiset, order determined by less functor working on pointers
   std::multiset<std::shared_ptr<node_type>, isless<std::shared_ptr<node_type>>> mTreeNodes;
+  // canonical decoding table, built on demand by GenerateDecodingTable
+  std::vector<TableEntry> mDecodingTable;
+  // number of bits per decoding table window
+  uint32_t mDecodingTableBits = 0;
 };
 
 } // namespace data_compression
@@ -18,6 +18,7 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <iomanip>
@@ -28,6 +29,7 @@
 #include <stdexcept> // exeptions, runtime_error
 #include "../include/DataCompression/dc_primitives.h"
 #include "../include/DataCompression/HuffmanCodec.h"
+#include "../include/DataCompression/DataDeflater.h"
 #include "CommonUtils/StringUtils.h"
 #include "DataGenerator.h"
 #include "Fifo.h"
@@ -226,5 +228,67 @@ BOOST_AUTO_TEST_CASE(test_HuffmanCodec_configuration)
   checkRandom(codec, dg);
 }
 
+BOOST_AUTO_TEST_CASE(test_HuffmanCodec_tableDecoding)
+{
+  auto setup = setupCodec();
+  auto& codec = setup.first;
+  auto& dg = setup.second;
+  auto const& huffmanmodel = codec.getCodingModel();
+  using ValueT = decltype(setup.first)::value_type;
+  using CodeT = decltype(setup.first)::code_type;
+
+  BOOST_REQUIRE(codec.makeDecodingTable(12));
+
+  // the table decoding must reproduce the tree decoding for every symbol
+  for (auto const& i : huffmanmodel) {
+    uint16_t codeLen = 0;
+    CodeT code;
+    codec.Encode(i.first, code, codeLen);
+    if (huffmanmodel.OrderMSB) {
+      code <<= (code.size() - codeLen);
+    }
+    uint16_t decodedLen = 0;
+    ValueT value;
+    codec.DecodeFast(value, code, decodedLen);
+    BOOST_CHECK_EQUAL(value, i.first);
+    BOOST_CHECK_EQUAL(decodedLen, codeLen);
+  }
+
+  // encode random values into word-aligned blocks as written by DataDeflater
+  // and decode the blocks in parallel
+  constexpr std::size_t nBlocks = 8;
+  constexpr std::size_t nRollsPerBlock = 10000;
+  std::vector<ValueT> values(nBlocks * nRollsPerBlock);
+  std::vector<std::vector<uint32_t>> payloads(nBlocks);
+  for (std::size_t block = 0; block < nBlocks; block++) {
+    DataDeflater<uint32_t> deflater;
+    auto writer = [&payload = payloads[block]](const uint32_t& word) {
+      payload.emplace_back(word);
+      return true;
+    };
+    for (std::size_t n = 0; n < nRollsPerBlock; n++) {
+      auto& value = values[block * nRollsPerBlock + n];
+      value = dg();
+      uint16_t codeLen = 0;
+      CodeT code;
+      codec.Encode(value, code, codeLen);
+      deflater.writeRaw(code.to_ulong(), codeLen, writer);
+    }
+    deflater.close(writer);
+  }
+
+  std::vector<ValueT> decoded(values.size());
+  std::vector<decltype(setup.first)::DecoderBlock<uint32_t>> blocks(nBlocks);
+  for (std::size_t block = 0; block < nBlocks; block++) {
+    blocks[block].payload = payloads[block].data();
+    blocks[block].payloadWords = payloads[block].size();
+    blocks[block].nSymbols = nRollsPerBlock;
+    blocks[block].target = decoded.data() + block * nRollsPerBlock;
+  }
+  auto nDecoded = codec.DecodeBlocks(blocks, 2);
+  BOOST_CHECK_EQUAL(nDecoded, values.size());
+  BOOST_CHECK(std::equal(values.begin(), values.end(), decoded.begin()));
+}
+
 } // namespace data_compression
 } // namespace o2
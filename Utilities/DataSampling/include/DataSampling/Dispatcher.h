@@ -67,13 +67,15 @@ class Dispatcher : public framework::Task
   DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy);
   header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
-  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output) const;
+  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output);
 
   std::string mName;
   DataSamplingHeader::DeviceIDType mDeviceID = "invalid";
   std::string mReconfigurationSource;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+  // payload bytes copied into sampled messages, to quantify the memory bandwidth spent on sampling
+  uint64_t mTotalBytesDispatched = 0;
 };
 
 } // namespace o2::utilities
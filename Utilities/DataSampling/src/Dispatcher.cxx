@@ -142,6 +142,7 @@ void Dispatcher::reportStats(Monitoring& monitoring) const
 
   monitoring.send(Metric{dispatcherTotalEvaluatedMessages, "Dispatcher_messages_evaluated", Verbosity::Prod}.addTag(tags::Key::Subsystem, tags::Value::DataSampling));
   monitoring.send(Metric{dispatcherTotalAcceptedMessages, "Dispatcher_messages_passed", Verbosity::Prod}.addTag(tags::Key::Subsystem, tags::Value::DataSampling));
+  monitoring.send(Metric{mTotalBytesDispatched, "Dispatcher_bytes_passed", Verbosity::Prod}.addTag(tags::Key::Subsystem, tags::Value::DataSampling));
 }
 
 DataSamplingHeader Dispatcher::prepareDataSamplingHeader(const DataSamplingPolicy& policy)
@@ -170,10 +171,15 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output)
 {
+  // The payload is copied into a new message. Sharing the input shared memory buffer with the
+  // subscribers instead would require holding a reference on the input message beyond the scope
+  // of this computation, which the DPL input API does not expose to tasks.
   const auto* inputHeader = DataRefUtils::getHeader<header::DataHeader*>(inputData);
-  dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  const auto payloadSize = DataRefUtils::getPayloadSize(inputData);
+  dataAllocator.snapshot(output, inputData.payload, payloadSize, inputHeader->payloadSerializationMethod);
+  mTotalBytesDispatched += payloadSize;
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
@@ -65,6 +65,8 @@ class FullHistoryMerger : public framework::Task
   int mObjectsMerged = 0;
   int mTotalUpdatesReceived = 0;
   int mUpdatesReceived = 0;
+  double mCycleProcessingTimeMs = 0.;
+  double mTotalProcessingTimeMs = 0.;
 
  private:
   void updateCache(const framework::DataRef& ref);
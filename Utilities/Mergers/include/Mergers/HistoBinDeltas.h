@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_HISTOBINDELTAS_H
+#define ALICEO2_HISTOBINDELTAS_H
+
+/// \file HistoBinDeltas.h
+/// \brief Definition of a sparse histogram delta shippable to O2 Mergers
+///
+/// \author Piotr Konopka, piotr.jan.konopka@cern.ch
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TNamed.h>
+
+#include "Mergers/MergeInterface.h"
+
+class TH1;
+
+namespace o2::mergers
+{
+
+/// \brief A sparse set of bin increments of a fixed-binning histogram.
+///
+/// Instead of shipping the full histogram every cycle, a producer can record the bins which
+/// changed since the last publication and ship only those. Since the class inherits
+/// MergeInterface, IntegratingMerger accumulates such deltas with the cheap sorted-list merge
+/// below, without ever materializing (or deserializing) the full histogram. The consumer
+/// reconstructs or updates the full histogram with unpackTo() / createHistogram().
+///
+/// Only histograms with fixed binning and without bin labels are supported; producers should
+/// fall back to shipping the full object otherwise.
+class HistoBinDeltas : public TNamed, public MergeInterface
+{
+ public:
+  /// number of statistics moments stored, large enough for TH1/TH2/TH3 (see TH1::GetStats)
+  static constexpr size_t NStats = 13;
+
+  HistoBinDeltas() = default;
+  /// capture the bin-by-bin difference between `current` and `reference` (all filled bins of
+  /// `current` when `reference` is nullptr); both must share class and binning
+  HistoBinDeltas(const TH1& current, const TH1* reference = nullptr);
+  ~HistoBinDeltas() override = default;
+
+  /// \brief Accumulate the deltas of `other` into this object (sorted-list merge of the bins).
+  void merge(MergeInterface* const other) override;
+
+  /// \brief Add the accumulated deltas into a full histogram with matching class and binning.
+  /// \return false (leaving the target untouched) if the histogram is not compatible
+  bool unpackTo(TH1* target) const;
+
+  /// \brief Build a new histogram from scratch and fill it with the accumulated deltas.
+  std::unique_ptr<TH1> createHistogram() const;
+
+  MergeInterface* cloneMovingWindow() const override { return new HistoBinDeltas(*this); }
+
+  /// \brief Check that the histogram has the class and binning the deltas were recorded from.
+  bool isCompatible(const TH1& histo) const;
+
+  size_t getNumberOfChangedBins() const { return mBinIndices.size(); }
+
+ private:
+  std::string mHistoClass{};           ///< class name of the source histogram
+  std::string mHistoTitle{};           ///< title of the source histogram
+  int mDimension = 0;                  ///< dimension of the source histogram
+  std::array<int, 3> mNBins{0, 0, 0};  ///< number of bins of the source histogram per axis
+  std::array<double, 3> mMin{};        ///< lower axis limits of the source histogram
+  std::array<double, 3> mMax{};        ///< upper axis limits of the source histogram
+  std::vector<int> mBinIndices{};      ///< global indices of the changed bins, in increasing order
+  std::vector<double> mContents{};     ///< content increments of the changed bins
+  std::vector<double> mSumw2{};        ///< sum-of-weights-squared increments (empty if not stored)
+  std::array<double, NStats> mStats{}; ///< increments of the statistics moments
+  double mEntries = 0.;                ///< increment of the number of entries
+
+  ClassDefOverride(HistoBinDeltas, 1);
+};
+
+} // namespace o2::mergers
+
+#endif // ALICEO2_HISTOBINDELTAS_H
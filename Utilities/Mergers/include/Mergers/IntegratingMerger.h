@@ -74,6 +74,8 @@ class IntegratingMerger : public framework::Task
   // stats
   int mTotalDeltasMerged = 0;
   int mDeltasMerged = 0;
+  double mCycleProcessingTimeMs = 0.;
+  double mTotalProcessingTimeMs = 0.;
 };
 
 } // namespace o2::mergers
@@ -26,6 +26,8 @@
 #include <Monitoring/MonitoringFactory.h>
 #include <InfoLogger/InfoLogger.hxx>
 
+#include <chrono>
+
 using namespace o2::header;
 using namespace o2::framework;
 using namespace std::chrono;
@@ -69,16 +71,20 @@ void FullHistoryMerger::run(framework::ProcessingContext& ctx)
   // we have to avoid mistaking the timer input with data inputs.
   auto* timerHeader = ctx.inputs().get("timer-publish").header;
 
+  auto updateStart = steady_clock::now();
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
       updateCache(ref);
       mUpdatesReceived++;
     }
   }
+  mCycleProcessingTimeMs += duration<double, std::milli>(steady_clock::now() - updateStart).count();
 
   if (ctx.inputs().isValid("timer-publish") && !mFirstObjectSerialized.first.empty()) {
     mCyclesSinceReset++;
+    auto mergeStart = steady_clock::now();
     mergeCache();
+    mCycleProcessingTimeMs += duration<double, std::milli>(steady_clock::now() - mergeStart).count();
     publish(ctx.outputs());
 
     if (mConfig.mergedObjectTimespan.value == MergedObjectTimespan::LastDifference ||
@@ -90,7 +96,9 @@ void FullHistoryMerger::run(framework::ProcessingContext& ctx)
 
 void FullHistoryMerger::endOfStream(framework::EndOfStreamContext& eosContext)
 {
+  auto mergeStart = steady_clock::now();
   mergeCache();
+  mCycleProcessingTimeMs += duration<double, std::milli>(steady_clock::now() - mergeStart).count();
   publish(eosContext.outputs());
 }
 
@@ -111,6 +119,8 @@ void FullHistoryMerger::clear()
   mObjectsMerged = 0;
   mTotalUpdatesReceived = 0;
   mUpdatesReceived = 0;
+  mCycleProcessingTimeMs = 0.;
+  mTotalProcessingTimeMs = 0.;
 }
 
 void FullHistoryMerger::updateCache(const DataRef& ref)
@@ -185,6 +195,7 @@ void FullHistoryMerger::mergeCache()
 
 void FullHistoryMerger::publish(framework::DataAllocator& allocator)
 {
+  auto publicationStart = steady_clock::now();
   if (std::holds_alternative<std::monostate>(mMergedObject)) {
     LOG(info) << "No objects received since start or reset, nothing to publish";
   } else if (object_store_helpers::snapshot(allocator, mSubSpec, mMergedObject)) {
@@ -196,13 +207,18 @@ void FullHistoryMerger::publish(framework::DataAllocator& allocator)
 
   mTotalObjectsMerged += mObjectsMerged;
   mTotalUpdatesReceived += mUpdatesReceived;
+  mCycleProcessingTimeMs += duration<double, std::milli>(steady_clock::now() - publicationStart).count();
+  mTotalProcessingTimeMs += mCycleProcessingTimeMs;
   mCollector->send({mTotalObjectsMerged, "total_objects_merged"}, monitoring::DerivedMetricMode::RATE);
   mCollector->send({mObjectsMerged, "objects_merged_since_last_publication"});
   mCollector->send({mTotalUpdatesReceived, "total_updates_received"}, monitoring::DerivedMetricMode::RATE);
   mCollector->send({mUpdatesReceived, "updates_received_since_last_publication"});
   mCollector->send({mCyclesSinceReset, "cycles_since_reset"});
+  mCollector->send({mCycleProcessingTimeMs, "processing_time_ms_since_last_publication"});
+  mCollector->send({mTotalProcessingTimeMs, "total_processing_time_ms"}, monitoring::DerivedMetricMode::RATE);
   mObjectsMerged = 0;
   mUpdatesReceived = 0;
+  mCycleProcessingTimeMs = 0.;
 }
 
 } // namespace o2::mergers
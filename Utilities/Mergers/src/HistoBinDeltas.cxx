@@ -0,0 +1,186 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HistoBinDeltas.cxx
+/// \brief Implementation of a sparse histogram delta shippable to O2 Mergers
+///
+/// \author Piotr Konopka, piotr.jan.konopka@cern.ch
+
+#include "Mergers/HistoBinDeltas.h"
+
+#include "Framework/Logger.h"
+
+#include <TClass.h>
+#include <TH1.h>
+
+#include <stdexcept>
+
+namespace o2::mergers
+{
+
+HistoBinDeltas::HistoBinDeltas(const TH1& current, const TH1* reference)
+  : TNamed(current.GetName(), current.GetTitle()),
+    mHistoClass(current.ClassName()),
+    mHistoTitle(current.GetTitle())
+{
+  if (reference != nullptr && (reference->IsA() != current.IsA() || reference->GetNcells() != current.GetNcells())) {
+    throw std::runtime_error(std::string("The reference histogram '") + reference->GetName() +
+                             "' does not match the class or binning of '" + current.GetName() + "'");
+  }
+
+  mDimension = current.GetDimension();
+  const TAxis* axes[3] = {current.GetXaxis(), current.GetYaxis(), current.GetZaxis()};
+  for (int i = 0; i < mDimension; i++) {
+    if (axes[i]->GetLabels() != nullptr || axes[i]->GetXbins()->GetSize() > 0) {
+      throw std::runtime_error(std::string("The histogram '") + current.GetName() +
+                               "' has bin labels or variable binning, cannot record bin deltas");
+    }
+    mNBins[i] = axes[i]->GetNbins();
+    mMin[i] = axes[i]->GetXmin();
+    mMax[i] = axes[i]->GetXmax();
+  }
+
+  // record the changed cells (in increasing index, as required by merge())
+  bool storeSumw2 = current.GetSumw2N() > 0;
+  for (int bin = 0; bin < current.GetNcells(); bin++) {
+    double delta = current.GetBinContent(bin) - (reference ? reference->GetBinContent(bin) : 0.);
+    double deltaW2 = storeSumw2 ? current.GetSumw2()->At(bin) - (reference ? reference->GetSumw2()->At(bin) : 0.) : 0.;
+    if (delta != 0. || deltaW2 != 0.) {
+      mBinIndices.push_back(bin);
+      mContents.push_back(delta);
+      if (storeSumw2) {
+        mSumw2.push_back(deltaW2);
+      }
+    }
+  }
+
+  std::array<double, NStats> refStats{};
+  current.GetStats(mStats.data());
+  if (reference != nullptr) {
+    reference->GetStats(refStats.data());
+  }
+  for (size_t i = 0; i < NStats; i++) {
+    mStats[i] -= refStats[i];
+  }
+  mEntries = current.GetEntries() - (reference ? reference->GetEntries() : 0.);
+}
+
+void HistoBinDeltas::merge(MergeInterface* const other)
+{
+  auto otherDeltas = dynamic_cast<const HistoBinDeltas* const>(other);
+  if (otherDeltas == nullptr) {
+    throw std::runtime_error("The object to be merged in does not inherit HistoBinDeltas");
+  }
+  if (mHistoClass.empty()) {
+    // this object is default-constructed (e.g. just deserialized as a merge target), take the other as-is
+    *this = *otherDeltas;
+    return;
+  }
+  if (otherDeltas->mHistoClass != mHistoClass || otherDeltas->mNBins != mNBins) {
+    throw std::runtime_error(std::string("The histogram deltas '") + otherDeltas->GetName() +
+                             "' do not match the class or binning of '" + GetName() + "'");
+  }
+
+  // merge the two sorted bin lists, summing the increments of common bins
+  bool storeSumw2 = !mSumw2.empty() || !otherDeltas->mSumw2.empty();
+  std::vector<int> binIndices{};
+  std::vector<double> contents{};
+  std::vector<double> sumw2{};
+  binIndices.reserve(mBinIndices.size() + otherDeltas->mBinIndices.size());
+  contents.reserve(binIndices.capacity());
+  if (storeSumw2) {
+    sumw2.reserve(binIndices.capacity());
+  }
+  auto w2At = [](const HistoBinDeltas& deltas, size_t i) { return deltas.mSumw2.empty() ? 0. : deltas.mSumw2[i]; };
+  size_t i = 0, j = 0;
+  while (i < mBinIndices.size() || j < otherDeltas->mBinIndices.size()) {
+    bool takeThis = j == otherDeltas->mBinIndices.size() ||
+                    (i < mBinIndices.size() && mBinIndices[i] <= otherDeltas->mBinIndices[j]);
+    bool takeOther = i == mBinIndices.size() ||
+                     (j < otherDeltas->mBinIndices.size() && otherDeltas->mBinIndices[j] <= mBinIndices[i]);
+    binIndices.push_back(takeThis ? mBinIndices[i] : otherDeltas->mBinIndices[j]);
+    contents.push_back((takeThis ? mContents[i] : 0.) + (takeOther ? otherDeltas->mContents[j] : 0.));
+    if (storeSumw2) {
+      sumw2.push_back((takeThis ? w2At(*this, i) : 0.) + (takeOther ? w2At(*otherDeltas, j) : 0.));
+    }
+    i += takeThis ? 1 : 0;
+    j += takeOther ? 1 : 0;
+  }
+  mBinIndices = std::move(binIndices);
+  mContents = std::move(contents);
+  mSumw2 = std::move(sumw2);
+
+  for (size_t k = 0; k < NStats; k++) {
+    mStats[k] += otherDeltas->mStats[k];
+  }
+  mEntries += otherDeltas->mEntries;
+}
+
+bool HistoBinDeltas::isCompatible(const TH1& histo) const
+{
+  if (mHistoClass != histo.ClassName() || mDimension != histo.GetDimension()) {
+    return false;
+  }
+  const TAxis* axes[3] = {histo.GetXaxis(), histo.GetYaxis(), histo.GetZaxis()};
+  for (int i = 0; i < mDimension; i++) {
+    if (axes[i]->GetNbins() != mNBins[i] || axes[i]->GetXmin() != mMin[i] || axes[i]->GetXmax() != mMax[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HistoBinDeltas::unpackTo(TH1* target) const
+{
+  if (target == nullptr || !isCompatible(*target)) {
+    return false;
+  }
+  if (!mSumw2.empty() && target->GetSumw2N() == 0) {
+    target->Sumw2();
+  }
+  for (size_t i = 0; i < mBinIndices.size(); i++) {
+    target->AddBinContent(mBinIndices[i], mContents[i]);
+    if (!mSumw2.empty()) {
+      target->GetSumw2()->AddAt(target->GetSumw2()->At(mBinIndices[i]) + mSumw2[i], mBinIndices[i]);
+    }
+  }
+  std::array<double, NStats> stats{};
+  target->GetStats(stats.data());
+  for (size_t i = 0; i < NStats; i++) {
+    stats[i] += mStats[i];
+  }
+  target->PutStats(stats.data());
+  target->SetEntries(target->GetEntries() + mEntries);
+  return true;
+}
+
+std::unique_ptr<TH1> HistoBinDeltas::createHistogram() const
+{
+  auto histoClass = TClass::GetClass(mHistoClass.c_str());
+  if (histoClass == nullptr || !histoClass->InheritsFrom(TH1::Class())) {
+    LOG(error) << "Cannot instantiate a histogram of class '" << mHistoClass << "'";
+    return nullptr;
+  }
+  std::unique_ptr<TH1> histo{static_cast<TH1*>(histoClass->New())};
+  histo->SetNameTitle(GetName(), mHistoTitle.c_str());
+  histo->SetDirectory(nullptr);
+  if (mDimension == 3) {
+    histo->SetBins(mNBins[0], mMin[0], mMax[0], mNBins[1], mMin[1], mMax[1], mNBins[2], mMin[2], mMax[2]);
+  } else if (mDimension == 2) {
+    histo->SetBins(mNBins[0], mMin[0], mMax[0], mNBins[1], mMin[1], mMax[1]);
+  } else {
+    histo->SetBins(mNBins[0], mMin[0], mMax[0]);
+  }
+  unpackTo(histo.get());
+  return histo;
+}
+
+} // namespace o2::mergers
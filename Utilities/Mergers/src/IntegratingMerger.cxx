@@ -26,6 +26,8 @@
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
 
+#include <chrono>
+
 using namespace o2::framework;
 
 namespace o2::mergers
@@ -60,6 +62,7 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   // we have to avoid mistaking the timer input with data inputs.
   auto* timerHeader = ctx.inputs().get("timer-publish").header;
 
+  auto mergingStart = std::chrono::steady_clock::now();
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
       auto other = object_store_helpers::extractObjectFrom(ref);
@@ -67,6 +70,7 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
       mDeltasMerged++;
     }
   }
+  mCycleProcessingTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mergingStart).count();
 
   if (ctx.inputs().isValid("timer-publish")) {
     finishCycle(ctx.outputs());
@@ -75,6 +79,7 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
 
 void IntegratingMerger::finishCycle(DataAllocator& outputs)
 {
+  auto cycleStart = std::chrono::steady_clock::now();
   mCyclesSinceReset++;
 
   if (mConfig.publishMovingWindow.value == PublishMovingWindow::Yes) {
@@ -94,10 +99,16 @@ void IntegratingMerger::finishCycle(DataAllocator& outputs)
     clear();
   }
 
+  mCycleProcessingTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cycleStart).count();
+  mTotalProcessingTimeMs += mCycleProcessingTimeMs;
+
   mCollector->send({mTotalDeltasMerged, "total_deltas_merged"}, monitoring::DerivedMetricMode::RATE);
   mCollector->send({mDeltasMerged, "deltas_merged_since_last_publication"});
   mCollector->send({mCyclesSinceReset, "cycles_since_reset"});
+  mCollector->send({mCycleProcessingTimeMs, "processing_time_ms_since_last_publication"});
+  mCollector->send({mTotalProcessingTimeMs, "total_processing_time_ms"}, monitoring::DerivedMetricMode::RATE);
   mDeltasMerged = 0;
+  mCycleProcessingTimeMs = 0.;
 }
 
 void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
@@ -138,6 +149,8 @@ void IntegratingMerger::clear()
   mCyclesSinceReset = 0;
   mTotalDeltasMerged = 0;
   mDeltasMerged = 0;
+  mCycleProcessingTimeMs = 0.;
+  mTotalProcessingTimeMs = 0.;
 }
 
 void IntegratingMerger::publishIntegral(framework::DataAllocator& allocator)
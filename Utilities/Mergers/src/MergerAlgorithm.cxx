@@ -33,6 +33,98 @@
 namespace o2::mergers::algorithm
 {
 
+namespace
+{
+
+/// checks that the two histograms have the same fixed binning without bin labels
+bool haveSameBinning(const TH1* target, const TH1* other)
+{
+  if (target->GetNcells() != other->GetNcells()) {
+    return false;
+  }
+  const TAxis* targetAxes[3] = {target->GetXaxis(), target->GetYaxis(), target->GetZaxis()};
+  const TAxis* otherAxes[3] = {other->GetXaxis(), other->GetYaxis(), other->GetZaxis()};
+  for (size_t i = 0; i < 3; i++) {
+    if (targetAxes[i]->GetLabels() != nullptr || otherAxes[i]->GetLabels() != nullptr ||
+        targetAxes[i]->GetXbins()->GetSize() > 0 || otherAxes[i]->GetXbins()->GetSize() > 0 ||
+        targetAxes[i]->GetNbins() != otherAxes[i]->GetNbins() ||
+        targetAxes[i]->GetXmin() != otherAxes[i]->GetXmin() ||
+        targetAxes[i]->GetXmax() != otherAxes[i]->GetXmax()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// adds the bin contents of `other` to `target` directly on the underlying arrays, bypassing
+/// the TList machinery and the axis comparisons of TH1::Merge; returns false (leaving the
+/// target untouched) when the preconditions for doing so are not met and the caller should
+/// fall back to TH1::Merge
+bool addBinsDirectly(TH1* target, TH1* other)
+{
+  // only the plain floating-point histograms are handled: the integer ones saturate in
+  // AddBinContent(), which a plain array addition would not reproduce, while profiles
+  // and other TH1 descendants carry extra state beyond the bin contents
+  const auto targetClass = target->IsA();
+  if (targetClass != TH1F::Class() && targetClass != TH1D::Class() &&
+      targetClass != TH2F::Class() && targetClass != TH2D::Class() &&
+      targetClass != TH3F::Class() && targetClass != TH3D::Class()) {
+    return false;
+  }
+  if (other == nullptr || target->IsA() != other->IsA() || other->TestBit(TH1::kIsAverage) ||
+      target->GetBuffer() != nullptr || other->GetBuffer() != nullptr ||
+      target->GetSumw2N() != other->GetSumw2N() ||
+      !haveSameBinning(target, other)) {
+    return false;
+  }
+
+  double* targetArray = nullptr;
+  const double* otherArray = nullptr;
+  float* targetArrayF = nullptr;
+  const float* otherArrayF = nullptr;
+  if (auto targetD = dynamic_cast<TArrayD*>(target)) {
+    targetArray = targetD->GetArray();
+    otherArray = dynamic_cast<TArrayD*>(other)->GetArray();
+  } else if (auto targetF = dynamic_cast<TArrayF*>(target)) {
+    targetArrayF = targetF->GetArray();
+    otherArrayF = dynamic_cast<TArrayF*>(other)->GetArray();
+  } else {
+    return false;
+  }
+
+  const int nCells = target->GetNcells();
+  if (targetArray != nullptr) {
+    for (int i = 0; i < nCells; i++) {
+      targetArray[i] += otherArray[i];
+    }
+  } else {
+    for (int i = 0; i < nCells; i++) {
+      targetArrayF[i] += otherArrayF[i];
+    }
+  }
+  if (target->GetSumw2N() > 0) {
+    double* targetSumw2 = target->GetSumw2()->GetArray();
+    const double* otherSumw2 = other->GetSumw2()->GetArray();
+    for (int i = 0; i < target->GetSumw2N(); i++) {
+      targetSumw2[i] += otherSumw2[i];
+    }
+  }
+
+  constexpr size_t nStats = 13; // large enough for TH1/TH2/TH3, see TH1::GetStats
+  double stats[nStats] = {0};
+  double otherStats[nStats] = {0};
+  target->GetStats(stats);
+  other->GetStats(otherStats);
+  for (size_t i = 0; i < nStats; i++) {
+    stats[i] += otherStats[i];
+  }
+  target->PutStats(stats);
+  target->SetEntries(target->GetEntries() + other->GetEntries());
+  return true;
+}
+
+} // namespace
+
 size_t estimateTreeSize(TTree* tree)
 {
   size_t totalSize = 0;
@@ -97,6 +189,8 @@ void merge(TObject* const target, TObject* const other)
         if (auto otherTH1 = dynamic_cast<TH1*>(otherCollection.First())) {
           errorCode = targetTH1->Add(otherTH1);
         }
+      } else if (addBinsDirectly(targetTH1, dynamic_cast<TH1*>(other))) {
+        // the common QC case of identical fixed binning without labels was added directly
       } else {
         // Add() does not support histograms with labels, thus we resort to Merge() by default
         errorCode = targetTH1->Merge(&otherCollection);
@@ -0,0 +1,169 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file test_HistoBinDeltas.cxx
+/// \brief A unit test of sparse histogram deltas and of the direct histogram addition
+///
+/// \author Piotr Konopka, piotr.jan.konopka@cern.ch
+
+#define BOOST_TEST_MODULE Test Utilities HistoBinDeltas
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "Mergers/HistoBinDeltas.h"
+#include "Mergers/MergerAlgorithm.h"
+
+#include <TH1.h>
+#include <TH2.h>
+
+#include <memory>
+
+using namespace o2::mergers;
+
+constexpr size_t bins = 10;
+constexpr size_t min = 0;
+constexpr size_t max = 10;
+
+static void checkHistosEqual(const TH1& h1, const TH1& h2)
+{
+  BOOST_REQUIRE_EQUAL(h1.GetNcells(), h2.GetNcells());
+  for (int bin = 0; bin < h1.GetNcells(); bin++) {
+    BOOST_CHECK_CLOSE(h1.GetBinContent(bin), h2.GetBinContent(bin), 0.0001);
+    BOOST_CHECK_CLOSE(h1.GetBinError(bin), h2.GetBinError(bin), 0.0001);
+  }
+  BOOST_CHECK_CLOSE(h1.GetEntries(), h2.GetEntries(), 0.0001);
+  BOOST_CHECK_CLOSE(h1.GetMean(), h2.GetMean(), 0.0001);
+  BOOST_CHECK_CLOSE(h1.GetStdDev(), h2.GetStdDev(), 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(DeltasRoundTrip)
+{
+  TH1F histo("histo", "histo", bins, min, max);
+  histo.Fill(2);
+  histo.Fill(2);
+  histo.Fill(5);
+  histo.Fill(-1); // underflow
+  histo.Fill(11); // overflow
+
+  HistoBinDeltas deltas(histo);
+  BOOST_CHECK_EQUAL(deltas.getNumberOfChangedBins(), 4);
+  BOOST_CHECK(deltas.isCompatible(histo));
+
+  auto rebuilt = deltas.createHistogram();
+  BOOST_REQUIRE(rebuilt != nullptr);
+  checkHistosEqual(histo, *rebuilt);
+}
+
+BOOST_AUTO_TEST_CASE(DeltasAgainstReference)
+{
+  TH1F reference("histo", "histo", bins, min, max);
+  reference.Fill(2);
+  reference.Fill(7);
+
+  TH1F current(reference);
+  current.Fill(2);
+  current.Fill(4);
+
+  HistoBinDeltas deltas(current, &reference);
+  BOOST_CHECK_EQUAL(deltas.getNumberOfChangedBins(), 2);
+
+  // applying the deltas on top of the reference restores the current state
+  TH1F target(reference);
+  BOOST_REQUIRE(deltas.unpackTo(&target));
+  checkHistosEqual(current, target);
+
+  // an incompatible histogram is left untouched
+  TH1F incompatible("histo", "histo", bins + 1, min, max);
+  BOOST_CHECK(!deltas.unpackTo(&incompatible));
+}
+
+BOOST_AUTO_TEST_CASE(DeltasMerging)
+{
+  TH1F histo1("histo", "histo", bins, min, max);
+  histo1.Fill(2);
+  histo1.Fill(3);
+  TH1F histo2("histo", "histo", bins, min, max);
+  histo2.Fill(3);
+  histo2.Fill(8);
+
+  HistoBinDeltas deltas1(histo1);
+  HistoBinDeltas deltas2(histo2);
+  deltas1.merge(&deltas2);
+  BOOST_CHECK_EQUAL(deltas1.getNumberOfChangedBins(), 3);
+
+  TH1F expected(histo1);
+  expected.Add(&histo2);
+  auto rebuilt = deltas1.createHistogram();
+  BOOST_REQUIRE(rebuilt != nullptr);
+  checkHistosEqual(expected, *rebuilt);
+}
+
+BOOST_AUTO_TEST_CASE(DeltasUnsupportedBinning)
+{
+  double edges[4] = {0., 1., 4., 10.};
+  TH1F variableBins("histo", "histo", 3, edges);
+  BOOST_CHECK_THROW(HistoBinDeltas{variableBins}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(DirectAddition)
+{
+  {
+    TH1F* target = new TH1F("obj1", "obj1", bins, min, max);
+    target->Fill(5);
+    TH1F* other = new TH1F("obj2", "obj2", bins, min, max);
+    other->Fill(2);
+    other->Fill(2);
+
+    TH1F expected(*target);
+    expected.Add(other);
+
+    BOOST_CHECK_NO_THROW(algorithm::merge(target, other));
+    checkHistosEqual(expected, *target);
+
+    delete other;
+    delete target;
+  }
+  {
+    // with per-bin errors stored
+    TH2D* target = new TH2D("obj1", "obj1", bins, min, max, bins, min, max);
+    target->Sumw2();
+    target->Fill(5., 5., 0.5);
+    TH2D* other = new TH2D("obj2", "obj2", bins, min, max, bins, min, max);
+    other->Sumw2();
+    other->Fill(2., 2., 1.5);
+    other->Fill(2., 2., 2.);
+
+    TH2D expected(*target);
+    expected.Add(other);
+
+    BOOST_CHECK_NO_THROW(algorithm::merge(target, other));
+    checkHistosEqual(expected, *target);
+
+    delete other;
+    delete target;
+  }
+  {
+    // integer histograms fall back to Merge()
+    TH1I* target = new TH1I("obj1", "obj1", bins, min, max);
+    target->Fill(5);
+    TH1I* other = new TH1I("obj2", "obj2", bins, min, max);
+    other->Fill(2);
+
+    BOOST_CHECK_NO_THROW(algorithm::merge(target, other));
+    BOOST_CHECK_EQUAL(target->GetBinContent(target->FindBin(2)), 1);
+    BOOST_CHECK_EQUAL(target->GetBinContent(target->FindBin(5)), 1);
+
+    delete other;
+    delete target;
+  }
+}
@@ -65,6 +65,14 @@ struct CoderPreset<CoderTag::AVX2> {
 };
 #endif
 
+#ifdef RANS_AVX512
+template <>
+struct CoderPreset<CoderTag::AVX512> {
+  inline static constexpr size_t nStreams = 16;
+  inline static constexpr size_t renormingLowerBound = internal::RenormingLowerBound;
+};
+#endif
+
 } // namespace defaults
 
 namespace internal
@@ -107,6 +115,15 @@ struct CoderTraits<CoderTag::AVX2> {
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <>
+struct CoderTraits<CoderTag::AVX512> {
+
+  template <size_t lowerBound_V = defaults::CoderPreset<CoderTag::AVX512>::renormingLowerBound>
+  using type = AVX512EncoderImpl<lowerBound_V>;
+};
+#endif /* RANS_AVX512 */
+
 template <CoderTag tag_V = defaults::DefaultTag, size_t lowerBound_V = defaults::CoderPreset<tag_V>::renormingLowerBound>
 using CoderTraits_t = typename CoderTraits<tag_V>::template type<lowerBound_V>;
 } // namespace internal
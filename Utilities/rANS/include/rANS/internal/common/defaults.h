@@ -29,14 +29,17 @@ namespace o2::rans
 enum class CoderTag : uint8_t { Compat,
                                 SingleStream,
                                 SSE,
-                                AVX2 };
+                                AVX2,
+                                AVX512 };
 
 using count_t = uint32_t;
 
 namespace defaults
 {
 
-#if defined(RANS_AVX2)
+#if defined(RANS_AVX512)
+inline constexpr o2::rans::CoderTag DefaultTag = o2::rans::CoderTag::AVX512;
+#elif defined(RANS_AVX2)
 inline constexpr o2::rans::CoderTag DefaultTag = o2::rans::CoderTag::AVX2;
 #elif defined(RANS_SSE_ONLY)
 inline constexpr o2::rans::CoderTag DefaultTag = o2::rans::CoderTag::SSE;
@@ -21,6 +21,9 @@
 #ifdef RANS_AVX2
 #error RANS_AVX2 cannot be directly set
 #endif
+#ifdef RANS_AVX512
+#error RANS_AVX512 cannot be directly set
+#endif
 #ifdef RANS_SSE
 #error RANS_SSE cannot be directly set
 #endif
@@ -54,6 +57,9 @@
 #if defined(__AVX2__)
 #define RANS_AVX2
 #endif // AVX2
+#if (defined(__AVX512F__) && defined(__AVX512DQ__))
+#define RANS_AVX512
+#endif // AVX512
 #endif // x86
 
 #if (defined(RANS_SSE) && !defined(RANS_AVX2))
@@ -350,6 +350,76 @@ class EncoderSymbolMapper<symbolTable_T,
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <size_t streamingLowerBound_V, typename symbolTable_T, typename incompressible_IT>
+class EncoderSymbolMapper<symbolTable_T,
+                          AVX512EncoderImpl<streamingLowerBound_V>,
+                          incompressible_IT> : public EncoderSymbolMapperInterface<symbolTable_T,
+                                                                                   AVX512EncoderImpl<streamingLowerBound_V>,
+                                                                                   incompressible_IT,
+                                                                                   EncoderSymbolMapper<symbolTable_T, incompressible_IT>>
+{
+  using base_type = EncoderSymbolMapperInterface<symbolTable_T, AVX512EncoderImpl<streamingLowerBound_V>, incompressible_IT, EncoderSymbolMapper<symbolTable_T, incompressible_IT>>;
+
+ public:
+  using symbolTable_type = typename base_type::symbolTable_type;
+  using coder_type = typename base_type::coder_type;
+  using size_type = typename base_type::size_type;
+  using difference_type = typename base_type::difference_type;
+  using source_type = typename base_type::source_type;
+  using symbol_type = typename base_type::symbol_type;
+  using coderSymbol_type = typename base_type::coderSymbol_type;
+  using incompressible_iterator = typename base_type::incompressible_iterator;
+
+  static_assert(coder_type::getNstreams() == 8);
+
+  EncoderSymbolMapper() = default;
+
+  EncoderSymbolMapper(const symbolTable_type& symbolTable, incompressible_IT incompressibleIter = nullptr) : base_type{symbolTable, incompressibleIter} {};
+
+  template <typename source_IT>
+  [[nodiscard]] inline source_IT unpackSymbols(source_IT sourceIter, coderSymbol_type& unpacked)
+  {
+    using namespace simd;
+    std::array<const Symbol*, 8> ret;
+    ret[7] = &this->lookupSymbol(sourceIter - 0);
+    ret[6] = &this->lookupSymbol(sourceIter - 1);
+    ret[5] = &this->lookupSymbol(sourceIter - 2);
+    ret[4] = &this->lookupSymbol(sourceIter - 3);
+    ret[3] = &this->lookupSymbol(sourceIter - 4);
+    ret[2] = &this->lookupSymbol(sourceIter - 5);
+    ret[1] = &this->lookupSymbol(sourceIter - 6);
+    ret[0] = &this->lookupSymbol(sourceIter - 7);
+
+    aosToSoa(gsl::make_span(ret), &unpacked.frequencies, &unpacked.cumulativeFrequencies);
+
+    return utils::advanceIter(sourceIter, -coder_type::getNstreams());
+  };
+
+  template <typename source_IT>
+  [[nodiscard]] inline source_IT unpackSymbols(source_IT sourceIter, coderSymbol_type& unpacked, size_type nActiveStreams)
+  {
+    using namespace internal::simd;
+
+    difference_type currentStream = nActiveStreams;
+
+    epi32_t<SIMDWidth::AVX> frequencies;
+    epi32_t<SIMDWidth::AVX> cumulativeFrequencies;
+
+    while (currentStream-- > 0) {
+      const auto& symbol = this->lookupSymbol(sourceIter--);
+      frequencies(currentStream) = symbol.getFrequency();
+      cumulativeFrequencies(currentStream) = symbol.getCumulative();
+    }
+
+    unpacked.frequencies = load(frequencies);
+    unpacked.cumulativeFrequencies = load(cumulativeFrequencies);
+
+    return sourceIter;
+  };
+};
+#endif /* RANS_AVX512 */
+
 } // namespace o2::rans::internal
 
 #endif /* RANS_INTERNAL_ENCODE_ENCODERSYMBOLMAPPER_H_ */
\ No newline at end of file
@@ -11,7 +11,7 @@
 
 /// @file   SIMDEncoderImpl.h
 /// @author Michael Lettrich
-/// @brief  rANS encoding operations that encode multiple symbols simultaniously using SIMD. Unified implementation for SSE4.1 and AVX2.
+/// @brief  rANS encoding operations that encode multiple symbols simultaniously using SIMD. Unified implementation for SSE4.1 and AVX2, masked implementation for AVX-512.
 
 #ifndef RANS_INTERNAL_ENCODE_SIMDENCODERIMPL_H_
 #define RANS_INTERNAL_ENCODE_SIMDENCODERIMPL_H_
@@ -216,6 +216,173 @@ using SSEEncoderImpl = SIMDEncoderImpl<streamingLowerBound_V, simd::SIMDWidth::S
 template <size_t streamingLowerBound_V>
 using AVXEncoderImpl = SIMDEncoderImpl<streamingLowerBound_V, simd::SIMDWidth::AVX>;
 
+#ifdef RANS_AVX512
+
+// 8 interleaved rANS states in a single 512 Bit register with mask-based renormalization.
+// Two interleaved instances cover the 16 logical streams of the SIMD coders, i.e. the
+// stream format stays identical to the one produced by the SSE and AVX2 implementations.
+template <size_t streamingLowerBound_V>
+class AVX512EncoderImpl : public EncoderImpl<simd::UnrolledSymbolsAVX512,
+                                             AVX512EncoderImpl<streamingLowerBound_V>>
+{
+  using base_type = EncoderImpl<simd::UnrolledSymbolsAVX512, AVX512EncoderImpl<streamingLowerBound_V>>;
+
+ public:
+  using stream_type = typename base_type::stream_type;
+  using state_type = typename base_type::state_type;
+  using symbol_type = typename base_type::symbol_type;
+  using size_type = typename base_type::size_type;
+  using difference_type = typename base_type::difference_type;
+
+  static_assert(streamingLowerBound_V <= 20, "SIMD coders are limited to 20 BIT precision because of their used of FP arithmeric");
+
+  [[nodiscard]] inline static constexpr size_type getNstreams() noexcept { return simd::getElementCount<state_type>(simd::SIMDWidth::AVX512); };
+
+  AVX512EncoderImpl(size_t symbolTablePrecision);
+  AVX512EncoderImpl() : AVX512EncoderImpl{0} {};
+
+  // Flushes the rANS encoder.
+  template <typename Stream_IT>
+  Stream_IT flush(Stream_IT outputIter);
+
+  template <typename Stream_IT>
+  Stream_IT putSymbols(Stream_IT outputIter, const symbol_type& encodeSymbols);
+
+  template <typename Stream_IT>
+  Stream_IT putSymbols(Stream_IT outputIter, const symbol_type& encodeSymbols, size_t nActiveStreams);
+
+  [[nodiscard]] inline static constexpr state_type getStreamingLowerBound() noexcept { return static_cast<state_type>(utils::pow2(streamingLowerBound_V)); };
+
+ private:
+  size_t mSymbolTablePrecision{};
+  simd::simdI_t<simd::SIMDWidth::AVX512> mStates{};
+  simd::simdD_t<simd::SIMDWidth::AVX512> mNSamples{};
+
+  template <typename Stream_IT>
+  Stream_IT putSymbol(Stream_IT outputIter, const Symbol& symbol, state_type& state);
+
+  template <typename Stream_IT>
+  Stream_IT flushState(state_type& state, Stream_IT outputIter);
+
+  // Renormalize the encoder.
+  template <typename Stream_IT>
+  std::tuple<state_type, Stream_IT> renorm(state_type state, Stream_IT outputIter, uint32_t frequency);
+
+  inline static constexpr state_type LowerBound = utils::pow2(streamingLowerBound_V); // lower bound of our normalization interval
+
+  inline static constexpr state_type StreamBits = utils::toBits<stream_type>(); // lower bound of our normalization interval
+};
+
+template <size_t streamingLowerBound_V>
+AVX512EncoderImpl<streamingLowerBound_V>::AVX512EncoderImpl(size_t symbolTablePrecision) : mSymbolTablePrecision{symbolTablePrecision}, mStates{}, mNSamples{}
+{
+  if (mSymbolTablePrecision > LowerBound) {
+    throw HistogramError(fmt::format("SymbolTable Precision of {} Bits is larger than allowed by the rANS Encoder (max {} Bits)", mSymbolTablePrecision, LowerBound));
+  }
+
+  mStates = simd::setAll<simd::SIMDWidth::AVX512>(LowerBound);
+  mNSamples = simd::setAll<simd::SIMDWidth::AVX512>(static_cast<double>(utils::pow2(mSymbolTablePrecision)));
+};
+
+template <size_t streamingLowerBound_V>
+template <typename Stream_IT>
+Stream_IT AVX512EncoderImpl<streamingLowerBound_V>::flush(Stream_IT iter)
+{
+  using namespace simd;
+  epi64_t<SIMDWidth::AVX512> states = store<uint64_t>(mStates);
+
+  Stream_IT streamPos = iter;
+  for (size_t stateIdx = states.nElements(); stateIdx-- > 0;) {
+    streamPos = flushState(*(states.data() + stateIdx), streamPos);
+  }
+
+  mStates = load(states);
+
+  return streamPos;
+};
+
+template <size_t streamingLowerBound_V>
+template <typename Stream_IT>
+inline Stream_IT AVX512EncoderImpl<streamingLowerBound_V>::putSymbols(Stream_IT outputIter, const symbol_type& symbols)
+{
+  using namespace simd;
+
+  simdI_t<SIMDWidth::AVX512> renormedStates;
+  auto streamPosition = ransRenorm<Stream_IT, LowerBound, StreamBits>(mStates,
+                                                                      symbols.frequencies,
+                                                                      static_cast<uint8_t>(mSymbolTablePrecision),
+                                                                      outputIter,
+                                                                      &renormedStates);
+  mStates = ransEncode(renormedStates, int32ToDouble<SIMDWidth::AVX512>(symbols.frequencies), int32ToDouble<SIMDWidth::AVX512>(symbols.cumulativeFrequencies), mNSamples);
+
+  return streamPosition;
+}
+
+template <size_t streamingLowerBound_V>
+template <typename Stream_IT>
+Stream_IT AVX512EncoderImpl<streamingLowerBound_V>::putSymbols(Stream_IT outputIter, const symbol_type& symbols, size_t nActiveStreams)
+{
+  using namespace simd;
+
+  Stream_IT streamPos = outputIter;
+
+  epi64_t<SIMDWidth::AVX512> states = store<uint64_t>(mStates);
+
+  epi32_t<SIMDWidth::AVX> frequencies = store<uint32_t>(symbols.frequencies);
+  epi32_t<SIMDWidth::AVX> cumulativeFrequencies = store<uint32_t>(symbols.cumulativeFrequencies);
+
+  for (size_t i = nActiveStreams; i-- > 0;) {
+    Symbol encodeSymbol{frequencies(i), cumulativeFrequencies(i)};
+    streamPos = putSymbol(streamPos, encodeSymbol, states(i));
+  }
+
+  mStates = load(states);
+
+  return streamPos;
+};
+
+template <size_t streamingLowerBound_V>
+template <typename Stream_IT>
+Stream_IT AVX512EncoderImpl<streamingLowerBound_V>::putSymbol(Stream_IT outputIter, const Symbol& symbol, state_type& state)
+{
+  assert(symbol.getFrequency() != 0); // can't encode symbol with freq=0
+  // renormalize
+  const auto [x, streamPos] = renorm(state, outputIter, symbol.getFrequency());
+
+  // x = C(s,x)
+  state = ((x / symbol.getFrequency()) << mSymbolTablePrecision) + (x % symbol.getFrequency()) + symbol.getCumulative();
+  return streamPos;
+}
+
+template <size_t streamingLowerBound_V>
+template <typename Stream_IT>
+Stream_IT AVX512EncoderImpl<streamingLowerBound_V>::flushState(state_type& state, Stream_IT streamPosition)
+{
+  *streamPosition = static_cast<stream_type>(state >> 32);
+  ++streamPosition;
+  *streamPosition = static_cast<stream_type>(state >> 0);
+  ++streamPosition;
+
+  state = 0;
+  return streamPosition;
+}
+
+template <size_t streamingLowerBound_V>
+template <typename Stream_IT>
+inline auto AVX512EncoderImpl<streamingLowerBound_V>::renorm(state_type state, Stream_IT outputIter, uint32_t frequency) -> std::tuple<state_type, Stream_IT>
+{
+  state_type maxState = ((LowerBound >> mSymbolTablePrecision) << StreamBits) * frequency; // this turns into a shift.
+  if (state >= maxState) {
+    *outputIter = static_cast<stream_type>(state);
+    ++outputIter;
+    state >>= StreamBits;
+    assert(state < maxState);
+  }
+  return std::make_tuple(state, outputIter);
+};
+
+#endif /* RANS_AVX512 */
+
 } // namespace o2::rans::internal
 
 #endif /* RANS_SIMD */
@@ -11,7 +11,7 @@
 
 /// @file   Encoder.h
 /// @author Michael Lettrich
-/// @brief  Kernels performing SIMD rANS encoding using SSE 4.1 and AVX2.
+/// @brief  Kernels performing SIMD rANS encoding using SSE 4.1, AVX2 and AVX-512.
 
 #ifndef RANS_INTERNAL_ENCODE_SIMDKERNEL_H_
 #define RANS_INTERNAL_ENCODE_SIMDKERNEL_H_
@@ -80,6 +80,29 @@ inline __m256i ransEncode(__m256i state, __m256d frequency, __m256d cumulative,
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+
+//
+// rans Encode
+//
+inline __m512i ransEncode(__m512i state, __m512d frequency, __m512d cumulative, __m512d normalization) noexcept
+{
+#if !defined(NDEBUG)
+  auto vec = store<uint64_t>(state);
+  for (auto i : gsl::make_span(vec)) {
+    assert(i < utils::pow2(52));
+  }
+#endif
+
+  auto [div, mod] = divMod(uint64ToDouble(state), frequency);
+  auto newState = _mm512_fmadd_pd(normalization, div, cumulative);
+  newState = _mm512_add_pd(newState, mod);
+
+  return doubleToUint64(newState);
+};
+
+#endif /* RANS_AVX512 */
+
 inline void aosToSoa(gsl::span<const Symbol*, 2> in, __m128i* __restrict__ frequency, __m128i* __restrict__ cumulatedFrequency) noexcept
 {
   __m128i in0Reg = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in[0]->data()));
@@ -102,6 +125,24 @@ inline void aosToSoa(gsl::span<const Symbol*, 4> in, __m128i* __restrict__ frequ
   *cumulatedFrequency = _mm_unpackhi_epi64(merged0Reg, merged1Reg);
 };
 
+#ifdef RANS_AVX512
+
+inline void aosToSoa(gsl::span<const Symbol*, 8> in, __m256i* __restrict__ frequency, __m256i* __restrict__ cumulatedFrequency) noexcept
+{
+  __m128i frequencyLo;
+  __m128i frequencyHi;
+  __m128i cumulatedFrequencyLo;
+  __m128i cumulatedFrequencyHi;
+
+  aosToSoa(gsl::span<const Symbol*, 4>{in.template subspan<0, 4>()}, &frequencyLo, &cumulatedFrequencyLo);
+  aosToSoa(gsl::span<const Symbol*, 4>{in.template subspan<4, 4>()}, &frequencyHi, &cumulatedFrequencyHi);
+
+  *frequency = _mm256_set_m128i(frequencyHi, frequencyLo);
+  *cumulatedFrequency = _mm256_set_m128i(cumulatedFrequencyHi, cumulatedFrequencyLo);
+};
+
+#endif /* RANS_AVX512 */
+
 template <SIMDWidth width_V, uint64_t lowerBound_V, uint8_t streamBits_V>
 inline auto computeMaxState(__m128i frequencyVec, uint8_t symbolTablePrecisionBits) noexcept
 {
@@ -140,6 +181,27 @@ inline __m256i computeNewState(__m256i stateVec, __m256i cmpVec) noexcept
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+
+template <SIMDWidth width_V, uint64_t lowerBound_V, uint8_t streamBits_V>
+inline __m512i computeMaxState(__m256i frequencyVec, uint8_t symbolTablePrecisionBits) noexcept
+{
+  static_assert(width_V == SIMDWidth::AVX512);
+  const uint64_t xmax = (lowerBound_V >> symbolTablePrecisionBits) << streamBits_V;
+  const uint8_t shift = log2UIntNZ(xmax);
+  __m512i frequencyVecEpi64 = _mm512_cvtepi32_epi64(frequencyVec);
+  return _mm512_slli_epi64(frequencyVecEpi64, shift);
+};
+
+template <uint8_t streamBits_V>
+inline __m512i computeNewState(__m512i stateVec, __mmask8 cmpMask) noexcept
+{
+  // newState = (state >= maxState) ? state >> streamBits_V : state
+  return _mm512_mask_srli_epi64(stateVec, cmpMask, stateVec, streamBits_V);
+};
+
+#endif /* RANS_AVX512 */
+
 inline constexpr std::array<epi8_t<SIMDWidth::SSE>, 16>
   SSEStreamOutLUT{{
     {0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8, 0xFF_u8}, // 0b0000   0xFFFFu, //0b0000
@@ -470,6 +532,41 @@ inline StreamOutResult<SIMDWidth::AVX> streamOut(const __m256i* __restrict__ sta
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+
+// bit-reversal of an 8 bit renormalization mask, needed to emit the
+// lower 32 bits of the renormalizing states with the highest stream first
+inline constexpr std::array<uint8_t, 256> AVX512MaskReverseLUT = []() constexpr {
+  std::array<uint8_t, 256> lut{};
+  for (size_t i = 0; i < lut.size(); ++i) {
+    uint8_t reversed = 0;
+    for (size_t bit = 0; bit < 8; ++bit) {
+      reversed |= ((i >> bit) & 0x1u) << (7 - bit);
+    }
+    lut[i] = reversed;
+  }
+  return lut;
+}();
+
+template <>
+struct StreamOutResult<SIMDWidth::AVX512> {
+  uint32_t nElemens;
+  __m256i streamOutVec;
+};
+
+inline StreamOutResult<SIMDWidth::AVX512> streamOut(__m512i stateVec, __mmask8 cmpMask) noexcept
+{
+  // reverse the states so that the masked compression emits the highest stream first
+  const __m512i reversedStates = _mm512_permutexvar_epi64(_mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), stateVec);
+  const __m256i lowerWords = _mm512_cvtepi64_epi32(reversedStates);
+  const __mmask16 reversedMask = AVX512MaskReverseLUT[cmpMask];
+  const __m512i streamOutVec = _mm512_maskz_compress_epi32(reversedMask, _mm512_castsi256_si512(lowerWords));
+
+  return {static_cast<uint32_t>(_mm_popcnt_u32(cmpMask)), _mm512_castsi512_si256(streamOutVec)};
+};
+
+#endif /* RANS_AVX512 */
+
 template <SIMDWidth, typename output_IT>
 struct RenormResult;
 
@@ -487,6 +584,14 @@ struct RenormResult<SIMDWidth::AVX, output_IT> {
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <typename output_IT>
+struct RenormResult<SIMDWidth::AVX512, output_IT> {
+  output_IT outputIter;
+  __m512i newState;
+};
+#endif /* RANS_AVX512 */
+
 template <typename output_IT, uint64_t lowerBound_V, uint8_t streamBits_V>
 inline output_IT ransRenorm(const __m128i* __restrict__ state, const __m128i* __restrict__ frequency, uint8_t symbolTablePrecisionBits, output_IT outputIter, __m128i* __restrict__ newState) noexcept
 {
@@ -551,11 +656,45 @@ inline output_IT ransRenorm(const __m256i* state, const __m128i* __restrict__ fr
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <typename output_IT, uint64_t lowerBound_V, uint8_t streamBits_V>
+inline output_IT ransRenorm(__m512i state, __m256i frequency, uint8_t symbolTablePrecisionBits, output_IT outputIter, __m512i* __restrict__ newState) noexcept
+{
+  // calculate maximum state
+  const __m512i maxState = computeMaxState<SIMDWidth::AVX512, lowerBound_V, streamBits_V>(frequency, symbolTablePrecisionBits);
+  // cmp = (state >= maxState)
+  const __mmask8 cmpMask = _mm512_cmpge_epu64_mask(state, maxState);
+  // newState = (state >= maxState) ? state >> streamBits_V : state
+  *newState = computeNewState<streamBits_V>(state, cmpMask);
+
+  auto [nStreamOutWords, streamOutResult] = streamOut(state, cmpMask);
+  if constexpr (std::is_pointer_v<output_IT>) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(outputIter), streamOutResult);
+    outputIter += nStreamOutWords;
+  } else {
+    auto result = store<uint32_t>(streamOutResult);
+    for (size_t i = 0; i < nStreamOutWords; ++i) {
+      *outputIter = result(i);
+      ++outputIter;
+    }
+  }
+
+  return outputIter;
+};
+#endif /* RANS_AVX512 */
+
 struct UnrolledSymbols {
   __m128i frequencies[2];
   __m128i cumulativeFrequencies[2];
 };
 
+#ifdef RANS_AVX512
+struct UnrolledSymbolsAVX512 {
+  __m256i frequencies;
+  __m256i cumulativeFrequencies;
+};
+#endif /* RANS_AVX512 */
+
 } // namespace o2::rans::internal::simd
 
 #endif /* RANS_SIMD */
@@ -16,6 +16,7 @@
 #ifndef RANS_INTERNAL_METRICS_SIZEESTIMATE_H_
 #define RANS_INTERNAL_METRICS_SIZEESTIMATE_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <cmath>
 
@@ -61,8 +62,11 @@ class SizeEstimate
   [[nodiscard]] size_t getIncompressibleSize(double_t safetyFactor = 1.2) const;
   template <typename T = uint8_t>
   [[nodiscard]] size_t getPackedDatasetSize(double_t safetyFactor = 1) const;
+  template <typename T = uint8_t>
+  [[nodiscard]] size_t getRawDatasetSize(double_t safetyFactor = 1) const;
 
   [[nodiscard]] inline bool preferPacking(double_t weight = 1) const;
+  [[nodiscard]] inline bool preferPassthrough(double_t weight = 1) const;
 
  private:
   size_t mEntropySizeB{};
@@ -70,6 +74,7 @@ class SizeEstimate
   size_t mCompressedDictionarySizeB{};
   size_t mIncompressibleSizeB{};
   size_t mPackedDatasetSizeB{};
+  size_t mRawDatasetSizeB{};
 };
 
 template <typename source_T>
@@ -86,6 +91,7 @@ inline SizeEstimate::SizeEstimate(const Metrics<source_T>& metrics) noexcept
                                                                            *coderProperties.renormingPrecisionBits);
     mIncompressibleSizeB = utils::toBytes(datasetProperties.alphabetRangeBits * (*coderProperties.nIncompressibleSamples));
     mPackedDatasetSizeB = utils::toBytes(datasetProperties.alphabetRangeBits * nSamples);
+    mRawDatasetSizeB = nSamples * sizeof(source_T);
   } else {
     // special case: store no data for empty dataset
     mEntropySizeB = 0;
@@ -93,6 +99,7 @@ inline SizeEstimate::SizeEstimate(const Metrics<source_T>& metrics) noexcept
     mCompressedDictionarySizeB = 0;
     mIncompressibleSizeB = 0;
     mPackedDatasetSizeB = 0;
+    mRawDatasetSizeB = 0;
   }
 };
 
@@ -126,6 +133,12 @@ template <typename T>
   return utils::nBytesTo<T>(std::ceil(mPackedDatasetSizeB * safetyFactor));
 };
 
+template <typename T>
+[[nodiscard]] inline size_t SizeEstimate::getRawDatasetSize(double_t safetyFactor) const
+{
+  return utils::nBytesTo<T>(std::ceil(mRawDatasetSizeB * safetyFactor));
+};
+
 [[nodiscard]] inline bool SizeEstimate::preferPacking(double_t weight) const
 {
   // convention: always pack empty dataset.
@@ -134,6 +147,21 @@ template <typename T>
                                             mIncompressibleSizeB);
 };
 
+[[nodiscard]] inline bool SizeEstimate::preferPassthrough(double_t weight) const
+{
+  // prefer storing the dataset as is if neither entropy coding nor packing reduces its size
+  // by more than the margin implied by the weight (>1 biases towards pass-through, trading
+  // compression rate for coding CPU). Empty datasets are never passed through.
+  if (mRawDatasetSizeB == 0) {
+    return false;
+  }
+  const size_t bestCodedSizeB = std::min(mPackedDatasetSizeB,
+                                         mCompressedDatasetSizeB +
+                                           mCompressedDictionarySizeB +
+                                           mIncompressibleSizeB);
+  return (bestCodedSizeB * weight) >= mRawDatasetSizeB;
+};
+
 } // namespace o2::rans
 
 #endif /* RANS_INTERNAL_METRICS_SIZEESTIMATE_H_ */
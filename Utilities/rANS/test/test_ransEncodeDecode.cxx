@@ -89,6 +89,10 @@ using coder_types = boost::mp11::mp_list<std::integral_constant<CoderTag, CoderT
                                          ,
                                          std::integral_constant<CoderTag, CoderTag::AVX2>
 #endif /* RANS_AVX2 */
+#ifdef RANS_AVX512
+                                         ,
+                                         std::integral_constant<CoderTag, CoderTag::AVX512>
+#endif /* RANS_AVX512 */
                                          >;
 
 using testCase_types = boost::mp11::mp_product<boost::mp11::mp_list, coder_types, testInput_types>;
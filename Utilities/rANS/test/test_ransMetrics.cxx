@@ -342,7 +342,9 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_emptySizeEstimate, histogram_T, histogram_typ
   BOOST_CHECK_EQUAL(estimate.getCompressedDictionarySize<>(1.0), 8);
   BOOST_CHECK_EQUAL(estimate.getIncompressibleSize<>(1.0), 0);
   BOOST_CHECK_EQUAL(estimate.getPackedDatasetSize<>(1.0), 0);
+  BOOST_CHECK_EQUAL(estimate.getRawDatasetSize<>(1.0), 0);
   BOOST_CHECK_EQUAL(estimate.preferPacking(1.0), true);
+  BOOST_CHECK_EQUAL(estimate.preferPassthrough(1.0), false);
 }
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_normalSizeEstimate, histogram_T, histogram_types)
@@ -358,6 +360,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_normalSizeEstimate, histogram_T, histogram_ty
   BOOST_CHECK_EQUAL(estimate.getCompressedDictionarySize<>(1.0), 29);
   BOOST_CHECK_EQUAL(estimate.getIncompressibleSize<>(1.0), 0);
   BOOST_CHECK_EQUAL(estimate.getPackedDatasetSize<>(1.0), 29);
+  BOOST_CHECK_EQUAL(estimate.getRawDatasetSize<>(1.0), histogram.getNumSamples() * sizeof(source_type));
   BOOST_CHECK_EQUAL(estimate.preferPacking(1.0), true);
+  BOOST_CHECK_EQUAL(estimate.preferPassthrough(1.0), false);
 }
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,103 @@
+#!/bin/bash
+
+# Script benchmarking the simulation per detector module:
+# - geometry construction time (init of a single-module simulation)
+# - transport/stepping cost on top of a CAVE-only baseline (fixed seeds)
+# - digitizer throughput (hits per second of digitization walltime)
+#
+# The metrics are emitted both in the InfluxDB line format used by
+# sim_performance_test.sh (for time-series monitoring) and as a
+# machine-readable JSON baseline file that can be diffed between O2
+# versions to catch per-detector simulation regressions early.
+
+# number of events / take from first argument or default
+NEVENTS=${1:-"5"}
+# engine / take from second argument or default
+ENGINE=${2:-"TGeant4"}
+# generator / take from third argument or default
+GEN=${3:-"pythia8pp"}
+
+# fixed seed so that successive runs transport identical events
+SEED=1234
+
+# the detector modules to benchmark individually
+DETECTORS=${DETECTORS:-"ITS TPC TRD TOF EMC PHS CPV HMP MFT MCH MID FDD FV0 FT0 ZDC"}
+
+# TIMESTAMP TO USE FOR INJECTION INTO DATABASE
+TIMEST=`date +%s`
+TIMEST="${TIMEST}000000000"
+
+SIMCONFIG="${GEN}_N${NEVENTS}_${ENGINE}"
+HOST=`hostname`
+TAG="conf=${SIMCONFIG},host=${HOST}${ALIDISTCOMMIT:+,alidist=$ALIDISTCOMMIT}${O2COMMIT:+,o2=$O2COMMIT}"
+
+METRICFILE=detector_metrics.dat
+BASELINEFILE=sim_detector_baseline_${SIMCONFIG}.json
+
+# helper extracting init/run real time from a simulation log
+get_init_time() { grep "Init: Real time" $1 | awk '//{print $5}'; }
+get_run_time() { grep " Real time" $1 | grep -v "Init:" | awk '//{print $4}'; }
+
+### ------ CAVE-only baseline: fixes the generator + infrastructure cost
+BASELOG=log_${SIMCONFIG}_CAVE
+taskset -c 1 o2-sim-serial -n ${NEVENTS} -e ${ENGINE} -g ${GEN} --seed ${SEED} -m CAVE -o o2sim_${SIMCONFIG}_CAVE > ${BASELOG} 2>&1
+BASEINIT=`get_init_time ${BASELOG}`
+BASERUN=`get_run_time ${BASELOG}`
+
+geom_metrics="geomtime_det,${TAG} "
+step_metrics="steptime_det,${TAG} "
+digirate_metrics="digirate_det,${TAG} "
+
+echo "{" > ${BASELINEFILE}
+echo "  \"config\": \"${SIMCONFIG}\", \"seed\": ${SEED}, \"timestamp\": ${TIMEST}," >> ${BASELINEFILE}
+echo "  \"baseline_init\": ${BASEINIT:-null}, \"baseline_run\": ${BASERUN:-null}," >> ${BASELINEFILE}
+echo "  \"detectors\": {" >> ${BASELINEFILE}
+
+SEP=""
+for d in ${DETECTORS}; do
+  SIMPREFIX=o2sim_${SIMCONFIG}_${d}
+  LOGFILE=log_${SIMCONFIG}_${d}
+
+  ### ------ single-module simulation: init time is dominated by the
+  ### ------ geometry construction of this module; the run-time excess
+  ### ------ over the CAVE baseline is the stepping cost of this module
+  taskset -c 1 o2-sim-serial -n ${NEVENTS} -e ${ENGINE} -g ${GEN} --seed ${SEED} -m ${d} -o ${SIMPREFIX} > ${LOGFILE} 2>&1
+
+  INITTIME=`get_init_time ${LOGFILE}`
+  RUNTIME=`get_run_time ${LOGFILE}`
+  GEOMTIME=`bc <<< "scale=3; ${INITTIME:-0} - ${BASEINIT:-0}"`
+  STEPTIME=`bc <<< "scale=3; ${RUNTIME:-0} - ${BASERUN:-0}"`
+
+  ### ------ hit statistics (for digitizer throughput normalization)
+  HITSTATFILE=hitstats_${SIMCONFIG}_${d}
+  root -q -b -l ${O2_ROOT}/share/macro/analyzeHits.C\(\"${SIMPREFIX}\"\) > ${HITSTATFILE} 2>/dev/null
+  HITNUMBER=`grep "${d}" ${HITSTATFILE} | awk '//{print $2}'`
+  HITNUMBER=${HITNUMBER:-0}
+
+  ### ------ digitization of this detector only
+  DIGILOGFILE=logdigi_${SIMCONFIG}_${d}
+  DIGITIMEFILE=timedigi_${SIMCONFIG}_${d}
+  TIME="#walltime %e" /usr/bin/time --output=${DIGITIMEFILE} o2-sim-digitizer-workflow --sims ${SIMPREFIX} -b --onlyDet ${d} --tpc-lanes 1 --configKeyValues "TRDSimParams.digithreads=1" > ${DIGILOGFILE} 2>&1
+  DIGITIME=`grep "#walltime" ${DIGITIMEFILE} | awk '//{print $2}'`
+  DIGIRATE=0
+  if [ "${HITNUMBER}" != "0" ] && [ -n "${DIGITIME}" ]; then
+    DIGIRATE=`bc <<< "scale=1; ${HITNUMBER} / (${DIGITIME} + 0.001)"`
+  fi
+
+  geom_metrics="${geom_metrics}$d=${GEOMTIME},"
+  step_metrics="${step_metrics}$d=${STEPTIME},"
+  digirate_metrics="${digirate_metrics}$d=${DIGIRATE},"
+
+  echo "    ${SEP}\"${d}\": { \"geomtime\": ${GEOMTIME:-null}, \"steptime\": ${STEPTIME:-null}, \"hits\": ${HITNUMBER}, \"digitime\": ${DIGITIME:-null}, \"digirate\": ${DIGIRATE} }" >> ${BASELINEFILE}
+  SEP=","
+done
+
+echo "  }" >> ${BASELINEFILE}
+echo "}" >> ${BASELINEFILE}
+
+echo "${geom_metrics%,} " >> ${METRICFILE}
+echo "${step_metrics%,} " >> ${METRICFILE}
+echo "${digirate_metrics%,} " >> ${METRICFILE}
+
+# remove empty DPL files
+find ./ -size 0 -exec rm {} ';'
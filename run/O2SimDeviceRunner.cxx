@@ -22,6 +22,7 @@
 #include <fairmq/Parts.h>
 #include <fairmq/TransportFactory.h>
 #include <TStopwatch.h>
+#include <TGeoManager.h>
 #include <sys/wait.h>
 #include <pthread.h> // to set cpu affinity
 #include <cmath>
@@ -373,6 +374,15 @@ int main(int argc, char* argv[])
       return 1;
     }
 
+    // At this point the geometry is fully finalized (constructed, aligned via
+    // o2::base::Aligner and closed) and will be shared with all forked workers
+    // through copy-on-write. Lock it so that no worker can accidentally modify
+    // it after the fork, which would silently un-share the geometry pages and
+    // multiply the memory footprint by the number of workers.
+    if (gGeoManager) {
+      gGeoManager->LockGeometry();
+    }
+
     // should be factored out?
     unsigned int nworkers = std::max(1u, std::thread::hardware_concurrency() / 2);
     auto f = getenv("ALICE_NSIMWORKERS");
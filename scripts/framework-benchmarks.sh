@@ -0,0 +1,59 @@
+#!/bin/bash
+# Runs the framework google-benchmark executables pinned to a single CPU,
+# stores the results as JSON and optionally compares them against a
+# baseline directory produced by a previous run, failing when a benchmark
+# regressed beyond the tolerance. Meant to be wired in CI so that
+# framework slowdowns are caught here rather than as P2 throughput drops.
+#
+# Usage: framework-benchmarks.sh <results-dir> [<baseline-dir>]
+#
+# Environment:
+#   BENCHMARKS           space separated list of benchmark suffixes to run
+#   BENCHMARK_CPU        CPU to pin the benchmarks to (default 0)
+#   BENCHMARK_TOLERANCE  allowed slowdown in percent before failing (default 10)
+
+BENCHMARKS=${BENCHMARKS:-"DataHeader DataDescriptorMatcher DataRelayer DeviceMetricsInfo InputRecord TableBuilder WorkflowHelpers"}
+CPU=${BENCHMARK_CPU:-0}
+TOLERANCE=${BENCHMARK_TOLERANCE:-10}
+
+RESULTS=$1
+BASELINE=$2
+[ "X$RESULTS" = X ] && { echo "Usage: $0 <results-dir> [<baseline-dir>]"; exit 1; }
+mkdir -p "$RESULTS"
+
+PIN="taskset -c $CPU"
+$PIN true 2> /dev/null || { echo "taskset not usable, running unpinned"; PIN=""; }
+
+FAILED=0
+for b in $BENCHMARKS; do
+  EXE=`which o2-bench-framework-benchmark-$b 2> /dev/null`
+  [ "X$EXE" = X ] && { echo "Unable to find o2-bench-framework-benchmark-$b, skipping"; continue; }
+  echo "### Running benchmark-$b pinned to CPU $CPU"
+  $PIN $EXE --benchmark_out_format=json --benchmark_out="$RESULTS/$b.json" || { FAILED=1; continue; }
+  [ "X$BASELINE" = X ] && continue
+  [ ! -e "$BASELINE/$b.json" ] && { echo "No baseline for $b, skipping comparison"; continue; }
+  python3 - "$BASELINE/$b.json" "$RESULTS/$b.json" "$TOLERANCE" <<\EOF || FAILED=1
+import json
+import sys
+
+def byName(path):
+    with open(path) as f:
+        return {b["name"]: b for b in json.load(f)["benchmarks"] if b.get("run_type", "iteration") == "iteration"}
+
+baseline, results, tolerance = byName(sys.argv[1]), byName(sys.argv[2]), float(sys.argv[3])
+status = 0
+for name, new in results.items():
+    old = baseline.get(name)
+    if old is None or old["real_time"] <= 0:
+        continue
+    delta = (new["real_time"] - old["real_time"]) / old["real_time"] * 100
+    marker = ""
+    if delta > tolerance:
+        marker = " REGRESSION"
+        status = 1
+    print(f'{name}: {old["real_time"]:.1f} -> {new["real_time"]:.1f} {new["time_unit"]} ({delta:+.1f}%){marker}')
+sys.exit(status)
+EOF
+done
+
+exit $FAILED